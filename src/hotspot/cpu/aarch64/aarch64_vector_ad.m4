@@ -201,7 +201,8 @@ source %{
         }
         break;
       case Op_ExpandV:
-        if (UseSVE < 2 || is_subword_type(bt)) {
+        // Byte and short elements are expanded without the SVE2 HISTCNT.
+        if (UseSVE == 0 || (UseSVE < 2 && !is_subword_type(bt))) {
           return false;
         }
         break;
@@ -2757,6 +2758,41 @@ instruct vcvtFtoHF_sve(vReg dst, vReg src, vReg tmp) %{
   ins_pipe(pipe_slow);
 %}
 
+// Combined rules for FP16 vector load/store with conversion, which use the
+// widening/narrowing forms of LD1H/ST1H instead of separate extend/narrow
+// instructions.
+
+// VectorCastHF2F+LoadVector
+instruct vloadHFtoF(vReg dst, indirect mem) %{
+  predicate(UseSVE > 0 &&
+            Matcher::vector_length_in_bytes(n) == MaxVectorSize);
+  match(Set dst (VectorCastHF2F (LoadVector mem)));
+  format %{ "vloadHFtoF $dst, $mem" %}
+  ins_encode %{
+    loadStoreA_predicated(masm, /* is_store */ false, $dst$$FloatRegister,
+                          ptrue, T_SHORT, T_FLOAT, $mem->opcode(),
+                          as_Register($mem$$base), $mem$$index, $mem$$scale, $mem$$disp);
+    __ sve_fcvt($dst$$FloatRegister, __ S, ptrue, $dst$$FloatRegister, __ H);
+  %}
+  ins_pipe(pipe_slow);
+%}
+
+// StoreVector+VectorCastF2HF
+instruct vstoreFtoHF(indirect mem, vReg src, vReg tmp) %{
+  predicate(UseSVE > 0 &&
+            Matcher::vector_length_in_bytes(n->as_StoreVector()->in(MemNode::ValueIn)->in(1)) == MaxVectorSize);
+  match(Set mem (StoreVector mem (VectorCastF2HF src)));
+  effect(TEMP tmp);
+  format %{ "vstoreFtoHF $mem, $src\t# KILL $tmp" %}
+  ins_encode %{
+    __ sve_fcvt($tmp$$FloatRegister, __ H, ptrue, $src$$FloatRegister, __ S);
+    loadStoreA_predicated(masm, /* is_store */ true, $tmp$$FloatRegister,
+                          ptrue, T_SHORT, T_FLOAT, $mem->opcode(),
+                          as_Register($mem$$base), $mem$$index, $mem$$scale, $mem$$disp);
+  %}
+  ins_pipe(pipe_slow);
+%}
+
 // ------------------------------ Replicate ------------------------------------
 
 dnl REPLICATE_INT($1,   $2,       $3  )
@@ -4878,6 +4914,7 @@ instruct vcompressS(vReg dst, vReg src, pReg pg,
 %}
 
 instruct vexpand(vReg dst, vReg src, pRegGov pg) %{
+  predicate(!is_subword_type(Matcher::vector_element_basic_type(n)));
   match(Set dst (ExpandV src pg));
   effect(TEMP_DEF dst);
   format %{ "vexpand $dst, $pg, $src" %}
@@ -4906,6 +4943,19 @@ instruct vexpand(vReg dst, vReg src, pRegGov pg) %{
   ins_pipe(pipe_slow);
 %}
 
+instruct vexpandBS(vReg dst, vReg src, pReg pg, vReg tmp) %{
+  predicate(is_subword_type(Matcher::vector_element_basic_type(n)));
+  match(Set dst (ExpandV src pg));
+  effect(TEMP_DEF dst, TEMP tmp);
+  format %{ "vexpandBS $dst, $pg, $src\t# KILL $tmp" %}
+  ins_encode %{
+    BasicType bt = Matcher::vector_element_basic_type(this);
+    __ sve_expand_subword($dst$$FloatRegister, $src$$FloatRegister, $pg$$PRegister,
+                          $tmp$$FloatRegister, bt, Matcher::vector_length(this));
+  %}
+  ins_pipe(pipe_slow);
+%}
+
 // ------------------------------ Vector signum --------------------------------
 
 // Vector Math.signum
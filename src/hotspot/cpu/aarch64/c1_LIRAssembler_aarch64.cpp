@@ -402,7 +402,7 @@ int LIR_Assembler::emit_unwind_handler() {
 
   __ bind(_unwind_handler_entry);
   __ verify_not_null_oop(r0);
-  if (method()->is_synchronized() || compilation()->env()->dtrace_method_probes()) {
+  if (method()->is_synchronized() || compilation()->env()->method_probes()) {
     __ mov(r19, r0);  // Preserve the exception
   }
 
@@ -419,13 +419,13 @@ int LIR_Assembler::emit_unwind_handler() {
     __ bind(*stub->continuation());
   }
 
-  if (compilation()->env()->dtrace_method_probes()) {
+  if (compilation()->env()->method_probes()) {
     __ mov(c_rarg0, rthread);
     __ mov_metadata(c_rarg1, method()->constant_encoding());
     __ call_VM_leaf(CAST_FROM_FN_PTR(address, SharedRuntime::dtrace_method_exit), c_rarg0, c_rarg1);
   }
 
-  if (method()->is_synchronized() || compilation()->env()->dtrace_method_probes()) {
+  if (method()->is_synchronized() || compilation()->env()->method_probes()) {
     __ mov(r0, r19);  // Restore the exception
   }
 
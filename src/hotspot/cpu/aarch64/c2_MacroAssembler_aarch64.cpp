@@ -289,26 +289,33 @@ void C2_MacroAssembler::fast_lock_lightweight(Register obj, Register t1,
   { // Handle inflated monitor.
     bind(inflated);
 
-    // mark contains the tagged ObjectMonitor*.
-    const Register t1_tagged_monitor = t1_mark;
-    const uintptr_t monitor_tag = markWord::monitor_value;
-    const Register t2_owner_addr = t2;
-    const Register t3_owner = t3;
-
-    // Compute owner address.
-    lea(t2_owner_addr, Address(t1_tagged_monitor, (in_bytes(ObjectMonitor::owner_offset()) - monitor_tag)));
-
-    // CAS owner (null => current thread).
-    cmpxchg(t2_owner_addr, zr, rthread, Assembler::xword, /*acquire*/ true,
-            /*release*/ false, /*weak*/ false, t3_owner);
-    br(Assembler::EQ, locked);
-
-    // Check if recursive.
-    cmp(t3_owner, rthread);
-    br(Assembler::NE, slow_path);
-
-    // Recursive.
-    increment(Address(t1_tagged_monitor, in_bytes(ObjectMonitor::recursions_offset()) - monitor_tag), 1);
+    if (UseObjectMonitorTable) {
+      // The mark word does not refer to the ObjectMonitor, let the runtime
+      // look it up. Set flag == NE.
+      tst(t1_mark, markWord::monitor_value);
+      b(slow_path);
+    } else {
+      // mark contains the tagged ObjectMonitor*.
+      const Register t1_tagged_monitor = t1_mark;
+      const uintptr_t monitor_tag = markWord::monitor_value;
+      const Register t2_owner_addr = t2;
+      const Register t3_owner = t3;
+
+      // Compute owner address.
+      lea(t2_owner_addr, Address(t1_tagged_monitor, (in_bytes(ObjectMonitor::owner_offset()) - monitor_tag)));
+
+      // CAS owner (null => current thread).
+      cmpxchg(t2_owner_addr, zr, rthread, Assembler::xword, /*acquire*/ true,
+              /*release*/ false, /*weak*/ false, t3_owner);
+      br(Assembler::EQ, locked);
+
+      // Check if recursive.
+      cmp(t3_owner, rthread);
+      br(Assembler::NE, slow_path);
+
+      // Recursive.
+      increment(Address(t1_tagged_monitor, in_bytes(ObjectMonitor::recursions_offset()) - monitor_tag), 1);
+    }
   }
 
   bind(locked);
@@ -412,6 +419,13 @@ void C2_MacroAssembler::fast_unlock_lightweight(Register obj, Register t1, Regis
     bind(check_done);
 #endif
 
+    if (UseObjectMonitorTable) {
+      // The mark word does not refer to the ObjectMonitor, let the runtime
+      // look it up. Set flag == NE.
+      tst(t1_mark, markWord::monitor_value);
+      b(slow_path);
+    }
+
     // mark contains the tagged ObjectMonitor*.
     const Register t1_monitor = t1_mark;
     const uintptr_t monitor_tag = markWord::monitor_value;
@@ -921,6 +935,132 @@ void C2_MacroAssembler::string_indexof(Register str2, Register str1,
 typedef void (MacroAssembler::* chr_insn)(Register Rt, const Address &adr);
 typedef void (MacroAssembler::* uxt_insn)(Register Rd, Register Rn);
 
+// Intrinsic for ArraysSupport.vectorizedHashCode: result = 31^cnt * result + sum(31^(cnt-1-i) * ary[i])
+//
+// The main loop handles 8 elements per iteration. Elements i and i + 4 of each
+// chunk are accumulated in lane i of vacc0 and vacc1, which are multiplied by
+// 31^8 every iteration, as is the scalar result. The lanes are weighted with
+// 31^7 .. 31^0 when the loop is done. The remaining elements are added one by one.
+void C2_MacroAssembler::arrays_hashcode(Register ary, Register cnt, Register result,
+                                        Register tmp1, Register tmp2,
+                                        FloatRegister vdata0, FloatRegister vdata1,
+                                        FloatRegister vacc0, FloatRegister vacc1,
+                                        FloatRegister vpow, FloatRegister vcoef0, FloatRegister vcoef1,
+                                        BasicType eltype) {
+  assert_different_registers(ary, cnt, result, tmp1, tmp2, rscratch1);
+  assert_different_registers(vdata0, vdata1, vacc0, vacc1, vpow, vcoef0, vcoef1);
+
+  switch (eltype) {
+  case T_BOOLEAN: BLOCK_COMMENT("arrays_hashcode(unsigned byte) {"); break;
+  case T_CHAR:    BLOCK_COMMENT("arrays_hashcode(char) {");          break;
+  case T_BYTE:    BLOCK_COMMENT("arrays_hashcode(byte) {");          break;
+  case T_SHORT:   BLOCK_COMMENT("arrays_hashcode(short) {");         break;
+  case T_INT:     BLOCK_COMMENT("arrays_hashcode(int) {");           break;
+  default:
+    ShouldNotReachHere();
+  }
+
+  const int stride = 8;
+  const int elsize = type2aelembytes(eltype);
+  const Register chunks_end = tmp2;
+
+  // Powers of 31, modulo 2^32 like the Java int arithmetic
+  juint pow31[stride + 1];
+  pow31[0] = 1;
+  for (int i = 1; i <= stride; i++) {
+    pow31[i] = pow31[i - 1] * 31;
+  }
+
+  Label DONE, TAIL, TAIL_LOOP, WIDE_LOOP;
+
+  // result has a value initially
+
+  cmpw(cnt, stride);
+  br(Assembler::LT, TAIL);
+
+  movw(tmp1, pow31[stride]);
+  dup(vpow, T4S, tmp1);
+  for (int i = 0; i < 4; i++) {
+    movw(rscratch1, pow31[stride - 1 - i]);
+    mov(vcoef0, S, i, rscratch1);
+    movw(rscratch1, pow31[3 - i]);
+    mov(vcoef1, S, i, rscratch1);
+  }
+  eor(vacc0, T16B, vacc0, vacc0);
+  eor(vacc1, T16B, vacc1, vacc1);
+
+  andw(chunks_end, cnt, ~(stride - 1));
+  add(chunks_end, ary, chunks_end, ext::uxtw, exact_log2(elsize));
+  andw(cnt, cnt, stride - 1);      // don't forget about tail!
+
+  bind(WIDE_LOOP);
+  switch (eltype) {
+  case T_BOOLEAN:
+    ldrd(vdata0, Address(post(ary, stride)));
+    uxtl(vdata0, T8H, vdata0, T8B);
+    ushll2(vdata1, T4S, vdata0, T8H, 0);
+    uxtl(vdata0, T4S, vdata0, T4H);
+    break;
+  case T_BYTE:
+    ldrd(vdata0, Address(post(ary, stride)));
+    sxtl(vdata0, T8H, vdata0, T8B);
+    sshll2(vdata1, T4S, vdata0, T8H, 0);
+    sxtl(vdata0, T4S, vdata0, T4H);
+    break;
+  case T_CHAR:
+    ldrq(vdata0, Address(post(ary, stride * 2)));
+    ushll2(vdata1, T4S, vdata0, T8H, 0);
+    uxtl(vdata0, T4S, vdata0, T4H);
+    break;
+  case T_SHORT:
+    ldrq(vdata0, Address(post(ary, stride * 2)));
+    sshll2(vdata1, T4S, vdata0, T8H, 0);
+    sxtl(vdata0, T4S, vdata0, T4H);
+    break;
+  case T_INT:
+    ldpq(vdata0, vdata1, Address(post(ary, stride * 4)));
+    break;
+  default:
+    ShouldNotReachHere();
+  }
+  mulv(vacc0, T4S, vacc0, vpow);
+  mulv(vacc1, T4S, vacc1, vpow);
+  addv(vacc0, T4S, vacc0, vdata0);
+  addv(vacc1, T4S, vacc1, vdata1);
+  mulw(result, result, tmp1);      // 31^^8 * h
+  cmp(ary, chunks_end);
+  br(Assembler::NE, WIDE_LOOP);
+
+  mulv(vacc0, T4S, vacc0, vcoef0);
+  mulv(vacc1, T4S, vacc1, vcoef1);
+  addv(vacc0, T4S, vacc0, vacc1);
+  addv(vacc0, T4S, vacc0);
+  umov(tmp2, vacc0, S, 0);
+  addw(result, result, tmp2);
+
+  bind(TAIL);
+  cbzw(cnt, DONE);
+  movw(tmp1, 31);
+
+  bind(TAIL_LOOP);
+  switch (eltype) {
+  // T_BOOLEAN used as surrogate for unsigned byte
+  case T_BOOLEAN: ldrb(tmp2, Address(post(ary, elsize)));   break;
+  case T_BYTE:    ldrsbw(tmp2, Address(post(ary, elsize))); break;
+  case T_CHAR:    ldrh(tmp2, Address(post(ary, elsize)));   break;
+  case T_SHORT:   ldrshw(tmp2, Address(post(ary, elsize))); break;
+  case T_INT:     ldrw(tmp2, Address(post(ary, elsize)));   break;
+  default:
+    ShouldNotReachHere();
+  }
+  maddw(result, result, tmp1, tmp2); // 31 * h + ary[i]
+  subsw(cnt, cnt, 1);
+  br(Assembler::NE, TAIL_LOOP);
+
+  bind(DONE);
+  BLOCK_COMMENT("} // arrays_hashcode");
+}
+
 void C2_MacroAssembler::string_indexof_char(Register str1, Register cnt1,
                                             Register ch, Register result,
                                             Register tmp1, Register tmp2, Register tmp3)
@@ -2319,6 +2459,40 @@ void C2_MacroAssembler::sve_compress_byte(FloatRegister dst, FloatRegister src,
   sve_orr(dst, dst, vtmp1);
 }
 
+void C2_MacroAssembler::sve_expand_subword(FloatRegister dst, FloatRegister src, PRegister mask,
+                                           FloatRegister vtmp, BasicType bt, int vector_length) {
+  assert(UseSVE > 0 && is_subword_type(bt), "unsupported");
+  assert_different_registers(dst, src, vtmp);
+  SIMD_RegVariant size = elemType_to_regVariant(bt);
+  int esize = type2aelembytes(bt);
+
+  // Example input:   src   = 1 2 3 4 5 6 7 8
+  //                  mask  = 1 0 0 1 1 0 1 1
+  // Expected result: dst   = 4 0 0 5 6 0 7 8
+  //
+  // As for the wider types, TBL moves the elements of src into place. The TBL
+  // index of an active lane is the number of active lanes below it. It is
+  // computed as a prefix sum over the mask, adding the partial sums shifted up
+  // by 1, 2, 4, ... lanes with EXT.
+
+  // vtmp = 1 0 0 1 1 0 1 1
+  sve_cpy(vtmp, size, mask, 1, /* isMerge */ false);
+  for (int shift = 1; shift < vector_length; shift <<= 1) {
+    // dst = vtmp shifted up by "shift" lanes, filled with zero.
+    sve_dup(dst, size, 0);
+    sve_ext(dst, vtmp, MaxVectorSize - shift * esize);
+    sve_add(vtmp, size, vtmp, dst);
+  }
+  // vtmp = 5 4 4 4 3 2 2 1, subtract one to get the TBL index.
+  // vtmp = 4 3 3 3 2 1 1 0
+  sve_sub(vtmp, size, 1);
+  // dst  = 4 5 5 5 6 7 7 8
+  sve_tbl(dst, size, src, vtmp);
+  // dst  = 4 0 0 5 6 0 7 8
+  sve_dup(vtmp, size, 0);
+  sve_sel(dst, size, mask, dst, vtmp);
+}
+
 void C2_MacroAssembler::neon_reverse_bits(FloatRegister dst, FloatRegister src, BasicType bt, bool isQ) {
   assert(bt == T_BYTE || bt == T_SHORT || bt == T_INT || bt == T_LONG, "unsupported basic type");
   SIMD_Arrangement size = isQ ? T16B : T8B;
@@ -59,6 +59,13 @@
                            Register ch, Register result,
                            Register tmp1, Register tmp2, Register tmp3);
 
+  void arrays_hashcode(Register ary, Register cnt, Register result,
+                       Register tmp1, Register tmp2,
+                       FloatRegister vdata0, FloatRegister vdata1,
+                       FloatRegister vacc0, FloatRegister vacc1,
+                       FloatRegister vpow, FloatRegister vcoef0, FloatRegister vcoef1,
+                       BasicType eltype);
+
   void stringL_indexof_char(Register str1, Register cnt1,
                             Register ch, Register result,
                             Register tmp1, Register tmp2, Register tmp3);
@@ -168,6 +175,12 @@
                           FloatRegister vtmp1, FloatRegister vtmp2,
                           PRegister pgtmp);
 
+  // Place the lowest-numbered elements of src, in order, into the elements of
+  // dst that are active in mask. Inactive elements of dst are set to zero.
+  // Used for byte and short elements, for which SVE2 HISTCNT is not available.
+  void sve_expand_subword(FloatRegister dst, FloatRegister src, PRegister mask,
+                          FloatRegister vtmp, BasicType bt, int vector_length);
+
   void neon_reverse_bits(FloatRegister dst, FloatRegister src, BasicType bt, bool isQ);
 
   void neon_reverse_bytes(FloatRegister dst, FloatRegister src, BasicType bt, bool isQ);
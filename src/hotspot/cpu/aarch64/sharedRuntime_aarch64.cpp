@@ -884,7 +884,20 @@ static int c_calling_convention_priv(const BasicType *sig_bt,
 int SharedRuntime::vector_calling_convention(VMRegPair *regs,
                                              uint num_bits,
                                              uint total_args_passed) {
-  Unimplemented();
+  // Only NEON vectors are passed, in v0-v7 as in the AAPCS64 vector PCS.
+  assert(num_bits == 64 || num_bits == 128, "only certain vector sizes are supported for now");
+
+  static const FloatRegister VEC_ArgReg[Argument::n_float_register_parameters_c] = {
+    v0, v1, v2, v3, v4, v5, v6, v7
+  };
+  assert(total_args_passed <= Argument::n_float_register_parameters_c, "too many vector arguments");
+
+  for (uint i = 0; i < total_args_passed; i++) {
+    VMReg vmreg = VEC_ArgReg[i]->as_VMReg();
+    int next_val = num_bits == 64 ? 1 : 3;
+    regs[i].set_pair(vmreg->next(next_val), vmreg);
+  }
+
   return 0;
 }
 
@@ -42,6 +42,7 @@
 #include "oops/oop.inline.hpp"
 #include "prims/methodHandles.hpp"
 #include "prims/upcallLinker.hpp"
+#include "runtime/arguments.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/continuation.hpp"
 #include "runtime/continuationEntry.inline.hpp"
@@ -1174,6 +1175,54 @@ class StubGenerator: public StubCodeGenerator {
     }
   }
 
+  // SVE predicated load and store of elements of the given size.
+  void sve_load_elements(FloatRegister zt, PRegister pg, size_t granularity, const Address &a) {
+    switch (granularity) {
+      case 1: __ sve_ld1b(zt, __ B, pg, a); break;
+      case 2: __ sve_ld1h(zt, __ H, pg, a); break;
+      case 4: __ sve_ld1w(zt, __ S, pg, a); break;
+      case 8: __ sve_ld1d(zt, __ D, pg, a); break;
+      default: ShouldNotReachHere();
+    }
+  }
+
+  void sve_store_elements(FloatRegister zt, PRegister pg, size_t granularity, const Address &a) {
+    switch (granularity) {
+      case 1: __ sve_st1b(zt, __ B, pg, a); break;
+      case 2: __ sve_st1h(zt, __ H, pg, a); break;
+      case 4: __ sve_st1w(zt, __ S, pg, a); break;
+      case 8: __ sve_st1d(zt, __ D, pg, a); break;
+      default: ShouldNotReachHere();
+    }
+  }
+
+  // Small copy of primitive elements using SVE: less than 16 bytes.
+  //
+  // Like copy_memory_small, but with a single predicated load and
+  // store instead of a bit test and branch per power of two. Ignores
+  // the bits of count which represent more than 15 bytes.
+
+  void copy_memory_small_sve(Register s, Register d, Register count, int step) {
+    bool is_backwards = step < 0;
+    size_t granularity = uabs(step);
+    int shift = exact_log2(granularity);
+
+    const Register t0 = r3;
+
+    __ andr(t0, count, 16 / granularity - 1);
+    if (is_backwards) {
+      __ sub(s, s, t0, Assembler::LSL, shift);
+      __ sub(d, d, t0, Assembler::LSL, shift);
+    }
+    __ sve_whilelo(p0, Assembler::elemBytes_to_regVariant(granularity), zr, t0);
+    sve_load_elements(z0, p0, granularity, Address(s));
+    sve_store_elements(z0, p0, granularity, Address(d));
+    if (!is_backwards) {
+      __ add(s, s, t0, Assembler::LSL, shift);
+      __ add(d, d, t0, Assembler::LSL, shift);
+    }
+  }
+
   Label copy_f, copy_b;
   Label copy_obj_f, copy_obj_b;
   Label copy_obj_uninit_f, copy_obj_uninit_b;
@@ -1202,8 +1251,25 @@ class StubGenerator: public StubCodeGenerator {
     const FloatRegister gcvt1 = v6, gcvt2 = v7, gcvt3 = v16; // Note that v8-v15 are callee saved
     ArrayCopyBarrierSetHelper bs(_masm, decorators, type, gct1, gct2, gct3, gcvt1, gcvt2, gcvt3);
 
+    bool use_sve = UseSVE > 0 && !is_reference_type(type);
+
     if (PrefetchCopyIntervalInBytes > 0)
       __ prfm(Address(s, 0), PLDL1KEEP);
+
+    if (use_sve) {
+      // Up to one vector: a single predicated load and store, with no
+      // branches on the size. As for the other small copies, all the
+      // data is loaded before anything is written.
+      Label not_small;
+      __ subs(zr, count, (uint64_t)(MaxVectorSize / granularity));
+      __ br(Assembler::HI, not_small);
+      __ sve_whilelo(p0, Assembler::elemBytes_to_regVariant(granularity), zr, count);
+      sve_load_elements(z0, p0, granularity, Address(s));
+      sve_store_elements(z0, p0, granularity, Address(d));
+      __ b(finish);
+      __ bind(not_small);
+    }
+
     __ cmp(count, u1((UseSIMDForMemoryOps ? 96:80)/granularity));
     __ br(Assembler::HI, copy_big);
 
@@ -1394,7 +1460,11 @@ class StubGenerator: public StubCodeGenerator {
         __ add(d, d, r15);
       }
 #else
-      copy_memory_small(decorators, type, s, d, r15, step);
+      if (use_sve) {
+        copy_memory_small_sve(s, d, r15, step);
+      } else {
+        copy_memory_small(decorators, type, s, d, r15, step);
+      }
 #endif
     }
 
@@ -1424,7 +1494,11 @@ class StubGenerator: public StubCodeGenerator {
     }
 
     // And the tail.
-    copy_memory_small(decorators, type, s, d, count, step);
+    if (use_sve) {
+      copy_memory_small_sve(s, d, count, step);
+    } else {
+      copy_memory_small(decorators, type, s, d, count, step);
+    }
 
     if (granularity >= 8) __ bind(copy8);
     if (granularity >= 4) __ bind(copy4);
@@ -2522,6 +2596,103 @@ class StubGenerator: public StubCodeGenerator {
     return start;
   }
 
+  //
+  //  Generate 'unsafe' set memory stub
+  //  Though just as safe as the other stubs, it takes an unscaled
+  //  size_t (# bytes) argument instead of an element count.
+  //
+  //  Input:
+  //    c_rarg0   - destination array address
+  //    c_rarg1   - byte count (size_t)
+  //    c_rarg2   - byte value
+  //
+  // Fills with the widest unit that both the destination and the size
+  // are aligned to, so that each unit is written atomically. With SVE
+  // every fill is a single predicated loop, without a scalar tail.
+  //
+  address generate_unsafe_setmemory() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "unsafe_setmemory");
+    address start = __ pc();
+    __ enter();   // required for proper stackwalking of RuntimeStub frame
+
+    // bump this on entry, not on exit:
+    inc_counter_np(SharedRuntime::_unsafe_set_memory_ctr);
+
+    const Register dest       = c_rarg0;
+    const Register size       = c_rarg1;
+    const Register byte_value = c_rarg2;
+    const Register value      = r3;
+    const Register count      = r4;
+    const Register idx        = r5;
+
+    Label L_exit;
+    Label L_fill[LogBytesPerLong + 1];
+
+    __ cbz(size, L_exit);
+
+    // Propagate the byte to all the bytes of the fill value.
+    if (UseSVE > 0) {
+      __ sve_dup(z0, __ B, byte_value);
+    } else {
+      __ andr(value, byte_value, 0xff);
+      __ bfi(value, value, 8, 8);   // 8 bit -> 16 bit
+      __ bfi(value, value, 16, 16); // 16 bit -> 32 bit
+      __ bfi(value, value, 32, 32); // 32 bit -> 64 bit
+    }
+
+    // Check for pointer & size alignment
+    __ orr(rscratch1, dest, size);
+    __ tst(rscratch1, 7);
+    __ br(Assembler::EQ, L_fill[LogBytesPerLong]);
+    __ tst(rscratch1, 3);
+    __ br(Assembler::EQ, L_fill[LogBytesPerInt]);
+    __ tst(rscratch1, 1);
+    __ br(Assembler::EQ, L_fill[LogBytesPerShort]);
+
+    for (int shift = 0; shift <= LogBytesPerLong; shift++) {
+      __ bind(L_fill[shift]);
+      {
+        UnsafeMemoryAccessMark umam(this, true, true);
+        __ lsr(count, size, shift);
+        if (UseSVE > 0) {
+          Assembler::SIMD_RegVariant T = Assembler::elemBytes_to_regVariant(1 << shift);
+          Label L_loop;
+          __ mov(idx, zr);
+          __ sve_whilelo(p0, T, idx, count);
+          __ bind(L_loop);
+          sve_store_elements(z0, p0, 1 << shift, Address(dest, idx, Address::lsl(shift)));
+          __ sve_inc(idx, T);
+          __ sve_whilelo(p0, T, idx, count);
+          __ br(Assembler::MI, L_loop); // while the first element is active
+        } else if (shift == LogBytesPerLong) {
+          __ fill_words(dest, count, value);
+        } else {
+          Label L_loop;
+          __ bind(L_loop);
+          switch (shift) {
+            case 0: __ strb(value, Address(__ post(dest, 1))); break;
+            case 1: __ strh(value, Address(__ post(dest, 2))); break;
+            case 2: __ strw(value, Address(__ post(dest, 4))); break;
+            default: ShouldNotReachHere();
+          }
+          __ subs(count, count, 1);
+          __ br(Assembler::NE, L_loop);
+        }
+      }
+      if (shift < LogBytesPerLong) {
+        __ b(L_exit);
+      }
+    }
+
+    __ bind(L_exit);
+    __ leave();   // required for proper stackwalking of RuntimeStub frame
+    __ ret(lr);
+
+    return start;
+  }
+
+
   address generate_data_cache_writeback() {
     const Register line        = c_rarg0;  // address of line to write back
 
@@ -2677,6 +2848,8 @@ class StubGenerator: public StubCodeGenerator {
     StubRoutines::_arrayof_jbyte_fill = generate_fill(T_BYTE, true, "arrayof_jbyte_fill");
     StubRoutines::_arrayof_jshort_fill = generate_fill(T_SHORT, true, "arrayof_jshort_fill");
     StubRoutines::_arrayof_jint_fill = generate_fill(T_INT, true, "arrayof_jint_fill");
+
+    StubRoutines::_unsafe_setmemory = generate_unsafe_setmemory();
   }
 
   void generate_math_stubs() { Unimplemented(); }
@@ -7305,6 +7478,166 @@ class StubGenerator: public StubCodeGenerator {
     return start;
   }
 
+  // In sun.security.util.math.intpoly.MontgomeryIntegerPolynomialP256,
+  // integers are represented as long[5], with BITS_PER_LIMB = 52.
+  // Multiply two 52-bit limbs, splitting the 104-bit product into its
+  // low and high 52 bits.
+  void mul_52(Register prod_lo, Register prod_hi, Register n, Register m) {
+    __ mul(prod_lo, n, m);
+    __ umulh(prod_hi, n, m);
+    __ extr(prod_hi, prod_hi, prod_lo, 52);
+    __ ubfx(prod_lo, prod_lo, 0, 52);
+  }
+
+  // Word-by-word Montgomery multiplication, r = a * b * 2^-260 (mod P),
+  // for the Montgomery friendly P256 modulus. This is the scalar
+  // equivalent of the AVX-512 IFMA stub on x86_64 and produces the same
+  // limbs: each row keeps the low and high halves of the partial products
+  // in separate accumulators, which are combined when the lowest limb is
+  // shifted out. NEON has no 64x64->128 bit multiply, so the general
+  // purpose mul/umulh pair is faster here than a vector implementation.
+  address generate_intpoly_montgomeryMult_P256() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "intpoly_montgomeryMult_P256");
+    address start = __ pc();
+    __ enter();
+    RegSet callee_saved = RegSet::range(r19, r28);
+    __ push(callee_saved, sp);
+
+    RegSetIterator<Register> regs = (RegSet::range(c_rarg0, r28) - r18_tls - rscratch1 - rscratch2).begin();
+
+    // Arguments
+    const Register a_limbs = *regs, b_limbs = *++regs, r_limbs = *++regs;
+
+    const int num_limbs = 5;
+    Register a[num_limbs], acc_lo[num_limbs], acc_hi[num_limbs], modulus[num_limbs];
+    for (int i = 0; i < num_limbs; i++) {
+      a[i] = *++regs;
+      acc_lo[i] = *++regs;
+      acc_hi[i] = *++regs;
+    }
+    // The modulus is 2^256 - 2^224 + 2^192 + 2^96 - 1; limb 2 is zero.
+    modulus[0] = *++regs;
+    modulus[1] = *++regs;
+    modulus[2] = noreg;
+    modulus[3] = *++regs;
+    modulus[4] = *++regs;
+    __ mov(modulus[0], (u8)0x000fffffffffffff);
+    __ mov(modulus[1], (u8)0x00000fffffffffff);
+    __ mov(modulus[3], (u8)0x0000001000000000);
+    __ mov(modulus[4], (u8)0x0000ffffffff0000);
+
+    // Limb i of b, and later the Montgomery factor of row i.
+    const Register n = *++regs;
+
+    __ ldp(a[0], a[1], Address(a_limbs, 0));
+    __ ldp(a[2], a[3], Address(a_limbs, 2 * sizeof (jlong)));
+    __ ldr(a[4], Address(a_limbs, 4 * sizeof (jlong)));
+
+    for (int i = 0; i < num_limbs; i++) {
+      // acc += a * b[i]
+      __ ldr(n, Address(b_limbs, i * sizeof (jlong)));
+      for (int j = 0; j < num_limbs; j++) {
+        if (i == 0) {
+          mul_52(acc_lo[j], acc_hi[j], a[j], n);
+        } else {
+          mul_52(rscratch1, acc_hi[j], a[j], n);
+          __ add(acc_lo[j], acc_lo[j], rscratch1);
+        }
+      }
+
+      // acc += modulus * n, which clears the low 52 bits of acc_lo[0]
+      // since modulus[0] == 2^52 - 1.
+      __ ubfx(n, acc_lo[0], 0, 52);
+      for (int j = 0; j < num_limbs; j++) {
+        if (modulus[j] == noreg) {
+          continue;
+        }
+        mul_52(rscratch1, rscratch2, modulus[j], n);
+        __ add(acc_lo[j], acc_lo[j], rscratch1);
+        __ add(acc_hi[j], acc_hi[j], rscratch2);
+      }
+
+      if (i == num_limbs - 1) {
+        break;
+      }
+
+      // Shift out the lowest limb, combining the high and low partial sums.
+      __ add(acc_hi[0], acc_hi[0], acc_lo[0], Assembler::LSR, 52);
+      for (int j = 0; j < num_limbs - 1; j++) {
+        __ add(acc_lo[j], acc_lo[j + 1], acc_hi[j]);
+      }
+      __ mov(acc_lo[num_limbs - 1], acc_hi[num_limbs - 1]);
+    }
+
+    // Last carry round: r[j] = mask52(acc_lo[j + 1]) + acc_hi[j] + (acc_lo[j] >> 52)
+    for (int j = 0; j < num_limbs; j++) {
+      __ add(acc_hi[j], acc_hi[j], acc_lo[j], Assembler::LSR, 52);
+      if (j < num_limbs - 1) {
+        __ ubfx(rscratch1, acc_lo[j + 1], 0, 52);
+        __ add(acc_hi[j], acc_hi[j], rscratch1);
+      }
+    }
+
+    __ stp(acc_hi[0], acc_hi[1], Address(r_limbs, 0));
+    __ stp(acc_hi[2], acc_hi[3], Address(r_limbs, 2 * sizeof (jlong)));
+    __ str(acc_hi[4], Address(r_limbs, 4 * sizeof (jlong)));
+
+    __ pop(callee_saved, sp);
+    __ leave();
+    __ ret(lr);
+
+    return start;
+  }
+
+  // a[i] = set ? b[i] : a[i] for all limbs of a.
+  // Must be constant time: no branches and the same memory accesses
+  // whatever the value of set. Branching on the number of limbs is fine,
+  // as it is fixed for each IntegerPolynomial and not a secret.
+  address generate_intpoly_assign() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "intpoly_assign");
+    address start = __ pc();
+    __ enter();
+
+    // Arguments
+    const Register set = c_rarg0, a_limbs = c_rarg1, b_limbs = c_rarg2, length = c_rarg3;
+
+    const FloatRegister mask = v0, a = v1, b = v2;
+    Label L_pairs, L_tail, L_done;
+
+    // set is 0 or 1, expand it into a mask of all zeros or all ones.
+    __ sbfx(set, set, 0, 1);
+    __ dup(mask, __ T2D, set);
+
+    // Two limbs at a time.
+    __ subsw(length, length, 2);
+    __ br(Assembler::LT, L_tail);
+    __ bind(L_pairs);
+    __ ldrq(a, Address(a_limbs));
+    __ ldrq(b, __ post(b_limbs, 2 * sizeof (jlong)));
+    __ bit(a, __ T16B, b, mask);
+    __ strq(a, __ post(a_limbs, 2 * sizeof (jlong)));
+    __ subsw(length, length, 2);
+    __ br(Assembler::GE, L_pairs);
+
+    // length is now -1 if there is one limb left, -2 otherwise.
+    __ bind(L_tail);
+    __ tbz(length, 0, L_done);
+    __ ldr(rscratch1, Address(a_limbs));
+    __ ldr(rscratch2, Address(b_limbs));
+    __ eor(rscratch2, rscratch2, rscratch1);
+    __ andr(rscratch2, rscratch2, set);
+    __ eor(rscratch1, rscratch1, rscratch2);
+    __ str(rscratch1, Address(a_limbs));
+
+    __ bind(L_done);
+    __ leave();
+    __ ret(lr);
+
+    return start;
+  }
+
 #if INCLUDE_JFR
 
   static void jfr_prologue(address the_pc, MacroAssembler* _masm, Register thread) {
@@ -8458,6 +8791,11 @@ class StubGenerator: public StubCodeGenerator {
       StubRoutines::_poly1305_processBlocks = generate_poly1305_processBlocks();
     }
 
+    if (UseIntPolyIntrinsics) {
+      StubRoutines::_intpoly_montgomeryMult_P256 = generate_intpoly_montgomeryMult_P256();
+      StubRoutines::_intpoly_assign = generate_intpoly_assign();
+    }
+
 #if defined (LINUX) && !defined (__ARM_FEATURE_ATOMICS)
 
     generate_atomic_entry_points();
@@ -8589,9 +8927,53 @@ class StubGenerator: public StubCodeGenerator {
     if (UseAdler32Intrinsics) {
       StubRoutines::_updateBytesAdler32 = generate_updateBytesAdler32();
     }
+
+#ifdef COMPILER2
+    generate_vector_math_stubs();
+#endif // COMPILER2
 #endif // COMPILER2_OR_JVMCI
   }
 
+#ifdef COMPILER2
+  void generate_vector_math_stubs() {
+    // Get native vector math stub routine addresses
+    void* libsleef = nullptr;
+    char ebuf[1024];
+    char dll_name[JVM_MAXPATHLEN];
+    if (os::dll_locate_lib(dll_name, sizeof(dll_name), Arguments::get_dll_dir(), "sleef")) {
+      libsleef = os::dll_load(dll_name, ebuf, sizeof ebuf);
+    }
+    if (libsleef == nullptr) {
+      return;
+    }
+    // SLEEF method naming convention
+    //   All the methods are named as Sleef_<op><T><N>_<U>advsimd
+    //   Where:
+    //      <T> is f for vector float and d for vector double operations
+    //      <N> is the number of elements in the 128 bit vector, 4 or 2
+    //      <U> is the error bound, u10 for 1.0 ULP, the accuracy required
+    //          by java.lang.Math. hypot is only available with 0.5 ULP.
+    //      e.g. Sleef_expf4_u10advsimd is the method for computing 4 element
+    //           vector float exp using NEON instructions
+    //
+    // Only the NEON vector sizes use these stubs; the vector calling
+    // convention does not support SVE scalable vectors.
+    log_info(library)("Loaded library %s, handle " INTPTR_FORMAT, JNI_LIB_PREFIX "sleef" JNI_LIB_SUFFIX, p2i(libsleef));
+    for (int op = 0; op < VectorSupport::NUM_SVML_OP; op++) {
+      int vop = VectorSupport::VECTOR_OP_SVML_START + op;
+      const char* ulp = (vop == VectorSupport::VECTOR_OP_HYPOT) ? "u05" : "u10";
+
+      // A 64 bit float vector uses the lower half of the 128 bit routine.
+      snprintf(ebuf, sizeof(ebuf), "Sleef_%sf4_%sadvsimd", VectorSupport::svmlname[op], ulp);
+      StubRoutines::_vector_f_math[VectorSupport::VEC_SIZE_64][op] = (address)os::dll_lookup(libsleef, ebuf);
+      StubRoutines::_vector_f_math[VectorSupport::VEC_SIZE_128][op] = (address)os::dll_lookup(libsleef, ebuf);
+
+      snprintf(ebuf, sizeof(ebuf), "Sleef_%sd2_%sadvsimd", VectorSupport::svmlname[op], ulp);
+      StubRoutines::_vector_d_math[VectorSupport::VEC_SIZE_128][op] = (address)os::dll_lookup(libsleef, ebuf);
+    }
+  }
+#endif // COMPILER2
+
  public:
   StubGenerator(CodeBuffer* code, StubsKind kind) : StubCodeGenerator(code) {
     switch(kind) {
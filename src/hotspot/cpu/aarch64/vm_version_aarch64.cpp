@@ -504,6 +504,10 @@ void VM_Version::initialize() {
     UseMontgomerySquareIntrinsic = true;
   }
 
+  if (FLAG_IS_DEFAULT(UseVectorizedHashCodeIntrinsic)) {
+    FLAG_SET_DEFAULT(UseVectorizedHashCodeIntrinsic, true);
+  }
+
   if (UseSVE > 0) {
     if (FLAG_IS_DEFAULT(MaxVectorSize)) {
       MaxVectorSize = _initial_sve_vector_length;
@@ -565,6 +569,10 @@ void VM_Version::initialize() {
   if (FLAG_IS_DEFAULT(UsePoly1305Intrinsics)) {
     FLAG_SET_DEFAULT(UsePoly1305Intrinsics, true);
   }
+
+  if (FLAG_IS_DEFAULT(UseIntPolyIntrinsics)) {
+    FLAG_SET_DEFAULT(UseIntPolyIntrinsics, true);
+  }
 #endif
 
   _spin_wait = get_spin_wait_desc();
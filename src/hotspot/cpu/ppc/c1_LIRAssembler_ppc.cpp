@@ -195,7 +195,7 @@ int LIR_Assembler::emit_unwind_handler() {
   _masm->block_comment("Unwind handler");
 
   int offset = code_offset();
-  bool preserve_exception = method()->is_synchronized() || compilation()->env()->dtrace_method_probes();
+  bool preserve_exception = method()->is_synchronized() || compilation()->env()->method_probes();
   const Register Rexception = R3 /*LIRGenerator::exceptionOopOpr()*/, Rexception_save = R31;
 
   // Fetch the exception from TLS and clear out exception related thread state.
@@ -217,7 +217,7 @@ int LIR_Assembler::emit_unwind_handler() {
     __ bind(*stub->continuation());
   }
 
-  if (compilation()->env()->dtrace_method_probes()) {
+  if (compilation()->env()->method_probes()) {
     Unimplemented();
   }
 
@@ -1711,6 +1711,65 @@ void C2_MacroAssembler::string_equals(Register a1, Register a2,
   BLOCK_COMMENT("} string_equals");
 }
 
+// Inflate byte[] array to char[].
+// Intrinsic for java.lang.StringLatin1.inflate(byte[] src, int srcOff, char[] dst, int dstOff, int len)
+// Clobbers: src, dst, len, tmp
+void C2_MacroAssembler::byte_array_inflate(Register src, Register dst, Register len, Register tmp) {
+  Label LOOP, DONE;
+  assert_different_registers(src, dst, len, tmp);
+
+  BLOCK_COMMENT("byte_array_inflate {");
+  beqz(len, DONE);
+  bind(LOOP);
+  lbu(tmp, Address(src));
+  addi(src, src, 1);
+  addi(len, len, -1);
+  sh(tmp, Address(dst));
+  addi(dst, dst, 2);
+  bnez(len, LOOP);
+  bind(DONE);
+  BLOCK_COMMENT("} byte_array_inflate");
+}
+
+// Intrinsic for java.lang.StringCoding.countPositives
+// result: the number of leading non-negative bytes in ary.
+// Unless unaligned accesses are to be avoided, the bytes are checked a word at
+// a time for a set sign bit, and one at a time only from the first word that has one.
+// Clobbers: ary, tmp1, tmp2
+void C2_MacroAssembler::count_positives(Register ary, Register len, Register result,
+                                        Register tmp1, Register tmp2) {
+  Label LOOP, TAIL, DONE;
+  assert_different_registers(ary, len, result, tmp1, tmp2, t0);
+
+  BLOCK_COMMENT("count_positives {");
+  mv(result, zr);
+
+  if (!AvoidUnalignedAccesses) {
+    mv(tmp2, 0x8080808080808080);
+    bind(LOOP);
+    sub(tmp1, len, result);
+    addi(tmp1, tmp1, -wordSize);
+    bltz(tmp1, TAIL);
+    ld(tmp1, Address(ary));
+    andr(tmp1, tmp1, tmp2);
+    bnez(tmp1, TAIL);
+    addi(ary, ary, wordSize);
+    addi(result, result, wordSize);
+    j(LOOP);
+  }
+
+  bind(TAIL);
+  bge(result, len, DONE);
+  lb(tmp1, Address(ary));
+  bltz(tmp1, DONE);
+  addi(ary, ary, 1);
+  addi(result, result, 1);
+  j(TAIL);
+
+  bind(DONE);
+  BLOCK_COMMENT("} count_positives");
+}
+
 // jdk.internal.util.ArraysSupport.vectorizedHashCode
 void C2_MacroAssembler::arrays_hashcode(Register ary, Register cnt, Register result,
                                         Register tmp1, Register tmp2, Register tmp3,
@@ -95,6 +95,12 @@
   void string_equals(Register r1, Register r2,
                      Register result, Register cnt1);
 
+  void byte_array_inflate(Register src, Register dst,
+                          Register len, Register tmp);
+
+  void count_positives(Register ary, Register len,
+                       Register result, Register tmp1, Register tmp2);
+
   // refer to conditional_branches and float_conditional_branches
   static const int bool_test_bits = 3;
   static const int neg_cond_bits = 2;
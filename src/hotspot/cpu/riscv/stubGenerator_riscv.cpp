@@ -5103,6 +5103,109 @@ class StubGenerator: public StubCodeGenerator {
     return (address) start;
   }
 
+  // Adds the next 8 bytes at buff to s1 and s2 and advances buff past them.
+  void generate_updateBytesAdler32_accum(Register s1, Register s2, Register buff, Register temp) {
+    for (int i = 0; i < 8; i++) {
+      __ lbu(temp, Address(buff, i));
+      __ add(s1, s1, temp);
+      __ add(s2, s2, s1);
+    }
+    __ addi(buff, buff, 8);
+  }
+
+  /***
+   *  Arguments:
+   *
+   *  Inputs:
+   *   c_rarg0   - int   adler
+   *   c_rarg1   - byte* buff
+   *   c_rarg2   - int   len
+   *
+   * Output:
+   *   c_rarg0   - int adler result
+   */
+  address generate_updateBytesAdler32() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "updateBytesAdler32");
+    address start = __ pc();
+
+    Label L_nmax, L_nmax_loop, L_by8, L_by8_loop, L_by1_loop, L_do_mod;
+
+    // Aliases
+    Register adler = c_rarg0;
+    Register s1    = c_rarg0;
+    Register s2    = c_rarg3;
+    Register buff  = c_rarg1;
+    Register len   = c_rarg2;
+    Register nmax  = c_rarg4;
+    Register base  = c_rarg5;
+    Register count = c_rarg6;
+    Register step  = c_rarg7;
+    Register temp  = x28;
+
+    // Max number of bytes we can process before having to take the mod
+    // 0x15B0 is 5552 in decimal, the largest n such that 255n(n+1)/2 + (n+1)(BASE-1) <= 2^32-1
+    const uint64_t BASE = 0xfff1;
+    const uint64_t NMAX = 0x15B0;
+
+    __ mv(base, BASE);
+    __ mv(nmax, NMAX);
+    __ mv(step, 8);
+
+    // s1 is initialized to the lower 16 bits of adler
+    // s2 is initialized to the upper 16 bits of adler
+    __ srliw(s2, adler, 16);
+    __ zero_extend(s1, adler, 16);
+
+    // Fewer than 8 bytes are handled by the byte loop only
+    __ bltu(len, step, L_by1_loop);
+
+    __ bind(L_nmax);
+    __ bltu(len, nmax, L_by8);
+    __ sub(len, len, nmax);
+    __ mv(count, nmax);
+
+    __ bind(L_nmax_loop);
+    generate_updateBytesAdler32_accum(s1, s2, buff, temp);
+    __ addi(count, count, -8);
+    __ bnez(count, L_nmax_loop);
+
+    // s1 = s1 % BASE, s2 = s2 % BASE
+    __ remuw(s1, s1, base);
+    __ remuw(s2, s2, base);
+    __ j(L_nmax);
+
+    __ bind(L_by8);
+    __ bltu(len, step, L_by1_loop);
+
+    __ bind(L_by8_loop);
+    generate_updateBytesAdler32_accum(s1, s2, buff, temp);
+    __ addi(len, len, -8);
+    __ bgeu(len, step, L_by8_loop);
+
+    // Less than 8 bytes are left
+    __ bind(L_by1_loop);
+    __ beqz(len, L_do_mod);
+    __ lbu(temp, Address(buff, 0));
+    __ addi(buff, buff, 1);
+    __ add(s1, s1, temp);
+    __ add(s2, s2, s1);
+    __ addi(len, len, -1);
+    __ j(L_by1_loop);
+
+    __ bind(L_do_mod);
+    __ remuw(s1, s1, base);
+    __ remuw(s2, s2, base);
+
+    // Combine lower bits and higher bits
+    __ slli(s2, s2, 16);
+    __ orr(c_rarg0, s1, s2);
+
+    __ ret();
+
+    return start;
+  }
+
 #endif // COMPILER2_OR_JVMCI
 
 #ifdef COMPILER2
@@ -5694,6 +5797,10 @@ static const int64_t right_3_bits = right_n_bits(3);
       StubRoutines::_sha1_implCompressMB   = generate_sha1_implCompress(true, "sha1_implCompressMB");
     }
 
+    if (UseAdler32Intrinsics) {
+      StubRoutines::_updateBytesAdler32 = generate_updateBytesAdler32();
+    }
+
 #endif // COMPILER2_OR_JVMCI
   }
 
@@ -205,7 +205,7 @@ int LIR_Assembler::emit_unwind_handler() {
 
   __ bind(_unwind_handler_entry);
   __ verify_not_null_oop(Z_EXC_OOP);
-  if (method()->is_synchronized() || compilation()->env()->dtrace_method_probes()) {
+  if (method()->is_synchronized() || compilation()->env()->method_probes()) {
     __ lgr_if_needed(exception_oop_callee_saved, Z_EXC_OOP); // Preserve the exception.
   }
 
@@ -220,7 +220,7 @@ int LIR_Assembler::emit_unwind_handler() {
     __ bind(*stub->continuation());
   }
 
-  if (compilation()->env()->dtrace_method_probes()) {
+  if (compilation()->env()->method_probes()) {
     ShouldNotReachHere(); // Not supported.
 #if 0
     __ mov(rdi, r15_thread);
@@ -229,7 +229,7 @@ int LIR_Assembler::emit_unwind_handler() {
 #endif
   }
 
-  if (method()->is_synchronized() || compilation()->env()->dtrace_method_probes()) {
+  if (method()->is_synchronized() || compilation()->env()->method_probes()) {
     __ lgr_if_needed(Z_EXC_OOP, exception_oop_callee_saved);  // Restore the exception.
   }
 
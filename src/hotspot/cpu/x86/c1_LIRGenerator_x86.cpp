@@ -1550,8 +1550,10 @@ void LIRGenerator::do_If(If* x) {
   }
 
   __ cmp(lir_cond(cond), left, right);
-  // Generate branch profiling. Profiling code doesn't kill flags.
-  profile_branch(x, cond);
+  // Generate branch profiling. Profiling code doesn't kill flags. Sampled
+  // profiling compares again, which it can't do after a long compare that
+  // destroys left.
+  profile_branch(x, cond, tag == longTag ? LIR_OprFact::illegalOpr : left, right);
   move_to_phi(x->state());
   if (x->x()->type()->is_float_kind()) {
     __ branch(lir_cond(cond), x->tsux(), x->usux());
@@ -640,19 +640,25 @@ void C2_MacroAssembler::fast_lock_lightweight(Register obj, Register box, Regist
   { // Handle inflated monitor.
     bind(inflated);
 
-    const Register tagged_monitor = mark;
+    if (UseObjectMonitorTable) {
+      // The mark word does not refer to the ObjectMonitor, let the runtime
+      // look it up. ZF == 0 from the monitor bit test.
+      jmp(slow_path);
+    } else {
+      const Register tagged_monitor = mark;
 
-    // CAS owner (null => current thread).
-    xorptr(rax_reg, rax_reg);
-    lock(); cmpxchgptr(thread, Address(tagged_monitor, OM_OFFSET_NO_MONITOR_VALUE_TAG(owner)));
-    jccb(Assembler::equal, locked);
+      // CAS owner (null => current thread).
+      xorptr(rax_reg, rax_reg);
+      lock(); cmpxchgptr(thread, Address(tagged_monitor, OM_OFFSET_NO_MONITOR_VALUE_TAG(owner)));
+      jccb(Assembler::equal, locked);
 
-    // Check if recursive.
-    cmpptr(thread, rax_reg);
-    jccb(Assembler::notEqual, slow_path);
+      // Check if recursive.
+      cmpptr(thread, rax_reg);
+      jccb(Assembler::notEqual, slow_path);
 
-    // Recursive.
-    increment(Address(tagged_monitor, OM_OFFSET_NO_MONITOR_VALUE_TAG(recursions)));
+      // Recursive.
+      increment(Address(tagged_monitor, OM_OFFSET_NO_MONITOR_VALUE_TAG(recursions)));
+    }
   }
 
   bind(locked);
@@ -706,6 +712,7 @@ void C2_MacroAssembler::fast_unlock_lightweight(Register obj, Register reg_rax,
 
   Label& push_and_slow_path = stub == nullptr ? dummy : stub->push_and_slow_path();
   Label& check_successor = stub == nullptr ? dummy : stub->check_successor();
+  Label& slow_path = stub == nullptr ? dummy : stub->slow_path_continuation();
 
   { // Lightweight Unlock
 
@@ -758,6 +765,14 @@ void C2_MacroAssembler::fast_unlock_lightweight(Register obj, Register reg_rax,
 
     bind(inflated);
 
+    if (UseObjectMonitorTable) {
+      // The mark word does not refer to the ObjectMonitor, let the runtime
+      // look it up. Restore the held monitor count first.
+      increment(Address(thread, JavaThread::held_monitor_count_offset()));
+      // increment will always result in ZF = 0 (no overflows).
+      jmp(slow_path);
+    }
+
     // mark contains the tagged ObjectMonitor*.
     const Register monitor = mark;
 
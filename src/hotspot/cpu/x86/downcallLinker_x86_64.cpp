@@ -257,7 +257,16 @@ void DowncallLinker::StubGenerator::generate() {
 
   //////////////////////////////////////////////////////////////////////////////
 
-  if (_captured_state_mask != 0) {
+  if (_captured_state_mask == DowncallLinker::ERRNO) {
+    __ block_comment("{ save errno");
+    // Read errno through the address cached in the thread, neither the return
+    // value nor any other register but the scratch registers is touched.
+    __ movptr(rscratch1, Address(r15_thread, JavaThread::errno_address_offset()));
+    __ movl(rscratch1, Address(rscratch1, 0));
+    __ movptr(rscratch2, Address(rsp, locs.data_offset(StubLocations::CAPTURED_STATE_BUFFER)));
+    __ movl(Address(rscratch2, DowncallLinker::captured_errno_offset_in_bytes()), rscratch1);
+    __ block_comment("} save errno");
+  } else if (_captured_state_mask != 0) {
     __ block_comment("{ save thread local");
 
     if (should_save_return_value) {
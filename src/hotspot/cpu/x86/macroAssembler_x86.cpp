@@ -4656,6 +4656,14 @@ void MacroAssembler::check_klass_subtype_slow_path(Register sub_klass,
                                                    Label* L_success,
                                                    Label* L_failure,
                                                    bool set_cond_codes) {
+#ifdef _LP64
+  if (UseSecondarySupersTable) {
+    hashed_check_klass_subtype_slow_path(sub_klass, super_klass, temp_reg, temp2_reg,
+                                         L_success, L_failure, set_cond_codes);
+    return;
+  }
+#endif // _LP64
+
   assert_different_registers(sub_klass, super_klass, temp_reg);
   if (temp2_reg != noreg)
     assert_different_registers(sub_klass, super_klass, temp_reg, temp2_reg);
@@ -4996,6 +5004,128 @@ void MacroAssembler::lookup_secondary_supers_table_slow_path(Register r_super_kl
   }
 }
 
+// As check_klass_subtype_slow_path, but looks super_klass up in the hashed
+// secondary supers of sub_klass, like lookup_secondary_supers_table does for
+// a constant super_klass. The secondary super cache is not updated.
+void MacroAssembler::hashed_check_klass_subtype_slow_path(Register sub_klass,
+                                                          Register super_klass,
+                                                          Register temp_reg,
+                                                          Register temp2_reg,
+                                                          Label* L_success,
+                                                          Label* L_failure,
+                                                          bool set_cond_codes) {
+  assert_different_registers(sub_klass, super_klass, temp_reg);
+  if (temp2_reg != noreg)
+    assert_different_registers(sub_klass, super_klass, temp_reg, temp2_reg);
+#define IS_A_TEMP(reg) ((reg) == temp_reg || (reg) == temp2_reg)
+
+  Label L_fallthrough, L_hit, L_miss;
+  int label_nulls = 0;
+  if (L_success == nullptr)   { L_success   = &L_fallthrough; label_nulls++; }
+  if (L_failure == nullptr)   { L_failure   = &L_fallthrough; label_nulls++; }
+  assert(label_nulls <= 1, "at most one null in the batch");
+
+  const Register
+    r_super_klass  = rax,
+    r_array_base   = rbx,
+    r_array_length = rcx,
+    r_array_index  = rdx,
+    r_sub_klass    = noreg,
+    r_bitmap       = r11,
+    result         = noreg;
+
+  LOOKUP_SECONDARY_SUPERS_TABLE_REGISTERS;
+
+  BLOCK_COMMENT("hashed_check_klass_subtype_slow_path {");
+
+  assert(sub_klass != rax, "killed reg"); // killed by mov(rax, super)
+  assert(sub_klass != rcx, "killed reg"); // killed by the home slot
+
+  // Get super_klass value into rax (even if it was in one of the other registers).
+  bool pushed_rax = false, pushed_rbx = false, pushed_rcx = false,
+       pushed_rdx = false, pushed_rdi = false, pushed_r11 = false;
+  if (super_klass != rax) {
+    if (!IS_A_TEMP(rax)) { push(rax); pushed_rax = true; }
+    mov(rax, super_klass);
+  }
+  if (!IS_A_TEMP(rbx)) { push(rbx); pushed_rbx = true; }
+  if (!IS_A_TEMP(rcx)) { push(rcx); pushed_rcx = true; }
+  if (!IS_A_TEMP(rdx)) { push(rdx); pushed_rdx = true; }
+  if (!IS_A_TEMP(rdi)) { push(rdi); pushed_rdi = true; }
+  if (!IS_A_TEMP(r11)) { push(r11); pushed_r11 = true; }
+
+  auto unspill = [&]() {
+    if (pushed_r11)  pop(r11);
+    if (pushed_rdi)  pop(rdi);
+    if (pushed_rdx)  pop(rdx);
+    if (pushed_rcx)  pop(rcx);
+    if (pushed_rbx)  pop(rbx);
+    if (pushed_rax)  pop(rax);
+  };
+
+  // sub_klass may be one of the registers loaded here.
+  if (sub_klass == r_bitmap) {
+    movptr(r_array_base, Address(sub_klass, Klass::secondary_supers_offset()));
+    movq(r_bitmap, Address(sub_klass, Klass::bitmap_offset()));
+  } else {
+    movq(r_bitmap, Address(sub_klass, Klass::bitmap_offset()));
+    movptr(r_array_base, Address(sub_klass, Klass::secondary_supers_offset()));
+  }
+
+  // First check the bitmap to see if super_klass might be present. If
+  // the bit of its home slot is zero, we are certain that super_klass is
+  // not one of the secondary supers.
+  movzbl(rcx, Address(r_super_klass, Klass::hash_slot_offset()));
+  btq(r_bitmap, rcx);
+  jcc(Assembler::carryClear, L_miss);
+
+  // Get the first array index that can contain super_klass into
+  // r_array_index, the population count of the bitmap bits up to and
+  // including the home slot.
+  // NB! r_array_index is off by 1. It is compensated by keeping r_array_base off by 1 word.
+  movq(r_array_index, r_bitmap);
+  xorl(rcx, Klass::SECONDARY_SUPERS_TABLE_MASK); // 63 - slot
+  shlq(r_array_index);
+  xorl(rcx, Klass::SECONDARY_SUPERS_TABLE_MASK); // slot
+  // Rotate the bitmap so that the next bit to test is in Bit 1.
+  rorq(r_bitmap);
+  population_count(r_array_index, r_array_index, rcx, rdi);
+
+  cmpq(r_super_klass, Address(r_array_base, r_array_index, Address::times_8));
+  jcc(Assembler::equal, L_hit);
+
+  // Is there another entry to check? Consult the bitmap.
+  btq(r_bitmap, 1);
+  jcc(Assembler::carryClear, L_miss);
+
+  lookup_secondary_supers_table_slow_path(r_super_klass, r_array_base, r_array_index, r_bitmap,
+                                          r_array_length, rdi, &L_hit, &L_miss);
+
+  bind(L_miss);
+  if (set_cond_codes) {
+    // Special hack for the AD files:  rdi is guaranteed non-zero.
+    assert(!pushed_rdi, "rdi must be left non-null");
+    movl(rdi, 1);
+    testptr(rax, rax); // super_klass is not null, set NZ
+  }
+  unspill();
+  jmp(*L_failure);
+
+  bind(L_hit);
+  if (set_cond_codes) {
+    cmpptr(rax, rax); // set Z
+  }
+  unspill();
+  if (L_success != &L_fallthrough) {
+    jmp(*L_success);
+  }
+
+#undef IS_A_TEMP
+
+  bind(L_fallthrough);
+  BLOCK_COMMENT("} hashed_check_klass_subtype_slow_path");
+}
+
 struct VerifyHelperArguments {
   Klass* _super;
   Klass* _sub;
@@ -637,7 +637,8 @@ class MacroAssembler: public Assembler {
   // The rest of the type check; must be wired to a corresponding fast path.
   // It does not repeat the fast path logic, so don't use it standalone.
   // The temp_reg and temp2_reg can be noreg, if no temps are available.
-  // Updates the sub's secondary super cache as necessary.
+  // Updates the sub's secondary super cache as necessary, unless the hashed
+  // lookup of hashed_check_klass_subtype_slow_path is used (UseSecondarySupersTable).
   // If set_cond_codes, condition codes will be Z on success, NZ on failure.
   void check_klass_subtype_slow_path(Register sub_klass,
                                      Register super_klass,
@@ -61,7 +61,14 @@ void SharedRuntime::inline_check_hashcode_from_object_header(MacroAssembler* mas
   __ movptr(result, Address(obj_reg, oopDesc::mark_offset_in_bytes()));
 
 
-  if (LockingMode == LM_LIGHTWEIGHT) {
+  if (LockingMode == LM_LIGHTWEIGHT && UseObjectMonitorTable) {
+    // The mark word of an inflated object keeps the hash, check if marked.
+    // notptr does not change the flags set by testptr.
+    __ notptr(result);
+    __ testptr(result, markWord::lock_mask_in_place);
+    __ notptr(result);
+    __ jcc(Assembler::zero, slowCase);
+  } else if (LockingMode == LM_LIGHTWEIGHT) {
     // check if monitor
     __ testptr(result, markWord::monitor_value);
     __ jcc(Assembler::notZero, slowCase);
@@ -4293,6 +4293,8 @@ void StubGenerator::generate_compiler_stubs() {
     StubRoutines::_sha512_implCompressMB = generate_sha512_implCompress(true, "sha512_implCompressMB");
   }
 
+  generate_sha3_stubs();
+
   if (UseBASE64Intrinsics) {
     if(VM_Version::supports_avx2()) {
       StubRoutines::x86::_avx2_shuffle_base64 = base64_avx2_shuffle_addr();
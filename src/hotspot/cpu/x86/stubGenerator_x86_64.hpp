@@ -325,6 +325,17 @@ class StubGenerator: public StubCodeGenerator {
   address generate_shuffle_byte_flip_mask();
   address generate_pshuffle_byte_flip_mask();
 
+  // SHA3 stubs and helper functions
+  void generate_sha3_stubs();
+  // block_size, ofs and limit are used for multi-block byte array.
+  // int com.sun.security.provider.SHA3.implCompressMultiBlock(byte[] b, int ofs, int limit)
+  address generate_sha3_implCompress(bool multi_block, const char *name);
+  void sha3_keccak_round(const XMMRegister in[], const XMMRegister out[],
+                         const XMMRegister rho[], XMMRegister rotate_m1,
+                         XMMRegister rotate_1, XMMRegister rotate_2,
+                         XMMRegister tmp0, XMMRegister tmp1, XMMRegister tmp2,
+                         Register consts, const Address& round_const);
+
 
   // AES intrinsic stubs
 
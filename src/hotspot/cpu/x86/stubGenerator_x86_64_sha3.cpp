@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "asm/assembler.hpp"
+#include "asm/assembler.inline.hpp"
+#include "runtime/stubRoutines.hpp"
+#include "macroAssembler_x86.hpp"
+#include "stubGenerator_x86_64.hpp"
+
+#define __ _masm->
+
+#ifdef PRODUCT
+#define BLOCK_COMMENT(str) /* nothing */
+#else
+#define BLOCK_COMMENT(str) __ block_comment(str)
+#endif // PRODUCT
+
+#define BIND(label) bind(label); BLOCK_COMMENT(#label ":")
+
+// Constants
+
+// The Keccak state of 25 64-bit lanes is kept in five zmm registers, one
+// row of five lanes A[0..4][y] per register, in qwords 0 to 4. The upper
+// three qwords of each register hold garbage that never moves into the
+// lower five.
+ATTRIBUTE_ALIGNED(64) static const uint64_t SHA3_CONSTS[] = {
+    // Rotation counts for rho, one row of the state per 64 bytes.
+    0, 1, 62, 28, 27, 0, 0, 0,
+    36, 44, 6, 55, 20, 0, 0, 0,
+    3, 10, 43, 25, 39, 0, 0, 0,
+    41, 45, 15, 21, 8, 0, 0, 0,
+    18, 2, 61, 56, 14, 0, 0, 0,
+
+    // Indexes for the vpermi2q instructions of pi, one row of the new
+    // state per 64 bytes. Lanes 0 to 4 are taken from rows 0 to 4.
+    0, 9, 2, 11, 4, 0, 0, 0,
+    3, 12, 0, 9, 2, 0, 0, 0,
+    1, 10, 3, 12, 0, 0, 0, 0,
+    4, 8, 1, 10, 3, 0, 0, 0,
+    2, 11, 4, 8, 1, 0, 0, 0,
+
+    // Indexes rotating the lanes of a row by -1, 1 and 2 for theta and chi.
+    4, 0, 1, 2, 3, 0, 0, 0,
+    1, 2, 3, 4, 0, 0, 0, 0,
+    2, 3, 4, 0, 1, 0, 0, 0,
+
+    // Round constants for iota.
+    0x0000000000000001UL, 0x0000000000008082UL, 0x800000000000808AUL,
+    0x8000000080008000UL, 0x000000000000808BUL, 0x0000000080000001UL,
+    0x8000000080008081UL, 0x8000000000008009UL, 0x000000000000008AUL,
+    0x0000000000000088UL, 0x0000000080008009UL, 0x000000008000000AUL,
+    0x000000008000808BUL, 0x800000000000008BUL, 0x8000000000008089UL,
+    0x8000000000008003UL, 0x8000000000008002UL, 0x8000000000000080UL,
+    0x000000000000800AUL, 0x800000008000000AUL, 0x8000000080008081UL,
+    0x8000000000008080UL, 0x0000000080000001UL, 0x8000000080008008UL
+};
+static address sha3_consts() {
+  return (address)SHA3_CONSTS;
+}
+
+static const int sha3_rho_offset          = 0;
+static const int sha3_pi_offset           = 5 * 64;
+static const int sha3_rotate_offset       = 10 * 64;
+static const int sha3_round_consts_offset = 13 * 64;
+
+void StubGenerator::generate_sha3_stubs() {
+  if (UseSHA3Intrinsics) {
+    StubRoutines::_sha3_implCompress   = generate_sha3_implCompress(false, "sha3_implCompress");
+    StubRoutines::_sha3_implCompressMB = generate_sha3_implCompress(true,  "sha3_implCompressMB");
+  }
+}
+
+// One round of Keccak-f[1600], taking the state from the registers in and
+// leaving the result in the registers out. The lanes of in are clobbered.
+// The constants table is at consts, and the round constant for iota at
+// round_const.
+void StubGenerator::sha3_keccak_round(const XMMRegister in[], const XMMRegister out[],
+                                      const XMMRegister rho[], XMMRegister rotate_m1,
+                                      XMMRegister rotate_1, XMMRegister rotate_2,
+                                      XMMRegister tmp0, XMMRegister tmp1, XMMRegister tmp2,
+                                      Register consts, const Address& round_const) {
+  const int vlen = Assembler::AVX_512bit;
+
+  // theta: C[x] = A[x][0] ^ ... ^ A[x][4], A[x][y] ^= C[x - 1] ^ rol(C[x + 1], 1)
+  __ evmovdquq(tmp0, in[0], vlen);
+  __ vpternlogq(tmp0, 0x96, in[1], in[2], vlen);
+  __ vpternlogq(tmp0, 0x96, in[3], in[4], vlen);
+  __ vpermq(tmp1, rotate_m1, tmp0, vlen);
+  __ vpermq(tmp2, rotate_1, tmp0, vlen);
+  __ evprolq(tmp2, tmp2, 1, vlen);
+  for (int y = 0; y < 5; y++) {
+    __ vpternlogq(in[y], 0x96, tmp1, tmp2, vlen);
+  }
+
+  // rho
+  for (int y = 0; y < 5; y++) {
+    __ evprolvq(in[y], in[y], rho[y], vlen);
+  }
+
+  // pi: B[y][2x + 3y] = A[x][y], so lane x of new row y is lane x + 3y of
+  // row x. Each row is gathered from the five rows with three masked
+  // vpermi2q, which keep the indexes of the lanes not written yet.
+  for (int y = 0; y < 5; y++) {
+    __ evmovdquq(out[y], Address(consts, sha3_pi_offset + y * 64), vlen);
+    __ evpermi2q(out[y], k3, in[0], in[1], true, vlen);
+    __ evpermi2q(out[y], k4, in[2], in[3], true, vlen);
+    __ evpermi2q(out[y], k5, in[4], in[4], true, vlen);
+  }
+
+  // chi: A[x][y] ^= ~A[x + 1][y] & A[x + 2][y]
+  for (int y = 0; y < 5; y++) {
+    __ vpermq(tmp0, rotate_1, out[y], vlen);
+    __ vpermq(tmp1, rotate_2, out[y], vlen);
+    __ vpternlogq(out[y], 0xD2, tmp0, tmp1, vlen);
+  }
+
+  // iota
+  __ evpxorq(out[0], k2, out[0], round_const, true, vlen);
+}
+
+// Arguments:
+//
+// Inputs:
+//   c_rarg0   - byte[]  source+offset
+//   c_rarg1   - long[]  SHA3.state
+//   c_rarg2   - int     block_size
+//   c_rarg3   - int     offset
+//   c_rarg4   - int     limit
+//
+address StubGenerator::generate_sha3_implCompress(bool multi_block, const char *name) {
+  assert(VM_Version::supports_evex() && VM_Version::supports_avx512bw(), "");
+  assert(VM_Version::supports_bmi2(), "");
+  __ align(CodeEntryAlignment);
+  StubCodeMark mark(this, "StubRoutines", name);
+  address start = __ pc();
+
+  const Register buf        = c_rarg0;
+  const Register state      = c_rarg1;
+  const Register block_size = c_rarg2;
+  const Register ofs        = c_rarg3;
+#ifndef _WIN64
+  const Register limit      = c_rarg4;
+#else
+  const Address  limit_mem(rbp, 6 * wordSize);
+  const Register limit      = r10;
+#endif
+  const Register consts     = r11;
+  const Register round      = rax;
+
+  // Only xmm registers that are volatile on all platforms are used.
+  const XMMRegister A[5]   = { xmm0, xmm1, xmm2, xmm3, xmm4 };
+  const XMMRegister B[5]   = { xmm16, xmm17, xmm18, xmm19, xmm20 };
+  const XMMRegister rho[5] = { xmm21, xmm22, xmm23, xmm24, xmm25 };
+  const XMMRegister rotate_m1 = xmm26;
+  const XMMRegister rotate_1  = xmm27;
+  const XMMRegister rotate_2  = xmm28;
+  const XMMRegister tmp0      = xmm29;
+  const XMMRegister tmp1      = xmm30;
+  const XMMRegister tmp2      = xmm31;
+
+  // k1 - the five lanes of a row, for loading and storing the state
+  // k2 - lane 0, for iota
+  // k3, k4, k5 - lanes 0 and 1, 2 and 3, and 4, for pi
+  // k6 - one bit per lane of the block, for absorbing the input
+  // k7 - the bits of k6 for one row
+  const int vlen = Assembler::AVX_512bit;
+
+  Label L_sha3_loop, L_rounds24_loop;
+
+  __ enter();
+
+#ifdef _WIN64
+  // on win64, fill limit from stack position
+  if (multi_block) {
+    __ movl(limit, limit_mem);
+  }
+#endif
+
+  __ movl(rax, 0x1F);
+  __ kmovwl(k1, rax);
+  __ movl(rax, 0x01);
+  __ kmovwl(k2, rax);
+  __ movl(rax, 0x03);
+  __ kmovwl(k3, rax);
+  __ movl(rax, 0x0C);
+  __ kmovwl(k4, rax);
+  __ movl(rax, 0x10);
+  __ kmovwl(k5, rax);
+  // The block has block_size / 8 lanes, at most 21.
+  __ movl(block_size, block_size); // zero-extend for the pointer arithmetic below
+  __ movl(r11, block_size);
+  __ shrl(r11, 3);
+  __ movl(rax, 1);
+  __ shlxl(rax, rax, r11);
+  __ decrementl(rax);
+  __ kmovdl(k6, rax);
+
+  __ lea(consts, ExternalAddress(sha3_consts()));
+  for (int y = 0; y < 5; y++) {
+    __ evmovdquq(rho[y], Address(consts, sha3_rho_offset + y * 64), vlen);
+  }
+  __ evmovdquq(rotate_m1, Address(consts, sha3_rotate_offset), vlen);
+  __ evmovdquq(rotate_1, Address(consts, sha3_rotate_offset + 64), vlen);
+  __ evmovdquq(rotate_2, Address(consts, sha3_rotate_offset + 128), vlen);
+
+  // load the state
+  for (int y = 0; y < 5; y++) {
+    __ evmovdquq(A[y], k1, Address(state, y * 40), false, vlen);
+  }
+
+  __ BIND(L_sha3_loop);
+
+  // Absorb the block: lane i of the block goes to lane i % 5 of row i / 5.
+  // The masked loads of a row may also read the first lanes of the next
+  // row into the garbage lanes, but never beyond the block.
+  __ evpxorq(A[0], k6, A[0], Address(buf, 0), true, vlen);
+  for (int y = 1; y < 5; y++) {
+    __ kshiftrdl(k7, k6, 5 * y);
+    __ evpxorq(A[y], k7, A[y], Address(buf, y * 40), true, vlen);
+  }
+
+  // 24 rounds, two per iteration, going from A to B and back. The round
+  // index counts up from -24 to 0.
+  __ movptr(round, -24);
+  __ BIND(L_rounds24_loop);
+  sha3_keccak_round(A, B, rho, rotate_m1, rotate_1, rotate_2, tmp0, tmp1, tmp2, consts,
+                    Address(consts, round, Address::times_8, sha3_round_consts_offset + 24 * 8));
+  sha3_keccak_round(B, A, rho, rotate_m1, rotate_1, rotate_2, tmp0, tmp1, tmp2, consts,
+                    Address(consts, round, Address::times_8, sha3_round_consts_offset + 25 * 8));
+  __ addq(round, 2);
+  __ jcc(Assembler::notZero, L_rounds24_loop);
+
+  if (multi_block) {
+    __ addptr(buf, block_size);
+    __ addl(ofs, block_size);
+    __ cmpl(ofs, limit);
+    __ jcc(Assembler::lessEqual, L_sha3_loop);
+    __ movl(rax, ofs); // return ofs
+  }
+
+  // store the state
+  for (int y = 0; y < 5; y++) {
+    __ evmovdquq(Address(state, y * 40), k1, A[y], true, vlen);
+  }
+
+  __ vzeroupper();
+  __ leave();
+  __ ret(0);
+
+  return start;
+}
+
+#undef __
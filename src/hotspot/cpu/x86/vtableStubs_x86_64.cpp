@@ -181,16 +181,41 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
   const Register method             = rbx;
   const Register icdata_reg         = rax;
 
-  __ movptr(resolved_klass_reg, Address(icdata_reg, CompiledICData::itable_refc_klass_offset()));
-  __ movptr(holder_klass_reg,   Address(icdata_reg, CompiledICData::itable_defc_klass_offset()));
-
-  Label L_no_such_interface;
+  Label L_no_such_interface, L_call;
 
   // get receiver klass (also an implicit null-check)
   assert(VtableStub::receiver_location() == j_rarg0->as_VMReg(), "receiver expected in j_rarg0");
   address npe_addr = __ pc();
   __ load_klass(recv_klass_reg, j_rarg0, temp_reg);
 
+  if (CompiledICData::use_type_cache()) {
+    // Check the receiver klasses seen at this call site before scanning the
+    // itable. A receiver that is not cached yet while there is an empty entry
+    // goes to the IC miss handler, which adds it. The CompiledICData is still
+    // in rax, as the IC miss stub expects.
+    Label L_scan_itable;
+    const Register cache_reg = temp_reg2;
+    __ movptr(cache_reg, Address(icdata_reg, CompiledICData::type_cache_offset()));
+    __ testptr(cache_reg, cache_reg);
+    __ jcc(Assembler::zero, L_scan_itable);
+    for (uint i = 0; i < InterfaceCallTypeCacheSize; i++) {
+      Label L_next;
+      const int entry_offset = i * (int)sizeof(CompiledICTypeCacheEntry);
+      __ movptr(temp_reg, Address(cache_reg, entry_offset + in_bytes(CompiledICTypeCacheEntry::klass_offset())));
+      __ cmpptr(recv_klass_reg, temp_reg);
+      __ jccb(Assembler::notEqual, L_next);
+      __ movptr(method, Address(cache_reg, entry_offset + in_bytes(CompiledICTypeCacheEntry::method_offset())));
+      __ jmp(L_call);
+      __ bind(L_next);
+      __ testptr(temp_reg, temp_reg);
+      __ jump_cc(Assembler::zero, RuntimeAddress(SharedRuntime::get_ic_miss_stub()));
+    }
+    __ bind(L_scan_itable);
+  }
+
+  __ movptr(resolved_klass_reg, Address(icdata_reg, CompiledICData::itable_refc_klass_offset()));
+  __ movptr(holder_klass_reg,   Address(icdata_reg, CompiledICData::itable_defc_klass_offset()));
+
   start_pc = __ pc();
 
   // Receiver subtype check against REFC.
@@ -224,6 +249,8 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
   // method (rbx): Method*
   // j_rarg0: receiver
 
+  __ bind(L_call);
+
 #ifdef ASSERT
   if (DebugVtables) {
     Label L2;
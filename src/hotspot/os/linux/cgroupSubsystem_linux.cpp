@@ -31,6 +31,7 @@
 #include "logging/log.hpp"
 #include "memory/allocation.hpp"
 #include "os_linux.hpp"
+#include "osContainer_linux.hpp"
 #include "runtime/globals.hpp"
 #include "runtime/os.hpp"
 #include "utilities/globalDefinitions.hpp"
@@ -507,7 +508,7 @@ int CgroupSubsystem::active_processor_count() {
   log_trace(os, container)("OSContainer::active_processor_count: %d", result);
 
   // Update cached metric to avoid re-reading container settings too often
-  cpu_limit->set_value(result, OSCONTAINER_CACHE_TIMEOUT);
+  cpu_limit->set_value(result, OSContainer::cache_timeout());
 
   return result;
 }
@@ -552,10 +553,15 @@ jlong CgroupSubsystem::memory_limit_in_bytes() {
   }
 
   // Update cached metric to avoid re-reading container settings too often
-  memory_limit->set_value(mem_limit, OSCONTAINER_CACHE_TIMEOUT);
+  memory_limit->set_value(mem_limit, OSContainer::cache_timeout());
   return mem_limit;
 }
 
+void CgroupSubsystem::invalidate_cached_limits() {
+  cpu_controller()->metrics_cache()->invalidate();
+  memory_controller()->metrics_cache()->invalidate();
+}
+
 bool CgroupController::read_string(const char* filename, char* buf, size_t buf_size) {
   assert(buf != nullptr, "buffer must not be null");
   assert(filename != nullptr, "filename must be given");
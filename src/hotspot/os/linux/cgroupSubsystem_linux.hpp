@@ -174,8 +174,12 @@ class CachedMetric : public CHeapObj<mtInternal>{
       // responsive to configuration changes. A very short grace time
       // between re-read avoids excessive overhead during startup without
       // significantly reducing the VMs ability to promptly react to changed
-      // metric config
-      _next_check_counter = os::elapsed_counter() + timeout;
+      // metric config. A timeout of max_jlong keeps the value until the
+      // metric is invalidated.
+      _next_check_counter = (timeout == max_jlong) ? max_jlong : os::elapsed_counter() + timeout;
+    }
+    void invalidate() {
+      _next_check_counter = min_jlong;
     }
 };
 
@@ -198,6 +202,9 @@ class CgroupSubsystem: public CHeapObj<mtInternal> {
   public:
     jlong memory_limit_in_bytes();
     int active_processor_count();
+    // Make the next memory_limit_in_bytes and active_processor_count calls
+    // re-read the limits.
+    void invalidate_cached_limits();
 
     virtual int cpu_quota() = 0;
     virtual int cpu_period() = 0;
@@ -211,6 +218,7 @@ class CgroupSubsystem: public CHeapObj<mtInternal> {
     virtual jlong memory_max_usage_in_bytes() = 0;
     virtual jlong rss_usage_in_bytes() = 0;
     virtual jlong cache_usage_in_bytes() = 0;
+    virtual jlong memory_pressure_events() = 0;
 
     virtual char * cpu_cpuset_cpus() = 0;
     virtual char * cpu_cpuset_memory_nodes() = 0;
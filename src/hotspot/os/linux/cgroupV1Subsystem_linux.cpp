@@ -268,6 +268,20 @@ jlong CgroupV1Subsystem::cache_usage_in_bytes() {
   return cache;
 }
 
+/* memory_pressure_events
+ *
+ * Return the number of times the memory usage hit the memory limit.
+ *
+ * return:
+ *    number of times the limit was hit
+ *    OSCONTAINER_ERROR for not supported
+ */
+jlong CgroupV1Subsystem::memory_pressure_events() {
+  julong failcnt;
+  CONTAINER_READ_NUMBER_CHECKED(_memory->controller(), "/memory.failcnt", "Memory Limit Hits", failcnt);
+  return (jlong)failcnt;
+}
+
 jlong CgroupV1Subsystem::kernel_memory_usage_in_bytes() {
   julong kmem_usage;
   CONTAINER_READ_NUMBER_CHECKED(_memory->controller(), "/memory.kmem.usage_in_bytes", "Kernel Memory Usage", kmem_usage);
@@ -82,6 +82,7 @@ class CgroupV1Subsystem: public CgroupSubsystem {
     jlong memory_max_usage_in_bytes();
     jlong rss_usage_in_bytes();
     jlong cache_usage_in_bytes();
+    jlong memory_pressure_events();
 
     jlong kernel_memory_usage_in_bytes();
     jlong kernel_memory_limit_in_bytes();
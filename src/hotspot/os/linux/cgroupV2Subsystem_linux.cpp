@@ -167,6 +167,27 @@ jlong CgroupV2Subsystem::cache_usage_in_bytes() {
   return (jlong)cache;
 }
 
+/* memory_pressure_events
+ *
+ * Return the number of times the memory usage went over the memory.high
+ * boundary and was throttled, or was about to go over memory.max, as
+ * counted by the "high" and "max" entries of memory.events.
+ *
+ * return:
+ *    number of memory pressure events
+ *    OSCONTAINER_ERROR for not supported
+ */
+jlong CgroupV2Subsystem::memory_pressure_events() {
+  julong high;
+  julong max;
+  if (!_memory->controller()->read_numerical_key_value("/memory.events", "high", &high) ||
+      !_memory->controller()->read_numerical_key_value("/memory.events", "max", &max)) {
+    return OSCONTAINER_ERROR;
+  }
+  log_trace(os, container)("Memory pressure events: " JULONG_FORMAT, high + max);
+  return (jlong)(high + max);
+}
+
 // Note that for cgroups v2 the actual limits set for swap and
 // memory live in two different files, memory.swap.max and memory.max
 // respectively. In order to properly report a cgroup v1 like
@@ -77,6 +77,7 @@ class CgroupV2Subsystem: public CgroupSubsystem {
     jlong memory_max_usage_in_bytes();
     jlong rss_usage_in_bytes();
     jlong cache_usage_in_bytes();
+    jlong memory_pressure_events();
 
     char * cpu_cpuset_cpus();
     char * cpu_cpuset_memory_nodes();
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -54,6 +54,11 @@
 // Support for building on older Linux systems
 //
 
+// madvise(2) flags
+#ifndef MADV_COLD
+#define MADV_COLD                        20
+#endif
+
 // memfd_create(2) flags
 #ifndef MFD_CLOEXEC
 #define MFD_CLOEXEC                      0x0001U
@@ -726,3 +731,21 @@ void ZPhysicalMemoryBacking::unmap(zaddress_unsafe addr, size_t size) const {
     fatal("Failed to map memory (%s)", err.to_string());
   }
 }
+
+void ZPhysicalMemoryBacking::advise_cold(zaddress_unsafe addr, size_t size) const {
+  // Only accessed by the uncommitter thread
+  static bool is_supported = true;
+  if (!is_supported) {
+    return;
+  }
+
+  // MADV_COLD is only a hint, and is not supported by older kernels. The
+  // memory stays committed and its contents are preserved.
+  if (madvise((void*)untype(addr), size, MADV_COLD) == -1) {
+    ZErrno err;
+    if (err == EINVAL) {
+      log_debug_p(gc)("Advising cold memory not supported (%s)", err.to_string());
+      is_supported = false;
+    }
+  }
+}
@@ -52,6 +52,12 @@
   product(bool, UseContainerSupport, true,                              \
           "Enable detection and runtime container configuration support") \
                                                                         \
+  product(uint, ContainerLimitsWatchInterval, 0, EXPERIMENTAL,          \
+          "Interval in ms at which the container CPU and memory limits "\
+          "are re-read, so that reads of the limits can always use the "\
+          "cached values and the VM reacts to in-place resizes. 0 "     \
+          "re-reads the limits on demand with a short timeout")         \
+                                                                        \
   product(bool, AdjustStackSizeForTLS, false,                           \
           "Increase the thread stack size to include space for glibc "  \
           "static thread-local storage (TLS) if true")                  \
@@ -88,12 +94,26 @@
           "thread stacks. When disabled, the absence of this mitigation"\
           "allows THPs to form in thread stacks.")                      \
                                                                         \
+  product(ccstr, BackgroundThreadSchedulingPolicy, nullptr, EXPERIMENTAL,\
+          "Scheduling policy of compiler threads and concurrent GC "    \
+          "threads: \"batch\" (SCHED_BATCH) or \"idle\" (SCHED_IDLE)")  \
+                                                                        \
+  product(ccstr, BackgroundThreadCPUs, nullptr, EXPERIMENTAL,           \
+          "List of CPUs, e.g. \"0-1,6\", to which compiler threads "    \
+          "and concurrent GC threads are bound")                        \
+                                                                        \
   develop(bool, DelayThreadStartALot, false,                            \
           "Artificially delay thread starts randomly for testing.")     \
                                                                         \
   product(bool, UseMadvPopulateWrite, true, DIAGNOSTIC,                 \
           "Use MADV_POPULATE_WRITE in os::pd_pretouch_memory.")         \
                                                                         \
+  product(bool, UseMadvCollapse, false, EXPERIMENTAL,                   \
+          "Use MADV_COLLAPSE to back memory advised for transparent "   \
+          "huge pages with huge pages right away rather than waiting "  \
+          "for khugepaged. This populates the memory. Requires "        \
+          "UseTransparentHugePages and Linux 6.1")                      \
+                                                                        \
   product(bool, PrintMemoryMapAtExit, false, DIAGNOSTIC,                \
           "Print an annotated memory map at exit")                      \
                                                                         \
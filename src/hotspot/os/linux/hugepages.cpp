@@ -333,5 +333,27 @@ void HugePages::initialize() {
 void HugePages::print_on(outputStream* os) {
   _explicit_hugepage_support.print_on(os);
   _thp_support.print_on(os);
+  print_thp_coverage_on(os);
   _shmem_thp_support.print_on(os);
 }
+
+void HugePages::print_thp_coverage_on(outputStream* os) {
+  FILE* f = os::fopen("/proc/self/smaps_rollup", "r");
+  if (f == nullptr) {
+    return;
+  }
+  size_t anon_kb = 0;
+  size_t anon_huge_kb = 0;
+  char line[256];
+  while (::fgets(line, sizeof(line), f) != nullptr) {
+    size_t kb;
+    if (::sscanf(line, "Anonymous: %zu kB", &kb) == 1) {
+      anon_kb = kb;
+    } else if (::sscanf(line, "AnonHugePages: %zu kB", &kb) == 1) {
+      anon_huge_kb = kb;
+    }
+  }
+  ::fclose(f);
+  os->print_cr("  THP coverage: " SIZE_FORMAT "K of " SIZE_FORMAT "K anonymous memory (%.1f%%)",
+               anon_huge_kb, anon_kb, anon_kb > 0 ? 100.0 * anon_huge_kb / anon_kb : 0.0);
+}
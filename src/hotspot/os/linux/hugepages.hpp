@@ -146,6 +146,10 @@ class HugePages : public AllStatic {
 
   static void initialize();
   static void print_on(outputStream* os);
+
+  // Prints how much of the anonymous memory of the process is backed by
+  // transparent huge pages, from /proc/self/smaps_rollup.
+  static void print_thp_coverage_on(outputStream* os);
 };
 
 #endif // OS_LINUX_HUGEPAGES_HPP
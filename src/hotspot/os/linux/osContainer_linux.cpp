@@ -25,9 +25,15 @@
 #include <string.h>
 #include <math.h>
 #include <errno.h>
+#include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/gc_globals.hpp"
 #include "runtime/globals.hpp"
+#include "runtime/globals_extension.hpp"
 #include "runtime/os.hpp"
+#include "runtime/task.hpp"
 #include "logging/log.hpp"
+#include "memory/universe.hpp"
+#include "utilities/align.hpp"
 #include "os_linux.hpp"
 #include "osContainer_linux.hpp"
 #include "cgroupSubsystem_linux.hpp"
@@ -35,8 +41,69 @@
 
 bool  OSContainer::_is_initialized   = false;
 bool  OSContainer::_is_containerized = false;
+bool  OSContainer::_limits_watched   = false;
 CgroupSubsystem* cgroup_subsystem;
 
+// Re-reads the container limits periodically, so that reads of the limits
+// can be served from the cache, and the VM can react to limit changes like
+// an in-place resize of the container.
+//
+// cgroupfs only sends inotify events for the *.events files, not for
+// writes to the limit files from outside of the container, so the limits
+// are polled. That is cheap at this rate and off the hot paths.
+class ContainerLimitsWatcher : public PeriodicTask {
+  int _cpu_count;
+  jlong _memory_limit;
+
+ public:
+  ContainerLimitsWatcher(size_t interval_ms) :
+    PeriodicTask(interval_ms),
+    _cpu_count(cgroup_subsystem->active_processor_count()),
+    _memory_limit(cgroup_subsystem->memory_limit_in_bytes()) {}
+
+  void task() {
+    cgroup_subsystem->invalidate_cached_limits();
+    int cpu_count = cgroup_subsystem->active_processor_count();
+    jlong memory_limit = cgroup_subsystem->memory_limit_in_bytes();
+    if (cpu_count != _cpu_count || memory_limit != _memory_limit) {
+      OSContainer::limits_changed(_cpu_count, cpu_count, _memory_limit, memory_limit);
+      _cpu_count = cpu_count;
+      _memory_limit = memory_limit;
+    }
+  }
+};
+
+void OSContainer::start_limits_watcher() {
+  if (!is_containerized() || ContainerLimitsWatchInterval == 0) {
+    return;
+  }
+  size_t interval = align_down(MAX2((size_t)ContainerLimitsWatchInterval, (size_t)PeriodicTask::min_interval),
+                               (size_t)PeriodicTask::interval_gran);
+  ContainerLimitsWatcher* watcher = new ContainerLimitsWatcher(interval);
+  _limits_watched = true;
+  watcher->enroll();
+  log_info(os, container)("Watching container limits (interval: " SIZE_FORMAT " ms)", interval);
+}
+
+void OSContainer::limits_changed(int old_cpu_count, int new_cpu_count,
+                                 jlong old_memory_limit, jlong new_memory_limit) {
+  log_info(os, container)("Container limits changed: CPUs %d -> %d, memory limit " JLONG_FORMAT " -> " JLONG_FORMAT,
+                          old_cpu_count, new_cpu_count, old_memory_limit, new_memory_limit);
+
+  // Follow the memory limit with the soft maximum heap size, unless that
+  // was set explicitly. GCs that don't support SoftMaxHeapSize ignore it.
+  // The number of active GC workers follows the CPU limit by itself, see
+  // WorkerPolicy::calc_active_workers.
+  if (new_memory_limit != old_memory_limit && FLAG_IS_ERGO(SoftMaxHeapSize)) {
+    julong limit = (new_memory_limit > 0) ? (julong)new_memory_limit : os::Linux::physical_memory();
+    size_t soft_max = (size_t)MIN2((julong)MaxHeapSize, (julong)(limit * MaxRAMPercentage / 100));
+    soft_max = MAX2(soft_max, MinHeapSize);
+    log_info(os, container)("Setting SoftMaxHeapSize to " SIZE_FORMAT "M", soft_max / M);
+    FLAG_SET_ERGO(SoftMaxHeapSize, soft_max);
+    Universe::heap()->soft_max_heap_size_changed();
+  }
+}
+
 /* init
  *
  * Initialize the container support and determine if
@@ -107,6 +174,11 @@ jlong OSContainer::cache_usage_in_bytes() {
   return cgroup_subsystem->cache_usage_in_bytes();
 }
 
+jlong OSContainer::memory_pressure_events() {
+  assert(cgroup_subsystem != nullptr, "cgroup subsystem not available");
+  return cgroup_subsystem->memory_pressure_events();
+}
+
 void OSContainer::print_version_specific_info(outputStream* st) {
   assert(cgroup_subsystem != nullptr, "cgroup subsystem not available");
   cgroup_subsystem->print_version_specific_info(st);
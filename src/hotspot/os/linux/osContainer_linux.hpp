@@ -40,10 +40,18 @@ class OSContainer: AllStatic {
  private:
   static bool   _is_initialized;
   static bool   _is_containerized;
+  static bool   _limits_watched;
   static int    _active_processor_count;
 
  public:
   static void init();
+  // Start re-reading the limits every ContainerLimitsWatchInterval ms.
+  static void start_limits_watcher();
+  // Called when the CPU or memory limits changed.
+  static void limits_changed(int old_cpu_count, int new_cpu_count,
+                             jlong old_memory_limit, jlong new_memory_limit);
+  // Time after which cached limits are re-read.
+  static jlong cache_timeout() { return _limits_watched ? max_jlong : OSCONTAINER_CACHE_TIMEOUT; }
   static void print_version_specific_info(outputStream* st);
   static void print_container_helper(outputStream* st, jlong j, const char* metrics);
 
@@ -58,6 +66,7 @@ class OSContainer: AllStatic {
   static jlong memory_max_usage_in_bytes();
   static jlong rss_usage_in_bytes();
   static jlong cache_usage_in_bytes();
+  static jlong memory_pressure_events();
 
   static int active_processor_count();
 
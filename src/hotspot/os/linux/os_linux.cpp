@@ -791,6 +791,78 @@ bool os::Linux::manually_expand_stack(JavaThread * t, address addr) {
 //////////////////////////////////////////////////////////////////////////////
 // create new thread
 
+// Compiler threads and concurrent GC threads can be moved out of the way of
+// the application threads with BackgroundThreadSchedulingPolicy and
+// BackgroundThreadCPUs. Both apply to the calling thread only, and neither
+// requires privileges since the threads only give up CPU time.
+
+static int background_sched_policy = -1;
+static cpu_set_t* background_cpus = nullptr;
+
+// Parse a list of CPUs like "0-3,6" into set. Returns false if malformed.
+static bool parse_cpu_list(const char* list, cpu_set_t* set) {
+  CPU_ZERO(set);
+  const char* p = list;
+  do {
+    char* end;
+    long first = strtol(p, &end, 10);
+    long last = first;
+    if (end == p) return false;
+    if (*end == '-') {
+      p = end + 1;
+      last = strtol(p, &end, 10);
+      if (end == p) return false;
+    }
+    if (first < 0 || last < first || last >= CPU_SETSIZE) return false;
+    for (long cpu = first; cpu <= last; cpu++) {
+      CPU_SET((int)cpu, set);
+    }
+    p = end;
+  } while (*p++ == ',');
+  return *(p - 1) == '\0';
+}
+
+static void background_thread_init() {
+  if (BackgroundThreadSchedulingPolicy != nullptr) {
+    if (strcmp(BackgroundThreadSchedulingPolicy, "batch") == 0) {
+      background_sched_policy = SCHED_BATCH;
+    } else if (strcmp(BackgroundThreadSchedulingPolicy, "idle") == 0) {
+      background_sched_policy = SCHED_IDLE;
+    } else {
+      warning("Ignoring unknown BackgroundThreadSchedulingPolicy \"%s\"", BackgroundThreadSchedulingPolicy);
+    }
+  }
+  if (BackgroundThreadCPUs != nullptr) {
+    cpu_set_t* set = NEW_C_HEAP_OBJ(cpu_set_t, mtInternal);
+    if (parse_cpu_list(BackgroundThreadCPUs, set)) {
+      background_cpus = set;
+    } else {
+      warning("Ignoring malformed BackgroundThreadCPUs \"%s\"", BackgroundThreadCPUs);
+      FREE_C_HEAP_OBJ(set);
+    }
+  }
+}
+
+static void set_background_thread_attributes(Thread* thread) {
+  if (!thread->is_Compiler_thread() && !thread->is_ConcurrentGC_thread()) {
+    return;
+  }
+  if (background_sched_policy != -1) {
+    struct sched_param param;
+    param.sched_priority = 0;
+    if (sched_setscheduler(0, background_sched_policy, &param) != 0) {
+      log_warning(os, thread)("Failed to set the scheduling policy of thread %s (%s)",
+                              thread->name(), os::strerror(errno));
+    }
+  }
+  if (background_cpus != nullptr) {
+    if (sched_setaffinity(0, sizeof(cpu_set_t), background_cpus) != 0) {
+      log_warning(os, thread)("Failed to set the CPU affinity of thread %s (%s)",
+                              thread->name(), os::strerror(errno));
+    }
+  }
+}
+
 // Thread start routine for all newly created threads
 static void *thread_native_entry(Thread *thread) {
 
@@ -854,6 +926,8 @@ static void *thread_native_entry(Thread *thread) {
     os::naked_short_sleep(100);
   }
 
+  set_background_thread_attributes(thread);
+
   // call one more level start routine
   thread->call_run();
 
@@ -2548,6 +2622,9 @@ void os::print_memory_info(outputStream* st) {
   st->print("Page Sizes: ");
   _page_sizes.print_on(st);
   st->cr();
+  if (UseTransparentHugePages) {
+    HugePages::print_thp_coverage_on(st);
+  }
 }
 
 // Print the first "model name" line and the first "flags" line
@@ -2978,6 +3055,15 @@ void os::pd_commit_memory_or_exit(char* addr, size_t size, bool exec,
   #define MADV_HUGEPAGE 14
 #endif
 
+// Define MADV_COLLAPSE here so we can build HotSpot on old systems.
+#define MADV_COLLAPSE_value 25
+#ifndef MADV_COLLAPSE
+  #define MADV_COLLAPSE MADV_COLLAPSE_value
+#else
+  // Sanity-check our assumed default value if we build with a new enough libc.
+  STATIC_ASSERT(MADV_COLLAPSE == MADV_COLLAPSE_value);
+#endif
+
 // Define MADV_POPULATE_WRITE here so we can build HotSpot on old systems.
 #define MADV_POPULATE_WRITE_value 23
 #ifndef MADV_POPULATE_WRITE
@@ -3027,6 +3113,26 @@ void os::Linux::madvise_transparent_huge_pages(void* addr, size_t bytes) {
   // We don't check the return value: madvise(MADV_HUGEPAGE) may not
   // be supported or the memory may already be backed by huge pages.
   ::madvise(addr, bytes, MADV_HUGEPAGE);
+
+  if (UseMadvCollapse) {
+    // Back the huge page aligned part of the range with huge pages right
+    // away instead of waiting for khugepaged. Kernels before 6.1 don't
+    // support MADV_COLLAPSE, in which case we stop trying.
+    static volatile bool collapse_supported = true;
+    const size_t page_size = HugePages::thp_pagesize_fallback();
+    char* const start = align_up((char*)addr, page_size);
+    char* const end = align_down((char*)addr + bytes, page_size);
+    if (start < end && Atomic::load(&collapse_supported) &&
+        ::madvise(start, pointer_delta(end, start, 1), MADV_COLLAPSE) != 0) {
+      if (errno == EINVAL) {
+        log_info(pagesize)("MADV_COLLAPSE is not supported");
+        Atomic::store(&collapse_supported, false);
+      } else {
+        log_debug(pagesize)("MADV_COLLAPSE failed for " RANGEFMT ": %s",
+                            RANGEFMTARGS(start, pointer_delta(end, start, 1)), os::strerror(errno));
+      }
+    }
+  }
 }
 
 void os::pd_realign_memory(char *addr, size_t bytes, size_t alignment_hint) {
@@ -4705,6 +4811,8 @@ jint os::init_2(void) {
   // initialize thread priority policy
   prio_init();
 
+  background_thread_init();
+
   if (!FLAG_IS_DEFAULT(AllocateHeapAt)) {
     set_coredump_filter(DAX_SHARED_BIT);
   }
@@ -5126,25 +5234,26 @@ jlong os::thread_cpu_time(Thread *thread, bool user_sys_cpu_time) {
 }
 
 //  -1 on error.
+// This is called for every thread by the ThreadMXBean bulk queries for the
+// user CPU time, so the stat file is read with a single read(2) into a stack
+// buffer and only the two fields needed are parsed.
 static jlong slow_thread_cpu_time(Thread *thread, bool user_sys_cpu_time) {
   pid_t  tid = thread->osthread()->thread_id();
   char *s;
+  char *end;
   char stat[2048];
-  size_t statlen;
+  ssize_t statlen;
   char proc_name[64];
-  int count;
-  long sys_time, user_time;
-  char cdummy;
-  int idummy;
-  long ldummy;
-  FILE *fp;
+  unsigned long sys_time, user_time;
+  int fd;
 
   snprintf(proc_name, 64, "/proc/self/task/%d/stat", tid);
-  fp = os::fopen(proc_name, "r");
-  if (fp == nullptr) return -1;
-  statlen = fread(stat, 1, 2047, fp);
+  fd = ::open(proc_name, O_RDONLY);
+  if (fd == -1) return -1;
+  statlen = ::read(fd, stat, sizeof(stat) - 1);
+  ::close(fd);
+  if (statlen <= 0) return -1;
   stat[statlen] = '\0';
-  fclose(fp);
 
   // Skip pid and the command string. Note that we could be dealing with
   // weird command names, e.g. user could decide to rename java launcher
@@ -5154,15 +5263,21 @@ static jlong slow_thread_cpu_time(Thread *thread, bool user_sys_cpu_time) {
   // occurrence of ")" and then start parsing from there. See bug 4726580.
   s = strrchr(stat, ')');
   if (s == nullptr) return -1;
+  s++;
 
-  // Skip blank chars
-  do { s++; } while (s && isspace((unsigned char) *s));
+  // Skip the state, ppid, pgrp, session, tty_nr, tpgid, flags, minflt,
+  // cminflt, majflt and cmajflt fields to get to utime and stime.
+  for (int i = 0; i < 11; i++) {
+    while (isspace((unsigned char) *s)) s++;
+    if (*s == '\0') return -1;
+    while (*s != '\0' && !isspace((unsigned char) *s)) s++;
+  }
+  user_time = strtoul(s, &end, 10);
+  if (end == s) return -1;
+  s = end;
+  sys_time = strtoul(s, &end, 10);
+  if (end == s) return -1;
 
-  count = sscanf(s,"%c %d %d %d %d %d %lu %lu %lu %lu %lu %lu %lu",
-                 &cdummy, &idummy, &idummy, &idummy, &idummy, &idummy,
-                 &ldummy, &ldummy, &ldummy, &ldummy, &ldummy,
-                 &user_time, &sys_time);
-  if (count != 13) return -1;
   if (user_sys_cpu_time) {
     return ((jlong)sys_time + (jlong)user_time) * (1000000000 / clock_tics_per_sec);
   } else {
@@ -5510,6 +5625,57 @@ bool os::trim_native_heap(os::size_change_t* rss_change) {
 #endif
 }
 
+// Returns the total time in microseconds some tasks stalled on memory, from
+// the "some" line of the PSI file /proc/pressure/memory, or -1.
+static jlong read_memory_stall_time() {
+  FILE* f = os::fopen("/proc/pressure/memory", "r");
+  if (f == nullptr) {
+    return -1;
+  }
+  jlong total = -1;
+  char line[256];
+  while (::fgets(line, sizeof(line), f) != nullptr) {
+    const char* p = ::strstr(line, "total=");
+    if (::strncmp(line, "some ", 5) == 0 && p != nullptr) {
+      total = ::strtoll(p + 6, nullptr, 10);
+      break;
+    }
+  }
+  ::fclose(f);
+  return total;
+}
+
+// Memory pressure is reported either if tasks stalled on memory for at least
+// 1% of the time since the last call, or if the container hit its memory
+// limits. Only called by the native heap trimmer, so needs no synchronization.
+bool os::memory_pressure_reported() {
+  static jlong last_stall_time = -1;
+  static jlong last_check_time = 0;
+  static jlong last_container_events = -1;
+
+  bool pressure = false;
+  jlong now = os::javaTimeNanos() / (NANOUNITS / MICROUNITS);
+  jlong stall_time = read_memory_stall_time();
+  if (stall_time >= 0 && last_stall_time >= 0 &&
+      (stall_time - last_stall_time) * 100 >= now - last_check_time) {
+    log_debug(trimnative)("Memory stall time: " JLONG_FORMAT "us in the last " JLONG_FORMAT "ms",
+                          stall_time - last_stall_time, (now - last_check_time) / 1000);
+    pressure = true;
+  }
+  last_stall_time = stall_time;
+  last_check_time = now;
+
+  if (OSContainer::is_containerized()) {
+    jlong events = OSContainer::memory_pressure_events();
+    if (events >= 0 && last_container_events >= 0 && events > last_container_events) {
+      log_debug(trimnative)("Container memory pressure events: " JLONG_FORMAT, events - last_container_events);
+      pressure = true;
+    }
+    last_container_events = events;
+  }
+  return pressure;
+}
+
 bool os::pd_dll_unload(void* libhandle, char* ebuf, int ebuflen) {
 
   if (ebuf && ebuflen > 0) {
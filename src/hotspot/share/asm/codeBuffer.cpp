@@ -517,6 +517,10 @@ static void append_oop_references(GrowableArray<oop>* oops, Klass* k) {
 }
 
 void CodeBuffer::finalize_oop_references(const methodHandle& mh) {
+  if (_oop_references_finalized) {
+    return;
+  }
+  _oop_references_finalized = true;
   NoSafepointVerifier nsv;
 
   GrowableArray<oop> oops;
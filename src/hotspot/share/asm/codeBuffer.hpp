@@ -438,6 +438,7 @@ class CodeBuffer: public StackObj DEBUG_ONLY(COMMA private Scrubber) {
   SharedStubToInterpRequests* _shared_stub_to_interp_requests; // used to collect requests for shared iterpreter stubs
   SharedTrampolineRequests*   _shared_trampoline_requests;     // used to collect requests for shared trampolines
   bool         _finalize_stubs; // Indicate if we need to finalize stubs to make CodeBuffer final.
+  bool         _oop_references_finalized; // The oops keeping embedded metadata alive are recorded.
 
   int          _const_section_alignment;
 
@@ -460,6 +461,7 @@ class CodeBuffer: public StackObj DEBUG_ONLY(COMMA private Scrubber) {
     _last_insn       = nullptr;
     _last_label      = nullptr;
     _finalize_stubs  = false;
+    _oop_references_finalized = false;
     _shared_stub_to_interp_requests = nullptr;
     _shared_trampoline_requests = nullptr;
 
@@ -639,7 +641,8 @@ class CodeBuffer: public StackObj DEBUG_ONLY(COMMA private Scrubber) {
   bool insts_contains(address pc) const  { return _insts.contains(pc); }
   bool insts_contains2(address pc) const { return _insts.contains2(pc); }
 
-  // Record any extra oops required to keep embedded metadata alive
+  // Record any extra oops required to keep embedded metadata alive. Done at most
+  // once, a compiler can call it before taking the locks for installing the code.
   void finalize_oop_references(const methodHandle& method);
 
   // Allocated size in all sections, when aligned and concatenated
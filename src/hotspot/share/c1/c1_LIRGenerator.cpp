@@ -922,7 +922,50 @@ LIR_Opr LIRGenerator::force_to_spill(LIR_Opr value, BasicType t) {
   return tmp;
 }
 
-void LIRGenerator::profile_branch(If* if_instr, If::Condition cond) {
+// Branch profile counters of hot code are written by all threads that run it, and
+// the cache lines holding them move between cores on every update. Sampling
+// updates once in about 2^C1ProfileSamplingShift executions, by as many counts,
+// keeps the counters statistically the same but makes these writes rare. The
+// countdown to the next sample is thread local and randomized, so that the
+// samples don't follow the structure of the profiled code.
+LabelObj* LIRGenerator::profile_sample() {
+  if (C1ProfileSamplingShift == 0) {
+    return nullptr;
+  }
+  LabelObj* skip = new LabelObj();
+  LIR_Opr thread = getThreadPointer();
+  LIR_Address* countdown_addr = new LIR_Address(thread, in_bytes(JavaThread::profile_sample_countdown_offset()), T_INT);
+  LIR_Opr countdown = new_register(T_INT);
+  __ move(countdown_addr, countdown);
+  __ sub(countdown, LIR_OprFact::intConst(1), countdown);
+  __ move(countdown, countdown_addr);
+  __ cmp(lir_cond_greater, countdown, 0);
+  __ branch(lir_cond_greater, skip->label());
+
+  // Next countdown: an odd number below 2^(C1ProfileSamplingShift + 1), taken from
+  // a xorshift random number generator.
+  LIR_Address* seed_addr = new LIR_Address(thread, in_bytes(JavaThread::profile_sample_seed_offset()), T_INT);
+  LIR_Opr seed = new_register(T_INT);
+  LIR_Opr tmp = new_register(T_INT);
+  __ move(seed_addr, seed);
+  __ move(seed, tmp);
+  __ shift_left(tmp, 13, tmp);
+  __ logical_xor(seed, tmp, seed);
+  __ move(seed, tmp);
+  __ unsigned_shift_right(tmp, 17, tmp);
+  __ logical_xor(seed, tmp, seed);
+  __ move(seed, tmp);
+  __ shift_left(tmp, 5, tmp);
+  __ logical_xor(seed, tmp, seed);
+  __ move(seed, seed_addr);
+  LIR_Opr mask = load_immediate((2 << C1ProfileSamplingShift) - 2, T_INT);
+  __ logical_and(tmp, mask, tmp);
+  __ add(tmp, LIR_OprFact::intConst(1), tmp);
+  __ move(tmp, countdown_addr);
+  return skip;
+}
+
+void LIRGenerator::profile_branch(If* if_instr, If::Condition cond, LIR_Opr left, LIR_Opr right) {
   if (if_instr->should_profile()) {
     ciMethod* method = if_instr->profiled_method();
     assert(method != nullptr, "method should be set if branch is profiled");
@@ -948,14 +991,24 @@ void LIRGenerator::profile_branch(If* if_instr, If::Condition cond) {
              LIR_OprFact::intptrConst(not_taken_count_offset),
              data_offset_reg, as_BasicType(if_instr->x()->type()));
 
+    // The countdown of sampling destroys the condition codes, which the compare
+    // has to compute again for the branch then.
+    LabelObj* skip = (left->is_valid() && right->is_valid()) ? profile_sample() : nullptr;
+    int increment = (skip != nullptr) ? profile_sample_increment() : DataLayout::counter_increment;
+
     // MDO cells are intptr_t, so the data_reg width is arch-dependent.
     LIR_Opr data_reg = new_pointer_register();
     LIR_Address* data_addr = new LIR_Address(md_reg, data_offset_reg, data_reg->type());
     __ move(data_addr, data_reg);
     // Use leal instead of add to avoid destroying condition codes on x86
-    LIR_Address* fake_incr_value = new LIR_Address(data_reg, DataLayout::counter_increment, T_INT);
+    LIR_Address* fake_incr_value = new LIR_Address(data_reg, increment, T_INT);
     __ leal(LIR_OprFact::address(fake_incr_value), data_reg);
     __ move(data_reg, data_addr);
+
+    if (skip != nullptr) {
+      __ branch_destination(skip->label());
+      __ cmp(lir_cond(cond), left, right);
+    }
   }
 }
 
@@ -1181,7 +1234,7 @@ void LIRGenerator::do_Local(Local* x) {
 
 
 void LIRGenerator::do_Return(Return* x) {
-  if (compilation()->env()->dtrace_method_probes()) {
+  if (compilation()->env()->method_probes()) {
     BasicTypeList signature;
     signature.append(LP64_ONLY(T_LONG) NOT_LP64(T_INT));    // thread
     signature.append(T_METADATA); // Method*
@@ -2477,8 +2530,13 @@ void LIRGenerator::do_Goto(Goto* x) {
     LIR_Opr md_reg = new_register(T_METADATA);
     __ metadata2reg(md->constant_encoding(), md_reg);
 
+    LabelObj* skip = profile_sample();
+    int increment = (skip != nullptr) ? profile_sample_increment() : DataLayout::counter_increment;
     increment_counter(new LIR_Address(md_reg, offset,
-                                      NOT_LP64(T_INT) LP64_ONLY(T_LONG)), DataLayout::counter_increment);
+                                      NOT_LP64(T_INT) LP64_ONLY(T_LONG)), increment);
+    if (skip != nullptr) {
+      __ branch_destination(skip->label());
+    }
   }
 
   // emit phi-instruction move after safepoint since this simplifies
@@ -2663,7 +2721,7 @@ void LIRGenerator::do_Base(Base* x) {
     java_index += type2size[t];
   }
 
-  if (compilation()->env()->dtrace_method_probes()) {
+  if (compilation()->env()->method_probes()) {
     BasicTypeList signature;
     signature.append(LP64_ONLY(T_LONG) NOT_LP64(T_INT));    // thread
     signature.append(T_METADATA); // Method*
@@ -400,7 +400,15 @@ class LIRGenerator: public InstructionVisitor, public BlockClosure {
 
   LIR_Opr safepoint_poll_register();
 
-  void profile_branch(If* if_instr, If::Condition cond);
+  // With C1ProfileSamplingShift, emit the countdown to the next sampled profile
+  // counter update and return the label that skips the update. Returns null if
+  // all updates are done.
+  LabelObj* profile_sample();
+  int profile_sample_increment() const { return DataLayout::counter_increment << C1ProfileSamplingShift; }
+  // The operands of the If's compare, if given, allow sampling. The flags of
+  // the compare are live when profile_branch() returns.
+  void profile_branch(If* if_instr, If::Condition cond,
+                      LIR_Opr left = LIR_OprFact::illegalOpr, LIR_Opr right = LIR_OprFact::illegalOpr);
   void increment_event_counter_impl(CodeEmitInfo* info,
                                     ciMethod *method, LIR_Opr step, int frequency,
                                     int bci, bool backedge, bool notify);
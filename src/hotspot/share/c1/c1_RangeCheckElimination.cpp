@@ -830,6 +830,16 @@ void RangeCheckEliminator::process_access_indexed(BlockBegin *loop_header, Block
 
   if (ai->check_flag(Instruction::NeedsRangeCheckFlag)) {
     Bound *index_bound = get_bound(ai->index());
+    if ((!index_bound->has_lower() || !index_bound->has_upper()) && ai->index()->as_Phi() != nullptr) {
+      Bound *sibling_bound = get_sibling_iv_bound(ai->index()->as_Phi());
+      if (sibling_bound != nullptr) {
+        TRACE_RANGE_CHECK_ELIMINATION(
+          tty->fill_to(block->dominator_depth()*2);
+          tty->print_cr("Index instruction %d is bounded by another induction variable", ai->index()->id())
+        );
+        index_bound = sibling_bound;
+      }
+    }
     if (!index_bound->has_lower() || !index_bound->has_upper()) {
       TRACE_RANGE_CHECK_ELIMINATION(
         tty->fill_to(block->dominator_depth()*2);
@@ -946,6 +956,121 @@ void RangeCheckEliminator::process_access_indexed(BlockBegin *loop_header, Block
   }
 }
 
+// Returns true if v is phi + step, the value of the induction variable phi in the next iteration.
+static bool is_iv_increment(Phi *phi, Value v, int &step) {
+  if (v == phi) {
+    step = 0;
+    return true;
+  }
+  ArithmeticOp *ao = v->as_ArithmeticOp();
+  if (ao == nullptr || ao->op() != Bytecodes::_iadd) {
+    return false;
+  }
+  Value other = (ao->x() == phi) ? ao->y() : ((ao->y() == phi) ? ao->x() : nullptr);
+  if (other == nullptr || !other->type()->as_IntConstant()) {
+    return false;
+  }
+  step = other->type()->as_IntConstant()->value();
+  return true;
+}
+
+// Returns true if x == y + diff for a constant diff.
+static bool has_constant_difference(Value x, Value y, int &diff) {
+  if (x == y) {
+    diff = 0;
+    return true;
+  }
+  IntConstant *cx = x->type()->as_IntConstant();
+  IntConstant *cy = y->type()->as_IntConstant();
+  if (cx != nullptr && cy != nullptr) {
+    jlong d = (jlong)cx->value() - (jlong)cy->value();
+    if (d < min_jint || d > max_jint) {
+      return false;
+    }
+    diff = (int)d;
+    return true;
+  }
+  ArithmeticOp *ao = x->as_ArithmeticOp();
+  if (ao != nullptr && ao->op() == Bytecodes::_iadd) {
+    Value c = (ao->x() == y) ? ao->y() : ((ao->y() == y) ? ao->x() : nullptr);
+    if (c != nullptr && c->type()->as_IntConstant()) {
+      diff = c->type()->as_IntConstant()->value();
+      return true;
+    }
+  } else if (ao != nullptr && ao->op() == Bytecodes::_isub && ao->x() == y && ao->y()->type()->as_IntConstant()) {
+    int c = ao->y()->type()->as_IntConstant()->value();
+    if (c != min_jint) {
+      diff = -c;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns true if phi and sibling are induction variables of the same loop that are
+// incremented by the same steps, and phi == sibling + diff on entry to the loop.
+static bool is_sibling_iv(Phi *phi, Phi *sibling, int &diff) {
+  if (phi->operand_count() != sibling->operand_count()) {
+    return false;
+  }
+  bool has_diff = false;
+  for (int i = 0; i < phi->operand_count(); i++) {
+    Value v = phi->operand_at(i);
+    Value s = sibling->operand_at(i);
+    if (v == nullptr || s == nullptr) {
+      return false;
+    }
+    int step;
+    int sibling_step;
+    int d;
+    if (is_iv_increment(phi, v, step)) {
+      if (!is_iv_increment(sibling, s, sibling_step) || step != sibling_step) {
+        return false;
+      }
+    } else if (has_constant_difference(v, s, d) && (!has_diff || d == diff)) {
+      diff = d;
+      has_diff = true;
+    } else {
+      return false;
+    }
+  }
+  return has_diff;
+}
+
+// A loop may have several induction variables that the same steps increment, like i and j in
+//
+//   for (int i = 0, j = 1; i < a.length - 1; i++, j++) { ... a[j] ... }
+//
+// Then j == i + 1 in every iteration and the bound of j follows from the bound of i, which
+// is the induction variable the loop condition tests.
+RangeCheckEliminator::Bound *RangeCheckEliminator::get_sibling_iv_bound(Phi *phi) {
+  BlockBegin *block = phi->block();
+  if (!block->is_set(BlockBegin::linear_scan_loop_header_flag) || !phi->type()->as_IntType()) {
+    return nullptr;
+  }
+
+  Bound *result = nullptr;
+  for_each_phi_fun(block, sibling,
+    int diff;
+    if (result == nullptr && sibling != phi && !sibling->is_illegal() && sibling->type()->as_IntType() &&
+        is_sibling_iv(phi, sibling, diff)) {
+      Bound *bound = get_bound(sibling);
+      if (bound->has_lower() && bound->has_upper()) {
+        jlong lower = (jlong)bound->lower() + diff;
+        jlong upper = (jlong)bound->upper() + diff;
+        // sibling + diff must not overflow for any value of sibling within its bound. The
+        // value of an instruction in the bound can be anything up to max_jint / down to min_jint.
+        bool no_overflow = (diff >= 0 || lower >= (bound->lower_instr() == nullptr ? (jlong)min_jint : 0)) &&
+                           (diff <= 0 || upper <= (bound->upper_instr() == nullptr ? (jlong)max_jint : 0));
+        if (no_overflow && lower >= min_jint && lower <= max_jint && upper >= min_jint && upper <= max_jint) {
+          result = new Bound((int)lower, bound->lower_instr(), (int)upper, bound->upper_instr());
+        }
+      }
+    }
+  );
+  return result;
+}
+
 void RangeCheckEliminator::remove_range_check(AccessIndexed *ai) {
   ai->set_flag(Instruction::NeedsRangeCheckFlag, false);
   // no range check, no need for the length instruction anymore
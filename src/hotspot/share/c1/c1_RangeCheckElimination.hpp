@@ -214,6 +214,7 @@ class RangeCheckEliminator {
   void remove_range_check(AccessIndexed *ai);                                                                // Mark this instructions as not needing a range check
   void add_if_condition(IntegerStack &pushed, Value x, Value y, Instruction::Condition condition);           // Update bound for an If
   bool in_array_bound(Bound *bound, Value array);                                                            // Check whether bound is known to fall within array
+  Bound *get_sibling_iv_bound(Phi *phi);                                                                     // Bound of phi derived from another induction variable
 
   // helper functions to work with predicates
   Instruction* insert_after(Instruction* insert_position, Instruction* instr, int bci);
@@ -305,6 +305,12 @@
   product(bool, C1ProfileBranches, true,                                    \
           "Profile branches when generating code for updating MDOs")        \
                                                                             \
+  product(intx, C1ProfileSamplingShift, 0, EXPERIMENTAL,                    \
+          "Update branch profile counters in profiled code only once in "   \
+          "about 2^n executions, by 2^n. Makes contention on the counters " \
+          "of hot code less likely")                                        \
+          range(0, 10)                                                      \
+                                                                            \
   product(bool, C1ProfileCheckcasts, true,                                  \
           "Profile checkcasts when generating code for updating MDOs")      \
                                                                             \
@@ -88,8 +88,11 @@ void ArchiveHeapWriter::init() {
     _native_pointers = new GrowableArrayCHeap<NativePointerInfo, mtClassShared>(2048);
     _source_objs = new GrowableArrayCHeap<oop, mtClassShared>(10000);
 
-    guarantee(UseG1GC, "implementation limitation");
-    guarantee(MIN_GC_REGION_ALIGNMENT <= G1HeapRegion::min_region_size_in_words() * HeapWordSize, "must be");
+#if INCLUDE_G1GC
+    if (UseG1GC) {
+      guarantee(MIN_GC_REGION_ALIGNMENT <= G1HeapRegion::min_region_size_in_words() * HeapWordSize, "must be");
+    }
+#endif
   }
 }
 
@@ -430,16 +433,23 @@ size_t ArchiveHeapWriter::copy_one_source_obj_to_buffer(oop src_obj) {
 
 void ArchiveHeapWriter::set_requested_address(ArchiveHeapInfo* info) {
   assert(!info->is_used(), "only set once");
-  assert(UseG1GC, "must be");
-  address heap_end = (address)G1CollectedHeap::heap()->reserved().end();
-  log_info(cds, heap)("Heap end = %p", heap_end);
 
   size_t heap_region_byte_size = _buffer_used;
   assert(heap_region_byte_size > 0, "must archived at least one object!");
 
+  // The archive may be dumped with one collector and mapped by G1 at runtime, so
+  // request the top end of the heap even when dumping with another collector.
+  size_t region_alignment = MIN_GC_REGION_ALIGNMENT;
+#if INCLUDE_G1GC
+  if (UseG1GC) {
+    region_alignment = G1HeapRegion::GrainBytes;
+  }
+#endif
 
   if (UseCompressedOops) {
-    _requested_bottom = align_down(heap_end - heap_region_byte_size, G1HeapRegion::GrainBytes);
+    address heap_end = (address)CompressedOops::end();
+    log_info(cds, heap)("Heap end = %p", heap_end);
+    _requested_bottom = align_down(heap_end - heap_region_byte_size, region_alignment);
   } else {
     // We always write the objects as if the heap started at this address. This
     // makes the contents of the archive heap deterministic.
@@ -449,7 +459,7 @@ void ArchiveHeapWriter::set_requested_address(ArchiveHeapInfo* info) {
     _requested_bottom = (address)NOCOOPS_REQUESTED_BASE;
   }
 
-  assert(is_aligned(_requested_bottom, G1HeapRegion::GrainBytes), "sanity");
+  assert(is_aligned(_requested_bottom, region_alignment), "sanity");
 
   _requested_top = _requested_bottom + _buffer_used;
 
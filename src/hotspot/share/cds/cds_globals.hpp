@@ -51,6 +51,11 @@
   product(bool, PrintSharedArchiveAndExit, false,                           \
           "Print shared archive file contents")                             \
                                                                             \
+  product(bool, ValidateSharedClassPathDigest, false,                       \
+          "Also validate class path jars against a digest of their central "\
+          "directory recorded in the shared archive, for jars whose "       \
+          "modification time does not reflect their contents")              \
+                                                                            \
   product(size_t, SharedBaseAddress, LP64_ONLY(32*G)                        \
           NOT_LP64(LINUX_ONLY(2*G) NOT_LINUX(0)),                           \
           "Address to allocate shared memory region for class data")        \
@@ -84,6 +89,13 @@
   product(ccstr, ArchiveClassesAtExit, nullptr,                             \
           "The path and name of the dynamic archive file")                  \
                                                                             \
+  product(uint, ArchiveClassesDelay, 0,                                     \
+          "If non-zero, the dynamic archive specified by "                  \
+          "ArchiveClassesAtExit is written this many milliseconds after "   \
+          "VM start, while the application keeps running, instead of at "   \
+          "exit. Classes loaded afterwards are not archived.")              \
+          range(0, max_jint)                                                \
+                                                                            \
   product(ccstr, ExtraSharedClassListFile, nullptr,                         \
           "Extra classlist for building the CDS archive file")              \
                                                                             \
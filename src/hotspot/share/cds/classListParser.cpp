@@ -303,7 +303,7 @@ void ClassListParser::parse_at_tags(TRAPS) {
       }
     }
   } else if (strcmp(_token, LAMBDA_FORM_TAG) == 0) {
-    LambdaFormInvokers::append(os::strdup((const char*)(_line + offset), mtInternal));
+    LambdaFormInvokers::append(_line + offset);
   } else if (strcmp(_token, CONSTANT_POOL_TAG) == 0) {
     _token = _line + offset;
     parse_constant_pool_tag();
@@ -779,6 +779,23 @@ InstanceKlass* ClassListParser::find_builtin_class(JavaThread* current, const ch
   }
 }
 
+// Classes of custom loaders are only known by the id they were given in
+// the class list. Look for one with this name; if several custom loaders
+// defined classes with the same name, the @cp line is ambiguous.
+InstanceKlass* ClassListParser::find_unregistered_class(const char* class_name) {
+  TempNewSymbol class_name_symbol = SymbolTable::new_symbol(class_name);
+  InstanceKlass* result = nullptr;
+  int num_found = 0;
+  id2klass_table()->iterate_all([&] (const int& id, InstanceKlass* const& ik) {
+    if (ik->name() == class_name_symbol &&
+        !SystemDictionaryShared::is_builtin_loader(ik->class_loader_data())) {
+      result = ik;
+      num_found++;
+    }
+  });
+  return (num_found == 1) ? result : nullptr;
+}
+
 void ClassListParser::parse_constant_pool_tag() {
   if (parse_lambda_forms_invokers_only()) {
     return;
@@ -792,13 +809,17 @@ void ClassListParser::parse_constant_pool_tag() {
   _token ++;
 
   InstanceKlass* ik = find_builtin_class(THREAD, class_name);
+  if (ik == nullptr) {
+    ik = find_unregistered_class(class_name);
+  }
   if (ik == nullptr) {
     _token = class_name;
     if (strstr(class_name, "/$Proxy") != nullptr ||
         strstr(class_name, "MethodHandle$Species_") != nullptr) {
       // ignore -- TODO: we should filter these out in classListWriter.cpp
     } else {
-      constant_pool_resolution_warning("class %s is not (yet) loaded by one of the built-in loaders", class_name);
+      constant_pool_resolution_warning("class %s is not (yet) loaded by one of the built-in loaders "
+                                       "or by a single custom loader", class_name);
     }
     return;
   }
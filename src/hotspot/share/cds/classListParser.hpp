@@ -120,6 +120,7 @@ class ClassListParser : public StackObj {
 
   InstanceKlass* find_builtin_class_helper(JavaThread* current, Symbol* class_name_symbol, oop class_loader_oop);
   InstanceKlass* find_builtin_class(JavaThread* current, const char* class_name);
+  InstanceKlass* find_unregistered_class(const char* class_name);
 
   void resolve_indy(JavaThread* current, Symbol* class_name_symbol);
   void resolve_indy_impl(Symbol* class_name_symbol, TRAPS);
@@ -217,8 +217,7 @@ void ClassListWriter::write_resolved_constants() {
 }
 
 void ClassListWriter::write_resolved_constants_for(InstanceKlass* ik) {
-  if (!SystemDictionaryShared::is_builtin_loader(ik->class_loader_data()) ||
-      ik->is_hidden()) {
+  if (ik->is_hidden()) {
     return;
   }
   if (LambdaFormInvokers::may_be_regenerated_class(ik->name())) {
@@ -230,7 +229,7 @@ void ClassListWriter::write_resolved_constants_for(InstanceKlass* ik) {
     return;
   }
 
-  if (!has_id(ik)) { // do not resolve CP for classes loaded by custom loaders.
+  if (!has_id(ik)) { // Class was not written to the class list.
     return;
   }
 
@@ -107,6 +107,11 @@ bool ClassPrelinker::is_resolution_deterministic(ConstantPool* cp, int cp_index)
       return false;
     }
 
+    if (!SystemDictionaryShared::is_builtin_loader(cp->pool_holder()->class_loader_data()) &&
+        !is_member_resolution_deterministic_for_unregistered(cp->pool_holder(), InstanceKlass::cast(k))) {
+      return false;
+    }
+
     // Here, We don't check if this entry can actually be resolved to a valid Field/Method.
     // This method should be called by the ConstantPool to check Fields/Methods that
     // have already been successfully resolved.
@@ -116,6 +121,27 @@ bool ClassPrelinker::is_resolution_deterministic(ConstantPool* cp, int cp_index)
   }
 }
 
+// Loader constraints for the signature of a field or method are checked when
+// it is resolved, but not when an archived entry is used at runtime. For
+// classes of custom loaders, only field and method references into classes
+// of the same loader are archived, as they need no such constraints. The
+// members of java.lang.Object only refer to classes in java.lang.
+bool ClassPrelinker::is_member_resolution_deterministic_for_unregistered(InstanceKlass* cp_holder, InstanceKlass* k) {
+  ClassLoaderData* loader_data = cp_holder->class_loader_data();
+  for (InstanceKlass* super = k; super != nullptr; super = super->java_super()) {
+    if (super->class_loader_data() != loader_data && super != vmClasses::Object_klass()) {
+      return false;
+    }
+  }
+  Array<InstanceKlass*>* ifs = k->transitive_interfaces();
+  for (int i = 0; i < ifs->length(); i++) {
+    if (ifs->at(i)->class_loader_data() != loader_data) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool ClassPrelinker::is_class_resolution_deterministic(InstanceKlass* cp_holder, Klass* resolved_class) {
   assert(!is_in_archivebuilder_buffer(cp_holder), "sanity");
   assert(!is_in_archivebuilder_buffer(resolved_class), "sanity");
@@ -134,13 +160,17 @@ bool ClassPrelinker::is_class_resolution_deterministic(InstanceKlass* cp_holder,
     }
 
     if (is_vm_class(ik)) {
-      if (ik->class_loader() != cp_holder->class_loader()) {
+      if (ik->class_loader() == cp_holder->class_loader()) {
+        return true;
+      } else if (!SystemDictionaryShared::is_builtin_loader(cp_holder->class_loader_data())) {
+        // Custom loaders may define their own versions of vm classes, except
+        // for the ones in java.* packages.
+        return is_java_vm_class(ik);
+      } else {
         // At runtime, cp_holder() may not be able to resolve to the same
         // ik. For example, a different version of ik may be defined in
         // cp->pool_holder()'s loader using MethodHandles.Lookup.defineClass().
         return false;
-      } else {
-        return true;
       }
     }
   } else if (resolved_class->is_objArray_klass()) {
@@ -204,7 +234,40 @@ Klass* ClassPrelinker::find_loaded_class(Thread* current, oop class_loader, Symb
 
 Klass* ClassPrelinker::find_loaded_class(Thread* current, ConstantPool* cp, int class_cp_index) {
   Symbol* name = cp->klass_name_at(class_cp_index);
-  return find_loaded_class(current, cp->pool_holder()->class_loader(), name);
+  InstanceKlass* cp_holder = cp->pool_holder();
+  if (!SystemDictionaryShared::is_builtin_loader(cp_holder->class_loader_data())) {
+    return find_loaded_class_for_unregistered(current, cp_holder, name);
+  }
+  return find_loaded_class(current, cp_holder->class_loader(), name);
+}
+
+// Only classes in java.* packages are guaranteed to be defined by the boot
+// loader, whichever loader initiates their loading.
+bool ClassPrelinker::is_java_vm_class(InstanceKlass* ik) {
+  return is_vm_class(ik) && ik->name()->starts_with("java/");
+}
+
+// The resolution of a class name by a custom loader is known at dump time
+// only for the super types of cp_holder, which are checked when the archived
+// cp_holder is loaded at runtime, and for the vm classes in java.* packages.
+// Returns null for all other names.
+Klass* ClassPrelinker::find_loaded_class_for_unregistered(Thread* current, InstanceKlass* cp_holder, Symbol* name) {
+  for (InstanceKlass* k = cp_holder; k != nullptr; k = k->java_super()) {
+    if (k->name() == name) {
+      return k;
+    }
+  }
+  Array<InstanceKlass*>* ifs = cp_holder->transitive_interfaces();
+  for (int i = 0; i < ifs->length(); i++) {
+    if (ifs->at(i)->name() == name) {
+      return ifs->at(i);
+    }
+  }
+  InstanceKlass* k = SystemDictionary::find_instance_klass(current, name, Handle(), Handle());
+  if (k != nullptr && is_java_vm_class(k)) {
+    return k;
+  }
+  return nullptr;
 }
 
 #if INCLUDE_CDS_JAVA_HEAP
@@ -217,10 +280,6 @@ void ClassPrelinker::resolve_string(constantPoolHandle cp, int cp_index, TRAPS)
 #endif
 
 void ClassPrelinker::preresolve_class_cp_entries(JavaThread* current, InstanceKlass* ik, GrowableArray<bool>* preresolve_list) {
-  if (!SystemDictionaryShared::is_builtin_loader(ik->class_loader_data())) {
-    return;
-  }
-
   JavaThread* THREAD = current;
   constantPoolHandle cp(THREAD, ik->constants());
   for (int cp_index = 1; cp_index < cp->length(); cp_index++) {
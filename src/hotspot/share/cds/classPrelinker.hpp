@@ -69,6 +69,9 @@ class ClassPrelinker :  AllStatic {
 
   static Klass* find_loaded_class(Thread* current, oop class_loader, Symbol* name);
   static Klass* find_loaded_class(Thread* current, ConstantPool* cp, int class_cp_index);
+  static Klass* find_loaded_class_for_unregistered(Thread* current, InstanceKlass* cp_holder, Symbol* name);
+  static bool is_java_vm_class(InstanceKlass* ik);
+  static bool is_member_resolution_deterministic_for_unregistered(InstanceKlass* cp_holder, InstanceKlass* k);
 
   // fmi = FieldRef/MethodRef/InterfaceMethodRef
   static void maybe_resolve_fmi_ref(InstanceKlass* ik, Method* m, Bytecodes::Code bc, int raw_index,
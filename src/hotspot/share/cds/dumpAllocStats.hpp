@@ -74,6 +74,9 @@ class DumpAllocStats : public StackObj {
   int _num_method_cp_entries;
   int _num_method_cp_entries_archived;
   int _num_method_cp_entries_reverted;
+  int _num_indy_cp_entries;
+  int _num_indy_cp_entries_archived;
+  int _num_indy_cp_entries_reverted;
 
 public:
   enum { RO = 0, RW = 1 };
@@ -90,6 +93,9 @@ class DumpAllocStats : public StackObj {
     _num_method_cp_entries          = 0;
     _num_method_cp_entries_archived = 0;
     _num_method_cp_entries_reverted = 0;
+    _num_indy_cp_entries            = 0;
+    _num_indy_cp_entries_archived   = 0;
+    _num_indy_cp_entries_reverted   = 0;
   };
 
   CompactHashtableStats* symbol_stats() { return &_symbol_stats; }
@@ -134,6 +140,12 @@ class DumpAllocStats : public StackObj {
     _num_method_cp_entries_reverted += reverted ? 1 : 0;
   }
 
+  void record_indy_cp_entry(bool archived, bool reverted) {
+    _num_indy_cp_entries ++;
+    _num_indy_cp_entries_archived += archived ? 1 : 0;
+    _num_indy_cp_entries_reverted += reverted ? 1 : 0;
+  }
+
   void print_stats(int ro_all, int rw_all);
 };
 
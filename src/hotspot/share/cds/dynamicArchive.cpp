@@ -45,6 +45,7 @@
 #include "memory/resourceArea.hpp"
 #include "oops/klass.inline.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/os.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/vmThread.hpp"
@@ -494,6 +495,22 @@ void DynamicArchive::check_for_dynamic_dump() {
   }
 }
 
+volatile bool DynamicArchive::_dump_claimed = false;
+
+bool DynamicArchive::claim_dump() {
+  return !Atomic::load(&_dump_claimed) && !Atomic::cmpxchg(&_dump_claimed, false, true);
+}
+
+static void report_dynamic_dump_failure(JavaThread* current) {
+  // One of the prepatory steps failed
+  oop ex = current->pending_exception();
+  log_error(cds)("Dynamic dump has failed");
+  log_error(cds)("%s: %s", ex->klass()->external_name(),
+                 java_lang_String::as_utf8_string(java_lang_Throwable::message(ex)));
+  current->clear_pending_exception();
+  CDSConfig::disable_dumping_dynamic_archive();  // Just for good measure
+}
+
 void DynamicArchive::dump_at_exit(JavaThread* current, const char* archive_name) {
   ExceptionMark em(current);
   ResourceMark rm(current);
@@ -501,6 +518,10 @@ void DynamicArchive::dump_at_exit(JavaThread* current, const char* archive_name)
   if (!CDSConfig::is_dumping_dynamic_archive() || archive_name == nullptr) {
     return;
   }
+  if (!claim_dump()) {
+    log_info(cds, dynamic)("Dynamic archive has already been dumped in the background");
+    return;
+  }
 
   log_info(cds, dynamic)("Preparing for dynamic dump at exit in thread %s", current->name());
 
@@ -515,13 +536,39 @@ void DynamicArchive::dump_at_exit(JavaThread* current, const char* archive_name)
     }
   }
 
-  // One of the prepatory steps failed
-  oop ex = current->pending_exception();
-  log_error(cds)("Dynamic dump has failed");
-  log_error(cds)("%s: %s", ex->klass()->external_name(),
-                 java_lang_String::as_utf8_string(java_lang_Throwable::message(ex)));
-  CLEAR_PENDING_EXCEPTION;
-  CDSConfig::disable_dumping_dynamic_archive();  // Just for good measure
+  report_dynamic_dump_failure(current);
+}
+
+bool DynamicArchive::has_background_dump_work() {
+  return ArchiveClassesDelay > 0 &&
+         ArchiveClassesAtExit != nullptr &&
+         CDSConfig::is_dumping_dynamic_archive() &&
+         !Atomic::load(&_dump_claimed) &&
+         os::elapsedTime() * MILLIUNITS >= ArchiveClassesDelay;
+}
+
+void DynamicArchive::dump_in_background(JavaThread* current) {
+  ExceptionMark em(current);
+  ResourceMark rm(current);
+
+  if (!claim_dump()) {
+    return;
+  }
+
+  log_info(cds, dynamic)("Preparing for dynamic dump %u ms after start in thread %s",
+                         ArchiveClassesDelay, current->name());
+
+  JavaThread* THREAD = current; // For TRAPS processing related to link_shared_classes
+  // The application keeps running, so the lambda form holder classes are not
+  // regenerated, the same as for a dump requested by jcmd.
+  MetaspaceShared::link_shared_classes(true/*application is running*/, THREAD);
+  if (!HAS_PENDING_EXCEPTION) {
+    VM_PopulateDynamicDumpSharedSpace op(ArchiveClassesAtExit);
+    VMThread::execute(&op);
+    return;
+  }
+
+  report_dynamic_dump_failure(current);
 }
 
 // This is called by "jcmd VM.cds dynamic_dump"
@@ -63,10 +63,17 @@ class DynamicArchive : AllStatic {
 private:
   static GrowableArray<ObjArrayKlass*>* _array_klasses;
   static Array<ObjArrayKlass*>* _dynamic_archive_array_klasses;
+  // Set by the thread that dumps the archive requested by ArchiveClassesAtExit,
+  // either in the background or at exit.
+  static volatile bool _dump_claimed;
+  static bool claim_dump();
 public:
   static void check_for_dynamic_dump();
   static void dump_for_jcmd(const char* archive_name, TRAPS);
   static void dump_at_exit(JavaThread* current, const char* archive_name);
+  // Dumping the archive before exit with ArchiveClassesDelay, done by the ServiceThread.
+  static bool has_background_dump_work();
+  static void dump_in_background(JavaThread* current);
   static bool is_mapped() { return FileMapInfo::dynamic_info() != nullptr; }
   static bool validate(FileMapInfo* dynamic_info);
   static void dump_array_klasses();
@@ -311,6 +311,7 @@ void SharedClassPathEntry::init(bool is_modules_image,
   assert(CDSConfig::is_dumping_archive(), "sanity");
   _timestamp = 0;
   _filesize  = 0;
+  _digest = 0;
   _from_class_path_attr = false;
 
   struct stat st;
@@ -325,6 +326,9 @@ void SharedClassPathEntry::init(bool is_modules_image,
         _type = jar_entry;
         _timestamp = st.st_mtime;
         _from_class_path_attr = cpe->from_class_path_attr();
+        if (!jar_digest(cpe->name(), &_digest)) {
+          _digest = 0;
+        }
       }
       _filesize = st.st_size;
       _is_module_path = is_module_path;
@@ -357,6 +361,7 @@ void SharedClassPathEntry::copy_from(SharedClassPathEntry* ent, ClassLoaderData*
   _is_module_path = ent->_is_module_path;
   _timestamp = ent->_timestamp;
   _filesize = ent->_filesize;
+  _digest = ent->_digest;
   _from_class_path_attr = ent->_from_class_path_attr;
   set_name(ent->name(), CHECK);
 
@@ -382,6 +387,60 @@ const char* SharedClassPathEntry::name() const {
   }
 }
 
+// Compute a digest of a jar file from its central directory, which holds the
+// CRC and size of every entry, so that it changes with the contents of the
+// jar even when the size and modification time of the file do not.
+bool SharedClassPathEntry::jar_digest(const char* path, u4* digest) {
+  const int ENDHDR = 22;                 // size of the end of central directory record
+  const int ENDSIG = 0x06054b50;
+  const int MAX_TAIL = ENDHDR + 0xFFFF;  // end record plus maximum comment length
+  const int CHUNK = 64 * K;
+
+  int fd = os::open(path, O_RDONLY | O_BINARY, 0);
+  if (fd < 0) {
+    return false;
+  }
+  jlong file_size = os::lseek(fd, 0, SEEK_END);
+  bool ok = false;
+  ResourceMark rm;
+  char* buf = NEW_RESOURCE_ARRAY(char, MAX2(CHUNK, MAX_TAIL));
+  if (file_size >= ENDHDR) {
+    int tail = (int)MIN2(file_size, (jlong)MAX_TAIL);
+    if (os::read_at(fd, buf, tail, file_size - tail) == tail) {
+      // Locate the end record, searching backwards past any comment.
+      for (int pos = tail - ENDHDR; pos >= 0; pos--) {
+        const u1* p = (const u1*)buf + pos;
+        if ((p[0] | (p[1] << 8) | (p[2] << 16) | ((u4)p[3] << 24)) == (u4)ENDSIG) {
+          u4 cen_size = p[12] | (p[13] << 8) | (p[14] << 16) | ((u4)p[15] << 24);
+          u4 cen_offset = p[16] | (p[17] << 8) | (p[18] << 16) | ((u4)p[19] << 24);
+          int crc = ClassLoader::crc32(0, (const char*)p, tail - pos);
+          if (cen_size != 0xFFFFFFFF && cen_offset != 0xFFFFFFFF &&
+              (jlong)cen_offset + cen_size <= file_size) {
+            // Fold in the central directory. For zip64 archives the end
+            // records and the tail of the directory have to do.
+            jlong offset = cen_offset;
+            jlong end = offset + cen_size;
+            ok = true;
+            while (ok && offset < end) {
+              int n = (int)MIN2((jlong)CHUNK, end - offset);
+              ok = os::read_at(fd, buf, n, offset) == n;
+              crc = ClassLoader::crc32(crc, buf, n);
+              offset += n;
+            }
+          } else {
+            crc = ClassLoader::crc32(crc, buf, tail);
+            ok = true;
+          }
+          *digest = (u4)crc;
+          break;
+        }
+      }
+    }
+  }
+  ::close(fd);
+  return ok;
+}
+
 bool SharedClassPathEntry::validate(bool is_class_path) const {
   assert(CDSConfig::is_using_archive(), "runtime only");
 
@@ -405,10 +464,16 @@ bool SharedClassPathEntry::validate(bool is_class_path) const {
   } else {
     bool size_differs = _filesize != st.st_size;
     bool time_differs = has_timestamp() && _timestamp != st.st_mtime;
-    if (time_differs || size_differs) {
+    bool digest_differs = false;
+    if (!time_differs && !size_differs && ValidateSharedClassPathDigest && is_jar() && _digest != 0) {
+      u4 digest;
+      digest_differs = !jar_digest(name, &digest) || digest != _digest;
+    }
+    if (time_differs || size_differs || digest_differs) {
       ok = false;
       if (PrintSharedArchiveAndExit) {
-        log_warning(cds)(time_differs ? "Timestamp mismatch" : "File size mismatch");
+        log_warning(cds)(time_differs ? "Timestamp mismatch" :
+                         size_differs ? "File size mismatch" : "Digest mismatch");
       } else {
         const char* bad_file_msg = "This file is not the one used while building the shared archive file:";
         log_warning(cds)("%s %s", bad_file_msg, name);
@@ -421,6 +486,9 @@ bool SharedClassPathEntry::validate(bool is_class_path) const {
         if (size_differs) {
           log_warning(cds)("%s size has changed.", name);
         }
+        if (digest_differs) {
+          log_warning(cds)("%s contents have changed.", name);
+        }
       }
     }
   }
@@ -63,6 +63,7 @@ class SharedClassPathEntry : public MetaspaceObj {
   u1     _type;
   bool   _is_module_path;
   bool   _from_class_path_attr;
+  u4     _digest;             // jar central directory CRC, 0 if not computed
   time_t _timestamp;          // jar timestamp,  0 if is directory, modules image or other
   int64_t      _filesize;     // jar/jimage file size, -1 if is directory, -2 if other
   Array<char>* _name;
@@ -70,7 +71,7 @@ class SharedClassPathEntry : public MetaspaceObj {
 
 public:
   SharedClassPathEntry() : _type(0), _is_module_path(false),
-                           _from_class_path_attr(false), _timestamp(0),
+                           _from_class_path_attr(false), _digest(0), _timestamp(0),
                            _filesize(0), _name(nullptr), _manifest(nullptr) {}
   static int size() {
     static_assert(is_aligned(sizeof(SharedClassPathEntry), wordSize), "must be");
@@ -81,6 +82,7 @@ class SharedClassPathEntry : public MetaspaceObj {
   void metaspace_pointers_do(MetaspaceClosure* it);
   MetaspaceObj::Type type() const { return SharedClassPathEntryType; }
   bool validate(bool is_class_path = true) const;
+  static bool jar_digest(const char* path, u4* digest);
 
   // The _timestamp only gets set for jar files.
   bool has_timestamp() const {
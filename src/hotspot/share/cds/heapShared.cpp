@@ -549,11 +549,17 @@ void HeapShared::archive_objects(ArchiveHeapInfo *heap_info) {
     // Cache for recording where the archived objects are copied to
     create_archived_object_cache();
 
-    log_info(cds)("Heap range = [" PTR_FORMAT " - "  PTR_FORMAT "]",
-                   UseCompressedOops ? p2i(CompressedOops::begin()) :
-                                       p2i((address)G1CollectedHeap::heap()->reserved().start()),
-                   UseCompressedOops ? p2i(CompressedOops::end()) :
-                                       p2i((address)G1CollectedHeap::heap()->reserved().end()));
+    if (UseCompressedOops) {
+      log_info(cds)("Heap range = [" PTR_FORMAT " - "  PTR_FORMAT "]",
+                     p2i(CompressedOops::begin()), p2i(CompressedOops::end()));
+    }
+#if INCLUDE_G1GC
+    else if (UseG1GC) {
+      log_info(cds)("Heap range = [" PTR_FORMAT " - "  PTR_FORMAT "]",
+                     p2i((address)G1CollectedHeap::heap()->reserved().start()),
+                     p2i((address)G1CollectedHeap::heap()->reserved().end()));
+    }
+#endif
     copy_objects();
 
     CDSHeapVerifier::verify();
@@ -49,6 +49,8 @@
 #include "runtime/handles.inline.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "utilities/resourceHash.hpp"
 
 GrowableArrayCHeap<char*, mtClassShared>* LambdaFormInvokers::_lambdaform_lines = nullptr;
 Array<Array<char>*>*  LambdaFormInvokers::_static_archive_invokers = nullptr;
@@ -69,12 +71,33 @@ static bool should_be_archived(char* line) {
 }
 #undef NUM_FILTER
 
-void LambdaFormInvokers::append(char* line) {
+static unsigned int line_hash(const char* const& line) {
+  return java_lang_String::hash_code((const jbyte*)line, (int)strlen(line));
+}
+
+static bool line_equals(const char* const& a, const char* const& b) {
+  return strcmp(a, b) == 0;
+}
+
+// The same LambdaForm is typically resolved many times during a run, and the
+// static archive lines are added again for a dynamic dump. Only one copy of each
+// line is kept, so each form is regenerated into the holder classes once.
+typedef ResourceHashtable<const char*, bool, 1009, AnyObj::C_HEAP, mtClassShared,
+                          line_hash, line_equals> LambdaFormLineTable;
+static LambdaFormLineTable* _lambdaform_line_table = nullptr;
+
+void LambdaFormInvokers::append(const char* line) {
   MutexLocker ml(Thread::current(), LambdaFormInvokers_lock);
   if (_lambdaform_lines == nullptr) {
     _lambdaform_lines = new GrowableArrayCHeap<char*, mtClassShared>(150);
+    _lambdaform_line_table = new LambdaFormLineTable();
+  }
+  if (_lambdaform_line_table->contains(line)) {
+    return;
   }
-  _lambdaform_lines->append(line);
+  char* copy = os::strdup(line, mtClassShared);
+  _lambdaform_line_table->put(copy, true);
+  _lambdaform_lines->append(copy);
 }
 
 
@@ -41,7 +41,7 @@ class LambdaFormInvokers : public AllStatic {
   static Array<Array<char>*>* _static_archive_invokers;
   static void regenerate_class(char* name, ClassFileStream& st, TRAPS);
  public:
-  static void append(char* line);
+  static void append(const char* line);
   static void dump_static_archive_invokers();
   static void read_static_archive_invokers();
   static void regenerate_holder_classes(TRAPS);
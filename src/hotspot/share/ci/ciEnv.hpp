@@ -82,6 +82,7 @@ class ciEnv : StackObj {
   // Cache DTrace flags
   bool  _dtrace_method_probes;
   bool  _dtrace_alloc_probes;
+  bool  _trace_method_calls;
 
   // Distinguished instances of certain ciObjects..
   static ciObject*              _null_object_instance;
@@ -359,6 +360,9 @@ class ciEnv : StackObj {
   // Cache DTrace flags
   void  cache_dtrace_flags();
   bool  dtrace_method_probes()   const { return _dtrace_method_probes; }
+  // Entry and exit probes for the method being compiled, but not for the
+  // methods inlined into it.
+  bool  method_probes()          const { return _dtrace_method_probes || _trace_method_calls; }
   bool  dtrace_alloc_probes()    const { return _dtrace_alloc_probes; }
 
   // The compiler task which has created this env.
@@ -383,6 +387,7 @@ class ciEnv : StackObj {
                        bool                      has_unsafe_access,
                        bool                      has_wide_vectors,
                        bool                      has_monitors,
+                       bool                      has_scoped_access,
                        int                       immediate_oops_patched);
 
   // Access to certain well known ciObjects.
@@ -92,6 +92,7 @@ ciMethod::ciMethod(const methodHandle& h_m, ciInstanceKlass* holder) :
   _can_be_parsed      = true;
   _has_reserved_stack_access = h_m->has_reserved_stack_access();
   _is_overpass        = h_m->is_overpass();
+  _is_scoped          = h_m->is_scoped();
   // Lazy fields, filled in on demand.  Require allocation.
   _code               = nullptr;
   _exception_handlers = nullptr;
@@ -94,6 +94,7 @@ class ciMethod : public ciMetadata {
   bool _can_omit_stack_trace;
   bool _has_reserved_stack_access;
   bool _is_overpass;
+  bool _is_scoped;
 
   // Lazy fields, filled in on demand
   address              _code;
@@ -356,6 +357,7 @@ class ciMethod : public ciMetadata {
   bool is_empty       () const;
   bool can_be_statically_bound() const           { return _can_be_statically_bound; }
   bool has_reserved_stack_access() const         { return _has_reserved_stack_access; }
+  bool is_scoped() const                         { return _is_scoped; }
   bool is_boxing_method() const;
   bool is_unboxing_method() const;
   bool is_vector_method() const;
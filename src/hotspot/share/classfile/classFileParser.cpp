@@ -39,6 +39,7 @@
 #include "classfile/verifier.hpp"
 #include "classfile/vmClasses.hpp"
 #include "classfile/vmSymbols.hpp"
+#include "gc/shared/stringdedup/stringDedup.hpp"
 #include "jvm.h"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
@@ -5345,6 +5346,10 @@ void ClassFileParser::fill_instance_klass(InstanceKlass* ik,
     ik->set_has_contended_annotations(true);
   }
 
+  if (StringDedup::is_enabled()) {
+    StringDedup::initialize_array_fields(ik);
+  }
+
   // Fill in has_finalizer and layout_helper
   set_precomputed_flags(ik);
 
@@ -93,6 +93,7 @@ static JImageOpen_t                    JImageOpen             = nullptr;
 static JImageClose_t                   JImageClose            = nullptr;
 static JImageFindResource_t            JImageFindResource     = nullptr;
 static JImageGetResource_t             JImageGetResource      = nullptr;
+static JImageGetResourceAddress_t      JImageGetResourceAddress = nullptr;
 
 // JimageFile pointer, or null if exploded JDK build.
 static JImageFile*                     JImage_file            = nullptr;
@@ -439,11 +440,20 @@ ClassFileStream* ClassPathImageEntry::open_stream_for_loader(JavaThread* current
     if (UsePerfData) {
       ClassLoader::perf_sys_classfile_bytes_read()->inc(size);
     }
-    char* data = NEW_RESOURCE_ARRAY(char, size);
-    (*JImageGetResource)(jimage_non_null(), location, data, size);
+    // Use uncompressed resources in place in the mapped image, which stays
+    // mapped for the lifetime of the VM.
+    const char* data = nullptr;
+    if (JImageGetResourceAddress != nullptr) {
+      data = (*JImageGetResourceAddress)(jimage_non_null(), location);
+    }
+    if (data == nullptr) {
+      char* buffer = NEW_RESOURCE_ARRAY(char, size);
+      (*JImageGetResource)(jimage_non_null(), location, buffer, size);
+      data = buffer;
+    }
     // Resource allocated
     assert(this == (ClassPathImageEntry*)ClassLoader::get_jrt_entry(), "must be");
-    return new ClassFileStream((u1*)data,
+    return new ClassFileStream((const u1*)data,
                                checked_cast<int>(size),
                                _name,
                                ClassFileStream::verify,
@@ -973,6 +983,8 @@ void ClassLoader::load_jimage_library() {
   JImageClose = CAST_TO_FN_PTR(JImageClose_t, dll_lookup(handle, "JIMAGE_Close", path));
   JImageFindResource = CAST_TO_FN_PTR(JImageFindResource_t, dll_lookup(handle, "JIMAGE_FindResource", path));
   JImageGetResource = CAST_TO_FN_PTR(JImageGetResource_t, dll_lookup(handle, "JIMAGE_GetResource", path));
+  // Optional, a missing entry point falls back to copying every resource.
+  JImageGetResourceAddress = CAST_TO_FN_PTR(JImageGetResourceAddress_t, os::dll_lookup(handle, "JIMAGE_GetResourceAddress"));
 }
 
 int ClassLoader::crc32(int crc, const char* buf, int len) {
@@ -1354,20 +1366,20 @@ void ClassLoader::initialize(TRAPS) {
     NEWPERFTICKCOUNTER(_perf_class_verify_selftime, SUN_CLS, "classVerifyTime.self");
     NEWPERFTICKCOUNTER(_perf_class_link_time, SUN_CLS, "classLinkedTime");
     NEWPERFTICKCOUNTER(_perf_class_link_selftime, SUN_CLS, "classLinkedTime.self");
-    NEWPERFEVENTCOUNTER(_perf_classes_inited, SUN_CLS, "initializedClasses");
-    NEWPERFEVENTCOUNTER(_perf_classes_linked, SUN_CLS, "linkedClasses");
-    NEWPERFEVENTCOUNTER(_perf_classes_verified, SUN_CLS, "verifiedClasses");
+    NEWPERFSTRIPEDEVENTCOUNTER(_perf_classes_inited, SUN_CLS, "initializedClasses");
+    NEWPERFSTRIPEDEVENTCOUNTER(_perf_classes_linked, SUN_CLS, "linkedClasses");
+    NEWPERFSTRIPEDEVENTCOUNTER(_perf_classes_verified, SUN_CLS, "verifiedClasses");
 
     NEWPERFTICKCOUNTER(_perf_shared_classload_time, SUN_CLS, "sharedClassLoadTime");
     NEWPERFTICKCOUNTER(_perf_sys_classload_time, SUN_CLS, "sysClassLoadTime");
     NEWPERFTICKCOUNTER(_perf_app_classload_time, SUN_CLS, "appClassLoadTime");
     NEWPERFTICKCOUNTER(_perf_app_classload_selftime, SUN_CLS, "appClassLoadTime.self");
-    NEWPERFEVENTCOUNTER(_perf_app_classload_count, SUN_CLS, "appClassLoadCount");
+    NEWPERFSTRIPEDEVENTCOUNTER(_perf_app_classload_count, SUN_CLS, "appClassLoadCount");
     NEWPERFTICKCOUNTER(_perf_define_appclasses, SUN_CLS, "defineAppClasses");
     NEWPERFTICKCOUNTER(_perf_define_appclass_time, SUN_CLS, "defineAppClassTime");
     NEWPERFTICKCOUNTER(_perf_define_appclass_selftime, SUN_CLS, "defineAppClassTime.self");
-    NEWPERFBYTECOUNTER(_perf_app_classfile_bytes_read, SUN_CLS, "appClassBytes");
-    NEWPERFBYTECOUNTER(_perf_sys_classfile_bytes_read, SUN_CLS, "sysClassBytes");
+    NEWPERFSTRIPEDBYTECOUNTER(_perf_app_classfile_bytes_read, SUN_CLS, "appClassBytes");
+    NEWPERFSTRIPEDBYTECOUNTER(_perf_sys_classfile_bytes_read, SUN_CLS, "sysClassBytes");
     NEWPERFEVENTCOUNTER(_unsafe_defineClassCallCounter, SUN_CLS, "unsafeDefineClassCalls");
     NEWPERFTICKCOUNTER(_perf_secondary_hash_time, SUN_CLS, "secondarySuperHashTime");
 
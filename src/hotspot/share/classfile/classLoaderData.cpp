@@ -138,6 +138,7 @@ ClassLoaderData::ClassLoaderData(Handle h_class_loader, bool has_class_mirror_ho
   _metaspace_lock(new Mutex(Mutex::nosafepoint-2, "MetaspaceAllocation_lock")),
   _unloading(false), _has_class_mirror_holder(has_class_mirror_holder),
   _modified_oops(true),
+  _modified_chunks_only(false),
   // A non-strong hidden class loader data doesn't have anything to keep
   // it from being unloaded during parsing of the non-strong hidden class.
   // The null-class-loader should always be kept alive.
@@ -196,6 +197,7 @@ OopHandle ClassLoaderData::ChunkedHandleList::add(oop o) {
   }
   oop* handle = &_head->_data[_head->_size];
   NativeAccess<IS_DEST_UNINITIALIZED>::oop_store(handle, o);
+  _head->_modified = true;
   Atomic::release_store(&_head->_size, _head->_size + 1);
   return OopHandle(handle);
 }
@@ -381,6 +383,28 @@ void ClassLoaderData::oops_do(OopClosure* f, int claim_value, bool clear_mod_oop
   _handles.oops_do(f);
 }
 
+void ClassLoaderData::modified_oops_do(OopClosure* f) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  const bool scan_all = !_modified_chunks_only;
+  bool modified = false;
+  for (ChunkedHandleList::Chunk* c = _handles._head; c != nullptr; c = c->_next) {
+    if (!scan_all && !c->_modified) {
+      continue;
+    }
+    // The closure records modified oops if a handle in this chunk still
+    // refers to a young gen object after the scan.
+    c->_modified = false;
+    clear_modified_oops();
+    _handles.oops_do_chunk(f, c, c->_size);
+    if (_modified_oops) {
+      c->_modified = true;
+      modified = true;
+    }
+  }
+  _modified_oops = modified;
+  _modified_chunks_only = true;
+}
+
 void ClassLoaderData::classes_do(KlassClosure* klass_closure) {
   // Lock-free access requires load_acquire
   for (Klass* k = Atomic::load_acquire(&_klasses); k != nullptr; k = k->next_link()) {
@@ -510,9 +534,9 @@ void ClassLoaderData::record_dependency(const Klass* k) {
       ls.cr();
     }
     Handle dependency(Thread::current(), to);
+    // Added a potentially young gen oop to the ClassLoaderData, add_handle
+    // records the modified chunk.
     add_handle(dependency);
-    // Added a potentially young gen oop to the ClassLoaderData
-    record_modified_oops();
   }
 }
 
@@ -829,7 +853,7 @@ ClassLoaderMetaspace* ClassLoaderData::metaspace_non_null() {
 
 OopHandle ClassLoaderData::add_handle(Handle h) {
   MutexLocker ml(metaspace_lock(),  Mutex::_no_safepoint_check_flag);
-  record_modified_oops();
+  record_modified_chunk();
   return _handles.add(h());
 }
 
@@ -847,7 +871,7 @@ void ClassLoaderData::init_handle_locked(OopHandle& dest, Handle h) {
   if (dest.resolve() != nullptr) {
     return;
   } else {
-    record_modified_oops();
+    record_modified_chunk();
     dest = _handles.add(h());
   }
 }
@@ -903,6 +927,14 @@ void ClassLoaderData::free_deallocate_list() {
       ClassLoaderDataGraph::set_should_clean_deallocate_lists();
     }
   }
+
+  if (MetaspaceReclaimFreeChunks && _metaspace != nullptr) {
+    size_t reclaimed_words = _metaspace->reclaim_free_chunks();
+    if (reclaimed_words > 0) {
+      log_debug(class, loader, data)("reclaimed " SIZE_FORMAT " metaspace words from " PTR_FORMAT,
+                                     reclaimed_words, p2i(this));
+    }
+  }
 }
 
 // This is distinct from free_deallocate_list.  For class loader data that are
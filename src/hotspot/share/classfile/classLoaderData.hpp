@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -75,10 +75,14 @@ class ClassLoaderData : public CHeapObj<mtClass> {
       oop _data[CAPACITY];
       volatile juint _size;
       Chunk* _next;
+      // Set when a handle in this chunk may refer to a young gen object.
+      bool _modified;
 
-      Chunk(Chunk* c) : _size(0), _next(c) { }
+      Chunk(Chunk* c) : _size(0), _next(c), _modified(false) { }
     };
 
+    friend class ClassLoaderData;
+
     Chunk* volatile _head;
 
     void oops_do_chunk(OopClosure* f, Chunk* c, const juint size);
@@ -102,6 +106,7 @@ class ClassLoaderData : public CHeapObj<mtClass> {
   friend class ClassLoaderDataGraphIteratorBase;
   friend class ClassLoaderDataGraphKlassIteratorAtomic;
   friend class ClassLoaderDataGraphKlassIteratorStatic;
+  friend class ClassLoaderDataGraphCLDIteratorAtomic;
   friend class ClassLoaderDataGraphMetaspaceIterator;
   friend class Klass;
   friend class MetaDataFactory;
@@ -124,6 +129,8 @@ class ClassLoaderData : public CHeapObj<mtClass> {
 
   // Remembered sets support for the oops in the class loader data.
   bool _modified_oops;     // Card Table Equivalent
+  bool _modified_chunks_only; // The handle chunks that may hold young gen references
+                              // are marked as modified, only those need to be scanned.
 
   int _keep_alive;         // if this CLD is kept alive.
                            // Used for non-strong hidden classes and the
@@ -200,10 +207,19 @@ class ClassLoaderData : public CHeapObj<mtClass> {
   // the Mod Union Table can't be used to mark when CLD have modified oops.
   // The CT and MUT bits saves this information for the whole class loader data.
   void clear_modified_oops()             { _modified_oops = false; }
+  // A handle has been added to the head chunk, which marks the chunk as modified.
+  void record_modified_chunk()           { _modified_oops = true; }
  public:
-  void record_modified_oops()            { _modified_oops = true; }
+  // The modified oops are not known, the next young collection scans all handles.
+  void record_modified_oops()            { _modified_oops = true; _modified_chunks_only = false; }
   bool has_modified_oops()               { return _modified_oops; }
 
+  // Applies the closure to the handles that may refer to young gen objects
+  // and clears the modified state of the handles found not to. The closure
+  // calls record_modified_oops() for any handle that still refers to a young
+  // gen object. Called by one thread per CLD at a safepoint.
+  void modified_oops_do(OopClosure* f);
+
   oop holder_no_keepalive() const;
   oop holder() const;
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -30,6 +30,7 @@
 #include "classfile/metadataOnStackMark.hpp"
 #include "classfile/moduleEntry.hpp"
 #include "classfile/packageEntry.hpp"
+#include "classfile/symbolTable.hpp"
 #include "code/dependencyContext.hpp"
 #include "gc/shared/classUnloadingContext.hpp"
 #include "logging/log.hpp"
@@ -42,6 +43,7 @@
 #include "runtime/mutex.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/safepointVerifiers.hpp"
+#include "runtime/trimNativeHeap.hpp"
 #include "runtime/vmOperations.hpp"
 #include "runtime/vmThread.hpp"
 #include "utilities/growableArray.hpp"
@@ -472,6 +474,10 @@ void ClassLoaderDataGraph::purge(bool at_safepoint) {
   Metaspace::purge(classes_unloaded);
   if (classes_unloaded) {
     set_metaspace_oom(false);
+    // Unloading classes frees native memory, like constant pool caches
+    // and symbols.
+    SymbolTable::notify_class_loaders_purged();
+    NativeHeapTrimmer::request_trim("class unloading");
   }
 
   DependencyContext::purge_dependency_contexts();
@@ -550,6 +556,38 @@ Klass* ClassLoaderDataGraphKlassIteratorAtomic::next_klass() {
   return nullptr;
 }
 
+ClassLoaderDataGraphCLDIteratorAtomic::ClassLoaderDataGraphCLDIteratorAtomic()
+    : _next_cld(nullptr) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint!");
+  _next_cld = ClassLoaderDataGraph::_head;
+}
+
+ClassLoaderData* ClassLoaderDataGraphCLDIteratorAtomic::next_cld() {
+  ClassLoaderData* head = Atomic::load(&_next_cld);
+
+  while (head != nullptr) {
+    ClassLoaderData* old_head = Atomic::cmpxchg(&_next_cld, head, head->next());
+
+    if (old_head == head) {
+      return head; // Won the CAS.
+    }
+
+    head = old_head;
+  }
+
+  // Nothing more for the iterator to hand out.
+  return nullptr;
+}
+
+void ClassLoaderDataGraphCLDIteratorAtomic::roots_cld_do(CLDClosure* strong, CLDClosure* weak) {
+  for (ClassLoaderData* cld = next_cld(); cld != nullptr; cld = next_cld()) {
+    CLDClosure* closure = cld->keep_alive() ? strong : weak;
+    if (closure != nullptr) {
+      closure->do_cld(cld);
+    }
+  }
+}
+
 void ClassLoaderDataGraph::verify() {
   ClassLoaderDataGraphIterator iter;
   while (ClassLoaderData* cld = iter.get_next()) {
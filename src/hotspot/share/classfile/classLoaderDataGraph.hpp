@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -37,6 +37,7 @@ class ClassLoaderDataGraph : public AllStatic {
   friend class ClassLoaderDataGraphMetaspaceIterator;
   friend class ClassLoaderDataGraphKlassIteratorAtomic;
   friend class ClassLoaderDataGraphKlassIteratorStatic;
+  friend class ClassLoaderDataGraphCLDIteratorAtomic;
   friend class VMStructs;
  private:
   class ClassLoaderDataGraphIterator;
@@ -152,4 +153,16 @@ class ClassLoaderDataGraphKlassIteratorAtomic : public StackObj {
   static Klass* next_klass_in_cldg(Klass* klass);
 };
 
+// An iterator that distributes CLDs to parallel worker threads at a safepoint.
+class ClassLoaderDataGraphCLDIteratorAtomic : public StackObj {
+  ClassLoaderData* volatile _next_cld;
+ public:
+  ClassLoaderDataGraphCLDIteratorAtomic();
+  ClassLoaderData* next_cld();
+
+  // Parallel version of ClassLoaderDataGraph::roots_cld_do(), every CLD is
+  // processed by one of the calling threads.
+  void roots_cld_do(CLDClosure* strong, CLDClosure* weak);
+};
+
 #endif // SHARE_CLASSFILE_CLASSLOADERDATAGRAPH_HPP
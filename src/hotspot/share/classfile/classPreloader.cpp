@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classPreloader.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "logging/log.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/instanceKlass.hpp"
+#include "oops/symbol.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/java.hpp"
+#include "runtime/os.hpp"
+#include "utilities/istream.hpp"
+#include "utilities/ostream.hpp"
+
+GrowableArrayCHeap<char*, mtClass>* ClassPreloader::_class_names = nullptr;
+volatile int ClassPreloader::_next_class = 0;
+volatile uint ClassPreloader::_active_threads = 0;
+
+void ClassPreloader::read_class_list(const char* file) {
+  FileInput file_input(file, "rt");
+  if (!file_input.is_open()) {
+    log_warning(preload)("Could not open class list %s", file);
+    return;
+  }
+  _class_names = new GrowableArrayCHeap<char*, mtClass>(1024);
+  for (inputStream input(&file_input); !input.done(); input.next()) {
+    char* line = input.current_line();
+    if (line[0] == '#' || line[0] == '@') {
+      // Comments and tags, like @lambda-proxy, name no class to preload.
+      continue;
+    }
+    if (strstr(line, " source:") != nullptr) {
+      // Class of a custom class loader.
+      continue;
+    }
+    // The class name is followed by optional attributes.
+    size_t len = strcspn(line, " \t\r");
+    if (len == 0 || len > (size_t)Symbol::max_length()) {
+      continue;
+    }
+    char* name = NEW_C_HEAP_ARRAY(char, len + 1, mtClass);
+    strncpy(name, line, len);
+    name[len] = '\0';
+    _class_names->append(name);
+  }
+  log_info(preload)("Preloading %d classes from %s", _class_names->length(), file);
+}
+
+void ClassPreloader::initialize(TRAPS) {
+  if (PreloadClassList == nullptr) {
+    return;
+  }
+  read_class_list(PreloadClassList);
+  if (_class_names == nullptr || _class_names->is_empty()) {
+    return;
+  }
+
+  uint num_threads = MIN2(PreloadClassListThreads, (uint)_class_names->length());
+  Atomic::store(&_active_threads, num_threads);
+  for (uint i = 0; i < num_threads; i++) {
+    char name[64];
+    os::snprintf_checked(name, sizeof(name), "Class Preloader Thread#%u", i);
+    Handle thread_oop = JavaThread::create_system_thread_object(name, CHECK);
+
+    ClassPreloaderThread* thread = new ClassPreloaderThread(&preload_thread_entry);
+    JavaThread::vm_exit_on_osthread_failure(thread);
+
+    JavaThread::start_internal_daemon(THREAD, thread, thread_oop, NormPriority);
+  }
+}
+
+void ClassPreloader::preload_class(const char* name, TRAPS) {
+  TempNewSymbol class_name = SymbolTable::new_symbol(name);
+  Handle loader(THREAD, SystemDictionary::java_system_loader());
+  Klass* k = SystemDictionary::resolve_or_null(class_name, loader, Handle(), CHECK);
+  if (k == nullptr) {
+    log_debug(preload)("Class not found: %s", name);
+  } else if (k->is_instance_klass()) {
+    // Linking verifies the class, so that is done here too.
+    InstanceKlass::cast(k)->link_class(CHECK);
+  }
+}
+
+void ClassPreloader::preload_thread_entry(JavaThread* thread, TRAPS) {
+  int num_classes = _class_names->length();
+  int num_loaded = 0;
+  for (int i = Atomic::fetch_then_add(&_next_class, 1);
+       i < num_classes;
+       i = Atomic::fetch_then_add(&_next_class, 1)) {
+    HandleMark hm(THREAD);
+    const char* name = _class_names->at(i);
+    preload_class(name, THREAD);
+    if (HAS_PENDING_EXCEPTION) {
+      // Leave reporting of the failure to the application's own loading
+      // of the class.
+      if (log_is_enabled(Debug, preload)) {
+        ResourceMark rm(THREAD);
+        log_debug(preload)("Failed to preload %s: %s", name,
+                           PENDING_EXCEPTION->klass()->external_name());
+      }
+      CLEAR_PENDING_EXCEPTION;
+    } else {
+      num_loaded++;
+    }
+  }
+  log_debug(preload)("%s preloaded %d classes", thread->name(), num_loaded);
+  thread_done();
+}
+
+void ClassPreloader::thread_done() {
+  if (Atomic::sub(&_active_threads, 1u) != 0) {
+    return;
+  }
+  // The last thread frees the class list.
+  log_info(preload)("Preloading from %s done", PreloadClassList);
+  for (int i = 0; i < _class_names->length(); i++) {
+    FREE_C_HEAP_ARRAY(char, _class_names->at(i));
+  }
+  delete _class_names;
+  _class_names = nullptr;
+}
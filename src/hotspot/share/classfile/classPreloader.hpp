@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_CLASSFILE_CLASSPRELOADER_HPP
+#define SHARE_CLASSFILE_CLASSPRELOADER_HPP
+
+#include "memory/allStatic.hpp"
+#include "runtime/javaThread.hpp"
+#include "utilities/growableArray.hpp"
+
+// Loads and links the classes named in the PreloadClassList class list on
+// background threads, so that the application threads find them already
+// loaded, parsed and verified.  The class list has the format written by
+// -XX:DumpLoadedClassList.  Classes are resolved through the system class
+// loader, so classes of the boot, platform and application loaders are
+// preloaded.  Classes of custom loaders (with a "source:" attribute) and
+// lambda proxy entries are skipped: the loader instances that will define
+// them are not known ahead of time.
+class ClassPreloader : AllStatic {
+  static GrowableArrayCHeap<char*, mtClass>* _class_names;
+  static volatile int _next_class;
+  static volatile uint _active_threads;
+
+  static void read_class_list(const char* file);
+  static void preload_thread_entry(JavaThread* thread, TRAPS);
+  static void preload_class(const char* name, TRAPS);
+  static void thread_done();
+
+ public:
+  // Starts the preloading threads if PreloadClassList is set.  Must be
+  // called after the system class loader has been initialized.
+  static void initialize(TRAPS);
+};
+
+// A hidden from external view JavaThread for preloading classes.
+class ClassPreloaderThread : public JavaThread {
+  friend class ClassPreloader;
+
+  ClassPreloaderThread(ThreadFunction entry_point) : JavaThread(entry_point) {};
+
+ public:
+  bool is_hidden_from_external_view() const { return true; }
+};
+
+#endif // SHARE_CLASSFILE_CLASSPRELOADER_HPP
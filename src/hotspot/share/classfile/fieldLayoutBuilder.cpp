@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "classfile/classFileParser.hpp"
 #include "classfile/fieldLayoutBuilder.hpp"
+#include "classfile/fieldLayoutProfile.hpp"
 #include "jvm.h"
 #include "memory/resourceArea.hpp"
 #include "oops/array.hpp"
@@ -492,6 +493,7 @@ FieldLayoutBuilder::FieldLayoutBuilder(const Symbol* classname, const InstanceKl
   _field_info(field_info),
   _info(info),
   _root_group(nullptr),
+  _hot_group(nullptr),
   _contended_groups(GrowableArray<FieldGroup*>(8)),
   _static_fields(nullptr),
   _layout(nullptr),
@@ -525,6 +527,9 @@ void FieldLayoutBuilder::prologue() {
   _static_layout->initialize_static_layout();
   _static_fields = new FieldGroup();
   _root_group = new FieldGroup();
+  if (FieldLayoutProfile::is_enabled()) {
+    _hot_group = new FieldGroup();
+  }
 }
 
 // Field sorting for regular classes:
@@ -532,6 +537,8 @@ void FieldLayoutBuilder::prologue() {
 //   - non-static fields are also sorted according to their contention group
 //     (support of the @Contended annotation)
 //   - @Contended annotation is ignored for static fields
+//   - with FieldLayoutProfileFile, the non-contended non-static fields
+//     listed in the profile are put in a separate group, laid out first
 void FieldLayoutBuilder::regular_field_sorting() {
   int idx = 0;
   for (GrowableArrayIterator<FieldInfo> it = _field_info->begin(); it != _field_info->end(); ++it, ++idx) {
@@ -550,6 +557,9 @@ void FieldLayoutBuilder::regular_field_sorting() {
         } else {
           group = get_or_create_contended_group(g);
         }
+      } else if (_hot_group != nullptr &&
+                 FieldLayoutProfile::weight(_classname, fieldinfo.name(_constant_pool)) > 0) {
+        group = _hot_group;
       } else {
         group = _root_group;
       }
@@ -577,6 +587,9 @@ void FieldLayoutBuilder::regular_field_sorting() {
     }
   }
   _root_group->sort_by_size();
+  if (_hot_group != nullptr) {
+    _hot_group->sort_by_size();
+  }
   _static_fields->sort_by_size();
   if (!_contended_groups.is_empty()) {
     for (int i = 0; i < _contended_groups.length(); i++) {
@@ -597,6 +610,8 @@ void FieldLayoutBuilder::insert_contended_padding(LayoutRawBlock* slot) {
 //   - primitive fields are allocated first (from the biggest to the smallest)
 //   - then oop fields are allocated, either in existing gaps or at the end of
 //     the layout
+//   - frequently accessed fields (see FieldLayoutProfile) are allocated the
+//     same way, but before all other fields, so they share cache lines
 void FieldLayoutBuilder::compute_regular_layout() {
   bool need_tail_padding = false;
   prologue();
@@ -609,6 +624,10 @@ void FieldLayoutBuilder::compute_regular_layout() {
     insert_contended_padding(_layout->start());
     need_tail_padding = true;
   }
+  if (_hot_group != nullptr) {
+    _layout->add(_hot_group->primitive_fields());
+    _layout->add(_hot_group->oop_fields());
+  }
   _layout->add(_root_group->primitive_fields());
   _layout->add(_root_group->oop_fields());
 
@@ -645,6 +664,13 @@ void FieldLayoutBuilder::epilogue() {
     _super_klass->nonstatic_oop_map_count());
   }
 
+  if (_hot_group != nullptr && _hot_group->oop_fields() != nullptr) {
+    for (int i = 0; i < _hot_group->oop_fields()->length(); i++) {
+      LayoutRawBlock* b = _hot_group->oop_fields()->at(i);
+      nonstatic_oop_maps->add(b->offset(), 1);
+    }
+  }
+
   if (_root_group->oop_fields() != nullptr) {
     for (int i = 0; i < _root_group->oop_fields()->length(); i++) {
       LayoutRawBlock* b = _root_group->oop_fields()->at(i);
@@ -233,6 +233,7 @@ class FieldLayoutBuilder : public ResourceObj {
   GrowableArray<FieldInfo>* _field_info;
   FieldLayoutInfo* _info;
   FieldGroup* _root_group;
+  FieldGroup* _hot_group;       // fields listed in FieldLayoutProfileFile, if any
   GrowableArray<FieldGroup*> _contended_groups;
   FieldGroup* _static_fields;
   FieldLayout* _layout;
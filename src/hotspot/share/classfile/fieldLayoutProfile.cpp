@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "classfile/fieldLayoutProfile.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "interpreter/bytecode.hpp"
+#include "interpreter/bytecodeStream.hpp"
+#include "logging/log.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/instanceKlass.hpp"
+#include "oops/method.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/handles.inline.hpp"
+#include "utilities/istream.hpp"
+#include "utilities/ostream.hpp"
+
+FieldLayoutProfile::FieldWeightTable* FieldLayoutProfile::_hot_fields = nullptr;
+FieldLayoutProfile::FieldWeightTable* FieldLayoutProfile::_dump_table = nullptr;
+
+// Splits off the next space separated field of line, or returns null if
+// there is none.
+static char* next_field(char** line) {
+  char* start = *line + strspn(*line, " \t");
+  size_t len = strcspn(start, " \t\r");
+  if (len == 0 || len > (size_t)Symbol::max_length()) {
+    return nullptr;
+  }
+  *line = start + len;
+  if (**line != '\0') {
+    **line = '\0';
+    (*line)++;
+  }
+  return start;
+}
+
+bool FieldLayoutProfile::parse_line(char* line, FieldWeightTable* table) {
+  char* klass = next_field(&line);
+  char* field = next_field(&line);
+  char* weight = next_field(&line);
+  if (klass == nullptr || field == nullptr || weight == nullptr) {
+    return false;
+  }
+  char* end;
+  errno = 0;
+  uint64_t value = (uint64_t)strtoull(weight, &end, 10);
+  if (*end != '\0' || errno != 0 || value == 0) {
+    return false;
+  }
+  // The symbols stay referenced by the table for the lifetime of the VM.
+  Key key(SymbolTable::new_symbol(klass), SymbolTable::new_symbol(field));
+  table->put(key, value);
+  return true;
+}
+
+void FieldLayoutProfile::load() {
+  if (FieldLayoutProfileFile == nullptr) {
+    return;
+  }
+  FileInput file_input(FieldLayoutProfileFile, "rt");
+  if (!file_input.is_open()) {
+    log_warning(class)("Could not open field layout profile file %s", FieldLayoutProfileFile);
+    return;
+  }
+  FieldWeightTable* table = new (mtClass) FieldWeightTable(1024, 256 * 1024);
+  for (inputStream input(&file_input); !input.done(); input.next()) {
+    char* line = input.current_line();
+    if (line[0] == '#' || line[0] == '\0') {
+      continue;
+    }
+    if (!parse_line(line, table)) {
+      log_warning(class)("Ignoring malformed line %d of field layout profile file %s",
+                         (int)input.lineno(), FieldLayoutProfileFile);
+    } else {
+      table->maybe_grow();
+    }
+  }
+  log_info(class)("Loaded %d hot fields from %s", table->number_of_entries(), FieldLayoutProfileFile);
+  Atomic::release_store(&_hot_fields, table);
+}
+
+uint64_t FieldLayoutProfile::weight(const Symbol* klass, const Symbol* field) {
+  assert(is_enabled(), "no field layout profile");
+  uint64_t* weight = _hot_fields->get(Key(klass, field));
+  return weight != nullptr ? *weight : 0;
+}
+
+void FieldLayoutProfile::count_field_accesses(Method* m) {
+  InstanceKlass* holder = m->method_holder();
+  if (holder->is_hidden() || !holder->is_rewritten() || m->is_native() || m->is_abstract()) {
+    return;
+  }
+  // The invocation and backedge counters approximate how often the field
+  // accesses of the method ran, without needing a profile per bytecode.
+  uint64_t count = (uint64_t)MAX2(m->invocation_count(), 0) + (uint64_t)MAX2(m->backedge_count(), 0);
+  if (count == 0) {
+    return;
+  }
+  Thread* current = Thread::current();
+  ResourceMark rm(current);
+  methodHandle mh(current, m);
+  BytecodeStream bs(mh);
+  Bytecodes::Code code;
+  while ((code = bs.next()) >= 0) {
+    if (code != Bytecodes::_getfield && code != Bytecodes::_putfield) {
+      continue;
+    }
+    Bytecode_field field(mh, bs.bci());
+    Key key(field.klass(), field.name());
+    bool created;
+    uint64_t* weight = _dump_table->put_if_absent(key, 0, &created);
+    *weight += count;
+    if (created) {
+      _dump_table->maybe_grow();
+    }
+  }
+}
+
+void FieldLayoutProfile::dump_at_exit() {
+  if (DumpFieldLayoutProfileFile == nullptr) {
+    return;
+  }
+  fileStream stream(DumpFieldLayoutProfileFile, "w");
+  if (!stream.is_open()) {
+    log_warning(class)("Could not open field layout profile file %s", DumpFieldLayoutProfileFile);
+    return;
+  }
+  stream.print_cr("# Instance field accesses, for use with -XX:FieldLayoutProfileFile");
+  _dump_table = new (mtClass) FieldWeightTable(1024, 256 * 1024);
+  SystemDictionary::methods_do(count_field_accesses);
+  _dump_table->iterate_all([&] (const Key& key, uint64_t& weight) {
+    ResourceMark rm;
+    const char* klass = key.klass()->as_C_string();
+    const char* field = key.field()->as_C_string();
+    // The file format has no quoting for names with spaces.
+    if (strchr(klass, ' ') == nullptr && strchr(field, ' ') == nullptr) {
+      stream.print_cr("%s %s " UINT64_FORMAT, klass, field, weight);
+    }
+  });
+  delete _dump_table;
+  _dump_table = nullptr;
+}
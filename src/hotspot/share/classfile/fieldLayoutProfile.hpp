@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef SHARE_CLASSFILE_FIELDLAYOUTPROFILE_HPP
+#define SHARE_CLASSFILE_FIELDLAYOUTPROFILE_HPP
+
+#include "memory/allStatic.hpp"
+#include "oops/symbol.hpp"
+#include "runtime/atomic.hpp"
+#include "utilities/resizeableResourceHash.hpp"
+
+class Method;
+
+// Carries the knowledge of which instance fields are accessed often over
+// to the next run of an application, so that the field layout can place
+// them next to each other, in as few cache lines as possible.
+//
+// With DumpFieldLayoutProfileFile, the getfield and putfield bytecodes of
+// the methods that ran are counted at exit, each weighted by the invocation
+// and backedge counts of its method, and written to a file, one field per
+// line as "klass field weight". The klass is the one the bytecode refers to.
+// With FieldLayoutProfileFile, such a file is read at startup and
+// FieldLayoutBuilder lays out the listed fields of a class before the
+// other instance fields of that class.
+class FieldLayoutProfile : AllStatic {
+  class Key {
+    const Symbol* _klass;
+    const Symbol* _field;
+
+   public:
+    Key(const Symbol* klass, const Symbol* field) : _klass(klass), _field(field) {}
+
+    const Symbol* klass() const { return _klass; }
+    const Symbol* field() const { return _field; }
+
+    static unsigned hash(const Key& k) {
+      return k._klass->identity_hash() ^ (k._field->identity_hash() * 31);
+    }
+    static bool equals(const Key& k1, const Key& k2) {
+      return k1._klass == k2._klass && k1._field == k2._field;
+    }
+  };
+
+  typedef ResizeableResourceHashtable<Key, uint64_t, AnyObj::C_HEAP, mtClass,
+                                      Key::hash, Key::equals> FieldWeightTable;
+
+  // Written once at startup, read-only afterwards.
+  static FieldWeightTable* _hot_fields;
+  // Only used while the profile is dumped.
+  static FieldWeightTable* _dump_table;
+
+  static bool parse_line(char* line, FieldWeightTable* table);
+  static void count_field_accesses(Method* m);
+
+ public:
+  // Read FieldLayoutProfileFile, if set.
+  static void load();
+  // Write DumpFieldLayoutProfileFile, if set.
+  static void dump_at_exit();
+
+  static bool is_enabled() {
+    return Atomic::load_acquire(&_hot_fields) != nullptr;
+  }
+
+  // The access weight of field of klass in FieldLayoutProfileFile, or 0
+  // if it is not listed.
+  static uint64_t weight(const Symbol* klass, const Symbol* field);
+};
+
+#endif // SHARE_CLASSFILE_FIELDLAYOUTPROFILE_HPP
@@ -34,6 +34,7 @@
 #include "classfile/javaClassesImpl.hpp"
 #include "classfile/javaThreadStatus.hpp"
 #include "classfile/moduleEntry.hpp"
+#include "classfile/stackTraceCache.hpp"
 #include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
@@ -2574,6 +2575,15 @@ void java_lang_Throwable::fill_in_stack_trace(Handle throwable, const methodHand
   bool skip_hidden = !ShowHiddenFrames;
   bool show_carrier = ShowCarrierFrames;
   ContinuationEntry* cont_entry = thread->last_continuation();
+  // With UseStackTraceCache, the frames are first collected, so that a
+  // cached backtrace for them can be used instead of building a new one.
+  // Cached frames refer to Method*s, which redefinition can free.
+  bool use_cache = UseStackTraceCache && !JvmtiExport::has_redefined_a_class();
+  StackTraceCache::Frame* cached_frames = nullptr;
+  bool hidden_top_frame = false;
+  if (use_cache) {
+    cached_frames = NEW_RESOURCE_ARRAY(StackTraceCache::Frame, StackTraceCacheMaxDepth);
+  }
   for (frame fr = thread->last_frame(); max_depth == 0 || max_depth != total_count;) {
     Method* method = nullptr;
     int bci = 0;
@@ -2668,15 +2678,46 @@ void java_lang_Throwable::fill_in_stack_trace(Handle throwable, const methodHand
         if (total_count == 0) {
           // The top frame will be hidden from the stack trace.
           bt.set_has_hidden_top_frame();
+          hidden_top_frame = true;
         }
         continue;
       }
     }
 
+    if (use_cache) {
+      if (total_count < StackTraceCacheMaxDepth) {
+        cached_frames[total_count]._method = method;
+        cached_frames[total_count]._bci = bci;
+        total_count++;
+        continue;
+      }
+      // Too deep to be cached, build the backtrace as usual.
+      for (int i = 0; i < total_count; i++) {
+        bt.push(cached_frames[i]._method, cached_frames[i]._bci, CHECK);
+      }
+      use_cache = false;
+    }
+
     bt.push(method, bci, CHECK);
     total_count++;
   }
 
+  if (use_cache) {
+    unsigned int hash = StackTraceCache::hash(cached_frames, total_count, hidden_top_frame);
+    objArrayOop backtrace = StackTraceCache::lookup(hash, cached_frames, total_count, hidden_top_frame);
+    if (backtrace != nullptr) {
+      log_info(stacktrace)("%s, %d (cached)", throwable->klass()->external_name(), total_count);
+      set_backtrace(throwable(), backtrace);
+      set_depth(throwable(), total_count);
+      return;
+    }
+    for (int i = 0; i < total_count; i++) {
+      bt.push(cached_frames[i]._method, cached_frames[i]._bci, CHECK);
+    }
+    Handle backtrace_h(THREAD, bt.backtrace());
+    StackTraceCache::insert(hash, cached_frames, total_count, hidden_top_frame, backtrace_h);
+  }
+
   log_info(stacktrace)("%s, %d", throwable->klass()->external_name(), total_count);
 
   // Put completed stack trace into throwable object
@@ -3012,7 +3053,7 @@ void java_lang_ClassFrameInfo::serialize_offsets(SerializeClosure* f) {
 }
 #endif
 
-static int get_flags(const methodHandle& m) {
+static int get_flags(const Method* m) {
   int flags = (jushort)( m->access_flags().as_short() & JVM_RECOGNIZED_METHOD_MODIFIERS );
   if (m->is_initializer()) {
     flags |= java_lang_invoke_MemberName::MN_IS_CONSTRUCTOR;
@@ -3037,10 +3078,10 @@ int java_lang_ClassFrameInfo::flags(oop obj) {
   return obj->int_field(_flags_offset);
 }
 
-void java_lang_ClassFrameInfo::init_class(Handle stackFrame, const methodHandle& m) {
+void java_lang_ClassFrameInfo::init_class(oop stackFrame, const Method* m) {
   stackFrame->obj_field_put(_classOrMemberName_offset, m->method_holder()->java_mirror());
   // flags is initialized when ClassFrameInfo object is constructed and retain the value
-  int flags = java_lang_ClassFrameInfo::flags(stackFrame()) | get_flags(m);
+  int flags = java_lang_ClassFrameInfo::flags(stackFrame) | get_flags(m);
   stackFrame->int_field_put(_flags_offset, flags);
 }
 
@@ -3048,7 +3089,7 @@ void java_lang_ClassFrameInfo::init_method(Handle stackFrame, const methodHandle
   oop rmethod_name = java_lang_invoke_ResolvedMethodName::find_resolved_method(m, CHECK);
   stackFrame->obj_field_put(_classOrMemberName_offset, rmethod_name);
   // flags is initialized when ClassFrameInfo object is constructed and retain the value
-  int flags = java_lang_ClassFrameInfo::flags(stackFrame()) | get_flags(m);
+  int flags = java_lang_ClassFrameInfo::flags(stackFrame()) | get_flags(m());
   stackFrame->int_field_put(_flags_offset, flags);
 }
 
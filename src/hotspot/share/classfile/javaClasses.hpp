@@ -1618,7 +1618,8 @@ class java_lang_ClassFrameInfo: AllStatic {
   static int  flags(oop info);
 
   // Setters
-  static void init_class(Handle stackFrame, const methodHandle& m);
+  // init_class does not safepoint, so it takes the raw frame info and method.
+  static void init_class(oop stackFrame, const Method* m);
   static void init_method(Handle stackFrame, const methodHandle& m, TRAPS);
 
   static void compute_offsets();
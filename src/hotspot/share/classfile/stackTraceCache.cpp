@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "classfile/stackTraceCache.hpp"
+#include "memory/allocation.hpp"
+#include "memory/universe.hpp"
+#include "oops/method.hpp"
+#include "oops/objArrayOop.hpp"
+#include "oops/weakHandle.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/globalCounter.inline.hpp"
+
+class StackTraceCache::Entry : public CHeapObj<mtClass> {
+  const unsigned int _hash;
+  const int _depth;
+  const bool _hidden_top_frame;
+  Frame* const _frames;
+  WeakHandle _backtrace;
+
+ public:
+  Entry* _next;  // in the list of entries to free
+
+  Entry(unsigned int hash, const Frame* frames, int depth, bool hidden_top_frame, Handle backtrace) :
+    _hash(hash),
+    _depth(depth),
+    _hidden_top_frame(hidden_top_frame),
+    _frames(NEW_C_HEAP_ARRAY(Frame, depth, mtClass)),
+    _backtrace(Universe::vm_weak(), backtrace),
+    _next(nullptr) {
+    memcpy(_frames, frames, depth * sizeof(Frame));
+  }
+
+  ~Entry() {
+    _backtrace.release(Universe::vm_weak());
+    FREE_C_HEAP_ARRAY(Frame, _frames);
+  }
+
+  bool matches(unsigned int hash, const Frame* frames, int depth, bool hidden_top_frame) const {
+    if (_hash != hash || _depth != depth || _hidden_top_frame != hidden_top_frame) {
+      return false;
+    }
+    for (int i = 0; i < depth; i++) {
+      if (_frames[i]._method != frames[i]._method || _frames[i]._bci != frames[i]._bci) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Null if the backtrace has been collected.
+  objArrayOop backtrace() const { return (objArrayOop)_backtrace.resolve(); }
+};
+
+StackTraceCache::Entry* volatile StackTraceCache::_table[StackTraceCache::table_size] = {};
+StackTraceCache::Entry* volatile StackTraceCache::_old_entries = nullptr;
+
+unsigned int StackTraceCache::hash(const Frame* frames, int depth, bool hidden_top_frame) {
+  unsigned int hash = hidden_top_frame ? 1 : 0;
+  for (int i = 0; i < depth; i++) {
+    hash = 31 * hash + (unsigned int)((uintptr_t)frames[i]._method >> LogBytesPerWord);
+    hash = 31 * hash + (unsigned int)frames[i]._bci;
+  }
+  return hash;
+}
+
+objArrayOop StackTraceCache::lookup(unsigned int hash, const Frame* frames, int depth, bool hidden_top_frame) {
+  // Need a critical section to avoid race against concurrent reclamation.
+  GlobalCounter::CriticalSection cs(Thread::current());
+  Entry* entry = Atomic::load_acquire(&_table[hash % table_size]);
+  // The methods of an entry with a live backtrace are kept alive by the
+  // mirrors in it. The frames of an entry with a dead backtrace may refer to
+  // unloaded methods, but such an entry never gives a result.
+  if (entry != nullptr && entry->matches(hash, frames, depth, hidden_top_frame)) {
+    return entry->backtrace();
+  }
+  return nullptr;
+}
+
+void StackTraceCache::insert(unsigned int hash, const Frame* frames, int depth, bool hidden_top_frame, Handle backtrace) {
+  Entry* entry = new Entry(hash, frames, depth, hidden_top_frame, backtrace);
+  Entry* old = Atomic::xchg(&_table[hash % table_size], entry);
+  if (old != nullptr) {
+    // Cannot free the old entry on the spot, lookups can still use it.
+    while (true) {
+      Entry* head = Atomic::load(&_old_entries);
+      old->_next = head;
+      if (Atomic::cmpxchg(&_old_entries, head, old) == head) {
+        break;
+      }
+    }
+  }
+}
+
+bool StackTraceCache::has_cleanup_work() {
+  return Atomic::load(&_old_entries) != nullptr;
+}
+
+void StackTraceCache::cleanup() {
+  Entry* entry = Atomic::xchg(&_old_entries, (Entry*)nullptr);
+  if (entry == nullptr) {
+    return;
+  }
+  GlobalCounter::write_synchronize();
+  while (entry != nullptr) {
+    Entry* next = entry->_next;
+    delete entry;
+    entry = next;
+  }
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef SHARE_CLASSFILE_STACKTRACECACHE_HPP
+#define SHARE_CLASSFILE_STACKTRACECACHE_HPP
+
+#include "memory/allStatic.hpp"
+#include "oops/oopsHierarchy.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class Handle;
+class Method;
+
+// Shares the backtraces of Throwables thrown from the same stack, with
+// UseStackTraceCache. A backtrace is never modified once it has been
+// filled in, so throwables with identical stacks can refer to the same
+// one, which saves allocating and filling the backtrace arrays.
+//
+// The cache is a fixed size table indexed by a hash of the (method, bci)
+// frames of a stack, with at most one entry per slot. An entry keeps its
+// frames for comparison and refers to the backtrace weakly, so unused
+// backtraces and the classes they keep alive can still be collected.
+// Lookups are lock-free. Replaced entries are freed by the ServiceThread
+// once no lookup can still be using them.
+class StackTraceCache : AllStatic {
+ public:
+  struct Frame {
+    Method* _method;
+    int _bci;
+  };
+
+ private:
+  class Entry;
+  static const int table_size = 1024;
+  static Entry* volatile _table[table_size];
+  static Entry* volatile _old_entries;
+
+ public:
+  static unsigned int hash(const Frame* frames, int depth, bool hidden_top_frame);
+
+  // Returns the cached backtrace for the given frames, or null.
+  static objArrayOop lookup(unsigned int hash, const Frame* frames, int depth, bool hidden_top_frame);
+  // Records backtrace as the backtrace for the given frames.
+  static void insert(unsigned int hash, const Frame* frames, int depth, bool hidden_top_frame, Handle backtrace);
+
+  static bool has_cleanup_work();
+  static void cleanup();
+};
+
+#endif // SHARE_CLASSFILE_STACKTRACECACHE_HPP
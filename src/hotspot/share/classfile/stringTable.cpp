@@ -45,10 +45,12 @@
 #include "memory/resourceArea.hpp"
 #include "oops/access.inline.hpp"
 #include "oops/compressedOops.hpp"
+#include "oops/objArrayOop.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/typeArrayOop.inline.hpp"
 #include "oops/weakHandle.inline.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/os.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/mutexLocker.hpp"
@@ -59,8 +61,12 @@
 #include "services/diagnosticCommand.hpp"
 #include "utilities/concurrentHashTable.inline.hpp"
 #include "utilities/concurrentHashTableTasks.inline.hpp"
+#include "utilities/globalCounter.inline.hpp"
+#include "utilities/growableArray.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/powerOfTwo.hpp"
 #include "utilities/resizeableResourceHash.hpp"
+#include "utilities/singleWriterSynchronizer.hpp"
 #include "utilities/utf8.hpp"
 #if INCLUDE_G1GC
 #include "gc/g1/g1CollectedHeap.hpp"
@@ -74,6 +80,8 @@ const size_t END_SIZE = 24;
 const size_t REHASH_LEN = 100;
 // If we have as many dead items as 50% of the number of bucket
 const double CLEAN_DEAD_HIGH_WATER_MARK = 0.5;
+// Number of buckets copied between safepoint checks by a concurrent rehash
+const size_t REHASH_CLAIM_SIZE = 1024;
 
 #if INCLUDE_CDS_JAVA_HEAP
 bool StringTable::_is_two_dimensional_shared_strings_array = false;
@@ -111,6 +119,21 @@ static SharedStringTable _shared_table;
 typedef ConcurrentHashTable<StringTableConfig, mtSymbol> StringTableHash;
 static StringTableHash* _local_table = nullptr;
 
+// The table that uses the alternative hash code once the table has been
+// rehashed. All other tables, including one being drained by a concurrent
+// rehash, use String.hashCode().
+static StringTableHash* _alt_hash_table = nullptr;
+
+// With ConcurrentStringTableRehash the old table stays readable while its
+// entries are copied into the new one. Lookups read it inside a
+// GlobalCounter critical section. Inserts enter _rehash_synchronizer before
+// picking a table, so the rehash can wait for inserts that may still go into
+// the old table, and inserts that already see the new table wait for
+// _rehash_handover to clear before they proceed.
+static StringTableHash* volatile _rehash_source = nullptr;
+static volatile bool _rehash_handover = false;
+static SingleWriterSynchronizer _rehash_synchronizer;
+
 volatile bool StringTable::_has_work = false;
 volatile bool StringTable::_needs_rehashing = false;
 OopStorage*   StringTable::_oop_storage;
@@ -123,12 +146,19 @@ volatile bool _alt_hash = false;
 static bool _rehashed = false;
 static uint64_t _alt_hash_seed = 0;
 
+// Mask for the per-thread cache index, or -1 if the cache is disabled.
+static int _thread_cache_mask = -1;
+
 static unsigned int hash_string(const jchar* s, int len, bool useAlt) {
   return  useAlt ?
     AltHashing::halfsiphash_32(_alt_hash_seed, s, len) :
     java_lang_String::hash_code(s, len);
 }
 
+static uintx table_hash(StringTableHash* table, const jchar* s, int len, unsigned int java_hash) {
+  return table == Atomic::load_acquire(&_alt_hash_table) ? hash_string(s, len, true) : java_hash;
+}
+
 class StringTableConfig : public StackObj {
  private:
  public:
@@ -240,6 +270,9 @@ void StringTable::create_table() {
   _local_table = new StringTableHash(start_size_log_2, END_SIZE, REHASH_LEN, true);
   _oop_storage = OopStorageSet::create_weak("StringTable Weak", mtSymbol);
   _oop_storage->register_num_dead_callback(&gc_notification);
+  if (StringTableThreadCacheSize > 0) {
+    _thread_cache_mask = checked_cast<int>(round_down_power_of_2(StringTableThreadCacheSize)) - 1;
+  }
 
 #if INCLUDE_CDS_JAVA_HEAP
   if (ArchiveHeapLoader::is_in_use()) {
@@ -295,9 +328,6 @@ oop StringTable::lookup(const jchar* name, int len) {
   if (string != nullptr) {
     return string;
   }
-  if (_alt_hash) {
-    hash = hash_string(name, len, true);
-  }
   return do_lookup(name, len, hash);
 }
 
@@ -323,16 +353,79 @@ void StringTable::update_needs_rehash(bool rehash) {
   }
 }
 
-oop StringTable::do_lookup(const jchar* name, int len, uintx hash) {
-  Thread* thread = Thread::current();
+static oop lookup_in(Thread* thread, StringTableHash* table, const jchar* name, int len, uintx hash) {
   StringTableLookupJchar lookup(thread, hash, name, len);
   StringTableGet stg(thread);
   bool rehash_warning;
-  _local_table->get(thread, lookup, stg, &rehash_warning);
-  update_needs_rehash(rehash_warning);
+  table->get(thread, lookup, stg, &rehash_warning);
+  StringTable::update_needs_rehash(rehash_warning);
   return stg.get_res_oop();
 }
 
+oop StringTable::do_lookup(const jchar* name, int len, unsigned int java_hash) {
+  Thread* thread = Thread::current();
+  GlobalCounter::CriticalSection cs(thread);
+  StringTableHash* table = Atomic::load_acquire(&_local_table);
+  oop string = lookup_in(thread, table, name, len, table_hash(table, name, len, java_hash));
+  if (string == nullptr) {
+    StringTableHash* source = Atomic::load_acquire(&_rehash_source);
+    if (source != nullptr && source != table) {
+      string = lookup_in(thread, source, name, len, java_hash);
+    }
+  }
+  return string;
+}
+
+// Per-thread cache
+//
+// Each thread may keep a small direct-mapped String[] of the Strings it
+// recently interned, indexed by String.hashCode(). A hit avoids the table
+// lookup and, for intern(oop), the conversion to unicode. The cache holds
+// strong references, so a cached String stays alive and thereby remains
+// the instance the table returns for its value.
+static oop lookup_thread_cache(JavaThread* thread, unsigned int hash, const jchar* name, int len) {
+  objArrayOop cache = objArrayOop(thread->string_table_cache());
+  if (cache != nullptr) {
+    oop string = cache->obj_at(hash & _thread_cache_mask);
+    if (string != nullptr && java_lang_String::equals(string, name, len)) {
+      return string;
+    }
+  }
+  return nullptr;
+}
+
+static oop lookup_thread_cache(JavaThread* thread, unsigned int hash, oop key) {
+  objArrayOop cache = objArrayOop(thread->string_table_cache());
+  if (cache != nullptr) {
+    oop string = cache->obj_at(hash & _thread_cache_mask);
+    if (string != nullptr && (string == key || java_lang_String::equals(string, key))) {
+      return string;
+    }
+  }
+  return nullptr;
+}
+
+// Returns string, which may have moved if the cache had to be allocated.
+static oop add_to_thread_cache(JavaThread* thread, unsigned int hash, oop string) {
+  if (_thread_cache_mask < 0 || thread->threadObj() == nullptr) {
+    return string;
+  }
+  objArrayOop cache = objArrayOop(thread->string_table_cache());
+  if (cache == nullptr) {
+    Handle h_string(thread, string);
+    cache = oopFactory::new_objArray(vmClasses::String_klass(), _thread_cache_mask + 1, thread);
+    if (thread->has_pending_exception()) {
+      // The cache is only an optimization, don't fail the intern.
+      thread->clear_pending_exception();
+      return h_string();
+    }
+    thread->set_string_table_cache(cache);
+    string = h_string();
+  }
+  cache->obj_at_put(hash & _thread_cache_mask, string);
+  return string;
+}
+
 // Interning
 oop StringTable::intern(Symbol* symbol, TRAPS) {
   if (symbol == nullptr) return nullptr;
@@ -346,6 +439,12 @@ oop StringTable::intern(Symbol* symbol, TRAPS) {
 
 oop StringTable::intern(oop string, TRAPS) {
   if (string == nullptr) return nullptr;
+  if (_thread_cache_mask >= 0) {
+    oop found_string = lookup_thread_cache(THREAD, java_lang_String::hash_code(string), string);
+    if (found_string != nullptr) {
+      return found_string;
+    }
+  }
   ResourceMark rm(THREAD);
   int length;
   Handle h_string (THREAD, string);
@@ -366,25 +465,89 @@ oop StringTable::intern(const char* utf8_string, TRAPS) {
   return result;
 }
 
+void StringTable::intern_all(objArrayHandle strings, TRAPS) {
+  for (int i = 0; i < strings->length(); i++) {
+    oop string = strings->obj_at(i);
+    if (string != nullptr) {
+      oop result = intern(string, CHECK);
+      strings->obj_at_put(i, result);
+    }
+  }
+}
+
 oop StringTable::intern(Handle string_or_null_h, const jchar* name, int len, TRAPS) {
   // shared table always uses java_lang_String::hash_code
-  unsigned int hash = java_lang_String::hash_code(name, len);
-  oop found_string = lookup_shared(name, len, hash);
+  unsigned int java_hash = java_lang_String::hash_code(name, len);
+  oop found_string = lookup_shared(name, len, java_hash);
   if (found_string != nullptr) {
     return found_string;
   }
-  if (_alt_hash) {
-    hash = hash_string(name, len, true);
+  if (_thread_cache_mask >= 0) {
+    found_string = lookup_thread_cache(THREAD, java_hash, name, len);
+    if (found_string != nullptr) {
+      return found_string;
+    }
   }
-  found_string = do_lookup(name, len, hash);
-  if (found_string != nullptr) {
-    return found_string;
+  found_string = do_lookup(name, len, java_hash);
+  if (found_string == nullptr) {
+    found_string = do_intern(string_or_null_h, name, len, java_hash, CHECK_NULL);
   }
-  return do_intern(string_or_null_h, name, len, hash, THREAD);
+  return add_to_thread_cache(THREAD, java_hash, found_string);
+}
+
+// Critical section for inserts, see _rehash_synchronizer.
+class StringTableInsertSection : public StackObj {
+  uint _enter_value;
+ public:
+  StringTableInsertSection() :
+    _enter_value(ConcurrentStringTableRehash ? _rehash_synchronizer.enter() : 0) {}
+  ~StringTableInsertSection() {
+    if (ConcurrentStringTableRehash) {
+      _rehash_synchronizer.exit(_enter_value);
+    }
+  }
+};
+
+// Returns the String for name in the table, inserting string_h if there is
+// none, or null if the insert needs to be retried.
+oop StringTable::try_insert(JavaThread* thread, Handle string_h, const jchar* name,
+                            int len, unsigned int java_hash) {
+  StringTableInsertSection sis;
+  StringTableHash* table = Atomic::load_acquire(&_local_table);
+  StringTableHash* source = Atomic::load_acquire(&_rehash_source);
+  if (source != nullptr && source != table) {
+    if (Atomic::load_acquire(&_rehash_handover)) {
+      // Inserts into the old table may still be in progress.
+      return nullptr;
+    }
+    // The old table no longer changes, but it may hold an earlier insert.
+    oop found_string = lookup_in(thread, source, name, len, java_hash);
+    if (found_string != nullptr) {
+      return found_string;
+    }
+  }
+
+  StringTableLookupOop lookup(thread, table_hash(table, name, len, java_hash), string_h);
+  StringTableGet stg(thread);
+  bool rehash_warning;
+  // Callers have already looked up the String using the jchar* name, so just go to add.
+  WeakHandle wh(_oop_storage, string_h);
+  // The hash table takes ownership of the WeakHandle, even if it's not inserted.
+  if (table->insert(thread, lookup, wh, &rehash_warning)) {
+    update_needs_rehash(rehash_warning);
+    return wh.resolve();
+  }
+  // In case another thread did a concurrent add, return value already in the table.
+  // This could fail if the String got gc'ed concurrently, so loop back until success.
+  if (table->get(thread, lookup, stg, &rehash_warning)) {
+    update_needs_rehash(rehash_warning);
+    return stg.get_res_oop();
+  }
+  return nullptr;
 }
 
 oop StringTable::do_intern(Handle string_or_null_h, const jchar* name,
-                           int len, uintx hash, TRAPS) {
+                           int len, unsigned int java_hash, TRAPS) {
   HandleMark hm(THREAD);  // cleanup strings created
   Handle string_h;
 
@@ -405,25 +568,15 @@ oop StringTable::do_intern(Handle string_or_null_h, const jchar* name,
     StringDedup::notify_intern(string_h());
   }
 
-  StringTableLookupOop lookup(THREAD, hash, string_h);
-  StringTableGet stg(THREAD);
-
-  bool rehash_warning;
-  do {
-    // Callers have already looked up the String using the jchar* name, so just go to add.
-    WeakHandle wh(_oop_storage, string_h);
-    // The hash table takes ownership of the WeakHandle, even if it's not inserted.
-    if (_local_table->insert(THREAD, lookup, wh, &rehash_warning)) {
-      update_needs_rehash(rehash_warning);
-      return wh.resolve();
+  while (true) {
+    oop result = try_insert(THREAD, string_h, name, len, java_hash);
+    if (result != nullptr) {
+      return result;
     }
-    // In case another thread did a concurrent add, return value already in the table.
-    // This could fail if the String got gc'ed concurrently, so loop back until success.
-    if (_local_table->get(THREAD, lookup, stg, &rehash_warning)) {
-      update_needs_rehash(rehash_warning);
-      return stg.get_res_oop();
+    if (Atomic::load_acquire(&_rehash_handover)) {
+      os::naked_yield();
     }
-  } while(true);
+  }
 }
 
 // Concurrent work
@@ -519,9 +672,9 @@ bool StringTable::should_grow() {
 }
 
 void StringTable::do_concurrent_work(JavaThread* jt) {
-  // Rehash if needed.  Rehashing goes to a safepoint but the rest of this
-  // work is concurrent.
-  if (needs_rehashing() && maybe_rehash_table()) {
+  // Rehash if needed.  Unless ConcurrentStringTableRehash is set, rehashing
+  // goes to a safepoint but the rest of this work is concurrent.
+  if (needs_rehashing() && maybe_rehash_table(jt)) {
     Atomic::release_store(&_has_work, false);
     return; // done, else grow
   }
@@ -548,6 +701,7 @@ void StringTable::rehash_table() {
   StringTableHash* new_table = new StringTableHash(new_size, END_SIZE, REHASH_LEN, true);
   // Use alt hash from now on
   _alt_hash = true;
+  _alt_hash_table = new_table;
   _local_table->rehash_nodes_to(Thread::current(), new_table);
 
   // free old table
@@ -558,7 +712,88 @@ void StringTable::rehash_table() {
   _needs_rehashing = false;
 }
 
-bool StringTable::maybe_rehash_table() {
+// Collects the live Strings of a range of buckets of the old table.
+class StringTableRehashCopy : public StackObj {
+  JavaThread* _thread;
+  GrowableArray<Handle> _strings;
+ public:
+  StringTableRehashCopy(JavaThread* thread) : _thread(thread), _strings(REHASH_CLAIM_SIZE) {}
+  bool operator()(WeakHandle* val) {
+    oop s = val->resolve();
+    if (s != nullptr) {
+      _strings.append(Handle(_thread, s));
+    }
+    return true;
+  }
+  void copy_to(StringTableHash* table) {
+    for (int i = 0; i < _strings.length(); i++) {
+      Handle string_h = _strings.at(i);
+      ResourceMark rm(_thread);
+      int length;
+      jchar* chars = java_lang_String::as_unicode_string_or_null(string_h(), length);
+      if (chars == nullptr) {
+        vm_exit_out_of_memory(length, OOM_MALLOC_ERROR, "rehash string table");
+      }
+      StringTableLookupOop lookup(_thread, hash_string(chars, length, true), string_h);
+      bool rehash_warning;
+      WeakHandle wh(StringTable::_oop_storage, string_h);
+      // Fails only if a newer instance was interned after this one died.
+      table->insert(_thread, lookup, wh, &rehash_warning);
+    }
+    _strings.clear();
+  }
+};
+
+// Called by the ServiceThread with ConcurrentStringTableRehash
+void StringTable::concurrent_rehash_table(JavaThread* jt) {
+  // The ServiceThread initiates the rehashing so it is not resizing.
+  assert(_local_table->is_safepoint_safe(), "Should not be resizing now");
+  log_debug(stringtable)("Started concurrent rehash");
+  ResourceMark rm(jt);
+  TraceTime timer("Rehash", TRACETIME_LOG(Debug, stringtable, perf));
+
+  StringTableHash* old_table = _local_table;
+  // We use current size, not max size.
+  size_t new_size = old_table->get_size_log2(jt);
+  StringTableHash* new_table = new StringTableHash(new_size, END_SIZE, REHASH_LEN, true);
+
+  _alt_hash_seed = AltHashing::compute_seed();
+  _alt_hash = true;
+  Atomic::release_store(&_alt_hash_table, new_table);
+  Atomic::release_store(&_rehash_source, old_table);
+  Atomic::release_store(&_rehash_handover, true);
+  Atomic::release_store(&_local_table, new_table);
+  // After this no thread inserts into the old table any longer.
+  _rehash_synchronizer.synchronize();
+  Atomic::release_store(&_rehash_handover, false);
+
+  // Copy the live entries a range of buckets at a time, letting safepoints
+  // in between. The old table is read only and stays visible to lookups.
+  StringTableHash::ScanTask st(old_table, REHASH_CLAIM_SIZE);
+  StringTableRehashCopy copy(jt);
+  while (true) {
+    HandleMark hm(jt);
+    if (!st.do_task(jt, copy)) {
+      break;
+    }
+    copy.copy_to(new_table);
+    {
+      ThreadBlockInVM tbivm(jt);
+    }
+  }
+
+  // Retire the old table once no lookup or insert can still be using it.
+  Atomic::release_store(&_rehash_source, (StringTableHash*)nullptr);
+  GlobalCounter::write_synchronize();
+  _rehash_synchronizer.synchronize();
+  delete old_table;
+
+  _rehashed = true;
+  _needs_rehashing = false;
+  log_debug(stringtable)("Concurrent rehash done");
+}
+
+bool StringTable::maybe_rehash_table(JavaThread* jt) {
   log_debug(stringtable)("Table imbalanced, rehashing called.");
 
   // Grow instead of rehash.
@@ -574,6 +809,11 @@ bool StringTable::maybe_rehash_table() {
     return false;
   }
 
+  if (ConcurrentStringTableRehash) {
+    concurrent_rehash_table(jt);
+    return true;
+  }
+
   VM_RehashStringTable op;
   VMThread::execute(&op);
   return true;  // return true because we tried.
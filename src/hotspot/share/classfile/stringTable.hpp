@@ -30,6 +30,7 @@
 #include "oops/oop.hpp"
 #include "oops/oopHandle.hpp"
 #include "oops/weakHandle.hpp"
+#include "runtime/handles.hpp"
 #include "utilities/tableStatistics.hpp"
 
 class CompactHashtableWriter;
@@ -42,6 +43,7 @@ class StringTableConfig;
 class StringTable : AllStatic {
   friend class VMStructs;
   friend class StringTableConfig;
+  friend class StringTableRehashCopy;
 
   static volatile bool _has_work;
 
@@ -66,8 +68,9 @@ class StringTable : AllStatic {
   static void item_removed();
 
   static oop intern(Handle string_or_null_h, const jchar* name, int len, TRAPS);
-  static oop do_intern(Handle string_or_null, const jchar* name, int len, uintx hash, TRAPS);
-  static oop do_lookup(const jchar* name, int len, uintx hash);
+  static oop do_intern(Handle string_or_null, const jchar* name, int len, unsigned int java_hash, TRAPS);
+  static oop do_lookup(const jchar* name, int len, unsigned int java_hash);
+  static oop try_insert(JavaThread* thread, Handle string_h, const jchar* name, int len, unsigned int java_hash);
 
   static void print_table_statistics(outputStream* st);
 
@@ -88,11 +91,14 @@ class StringTable : AllStatic {
   static oop intern(Symbol* symbol, TRAPS);
   static oop intern(oop string, TRAPS);
   static oop intern(const char *utf8_string, TRAPS);
+  // Replaces each element of strings with its interned instance.
+  static void intern_all(objArrayHandle strings, TRAPS);
 
   // Rehash the string table if it gets out of balance
 private:
   static bool should_grow();
-  static bool maybe_rehash_table();
+  static bool maybe_rehash_table(JavaThread* jt);
+  static void concurrent_rehash_table(JavaThread* jt);
 public:
   static void rehash_table();
   static bool needs_rehashing() { return _needs_rehashing; }
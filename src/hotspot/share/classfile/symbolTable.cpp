@@ -257,6 +257,13 @@ void SymbolTable::trigger_cleanup() {
   }
 }
 
+void SymbolTable::notify_class_loaders_purged() {
+  // Without this the dead symbols would only be found by lookups that
+  // happen to walk their buckets.
+  mark_has_items_to_clean();
+  check_concurrent_work();
+}
+
 class SymbolsDo : StackObj {
   SymbolClosure *_cl;
 public:
@@ -115,6 +115,9 @@ class SymbolTable : public AllStatic {
   static void do_concurrent_work(JavaThread* jt);
   static bool has_work();
   static void trigger_cleanup();
+  // The symbols only referenced by the classes of purged class loaders are
+  // dead, remove them from the table in one concurrent pass.
+  static void notify_class_loaders_purged();
 
   // Probing
   // Needed for preloading classes in signatures when compiling.
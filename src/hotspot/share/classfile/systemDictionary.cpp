@@ -78,6 +78,7 @@
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/signature.hpp"
 #include "runtime/synchronizer.hpp"
+#include "services/allocationSiteService.hpp"
 #include "services/classLoadingService.hpp"
 #include "services/diagnosticCommand.hpp"
 #include "services/finalizerService.hpp"
@@ -254,6 +255,47 @@ Handle SystemDictionary::get_loader_lock_or_null(Handle class_loader) {
   }
 }
 
+// ----------------------------------------------------------------------------
+// Timing of SystemDictionary_lock waits during class loading
+
+static void post_lock_wait_event(EventClassLoadingLockWait* event,
+                                 Symbol* name,
+                                 ClassLoaderData* loader_data,
+                                 bool parallel_load) {
+  if (event->should_commit()) {
+    event->set_className(name);
+    event->set_classLoader(loader_data);
+    event->set_parallelLoad(parallel_load);
+    event->commit();
+  }
+}
+
+// Locks SystemDictionary_lock like a MutexLocker.  If the lock is
+// contended, the time spent blocked is reported as a ClassLoadingLockWait
+// event for the class being loaded.
+class SystemDictionaryLocker : public StackObj {
+ public:
+  SystemDictionaryLocker(JavaThread* current, Symbol* name, ClassLoaderData* loader_data) {
+    if (!SystemDictionary_lock->try_lock()) {
+      EventClassLoadingLockWait event;
+      SystemDictionary_lock->lock(current);
+      post_lock_wait_event(&event, name, loader_data, false);
+    }
+  }
+
+  ~SystemDictionaryLocker() {
+    SystemDictionary_lock->unlock();
+  }
+};
+
+// Waits on SystemDictionary_lock for another thread loading or defining
+// the class, reporting the time spent waiting.
+static void wait_for_parallel_load(Symbol* name, ClassLoaderData* loader_data) {
+  EventClassLoadingLockWait event;
+  SystemDictionary_lock->wait();
+  post_lock_wait_event(&event, name, loader_data, true);
+}
+
 // ----------------------------------------------------------------------------
 // Resolving of classes
 
@@ -435,7 +477,7 @@ InstanceKlass* SystemDictionary::resolve_super_or_fail(Symbol* class_name,
   // can't throw error holding a lock
   bool throw_circularity_error = false;
   {
-    MutexLocker mu(THREAD, SystemDictionary_lock);
+    SystemDictionaryLocker sdl(THREAD, class_name, loader_data);
     InstanceKlass* klassk = dictionary->find_class(THREAD, class_name);
     InstanceKlass* quicksuperk;
     // To support parallel loading: if class is done loading, just return the superclass
@@ -478,7 +520,7 @@ InstanceKlass* SystemDictionary::resolve_super_or_fail(Symbol* class_name,
 
   // Clean up placeholder entry.
   {
-    MutexLocker mu(THREAD, SystemDictionary_lock);
+    SystemDictionaryLocker sdl(THREAD, class_name, loader_data);
     PlaceholderTable::find_and_remove(class_name, loader_data, PlaceholderTable::LOAD_SUPER, THREAD);
     SystemDictionary_lock->notify_all();
   }
@@ -540,7 +582,7 @@ static InstanceKlass* handle_parallel_loading(JavaThread* current,
 
         // LOAD_INSTANCE placeholders are used to implement parallel capable class loading
         // for the bootclass loader.
-        SystemDictionary_lock->wait();
+        wait_for_parallel_load(name, loader_data);
 
         // Check if classloading completed while we were waiting
         InstanceKlass* check = loader_data->dictionary()->find_class(current, name);
@@ -618,7 +660,7 @@ InstanceKlass* SystemDictionary::resolve_instance_class_or_null(Symbol* name,
 
   // Check again (after locking) if the class already exists in SystemDictionary
   {
-    MutexLocker mu(THREAD, SystemDictionary_lock);
+    SystemDictionaryLocker sdl(THREAD, name, loader_data);
     InstanceKlass* check = dictionary->find_class(THREAD, name);
     if (check != nullptr) {
       // InstanceKlass is already loaded, but we still need to check protection domain below.
@@ -658,8 +700,14 @@ InstanceKlass* SystemDictionary::resolve_instance_class_or_null(Symbol* name,
     //    There should be no need for need for LOAD_INSTANCE for mutual exclusion,
     //    except the LOAD_INSTANCE placeholder is used to detect CCE for -Xcomp.
     //    TODO: should also be used to detect CCE for parallel capable class loaders but it's not.
-    {
-      MutexLocker mu(THREAD, SystemDictionary_lock);
+    //
+    // Parallel capable class loaders don't need a placeholder, and only
+    // recheck the dictionary if a parallel superclass load could have loaded
+    // the class in the meantime.  Otherwise the lookup above, made while
+    // holding the SystemDictionary_lock, is recent enough: the class loader
+    // itself handles classes defined since then.
+    if (needs_load_placeholder(class_loader) || super_load_in_progress) {
+      SystemDictionaryLocker sdl(THREAD, name, loader_data);
       if (needs_load_placeholder(class_loader)) {
         loaded_class = handle_parallel_loading(THREAD,
                                                name,
@@ -706,7 +754,7 @@ InstanceKlass* SystemDictionary::resolve_instance_class_or_null(Symbol* name,
       // clean up placeholder entries for LOAD_INSTANCE success or error
       // This brackets the SystemDictionary updates for both defining
       // and initiating loaders
-      MutexLocker mu(THREAD, SystemDictionary_lock);
+      SystemDictionaryLocker sdl(THREAD, name, loader_data);
       PlaceholderTable::find_and_remove(name, loader_data, PlaceholderTable::LOAD_INSTANCE, THREAD);
       SystemDictionary_lock->notify_all();
     }
@@ -1458,7 +1506,7 @@ InstanceKlass* SystemDictionary::find_or_define_helper(Symbol* class_name, Handl
 
   // Hold SD lock around find_class and placeholder creation for DEFINE_CLASS
   {
-    MutexLocker mu(THREAD, SystemDictionary_lock);
+    SystemDictionaryLocker sdl(THREAD, name_h, loader_data);
     // First check if class already defined
     if (is_parallelDefine(class_loader)) {
       InstanceKlass* check = dictionary->find_class(THREAD, name_h);
@@ -1475,7 +1523,7 @@ InstanceKlass* SystemDictionary::find_or_define_helper(Symbol* class_name, Handl
     // caller is surprised by LinkageError: duplicate, but findLoadedClass fails
     // if other thread has not finished updating dictionary
     while (probe->definer() != nullptr) {
-      SystemDictionary_lock->wait();
+      wait_for_parallel_load(name_h, loader_data);
     }
     // Only special cases allow parallel defines and can use other thread's results
     // Other cases fall through, and may run into duplicate defines
@@ -1499,7 +1547,7 @@ InstanceKlass* SystemDictionary::find_or_define_helper(Symbol* class_name, Handl
 
   // definer must notify any waiting threads
   {
-    MutexLocker mu(THREAD, SystemDictionary_lock);
+    SystemDictionaryLocker sdl(THREAD, name_h, loader_data);
     PlaceholderEntry* probe = PlaceholderTable::get_entry(name_h, loader_data);
     assert(probe != nullptr, "DEFINE_CLASS placeholder lost?");
     if (!HAS_PENDING_EXCEPTION) {
@@ -1550,6 +1598,7 @@ bool SystemDictionary::do_unloading(GCTimer* gc_timer) {
       ConditionalMutexLocker ml2(Module_lock, is_concurrent);
       JFR_ONLY(Jfr::on_unloading_classes();)
       MANAGEMENT_ONLY(FinalizerService::purge_unloaded();)
+      AllocationSiteService::purge_unloaded();
       ConditionalMutexLocker ml1(SystemDictionary_lock, is_concurrent);
       ClassLoaderDataGraph::clean_module_and_package_info();
       LoaderConstraintTable::purge_loader_constraints();
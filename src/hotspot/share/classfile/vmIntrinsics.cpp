@@ -550,6 +550,8 @@ bool vmIntrinsics::disabled_by_jvm_flags(vmIntrinsics::ID id) {
   case vmIntrinsics::_encodeISOArray:
   case vmIntrinsics::_encodeAsciiArray:
   case vmIntrinsics::_encodeByteISOArray:
+  case vmIntrinsics::_encodeByteISOArrayToAddress:
+  case vmIntrinsics::_encodeAsciiArrayToAddress:
     if (!SpecialEncodeISOArray) return true;
     break;
   case vmIntrinsics::_getCallerClass:
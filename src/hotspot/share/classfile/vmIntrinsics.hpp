@@ -432,6 +432,12 @@ class methodHandle;
   do_intrinsic(_encodeAsciiArray,       java_lang_StringCoding, encodeAsciiArray_name, encodeISOArray_signature, F_S)   \
    do_name(     encodeAsciiArray_name,                           "implEncodeAsciiArray")                                \
                                                                                                                         \
+  do_intrinsic(_encodeByteISOArrayToAddress, java_lang_StringCoding, encodeISOArrayToAddress_name, encodeToAddress_signature, F_S) \
+   do_name(     encodeISOArrayToAddress_name,                    "implEncodeISOArrayToAddress")                         \
+   do_signature(encodeToAddress_signature,                       "([BIJI)I")                                            \
+  do_intrinsic(_encodeAsciiArrayToAddress, java_lang_StringCoding, encodeAsciiArrayToAddress_name, encodeToAddress_signature, F_S) \
+   do_name(     encodeAsciiArrayToAddress_name,                  "implEncodeAsciiArrayToAddress")                       \
+                                                                                                                        \
   do_class(java_math_BigInteger,                      "java/math/BigInteger")                                           \
   do_intrinsic(_multiplyToLen,      java_math_BigInteger, multiplyToLen_name, multiplyToLen_signature, F_S)             \
    do_name(     multiplyToLen_name,                             "implMultiplyToLen")                                    \
@@ -46,7 +46,9 @@ enum class CodeBlobType {
   MethodProfiled      = 1,    // Execution level 2 and 3 (profiled) nmethods
   NonNMethod          = 2,    // Non-nmethods like Buffers, Adapters and Runtime Stubs
   All                 = 3,    // All types (No code cache segmentation)
-  NumTypes            = 4     // Number of CodeBlobTypes
+  MethodHot           = 4,    // Hot non-profiled nmethods, see HotCodeHeapSize. Comes after All
+                              // to keep the values of the other types.
+  NumTypes            = 5     // Number of CodeBlobTypes
 };
 
 // CodeBlob - superclass for all entries in the CodeCache.
@@ -201,6 +201,7 @@ void CodeCache::initialize_heaps() {
   CodeHeapInfo non_nmethod = {NonNMethodCodeHeapSize, FLAG_IS_CMDLINE(NonNMethodCodeHeapSize), true};
   CodeHeapInfo profiled = {ProfiledCodeHeapSize, FLAG_IS_CMDLINE(ProfiledCodeHeapSize), true};
   CodeHeapInfo non_profiled = {NonProfiledCodeHeapSize, FLAG_IS_CMDLINE(NonProfiledCodeHeapSize), true};
+  CodeHeapInfo hot = {0, false, heap_available(CodeBlobType::MethodHot)};
 
   const bool cache_size_set   = FLAG_IS_CMDLINE(ReservedCodeCacheSize);
   const size_t ps             = page_size(false, 8);
@@ -313,17 +314,41 @@ void CodeCache::initialize_heaps() {
   profiled.size = align_down(profiled.size, min_size);
   non_profiled.size = align_down(non_profiled.size, min_size);
 
+  // The hot code heap is taken out of the non-profiled code heap. It is
+  // aligned to the large page size, so it can be backed by large pages
+  // even if the rest of the code cache is not.
+  const size_t hot_alignment = MAX2(min_size, os::large_page_size());
+  if (hot.enabled) {
+    hot.size = align_up((size_t)HotCodeHeapSize, hot_alignment);
+    if (non_profiled.size < hot.size + min_size) {
+      log_warning(codecache)("HotCodeHeapSize (" SIZE_FORMAT "K) leaves too little space for the non-profiled code heap (" SIZE_FORMAT "K), "
+                             "not using a hot code heap", hot.size/K, non_profiled.size/K);
+      hot.size = 0;
+      hot.enabled = false;
+    } else {
+      non_profiled.size -= hot.size;
+    }
+  }
+
   FLAG_SET_ERGO(NonNMethodCodeHeapSize, non_nmethod.size);
   FLAG_SET_ERGO(ProfiledCodeHeapSize, profiled.size);
   FLAG_SET_ERGO(NonProfiledCodeHeapSize, non_profiled.size);
+  FLAG_SET_ERGO(HotCodeHeapSize, hot.size);
   FLAG_SET_ERGO(ReservedCodeCacheSize, cache_size);
 
-  ReservedCodeSpace rs = reserve_heap_memory(cache_size, ps);
+  // The hot code heap comes first, so aligning the whole reservation aligns it.
+  ReservedCodeSpace rs = reserve_heap_memory(cache_size, ps, hot.enabled ? hot_alignment : 0);
 
   // Register CodeHeaps with LSan as we sometimes embed pointers to malloc memory.
   LSAN_REGISTER_ROOT_REGION(rs.base(), rs.size());
 
   size_t offset = 0;
+  if (hot.enabled) {
+    ReservedSpace hot_space = rs.partition(offset, hot.size);
+    offset += hot.size;
+    // Tier 4 methods with high invocation counts
+    add_heap(hot_space, "CodeHeap 'hot nmethods'", CodeBlobType::MethodHot);
+  }
   if (profiled.enabled) {
     ReservedSpace profiled_space = rs.partition(offset, profiled.size);
     offset += profiled.size;
@@ -341,6 +366,7 @@ void CodeCache::initialize_heaps() {
     // Tier 1 and tier 4 (non-profiled) methods and native methods
     add_heap(non_profiled_space, "CodeHeap 'non-profiled nmethods'", CodeBlobType::MethodNonProfiled);
   }
+
 }
 
 size_t CodeCache::page_size(bool aligned, size_t min_pages) {
@@ -348,9 +374,9 @@ size_t CodeCache::page_size(bool aligned, size_t min_pages) {
                    os::page_size_for_region_unaligned(ReservedCodeCacheSize, min_pages);
 }
 
-ReservedCodeSpace CodeCache::reserve_heap_memory(size_t size, size_t rs_ps) {
+ReservedCodeSpace CodeCache::reserve_heap_memory(size_t size, size_t rs_ps, size_t min_alignment) {
   // Align and reserve space for code cache
-  const size_t rs_align = MAX2(rs_ps, os::vm_allocation_granularity());
+  const size_t rs_align = MAX3(rs_ps, os::vm_allocation_granularity(), min_alignment);
   const size_t rs_size = align_up(size, rs_align);
   ReservedCodeSpace rs(rs_size, rs_align, rs_ps);
   if (!rs.is_reserved()) {
@@ -366,7 +392,11 @@ ReservedCodeSpace CodeCache::reserve_heap_memory(size_t size, size_t rs_ps) {
 
 // Heaps available for allocation
 bool CodeCache::heap_available(CodeBlobType code_blob_type) {
-  if (!SegmentedCodeCache) {
+  if (code_blob_type == CodeBlobType::MethodHot) {
+    // Only used next to a non-profiled code heap, and only if sized
+    return SegmentedCodeCache && HotCodeHeapSize > 0 &&
+           !CompilerConfig::is_interpreter_only() && CompilerConfig::is_c2_or_jvmci_compiler_enabled();
+  } else if (!SegmentedCodeCache) {
     // No segmentation: use a single code heap
     return (code_blob_type == CodeBlobType::All);
   } else if (CompilerConfig::is_interpreter_only()) {
@@ -382,6 +412,17 @@ bool CodeCache::heap_available(CodeBlobType code_blob_type) {
   }
 }
 
+bool CodeCache::is_hot_method(const Method* method, int comp_level) {
+  if (comp_level != CompLevel_full_optimization || !heap_available(CodeBlobType::MethodHot)) {
+    return false;
+  }
+  // The counters are those at the time the compilation is installed, so
+  // recompilations of methods running for a long time are the most likely
+  // to be placed in the hot code heap.
+  int64_t count = (int64_t)method->invocation_count() + (int64_t)method->backedge_count();
+  return count >= (int64_t)HotCodeHeapThreshold;
+}
+
 const char* CodeCache::get_code_heap_flag_name(CodeBlobType code_blob_type) {
   switch(code_blob_type) {
   case CodeBlobType::NonNMethod:
@@ -393,6 +434,9 @@ const char* CodeCache::get_code_heap_flag_name(CodeBlobType code_blob_type) {
   case CodeBlobType::MethodProfiled:
     return "ProfiledCodeHeapSize";
     break;
+  case CodeBlobType::MethodHot:
+    return "HotCodeHeapSize";
+    break;
   default:
     ShouldNotReachHere();
     return nullptr;
@@ -433,11 +477,21 @@ void CodeCache::add_heap(ReservedSpace rs, const char* name, CodeBlobType code_b
 
   // Reserve Space
   size_t size_initial = MIN2((size_t)InitialCodeCacheSize, rs.size());
+  if (code_blob_type == CodeBlobType::MethodHot) {
+    // Commit the hot code heap up front, so it can be backed by large
+    // pages as a whole.
+    size_initial = rs.size();
+  }
   size_initial = align_up(size_initial, os::vm_page_size());
   if (!heap->reserve(rs, size_initial, CodeCacheSegmentSize)) {
     vm_exit_during_initialization(err_msg("Could not reserve enough space in %s (" SIZE_FORMAT "K)",
                                           heap->name(), size_initial/K));
   }
+  if (code_blob_type == CodeBlobType::MethodHot && rs.page_size() < os::large_page_size()) {
+    // Ask for transparent huge pages, if the code cache itself is not
+    // backed by large pages.
+    os::realign_memory(rs.base(), rs.size(), os::large_page_size());
+  }
 
   // Register the CodeHeap
   MemoryService::add_code_heap_memory_pool(heap, name);
@@ -572,6 +626,18 @@ CodeBlob* CodeCache::allocate(uint size, CodeBlobType code_blob_type, bool handl
   return cb;
 }
 
+CodeBlob* CodeCache::allocate_below(uint size, CodeBlobType code_blob_type, const void* limit) {
+  assert_locked_or_safepoint(CodeCache_lock);
+  assert(size > 0, "Code cache allocation request must be > 0");
+  CodeHeap* heap = get_code_heap(code_blob_type);
+  assert(heap != nullptr, "heap is null");
+  CodeBlob* cb = (CodeBlob*)heap->allocate_below(size, limit);
+  if (cb != nullptr) {
+    print_trace("allocation", cb, size);
+  }
+  return cb;
+}
+
 void CodeCache::free(CodeBlob* cb) {
   assert_locked_or_safepoint(CodeCache_lock);
   CodeHeap* heap = get_code_heap(cb);
@@ -935,6 +1001,74 @@ void CodeCache::maybe_restart_compiler(size_t freed_memory) {
   }
 }
 
+int CodeCache::compact(CodeBlobType code_blob_type) {
+  assert(NMethodRelocation, "must be enabled");
+  JavaThread* thread = JavaThread::current();
+  CodeHeap* heap = get_code_heap(code_blob_type);
+  // Relocate a few nmethods at a time, so safepoints are not held
+  // off for long. Between the batches the old copies may be freed.
+  const int batch_size = 64;
+  const void* limit = heap->high();
+  int relocated = 0;
+  bool done = false;
+  while (!done) {
+    ResourceMark rm(thread);
+    GrowableArray<nmethod*> candidates;
+    GrowableArray<nmethod*> copies;
+    {
+      MutexLocker ml_Compile_lock(thread, Compile_lock);
+      // No safepoint may free the candidates while they are moved.
+      NoSafepointVerifier nsv;
+      {
+        MutexLocker ml_CodeCache_lock(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+        FOR_ALL_BLOBS(cb, heap) {
+          if (cb >= limit) {
+            break;
+          }
+          nmethod* nm = cb->as_nmethod_or_null();
+          if (nm != nullptr && nm->is_relocatable()) {
+            candidates.append(nm);
+          }
+        }
+      }
+      if (candidates.is_empty()) {
+        break;
+      }
+      // Move the highest candidates down, highest first.
+      int first = MAX2(0, candidates.length() - batch_size);
+      for (int i = candidates.length() - 1; i >= first; i--) {
+        nmethod* nm = candidates.at(i);
+        CompiledICLocker ic_locker(nm);
+        MutexLocker ml_CodeCache_lock(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+        nmethod* nm_copy = nm->relocate(code_blob_type, nm);
+        if (nm_copy != nullptr) {
+          copies.append(nm_copy);
+        }
+      }
+      limit = candidates.at(first);
+      done = first == 0;
+    }
+    // JVMTI -- compiled method notification (must be done outside lock)
+    for (nmethod* nm_copy : copies) {
+      nm_copy->post_compiled_method_load_event();
+    }
+    relocated += copies.length();
+  }
+  return relocated;
+}
+
+void CodeCache::compact_all(outputStream* st) {
+  if (!NMethodRelocation) {
+    st->print_cr("nmethod relocation is disabled, use -XX:+UnlockDiagnosticVMOptions -XX:+NMethodRelocation");
+    return;
+  }
+  for (CodeHeap* heap : *_nmethod_heaps) {
+    int relocated = compact(heap->code_blob_type());
+    st->print_cr("%s: relocated %d nmethods", heap->name(), relocated);
+  }
+  st->print_cr("The old nmethods are freed once they are no longer on any stack.");
+}
+
 uint8_t CodeCache::_unloading_cycle = 1;
 
 void CodeCache::increment_unloading_cycle() {
@@ -28,6 +28,7 @@
 #include "compiler/compileBroker.hpp"
 #include "oops/klass.inline.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
 #include "runtime/safepoint.hpp"
 #include "utilities/powerOfTwo.hpp"
 
@@ -298,6 +299,18 @@ unsigned int CodeHeapState::findHeapIndex(outputStream* out, const char* heapNam
   }
 }
 
+// Counts the pages of page_size that [start, start + len) touches beyond
+// those counted for previous blocks. Blocks must be visited in address order.
+static size_t count_touched_pages(const char* start, size_t len, size_t page_size, uintptr_t* next_page) {
+  uintptr_t first = MAX2((uintptr_t)start / page_size, *next_page);
+  uintptr_t last  = ((uintptr_t)start + len - 1) / page_size;
+  if (last < first) {
+    return 0;
+  }
+  *next_page = last + 1;
+  return last - first + 1;
+}
+
 void CodeHeapState::get_HeapStatGlobals(outputStream* out, const char* heapName) {
   unsigned int ix = findHeapIndex(out, heapName);
   if (ix < maxHeaps) {
@@ -674,6 +687,14 @@ void CodeHeapState::aggregate(outputStream* out, CodeHeap* heap, size_t granular
 
     unsigned int n_methods              = 0;
 
+    // Pages touched by active nmethods, as a measure of iTLB locality.
+    const size_t small_page_size        = os::vm_page_size();
+    const size_t large_page_size        = os::large_page_size() > small_page_size ? os::large_page_size() : 2*M;
+    size_t       small_pages_touched    = 0;
+    size_t       large_pages_touched    = 0;
+    uintptr_t    next_small_page        = 0;
+    uintptr_t    next_large_page        = 0;
+
     for (HeapBlock *h = heap->first_block(); h != nullptr && !insane; h = heap->next_block(h)) {
       unsigned int hb_len     = (unsigned int)h->length();  // despite being size_t, length can never overflow an unsigned int.
       size_t       hb_bytelen = ((size_t)hb_len)<<log2_seg_size;
@@ -752,6 +773,8 @@ void CodeHeapState::aggregate(outputStream* out, CodeHeap* heap, size_t granular
               case nMethod_inuse: { // only for executable methods!!!
                 // space for these cbs is accounted for later.
                 n_methods++;
+                small_pages_touched += count_touched_pages((char*)h, hb_bytelen, small_page_size, &next_small_page);
+                large_pages_touched += count_touched_pages((char*)h, hb_bytelen, large_page_size, &next_large_page);
                 break;
               }
               case nMethod_notused:
@@ -1043,6 +1066,13 @@ void CodeHeapState::aggregate(outputStream* out, CodeHeap* heap, size_t granular
       ast->print_cr("  stubSpace      = " SIZE_FORMAT_W(8) "k, nBlocks_stub     = %6d, %10.3f%% of capacity, %10.3f%% of max_capacity", stubSpace/(size_t)K,     nBlocks_stub,     (100.0*stubSpace)/size,     (100.0*stubSpace)/res_size);
       ast->print_cr("ZombieBlocks     = %8d. These are HeapBlocks which could not be identified as CodeBlobs.", nBlocks_zomb);
       ast->cr();
+      // The fewer pages the active code is spread over, the fewer iTLB entries it needs.
+      const size_t activeSpace = t1Space + t2Space;
+      ast->print_cr("iTLB locality: active nmethods touch " SIZE_FORMAT " pages of " SIZE_FORMAT "K (" SIZE_FORMAT " if packed)"
+                    " and " SIZE_FORMAT " pages of " SIZE_FORMAT "K (" SIZE_FORMAT " if packed)",
+                    small_pages_touched, small_page_size/K, align_up(activeSpace, small_page_size)/small_page_size,
+                    large_pages_touched, large_page_size/K, align_up(activeSpace, large_page_size)/large_page_size);
+      ast->cr();
       ast->print_cr("Segment start          = " INTPTR_FORMAT ", used space      = " SIZE_FORMAT_W(8)"k", p2i(low_bound), size/K);
       ast->print_cr("Segment end (used)     = " INTPTR_FORMAT ", remaining space = " SIZE_FORMAT_W(8)"k", p2i(low_bound) + size, (res_size - size)/K);
       ast->print_cr("Segment end (reserved) = " INTPTR_FORMAT ", reserved space  = " SIZE_FORMAT_W(8)"k", p2i(low_bound) + res_size, res_size/K);
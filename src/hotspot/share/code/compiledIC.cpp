@@ -72,8 +72,15 @@ CompiledICData::CompiledICData()
     _speculated_klass(),
     _itable_defc_klass(),
     _itable_refc_klass(),
+    _type_cache(),
     _is_initialized() {}
 
+CompiledICData::~CompiledICData() {
+  if (_type_cache != nullptr) {
+    FREE_C_HEAP_ARRAY(CompiledICTypeCacheEntry, _type_cache);
+  }
+}
+
 // Inline cache callsite info is initialized once the first time it is resolved
 void CompiledICData::initialize(CallInfo* call_info, Klass* receiver_klass) {
   _speculated_method = call_info->selected_method();
@@ -93,8 +100,64 @@ bool CompiledICData::is_speculated_klass_unloaded() const {
   return is_initialized() && _speculated_klass == 0;
 }
 
+bool CompiledICData::use_type_cache() {
+  return AMD64_ONLY(InterfaceCallTypeCacheSize > 0) NOT_AMD64(false);
+}
+
+// Called with the CompiledICLocker held, so entries are only added by one
+// thread at a time. The itable stubs read the cache concurrently: an entry
+// is published by storing its klass after its method, and the cache array
+// once all of its entries are cleared.
+void CompiledICData::add_type_cache_entry(Klass* receiver_klass, Method* method) {
+  assert(use_type_cache(), "must be");
+  CompiledICTypeCacheEntry* cache = _type_cache;
+  if (cache == nullptr) {
+    cache = NEW_C_HEAP_ARRAY(CompiledICTypeCacheEntry, InterfaceCallTypeCacheSize, mtCode);
+    for (uint i = 0; i < InterfaceCallTypeCacheSize; i++) {
+      cache[i]._klass = nullptr;
+      cache[i]._method = nullptr;
+    }
+    Atomic::release_store(&_type_cache, cache);
+  }
+  for (uint i = 0; i < InterfaceCallTypeCacheSize; i++) {
+    Klass* const klass = cache[i]._klass;
+    if (klass == receiver_klass) {
+      return;
+    }
+    if (klass == nullptr) {
+      log_trace(inlinecache)("ICData@" INTPTR_FORMAT ": type cache entry %u %s -> %s", p2i(this), i,
+                             receiver_klass->external_name(), method->print_value_string());
+      Atomic::store(&cache[i]._method, method);
+      Atomic::release_store(&cache[i]._klass, receiver_klass);
+      return;
+    }
+  }
+  // The cache is full, other receivers are dispatched by scanning the itable.
+}
+
+void CompiledICData::clean_type_cache() {
+  CompiledICTypeCacheEntry* const cache = _type_cache;
+  if (cache == nullptr) {
+    return;
+  }
+  // An unloaded entry is not cleared since the itable stubs stop at the first
+  // empty entry, instead it is marked so that it never matches again.
+  for (uint i = 0; i < InterfaceCallTypeCacheSize; i++) {
+    Klass* const klass = cache[i]._klass;
+    if (klass != nullptr && klass != unloaded_klass() && !klass->is_loader_alive()) {
+      Atomic::store(&cache[i]._klass, unloaded_klass());
+    }
+  }
+}
+
 void CompiledICData::clean_metadata() {
-  if (!is_initialized() || is_speculated_klass_unloaded()) {
+  if (!is_initialized()) {
+    return;
+  }
+
+  clean_type_cache();
+
+  if (is_speculated_klass_unloaded()) {
     return;
   }
 
@@ -127,6 +190,16 @@ void CompiledICData::metadata_do(MetadataClosure* cl) {
   if (_itable_defc_klass != nullptr) {
     cl->do_metadata(_itable_defc_klass);
   }
+  CompiledICTypeCacheEntry* const cache = _type_cache;
+  if (cache != nullptr) {
+    for (uint i = 0; i < InterfaceCallTypeCacheSize; i++) {
+      Klass* const klass = cache[i]._klass;
+      if (klass != nullptr && klass != unloaded_klass()) {
+        cl->do_metadata(klass);
+        cl->do_metadata(cache[i]._method);
+      }
+    }
+  }
 }
 
 Klass* CompiledICData::speculated_klass() const {
@@ -222,7 +295,7 @@ void CompiledIC::set_to_monomorphic() {
   _call->set_destination_mt_safe(entry);
 }
 
-void CompiledIC::set_to_megamorphic(CallInfo* call_info) {
+void CompiledIC::set_to_megamorphic(CallInfo* call_info, Klass* receiver_klass) {
   assert(data()->is_initialized(), "must be initialized");
 
   address entry;
@@ -243,6 +316,15 @@ void CompiledIC::set_to_megamorphic(CallInfo* call_info) {
     InstanceKlass* k = call_info->resolved_method()->method_holder();
     assert(k->verify_itable_index(itable_index), "sanity check");
 #endif //ASSERT
+    if (CompiledICData::use_type_cache()) {
+      // Seed the type cache with the receivers seen so far before the stub
+      // can observe it.
+      Klass* const speculated_klass = data()->speculated_klass();
+      if (speculated_klass != nullptr && data()->speculated_method() != nullptr) {
+        data()->add_type_cache_entry(speculated_klass, data()->speculated_method());
+      }
+      data()->add_type_cache_entry(receiver_klass, call_info->selected_method());
+    }
   } else {
     assert(call_info->call_kind() == CallInfo::vtable_call, "what else?");
     // Can be different than selected_method->vtable_index(), due to package-private etc.
@@ -266,7 +348,11 @@ void CompiledIC::update(CallInfo* call_info, Klass* receiver_klass) {
   ensure_initialized(call_info, receiver_klass);
 
   if (is_megamorphic()) {
-    // Terminal state for the inline cache
+    // Terminal state for the inline cache. The itable stub missed in the
+    // type cache if the call got here, so the receiver is added to it.
+    if (CompiledICData::use_type_cache() && call_info->call_kind() == CallInfo::itable_call) {
+      data()->add_type_cache_entry(receiver_klass, call_info->selected_method());
+    }
     return;
   }
 
@@ -277,7 +363,7 @@ void CompiledIC::update(CallInfo* call_info, Klass* receiver_klass) {
   } else {
     // If the dynamic type speculation fails, we try to transform to a megamorphic state
     // for the inline cache using stubs to dispatch in tables
-    set_to_megamorphic(call_info);
+    set_to_megamorphic(call_info, receiver_klass);
   }
 }
 
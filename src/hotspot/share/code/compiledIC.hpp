@@ -55,10 +55,25 @@ class CompiledICLocker: public StackObj {
   static bool is_safe(address code);
 };
 
+// A receiver klass of a megamorphic interface call site and the method
+// that is selected for it.
+class CompiledICTypeCacheEntry {
+  friend class CompiledICData;
+
+  Klass*  volatile _klass;
+  Method* volatile _method;
+
+ public:
+  static ByteSize klass_offset()  { return byte_offset_of(CompiledICTypeCacheEntry, _klass); }
+  static ByteSize method_offset() { return byte_offset_of(CompiledICTypeCacheEntry, _method); }
+};
+
 // A CompiledICData is a helper object for the inline cache implementation.
 // It comprises:
 // (1) The first receiver klass and its selected method
 // (2) Itable call metadata
+// (3) Optionally, the receiver klasses and selected methods seen after an
+//     interface call site went megamorphic, see InterfaceCallTypeCacheSize
 
 class CompiledICData : public CHeapObj<mtCode> {
   friend class VMStructs;
@@ -68,13 +83,19 @@ class CompiledICData : public CHeapObj<mtCode> {
   uintptr_t volatile _speculated_klass;
   Klass*             _itable_defc_klass;
   Klass*             _itable_refc_klass;
+  CompiledICTypeCacheEntry* volatile _type_cache;
   bool               _is_initialized;
 
   bool is_speculated_klass_unloaded() const;
+  void clean_type_cache();
+
+  // Marks an entry whose klass was unloaded, never matches a receiver klass
+  static Klass* unloaded_klass() { return (Klass*)badAddressVal; }
 
  public:
   // Constructor
   CompiledICData();
+  ~CompiledICData();
 
   // accessors
   Klass*    speculated_klass()  const;
@@ -87,11 +108,16 @@ class CompiledICData : public CHeapObj<mtCode> {
 
   static ByteSize itable_defc_klass_offset() { return byte_offset_of(CompiledICData, _itable_defc_klass); }
   static ByteSize itable_refc_klass_offset() { return byte_offset_of(CompiledICData, _itable_refc_klass); }
+  static ByteSize type_cache_offset()        { return byte_offset_of(CompiledICData, _type_cache); }
 
   void initialize(CallInfo* call_info, Klass* receiver_klass);
 
   bool is_initialized()       const { return _is_initialized; }
 
+  // Type cache of megamorphic interface call sites, checked by the itable stubs
+  static bool use_type_cache();
+  void add_type_cache_entry(Klass* receiver_klass, Method* method);
+
   // GC Support
   void clean_metadata();
   void metadata_do(MetadataClosure* cl);
@@ -111,7 +137,7 @@ class CompiledIC: public ResourceObj {
 
   // Inline cache states
   void set_to_monomorphic();
-  void set_to_megamorphic(CallInfo* call_info);
+  void set_to_megamorphic(CallInfo* call_info, Klass* receiver_klass);
 
 public:
   // conversion (machine PC to CompiledIC*)
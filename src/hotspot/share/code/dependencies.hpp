@@ -684,6 +684,10 @@ class DepChange : public StackObj {
   virtual bool is_klass_init_change() const { return false; }
   virtual bool is_call_site_change()  const { return false; }
 
+  // Mask of the dependency types this change can invalidate. Must agree
+  // with DepStream::spot_check_dependency_at.
+  virtual int affected_dependency_types() const { return Dependencies::all_types; }
+
   // Subclass casting with assertions.
   KlassDepChange*    as_klass_change() {
     assert(is_klass_change(), "bad cast");
@@ -794,6 +798,7 @@ class NewKlassDepChange : public KlassDepChange {
 
   // What kind of DepChange is this?
   virtual bool is_new_klass_change() const { return true; }
+  virtual int affected_dependency_types() const { return Dependencies::klass_types; }
 
   InstanceKlass* new_type() { return type(); }
 };
@@ -805,6 +810,8 @@ class KlassInitDepChange : public KlassDepChange {
 
   // What kind of DepChange is this?
   virtual bool is_klass_init_change() const { return true; }
+  // See DepStream::check_klass_init_dependency.
+  virtual int affected_dependency_types() const { return 1 << Dependencies::unique_concrete_method_4; }
 };
 
 // A CallSite has changed its target.
@@ -818,6 +825,7 @@ class CallSiteDepChange : public DepChange {
 
   // What kind of DepChange is this?
   virtual bool is_call_site_change() const { return true; }
+  virtual int affected_dependency_types() const { return Dependencies::non_klass_types; }
 
   oop call_site()     const { return _call_site();     }
   oop method_handle() const { return _method_handle(); }
@@ -68,11 +68,13 @@ void DependencyContext::init() {
 // deoptimization.
 //
 void DependencyContext::mark_dependent_nmethods(DeoptimizationScope* deopt_scope, DepChange& changes) {
+  int affected_dep_types = changes.affected_dependency_types();
   for (nmethodBucket* b = dependencies_not_unloading(); b != nullptr; b = b->next_not_unloading()) {
     nmethod* nm = b->get_nmethod();
+    int dep_type = Dependencies::end_marker;
     if (nm->is_marked_for_deoptimization()) {
       deopt_scope->dependent(nm);
-    } else if (nm->check_dependency_on(changes)) {
+    } else if ((b->dep_types() & affected_dep_types) != 0 && nm->check_dependency_on(changes, &dep_type)) {
       LogTarget(Info, dependencies) lt;
       if (lt.is_enabled()) {
         ResourceMark rm;
@@ -82,22 +84,24 @@ void DependencyContext::mark_dependent_nmethods(DeoptimizationScope* deopt_scope
         nm->print_on(&ls);
         nm->print_dependencies_on(&ls);
       }
-      deopt_scope->mark(nm, !changes.is_call_site_change());
+      deopt_scope->mark(nm, changes, dep_type);
     }
   }
 }
 
 //
-// Add an nmethod to the dependency context.
+// Add an nmethod with a dependency of the given type to the dependency context.
 //
-void DependencyContext::add_dependent_nmethod(nmethod* nm) {
+void DependencyContext::add_dependent_nmethod(nmethod* nm, int dep_type) {
   assert_lock_strong(CodeCache_lock);
+  assert(dep_type >= Dependencies::FIRST_TYPE && dep_type < Dependencies::TYPE_LIMIT, "bad dependency type");
   for (nmethodBucket* b = dependencies_not_unloading(); b != nullptr; b = b->next_not_unloading()) {
     if (nm == b->get_nmethod()) {
+      b->add_dep_types(1 << dep_type);
       return;
     }
   }
-  nmethodBucket* new_head = new nmethodBucket(nm, nullptr);
+  nmethodBucket* new_head = new nmethodBucket(nm, nullptr, 1 << dep_type);
   for (;;) {
     nmethodBucket* head = Atomic::load(_dependency_context_addr);
     new_head->set_next(head);
@@ -47,10 +47,13 @@ class nmethodBucket: public CHeapObj<mtClass> {
   nmethod*       _nmethod;
   nmethodBucket* volatile _next;
   nmethodBucket* volatile _purge_list_next;
+  // Mask of the types of the nmethod's dependencies in this context,
+  // which allows skipping the nmethod for changes that can't affect them.
+  int            _dep_types;
 
  public:
-  nmethodBucket(nmethod* nmethod, nmethodBucket* next) :
-    _nmethod(nmethod), _next(next), _purge_list_next(nullptr) {}
+  nmethodBucket(nmethod* nmethod, nmethodBucket* next, int dep_types) :
+    _nmethod(nmethod), _next(next), _purge_list_next(nullptr), _dep_types(dep_types) {}
 
   nmethodBucket* next();
   nmethodBucket* next_not_unloading();
@@ -58,6 +61,8 @@ class nmethodBucket: public CHeapObj<mtClass> {
   nmethodBucket* purge_list_next();
   void set_purge_list_next(nmethodBucket* b);
   nmethod* get_nmethod()                     { return _nmethod; }
+  int dep_types() const                      { return _dep_types; }
+  void add_dep_types(int dep_types)          { _dep_types |= dep_types; }
 };
 
 //
@@ -112,7 +117,7 @@ class DependencyContext : public StackObj {
   static void init();
 
   void mark_dependent_nmethods(DeoptimizationScope* deopt_scope, DepChange& changes);
-  void add_dependent_nmethod(nmethod* nm);
+  void add_dependent_nmethod(nmethod* nm, int dep_type);
   void remove_all_dependents();
   void remove_and_mark_for_deoptimization_all_dependents(DeoptimizationScope* deopt_scope);
   void clean_unloading_dependents();
@@ -66,6 +66,7 @@
 #include "runtime/flags/flagSetting.hpp"
 #include "runtime/frame.inline.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/icache.hpp"
 #include "runtime/jniHandles.inline.hpp"
 #include "runtime/orderAccess.hpp"
 #include "runtime/os.hpp"
@@ -766,7 +767,8 @@ Method* nmethod::attached_method_before_pc(address pc) {
 }
 
 void nmethod::clear_inline_caches() {
-  assert(SafepointSynchronize::is_at_safepoint(), "clearing of IC's only allowed at safepoint");
+  assert(SafepointSynchronize::is_at_safepoint() || is_not_installed(),
+         "clearing of IC's only allowed at safepoint or before installation");
   RelocIterator iter(this);
   while (iter.next()) {
     iter.reloc()->clear_inline_cache();
@@ -1119,6 +1121,31 @@ nmethod* nmethod::new_native_nmethod(const methodHandle& method,
   return nm;
 }
 
+// To make dependency checking during class loading fast, record
+// the nmethod dependencies in the classes it is dependent on.
+// This allows the dependency checking code to simply walk the
+// class hierarchy above the loaded class, checking only nmethods
+// which are dependent on those classes.  The slow way is to
+// check every nmethod for dependencies which makes it linear in
+// the number of methods compiled.  For applications with a lot
+// classes the slow way is too slow.
+static void record_dependencies(nmethod* nm) {
+  for (Dependencies::DepStream deps(nm); deps.next(); ) {
+    if (deps.type() == Dependencies::call_site_target_value) {
+      // CallSite dependencies are managed on per-CallSite instance basis.
+      oop call_site = deps.argument_oop(0);
+      MethodHandles::add_dependent_nmethod(call_site, nm);
+    } else {
+      InstanceKlass* ik = deps.context_type();
+      if (ik == nullptr) {
+        continue;  // ignore things like evol_method
+      }
+      // record this nmethod as dependent on this klass
+      ik->add_dependent_nmethod(nm, deps.type());
+    }
+  }
+}
+
 nmethod* nmethod::new_nmethod(const methodHandle& method,
   int compile_id,
   int entry_bci,
@@ -1172,7 +1199,7 @@ nmethod* nmethod::new_nmethod(const methodHandle& method,
   {
     MutexLocker mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
 
-    nm = new (nmethod_size, comp_level)
+    nm = new (nmethod_size, comp_level, CodeCache::is_hot_method(method(), comp_level))
     nmethod(method(), compiler->type(), nmethod_size, immutable_data_size,
             compile_id, entry_bci, immutable_data, offsets, orig_pc_offset,
             debug_info, dependencies, code_buffer, frame_size, oop_maps,
@@ -1185,28 +1212,7 @@ nmethod* nmethod::new_nmethod(const methodHandle& method,
             );
 
     if (nm != nullptr) {
-      // To make dependency checking during class loading fast, record
-      // the nmethod dependencies in the classes it is dependent on.
-      // This allows the dependency checking code to simply walk the
-      // class hierarchy above the loaded class, checking only nmethods
-      // which are dependent on those classes.  The slow way is to
-      // check every nmethod for dependencies which makes it linear in
-      // the number of methods compiled.  For applications with a lot
-      // classes the slow way is too slow.
-      for (Dependencies::DepStream deps(nm); deps.next(); ) {
-        if (deps.type() == Dependencies::call_site_target_value) {
-          // CallSite dependencies are managed on per-CallSite instance basis.
-          oop call_site = deps.argument_oop(0);
-          MethodHandles::add_dependent_nmethod(call_site, nm);
-        } else {
-          InstanceKlass* ik = deps.context_type();
-          if (ik == nullptr) {
-            continue;  // ignore things like evol_method
-          }
-          // record this nmethod as dependent on this klass
-          ik->add_dependent_nmethod(nm);
-        }
-      }
+      record_dependencies(nm);
       NOT_PRODUCT(if (nm != nullptr)  note_java_nmethod(nm));
     }
   }
@@ -1234,6 +1240,7 @@ void nmethod::init_defaults(CodeBuffer *code_buffer, CodeOffsets* offsets) {
   _has_method_handle_invokes  = 0;
   _has_wide_vectors           = 0;
   _has_monitors               = 0;
+  _has_scoped_access          = 0;
   _has_flushed_dependencies   = 0;
   _is_unlinked                = 0;
   _load_reported              = 0; // jvmti state
@@ -1380,7 +1387,14 @@ nmethod::nmethod(
   }
 }
 
-void* nmethod::operator new(size_t size, int nmethod_size, int comp_level) throw () {
+void* nmethod::operator new(size_t size, int nmethod_size, int comp_level, bool hot) throw () {
+  if (hot) {
+    // Silently fall back to the non-profiled code heap if the hot one is full.
+    void* return_value = CodeCache::allocate(nmethod_size, CodeBlobType::MethodHot, false /* handle_alloc_failure */);
+    if (return_value != nullptr) {
+      return return_value;
+    }
+  }
   return CodeCache::allocate(nmethod_size, CodeCache::get_code_blob_type(comp_level));
 }
 
@@ -1392,6 +1406,13 @@ void* nmethod::operator new(size_t size, int nmethod_size, bool allow_NonNMethod
   return CodeCache::allocate(nmethod_size, CodeBlobType::NonNMethod);
 }
 
+void* nmethod::operator new(size_t size, int nmethod_size, CodeBlobType code_blob_type, const void* limit) throw () {
+  if (limit != nullptr) {
+    return CodeCache::allocate_below(nmethod_size, code_blob_type, limit);
+  }
+  return CodeCache::allocate(nmethod_size, code_blob_type, false /* handle_alloc_failure */);
+}
+
 // For normal JIT compiled code
 nmethod::nmethod(
   Method* method,
@@ -1559,6 +1580,104 @@ nmethod::nmethod(
   }
 }
 
+// For relocation within the code cache
+nmethod::nmethod(const nmethod& nm)
+  : CodeBlob(nm._name, nm._kind, nm._size, nm._header_size),
+  _deoptimization_generation(0),
+  _gc_epoch(CodeCache::gc_epoch()),
+  _method(nm._method),
+  _osr_link(nullptr)
+{
+  debug_only(NoSafepointVerifier nsv;)
+  assert_locked_or_safepoint(CodeCache_lock);
+  assert(nm.is_java_method() && !nm.is_osr_method(), "only regular Java methods are relocated");
+
+  _oop_maps                  = nm._oop_maps != nullptr ? nm._oop_maps->clone() : nullptr;
+  _relocation_size           = nm._relocation_size;
+  _content_offset            = nm._content_offset;
+  _code_offset               = nm._code_offset;
+  _data_offset               = nm._data_offset;
+  _frame_size                = nm._frame_size;
+  _frame_complete_offset     = nm._frame_complete_offset;
+  _caller_must_gc_arguments  = nm._caller_must_gc_arguments;
+  NOT_PRODUCT(_asm_remarks.share(nm._asm_remarks));
+  NOT_PRODUCT(_dbg_strings.share(nm._dbg_strings));
+
+  _exception_cache           = nullptr;
+  _gc_data                   = nullptr;
+  _oops_do_mark_link         = nullptr;
+  _compiled_ic_data          = nullptr; // allocated by finalize_relocations()
+
+  _osr_entry_point           = code_begin() + (nm._osr_entry_point - nm.code_begin());
+  _entry_offset              = nm._entry_offset;
+  _verified_entry_offset     = nm._verified_entry_offset;
+  _entry_bci                 = nm._entry_bci;
+  _skipped_instructions_size = nm._skipped_instructions_size;
+  _stub_offset               = nm._stub_offset;
+  _exception_offset          = nm._exception_offset;
+  _deopt_handler_offset      = nm._deopt_handler_offset;
+  _deopt_mh_handler_offset   = nm._deopt_mh_handler_offset;
+  _unwind_handler_offset     = nm._unwind_handler_offset;
+  _num_stack_arg_slots       = nm._num_stack_arg_slots;
+  _metadata_offset           = nm._metadata_offset;
+#if INCLUDE_JVMCI
+  _jvmci_data_offset         = nm._jvmci_data_offset;
+#endif
+  _nul_chk_table_offset      = nm._nul_chk_table_offset;
+  _handler_table_offset      = nm._handler_table_offset;
+  _scopes_pcs_offset         = nm._scopes_pcs_offset;
+  _scopes_data_offset        = nm._scopes_data_offset;
+#if INCLUDE_JVMCI
+  _speculations_offset       = nm._speculations_offset;
+#endif
+  _orig_pc_offset            = nm._orig_pc_offset;
+  _compile_id                = nm._compile_id;
+  _comp_level                = nm._comp_level;
+  _compiler_type             = nm._compiler_type;
+
+  _is_unloading_state        = 0;
+  _state                     = not_installed;
+
+  _has_unsafe_access         = nm._has_unsafe_access;
+  _has_method_handle_invokes = nm._has_method_handle_invokes;
+  _has_wide_vectors          = nm._has_wide_vectors;
+  _has_monitors              = nm._has_monitors;
+  _has_scoped_access         = nm._has_scoped_access;
+  _has_flushed_dependencies  = 0;
+  _is_unlinked               = 0;
+  _load_reported             = 0;
+
+  _deoptimization_status     = not_marked;
+
+  // The immutable data is owned by each nmethod and freed when it is purged.
+  _immutable_data_size       = nm._immutable_data_size;
+  if (nm._immutable_data != nm.data_end()) {
+    _immutable_data = (address)os::malloc(_immutable_data_size, mtCode);
+    if (_immutable_data == nullptr) {
+      vm_exit_out_of_memory(_immutable_data_size, OOM_MALLOC_ERROR, "nmethod: no space for immutable data");
+    }
+    memcpy(_immutable_data, nm._immutable_data, _immutable_data_size);
+  } else {
+    _immutable_data = data_end();
+  }
+
+  // Copy relocation info, code, oops, metadata and JVMCI data
+  memcpy(header_begin() + _header_size, nm.header_begin() + nm._header_size, _size - _header_size);
+
+  set_ctable_begin(header_begin() + content_offset());
+
+  _pc_desc_container = new PcDescContainer(scopes_pcs_begin());
+
+  // Fix up the code for its new position. The content is one section in
+  // both buffers, so offsets into the nmethod map one to one.
+  CodeBuffer src(const_cast<nmethod*>(&nm));
+  CodeBuffer dst(this);
+  RelocIterator iter(this);
+  while (iter.next()) {
+    iter.reloc()->fix_relocation_after_move(&src, &dst);
+  }
+}
+
 // Print a short set of xml attributes to identify this nmethod.  The
 // output should be embedded in some other element.
 void nmethod::log_identity(xmlStream* log) const {
@@ -1981,7 +2100,7 @@ void nmethod::unlink_from_method() {
 }
 
 // Invalidate code
-bool nmethod::make_not_entrant() {
+bool nmethod::make_not_entrant(bool relocated) {
   // This can be called while the system is already at a safepoint which is ok
   NoSafepointVerifier nsv;
 
@@ -2021,7 +2140,7 @@ bool nmethod::make_not_entrant() {
                                        SharedRuntime::get_handle_wrong_method_stub());
     }
 
-    if (update_recompile_counts()) {
+    if (!relocated && update_recompile_counts()) {
       // Mark the method as decompiled.
       inc_decompile_count();
     }
@@ -2065,6 +2184,74 @@ bool nmethod::make_not_entrant() {
   return true;
 }
 
+bool nmethod::is_relocatable() {
+  if (!is_java_method() || is_osr_method()) {
+    return false;
+  }
+  if (get_state() != in_use || is_marked_for_deoptimization() || is_unloading()) {
+    return false;
+  }
+  // The HotSpotNmethod mirrors of JVMCI refer to the nmethod's address.
+  if (is_compiled_by_jvmci()) {
+    return false;
+  }
+  // Old methods must rather go away with redefinition.
+  if (has_evol_metadata()) {
+    return false;
+  }
+  return true;
+}
+
+nmethod* nmethod::relocate(CodeBlobType code_blob_type, const void* limit) {
+  assert_lock_strong(Compile_lock);
+  assert_lock_strong(CodeCache_lock);
+  assert(CompiledICLocker::is_safe(this), "mt unsafe call");
+
+  if (!is_relocatable()) {
+    return nullptr;
+  }
+
+  // Heal the oops in the code and disarm the entry barrier, so the copy
+  // starts out like a freshly installed nmethod.
+  run_nmethod_entry_barrier();
+
+  nmethod* nm_copy = new (size(), code_blob_type, limit) nmethod(*this);
+  if (nm_copy == nullptr) {
+    return nullptr;
+  }
+
+  // Compile_lock keeps the dependencies valid until the copy is installed.
+  record_dependencies(nm_copy);
+  NOT_PRODUCT(note_java_nmethod(nm_copy));
+  nm_copy->post_init();
+
+  {
+    // Direct calls to this nmethod's stubs and the inline caches still refer
+    // to the old code, so start the copy with all call sites unresolved.
+    CompiledICLocker ic_locker(nm_copy);
+    nm_copy->clear_inline_caches();
+  }
+  ICache::invalidate_range(nm_copy->code_begin(), nm_copy->code_size());
+
+  MutexLocker ml(NMethodState_lock, Mutex::_no_safepoint_check_flag);
+  if (get_state() == in_use && method()->code() == this && !is_marked_for_deoptimization()) {
+    bool success = nm_copy->make_in_use();
+    assert(success, "Transition can't fail");
+    methodHandle mh(Thread::current(), method());
+    Method::set_code(mh, nm_copy);
+    // Callers patched to the old entry go through the handle wrong method
+    // stub and are resolved to the copy.
+    make_not_entrant(true /* relocated */);
+    log_debug(codecache)("Relocated nmethod %d from " INTPTR_FORMAT " to " INTPTR_FORMAT " in %s",
+                         compile_id(), p2i(this), p2i(nm_copy), CodeCache::get_code_heap_name(code_blob_type));
+    return nm_copy;
+  }
+
+  // The nmethod was invalidated while it was copied, so drop the copy.
+  nm_copy->make_not_entrant(true /* relocated */);
+  return nullptr;
+}
+
 // For concurrent GCs, there must be a handshake between unlink and flush
 void nmethod::unlink() {
   if (is_unlinked()) {
@@ -2826,7 +3013,7 @@ PcDesc* PcDescContainer::find_pc_desc_internal(address pc, bool approximate, add
   }
 }
 
-bool nmethod::check_dependency_on(DepChange& changes) {
+bool nmethod::check_dependency_on(DepChange& changes, int* dep_type) {
   // What has happened:
   // 1) a new class dependee has been added
   // 2) dependee and all its super classes have been marked
@@ -2834,6 +3021,9 @@ bool nmethod::check_dependency_on(DepChange& changes) {
   for (Dependencies::DepStream deps(this); deps.next(); ) {
     // Evaluate only relevant dependencies.
     if (deps.spot_check_dependency_at(changes) != nullptr) {
+      if (!found_check && dep_type != nullptr) {
+        *dep_type = deps.type();
+      }
       found_check = true;
       NOT_DEBUG(break);
     }
@@ -271,6 +271,7 @@ class nmethod : public CodeBlob {
           _has_method_handle_invokes:1,// Has this method MethodHandle invokes?
           _has_wide_vectors:1,         // Preserve wide vectors at safepoints
           _has_monitors:1,             // Fastpath monitor detection for continuations
+          _has_scoped_access:1,        // Has inlined a @Scoped ScopedMemoryAccess method
           _has_flushed_dependencies:1, // Used for maintenance of dependencies (under CodeCache_lock)
           _is_unlinked:1,              // mark during class unloading
           _load_reported:1;            // used by jvmti to track if an event has been posted for this nmethod
@@ -332,14 +333,21 @@ class nmethod : public CodeBlob {
 #endif
           );
 
+  // For relocation of an nmethod within the code cache, see relocate()
+  nmethod(const nmethod& nm);
+
   // helper methods
-  void* operator new(size_t size, int nmethod_size, int comp_level) throw();
+  // Hot nmethods are tried in the hot code heap first, see CodeCache::is_hot_method().
+  void* operator new(size_t size, int nmethod_size, int comp_level, bool hot) throw();
 
   // For method handle intrinsics: Try MethodNonProfiled, MethodProfiled and NonNMethod.
   // Attention: Only allow NonNMethod space for special nmethods which don't need to be
   // findable by nmethod iterators! In particular, they must not contain oops!
   void* operator new(size_t size, int nmethod_size, bool allow_NonNMethod_space) throw();
 
+  // For relocation: Allocate in the given code heap, below 'limit' if it is not null.
+  void* operator new(size_t size, int nmethod_size, CodeBlobType code_blob_type, const void* limit) throw();
+
   const char* reloc_string_for(u_char* begin, u_char* end);
 
   bool try_transition(signed char new_state);
@@ -630,9 +638,20 @@ class nmethod : public CodeBlob {
   // alive.  It is used when an uncommon trap happens.  Returns true
   // if this thread changed the state of the nmethod or false if
   // another thread performed the transition.
-  bool  make_not_entrant();
+  // A relocated nmethod is made not entrant without counting as a decompilation.
+  bool  make_not_entrant(bool relocated = false);
   bool  make_not_used()    { return make_not_entrant(); }
 
+  // Relocation of an nmethod copies it into another place in the code cache
+  // and replaces it as the code of its method. Activations of the old
+  // nmethod continue to run in it; it is made not entrant and freed by the
+  // GC once the nmethod entry barriers find it is no longer on any stack.
+  // The caller must hold the Compile_lock, a CompiledICLocker for this
+  // nmethod and the CodeCache_lock. If 'limit' is not null, the copy must
+  // fit into a free block below it. Returns the copy or null.
+  bool     is_relocatable();
+  nmethod* relocate(CodeBlobType code_blob_type, const void* limit = nullptr);
+
   bool  is_marked_for_deoptimization() const { return deoptimization_status() != not_marked; }
   bool  has_been_deoptimized() const { return deoptimization_status() == deoptimize_done; }
   void  set_deoptimized_done();
@@ -664,6 +683,9 @@ class nmethod : public CodeBlob {
   bool  has_monitors() const                      { return _has_monitors; }
   void  set_has_monitors(bool z)                  { _has_monitors = z; }
 
+  bool  has_scoped_access() const                 { return _has_scoped_access; }
+  void  set_has_scoped_access(bool z)             { _has_scoped_access = z; }
+
   bool  has_method_handle_invokes() const         { return _has_method_handle_invokes; }
   void  set_has_method_handle_invokes(bool z)     { _has_method_handle_invokes = z; }
 
@@ -963,8 +985,9 @@ class nmethod : public CodeBlob {
   void print_code_comment_on(outputStream* st, int column, address begin, address end);
 
   // tells if this compiled method is dependent on the given changes,
-  // and the changes have invalidated it
-  bool check_dependency_on(DepChange& changes);
+  // and the changes have invalidated it. If dep_type is not null, the
+  // type of the first invalidated dependency is stored there.
+  bool check_dependency_on(DepChange& changes, int* dep_type = nullptr);
 
   // Fast breakpoint support. Tells if this compiled method is
   // dependent on the given method. Returns true if this nmethod
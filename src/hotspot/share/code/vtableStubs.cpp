@@ -141,7 +141,8 @@ int VtableStubs::code_size_limit(bool is_vtable_stub) {
   if (is_vtable_stub) {
     return _vtab_stub_size > 0 ? _vtab_stub_size : first_vtableStub_size;
   } else { // itable stub
-    return _itab_stub_size > 0 ? _itab_stub_size : first_itableStub_size;
+    // Leave room for the type cache checks, see InterfaceCallTypeCacheSize.
+    return _itab_stub_size > 0 ? _itab_stub_size : first_itableStub_size + (int)InterfaceCallTypeCacheSize * 64;
   }
 }   // code_size_limit
 
@@ -28,6 +28,7 @@
 #include "compiler/compileBroker.hpp"
 #include "compiler/compilerDefinitions.inline.hpp"
 #include "compiler/compilerOracle.hpp"
+#include "compiler/methodProfileArchive.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/methodData.hpp"
 #include "oops/method.inline.hpp"
@@ -232,6 +233,7 @@ class LoopPredicate : AllStatic {
     if (CompilerOracle::has_option_value(method, CompileCommandEnum::CompileThresholdScaling, threshold_scaling)) {
       scale *= threshold_scaling;
     }
+    scale *= MethodProfileArchive::threshold_scaling(method);
     switch(cur_level) {
     case CompLevel_none:
     case CompLevel_limited_profile:
@@ -270,6 +272,7 @@ class CallPredicate : AllStatic {
     if (CompilerOracle::has_option_value(method, CompileCommandEnum::CompileThresholdScaling, threshold_scaling)) {
       scale *= threshold_scaling;
     }
+    scale *= MethodProfileArchive::threshold_scaling(method);
     switch(cur_level) {
     case CompLevel_none:
     case CompLevel_limited_profile:
@@ -619,57 +622,45 @@ void CompilationPolicy::handle_counter_overflow(const methodHandle& method) {
 
 // Called with the queue locked and with at least one element
 CompileTask* CompilationPolicy::select_task(CompileQueue* compile_queue) {
-  CompileTask *max_blocking_task = nullptr;
-  CompileTask *max_task = nullptr;
-  Method* max_method = nullptr;
-
   jlong t = nanos_to_millis(os::javaTimeNanos());
-  // Iterate through the queue and find a method with a maximum rate.
-  for (CompileTask* task = compile_queue->first(); task != nullptr;) {
-    CompileTask* next_task = task->next();
-    // If a method was unloaded or has been stale for some time, remove it from the queue.
-    // Blocking tasks and tasks submitted from whitebox API don't become stale
-    if (task->is_unloaded()) {
-      compile_queue->remove_and_mark_stale(task);
-      task = next_task;
-      continue;
-    }
-    Method* method = task->method();
-    methodHandle mh(Thread::current(), method);
-    if (task->can_become_stale() && is_stale(t, TieredCompileTaskTimeout, mh) && !is_old(mh)) {
-      if (PrintTieredEvents) {
-        print_event(REMOVE_FROM_QUEUE, method, method, task->osr_bci(), (CompLevel) task->comp_level());
+  if (t - compile_queue->last_rescan_ms() >= TieredCompileQueueRescanInterval) {
+    // Update the rates and priorities of all queued methods. In between,
+    // the queue order is based on the priorities the tasks had when they
+    // were added or at the last rescan.
+    for (CompileTask* task = compile_queue->first(); task != nullptr;) {
+      CompileTask* next_task = task->next();
+      // If a method was unloaded or has been stale for some time, remove it from the queue.
+      // Blocking tasks and tasks submitted from whitebox API don't become stale
+      if (task->is_unloaded()) {
+        compile_queue->remove_and_mark_stale(task);
+        task = next_task;
+        continue;
       }
-      method->clear_queued_for_compilation();
-      compile_queue->remove_and_mark_stale(task);
-      task = next_task;
-      continue;
-    }
-    update_rate(t, mh);
-    if (max_task == nullptr || compare_methods(method, max_method)) {
-      // Select a method with the highest rate
-      max_task = task;
-      max_method = method;
-    }
-
-    if (task->is_blocking()) {
-      if (max_blocking_task == nullptr || compare_methods(method, max_blocking_task->method())) {
-        max_blocking_task = task;
+      Method* method = task->method();
+      methodHandle mh(Thread::current(), method);
+      if (task->can_become_stale() && is_stale(t, TieredCompileTaskTimeout, mh) && !is_old(mh)) {
+        if (PrintTieredEvents) {
+          print_event(REMOVE_FROM_QUEUE, method, method, task->osr_bci(), (CompLevel) task->comp_level());
+        }
+        method->clear_queued_for_compilation();
+        compile_queue->remove_and_mark_stale(task);
+        task = next_task;
+        continue;
       }
+      update_rate(t, mh);
+      update_priority(task);
+      task = next_task;
     }
-
-    task = next_task;
+    compile_queue->rebuild_heap(t);
   }
 
-  if (max_blocking_task != nullptr) {
-    // In blocking compilation mode, the CompileBroker will make
-    // compilations submitted by a JVMCI compiler thread non-blocking. These
-    // compilations should be scheduled after all blocking compilations
-    // to service non-compiler related compilations sooner and reduce the
-    // chance of such compilations timing out.
-    max_task = max_blocking_task;
-    max_method = max_task->method();
+  // Select the method with the highest rate.
+  CompileTask* max_task = compile_queue->highest_priority();
+  while (max_task != nullptr && max_task->is_unloaded()) {
+    compile_queue->remove_and_mark_stale(max_task);
+    max_task = compile_queue->highest_priority();
   }
+  Method* max_method = max_task != nullptr ? max_task->method() : nullptr;
 
   methodHandle max_method_h(Thread::current(), max_method);
 
@@ -877,18 +868,26 @@ double CompilationPolicy::weight(Method* method) {
   return (double)(method->rate() + 1) * (method->invocation_count() + 1) * (method->backedge_count() + 1);
 }
 
+void CompilationPolicy::update_priority(CompileTask* task) {
+  Method* method = task->method();
+  task->set_priority(method->highest_comp_level(), weight(method));
+}
+
 // Apply heuristics and return true if x should be compiled before y
-bool CompilationPolicy::compare_methods(Method* x, Method* y) {
-  if (x->highest_comp_level() > y->highest_comp_level()) {
+bool CompilationPolicy::compare_tasks(CompileTask* x, CompileTask* y) {
+  if (x->is_blocking() != y->is_blocking()) {
+    // In blocking compilation mode, the CompileBroker will make
+    // compilations submitted by a JVMCI compiler thread non-blocking. These
+    // compilations should be scheduled after all blocking compilations
+    // to service non-compiler related compilations sooner and reduce the
+    // chance of such compilations timing out.
+    return x->is_blocking();
+  }
+  if (x->priority_level() != y->priority_level()) {
     // recompilation after deopt
-    return true;
-  } else
-    if (x->highest_comp_level() == y->highest_comp_level()) {
-      if (weight(x) > weight(y)) {
-        return true;
-      }
-    }
-  return false;
+    return x->priority_level() > y->priority_level();
+  }
+  return x->priority_weight() > y->priority_weight();
 }
 
 // Is method profiled enough?
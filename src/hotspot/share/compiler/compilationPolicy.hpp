@@ -203,8 +203,6 @@ class CompilationPolicy : AllStatic {
   inline static bool is_stale(jlong t, jlong timeout, const methodHandle& method);
   // Compute the weight of the method for the compilation scheduling
   inline static double weight(Method* method);
-  // Apply heuristics and return true if x should be compiled before y
-  inline static bool compare_methods(Method* x, Method* y);
   // Compute event rate for a given method. The rate is the number of event (invocations + backedges)
   // per millisecond.
   inline static void update_rate(jlong t, const methodHandle& method);
@@ -268,6 +266,11 @@ class CompilationPolicy : AllStatic {
                         int branch_bci, int bci, CompLevel comp_level, nmethod* nm, TRAPS);
   // Select task is called by CompileBroker. We should return a task or nullptr.
   static CompileTask* select_task(CompileQueue* compile_queue);
+  // Record the current priority of the task's method in the task.
+  static void update_priority(CompileTask* task);
+  // Return true if task x should be compiled before task y, based on
+  // the priorities recorded in the tasks.
+  static bool compare_tasks(CompileTask* x, CompileTask* y);
   // Tell the runtime if we think a given method is adequately profiled.
   static bool is_mature(Method* method);
   // Initialize: set compiler thread count
@@ -38,6 +38,7 @@
 #include "compiler/compilerEvent.hpp"
 #include "compiler/compilerOracle.hpp"
 #include "compiler/directivesParser.hpp"
+#include "compiler/methodProfileArchive.hpp"
 #include "gc/shared/memAllocator.hpp"
 #include "interpreter/linkResolver.hpp"
 #include "jvm.h"
@@ -68,6 +69,7 @@
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/threads.hpp"
 #include "runtime/threadSMR.hpp"
+#include "runtime/timer.hpp"
 #include "runtime/timerTrace.hpp"
 #include "runtime/vframe.inline.hpp"
 #include "utilities/debug.hpp"
@@ -75,6 +77,7 @@
 #include "utilities/events.hpp"
 #include "utilities/formatBuffer.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/powerOfTwo.hpp"
 #ifdef COMPILER1
 #include "c1/c1_Compiler.hpp"
 #endif
@@ -133,6 +136,11 @@ AbstractCompiler* CompileBroker::_compilers[2];
 int CompileBroker::_c1_count = 0;
 int CompileBroker::_c2_count = 0;
 
+volatile jlong CompileBroker::_compiler_cpu_time = 0;
+volatile jlong CompileBroker::_cpu_sample_time = 0;
+jlong CompileBroker::_cpu_sample_compiler_cpu_time = 0;
+volatile bool CompileBroker::_cpu_budget_exceeded = false;
+
 // An array of compiler names as Java String objects
 jobject* CompileBroker::_compiler1_objects = nullptr;
 jobject* CompileBroker::_compiler2_objects = nullptr;
@@ -331,6 +339,9 @@ void CompileQueue::add(CompileTask* task) {
     task->set_prev(_last);
     _last = task;
   }
+  CompilationPolicy::update_priority(task);
+  heap_set(_heap.length(), task);
+  heap_sift_up(task->queue_index());
   ++_size;
   ++_total_added;
   if (_size > _peak_size) {
@@ -376,6 +387,7 @@ void CompileQueue::free_all() {
   }
   _first = nullptr;
   _last = nullptr;
+  _heap.clear();
 
   // Wake up all threads that block on the queue.
   MethodCompileQueue_lock->notify_all();
@@ -446,6 +458,7 @@ CompileTask* CompileQueue::get(CompilerThread* thread) {
     save_hot_method = methodHandle(thread, task->hot_method());
 
     remove(task);
+    record_wait_time(task);
   }
   purge_stale_tasks(); // may temporarily release MCQ lock
   return task;
@@ -491,6 +504,7 @@ void CompileQueue::remove(CompileTask* task) {
     assert(task == _last, "Sanity");
     _last = task->prev();
   }
+  heap_remove(task);
   --_size;
   ++_total_removed;
 }
@@ -505,6 +519,104 @@ void CompileQueue::remove_and_mark_stale(CompileTask* task) {
   _first_stale = task;
 }
 
+void CompileQueue::heap_set(int index, CompileTask* task) {
+  if (index == _heap.length()) {
+    _heap.append(task);
+  } else {
+    _heap.at_put(index, task);
+  }
+  task->set_queue_index(index);
+}
+
+void CompileQueue::heap_sift_up(int index) {
+  CompileTask* task = _heap.at(index);
+  while (index > 0) {
+    int parent = (index - 1) / 2;
+    if (!CompilationPolicy::compare_tasks(task, _heap.at(parent))) {
+      break;
+    }
+    heap_set(index, _heap.at(parent));
+    index = parent;
+  }
+  heap_set(index, task);
+}
+
+void CompileQueue::heap_sift_down(int index) {
+  CompileTask* task = _heap.at(index);
+  int length = _heap.length();
+  while (true) {
+    int child = 2 * index + 1;
+    if (child >= length) {
+      break;
+    }
+    if (child + 1 < length && CompilationPolicy::compare_tasks(_heap.at(child + 1), _heap.at(child))) {
+      child++;
+    }
+    if (!CompilationPolicy::compare_tasks(_heap.at(child), task)) {
+      break;
+    }
+    heap_set(index, _heap.at(child));
+    index = child;
+  }
+  heap_set(index, task);
+}
+
+void CompileQueue::heap_remove(CompileTask* task) {
+  int index = task->queue_index();
+  assert(index >= 0 && index < _heap.length() && _heap.at(index) == task, "not in heap");
+  CompileTask* last = _heap.pop();
+  task->set_queue_index(-1);
+  if (last != task) {
+    heap_set(index, last);
+    heap_sift_down(index);
+    heap_sift_up(last->queue_index());
+  }
+}
+
+void CompileQueue::rebuild_heap(jlong now_ms) {
+  assert(MethodCompileQueue_lock->owned_by_self(), "must own lock");
+  for (int i = _heap.length() / 2 - 1; i >= 0; i--) {
+    heap_sift_down(i);
+  }
+  _last_rescan_ms = now_ms;
+}
+
+void CompileQueue::record_wait_time(CompileTask* task) {
+  int level = task->comp_level();
+  if (level <= CompLevel_none || level > CompLevel_full_optimization) {
+    return;
+  }
+  jlong millis = (jlong)TimeHelper::counter_to_millis(os::elapsed_counter() - task->time_queued());
+  int bucket = millis <= 0 ? 0 : MIN2(log2i(millis) + 1, wait_time_buckets - 1);
+  _wait_times[level][bucket]++;
+}
+
+void CompileQueue::print_wait_times(outputStream* st) {
+  assert_locked_or_safepoint(MethodCompileQueue_lock);
+  st->print_cr("%s wait times:", name());
+  for (int level = CompLevel_simple; level <= CompLevel_full_optimization; level++) {
+    uint total = 0;
+    for (int i = 0; i < wait_time_buckets; i++) {
+      total += _wait_times[level][i];
+    }
+    if (total == 0) {
+      continue;
+    }
+    st->print("  level %d (%u tasks):", level, total);
+    for (int i = 0; i < wait_time_buckets; i++) {
+      if (_wait_times[level][i] == 0) {
+        continue;
+      }
+      if (i == wait_time_buckets - 1) {
+        st->print(" >=%dms: %u", 1 << (i - 1), _wait_times[level][i]);
+      } else {
+        st->print(" <%dms: %u", 1 << i, _wait_times[level][i]);
+      }
+    }
+    st->cr();
+  }
+}
+
 // methods in the compile queue need to be marked as used on the stack
 // so that they don't get reclaimed by Redefine Classes
 void CompileQueue::mark_on_stack() {
@@ -544,6 +656,12 @@ void CompileBroker::print_compile_queues(outputStream* st) {
   if (_c2_compile_queue != nullptr) {
     _c2_compile_queue->print(st);
   }
+  if (_c1_compile_queue != nullptr) {
+    _c1_compile_queue->print_wait_times(st);
+  }
+  if (_c2_compile_queue != nullptr) {
+    _c2_compile_queue->print_wait_times(st);
+  }
 }
 
 void CompileQueue::print(outputStream* st) {
@@ -611,6 +729,8 @@ void CompileBroker::compilation_init(JavaThread* THREAD) {
   if (!UseCompiler) {
     return;
   }
+  MethodProfileArchive::load();
+
   // Set the interface to the current compiler(s).
   _c1_count = CompilationPolicy::c1_count();
   _c2_count = CompilationPolicy::c2_count();
@@ -1021,6 +1141,36 @@ void CompileBroker::init_compiler_threads() {
 #endif // defined(ASSERT) && COMPILER2_OR_JVMCI
 }
 
+// Number of CPUs the compiler threads may use with CompilerThreadCPUBudget.
+// os::active_processor_count() takes container CPU quotas into account.
+double CompileBroker::compiler_cpu_budget() {
+  assert(CompilerThreadCPUBudget > 0, "no budget");
+  return MAX2(1.0, os::active_processor_count() * CompilerThreadCPUBudget / 100.0);
+}
+
+// Compare the CPU usage of the compiler threads since the last sample with
+// the budget. Called by compiler threads after each compilation.
+void CompileBroker::sample_compiler_cpu_usage() {
+  const jlong sample_interval = 100 * NANOSECS_PER_MILLISEC;
+  jlong now = os::javaTimeNanos();
+  jlong last = Atomic::load(&_cpu_sample_time);
+  if (now - last < sample_interval || Atomic::cmpxchg(&_cpu_sample_time, last, now) != last) {
+    // Too early, or another thread takes this sample.
+    return;
+  }
+  jlong cpu_time = Atomic::load(&_compiler_cpu_time);
+  double usage = (double)(cpu_time - _cpu_sample_compiler_cpu_time) / (double)(now - last);
+  _cpu_sample_compiler_cpu_time = cpu_time;
+
+  double budget = compiler_cpu_budget();
+  bool exceeded = usage >= budget;
+  if (exceeded != Atomic::load(&_cpu_budget_exceeded)) {
+    log_debug(jit, thread)("Compiler threads %s CPU budget: using %.2f of %.2f CPUs",
+                           exceeded ? "exceed" : "are within", usage, budget);
+    Atomic::store(&_cpu_budget_exceeded, exceeded);
+  }
+}
+
 void CompileBroker::possibly_add_compiler_threads(JavaThread* THREAD) {
 
   julong free_memory = os::free_memory();
@@ -1031,12 +1181,21 @@ void CompileBroker::possibly_add_compiler_threads(JavaThread* THREAD) {
   // Only do attempt to start additional threads if the lock is free.
   if (!CompileThread_lock->try_lock()) return;
 
+  // Limit on the total number of compiler threads with CompilerThreadCPUBudget.
+  // Don't add any while the compiler threads exceed their budget.
+  int cpu_limit = max_jint;
+  if (CompilerThreadCPUBudget > 0) {
+    cpu_limit = Atomic::load(&_cpu_budget_exceeded) ? 0 : (int)compiler_cpu_budget();
+  }
+
   if (_c2_compile_queue != nullptr) {
     int old_c2_count = _compilers[1]->num_compiler_threads();
+    int c1_count = (_c1_compile_queue != nullptr) ? _compilers[0]->num_compiler_threads() : 0;
     int new_c2_count = MIN4(_c2_count,
         _c2_compile_queue->size() / 2,
         (int)(free_memory / (200*M)),
         (int)(available_cc_np / (128*K)));
+    new_c2_count = MIN2(new_c2_count, cpu_limit - c1_count);
 
     for (int i = old_c2_count; i < new_c2_count; i++) {
 #if INCLUDE_JVMCI
@@ -1094,10 +1253,12 @@ void CompileBroker::possibly_add_compiler_threads(JavaThread* THREAD) {
 
   if (_c1_compile_queue != nullptr) {
     int old_c1_count = _compilers[0]->num_compiler_threads();
+    int c2_count = (_c2_compile_queue != nullptr) ? _compilers[1]->num_compiler_threads() : 0;
     int new_c1_count = MIN4(_c1_count,
         _c1_compile_queue->size() / 4,
         (int)(free_memory / (100*M)),
         (int)(available_cc_p / (128*K)));
+    new_c1_count = MIN2(new_c1_count, cpu_limit - c2_count);
 
     for (int i = old_c1_count; i < new_c1_count; i++) {
       JavaThread *ct = make_thread(compiler_t, compiler1_object(i), _c1_compile_queue, _compilers[0], THREAD);
@@ -1958,7 +2119,14 @@ void CompileBroker::compiler_thread_loop() {
       if (method()->number_of_breakpoints() == 0) {
         // Compile the method.
         if ((UseCompiler || AlwaysCompileLoopMethods) && CompileBroker::should_compile_new_jobs()) {
-          invoke_compiler_on_method(task);
+          if (CompilerThreadCPUBudget > 0 && os::is_thread_cpu_time_supported()) {
+            jlong start_cpu_time = os::current_thread_cpu_time();
+            invoke_compiler_on_method(task);
+            Atomic::add(&_compiler_cpu_time, os::current_thread_cpu_time() - start_cpu_time);
+            sample_compiler_cpu_usage();
+          } else {
+            invoke_compiler_on_method(task);
+          }
           thread->start_idle_timer();
         } else {
           // After compilation is disabled, remove remaining methods from queue
@@ -1973,6 +2141,11 @@ void CompileBroker::compiler_thread_loop() {
         possibly_add_compiler_threads(thread);
         assert(!thread->has_pending_exception(), "should have been handled");
       }
+
+      if (CompilerThreadCPUBudget > 0 && Atomic::load(&_cpu_budget_exceeded)) {
+        // Let application threads run before taking the next task.
+        os::naked_yield();
+      }
     }
   }
 
@@ -2186,6 +2359,9 @@ void CompileBroker::invoke_compiler_on_method(CompileTask* task) {
     }
 
     DTRACE_METHOD_COMPILE_BEGIN_PROBE(method, compiler_name(task_level));
+
+    // Must be tagged before the compiler looks at it, see ciEnv::cache_dtrace_flags().
+    CompilerOracle::tag_traced_calls_if_requested(method);
   }
 
   should_break = directive->BreakAtCompileOption || task->check_break_at_flags();
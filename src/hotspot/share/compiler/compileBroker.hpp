@@ -32,6 +32,7 @@
 #include "compiler/compilerThread.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/perfDataTypes.hpp"
+#include "utilities/growableArray.hpp"
 #include "utilities/stack.hpp"
 #if INCLUDE_JVMCI
 #include "jvmci/jvmciCompiler.hpp"
@@ -78,8 +79,18 @@ class CompilerCounters : public CHeapObj<mtCompiler> {
 // CompileQueue
 //
 // A list of CompileTasks.
+//
+// The tasks are also kept in a binary max-heap, ordered by the priority
+// recorded in each task (see CompilationPolicy::compare_tasks()). The
+// priority of a task is computed when it is added. The priorities of all
+// tasks are recomputed, and the heap is rebuilt, by select_task() at most
+// every TieredCompileQueueRescanInterval milliseconds.
 class CompileQueue : public CHeapObj<mtCompiler> {
  private:
+  // Queue wait times are recorded per compilation level, in buckets
+  // of power of two milliseconds: <1ms, <2ms, <4ms, and so on.
+  static const int wait_time_buckets = 16;
+
   const char* _name;
 
   CompileTask* _first;
@@ -87,14 +98,25 @@ class CompileQueue : public CHeapObj<mtCompiler> {
 
   CompileTask* _first_stale;
 
+  GrowableArrayCHeap<CompileTask*, mtCompiler> _heap;
+  jlong _last_rescan_ms;
+
   int _size;
   int _peak_size;
   uint _total_added;
   uint _total_removed;
 
+  uint _wait_times[CompLevel_full_optimization + 1][wait_time_buckets];
+
   void purge_stale_tasks();
+
+  void heap_set(int index, CompileTask* task);
+  void heap_sift_up(int index);
+  void heap_sift_down(int index);
+  void heap_remove(CompileTask* task);
+  void record_wait_time(CompileTask* task);
  public:
-  CompileQueue(const char* name) {
+  CompileQueue(const char* name) : _heap(64) {
     _name = name;
     _first = nullptr;
     _last = nullptr;
@@ -103,6 +125,8 @@ class CompileQueue : public CHeapObj<mtCompiler> {
     _total_removed = 0;
     _peak_size = 0;
     _first_stale = nullptr;
+    _last_rescan_ms = 0;
+    memset(_wait_times, 0, sizeof(_wait_times));
   }
 
   const char*  name() const                      { return _name; }
@@ -113,6 +137,12 @@ class CompileQueue : public CHeapObj<mtCompiler> {
   CompileTask* first()                           { return _first; }
   CompileTask* last()                            { return _last;  }
 
+  // The task with the highest priority, or null if the queue is empty.
+  CompileTask* highest_priority() const          { return _heap.is_empty() ? nullptr : _heap.first(); }
+  // Restore the heap order after the priorities of the tasks have changed.
+  void         rebuild_heap(jlong now_ms);
+  jlong        last_rescan_ms() const            { return _last_rescan_ms; }
+
   CompileTask* get(CompilerThread* thread);
 
   bool         is_empty() const                  { return _first == nullptr; }
@@ -127,6 +157,7 @@ class CompileQueue : public CHeapObj<mtCompiler> {
   void free_all();
   void print_tty();
   void print(outputStream* st = tty);
+  void print_wait_times(outputStream* st);
 
   ~CompileQueue() {
     assert (is_empty(), " Compile Queue must be empty");
@@ -173,6 +204,12 @@ class CompileBroker: AllStatic {
   // The maximum numbers of compiler threads to be determined during startup.
   static int _c1_count, _c2_count;
 
+  // CPU time spent in compilations, sampled for CompilerThreadCPUBudget.
+  static volatile jlong _compiler_cpu_time;
+  static volatile jlong _cpu_sample_time;
+  static jlong _cpu_sample_compiler_cpu_time;
+  static volatile bool _cpu_budget_exceeded;
+
   // An array of compiler thread Java objects
   static jobject *_compiler1_objects, *_compiler2_objects;
 
@@ -244,6 +281,8 @@ class CompileBroker: AllStatic {
   static JavaThread* make_thread(ThreadType type, jobject thread_oop, CompileQueue* queue, AbstractCompiler* comp, JavaThread* THREAD);
   static void init_compiler_threads();
   static void possibly_add_compiler_threads(JavaThread* THREAD);
+  static double compiler_cpu_budget();
+  static void sample_compiler_cpu_usage();
   static bool compilation_is_prohibited(const methodHandle& method, int osr_bci, int comp_level, bool excluded);
 
   static CompileTask* create_compile_task(CompileQueue*       queue,
@@ -138,6 +138,9 @@ void CompileTask::initialize(int compile_id,
   }
 
   _next = nullptr;
+  _queue_index = -1;
+  _priority_level = 0;
+  _priority_weight = 0.0;
 }
 
 /**
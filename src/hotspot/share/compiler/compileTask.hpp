@@ -102,6 +102,11 @@ class CompileTask : public CHeapObj<mtCompiler> {
   int                  _num_inlined_bytecodes;
   CompileTask*         _next, *_prev;
   bool                 _is_free;
+  // Position in the priority heap of the compile queue, and the priority
+  // the task has there (see CompileQueue).
+  int                  _queue_index;
+  int                  _priority_level;
+  double               _priority_weight;
   // Fields used for logging why the compilation was initiated:
   jlong                _time_queued;  // time when task was enqueued
   jlong                _time_started; // time when compilation started
@@ -193,6 +198,16 @@ class CompileTask : public CHeapObj<mtCompiler> {
   void         set_prev(CompileTask* prev)       { _prev = prev; }
   bool         is_free() const                   { return _is_free; }
   void         set_is_free(bool val)             { _is_free = val; }
+
+  int          queue_index() const               { return _queue_index; }
+  void         set_queue_index(int index)        { _queue_index = index; }
+  int          priority_level() const            { return _priority_level; }
+  double       priority_weight() const           { return _priority_weight; }
+  void         set_priority(int level, double weight) {
+    _priority_level = level;
+    _priority_weight = weight;
+  }
+  jlong        time_queued() const               { return _time_queued; }
   bool         is_unloaded() const;
 
   // RedefineClasses support
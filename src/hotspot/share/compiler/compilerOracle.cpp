@@ -466,7 +466,10 @@ bool CompilerOracle::should_inline(const methodHandle& method) {
 }
 
 bool CompilerOracle::should_not_inline(const methodHandle& method) {
-  return check_predicate(CompileCommandEnum::DontInline, method) || check_predicate(CompileCommandEnum::Exclude, method);
+  // Traced methods are not inlined so that only their own compiled code has
+  // to report their entries and exits.
+  return check_predicate(CompileCommandEnum::DontInline, method) || check_predicate(CompileCommandEnum::Exclude, method) ||
+         check_predicate(CompileCommandEnum::TraceMethodCalls, method);
 }
 
 bool CompilerOracle::should_print(const methodHandle& method) {
@@ -529,6 +532,13 @@ void CompilerOracle::tag_blackhole_if_possible(const methodHandle& method) {
   method->set_intrinsic_id(vmIntrinsics::_blackhole);
 }
 
+void CompilerOracle::tag_traced_calls_if_requested(const methodHandle& method) {
+  if (method->has_traced_calls() || !check_predicate(CompileCommandEnum::TraceMethodCalls, method)) {
+    return;
+  }
+  method->set_has_traced_calls();
+}
+
 static CompileCommandEnum match_option_name(const char* line, int* bytes_read, char* errorbuf, int bufsize) {
   assert(ARRAY_SIZE(option_names) == static_cast<int>(CompileCommandEnum::Count), "option_names size mismatch");
 
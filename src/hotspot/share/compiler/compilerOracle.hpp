@@ -53,6 +53,7 @@ class methodHandle;
   option(Inline,  "inline", Bool) \
   option(DontInline,  "dontinline", Bool) \
   option(Blackhole,  "blackhole", Bool) \
+  option(TraceMethodCalls, "TraceMethodCalls", Bool) \
   option(CompileOnly, "compileonly", Bool)\
   option(Exclude, "exclude", Bool) \
   option(Break, "break", Bool) \
@@ -170,6 +171,10 @@ class CompilerOracle : AllStatic {
   // Tags the method as blackhole candidate, if possible.
   static void tag_blackhole_if_possible(const methodHandle& method);
 
+  // Tags the method for reporting its entries and exits from compiled code,
+  // if requested by TraceMethodCalls.
+  static void tag_traced_calls_if_requested(const methodHandle& method);
+
   // A wrapper for checking bool options
   static bool has_option(const methodHandle& method, CompileCommandEnum option);
 
@@ -27,6 +27,7 @@
 #include "compiler/compileBroker.hpp"
 #include "compiler/compileTask.hpp"
 #include "compiler/compilerThread.hpp"
+#include "memory/arena.hpp"
 #include "runtime/javaThread.inline.hpp"
 
 // Create a CompilerThread
@@ -42,6 +43,10 @@ CompilerThread::CompilerThread(CompileQueue* queue,
   _can_call_java = false;
   _compiler = nullptr;
   _arena_stat = CompilationMemoryStatistic::enabled() ? new ArenaStatCounter : nullptr;
+  _chunk_cache = nullptr;
+  if (CompilerThreadChunkCacheSize > 0) {
+    _chunk_cache = new ThreadChunkCache(CompilerThreadChunkCacheSize, CompilerThreadChunkCacheLargePages);
+  }
 
 #ifndef PRODUCT
   _ideal_graph_printer = nullptr;
@@ -52,6 +57,10 @@ CompilerThread::~CompilerThread() {
   // Delete objects which were allocated on heap.
   delete _counters;
   delete _arena_stat;
+  // Chunks released from now on bypass the cache.
+  ThreadChunkCache* const cache = _chunk_cache;
+  _chunk_cache = nullptr;
+  delete cache;
 }
 
 void CompilerThread::set_compiler(AbstractCompiler* c) {
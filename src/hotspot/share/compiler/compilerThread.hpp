@@ -37,6 +37,7 @@ class CompileTask;
 class CompileQueue;
 class CompilerCounters;
 class IdealGraphPrinter;
+class ThreadChunkCache;
 
 // A thread used for Compilation.
 class CompilerThread : public JavaThread {
@@ -56,6 +57,7 @@ class CompilerThread : public JavaThread {
   TimeStamp             _idle_time;
 
   ArenaStatCounter*     _arena_stat;
+  ThreadChunkCache*     _chunk_cache;
 
  public:
 
@@ -85,6 +87,8 @@ class CompilerThread : public JavaThread {
   CompileQueue* queue()        const             { return _queue; }
   CompilerCounters* counters() const             { return _counters; }
   ArenaStatCounter* arena_stat() const           { return _arena_stat; }
+  // Arena chunks kept for later compilations, or null (see CompilerThreadChunkCacheSize)
+  ThreadChunkCache* chunk_cache() const          { return _chunk_cache; }
 
   // Get/set the thread's compilation environment.
   ciEnv*        env()                            { return _env; }
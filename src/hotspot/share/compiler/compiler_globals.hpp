@@ -247,6 +247,12 @@
           "given timeout in milliseconds")                                  \
           range(0, max_intx)                                                \
                                                                             \
+  product(intx, TieredCompileQueueRescanInterval, 10, EXPERIMENTAL,         \
+          "Minimum time in milliseconds between updates of the priorities " \
+          "of all tasks in a compile queue. With 0 the priorities are "     \
+          "updated every time a task is taken from the queue")              \
+          range(0, max_intx)                                                \
+                                                                            \
   product(intx, TieredStopAtLevel, 4,                                       \
           "Stop at given compilation level")                                \
           range(0, 4)                                                       \
@@ -318,6 +324,19 @@
           "File containing inlining replay information"                     \
           "[default: ./inline_pid%p.log] (%p replaced with pid)")           \
                                                                             \
+  product(ccstr, DumpMethodProfileFile, nullptr, EXPERIMENTAL,              \
+          "At exit, write the methods compiled at the highest tier to "     \
+          "this file, for use with MethodProfileFile")                      \
+                                                                            \
+  product(ccstr, MethodProfileFile, nullptr, EXPERIMENTAL,                  \
+          "Read the hot methods of a previous run, written with "           \
+          "DumpMethodProfileFile, and compile them early")                  \
+                                                                            \
+  product(double, MethodProfileThresholdScaling, 0.05, EXPERIMENTAL,        \
+          "Factor applied to the compile thresholds of the methods read "   \
+          "from MethodProfileFile")                                         \
+          range(0.0, 1.0)                                                   \
+                                                                            \
   product(intx, ReplaySuppressInitializers, 2, DIAGNOSTIC,                  \
           "Control handling of class initialization during replay: "        \
           "0 - don't do anything special; "                                 \
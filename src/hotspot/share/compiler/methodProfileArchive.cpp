@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "compiler/compilationPolicy.hpp"
+#include "compiler/methodProfileArchive.hpp"
+#include "logging/log.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/instanceKlass.hpp"
+#include "oops/method.hpp"
+#include "runtime/handles.inline.hpp"
+#include "utilities/istream.hpp"
+#include "utilities/ostream.hpp"
+
+MethodProfileArchive::HotMethodTable* MethodProfileArchive::_hot_methods = nullptr;
+fileStream* MethodProfileArchive::_dump_stream = nullptr;
+
+// Splits off the next space separated field of line, or returns null if
+// there is none.
+static char* next_field(char** line) {
+  char* start = *line + strspn(*line, " \t");
+  size_t len = strcspn(start, " \t\r");
+  if (len == 0 || len > (size_t)Symbol::max_length()) {
+    return nullptr;
+  }
+  *line = start + len;
+  if (**line != '\0') {
+    **line = '\0';
+    (*line)++;
+  }
+  return start;
+}
+
+bool MethodProfileArchive::parse_line(char* line, HotMethodTable* table) {
+  char* klass = next_field(&line);
+  char* name = next_field(&line);
+  char* signature = next_field(&line);
+  if (klass == nullptr || name == nullptr || signature == nullptr) {
+    return false;
+  }
+  // The symbols stay referenced by the table for the lifetime of the VM.
+  Key key(SymbolTable::new_symbol(klass),
+          SymbolTable::new_symbol(name),
+          SymbolTable::new_symbol(signature));
+  table->put(key, true);
+  return true;
+}
+
+void MethodProfileArchive::load() {
+  if (MethodProfileFile == nullptr) {
+    return;
+  }
+  FileInput file_input(MethodProfileFile, "rt");
+  if (!file_input.is_open()) {
+    log_warning(jit, compilation)("Could not open method profile file %s", MethodProfileFile);
+    return;
+  }
+  HotMethodTable* table = new (mtCompiler) HotMethodTable(1024, 256 * 1024);
+  for (inputStream input(&file_input); !input.done(); input.next()) {
+    char* line = input.current_line();
+    if (line[0] == '#' || line[0] == '\0') {
+      continue;
+    }
+    if (!parse_line(line, table)) {
+      log_warning(jit, compilation)("Ignoring malformed line %d of method profile file %s",
+                                    (int)input.lineno(), MethodProfileFile);
+    } else {
+      table->maybe_grow();
+    }
+  }
+  log_info(jit, compilation)("Loaded %d hot methods from %s", table->number_of_entries(), MethodProfileFile);
+  Atomic::release_store(&_hot_methods, table);
+}
+
+bool MethodProfileArchive::is_hot(const methodHandle& m) {
+  Key key(m->method_holder()->name(), m->name(), m->signature());
+  return _hot_methods->contains(key);
+}
+
+void MethodProfileArchive::dump_method(Method* m) {
+  InstanceKlass* holder = m->method_holder();
+  if (holder->is_hidden()) {
+    // Hidden class names are not stable across runs.
+    return;
+  }
+  int level = MAX2(m->highest_comp_level(), m->highest_osr_comp_level());
+  if (level < CompilationPolicy::highest_compile_level()) {
+    return;
+  }
+  ResourceMark rm;
+  const char* klass = holder->name()->as_C_string();
+  const char* name = m->name()->as_C_string();
+  const char* signature = m->signature()->as_C_string();
+  // The file format has no quoting for names with spaces.
+  if (strchr(klass, ' ') != nullptr || strchr(name, ' ') != nullptr ||
+      strchr(signature, ' ') != nullptr) {
+    return;
+  }
+  _dump_stream->print_cr("%s %s %s", klass, name, signature);
+}
+
+void MethodProfileArchive::dump_at_exit() {
+  if (DumpMethodProfileFile == nullptr || !UseCompiler ||
+      CompilationPolicy::highest_compile_level() == CompLevel_none) {
+    return;
+  }
+  fileStream stream(DumpMethodProfileFile, "w");
+  if (!stream.is_open()) {
+    log_warning(jit, compilation)("Could not open method profile file %s", DumpMethodProfileFile);
+    return;
+  }
+  stream.print_cr("# Methods compiled at level %d, for use with -XX:MethodProfileFile",
+                  CompilationPolicy::highest_compile_level());
+  _dump_stream = &stream;
+  SystemDictionary::methods_do(dump_method);
+  _dump_stream = nullptr;
+}
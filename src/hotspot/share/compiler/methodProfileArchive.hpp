@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_COMPILER_METHODPROFILEARCHIVE_HPP
+#define SHARE_COMPILER_METHODPROFILEARCHIVE_HPP
+
+#include "compiler/compiler_globals.hpp"
+#include "memory/allStatic.hpp"
+#include "oops/symbol.hpp"
+#include "runtime/atomic.hpp"
+#include "utilities/resizeableResourceHash.hpp"
+
+class fileStream;
+class Method;
+class methodHandle;
+
+// Carries the knowledge of which methods got hot over to the next run of
+// an application, so that its warmup is shorter.
+//
+// With DumpMethodProfileFile, the methods compiled at the highest tier are
+// written to a file at exit, one per line as "klass name signature". With
+// MethodProfileFile, such a file is read at startup and the compile
+// thresholds of the methods listed in it are scaled by
+// MethodProfileThresholdScaling, so they move through the tiers quickly.
+// The profiles themselves are not kept: the methods still pass through a
+// profiled tier, only a much shorter one.
+class MethodProfileArchive : AllStatic {
+  class Key {
+    Symbol* _klass;
+    Symbol* _name;
+    Symbol* _signature;
+
+   public:
+    Key(Symbol* klass, Symbol* name, Symbol* signature) :
+      _klass(klass), _name(name), _signature(signature) {}
+
+    static unsigned hash(const Key& k) {
+      return k._klass->identity_hash() ^ (k._name->identity_hash() * 31) ^ k._signature->identity_hash();
+    }
+    static bool equals(const Key& k1, const Key& k2) {
+      return k1._klass == k2._klass && k1._name == k2._name && k1._signature == k2._signature;
+    }
+  };
+
+  typedef ResizeableResourceHashtable<Key, bool, AnyObj::C_HEAP, mtCompiler,
+                                      Key::hash, Key::equals> HotMethodTable;
+
+  // Written once at startup, read-only afterwards.
+  static HotMethodTable* _hot_methods;
+  static fileStream* _dump_stream;
+
+  static bool parse_line(char* line, HotMethodTable* table);
+  static void dump_method(Method* m);
+  static bool is_hot(const methodHandle& m);
+
+ public:
+  // Read MethodProfileFile, if set.
+  static void load();
+  // Write DumpMethodProfileFile, if set.
+  static void dump_at_exit();
+
+  // The factor to apply to the compile thresholds of method m. This is
+  // 1.0 unless m is listed in MethodProfileFile.
+  static double threshold_scaling(const methodHandle& m) {
+    if (Atomic::load_acquire(&_hot_methods) == nullptr) {
+      return 1.0;
+    }
+    return is_hot(m) ? MethodProfileThresholdScaling : 1.0;
+  }
+};
+
+#endif // SHARE_COMPILER_METHODPROFILEARCHIVE_HPP
@@ -862,6 +862,13 @@ ImmutableOopMapSet* ImmutableOopMapSet::build_from(const OopMapSet* oopmap_set)
   return builder.build();
 }
 
+ImmutableOopMapSet* ImmutableOopMapSet::clone() const {
+  // The set and its maps are a single chunk which only uses offsets internally.
+  address buffer = NEW_C_HEAP_ARRAY(unsigned char, _size, mtCode);
+  memcpy(buffer, (address) this, _size);
+  return (ImmutableOopMapSet*) buffer;
+}
+
 void ImmutableOopMapSet::operator delete(void* p) {
   FREE_C_HEAP_ARRAY(unsigned char, p);
 }
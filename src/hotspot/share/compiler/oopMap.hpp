@@ -349,6 +349,8 @@ class ImmutableOopMapSet {
   ImmutableOopMapPair* get_pairs() const { return (ImmutableOopMapPair*) ((address) this + sizeof(*this)); }
 
   static ImmutableOopMapSet* build_from(const OopMapSet* oopmap_set);
+  // Copy this set for a relocated CodeBlob
+  ImmutableOopMapSet* clone() const;
 
   int find_slot_for_offset(int pc_offset) const;
   const ImmutableOopMap* find_map_at_offset(int pc_offset) const;
@@ -28,16 +28,30 @@
 #include "gc/epsilon/epsilonInitLogger.hpp"
 #include "gc/epsilon/epsilonMemoryPool.hpp"
 #include "gc/epsilon/epsilonThreadLocalData.hpp"
+#include "classfile/classLoaderData.hpp"
+#include "classfile/classLoaderDataGraph.hpp"
+#include "code/codeCache.hpp"
 #include "gc/shared/gcArguments.hpp"
+#include "gc/shared/gcVMOperations.hpp"
 #include "gc/shared/locationPrinter.inline.hpp"
+#include "gc/shared/oopStorageSet.inline.hpp"
+#include "gc/shared/weakProcessor.hpp"
 #include "logging/log.hpp"
 #include "memory/allocation.hpp"
 #include "memory/allocation.inline.hpp"
+#include "memory/iterator.inline.hpp"
 #include "memory/metaspaceUtils.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
+#include "oops/access.inline.hpp"
+#include "oops/compressedOops.inline.hpp"
+#include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/globals.hpp"
+#include "runtime/os.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/threads.hpp"
+#include "runtime/vmThread.hpp"
 
 jint EpsilonHeap::initialize() {
   size_t align = HeapAlignment;
@@ -271,7 +285,106 @@ HeapWord* EpsilonHeap::allocate_loaded_archive_space(size_t size) {
   return allocate_work(size, /* verbose = */false);
 }
 
+// Counts the references to objects at or above the given limit.
+class EpsilonFindReferencesAboveClosure : public BasicOopIterateClosure {
+  HeapWord* const _limit;
+  size_t _found;
+
+  template <class T>
+  void do_oop_work(T* p) {
+    T o = RawAccess<>::oop_load(p);
+    if (!CompressedOops::is_null(o)) {
+      oop obj = CompressedOops::decode_not_null(o);
+      if (cast_from_oop<HeapWord*>(obj) >= _limit) {
+        _found++;
+      }
+    }
+  }
+
+public:
+  EpsilonFindReferencesAboveClosure(HeapWord* limit) : _limit(limit), _found(0) {}
+
+  void do_oop(oop* p)       override { do_oop_work(p); }
+  void do_oop(narrowOop* p) override { do_oop_work(p); }
+
+  size_t found() const { return _found; }
+};
+
+class VM_EpsilonReclaim : public VM_GC_Sync_Operation {
+public:
+  VMOp_Type type() const override { return VMOp_EpsilonReclaim; }
+  void doit() override {
+    EpsilonHeap::heap()->reclaim_since_mark();
+  }
+};
+
+void EpsilonHeap::reclaim_since_mark() {
+  assert(SafepointSynchronize::is_at_safepoint(), "Expected at safepoint");
+
+  // Make the heap parsable, and let all threads start over with new TLABs.
+  ensure_parsability(true);
+
+  HeapWord* const mark = _reclaim_mark;
+  HeapWord* const top = _space->top();
+  _reclaim_mark = top;
+  if (mark == nullptr || mark == top) {
+    return;
+  }
+
+  // Epsilon has no liveness information, so the memory above the mark can only
+  // be reclaimed if no root and no object below the mark refers into it. Weak
+  // roots are treated as strong, as there is nothing to clear them with.
+  EpsilonFindReferencesAboveClosure cl(mark);
+  CLDToOopClosure cld_cl(&cl, ClassLoaderData::_claim_none);
+  ClassLoaderDataGraph::cld_do(&cld_cl);
+  NMethodToOopClosure nm_cl(&cl, false /* fix_relocations */);
+  Threads::oops_do(&cl, nullptr);
+  CodeCache::nmethods_do(&nm_cl);
+  OopStorageSet::strong_oops_do(&cl);
+  WeakProcessor::oops_do(&cl);
+  for (HeapWord* p = _space->bottom(); p < mark; p += cast_to_oop(p)->size()) {
+    cast_to_oop(p)->oop_iterate(&cl);
+  }
+
+  size_t size = pointer_delta(top, mark) * HeapWordSize;
+  if (cl.found() > 0) {
+    log_info(gc)("Retained " SIZE_FORMAT "%s allocated since the last explicit GC, " SIZE_FORMAT " references into it",
+                 byte_size_in_proper_unit(size), proper_unit_for_byte_size(size), cl.found());
+    return;
+  }
+
+  _space->set_top(mark);
+  _reclaim_mark = mark;
+
+  // Uncommit the reclaimed memory, but never shrink below the initial heap size.
+  size_t committed = MAX2(align_up(used(), os::vm_page_size()), align_up(InitialHeapSize, HeapAlignment));
+  if (committed < capacity()) {
+    _virtual_space.shrink_by(capacity() - committed);
+    _space->set_end((HeapWord*) _virtual_space.high());
+  }
+
+  // The counter and printing steps are relative to the previous usage.
+  _last_counter_update = used();
+  _last_heap_print = used();
+
+  log_info(gc)("Reclaimed " SIZE_FORMAT "%s allocated since the last explicit GC",
+               byte_size_in_proper_unit(size), proper_unit_for_byte_size(size));
+  print_heap_info(used());
+}
+
 void EpsilonHeap::collect(GCCause::Cause cause) {
+  if (EpsilonReclaimOnExplicitGC &&
+      (GCCause::is_user_requested_gc(cause) || cause == GCCause::_wb_full_gc)) {
+    if (SafepointSynchronize::is_at_safepoint()) {
+      reclaim_since_mark();
+    } else {
+      VM_EpsilonReclaim op;
+      VMThread::execute(&op);
+    }
+    _monitoring_support->update_counters();
+    return;
+  }
+
   switch (cause) {
     case GCCause::_metadata_GC_threshold:
     case GCCause::_metadata_GC_clear_soft_refs:
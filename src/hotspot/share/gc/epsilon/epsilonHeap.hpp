@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2023, 2024, Oracle and/or its affiliates. All rights reserved.
  * Copyright (c) 2017, 2022, Red Hat, Inc. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
@@ -48,13 +48,17 @@ class EpsilonHeap : public CollectedHeap {
   int64_t _decay_time_ns;
   volatile size_t _last_counter_update;
   volatile size_t _last_heap_print;
+  // Top of the space at the previous explicit GC request, see
+  // EpsilonReclaimOnExplicitGC.
+  HeapWord* _reclaim_mark;
 
 public:
   static EpsilonHeap* heap();
 
   EpsilonHeap() :
           _memory_manager("Epsilon Heap"),
-          _space(nullptr) {};
+          _space(nullptr),
+          _reclaim_mark(nullptr) {};
 
   Name kind() const override {
     return CollectedHeap::Epsilon;
@@ -101,6 +105,10 @@ class EpsilonHeap : public CollectedHeap {
   void collect(GCCause::Cause cause) override;
   void do_full_collection(bool clear_all_soft_refs) override;
 
+  // Reclaims the memory allocated since the previous call, unless anything
+  // still references it. Must be called at a safepoint.
+  void reclaim_since_mark();
+
   // Heap walking support
   void object_iterate(ObjectClosure* cl) override;
 
@@ -85,7 +85,13 @@
   product(size_t, EpsilonMinHeapExpand, 128 * M, EXPERIMENTAL,              \
           "Min expansion step for heap. Larger value improves performance " \
           "at the potential expense of memory waste.")                      \
-          range(1, max_intx)
+          range(1, max_intx)                                                \
+                                                                            \
+  product(bool, EpsilonReclaimOnExplicitGC, false, EXPERIMENTAL,            \
+          "Treat explicit GC requests as quiescent points: the memory "     \
+          "allocated since the previous request is reclaimed and "          \
+          "uncommitted if nothing references it anymore. Otherwise the "    \
+          "memory is retained for good.")
 
 // end of GC_EPSILON_FLAGS
 
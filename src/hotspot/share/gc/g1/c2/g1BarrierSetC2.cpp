@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -317,17 +317,31 @@ bool G1BarrierSetC2::g1_can_remove_post_barrier(GraphKit* kit,
      return false; // No allocation found
   }
 
-  // Start search from Store node
-  Node* mem = store->in(MemNode::Control);
-  if (mem->is_Proj() && mem->in(0)->is_Initialize()) {
-
-    InitializeNode* st_init = mem->in(0)->as_Initialize();
-    AllocateNode*  st_alloc = st_init->allocation();
+  // Start search from Store node and walk up the control chain to the
+  // initialization of the allocation. The store may follow other stores,
+  // null checks or membars, but no node that may safepoint (these include
+  // all calls) and no merge of control flow, so that the object has not
+  // been exposed to a GC since its allocation on every path to the store.
+  Node* ctrl = store->in(MemNode::Control);
+  for (int cnt = 0; cnt < 50 && ctrl != nullptr; cnt++) {
+    if (ctrl->is_Proj() && ctrl->in(0)->is_Initialize()) {
+      InitializeNode* st_init = ctrl->in(0)->as_Initialize();
+      AllocateNode*  st_alloc = st_init->allocation();
+
+      // Make sure we are looking at the same allocation. A different
+      // allocation is a call that may safepoint.
+      return alloc == st_alloc;
+    }
 
-    // Make sure we are looking at the same allocation
-    if (alloc == st_alloc) {
-      return true;
+    Node* n = ctrl->is_Proj() ? ctrl->in(0) : ctrl;
+    if (n == nullptr || n->is_SafePoint() || n->is_Region() || n->is_Start()) {
+      break;
     }
+    if (!n->is_If() && !n->is_MemBar()) {
+      // Unknown control, be conservative.
+      break;
+    }
+    ctrl = n->in(0);
   }
 
   return false;
@@ -352,6 +366,11 @@ void G1BarrierSetC2::g1_mark_card(GraphKit* kit,
   // Smash zero into card. MUST BE ORDERED WRT TO STORE
   __ storeCM(__ ctrl(), card_adr, zero, oop_store, oop_alias_idx, card_bt, Compile::AliasIdxRaw);
 
+  if (G1UseCardTableRefinementSweep) {
+    // Refinement finds the card by sweeping the card table.
+    return;
+  }
+
   //  Now do the queue work
   __ if_then(index, BoolTest::ne, zeroX); {
 
@@ -433,8 +452,13 @@ void G1BarrierSetC2::post_barrier(GraphKit* kit,
   // Now some values
   // Use ctrl to avoid hoisting these values past a safepoint, which could
   // potentially reset these fields in the JavaThread.
-  Node* index  = __ load(__ ctrl(), index_adr, TypeX_X, TypeX_X->basic_type(), Compile::AliasIdxRaw);
-  Node* buffer = __ load(__ ctrl(), buffer_adr, TypeRawPtr::NOTNULL, T_ADDRESS, Compile::AliasIdxRaw);
+  // There is no queue work with G1UseCardTableRefinementSweep.
+  Node* index  = nullptr;
+  Node* buffer = nullptr;
+  if (!G1UseCardTableRefinementSweep) {
+    index  = __ load(__ ctrl(), index_adr, TypeX_X, TypeX_X->basic_type(), Compile::AliasIdxRaw);
+    buffer = __ load(__ ctrl(), buffer_adr, TypeRawPtr::NOTNULL, T_ADDRESS, Compile::AliasIdxRaw);
+  }
 
   // Convert the store obj pointer to an int prior to doing math on it
   // Must use ctrl to prevent "integerized oop" existing across safepoint
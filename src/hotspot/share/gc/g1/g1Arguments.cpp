@@ -175,6 +175,15 @@ void G1Arguments::initialize() {
     FLAG_SET_ERGO(ParallelGCThreads, 1);
   }
 
+#if !defined(X86) && !defined(ZERO)
+  // Only the x86 barriers leave out the dirty card queue enqueue. Elsewhere the
+  // compiled barriers would keep filling their buffers.
+  if (G1UseCardTableRefinementSweep) {
+    log_warning(gc, ergo)("-XX:+G1UseCardTableRefinementSweep is not supported on this platform");
+    FLAG_SET_DEFAULT(G1UseCardTableRefinementSweep, false);
+  }
+#endif
+
   if (!G1UseConcRefinement) {
     if (!FLAG_IS_DEFAULT(G1ConcRefinementThreads)) {
       log_warning(gc, ergo)("Ignoring -XX:G1ConcRefinementThreads "
@@ -96,6 +96,10 @@ void G1BarrierSet::write_ref_field_post_slow(volatile CardValue* byte) {
   OrderAccess::storeload();
   if (*byte != G1CardTable::dirty_card_val()) {
     *byte = G1CardTable::dirty_card_val();
+    if (G1UseCardTableRefinementSweep) {
+      // Refinement finds the card by sweeping the card table.
+      return;
+    }
     Thread* thr = Thread::current();
     G1DirtyCardQueue& queue = G1ThreadLocalData::dirty_card_queue(thr);
     G1BarrierSet::dirty_card_queue_set().enqueue(queue, byte);
@@ -128,7 +132,9 @@ void G1BarrierSet::write_region(JavaThread* thread, MemRegion mr) {
     assert(bv != G1CardTable::g1_young_card_val(), "Invalid card");
     if (bv != G1CardTable::dirty_card_val()) {
       *byte = G1CardTable::dirty_card_val();
-      qset.enqueue(queue, byte);
+      if (!G1UseCardTableRefinementSweep) {
+        qset.enqueue(queue, byte);
+      }
     }
   }
 }
@@ -380,6 +380,7 @@ void G1CardSetHashTableConfig::free_node(void* context, void* memory, Value cons
 
 G1CardSetCoarsenStats G1CardSet::_coarsen_stats;
 G1CardSetCoarsenStats G1CardSet::_last_coarsen_stats;
+size_t G1CardSet::_mem_budget = 0;
 
 G1CardSet::G1CardSet(G1CardSetConfiguration* config, G1CardSetMemoryManager* mm) :
   _mm(mm),
@@ -415,6 +416,12 @@ void G1CardSet::initialize(MemRegion reserved) {
                        BitsInUint + _split_card_shift + G1CardTable::card_shift());
     vm_exit_during_initialization(fmt, "Decrease heap size.");
   }
+
+  _mem_budget = reserved.byte_size() / 100 * G1RemSetMemoryBudgetPercent;
+}
+
+bool G1CardSet::is_over_mem_budget() {
+  return _mem_budget != 0 && G1MonotonicArena::total_segment_mem_size() > _mem_budget;
 }
 
 uint G1CardSet::container_type_to_mem_object_type(uintptr_t type) const {
@@ -602,12 +609,19 @@ G1CardSet::ContainerPtr G1CardSet::create_coarsened_array_of_cards(uint card_in_
 bool G1CardSet::coarsen_container(ContainerPtr volatile* container_addr,
                                   ContainerPtr cur_container,
                                   uint card_in_region,
-                                  bool within_howl) {
+                                  bool within_howl,
+                                  bool* coarsened_to_full) {
   ContainerPtr new_container = nullptr;
 
   switch (container_type(cur_container)) {
     case ContainerArrayOfCards: {
-      new_container = create_coarsened_array_of_cards(card_in_region, within_howl);
+      if (!within_howl && is_over_mem_budget()) {
+        // Do not allocate a Howl container and its bitmaps if card sets already use
+        // more memory than allowed; scanning the whole region is the price.
+        new_container = FullCardSet;
+      } else {
+        new_container = create_coarsened_array_of_cards(card_in_region, within_howl);
+      }
       break;
     }
     case ContainerBitMap: {
@@ -643,6 +657,9 @@ bool G1CardSet::coarsen_container(ContainerPtr volatile* container_addr,
       G1ReleaseCardsets rel(this);
       container_ptr<G1CardSetHowl>(cur_container)->iterate(rel, _config->num_buckets_in_howl());
     }
+    if (coarsened_to_full != nullptr) {
+      *coarsened_to_full = (new_container == FullCardSet);
+    }
     return true;
   } else {
     // Somebody else beat us to coarsening that card set. Exit, but clean up first.
@@ -665,15 +682,17 @@ class G1TransferCard : public StackObj {
   }
 };
 
-void G1CardSet::transfer_cards(G1CardSetHashTableValue* table_entry, ContainerPtr source_container, uint card_region) {
+void G1CardSet::transfer_cards(G1CardSetHashTableValue* table_entry, ContainerPtr source_container, uint card_region,
+                               bool coarsened_to_full) {
   assert(source_container != FullCardSet, "Should not need to transfer from FullCardSet");
   // Need to transfer old entries unless there is a Full card set container in place now, i.e.
-  // the old type has been ContainerBitMap. "Full" contains all elements anyway.
-  if (container_type(source_container) != ContainerHowl) {
+  // the old type has been ContainerHowl, or an ContainerArrayOfCards coarsened directly to
+  // Full due to memory pressure. "Full" contains all elements anyway.
+  if (!coarsened_to_full) {
+    assert(container_type(source_container) != ContainerHowl, "must be");
     G1TransferCard iter(this, card_region);
     iterate_cards_during_transfer(source_container, iter);
   } else {
-    assert(container_type(source_container) == ContainerHowl, "must be");
     // Need to correct for that the Full remembered set occupies more cards than the
     // AoCS before.
     Atomic::add(&_num_occupied, _config->max_cards_in_region() - table_entry->_num_occupied, memory_order_relaxed);
@@ -782,6 +801,7 @@ bool G1CardSet::contains_card(uintptr_t card) {
 G1AddCardResult G1CardSet::add_card(uint card_region, uint card_in_region, bool increment_total) {
   G1AddCardResult add_result;
   ContainerPtr to_transfer = nullptr;
+  bool to_full = false;
   ContainerPtr container;
 
   bool should_grow_table = false;
@@ -794,7 +814,8 @@ G1AddCardResult G1CardSet::add_card(uint card_region, uint card_in_region, bool
       break;
     }
     // Card set has overflown. Coarsen or retry.
-    bool coarsened = coarsen_container(&table_entry->_container, container, card_in_region);
+    bool coarsened = coarsen_container(&table_entry->_container, container, card_in_region,
+                                       false /* within_howl */, &to_full);
     _coarsen_stats.record_coarsening(container_type(container), !coarsened);
     if (coarsened) {
       // We successful coarsened this card set container (and in the process added the card).
@@ -814,7 +835,7 @@ G1AddCardResult G1CardSet::add_card(uint card_region, uint card_in_region, bool
     _table->grow();
   }
   if (to_transfer != nullptr) {
-    transfer_cards(table_entry, to_transfer, card_region);
+    transfer_cards(table_entry, to_transfer, card_region, to_full);
   }
 
   release_and_maybe_free_container(container);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2021, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -187,6 +187,7 @@ class G1CardSet : public CHeapObj<mtGCCardSet> {
   friend class G1CardSetTest;
   friend class G1CardSetMtTestTask;
   friend class G1CheckCardClosure;
+  friend class MicroBenchCardSet;
 
   friend class G1TransferCard;
 
@@ -201,6 +202,10 @@ class G1CardSet : public CHeapObj<mtGCCardSet> {
 
   static G1CardSetCoarsenStats _coarsen_stats; // Coarsening statistics since VM start.
   static G1CardSetCoarsenStats _last_coarsen_stats; // Coarsening statistics before last GC.
+
+  // Native memory budget for all card sets, zero if there is none.
+  static size_t _mem_budget;
+  static bool is_over_mem_budget();
 public:
   // Two lower bits are used to encode the card set container types
   static const uintptr_t ContainerPtrHeaderSize = 2;
@@ -288,16 +293,19 @@ class G1CardSet : public CHeapObj<mtGCCardSet> {
   // coarsen_container does not transfer cards from cur_container
   // to the new container. Transfer is achieved by transfer_cards.
   // Returns true if this was the thread that coarsened the container (and added the card).
+  // If so, coarsened_to_full is set to whether the new container is the Full container.
   bool coarsen_container(ContainerPtr volatile* container_addr,
                          ContainerPtr cur_container,
-                         uint card_in_region, bool within_howl = false);
+                         uint card_in_region, bool within_howl = false,
+                         bool* coarsened_to_full = nullptr);
 
   ContainerPtr create_coarsened_array_of_cards(uint card_in_region, bool within_howl);
 
   // Transfer entries from source_card_set to a recently installed coarser storage type
   // We only need to transfer anything finer than ContainerBitMap. "Full" contains
   // all elements anyway.
-  void transfer_cards(G1CardSetHashTableValue* table_entry, ContainerPtr source_container, uint card_region);
+  void transfer_cards(G1CardSetHashTableValue* table_entry, ContainerPtr source_container, uint card_region,
+                      bool coarsened_to_full);
   void transfer_cards_in_howl(ContainerPtr parent_container, ContainerPtr source_container, uint card_region);
 
   G1AddCardResult add_to_container(ContainerPtr volatile* container_addr, ContainerPtr container, uint card_region, uint card, bool increment_total = true);
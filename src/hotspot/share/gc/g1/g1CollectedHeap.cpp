@@ -69,6 +69,7 @@
 #include "gc/g1/g1RootProcessor.hpp"
 #include "gc/g1/g1SATBMarkQueueSet.hpp"
 #include "gc/g1/g1ServiceThread.hpp"
+#include "gc/g1/g1SoftMaxHeapSizeTask.hpp"
 #include "gc/g1/g1ThreadLocalData.hpp"
 #include "gc/g1/g1Trace.hpp"
 #include "gc/g1/g1UncommitRegionTask.hpp"
@@ -346,14 +347,18 @@ HeapWord* G1CollectedHeap::humongous_obj_allocate(size_t word_size) {
   _verifier->verify_region_sets_optional();
 
   uint obj_regions = (uint) humongous_obj_size_in_regions(word_size);
+  // Prefer regions local to the allocating thread; at a safepoint this is the VM thread,
+  // which does not know about the original requester, so do not ask for a node then.
+  uint node_index = SafepointSynchronize::is_at_safepoint() ? G1NUMA::AnyNodeIndex
+                                                            : _numa->index_of_current_thread();
 
   // Policy: First try to allocate a humongous object in the free list.
-  G1HeapRegion* humongous_start = _hrm.allocate_humongous(obj_regions);
+  G1HeapRegion* humongous_start = _hrm.allocate_humongous(obj_regions, node_index);
   if (humongous_start == nullptr) {
     // Policy: We could not find enough regions for the humongous object in the
     // free list. Look through the heap to find a mix of free and uncommitted regions.
     // If so, expand the heap and allocate the humongous object.
-    humongous_start = _hrm.expand_and_allocate_humongous(obj_regions);
+    humongous_start = _hrm.expand_and_allocate_humongous(obj_regions, node_index);
     if (humongous_start != nullptr) {
       // We managed to find a region by expanding the heap.
       log_debug(gc, ergo, heap)("Heap expansion (humongous allocation request). Allocation request: " SIZE_FORMAT "B",
@@ -1127,6 +1132,7 @@ G1CollectedHeap::G1CollectedHeap() :
   _service_thread(nullptr),
   _periodic_gc_task(nullptr),
   _free_arena_memory_task(nullptr),
+  _soft_max_heap_size_task(nullptr),
   _workers(nullptr),
   _card_table(nullptr),
   _collection_pause_end(Ticks::now()),
@@ -1403,6 +1409,9 @@ jint G1CollectedHeap::initialize() {
   _free_arena_memory_task = new G1MonotonicArenaFreeMemoryTask("Card Set Free Memory Task");
   _service_thread->register_task(_free_arena_memory_task);
 
+  _soft_max_heap_size_task = new G1SoftMaxHeapSizeTask();
+  _service_thread->register_task(_soft_max_heap_size_task);
+
   // Here we allocate the dummy G1HeapRegion that is required by the
   // G1AllocRegion class.
   G1HeapRegion* dummy_region = _hrm.get_dummy_region();
@@ -2034,6 +2043,18 @@ size_t G1CollectedHeap::max_capacity() const {
   return max_regions() * G1HeapRegion::GrainBytes;
 }
 
+size_t G1CollectedHeap::soft_max_capacity() const {
+  // Note that SoftMaxHeapSize is a manageable flag
+  const size_t soft_max_capacity = align_up(Atomic::load(&SoftMaxHeapSize), G1HeapRegion::GrainBytes);
+  return clamp(soft_max_capacity, MinHeapSize, max_capacity());
+}
+
+void G1CollectedHeap::soft_max_heap_size_changed() {
+  if (_soft_max_heap_size_task != nullptr) {
+    _soft_max_heap_size_task->request();
+  }
+}
+
 void G1CollectedHeap::prepare_for_verify() {
   _verifier->prepare_for_verify();
 }
@@ -78,6 +78,7 @@ class G1NewTracer;
 class G1RemSet;
 class G1ServiceTask;
 class G1ServiceThread;
+class G1SoftMaxHeapSizeTask;
 class GCMemoryManager;
 class G1HeapRegion;
 class MemoryPool;
@@ -171,6 +172,7 @@ class G1CollectedHeap : public CollectedHeap {
   G1ServiceThread* _service_thread;
   G1ServiceTask* _periodic_gc_task;
   G1MonotonicArenaFreeMemoryTask* _free_arena_memory_task;
+  G1SoftMaxHeapSizeTask* _soft_max_heap_size_task;
 
   WorkerThreads* _workers;
   G1CardTable* _card_table;
@@ -1189,6 +1191,11 @@ class G1CollectedHeap : public CollectedHeap {
   // Print the maximum heap capacity.
   size_t max_capacity() const override;
 
+  // The capacity the heap sizing tries to stay below, based on
+  // SoftMaxHeapSize.
+  size_t soft_max_capacity() const;
+  void soft_max_heap_size_changed() override;
+
   Tickspan time_since_last_collection() const { return Ticks::now() - _collection_pause_end; }
 
   // Convenience function to be used in situations where the heap type can be
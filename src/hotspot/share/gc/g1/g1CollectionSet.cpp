@@ -346,7 +346,11 @@ void G1CollectionSet::finalize_old_part(double time_remaining_ms) {
     G1CollectionCandidateRegionList pinned_retained_regions;
 
     if (collector_state()->in_mixed_phase()) {
-      time_remaining_ms = _policy->select_candidates_from_marking(&candidates()->marking_regions(),
+      // The remembered sets of the marking candidates keep growing during the
+      // mixed phase, changing their predicted merge and scan cost. Re-sort by
+      // current efficiency so that regions that became expensive move back.
+      candidates()->sort_marking_by_efficiency();
+      time_remaining_ms =_policy->select_candidates_from_marking(&candidates()->marking_regions(),
                                                                   time_remaining_ms,
                                                                   &initial_old_regions,
                                                                   &_optional_old_regions,
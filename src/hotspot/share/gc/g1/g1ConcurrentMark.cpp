@@ -1768,9 +1768,53 @@ class G1PrecleanYieldClosure : public YieldClosure {
   }
 };
 
+// Preclean the discovered reference lists with multiple concurrent workers.
+// Workers claim whole lists, so no list is accessed by more than one thread.
+class G1CMPrecleanTask : public WorkerTask {
+  G1ConcurrentMark* _cm;
+  ReferenceProcessor* _rp;
+  volatile uint _next_list;
+
+public:
+  G1CMPrecleanTask(G1ConcurrentMark* cm, ReferenceProcessor* rp) :
+    WorkerTask("G1 Concurrent Preclean"), _cm(cm), _rp(rp), _next_list(0) { }
+
+  void work(uint worker_id) {
+    SuspendibleThreadSetJoiner sts_join;
+
+    BarrierEnqueueDiscoveredFieldClosure enqueue;
+    G1PrecleanYieldClosure yield_cl(_cm);
+
+    const uint num_lists = _rp->num_discovered_lists();
+    for (uint i = Atomic::fetch_then_add(&_next_list, 1u);
+         i < num_lists;
+         i = Atomic::fetch_then_add(&_next_list, 1u)) {
+      if (yield_cl.should_return() ||
+          _rp->preclean_discovered_list(i, _rp->is_alive_non_header(), &enqueue, &yield_cl)) {
+        return;
+      }
+    }
+  }
+};
+
 void G1ConcurrentMark::preclean() {
   assert(G1UseReferencePrecleaning, "Precleaning must be enabled.");
 
+  ReferenceProcessor* rp = _g1h->ref_processor_cm();
+  // Precleaning only removes references from the discovered lists. Temporarily
+  // disable MT discovery.
+  ReferenceProcessorMTDiscoveryMutator rp_mut_discovery(rp, false);
+
+  // Use the marking workers if reference processing is parallel anyway.
+  const uint num_workers = MIN2(_concurrent_workers->active_workers(), rp->num_discovered_lists());
+  if (ParallelRefProcEnabled && num_workers > 1) {
+    GCTraceTime(Debug, gc, ref) tm("Preclean References", _gc_timer_cm);
+    set_concurrency_and_phase(1, true);
+    G1CMPrecleanTask task(this, rp);
+    _concurrent_workers->run_task(&task, num_workers);
+    return;
+  }
+
   SuspendibleThreadSetJoiner joiner;
 
   BarrierEnqueueDiscoveredFieldClosure enqueue;
@@ -1779,9 +1823,6 @@ void G1ConcurrentMark::preclean() {
 
   G1PrecleanYieldClosure yield_cl(this);
 
-  ReferenceProcessor* rp = _g1h->ref_processor_cm();
-  // Precleaning is single threaded. Temporarily disable MT discovery.
-  ReferenceProcessorMTDiscoveryMutator rp_mut_discovery(rp, false);
   rp->preclean_discovered_references(rp->is_alive_non_header(),
                                      &enqueue,
                                      &yield_cl,
@@ -2480,7 +2521,7 @@ void G1CMTask::print_stats() {
 }
 
 bool G1ConcurrentMark::try_stealing(uint worker_id, G1TaskQueueEntry& task_entry) {
-  return _task_queues->steal(worker_id, task_entry);
+  return _task_queues->steal_batch(worker_id, task_entry);
 }
 
 /*****************************************************************************
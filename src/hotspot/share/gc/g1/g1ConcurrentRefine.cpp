@@ -151,7 +151,8 @@ G1ConcurrentRefine::G1ConcurrentRefine(G1Policy* policy) :
   _needs_adjust(false),
   _threads_needed(policy, adjust_threads_period_ms()),
   _thread_control(G1ConcRefinementThreads),
-  _dcqs(G1BarrierSet::dirty_card_queue_set())
+  _dcqs(G1BarrierSet::dirty_card_queue_set()),
+  _sweep()
 {}
 
 jint G1ConcurrentRefine::initialize() {
@@ -211,6 +212,12 @@ void G1ConcurrentRefine::adjust_after_gc(double logged_cards_time_ms,
                                          double goal_ms) {
   if (!G1UseConcRefinement) return;
 
+  if (G1UseCardTableRefinementSweep) {
+    // The pause has processed all dirty cards, so the current pass, if any,
+    // would only find cards dirtied since.
+    _sweep.start_pass();
+  }
+
   update_pending_cards_target(logged_cards_time_ms,
                               processed_logged_cards,
                               predicted_thread_buffer_cards,
@@ -333,9 +340,16 @@ bool G1ConcurrentRefine::is_in_last_adjustment_period() const {
   return _threads_needed.predicted_time_until_next_gc_ms() <= adjust_threads_period_ms();
 }
 
+size_t G1ConcurrentRefine::num_pending_cards() const {
+  if (G1UseCardTableRefinementSweep) {
+    return _sweep.pending_cards_estimate();
+  }
+  return _dcqs.num_cards();
+}
+
 void G1ConcurrentRefine::adjust_threads_wanted(size_t available_bytes) {
   assert_current_thread_is_primary_refinement_thread();
-  size_t num_cards = _dcqs.num_cards();
+  size_t num_cards = num_pending_cards();
   size_t mutator_threshold = SIZE_MAX;
   uint old_wanted = Atomic::load(&_threads_wanted);
 
@@ -344,6 +358,14 @@ void G1ConcurrentRefine::adjust_threads_wanted(size_t available_bytes) {
                          num_cards,
                          _pending_cards_target);
   uint new_wanted = _threads_needed.threads_needed();
+  if (G1UseCardTableRefinementSweep) {
+    // The estimate of pending cards is only updated by sweeping, so always
+    // let the primary thread do a pass per adjustment period.
+    if (_sweep.is_pass_complete()) {
+      _sweep.start_pass();
+    }
+    new_wanted = MAX2(new_wanted, 1u);
+  }
   if (new_wanted > _thread_control.max_num_threads()) {
     // If running all the threads can't reach goal, turn on refinement by
     // mutator threads.  Using target as the threshold may be stronger
@@ -432,5 +454,10 @@ bool G1ConcurrentRefine::try_refinement_step(uint worker_id,
                                              size_t stop_at,
                                              G1ConcurrentRefineStats* stats) {
   uint adjusted_id = worker_id + worker_id_offset();
+  if (G1UseCardTableRefinementSweep) {
+    // A pass is not cut off at stop_at, as the number of remaining dirty
+    // cards is not known until the pass completes.
+    return _sweep.refine_step(adjusted_id, stats);
+  }
   return _dcqs.refine_completed_buffer_concurrently(adjusted_id, stop_at, stats);
 }
@@ -26,6 +26,7 @@
 #define SHARE_GC_G1_G1CONCURRENTREFINE_HPP
 
 #include "gc/g1/g1ConcurrentRefineStats.hpp"
+#include "gc/g1/g1ConcurrentRefineSweep.hpp"
 #include "gc/g1/g1ConcurrentRefineThreadsNeeded.hpp"
 #include "memory/allocation.hpp"
 #include "utilities/debug.hpp"
@@ -118,6 +119,12 @@ class G1ConcurrentRefine : public CHeapObj<mtGC> {
   G1ConcurrentRefineThreadsNeeded _threads_needed;
   G1ConcurrentRefineThreadControl _thread_control;
   G1DirtyCardQueueSet& _dcqs;
+  // Used instead of the dirty card queues with G1UseCardTableRefinementSweep.
+  G1ConcurrentRefineSweep _sweep;
+
+  // Number of cards waiting for refinement, from the dirty card queues or
+  // estimated from the last card table sweep.
+  size_t num_pending_cards() const;
 
   G1ConcurrentRefine(G1Policy* policy);
 
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1CardTable.inline.hpp"
+#include "gc/g1/g1CollectedHeap.inline.hpp"
+#include "gc/g1/g1ConcurrentRefineStats.hpp"
+#include "gc/g1/g1ConcurrentRefineSweep.hpp"
+#include "gc/g1/g1HeapRegion.inline.hpp"
+#include "gc/g1/g1RemSet.hpp"
+#include "gc/shared/suspendibleThreadSet.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/orderAccess.hpp"
+#include "utilities/ticks.hpp"
+
+// Chunks are the claiming granularity, and also the number of cards cleaned
+// before a single fence, like a buffer of the dirty card queues.
+static const size_t MaxCardsPerChunk = 256;
+
+size_t G1ConcurrentRefineSweep::cards_per_chunk() {
+  return MIN2(MaxCardsPerChunk, G1HeapRegion::CardsPerRegion);
+}
+
+G1ConcurrentRefineSweep::G1ConcurrentRefineSweep() :
+  _next_chunk(0),
+  _num_chunks(0),
+  _dirty_cards(0),
+  _last_pass_dirty_cards(0) { }
+
+void G1ConcurrentRefineSweep::start_pass() {
+  if (is_pass_complete()) {
+    _last_pass_dirty_cards = Atomic::load(&_dirty_cards);
+  }
+  Atomic::store(&_dirty_cards, size_t(0));
+  size_t num_cards = G1CollectedHeap::heap()->max_reserved_regions() * G1HeapRegion::CardsPerRegion;
+  _num_chunks = num_cards / cards_per_chunk();
+  Atomic::release_store(&_next_chunk, size_t(0));
+}
+
+bool G1ConcurrentRefineSweep::is_pass_complete() const {
+  return Atomic::load_acquire(&_next_chunk) >= _num_chunks;
+}
+
+bool G1ConcurrentRefineSweep::refine_cards(G1HeapRegion* r,
+                                           CardValue* start,
+                                           CardValue* end,
+                                           uint worker_id,
+                                           G1ConcurrentRefineStats* stats) {
+  G1RemSet* rem_set = G1CollectedHeap::heap()->rem_set();
+  CardValue* cards[MaxCardsPerChunk];
+  size_t num_found = 0;
+  size_t num_cleaned = 0;
+
+  for (CardValue* card_ptr = start; card_ptr < end; ++card_ptr) {
+    if (*card_ptr != G1CardTable::dirty_card_val()) {
+      continue;
+    }
+    num_found++;
+    // Cleaning re-checks the region's type and top; cards that fail these
+    // checks are left dirty for a later pass or the next GC pause.
+    CardValue* cleaned = card_ptr;
+    if (rem_set->clean_card_before_refine(&cleaned)) {
+      cards[num_cleaned++] = cleaned;
+    }
+  }
+  Atomic::add(&_dirty_cards, num_found);
+  if (num_cleaned == 0) {
+    return true;
+  }
+
+  // See G1RefineBufferedCards::refine() for the reasons for this fence.
+  OrderAccess::fence();
+
+  size_t i = 0;
+  bool result = true;
+  for ( ; i < num_cleaned; ++i) {
+    if (SuspendibleThreadSet::should_yield()) {
+      // Redirty the unrefined cards, leaving them for a later pass or the GC.
+      for (size_t j = i; j < num_cleaned; ++j) {
+        *cards[j] = G1CardTable::dirty_card_val();
+      }
+      result = false;
+      break;
+    }
+    rem_set->refine_card_concurrently(cards[i], worker_id);
+  }
+  stats->inc_refined_cards(i);
+  return result;
+}
+
+bool G1ConcurrentRefineSweep::refine_step(uint worker_id, G1ConcurrentRefineStats* stats) {
+  if (is_pass_complete()) {
+    return false;
+  }
+  size_t chunk = Atomic::fetch_then_add(&_next_chunk, size_t(1));
+  if (chunk >= _num_chunks) {
+    return false;
+  }
+
+  Ticks start_time = Ticks::now();
+
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  size_t const first_card = chunk * cards_per_chunk();
+  uint const region_idx = checked_cast<uint>(first_card >> G1HeapRegion::LogCardsPerRegion);
+  // Only look at the card table of committed regions, as G1 may uncommit
+  // the parts of the card table covering uncommitted regions concurrently.
+  G1HeapRegion* r = g1h->region_at_or_null(region_idx);
+  if (r != nullptr && r->is_old_or_humongous()) {
+    G1CardTable* ct = g1h->card_table();
+    CardValue* start = ct->byte_for_index(first_card);
+    CardValue* end = start + cards_per_chunk();
+    // Cards at or above top can not have been dirtied for this region.
+    HeapWord* top = r->top();
+    if (top <= r->bottom()) {
+      end = start;
+    } else {
+      end = MIN2(end, ct->byte_for(top - 1) + 1);
+    }
+    if (start < end) {
+      refine_cards(r, start, end, worker_id, stats);
+    }
+  }
+
+  stats->inc_refinement_time(Ticks::now() - start_time);
+  return true;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_G1_G1CONCURRENTREFINESWEEP_HPP
+#define SHARE_GC_G1_G1CONCURRENTREFINESWEEP_HPP
+
+#include "gc/g1/g1CardTable.hpp"
+#include "memory/allocation.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class G1ConcurrentRefineStats;
+class G1HeapRegion;
+
+// Concurrent refinement by sweeping the card table, used when
+// G1UseCardTableRefinementSweep is enabled.
+//
+// The post write barrier only dirties cards and does not enqueue them. A
+// sweep pass walks the card table in chunks: refinement threads claim
+// chunks, and clean and refine the dirty cards of old and humongous regions
+// they find there. This uses the same clean-then-scan protocol as refinement
+// of cards taken from the dirty card queues, so a card dirtied again while
+// it is refined will be found by a later pass or by the next GC pause.
+//
+// The GC pause treats all cards still dirty in the card table like cards
+// from the dirty card queues (see G1MergeHeapRootsTask).
+class G1ConcurrentRefineSweep {
+  typedef G1CardTable::CardValue CardValue;
+
+  // Index of the next chunk of the card table to claim in the current pass.
+  volatile size_t _next_chunk;
+  // Number of chunks covering the card table for the current pass.
+  size_t _num_chunks;
+  // Number of dirty cards found in the current and in the last completed pass.
+  volatile size_t _dirty_cards;
+  size_t _last_pass_dirty_cards;
+
+  static size_t cards_per_chunk();
+
+  // Clean the dirty cards in [start, end) of region r and refine them.
+  // Returns false if refinement stopped early because of a pending safepoint.
+  bool refine_cards(G1HeapRegion* r, CardValue* start, CardValue* end,
+                    uint worker_id, G1ConcurrentRefineStats* stats);
+
+public:
+  G1ConcurrentRefineSweep();
+
+  // Start a new pass over the card table, abandoning any current one.
+  void start_pass();
+
+  bool is_pass_complete() const;
+
+  // Number of dirty cards found by the last completed pass. Used as the
+  // estimate of pending cards when controlling the refinement threads.
+  size_t pending_cards_estimate() const { return _last_pass_dirty_cards; }
+
+  // Claim and refine the next chunk of the card table. Returns false if the
+  // current pass is complete and there was nothing left to claim.
+  bool refine_step(uint worker_id, G1ConcurrentRefineStats* stats);
+};
+
+#endif // SHARE_GC_G1_G1CONCURRENTREFINESWEEP_HPP
@@ -28,6 +28,7 @@
 #include "gc/g1/g1GCPhaseTimes.hpp"
 #include "gc/g1/g1ParScanThreadState.inline.hpp"
 #include "gc/shared/gcTimer.hpp"
+#include "gc/shared/gcWorkerTimeline.hpp"
 #include "gc/shared/oopStorage.hpp"
 #include "gc/shared/oopStorageSet.hpp"
 #include "gc/shared/tlab_globals.hpp"
@@ -263,6 +264,26 @@ void G1GCPhaseTimes::record_gc_pause_end() {
 
 #undef ASSERT_PHASE_UNINITIALIZED
 
+double G1GCPhaseTimes::evacuation_parallel_efficiency(uint* num_workers) {
+  uint workers = 0;
+  double busy_time = 0.0;
+  double max_total_time = 0.0;
+  for (uint i = 0; i < _max_gc_threads; i++) {
+    if (_gc_par_phases[GCWorkerStart]->get(i) == WorkerDataArray<double>::uninitialized()) {
+      continue;
+    }
+    const double total_time = worker_time(GCWorkerTotal, i);
+    workers++;
+    busy_time += total_time - worker_time(Termination, i);
+    max_total_time = MAX2(max_total_time, total_time);
+  }
+  *num_workers = workers;
+  if (workers == 0 || max_total_time <= 0.0) {
+    return 1.0;
+  }
+  return busy_time / (workers * max_total_time);
+}
+
 // record the time a phase took in seconds
 void G1GCPhaseTimes::record_time_secs(GCParPhases phase, uint worker_id, double secs) {
   _gc_par_phases[phase]->set(worker_id, secs);
@@ -612,6 +633,7 @@ G1GCParPhaseTimesTracker::G1GCParPhaseTimesTracker(G1GCPhaseTimes* phase_times,
   _start_time(), _phase(phase), _phase_times(phase_times), _worker_id(worker_id), _event(), _allow_multiple_record(allow_multiple_record) {
   if (_phase_times != nullptr) {
     _start_time = Ticks::now();
+    GCWorkerTimeline::begin(G1GCPhaseTimes::phase_name(_phase));
   }
 }
 
@@ -623,6 +645,7 @@ G1GCParPhaseTimesTracker::~G1GCParPhaseTimesTracker() {
       _phase_times->record_time_secs(_phase, _worker_id, (Ticks::now() - _start_time).seconds());
     }
     _event.commit(GCId::current(), _worker_id, G1GCPhaseTimes::phase_name(_phase));
+    GCWorkerTimeline::end(G1GCPhaseTimes::phase_name(_phase));
   }
 }
 
@@ -272,6 +272,12 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   // return the average time for a phase in milliseconds
   double average_time_ms(GCParPhases phase) const;
 
+  // Returns the parallel efficiency of the evacuation of the current pause:
+  // the time of the workers outside termination relative to the number of
+  // workers times the longest worker time. num_workers is set to the number
+  // of workers that took part. Only valid after record_gc_pause_end().
+  double evacuation_parallel_efficiency(uint* num_workers);
+
   size_t sum_thread_work_items(GCParPhases phase, uint index = 0);
 
   void record_pre_evacuate_prepare_time_ms(double ms) {
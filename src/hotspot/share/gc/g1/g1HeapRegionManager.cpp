@@ -118,16 +118,23 @@ G1HeapRegion* HeapRegionManager::allocate_free_region(HeapRegionType type, uint
   return hr;
 }
 
-G1HeapRegion* HeapRegionManager::allocate_humongous_from_free_list(uint num_regions) {
-  uint candidate = find_contiguous_in_free_list(num_regions);
+void HeapRegionManager::update_humongous_statistics(G1HeapRegion* hr, uint requested_node_index) {
+  G1NUMA* numa = G1NUMA::numa();
+  if (hr != nullptr && numa->is_enabled() && hr->node_index() < numa->num_active_nodes()) {
+    numa->update_statistics(G1NUMAStats::HumongousRegionAlloc, requested_node_index, hr->node_index());
+  }
+}
+
+G1HeapRegion* HeapRegionManager::allocate_humongous_from_free_list(uint num_regions, uint requested_node_index) {
+  uint candidate = find_contiguous_in_free_list(num_regions, requested_node_index);
   if (candidate == G1_NO_HRM_INDEX) {
     return nullptr;
   }
   return allocate_free_regions_starting_at(candidate, num_regions);
 }
 
-G1HeapRegion* HeapRegionManager::allocate_humongous_allow_expand(uint num_regions) {
-  uint candidate = find_contiguous_allow_expand(num_regions);
+G1HeapRegion* HeapRegionManager::allocate_humongous_allow_expand(uint num_regions, uint requested_node_index) {
+  uint candidate = find_contiguous_allow_expand(num_regions, requested_node_index);
   if (candidate == G1_NO_HRM_INDEX) {
     return nullptr;
   }
@@ -135,16 +142,22 @@ G1HeapRegion* HeapRegionManager::allocate_humongous_allow_expand(uint num_region
   return allocate_free_regions_starting_at(candidate, num_regions);
 }
 
-G1HeapRegion* HeapRegionManager::allocate_humongous(uint num_regions) {
+G1HeapRegion* HeapRegionManager::allocate_humongous(uint num_regions, uint requested_node_index) {
+  G1HeapRegion* hr;
   // Special case a single region to avoid expensive search.
   if (num_regions == 1) {
-    return allocate_free_region(HeapRegionType::Humongous, G1NUMA::AnyNodeIndex);
+    hr = allocate_free_region(HeapRegionType::Humongous, requested_node_index);
+  } else {
+    hr = allocate_humongous_from_free_list(num_regions, requested_node_index);
   }
-  return allocate_humongous_from_free_list(num_regions);
+  update_humongous_statistics(hr, requested_node_index);
+  return hr;
 }
 
-G1HeapRegion* HeapRegionManager::expand_and_allocate_humongous(uint num_regions) {
-  return allocate_humongous_allow_expand(num_regions);
+G1HeapRegion* HeapRegionManager::expand_and_allocate_humongous(uint num_regions, uint requested_node_index) {
+  G1HeapRegion* hr = allocate_humongous_allow_expand(num_regions, requested_node_index);
+  update_humongous_statistics(hr, requested_node_index);
+  return hr;
 }
 
 #ifdef ASSERT
@@ -439,7 +452,7 @@ void HeapRegionManager::assert_contiguous_range(uint start, uint num_regions) {
 }
 #endif
 
-uint HeapRegionManager::find_contiguous_in_range(uint start, uint end, uint num_regions) {
+uint HeapRegionManager::find_contiguous_in_range(uint start, uint end, uint num_regions, uint requested_node_index) {
   assert(start <= end, "precondition");
   assert(num_regions >= 1, "precondition");
   uint candidate = start;       // First region in candidate sequence.
@@ -458,32 +471,56 @@ uint HeapRegionManager::find_contiguous_in_range(uint start, uint end, uint num_
       } else if (i == unchecked) {
         // All regions of candidate sequence have passed check.
         assert_contiguous_range(candidate, num_regions);
-        return candidate;
+        return prefer_node_in_range(candidate, end, num_regions, requested_node_index);
       }
     }
   }
   return G1_NO_HRM_INDEX;
 }
 
-uint HeapRegionManager::find_contiguous_in_free_list(uint num_regions) {
+uint HeapRegionManager::prefer_node_in_range(uint candidate, uint end, uint num_regions, uint requested_node_index) {
+  G1NUMA* numa = G1NUMA::numa();
+  if (requested_node_index == G1NUMA::AnyNodeIndex || !numa->is_enabled()) {
+    return candidate;
+  }
+
+  // Slide the sequence one region at a time as long as the region becoming
+  // its new last region is empty or uncommitted as well.
+  uint const max_search_depth = numa->max_search_depth();
+  uint start = candidate;
+  for (uint i = 0; i < max_search_depth; i++) {
+    if (numa->preferred_node_index_for_index(start) == requested_node_index) {
+      assert_contiguous_range(start, num_regions);
+      return start;
+    }
+    uint next_last = start + num_regions;
+    if (next_last >= end || (is_available(next_last) && !at(next_last)->is_free())) {
+      break;
+    }
+    start++;
+  }
+  return candidate;
+}
+
+uint HeapRegionManager::find_contiguous_in_free_list(uint num_regions, uint requested_node_index) {
   uint candidate = G1_NO_HRM_INDEX;
   HeapRegionRange range(0,0);
 
   do {
     range = _committed_map.next_active_range(range.end());
-    candidate = find_contiguous_in_range(range.start(), range.end(), num_regions);
+    candidate = find_contiguous_in_range(range.start(), range.end(), num_regions, requested_node_index);
   } while (candidate == G1_NO_HRM_INDEX && range.end() < reserved_length());
 
   return candidate;
 }
 
-uint HeapRegionManager::find_contiguous_allow_expand(uint num_regions) {
+uint HeapRegionManager::find_contiguous_allow_expand(uint num_regions, uint requested_node_index) {
   // Check if we can actually satisfy the allocation.
   if (num_regions > available()) {
     return G1_NO_HRM_INDEX;
   }
   // Find any candidate.
-  return find_contiguous_in_range(0, reserved_length(), num_regions);
+  return find_contiguous_in_range(0, reserved_length(), num_regions, requested_node_index);
 }
 
 G1HeapRegion* HeapRegionManager::next_region_in_heap(const G1HeapRegion* r) const {
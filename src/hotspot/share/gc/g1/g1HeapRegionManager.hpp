@@ -95,14 +95,19 @@ class HeapRegionManager: public CHeapObj<mtGC> {
 
   // Find a contiguous set of empty or uncommitted regions of length num_regions and return
   // the index of the first region or G1_NO_HRM_INDEX if the search was unsuccessful.
-  // Start and end defines the range to seek in, policy is first-fit.
-  uint find_contiguous_in_range(uint start, uint end, uint num_regions);
+  // Start and end defines the range to seek in, policy is first-fit. If a node index is
+  // requested, a sequence starting on that node is preferred, see prefer_node_in_range.
+  uint find_contiguous_in_range(uint start, uint end, uint num_regions, uint requested_node_index);
+  // Starting from the contiguous set of empty or uncommitted regions at candidate, try to
+  // shift the set towards end so that its first region is on the requested node. Only
+  // looks a bounded number of regions ahead; returns candidate if nothing better was found.
+  uint prefer_node_in_range(uint candidate, uint end, uint num_regions, uint requested_node_index);
   // Find a contiguous set of empty regions of length num_regions. Returns the start index
   // of that set, or G1_NO_HRM_INDEX.
-  uint find_contiguous_in_free_list(uint num_regions);
+  uint find_contiguous_in_free_list(uint num_regions, uint requested_node_index);
   // Find a contiguous set of empty or unavailable regions of length num_regions. Returns the
   // start index of that set, or G1_NO_HRM_INDEX.
-  uint find_contiguous_allow_expand(uint num_regions);
+  uint find_contiguous_allow_expand(uint num_regions, uint requested_node_index);
 
   void assert_contiguous_range(uint start, uint num_regions) NOT_DEBUG_RETURN;
 
@@ -141,8 +146,9 @@ class HeapRegionManager: public CHeapObj<mtGC> {
   G1HeapRegion* new_heap_region(uint hrm_index);
 
   // Humongous allocation helpers
-  G1HeapRegion* allocate_humongous_from_free_list(uint num_regions);
-  G1HeapRegion* allocate_humongous_allow_expand(uint num_regions);
+  G1HeapRegion* allocate_humongous_from_free_list(uint num_regions, uint requested_node_index);
+  G1HeapRegion* allocate_humongous_allow_expand(uint num_regions, uint requested_node_index);
+  void update_humongous_statistics(G1HeapRegion* hr, uint requested_node_index);
 
   // Expand helper for cases when the regions to expand are well defined.
   void expand_exact(uint start, uint num_regions, WorkerThreads* pretouch_workers);
@@ -203,11 +209,13 @@ class HeapRegionManager: public CHeapObj<mtGC> {
   // Allocate a free region with specific node index. If fails allocate with next node index.
   G1HeapRegion* allocate_free_region(HeapRegionType type, uint requested_node_index);
 
-  // Allocate a humongous object from the free list
-  G1HeapRegion* allocate_humongous(uint num_regions);
+  // Allocate a humongous object from the free list, preferably starting on the
+  // requested node.
+  G1HeapRegion* allocate_humongous(uint num_regions, uint requested_node_index);
 
-  // Allocate a humongous object by expanding the heap
-  G1HeapRegion* expand_and_allocate_humongous(uint num_regions);
+  // Allocate a humongous object by expanding the heap, preferably starting on the
+  // requested node.
+  G1HeapRegion* expand_and_allocate_humongous(uint num_regions, uint requested_node_index);
 
   inline G1HeapRegion* allocate_free_regions_starting_at(uint first, uint num_regions);
 
@@ -244,6 +244,10 @@ size_t G1HeapSizingPolicy::full_collection_resize_amount(bool& expand) {
   // with respect to the heap max size as it's an upper bound (i.e.,
   // we'll try to make the capacity smaller than it, not greater).
   maximum_desired_capacity =  MAX2(maximum_desired_capacity, MinHeapSize);
+  // Try to stay below SoftMaxHeapSize as long as that leaves the space
+  // required by MinHeapFreeRatio.
+  maximum_desired_capacity = MAX2(MIN2(maximum_desired_capacity, _g1h->soft_max_capacity()),
+                                  minimum_desired_capacity);
 
   // Don't expand unless it's significant; prefer expansion to shrinking.
   if (capacity_after_gc < minimum_desired_capacity) {
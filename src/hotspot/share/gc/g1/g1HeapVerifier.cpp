@@ -290,6 +290,7 @@ class G1VerifyTask: public WorkerTask {
   G1CollectedHeap*  _g1h;
   VerifyOption      _vo;
   bool              _failures;
+  G1RootProcessor   _root_processor;
   HeapRegionClaimer _hrclaimer;
 
 public:
@@ -298,6 +299,7 @@ class G1VerifyTask: public WorkerTask {
       _g1h(g1h),
       _vo(vo),
       _failures(false),
+      _root_processor(g1h, g1h->workers()->active_workers()),
       _hrclaimer(g1h->workers()->active_workers()) {}
 
   bool failures() {
@@ -305,9 +307,20 @@ class G1VerifyTask: public WorkerTask {
   }
 
   void work(uint worker_id) {
+    // We apply the relevant closures to all the oops in the
+    // system dictionary, class loader data graph, the string table
+    // and the nmethods in the code cache. The root processor
+    // distributes the root groups and the thread stacks among
+    // the workers.
+    VerifyRootsClosure roots_cl(_vo);
+    VerifyCLDClosure cld_cl(_g1h, &roots_cl);
+    G1VerifyCodeRootOopClosure code_roots_cl(_g1h, &roots_cl, _vo);
+    G1VerifyCodeRootNMethodClosure blobs_cl(&code_roots_cl);
+    _root_processor.process_all_roots(&roots_cl, &cld_cl, &blobs_cl);
+
     VerifyRegionClosure blk(_vo);
     _g1h->heap_region_par_iterate_from_worker_offset(&blk, &_hrclaimer, worker_id);
-    if (blk.failures()) {
+    if (roots_cl.failures() || code_roots_cl.failures() || blk.failures()) {
       _failures = true;
     }
   }
@@ -330,23 +343,6 @@ void G1HeapVerifier::verify(VerifyOption vo) {
   assert_at_safepoint_on_vm_thread();
   assert(Heap_lock->is_locked(), "heap must be locked");
 
-  log_debug(gc, verify)("Roots");
-  VerifyRootsClosure rootsCl(vo);
-  VerifyCLDClosure cldCl(_g1h, &rootsCl);
-
-  // We apply the relevant closures to all the oops in the
-  // system dictionary, class loader data graph, the string table
-  // and the nmethods in the code cache.
-  G1VerifyCodeRootOopClosure codeRootsCl(_g1h, &rootsCl, vo);
-  G1VerifyCodeRootNMethodClosure blobsCl(&codeRootsCl);
-
-  {
-    G1RootProcessor root_processor(_g1h, 1);
-    root_processor.process_all_roots(&rootsCl, &cldCl, &blobsCl);
-  }
-
-  bool failures = rootsCl.failures() || codeRootsCl.failures();
-
   if (!_g1h->policy()->collector_state()->in_full_gc()) {
     // If we're verifying during a full GC then the region sets
     // will have been torn down at the start of the GC. Therefore
@@ -356,11 +352,11 @@ void G1HeapVerifier::verify(VerifyOption vo) {
     verify_region_sets();
   }
 
-  log_debug(gc, verify)("HeapRegions");
+  log_debug(gc, verify)("Roots and HeapRegions");
 
   G1VerifyTask task(_g1h, vo);
   _g1h->workers()->run_task(&task);
-  if (failures || task.failures()) {
+  if (task.failures()) {
     log_error(gc, verify)("Heap after failed verification (kind %u):",
                           static_cast<std::underlying_type_t<VerifyOption>>(vo));
     // It helps to have the per-region information in the output to
@@ -551,9 +547,27 @@ void G1HeapVerifier::verify_bitmap_clear(bool from_tams) {
       guarantee(mark == r->end(), "Found mark at " PTR_FORMAT " in region %u from start " PTR_FORMAT, p2i(mark), r->hrm_index(), p2i(start));
       return false;
     }
-  } cl(from_tams);
+  };
+
+  class G1VerifyBitmapClearTask : public WorkerTask {
+    HeapRegionClaimer _hrclaimer;
+    bool _from_tams;
+
+  public:
+    G1VerifyBitmapClearTask(uint n_workers, bool from_tams) :
+      WorkerTask("Verify Bitmap Clear"),
+      _hrclaimer(n_workers),
+      _from_tams(from_tams) { }
+
+    void work(uint worker_id) {
+      G1VerifyBitmapClear cl(_from_tams);
+      G1CollectedHeap::heap()->heap_region_par_iterate_from_worker_offset(&cl, &_hrclaimer, worker_id);
+    }
+  };
 
-  G1CollectedHeap::heap()->heap_region_iterate(&cl);
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  G1VerifyBitmapClearTask task(g1h->workers()->active_workers(), from_tams);
+  g1h->workers()->run_task(&task);
 }
 
 #ifndef PRODUCT
@@ -29,6 +29,8 @@
 #include "runtime/vmOperations.hpp"
 #include "utilities/globalCounter.inline.hpp"
 
+volatile size_t G1MonotonicArena::_total_segment_mem_size = 0;
+
 G1MonotonicArena::Segment::Segment(uint slot_size, uint num_slots, Segment* next, MEMFLAGS flag) :
   _slot_size(slot_size),
   _num_slots(num_slots),
@@ -44,6 +46,7 @@ G1MonotonicArena::Segment* G1MonotonicArena::Segment::create_segment(uint slot_s
                                                                      MEMFLAGS mem_flag) {
   size_t block_size = size_in_bytes(slot_size, num_slots);
   char* alloc_block = NEW_C_HEAP_ARRAY(char, block_size, mem_flag);
+  Atomic::add(&_total_segment_mem_size, block_size, memory_order_relaxed);
   return new (alloc_block) Segment(slot_size, num_slots, next, mem_flag);
 }
 
@@ -53,6 +56,7 @@ void G1MonotonicArena::Segment::delete_segment(Segment* segment) {
   if (!VM_Exit::vm_exited()) {
     GlobalCounter::write_synchronize();
   }
+  Atomic::sub(&_total_segment_mem_size, segment->mem_size(), memory_order_relaxed);
   segment->~Segment();
   FREE_C_HEAP_ARRAY(_mem_flag, segment);
 }
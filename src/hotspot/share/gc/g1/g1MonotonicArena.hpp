@@ -76,6 +76,8 @@ class G1MonotonicArena : public FreeListConfig {
   volatile uint _num_total_slots; // Number of slots available in all segments (allocated + not yet used).
   volatile uint _num_allocated_slots; // Number of total slots allocated ever (including free and pending).
 
+  static volatile size_t _total_segment_mem_size; // Memory of all segments in existence, including free ones.
+
   inline Segment* new_segment(Segment* const prev);
 
   DEBUG_ONLY(uint calculate_length() const;)
@@ -102,6 +104,9 @@ class G1MonotonicArena : public FreeListConfig {
 
   uint num_segments() const;
 
+  // Memory of all segments in existence, i.e. in use by any arena or on a free list.
+  static size_t total_segment_mem_size() { return Atomic::load(&_total_segment_mem_size); }
+
   template<typename SegmentClosure>
   void iterate_segments(SegmentClosure& closure) const;
 protected:
@@ -157,6 +157,10 @@ static const char* phase_to_explanatory_string(G1NUMAStats::NodeDataItems phase)
       return "Placement match ratio";
     case G1NUMAStats::LocalObjProcessAtCopyToSurv:
       return "Worker task locality match ratio";
+    case G1NUMAStats::LocalObjProcessAtCopyToOld:
+      return "Worker promotion locality match ratio";
+    case G1NUMAStats::HumongousRegionAlloc:
+      return "Humongous placement match ratio";
     default:
       return "";
   }
@@ -226,5 +230,8 @@ void G1NUMAStats::print_statistics() {
   print_info(NewRegionAlloc);
   print_mutator_alloc_stat_debug();
 
+  print_info(HumongousRegionAlloc);
+
   print_info(LocalObjProcessAtCopyToSurv);
+  print_info(LocalObjProcessAtCopyToOld);
 }
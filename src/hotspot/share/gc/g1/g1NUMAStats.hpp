@@ -87,6 +87,10 @@ class G1NUMAStats : public CHeapObj<mtGC> {
     NewRegionAlloc,
     // Statistics of object processing during copy to survivor region.
     LocalObjProcessAtCopyToSurv,
+    // Statistics of object processing during promotion to old region.
+    LocalObjProcessAtCopyToOld,
+    // Statistics of a new humongous object allocation.
+    HumongousRegionAlloc,
     NodeDataItemsSentinel
   };
 
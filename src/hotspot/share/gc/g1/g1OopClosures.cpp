@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2014, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -49,8 +49,13 @@ void G1CLDScanClosure::do_cld(ClassLoaderData* cld) {
     // Tell the closure that this class loader data is the CLD to scavenge
     // and is the one to dirty if oops are left pointing into the young gen.
     _closure->set_scanned_cld(cld);
-    // Clean modified oops since we're going to scavenge all the metadata.
-    cld->oops_do(_closure, ClassLoaderData::_claim_none, true /*clear_modified_oops*/);
+    if (_process_only_dirty) {
+      // Only scavenge the handles that may refer to the young gen.
+      cld->modified_oops_do(_closure);
+    } else {
+      // Clean modified oops since we're going to scavenge all the metadata.
+      cld->oops_do(_closure, ClassLoaderData::_claim_none, true /*clear_modified_oops*/);
+    }
 
     _closure->set_scanned_cld(nullptr);
 
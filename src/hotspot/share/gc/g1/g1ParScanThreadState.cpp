@@ -86,6 +86,7 @@ G1ParScanThreadState::G1ParScanThreadState(G1CollectedHeap* g1h,
     _max_num_optional_regions(collection_set->optional_region_length()),
     _numa(g1h->numa()),
     _obj_alloc_stat(nullptr),
+    _old_obj_alloc_stat(nullptr),
     ALLOCATION_FAILURE_INJECTOR_ONLY(_allocation_failure_inject_counter(0) COMMA)
     _preserved_marks(preserved_marks),
     _evacuation_failed_info(),
@@ -139,6 +140,7 @@ G1ParScanThreadState::~G1ParScanThreadState() {
   FREE_C_HEAP_ARRAY(size_t, _surviving_young_words_base);
   delete[] _oops_into_optional_regions;
   FREE_C_HEAP_ARRAY(size_t, _obj_alloc_stat);
+  FREE_C_HEAP_ARRAY(size_t, _old_obj_alloc_stat);
 }
 
 size_t G1ParScanThreadState::lab_waste_words() const {
@@ -235,13 +237,20 @@ void G1ParScanThreadState::do_partial_array(PartialArrayScanTask task) {
   assert(to_obj->is_objArray(), "must be obj array");
   objArrayOop to_array = objArrayOop(to_obj);
 
+  const int length = objArrayOop(from_obj)->length();
+  const int chunk_size = _partial_array_stepper.chunk_size(length, _partial_objarray_chunk_size);
   PartialArrayTaskStepper::Step step
     = _partial_array_stepper.next(objArrayOop(from_obj),
                                   to_array,
-                                  _partial_objarray_chunk_size);
+                                  chunk_size);
   for (uint i = 0; i < step._ncreate; ++i) {
     push_on_queue(ScannerTask(PartialArrayScanTask(from_obj)));
   }
+  // The most recently pushed task is likely to be popped by this worker
+  // next, and to claim the chunk following this one.
+  if (step._ncreate > 0) {
+    PartialArrayTaskStepper::prefetch_chunk(to_array, length, step._index + chunk_size, chunk_size);
+  }
 
   G1HeapRegionAttr dest_attr = _g1h->region_attr(to_array);
   G1SkipCardEnqueueSetter x(&_scanner, dest_attr.is_new_survivor());
@@ -250,7 +259,7 @@ void G1ParScanThreadState::do_partial_array(PartialArrayScanTask task) {
   // on start/end.
   to_array->oop_iterate_range(&_scanner,
                               step._index,
-                              step._index + _partial_objarray_chunk_size);
+                              step._index + chunk_size);
 }
 
 MAYBE_INLINE_EVACUATION
@@ -265,10 +274,11 @@ void G1ParScanThreadState::start_partial_objarray(G1HeapRegionAttr dest_attr,
 
   objArrayOop to_array = objArrayOop(to_obj);
 
+  const int length = objArrayOop(from_obj)->length();
   PartialArrayTaskStepper::Step step
     = _partial_array_stepper.start(objArrayOop(from_obj),
                                    to_array,
-                                   _partial_objarray_chunk_size);
+                                   _partial_array_stepper.chunk_size(length, _partial_objarray_chunk_size));
 
   // Push any needed partial scan tasks.  Pushed before processing the
   // initial chunk to allow other workers to steal while we're processing.
@@ -419,7 +429,7 @@ HeapWord* G1ParScanThreadState::allocate_copy_slow(G1HeapRegionAttr* dest_attr,
     }
   }
   if (obj_ptr != nullptr) {
-    update_numa_stats(node_index);
+    update_numa_stats(*dest_attr, node_index);
     if (_g1h->gc_tracer_stw()->should_report_promotion_events()) {
       // The events are checked individually as part of the actual commit
       report_promotion_event(*dest_attr, old, word_sz, age, obj_ptr, node_index);
@@ -685,6 +695,8 @@ void G1ParScanThreadState::initialize_numa_stats() {
       // Record only if there are multiple active nodes.
       _obj_alloc_stat = NEW_C_HEAP_ARRAY(size_t, num_nodes, mtGC);
       memset(_obj_alloc_stat, 0, sizeof(size_t) * num_nodes);
+      _old_obj_alloc_stat = NEW_C_HEAP_ARRAY(size_t, num_nodes, mtGC);
+      memset(_old_obj_alloc_stat, 0, sizeof(size_t) * num_nodes);
     }
   }
 }
@@ -693,12 +705,17 @@ void G1ParScanThreadState::flush_numa_stats() {
   if (_obj_alloc_stat != nullptr) {
     uint node_index = _numa->index_of_current_thread();
     _numa->copy_statistics(G1NUMAStats::LocalObjProcessAtCopyToSurv, node_index, _obj_alloc_stat);
+    _numa->copy_statistics(G1NUMAStats::LocalObjProcessAtCopyToOld, node_index, _old_obj_alloc_stat);
   }
 }
 
-void G1ParScanThreadState::update_numa_stats(uint node_index) {
+void G1ParScanThreadState::update_numa_stats(G1HeapRegionAttr dest_attr, uint node_index) {
   if (_obj_alloc_stat != nullptr) {
-    _obj_alloc_stat[node_index]++;
+    if (dest_attr.is_old()) {
+      _old_obj_alloc_stat[node_index]++;
+    } else {
+      _obj_alloc_stat[node_index]++;
+    }
   }
 }
 
@@ -40,6 +40,7 @@
 #include "gc/g1/g1GCPhaseTimes.hpp"
 #include "gc/g1/g1Policy.hpp"
 #include "gc/g1/g1SurvivorRegions.hpp"
+#include "gc/g1/g1WorkerCountControl.hpp"
 #include "gc/g1/g1YoungGenSizer.hpp"
 #include "gc/shared/concurrentGCBreakpoints.hpp"
 #include "gc/shared/gcPolicyCounters.hpp"
@@ -53,12 +54,13 @@
 #include "gc/shared/gcTraceTime.inline.hpp"
 
 G1Policy::G1Policy(STWGCTimer* gc_timer) :
-  _predictor(G1ConfidencePercent / 100.0),
+  _predictor(G1ConfidencePercent / 100.0, G1PredictionPercentile),
   _analytics(new G1Analytics(&_predictor)),
   _remset_tracker(),
   _mmu_tracker(new G1MMUTracker(GCPauseIntervalMillis / 1000.0, MaxGCPauseMillis / 1000.0)),
   _old_gen_alloc_tracker(),
   _ihop_control(create_ihop_control(&_old_gen_alloc_tracker, &_predictor)),
+  _worker_count_control(G1UseAdaptiveWorkerCount ? new G1WorkerCountControl(ParallelGCThreads) : nullptr),
   _policy_counters(new GCPolicyCounters("GarbageFirst", 1, 2)),
   _full_collection_start_sec(0.0),
   _young_list_desired_length(0),
@@ -86,6 +88,7 @@ G1Policy::G1Policy(STWGCTimer* gc_timer) :
 
 G1Policy::~G1Policy() {
   delete _ihop_control;
+  delete _worker_count_control;
 }
 
 G1CollectorState* G1Policy::collector_state() const { return _g1h->collector_state(); }
@@ -1057,6 +1060,27 @@ void G1Policy::report_ihop_statistics() {
 void G1Policy::record_young_gc_pause_end(bool evacuation_failed) {
   phase_times()->record_gc_pause_end();
   phase_times()->print(evacuation_failed);
+
+  if (_worker_count_control != nullptr) {
+    uint num_workers;
+    double efficiency = phase_times()->evacuation_parallel_efficiency(&num_workers);
+    _worker_count_control->update(num_workers, efficiency);
+  }
+}
+
+uint G1Policy::calc_evacuation_workers(uint active_workers) {
+  if (_worker_count_control == nullptr) {
+    return active_workers;
+  }
+  G1WorkerCountControl::PauseKind kind;
+  if (collector_state()->in_concurrent_start_gc()) {
+    kind = G1WorkerCountControl::ConcurrentStart;
+  } else if (collector_state()->in_young_only_phase()) {
+    kind = G1WorkerCountControl::YoungOnly;
+  } else {
+    kind = G1WorkerCountControl::Mixed;
+  }
+  return MIN2(active_workers, _worker_count_control->limit_for(kind));
 }
 
 double G1Policy::predict_base_time_ms(size_t pending_cards,
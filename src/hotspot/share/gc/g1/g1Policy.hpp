@@ -51,6 +51,7 @@ class G1CollectionSetCandidates;
 class G1CollectionSetChooser;
 class G1CollectionCandidateRegionList;
 class G1IHOPControl;
+class G1WorkerCountControl;
 class G1Analytics;
 class G1SurvivorRegions;
 class GCPolicyCounters;
@@ -75,6 +76,8 @@ class G1Policy: public CHeapObj<mtGC> {
   // two GCs.
   G1OldGenAllocationTracker _old_gen_alloc_tracker;
   G1IHOPControl* _ihop_control;
+  // Limits the evacuation workers, null unless G1UseAdaptiveWorkerCount.
+  G1WorkerCountControl* _worker_count_control;
 
   GCPolicyCounters* _policy_counters;
 
@@ -304,6 +307,10 @@ class G1Policy: public CHeapObj<mtGC> {
   void record_young_gc_pause_start();
   void record_young_gc_pause_end(bool evacuation_failed);
 
+  // Returns the number of workers to use for evacuation in the current
+  // young collection, given that otherwise active_workers would be used.
+  uint calc_evacuation_workers(uint active_workers);
+
   bool need_to_start_conc_mark(const char* source, size_t alloc_word_size = 0);
 
   bool concurrent_operation_is_full_mark(const char* msg = nullptr);
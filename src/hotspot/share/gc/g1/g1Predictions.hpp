@@ -31,6 +31,8 @@
 class G1Predictions {
  private:
   double _sigma;
+  // If non-zero, predictions are at least this percentile of the recent samples.
+  double _percentile;
 
   // This function is used to estimate the stddev of sample sets. There is some
   // special consideration of small sample sets: the actual stddev for them is
@@ -47,15 +49,25 @@ class G1Predictions {
     return estimate;
   }
  public:
-  G1Predictions(double sigma) : _sigma(sigma) {
+  G1Predictions(double sigma, double percentile = 0.0) : _sigma(sigma), _percentile(percentile) {
     assert(sigma >= 0.0, "Confidence must be larger than or equal to zero");
+    assert(percentile >= 0.0 && percentile <= 100.0, "Percentile must be between 0 and 100");
   }
 
   // Confidence factor.
   double sigma() const { return _sigma; }
 
+  double percentile() const { return _percentile; }
+
+  // The average based prediction underestimates sequences with occasional
+  // spikes, so if requested never predict less than the given percentile of
+  // the samples. Small sample sets use the average based estimate only.
   double predict(TruncatedSeq const* seq) const {
-    return seq->davg() + _sigma * stddev_estimate(seq);
+    double prediction = seq->davg() + _sigma * stddev_estimate(seq);
+    if (_percentile > 0.0 && seq->num() >= 5) {
+      prediction = MAX2(prediction, seq->percentile(_percentile));
+    }
+    return prediction;
   }
 
   double predict_in_unit_interval(TruncatedSeq const* seq) const {
@@ -946,6 +946,81 @@ class G1MergeHeapRootsPrefetchCache {
   }
 };
 
+// With G1UseCardTableRefinementSweep the post write barrier does not enqueue
+// dirty cards, so concurrent refinement may have left dirty cards in the card
+// table that are not in any log buffer. Merge them like log buffer cards
+// before the remembered sets of the collection set are merged into the card
+// table, so that only cards actually left by the mutator are counted.
+class G1MergeCardTableTask : public WorkerTask {
+  typedef CardTable::CardValue CardValue;
+
+  class G1MergeCardTableClosure : public HeapRegionClosure {
+    G1RemSetScanState* _scan_state;
+    G1CardTable* _ct;
+    size_t _cards_dirty;
+
+  public:
+    G1MergeCardTableClosure(G1CollectedHeap* g1h, G1RemSetScanState* scan_state) :
+      _scan_state(scan_state),
+      _ct(g1h->card_table()),
+      _cards_dirty(0)
+    {}
+
+    bool do_heap_region(G1HeapRegion* r) override {
+      if (!_scan_state->contains_cards_to_process(r->hrm_index()) ||
+          r->top() == r->bottom()) {
+        return false;
+      }
+      CardValue* cur = _ct->byte_for(r->bottom());
+      CardValue* const end = _ct->byte_for(r->top() - 1) + 1;
+      bool found_dirty = false;
+      while (cur < end) {
+        // Most of the card table is clean, so skip clean words quickly. The
+        // cards of a region start at a word boundary.
+        if (is_aligned(cur, sizeof(size_t)) && (cur + sizeof(size_t)) <= end &&
+            *reinterpret_cast<size_t*>(cur) == G1CardTable::WordAllClean) {
+          cur += sizeof(size_t);
+          continue;
+        }
+        if (*cur == G1CardTable::dirty_card_val()) {
+          found_dirty = true;
+          _scan_state->set_chunk_dirty(_ct->index_for_cardvalue(cur));
+          _cards_dirty++;
+        }
+        cur++;
+      }
+      if (found_dirty) {
+        _scan_state->add_dirty_region(r->hrm_index());
+      }
+      return false;
+    }
+
+    size_t cards_dirty() const { return _cards_dirty; }
+  };
+
+  G1RemSetScanState* _scan_state;
+  HeapRegionClaimer _claimer;
+
+public:
+  G1MergeCardTableTask(G1RemSetScanState* scan_state, uint num_workers) :
+    WorkerTask("G1 Merge Card Table"),
+    _scan_state(scan_state),
+    _claimer(num_workers)
+  {}
+
+  void work(uint worker_id) override {
+    G1CollectedHeap* g1h = G1CollectedHeap::heap();
+    G1GCPhaseTimes* p = g1h->phase_times();
+
+    G1GCParPhaseTimesTracker x(p, G1GCPhaseTimes::MergeLB, worker_id, true /* allow_multiple_record */);
+
+    G1MergeCardTableClosure cl(g1h, _scan_state);
+    g1h->heap_region_par_iterate_from_worker_offset(&cl, &_claimer, worker_id);
+
+    p->record_or_add_thread_work_item(G1GCPhaseTimes::MergeLB, worker_id, cl.cards_dirty(), G1GCPhaseTimes::MergeLBDirtyCards);
+  }
+};
+
 class G1MergeHeapRootsTask : public WorkerTask {
 
   class G1MergeCardSetStats {
@@ -1391,12 +1466,13 @@ class G1MergeHeapRootsTask : public WorkerTask {
     // Now apply the closure to all remaining log entries.
     if (_initial_evacuation) {
       assert(merge_remset_phase == G1GCPhaseTimes::MergeRS, "Wrong merge phase");
-      G1GCParPhaseTimesTracker x(p, G1GCPhaseTimes::MergeLB, worker_id);
+      // G1MergeCardTableTask may already have recorded into this phase.
+      G1GCParPhaseTimesTracker x(p, G1GCPhaseTimes::MergeLB, worker_id, G1UseCardTableRefinementSweep /* allow_multiple_record */);
 
       G1MergeLogBufferCardsClosure cl(g1h, _scan_state);
       apply_closure_to_dirty_card_buffers(&cl, worker_id);
 
-      p->record_thread_work_item(G1GCPhaseTimes::MergeLB, worker_id, cl.cards_dirty(), G1GCPhaseTimes::MergeLBDirtyCards);
+      p->record_or_add_thread_work_item(G1GCPhaseTimes::MergeLB, worker_id, cl.cards_dirty(), G1GCPhaseTimes::MergeLBDirtyCards);
       p->record_thread_work_item(G1GCPhaseTimes::MergeLB, worker_id, cl.cards_skipped(), G1GCPhaseTimes::MergeLBSkippedCards);
     }
   }
@@ -1446,6 +1522,12 @@ void G1RemSet::merge_heap_roots(bool initial_evacuation) {
   uint const num_workers = initial_evacuation ? workers->active_workers() :
                                                 MIN2(workers->active_workers(), (uint)increment_length);
 
+  if (initial_evacuation && G1UseCardTableRefinementSweep) {
+    G1MergeCardTableTask cl(_scan_state, num_workers);
+    log_debug(gc, ergo)("Running %s using %u workers", cl.name(), num_workers);
+    workers->run_task(&cl, num_workers);
+  }
+
   {
     G1MergeHeapRootsTask cl(_scan_state, num_workers, initial_evacuation);
     log_debug(gc, ergo)("Running %s using %u workers for " SIZE_FORMAT " regions",
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -182,9 +182,11 @@ void G1RootProcessor::process_java_roots(G1RootClosures* closures,
                                        closures->strong_nmethods());
   }
 
-  if (_process_strong_tasks.try_claim_task(G1RP_PS_ClassLoaderDataGraph_oops_do)) {
+  // All workers claim CLDs from the graph, so that a large number of
+  // CLDs with modified oops does not serialize on a single worker.
+  {
     G1GCParPhaseTimesTracker x(phase_times, G1GCPhaseTimes::CLDGRoots, worker_id);
-    ClassLoaderDataGraph::roots_cld_do(closures->strong_clds(), closures->weak_clds());
+    _cld_iter.roots_cld_do(closures->strong_clds(), closures->weak_clds());
   }
 }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2021, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,6 +25,7 @@
 #ifndef SHARE_GC_G1_G1ROOTPROCESSOR_HPP
 #define SHARE_GC_G1_G1ROOTPROCESSOR_HPP
 
+#include "classfile/classLoaderDataGraph.hpp"
 #include "gc/shared/oopStorageSetParState.hpp"
 #include "gc/shared/strongRootsScope.hpp"
 #include "memory/allocation.hpp"
@@ -50,9 +51,9 @@ class G1RootProcessor : public StackObj {
   SubTasksDone _process_strong_tasks;
   StrongRootsScope _srs;
   OopStorageSetStrongParState<false, false> _oop_storage_set_strong_par_state;
+  ClassLoaderDataGraphCLDIteratorAtomic _cld_iter;
 
   enum G1H_process_roots_tasks {
-    G1RP_PS_ClassLoaderDataGraph_oops_do,
     G1RP_PS_CodeCache_oops_do,
     G1RP_PS_refProcessor_oops_do,
     // Leave this one last.
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1CollectedHeap.inline.hpp"
+#include "gc/g1/g1ConcurrentMark.inline.hpp"
+#include "gc/g1/g1ConcurrentMarkThread.inline.hpp"
+#include "gc/g1/g1GCCounters.hpp"
+#include "gc/g1/g1SoftMaxHeapSizeTask.hpp"
+#include "gc/shared/suspendibleThreadSet.hpp"
+#include "logging/log.hpp"
+#include "runtime/atomic.hpp"
+
+G1SoftMaxHeapSizeTask::G1SoftMaxHeapSizeTask() :
+  G1ServiceTask("Soft Max Heap Size Task"),
+  // Registering the task schedules it once.
+  _scheduled(true) { }
+
+void G1SoftMaxHeapSizeTask::request() {
+  if (Atomic::cmpxchg(&_scheduled, false, true) == false) {
+    G1CollectedHeap::heap()->service_thread()->schedule_task(this, 0);
+  }
+}
+
+void G1SoftMaxHeapSizeTask::execute() {
+  // Requests from now on need to schedule the task again.
+  Atomic::release_store(&_scheduled, false);
+
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  G1GCCounters counters;
+  {
+    // Ensure no GC safepoints while we're doing the checks, to avoid data races.
+    SuspendibleThreadSetJoiner sts;
+
+    const size_t capacity = g1h->capacity();
+    const size_t soft_max_capacity = g1h->soft_max_capacity();
+    if (capacity <= soft_max_capacity) {
+      return;
+    }
+    // The Remark pause of the current cycle will shrink the heap.
+    if (g1h->concurrent_mark()->cm_thread()->in_progress()) {
+      return;
+    }
+    log_debug(gc, ergo, heap)("Capacity " SIZE_FORMAT "M exceeds the soft max capacity " SIZE_FORMAT "M, "
+                              "requesting concurrent cycle", capacity / M, soft_max_capacity / M);
+    counters = G1GCCounters(g1h);
+  }
+
+  if (!g1h->try_collect(GCCause::_g1_periodic_collection, counters)) {
+    log_debug(gc, ergo, heap)("Concurrent cycle request to shrink the heap denied");
+  }
+}
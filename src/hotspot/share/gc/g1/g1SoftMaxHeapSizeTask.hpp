@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_G1_G1SOFTMAXHEAPSIZETASK_HPP
+#define SHARE_GC_G1_G1SOFTMAXHEAPSIZETASK_HPP
+
+#include "gc/g1/g1ServiceThread.hpp"
+
+// Task starting a concurrent cycle when the heap capacity exceeds the
+// SoftMaxHeapSize after that has been lowered at runtime. The Remark pause
+// of the cycle shrinks the heap towards SoftMaxHeapSize, and the
+// G1UncommitRegionTask then uncommits the memory.
+class G1SoftMaxHeapSizeTask : public G1ServiceTask {
+  // Whether the task is queued on the service thread.
+  volatile bool _scheduled;
+
+public:
+  G1SoftMaxHeapSizeTask();
+
+  // Run the task as soon as possible. Can be called by any thread.
+  void request();
+
+  virtual void execute();
+};
+
+#endif // SHARE_GC_G1_G1SOFTMAXHEAPSIZETASK_HPP
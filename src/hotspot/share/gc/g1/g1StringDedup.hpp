@@ -31,7 +31,8 @@
 // An object is considered a deduplication candidate if all of the following
 // statements are true:
 //
-// - The object is an instance of java.lang.String
+// - The object is an instance of java.lang.String, or of a class with fields
+//   listed in DeduplicateByteArrayFields
 //
 // - The object is being evacuated from a young heap region
 //
@@ -68,7 +69,7 @@ class G1StringDedup : AllStatic {
                                            G1HeapRegionAttr from,
                                            G1HeapRegionAttr to,
                                            uint age) {
-    return StringDedup::is_enabled_string(klass) &&
+    return StringDedup::is_enabled_candidate(klass) &&
            from.is_young() &&
            (to.is_young() ?
             StringDedup::is_threshold_age(age) :
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1WorkerCountControl.hpp"
+#include "gc/shared/gc_globals.hpp"
+#include "logging/log.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+// Weight of the most recent sample in the efficiency average.
+static const double EfficiencySampleWeight = 0.3;
+
+G1WorkerCountControl::G1WorkerCountControl(uint max_workers) :
+  _max_workers(max_workers),
+  _current_kind(YoungOnly)
+{
+  for (uint i = 0; i < NumPauseKinds; i++) {
+    _states[i]._limit = max_workers;
+    _states[i]._efficiency = -1.0;
+  }
+}
+
+const char* G1WorkerCountControl::to_string(PauseKind kind) {
+  switch (kind) {
+    case YoungOnly:       return "Young";
+    case ConcurrentStart: return "Concurrent Start";
+    case Mixed:           return "Mixed";
+    default:              ShouldNotReachHere(); return nullptr;
+  }
+}
+
+uint G1WorkerCountControl::limit_for(PauseKind kind) {
+  _current_kind = kind;
+  return _states[kind]._limit;
+}
+
+void G1WorkerCountControl::update(uint num_workers, double efficiency) {
+  if (num_workers < 2) {
+    // Nothing to learn from a single worker.
+    return;
+  }
+  State* const state = &_states[_current_kind];
+  if (state->_efficiency < 0.0) {
+    state->_efficiency = efficiency;
+  } else {
+    state->_efficiency = (1.0 - EfficiencySampleWeight) * state->_efficiency +
+                         EfficiencySampleWeight * efficiency;
+  }
+
+  const uint old_limit = state->_limit;
+  const double low = G1WorkerEfficiencyLowPercent / 100.0;
+  const double high = G1WorkerEfficiencyHighPercent / 100.0;
+  uint new_limit = old_limit;
+  if (state->_efficiency < low) {
+    // Decrease from the number of workers actually used, which may already
+    // be below the limit.
+    new_limit = MAX2(2u, num_workers - MAX2(1u, num_workers / 4));
+  } else if (state->_efficiency > high && num_workers == old_limit) {
+    // Only increase if the limit was what held the number of workers back.
+    new_limit = MIN2(_max_workers, old_limit + MAX2(1u, old_limit / 4));
+  }
+
+  log_debug(gc, task)("%s pause evacuation parallel efficiency %.1f%% with %u workers, average %.1f%%",
+                      to_string(_current_kind), efficiency * 100.0, num_workers, state->_efficiency * 100.0);
+  if (new_limit != old_limit) {
+    log_info(gc, task)("%s pause evacuation worker limit %u -> %u (parallel efficiency %.1f%%)",
+                       to_string(_current_kind), old_limit, new_limit, state->_efficiency * 100.0);
+    state->_limit = new_limit;
+    // Start over measuring with the new limit.
+    state->_efficiency = -1.0;
+  }
+}
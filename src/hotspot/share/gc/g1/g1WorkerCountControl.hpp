@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef SHARE_GC_G1_G1WORKERCOUNTCONTROL_HPP
+#define SHARE_GC_G1_G1WORKERCOUNTCONTROL_HPP
+
+#include "memory/allocation.hpp"
+
+// Limits the number of workers used for evacuation in young collections by
+// the parallel efficiency measured in the previous pauses of the same kind.
+//
+// The parallel efficiency of a pause is the time the workers spent outside
+// of termination divided by the number of workers times the longest worker
+// time. With many workers on a busy or small host the workers spend a lot of
+// time stealing and terminating, or start late, and a pause with fewer
+// workers takes as long or less. The control lowers the limit when the
+// decaying average of the efficiency is below G1WorkerEfficiencyLowPercent
+// and raises it again when the average is above
+// G1WorkerEfficiencyHighPercent.
+class G1WorkerCountControl : public CHeapObj<mtGC> {
+public:
+  enum PauseKind {
+    YoungOnly,
+    ConcurrentStart,
+    Mixed,
+    NumPauseKinds
+  };
+
+private:
+  struct State {
+    uint _limit;
+    // Decaying average of the efficiency with the current limit, negative
+    // if there are no samples yet.
+    double _efficiency;
+  };
+
+  const uint _max_workers;
+  State _states[NumPauseKinds];
+  // The kind of the current pause, set when the workers are selected.
+  PauseKind _current_kind;
+
+  static const char* to_string(PauseKind kind);
+
+public:
+  G1WorkerCountControl(uint max_workers);
+
+  // Returns the number of workers to use at most for evacuation in the
+  // current pause, which is of the given kind.
+  uint limit_for(PauseKind kind);
+
+  // Updates the limit for the kind of the current pause, in which
+  // num_workers workers evacuated with the given parallel efficiency.
+  void update(uint num_workers, double efficiency);
+};
+
+#endif // SHARE_GC_G1_G1WORKERCOUNTCONTROL_HPP
@@ -32,7 +32,7 @@
 #include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1CollectionSetCandidates.inline.hpp"
 #include "gc/g1/g1CollectorState.hpp"
-#include "gc/g1/g1ConcurrentMark.hpp"
+#include "gc/g1/g1ConcurrentMark.inline.hpp"
 #include "gc/g1/g1GCPhaseTimes.hpp"
 #include "gc/g1/g1EvacFailureRegions.inline.hpp"
 #include "gc/g1/g1EvacInfo.hpp"
@@ -52,6 +52,7 @@
 #include "gc/shared/concurrentGCBreakpoints.hpp"
 #include "gc/shared/gcTraceTime.inline.hpp"
 #include "gc/shared/gcTimer.hpp"
+#include "gc/shared/gcWorkerTimeline.hpp"
 #include "gc/shared/gc_globals.hpp"
 #include "gc/shared/preservedMarks.hpp"
 #include "gc/shared/referenceProcessor.hpp"
@@ -323,6 +324,11 @@ class G1PrepareEvacuationTask : public WorkerTask {
       if (region->has_pinned_objects()) {
         return false;
       }
+      // We don't nominate objects with many remembered set entries, on
+      // the assumption that such objects are likely still live.
+      if (!_g1h->is_potential_eager_reclaim_candidate(region)) {
+        return false;
+      }
       // Candidate selection must satisfy the following constraints
       // while concurrent marking is in progress:
       //
@@ -344,12 +350,7 @@ class G1PrepareEvacuationTask : public WorkerTask {
       // structures don't support efficiently performing the needed
       // additional tests or scrubbing of the mark stack.
       //
-      // However, we presently only nominate is_typeArray() objects.
-      // A humongous object containing references induces remembered
-      // set entries on other regions.  In order to reclaim such an
-      // object, those remembered sets would need to be cleaned up.
-      //
-      // We also treat is_typeArray() objects specially, allowing them
+      // We treat is_typeArray() objects specially, allowing them
       // to be reclaimed even if allocated before the start of
       // concurrent mark.  For this we rely on mark stack insertion to
       // exclude is_typeArray() objects, preventing reclaiming an object
@@ -358,9 +359,17 @@ class G1PrepareEvacuationTask : public WorkerTask {
       // Frequent allocation and drop of large binary blobs is an
       // important use case for eager reclaim, and this special handling
       // may reduce needed headroom.
+      if (obj->is_typeArray()) {
+        return true;
+      }
 
-      return obj->is_typeArray() &&
-             _g1h->is_potential_eager_reclaim_candidate(region);
+      // A humongous object array induces remembered set entries on the
+      // regions it references.  These entries become stale when the object
+      // is reclaimed, just like the ones of any freed old region, which
+      // remembered set scanning already copes with.
+      return obj->is_objArray() &&
+             (!_g1h->collector_state()->mark_or_rebuild_in_progress() ||
+              _g1h->concurrent_mark()->top_at_mark_start(region) == region->bottom());
     }
 
   public:
@@ -471,6 +480,7 @@ void G1YoungCollector::set_young_collection_default_active_worker_threads(){
   uint active_workers = WorkerPolicy::calc_active_workers(workers()->max_workers(),
                                                           workers()->active_workers(),
                                                           Threads::number_of_non_daemon_threads());
+  active_workers = policy()->calc_evacuation_workers(active_workers);
   active_workers = workers()->set_active_workers(active_workers);
   log_info(gc,task)("Using %u workers of %u for evacuation", active_workers, workers()->max_workers());
 }
@@ -574,6 +584,7 @@ class G1ParEvacuateFollowersClosure : public VoidClosure {
     event.commit(GCId::current(), pss->worker_id(), G1GCPhaseTimes::phase_name(_phase));
     do {
       EventGCPhaseParallel event;
+      GCWorkerTimelineMark timeline_mark("Steal");
       pss->steal_and_trim_queue(queues());
       event.commit(GCId::current(), pss->worker_id(), G1GCPhaseTimes::phase_name(_phase));
     } while (!offer_termination());
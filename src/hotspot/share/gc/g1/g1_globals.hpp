@@ -114,6 +114,12 @@
           "Confidence level for MMU/pause predictions")                     \
           range(0, 100)                                                     \
                                                                             \
+  product(uint, G1PredictionPercentile, 0,                                  \
+          "If non-zero, MMU/pause predictions are at least this percentile "\
+          "of the recent samples. Use for pause time goals that have to "   \
+          "hold for the tail of the pause distribution")                    \
+          range(0, 100)                                                     \
+                                                                            \
   product(uintx, G1SummarizeRSetStatsPeriod, 0, DIAGNOSTIC,                 \
           "The period (in number of GCs) at which we will generate "        \
           "update buffer processing info "                                  \
@@ -174,6 +180,11 @@
           "Control whether concurrent refinement is performed. "            \
           "Disabling effectively ignores G1RSetUpdatingPauseTimePercent")   \
                                                                             \
+  product(bool, G1UseCardTableRefinementSweep, false, EXPERIMENTAL,         \
+          "Find the cards to refine by sweeping the card table instead "    \
+          "of using dirty card queues. The post write barrier then only "   \
+          "dirties the card.")                                              \
+                                                                            \
   develop(uint, G1RemSetArrayOfCardsEntriesBase, 8,                         \
           "Maximum number of entries per region in the Array of Cards "     \
           "card set container per MB of a heap region.")                    \
@@ -209,6 +220,13 @@
           "set container.")                                                 \
           range(1, 100)                                                     \
                                                                             \
+  product(uint, G1RemSetMemoryBudgetPercent, 0, EXPERIMENTAL,               \
+          "Native memory budget for remembered sets in percent of the "     \
+          "maximum heap size. Beyond it, Array of Cards card set "          \
+          "containers are coarsened to Full card set containers directly "  \
+          "instead of to Howl containers. Zero means no budget.")           \
+          range(0, 100)                                                     \
+                                                                            \
   develop(size_t, G1MaxVerifyFailures, SIZE_MAX,                            \
           "The maximum number of liveness and remembered set verification " \
           "failures to print per thread.")                                  \
@@ -276,6 +294,21 @@
           "as a percentage of the heap size.")                              \
           range(0, 100)                                                     \
                                                                             \
+  product(bool, G1UseAdaptiveWorkerCount, false, EXPERIMENTAL,              \
+          "Limit the number of workers for evacuation in young "            \
+          "collections by the parallel efficiency measured in previous "    \
+          "pauses of the same kind.")                                       \
+                                                                            \
+  product(uint, G1WorkerEfficiencyLowPercent, 60, EXPERIMENTAL,             \
+          "Parallel efficiency of evacuation below which "                  \
+          "G1UseAdaptiveWorkerCount uses fewer workers.")                   \
+          range(0, 100)                                                     \
+                                                                            \
+  product(uint, G1WorkerEfficiencyHighPercent, 85, EXPERIMENTAL,            \
+          "Parallel efficiency of evacuation above which "                  \
+          "G1UseAdaptiveWorkerCount allows more workers again.")            \
+          range(0, 100)                                                     \
+                                                                            \
   product(bool, G1VerifyHeapRegionCodeRoots, false, DIAGNOSTIC,             \
           "Verify the code root lists attached to each heap region.")       \
                                                                             \
@@ -257,6 +257,7 @@ class ParallelScavengeHeap : public CollectedHeap {
 
   void pin_object(JavaThread* thread, oop obj) override;
   void unpin_object(JavaThread* thread, oop obj) override;
+  bool pin_object_blocks_gc() const override { return true; }
 };
 
 // Class that can be used to print information about the
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -130,8 +130,8 @@ class PSScavengeCLDClosure: public CLDClosure {
       // if references are left in the young gen.
       _oop_closure.set_scanned_cld(cld);
 
-      // Clean the cld since we're going to scavenge all the metadata.
-      cld->oops_do(&_oop_closure, ClassLoaderData::_claim_none, /*clear_modified_oops*/true);
+      // Only scavenge the handles that may refer to the young gen.
+      cld->modified_oops_do(&_oop_closure);
 
       _oop_closure.set_scanned_cld(nullptr);
     }
@@ -66,7 +66,7 @@ class PCIterateMarkAndPushClosure: public ClaimMetadataVisitingOopIterateClosure
 };
 
 inline bool ParCompactionManager::steal(int queue_num, oop& t) {
-  return oop_task_queues()->steal(queue_num, t);
+  return oop_task_queues()->steal_batch(queue_num, t);
 }
 
 inline bool ParCompactionManager::steal_objarray(int queue_num, ObjArrayTask& t) {
@@ -55,6 +55,7 @@
 #include "gc/shared/oopStorage.inline.hpp"
 #include "gc/shared/oopStorageSet.inline.hpp"
 #include "gc/shared/oopStorageSetParState.inline.hpp"
+#include "gc/shared/parallelCleaning.hpp"
 #include "gc/shared/preservedMarks.inline.hpp"
 #include "gc/shared/referencePolicy.hpp"
 #include "gc/shared/referenceProcessor.hpp"
@@ -851,6 +852,132 @@ bool PSParallelCompact::reassess_maximum_compaction(bool maximum_compaction,
   return false;
 }
 
+// Summarizes the part of the old space after the dense prefix in parallel.
+// The old space is compacted into itself, so no region is ever split and the
+// destination of a region only depends on the amount of live data below it.
+// The regions are divided into chunks; the first pass computes the live words
+// of every chunk, the destination of each chunk is then the prefix sum of the
+// live words of the previous chunks, and the second pass summarizes all
+// chunks independently.
+class PSSummarizeOldSpaceTask : public WorkerTask {
+  // Chunks are kept large so that claiming is cheap relative to the work.
+  static const size_t MinRegionsPerChunk = 1024;
+  static const uint ChunksPerWorker = 4;
+
+  ParallelCompactData& _sd;
+  SplitInfo& _split_info;
+  const size_t _beg_region;
+  const size_t _end_region;
+  HeapWord* const _space_end;
+
+  size_t _num_chunks;
+  size_t _regions_per_chunk;
+  // Live words of each chunk after the first pass, replaced by the
+  // destination offset of each chunk before the second pass.
+  size_t* _chunk_words;
+
+  bool _second_pass;
+  volatile size_t _claimed_chunks;
+
+  void chunk_bounds(size_t chunk, size_t& beg, size_t& end) const {
+    beg = MIN2(_beg_region + chunk * _regions_per_chunk, _end_region);
+    end = MIN2(beg + _regions_per_chunk, _end_region);
+  }
+
+  size_t live_words_in_chunk(size_t chunk) const {
+    size_t beg, end;
+    chunk_bounds(chunk, beg, end);
+    size_t words = 0;
+    for (size_t cur = beg; cur < end; ++cur) {
+      words += _sd.region(cur)->data_size();
+    }
+    return words;
+  }
+
+  void summarize_chunk(size_t chunk) {
+    size_t beg, end;
+    chunk_bounds(chunk, beg, end);
+    HeapWord* const dest = _sd.region_to_addr(_beg_region) + _chunk_words[chunk];
+    HeapWord* next = nullptr;
+    bool done = _sd.summarize(_split_info,
+                              _sd.region_to_addr(beg), _sd.region_to_addr(end), nullptr,
+                              dest, _space_end, &next);
+    assert(done, "old space must fit into itself");
+  }
+
+public:
+  PSSummarizeOldSpaceTask(SplitInfo& split_info, HeapWord* beg, HeapWord* top,
+                          HeapWord* space_end, uint num_workers) :
+      WorkerTask("PSSummarizeOldSpaceTask"),
+      _sd(PSParallelCompact::summary_data()),
+      _split_info(split_info),
+      _beg_region(_sd.addr_to_region_idx(beg)),
+      _end_region(_sd.addr_to_region_idx(_sd.region_align_up(top))),
+      _space_end(space_end),
+      _num_chunks(0),
+      _regions_per_chunk(0),
+      _chunk_words(nullptr),
+      _second_pass(false),
+      _claimed_chunks(0) {
+    const size_t num_regions = _end_region - _beg_region;
+    _num_chunks = clamp(num_regions / MinRegionsPerChunk, (size_t)1, (size_t)num_workers * ChunksPerWorker);
+    _regions_per_chunk = (num_regions + _num_chunks - 1) / _num_chunks;
+    _chunk_words = NEW_C_HEAP_ARRAY(size_t, _num_chunks, mtGC);
+  }
+
+  ~PSSummarizeOldSpaceTask() {
+    FREE_C_HEAP_ARRAY(size_t, _chunk_words);
+  }
+
+  size_t num_chunks() const { return _num_chunks; }
+
+  // Turns the live words of the chunks into destination offsets and returns
+  // the total number of live words.
+  size_t prepare_second_pass() {
+    size_t offset = 0;
+    for (size_t i = 0; i < _num_chunks; ++i) {
+      size_t words = _chunk_words[i];
+      _chunk_words[i] = offset;
+      offset += words;
+    }
+    _second_pass = true;
+    _claimed_chunks = 0;
+    return offset;
+  }
+
+  virtual void work(uint worker_id) {
+    size_t chunk;
+    while ((chunk = Atomic::fetch_then_add(&_claimed_chunks, (size_t)1)) < _num_chunks) {
+      if (_second_pass) {
+        summarize_chunk(chunk);
+      } else {
+        _chunk_words[chunk] = live_words_in_chunk(chunk);
+      }
+    }
+  }
+};
+
+void PSParallelCompact::summarize_old_space(HeapWord* dense_prefix_end) {
+  MutableSpace* const old_space = _space_info[old_space_id].space();
+  SplitInfo& split_info = _space_info[old_space_id].split_info();
+  WorkerThreads& workers = ParallelScavengeHeap::heap()->workers();
+
+  PSSummarizeOldSpaceTask task(split_info, dense_prefix_end, old_space->top(),
+                               old_space->end(), workers.active_workers());
+  if (task.num_chunks() == 1) {
+    _summary_data.summarize(split_info,
+                            dense_prefix_end, old_space->top(), nullptr,
+                            dense_prefix_end, old_space->end(),
+                            _space_info[old_space_id].new_top_addr());
+    return;
+  }
+
+  workers.run_task(&task);
+  size_t live_words = task.prepare_second_pass();
+  workers.run_task(&task);
+  _space_info[old_space_id].set_new_top(dense_prefix_end + live_words);
+}
+
 void PSParallelCompact::summary_phase(bool maximum_compaction)
 {
   GCTraceTime(Info, gc, phases) tm("Summary Phase", &_gc_timer);
@@ -889,10 +1016,7 @@ void PSParallelCompact::summary_phase(bool maximum_compaction)
       fill_dense_prefix_end(id);
       _summary_data.summarize_dense_prefix(old_space->bottom(), dense_prefix_end);
     }
-    _summary_data.summarize(_space_info[id].split_info(),
-                            dense_prefix_end, old_space->top(), nullptr,
-                            dense_prefix_end, old_space->end(),
-                            _space_info[id].new_top_addr());
+    summarize_old_space(dense_prefix_end);
   }
 
   // Summarize the remaining spaces in the young gen.  The initial target space
@@ -1035,7 +1159,7 @@ bool PSParallelCompact::invoke_no_policy(bool maximum_heap_compaction) {
 
     ref_processor()->start_discovery(maximum_heap_compaction);
 
-    ClassUnloadingContext ctx(1 /* num_nmethod_unlink_workers */,
+    ClassUnloadingContext ctx(ParallelScavengeHeap::heap()->workers().active_workers(),
                               false /* unregister_nmethods_during_purge */,
                               false /* lock_nmethod_free_separately */);
 
@@ -1278,6 +1402,31 @@ class ParallelCompactRefProcProxyTask : public RefProcProxyTask {
   }
 };
 
+// Unloads nmethods and cleans the weak klass links of the remaining classes
+// with all workers.
+class PSParallelCleaningTask : public WorkerTask {
+  bool                   _unloading_occurred;
+  CodeCacheUnloadingTask _code_cache_task;
+  KlassCleaningTask      _klass_cleaning_task;
+
+public:
+  PSParallelCleaningTask(uint num_workers, bool unloading_occurred) :
+    WorkerTask("PS Parallel Cleaning"),
+    _unloading_occurred(unloading_occurred),
+    _code_cache_task(num_workers, unloading_occurred),
+    _klass_cleaning_task() { }
+
+  void work(uint worker_id) {
+    _code_cache_task.work(worker_id);
+
+    // The weak metadata in klass doesn't need to be
+    // processed if there was no unloading.
+    if (_unloading_occurred) {
+      _klass_cleaning_task.work();
+    }
+  }
+};
+
 static void flush_marking_stats_cache(const uint num_workers) {
   for (uint i = 0; i < num_workers; ++i) {
     ParCompactionManager* cm = ParCompactionManager::gc_thread_compaction_manager(i);
@@ -1343,8 +1492,10 @@ void PSParallelCompact::marking_phase(ParallelOldTracer *gc_tracer) {
       // Follow system dictionary roots and unload classes.
       unloading_occurred = SystemDictionary::do_unloading(&_gc_timer);
 
-      // Unload nmethods.
-      CodeCache::do_unloading(unloading_occurred);
+      // Unload nmethods and prune dead klasses from subklass/sibling/implementor lists.
+      GCTraceTime(Debug, gc, phases) t("Parallel Cleaning", gc_timer());
+      PSParallelCleaningTask task(active_gc_threads, unloading_occurred);
+      ParallelScavengeHeap::heap()->workers().run_task(&task);
     }
 
     {
@@ -1361,9 +1512,6 @@ void PSParallelCompact::marking_phase(ParallelOldTracer *gc_tracer) {
       ctx->free_nmethods();
     }
 
-    // Prune dead klasses from subklass/sibling/implementor lists.
-    Klass::clean_weak_klass_links(unloading_occurred);
-
     // Clean JVMCI metadata handles.
     JVMCI_ONLY(JVMCI::do_unloading(unloading_occurred));
   }
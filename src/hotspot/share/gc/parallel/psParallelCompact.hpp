@@ -739,6 +739,10 @@ class PSParallelCompact : AllStatic {
   // make the heap parsable.
   static void fill_dense_prefix_end(SpaceId id);
 
+  // Summarize the old space after the dense prefix, using the workers if the
+  // space is large enough.
+  static void summarize_old_space(HeapWord* dense_prefix_end);
+
   static void summary_phase(bool maximum_compaction);
 
   static void adjust_pointers();
@@ -125,6 +125,8 @@ class PSPromotionManager {
   static PSPromotionManager* vm_thread_promotion_manager();
 
   static bool steal_depth(int queue_num, ScannerTask& t);
+  // Records the NUMA node the current worker thread runs on for stealing.
+  static void record_numa_id(uint queue_num);
 
   PSPromotionManager();
 
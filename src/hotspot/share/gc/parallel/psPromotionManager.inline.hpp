@@ -41,6 +41,7 @@
 #include "oops/access.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
 #include "runtime/prefetch.inline.hpp"
 #include "utilities/copy.hpp"
 
@@ -339,6 +340,12 @@ inline bool PSPromotionManager::steal_depth(int queue_num, ScannerTask& t) {
   return stack_array_depth()->steal(queue_num, t);
 }
 
+inline void PSPromotionManager::record_numa_id(uint queue_num) {
+  if (UseNUMA && UseNUMAAwareStealing) {
+    stack_array_depth()->set_numa_id(queue_num, os::numa_get_group_id());
+  }
+}
+
 #if TASKQUEUE_STATS
 void PSPromotionManager::record_steal(ScannerTask task) {
   if (task.is_partial_array_task()) {
@@ -308,6 +308,8 @@ class ScavengeRootsTask : public WorkerTask {
     assert(worker_id < _active_workers, "Sanity");
     ResourceMark rm;
 
+    PSPromotionManager::record_numa_id(worker_id);
+
     if (!_is_old_gen_empty) {
       // There are only old-to-young pointers if there are objects
       // in the old gen.
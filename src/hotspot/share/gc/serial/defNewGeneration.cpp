@@ -27,7 +27,7 @@
 #include "gc/serial/serialGcRefProcProxyTask.hpp"
 #include "gc/serial/serialHeap.inline.hpp"
 #include "gc/serial/serialStringDedup.inline.hpp"
-#include "gc/serial/tenuredGeneration.hpp"
+#include "gc/serial/tenuredGeneration.inline.hpp"
 #include "gc/shared/adaptiveSizePolicy.hpp"
 #include "gc/shared/ageTable.inline.hpp"
 #include "gc/shared/collectorCounters.hpp"
@@ -132,8 +132,8 @@ class CLDScanClosure: public CLDClosure {
       // if oops are left pointing into the young gen.
       _oop_closure.set_scanned_cld(cld);
 
-      // Clean the cld since we're going to scavenge all the metadata.
-      cld->oops_do(&_oop_closure, ClassLoaderData::_claim_none, /*clear_modified_oops*/true);
+      // Only scavenge the handles that may refer to the young gen.
+      cld->modified_oops_do(&_oop_closure);
 
       _oop_closure.set_scanned_cld(nullptr);
     }
@@ -304,6 +304,7 @@ class SerialHeap : public CollectedHeap {
 
   void pin_object(JavaThread* thread, oop obj) override;
   void unpin_object(JavaThread* thread, oop obj) override;
+  bool pin_object_blocks_gc() const override { return true; }
 };
 
 #endif // SHARE_GC_SERIAL_SERIALHEAP_HPP
@@ -39,7 +39,6 @@
 #include "memory/allocation.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/java.hpp"
-#include "utilities/copy.hpp"
 #include "utilities/macros.hpp"
 
 bool TenuredGeneration::grow_by(size_t bytes) {
@@ -387,31 +386,6 @@ bool TenuredGeneration::promotion_attempt_is_safe(size_t max_promotion_in_bytes)
   return res;
 }
 
-oop TenuredGeneration::promote(oop obj, size_t obj_size) {
-  assert(obj_size == obj->size(), "bad obj_size passed in");
-
-#ifndef PRODUCT
-  if (SerialHeap::heap()->promotion_should_fail()) {
-    return nullptr;
-  }
-#endif  // #ifndef PRODUCT
-
-  // Allocate new object.
-  HeapWord* result = allocate(obj_size, false);
-  if (result == nullptr) {
-    // Promotion of obj into gen failed.  Try to expand and allocate.
-    result = expand_and_allocate(obj_size, false);
-    if (result == nullptr) {
-      return nullptr;
-    }
-  }
-
-  // Copy to new location.
-  Copy::aligned_disjoint_words(cast_from_oop<HeapWord*>(obj), result, obj_size);
-  oop new_obj = cast_to_oop<HeapWord*>(result);
-  return new_obj;
-}
-
 HeapWord*
 TenuredGeneration::expand_and_allocate(size_t word_size, bool is_tlab) {
   assert(!is_tlab, "TenuredGeneration does not support TLAB allocation");
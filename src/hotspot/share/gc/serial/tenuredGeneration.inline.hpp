@@ -26,7 +26,15 @@
 #define SHARE_GC_SERIAL_TENUREDGENERATION_INLINE_HPP
 
 #include "gc/serial/tenuredGeneration.hpp"
+
+#include "gc/serial/serialBlockOffsetTable.hpp"
+#include "gc/serial/serialHeap.hpp"
+#include "gc/shared/gc_globals.hpp"
 #include "gc/shared/space.hpp"
+#include "runtime/prefetch.inline.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/copy.hpp"
 
 inline size_t TenuredGeneration::capacity() const {
   return space()->capacity();
@@ -68,4 +76,38 @@ HeapWord* TenuredGeneration::par_allocate(size_t word_size,
   return res;
 }
 
+inline oop TenuredGeneration::promote(oop obj, size_t obj_size) {
+  assert(obj_size == obj->size(), "bad obj_size passed in");
+  assert(SafepointSynchronize::is_at_safepoint() && Thread::current()->is_VM_thread(),
+         "only the young collection promotes");
+
+#ifndef PRODUCT
+  if (SerialHeap::heap()->promotion_should_fail()) {
+    return nullptr;
+  }
+#endif  // #ifndef PRODUCT
+
+  // The young collection is the only allocator into the old gen while it
+  // runs, so the free part of the space acts as a promotion LAB: bump its
+  // top directly instead of going through the general allocation path.
+  HeapWord* result = _the_space->top();
+  if (pointer_delta(_the_space->end(), result) >= obj_size) {
+    _the_space->set_top(result + obj_size);
+    _bts->update_for_block(result, result + obj_size);
+  } else {
+    // Promotion of obj into gen failed.  Try to expand and allocate.
+    result = expand_and_allocate(obj_size, false);
+    if (result == nullptr) {
+      return nullptr;
+    }
+  }
+
+  // Prefetch beyond the new object, as done for copies into to-space.
+  Prefetch::write(result, PrefetchCopyIntervalInBytes);
+
+  // Copy to new location.
+  Copy::aligned_disjoint_words(cast_from_oop<HeapWord*>(obj), result, obj_size);
+  return cast_to_oop<HeapWord*>(result);
+}
+
 #endif // SHARE_GC_SERIAL_TENUREDGENERATION_INLINE_HPP
@@ -270,6 +270,11 @@ class CollectedHeap : public CHeapObj<mtGC> {
   // spaces).
   virtual size_t max_capacity() const = 0;
 
+  // Called after SoftMaxHeapSize has been changed at runtime, so that the
+  // heap can start to shrink towards it. Can be called by any thread and
+  // must not block.
+  virtual void soft_max_heap_size_changed() {}
+
   // Returns "TRUE" iff "p" points into the committed areas of the heap.
   // This method can be expensive so avoid using it in performance critical
   // code.
@@ -497,6 +502,9 @@ class CollectedHeap : public CHeapObj<mtGC> {
   // These functions are potentially safepointing.
   virtual void pin_object(JavaThread* thread, oop obj) = 0;
   virtual void unpin_object(JavaThread* thread, oop obj) = 0;
+  // True if pin_object() blocks all GCs until the object is unpinned,
+  // rather than only keeping the object in place.
+  virtual bool pin_object_blocks_gc() const { return false; }
 
   // Support for loading objects from CDS archive into the heap
   // (usually as a snapshot of the old generation).
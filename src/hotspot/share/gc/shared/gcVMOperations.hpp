@@ -161,14 +161,15 @@ class VM_GC_HeapInspection: public VM_GC_Operation {
   outputStream* _out;
   bool _full_gc;
   uint _parallel_thread_num;
+  bool _json;
  public:
   VM_GC_HeapInspection(outputStream* out, bool request_full_gc,
-                       uint parallel_thread_num = 1) :
+                       uint parallel_thread_num = 1, bool json = false) :
     VM_GC_Operation(0 /* total collections,      dummy, ignored */,
                     GCCause::_heap_inspection /* GC Cause */,
                     0 /* total full collections, dummy, ignored */,
                     request_full_gc), _out(out), _full_gc(request_full_gc),
-                    _parallel_thread_num(parallel_thread_num) {}
+                    _parallel_thread_num(parallel_thread_num), _json(json) {}
 
   ~VM_GC_HeapInspection() {}
   virtual VMOp_Type type() const { return VMOp_GC_HeapInspection; }
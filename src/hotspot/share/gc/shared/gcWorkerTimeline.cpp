@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/gcId.hpp"
+#include "gc/shared/gcWorkerTimeline.hpp"
+#include "memory/allocation.hpp"
+#include "memory/iterator.hpp"
+#include "memory/resourceArea.hpp"
+#include "memory/universe.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
+#include "runtime/osThread.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/powerOfTwo.hpp"
+
+GCWorkerTimeline::Event* GCWorkerTimeline::_events = nullptr;
+size_t GCWorkerTimeline::_mask = 0;
+volatile size_t GCWorkerTimeline::_next = 0;
+
+void GCWorkerTimeline::initialize() {
+  if (!RecordGCWorkerTimeline) {
+    return;
+  }
+  const size_t size = round_up_power_of_2((size_t)GCWorkerTimelineSize);
+  _events = NEW_C_HEAP_ARRAY(Event, size, mtGC);
+  for (size_t i = 0; i < size; i++) {
+    _events[i]._seq = 0;
+  }
+  _mask = size - 1;
+}
+
+// Every event slot is a small seqlock: it is marked as being written before
+// and stamped with its index after the other fields are written, so that
+// write_on can skip slots that are being overwritten.
+void GCWorkerTimeline::record(EventType type, const char* name) {
+  Thread* const thread = Thread::current();
+  const size_t index = Atomic::fetch_then_add(&_next, (size_t)1);
+  Event* const e = &_events[index & _mask];
+  Atomic::store(&e->_seq, (size_t)0);
+  OrderAccess::storestore();
+  e->_ticks = os::elapsed_counter();
+  e->_name = name;
+  e->_thread_id = (uint64_t)thread->osthread()->thread_id();
+  e->_gc_id = GCId::current_or_undefined();
+  e->_type = type;
+  Atomic::release_store(&e->_seq, index + 1);
+}
+
+class GCWorkerTimelineThreadNames : public ThreadClosure {
+  outputStream* const _st;
+  const int _pid;
+  bool _first;
+public:
+  GCWorkerTimelineThreadNames(outputStream* st, int pid) : _st(st), _pid(pid), _first(true) {}
+  void do_thread(Thread* thread) {
+    if (thread->osthread() == nullptr) {
+      return;
+    }
+    _st->print_cr("%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %d, \"tid\": " UINT64_FORMAT ", "
+                  "\"args\": {\"name\": \"%s\"}}",
+                  _first ? "" : ",", _pid, (uint64_t)thread->osthread()->thread_id(), thread->name());
+    _first = false;
+  }
+  bool first() const { return _first; }
+};
+
+void GCWorkerTimeline::write_on(outputStream* st) {
+  const int pid = os::current_process_id();
+  const double micros_per_tick = 1000000.0 / os::elapsed_frequency();
+
+  st->print_cr("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+  bool first = true;
+  if (Universe::heap() != nullptr) {
+    ResourceMark rm;
+    MutexLocker ml(Threads_lock);
+    GCWorkerTimelineThreadNames names(st, pid);
+    Universe::heap()->gc_threads_do(&names);
+    first = names.first();
+  }
+
+  if (_events != nullptr) {
+    const size_t next = Atomic::load_acquire(&_next);
+    const size_t size = _mask + 1;
+    const size_t start = next > size ? next - size : 0;
+    for (size_t index = start; index < next; index++) {
+      const Event* const e = &_events[index & _mask];
+      const size_t seq = Atomic::load_acquire(&e->_seq);
+      const jlong ticks = e->_ticks;
+      const char* const name = e->_name;
+      const uint64_t thread_id = e->_thread_id;
+      const uint gc_id = e->_gc_id;
+      const EventType type = e->_type;
+      OrderAccess::loadload();
+      if (seq != index + 1 || Atomic::load(&e->_seq) != seq) {
+        // Not yet written, or overwritten by a more recent event.
+        continue;
+      }
+      const char ph = type == Begin ? 'B' : (type == End ? 'E' : 'i');
+      st->print("%s{\"name\": \"%s\", \"cat\": \"gc\", \"ph\": \"%c\", \"ts\": %.3f, "
+                "\"pid\": %d, \"tid\": " UINT64_FORMAT ", ",
+                first ? "" : ",", name, ph, ticks * micros_per_tick, pid, thread_id);
+      if (type == Instant) {
+        st->print("\"s\": \"t\", ");
+      }
+      if (gc_id != GCId::undefined()) {
+        st->print_cr("\"args\": {\"gc_id\": %u}}", gc_id);
+      } else {
+        st->print_cr("\"args\": {}}");
+      }
+      first = false;
+    }
+  }
+  st->print_cr("]}");
+}
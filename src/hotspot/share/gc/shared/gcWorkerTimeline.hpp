@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef SHARE_GC_SHARED_GCWORKERTIMELINE_HPP
+#define SHARE_GC_SHARED_GCWORKERTIMELINE_HPP
+
+#include "gc/shared/gc_globals.hpp"
+#include "memory/allStatic.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class outputStream;
+
+// An opt-in (-XX:+RecordGCWorkerTimeline) timeline of the work of the GC worker
+// threads: the begin and end of their tasks and of the phases within them,
+// steals and termination. The events go into a fixed-size ring buffer that
+// keeps the most recent GCWorkerTimelineSize events, without locking, and
+// are written out in the Chrome trace event format, which Perfetto and
+// chrome://tracing load, to see how the work of a pause was spread over
+// the workers.
+//
+// Event names must be string literals or otherwise live forever.
+class GCWorkerTimeline : public AllStatic {
+public:
+  enum EventType : uint8_t {
+    Begin,
+    End,
+    Instant
+  };
+
+private:
+  struct Event {
+    // 1 + the index of the event once it is completely written, 0 while it
+    // is being written.
+    volatile size_t _seq;
+    jlong _ticks;
+    const char* _name;
+    uint64_t _thread_id;
+    uint _gc_id;
+    EventType _type;
+  };
+
+  static Event* _events;
+  static size_t _mask;
+  static volatile size_t _next;
+
+  static void record(EventType type, const char* name);
+
+public:
+  static void initialize();
+
+  static void begin(const char* name) {
+    if (RecordGCWorkerTimeline) {
+      record(Begin, name);
+    }
+  }
+  static void end(const char* name) {
+    if (RecordGCWorkerTimeline) {
+      record(End, name);
+    }
+  }
+  static void instant(const char* name) {
+    if (RecordGCWorkerTimeline) {
+      record(Instant, name);
+    }
+  }
+
+  // Writes the events in the buffer as a Chrome trace JSON object.
+  // Events recorded while writing may or may not be included.
+  static void write_on(outputStream* st);
+};
+
+// Records the begin and end of the enclosing scope.
+class GCWorkerTimelineMark : public StackObj {
+  const char* const _name;
+public:
+  GCWorkerTimelineMark(const char* name) : _name(name) {
+    GCWorkerTimeline::begin(_name);
+  }
+  ~GCWorkerTimelineMark() {
+    GCWorkerTimeline::end(_name);
+  }
+};
+
+#endif // SHARE_GC_SHARED_GCWORKERTIMELINE_HPP
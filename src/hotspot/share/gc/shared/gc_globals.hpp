@@ -185,6 +185,16 @@
           "bigger than this")                                               \
           range(1, INT_MAX/3)                                               \
                                                                             \
+  product(bool, UseAdaptiveArrayScanChunk, false, EXPERIMENTAL,             \
+          "Grow the chunk size used to scan large object arrays with the "  \
+          "array length, using ParGCArrayScanChunk as the minimum. Only "   \
+          "supported by G1")                                                \
+                                                                            \
+  product(uint, ArrayScanChunksPerWorker, 8, EXPERIMENTAL,                  \
+          "Number of chunks per GC worker a large object array is split "   \
+          "into with UseAdaptiveArrayScanChunk")                            \
+          range(1, 1024)                                                    \
+                                                                            \
                                                                             \
   product(bool, AlwaysPreTouch, false,                                      \
           "Force all freshly committed pages to be pre-touched")            \
@@ -196,6 +206,11 @@
           "Per-thread chunk size for parallel memory pre-touch.")           \
           range(4*K, SIZE_MAX / 2)                                          \
                                                                             \
+  product(bool, NUMAAwarePreTouch, false, EXPERIMENTAL,                     \
+          "With UseNUMA, split parallel memory pre-touch into a part for "  \
+          "each NUMA node, which the workers running on that node "         \
+          "pre-touch first")                                                \
+                                                                            \
   /* where does the range max value of (max_jint - 1) come from? */         \
   product(size_t, MarkStackSizeMax, NOT_LP64(4*M) LP64_ONLY(512*M),         \
           "Maximum size of marking stack in bytes.")                        \
@@ -265,6 +280,17 @@
   product(uintx, WorkStealingSpinToYieldRatio, 10, EXPERIMENTAL,            \
           "Ratio of hard spins to calls to yield")                          \
                                                                             \
+  product(uint, WorkStealingBatchSize, 32, EXPERIMENTAL,                    \
+          "Maximum number of tasks taken from another task queue by a "     \
+          "batched steal during marking. A batched steal takes at most "    \
+          "half of the tasks of that queue. 1 disables batching.")          \
+          range(1, 1024)                                                    \
+                                                                            \
+  product(bool, UseNUMAAwareStealing, false, EXPERIMENTAL,                 \
+          "Prefer stealing from task queues owned by workers running on "   \
+          "the same NUMA node before falling back to any queue. Only "      \
+          "effective with UseNUMA.")                                        \
+                                                                            \
   develop(uintx, ObjArrayMarkingStride, 2048,                               \
           "Number of object array elements to push onto the marking stack " \
           "before pushing a continuation entry")                            \
@@ -491,6 +517,17 @@
           "When +ReduceInitialCardMarks, explicitly defer any that "        \
           "may arise from new_pre_store_barrier")                           \
                                                                             \
+  product(bool, RecordGCWorkerTimeline, false, DIAGNOSTIC,                  \
+          "Record the begin and end of the tasks and phases of the GC "     \
+          "worker threads, their steals and termination into a ring "       \
+          "buffer, which the GC.worker_timeline diagnostic command "        \
+          "writes out in the Chrome trace event format")                    \
+                                                                            \
+  product(uint, GCWorkerTimelineSize, 256 * K, DIAGNOSTIC,                  \
+          "Number of the most recent events RecordGCWorkerTimeline keeps, " \
+          "rounded up to a power of 2")                                     \
+          range(1 * K, 64 * M)                                              \
+                                                                            \
   product(bool, UseCondCardMark, false,                                     \
           "Check for already marked card before updating card table")       \
                                                                             \
@@ -38,6 +38,7 @@
 #include "runtime/handles.inline.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/javaThread.hpp"
+#include "services/allocationSiteService.hpp"
 #include "services/lowMemoryDetector.hpp"
 #include "utilities/align.hpp"
 #include "utilities/copy.hpp"
@@ -61,6 +62,7 @@ class MemAllocator::Allocation: StackObj {
   void notify_allocation_jvmti_sampler();
   void notify_allocation_low_memory_detector();
   void notify_allocation_jfr_sampler();
+  void notify_allocation_site_sampler();
   void notify_allocation_dtrace_sampler();
 #ifdef ASSERT
   void check_for_valid_allocation_state() const;
@@ -219,6 +221,16 @@ void MemAllocator::Allocation::notify_allocation_jfr_sampler() {
   }
 }
 
+void MemAllocator::Allocation::notify_allocation_site_sampler() {
+  if (RecordAllocationSites) {
+    if (_allocated_outside_tlab) {
+      AllocationSiteService::on_sample(_thread, obj()->klass(), _allocator._word_size * HeapWordSize);
+    } else if (_allocated_tlab_size != 0) {
+      AllocationSiteService::on_sample(_thread, obj()->klass(), _allocated_tlab_size * HeapWordSize);
+    }
+  }
+}
+
 void MemAllocator::Allocation::notify_allocation_dtrace_sampler() {
   if (DTraceAllocProbes) {
     // support for Dtrace object alloc event (no-op most of the time)
@@ -233,6 +245,7 @@ void MemAllocator::Allocation::notify_allocation_dtrace_sampler() {
 void MemAllocator::Allocation::notify_allocation() {
   notify_allocation_low_memory_detector();
   notify_allocation_jfr_sampler();
+  notify_allocation_site_sampler();
   notify_allocation_dtrace_sampler();
   notify_allocation_jvmti_sampler();
 }
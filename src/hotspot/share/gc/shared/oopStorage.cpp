@@ -40,6 +40,7 @@
 #include "runtime/os.hpp"
 #include "runtime/safefetch.hpp"
 #include "runtime/safepoint.hpp"
+#include "runtime/thread.hpp"
 #include "utilities/align.hpp"
 #include "utilities/count_trailing_zeros.hpp"
 #include "utilities/debug.hpp"
@@ -339,6 +340,20 @@ uintx OopStorage::Block::allocate_all() {
   return new_allocated;
 }
 
+uintx OopStorage::Block::allocate_some(uint max_count) {
+  uintx free = ~allocated_bitmask();
+  assert(free != 0, "attempt to allocate from full block");
+  uintx new_allocated = 0;
+  for (uint i = 0; (i < max_count) && (free != 0); ++i) {
+    uintx lowest = free & (~free + 1);
+    new_allocated |= lowest;
+    free ^= lowest;
+  }
+  // Use atomic update because release may change bitmask.
+  atomic_add_allocated(new_allocated);
+  return new_allocated;
+}
+
 OopStorage::Block* OopStorage::Block::new_block(const OopStorage* owner) {
   // _data must be first member: aligning block => aligning _data.
   STATIC_ASSERT(_data_pos == 0);
@@ -434,6 +449,18 @@ OopStorage::Block::block_for_ptr(const OopStorage* owner, const oop* ptr) {
 // is empty, for ease of empty block deletion processing.
 
 oop* OopStorage::allocate() {
+  if (_thread_local_caching) {
+    Thread* thread = Thread::current_or_null();
+    if (thread != nullptr) {
+      oop* result = thread->oop_storage_cache()->allocate(this);
+      if (result != nullptr) {
+        Atomic::inc(&_allocation_count);
+        log_trace(oopstorage, ref)("%s: allocated " PTR_FORMAT " from thread cache", name(), p2i(result));
+      }
+      return result;
+    }
+  }
+
   MutexLocker ml(_allocation_mutex, Mutex::_no_safepoint_check_flag);
 
   Block* block = block_for_allocation();
@@ -457,6 +484,43 @@ oop* OopStorage::allocate() {
   return result;
 }
 
+// Refilling a thread cache claims up to thread_cache_refill_count entries of
+// the first block on the _allocation_list, the same way allocate() claims a
+// single entry.  The claimed entries are marked allocated in the block, but
+// are not counted in _allocation_count until handed out from the cache.
+uintx OopStorage::allocate_for_thread_cache(oop** base) {
+  MutexLocker ml(_allocation_mutex, Mutex::_no_safepoint_check_flag);
+
+  Block* block = block_for_allocation();
+  if (block == nullptr) return 0; // Block allocation failed.
+  assert(!block->is_full(), "invariant");
+  if (block->is_empty()) {
+    // Transitioning from empty to not empty.
+    log_block_transition(block, "not empty");
+  }
+  uintx taken = block->allocate_some(thread_cache_refill_count);
+  assert(taken != 0, "allocation failed");
+  if (block->is_full()) {
+    // Transitioning from not full to full.
+    // Remove full blocks from consideration by future allocates.
+    log_block_transition(block, "full");
+    _allocation_list.unlink(*block);
+  }
+  *base = block->get_pointer(0);
+  log_trace(oopstorage, ref)("%s: cached %u entries of block " PTR_FORMAT,
+                             name(), population_count(taken), p2i(block));
+  return taken;
+}
+
+void OopStorage::release_from_thread_cache(const oop* base, uintx entries) {
+  assert(entries != 0, "precondition");
+  Block* block = find_block_or_null(base);
+  assert(block != nullptr, "%s: invalid cached block " PTR_FORMAT, name(), p2i(base));
+  log_trace(oopstorage, ref)("%s: uncached %u entries of block " PTR_FORMAT,
+                             name(), population_count(entries), p2i(block));
+  block->release_entries(entries, this);
+}
+
 // Bulk allocation takes the first block off the _allocation_list, and marks
 // all remaining entries in that block as allocated.  It then drops the lock
 // and fills buffer with those newly allocated entries.  If more entries
@@ -774,7 +838,14 @@ void OopStorage::release(const oop* ptr) {
   Block* block = find_block_or_null(ptr);
   assert(block != nullptr, "%s: invalid release " PTR_FORMAT, name(), p2i(ptr));
   log_trace(oopstorage, ref)("%s: releasing " PTR_FORMAT, name(), p2i(ptr));
-  block->release_entries(block->bitmask_for_entry(ptr), this);
+  uintx releasing = block->bitmask_for_entry(ptr);
+  // An entry from a block cached by the current thread goes back to the
+  // cache, without updating the block.
+  Thread* thread = _thread_local_caching ? Thread::current_or_null() : nullptr;
+  if ((thread == nullptr) ||
+      !thread->oop_storage_cache()->release(this, block->get_pointer(0), releasing)) {
+    block->release_entries(releasing, this);
+  }
   Atomic::dec(&_allocation_count);
 }
 
@@ -828,6 +899,7 @@ OopStorage::OopStorage(const char* name, MEMFLAGS memflags) :
   _active_mutex(make_oopstorage_mutex(name, "active", Mutex::oopstorage - 1)),
   _num_dead_callback(nullptr),
   _allocation_count(0),
+  _thread_local_caching(false),
   _concurrent_iteration_count(0),
   _memflags(memflags),
   _needs_cleanup(false)
@@ -869,6 +941,11 @@ void OopStorage::register_num_dead_callback(NumDeadCallback f) {
   _num_dead_callback = f;
 }
 
+void OopStorage::enable_thread_local_caching() {
+  assert(_allocation_count == 0, "%s: enabling caching after allocations", name());
+  _thread_local_caching = true;
+}
+
 void OopStorage::report_num_dead(size_t num_dead) const {
   if (_num_dead_callback != nullptr) {
     _num_dead_callback(num_dead);
@@ -103,7 +103,8 @@ class OopStorage : public CHeapObjBase {
   EntryStatus allocation_status(const oop* ptr) const;
 
   // Allocates and returns a new entry.  Returns null if memory allocation
-  // failed.  Locks _allocation_mutex.
+  // failed.  Locks _allocation_mutex, unless the entry is obtained from the
+  // current thread's cache (see enable_thread_local_caching()).
   // postcondition: result == nullptr or *result == nullptr.
   oop* allocate();
 
@@ -128,6 +129,17 @@ class OopStorage : public CHeapObjBase {
   // precondition: *ptr == nullptr.
   void release(const oop* ptr);
 
+  // Lets threads cache entries of a block for allocate() and release(oop*),
+  // avoiding the _allocation_mutex for most single entry allocations.
+  // Cached entries are allocated from the point of view of the storage, and
+  // are null, so iterations see them like allocated but cleared entries;
+  // allocation_count() only counts entries handed out by allocate().  Only
+  // suitable for storages that live as long as the threads using them, and
+  // whose clients don't depend on the number of null entries reported to a
+  // num_dead callback.
+  // precondition: Called before any allocation from this storage.
+  void enable_thread_local_caching();
+
   // Releases all the ptrs.  Possibly faster than individual calls to
   // release(oop*).  Best if ptrs is sorted by address.  No locking.
   // precondition: All elements of ptrs are valid allocated entries.
@@ -267,6 +279,9 @@ class OopStorage : public CHeapObjBase {
   // Volatile for racy unlocked accesses.
   volatile size_t _allocation_count;
 
+  // Set if allocate() and release(oop*) use the per-thread caches.
+  bool _thread_local_caching;
+
   // Protection for _active_array.
   mutable SingleWriterSynchronizer _protect_active;
 
@@ -285,6 +300,12 @@ class OopStorage : public CHeapObjBase {
 
   bool try_add_block();
   Block* block_for_allocation();
+
+  // Thread cache support.
+  friend class OopStorageThreadCache;
+  static const uint thread_cache_refill_count = 16;
+  uintx allocate_for_thread_cache(oop** base);
+  void release_from_thread_cache(const oop* base, uintx entries);
   void  log_block_transition(Block* block, const char* new_state) const;
 
   Block* find_block_or_null(const oop* ptr) const;
@@ -189,6 +189,7 @@ class OopStorage::Block /* No base class, to avoid messing up alignment. */ {
 
   oop* allocate();
   uintx allocate_all();
+  uintx allocate_some(uint max_count);
   static Block* new_block(const OopStorage* owner);
   static void delete_block(const Block& block);
 
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/oopStorage.hpp"
+#include "gc/shared/oopStorageThreadCache.hpp"
+#include "utilities/count_trailing_zeros.hpp"
+#include "utilities/debug.hpp"
+
+OopStorageThreadCache::OopStorageThreadCache() {
+  for (uint i = 0; i < NumSlots; ++i) {
+    _slots[i]._storage = nullptr;
+    _slots[i]._base = nullptr;
+    _slots[i]._entries = 0;
+  }
+}
+
+OopStorageThreadCache::~OopStorageThreadCache() {
+  flush();
+}
+
+OopStorageThreadCache::Slot* OopStorageThreadCache::slot_for(OopStorage* storage) {
+  Slot* unused = nullptr;
+  for (uint i = 0; i < NumSlots; ++i) {
+    Slot* slot = &_slots[i];
+    if (slot->_storage == storage) {
+      return slot;
+    } else if ((unused == nullptr) && (slot->_entries == 0)) {
+      unused = slot;
+    }
+  }
+  if (unused == nullptr) {
+    // All slots hold entries of other storages; evict the first.
+    unused = &_slots[0];
+    flush_slot(unused);
+  }
+  unused->_storage = storage;
+  unused->_base = nullptr;
+  return unused;
+}
+
+void OopStorageThreadCache::flush_slot(Slot* slot) {
+  if (slot->_entries != 0) {
+    slot->_storage->release_from_thread_cache(slot->_base, slot->_entries);
+    slot->_entries = 0;
+  }
+  slot->_base = nullptr;
+}
+
+oop* OopStorageThreadCache::allocate(OopStorage* storage) {
+  Slot* slot = slot_for(storage);
+  if (slot->_entries == 0) {
+    slot->_entries = storage->allocate_for_thread_cache(&slot->_base);
+    if (slot->_entries == 0) {
+      return nullptr;
+    }
+  }
+  unsigned index = count_trailing_zeros(slot->_entries);
+  slot->_entries ^= uintx(1) << index;
+  return slot->_base + index;
+}
+
+bool OopStorageThreadCache::release(const OopStorage* storage, const oop* base, uintx bitmask) {
+  for (uint i = 0; i < NumSlots; ++i) {
+    Slot* slot = &_slots[i];
+    if ((slot->_storage == storage) && (slot->_base == base)) {
+      assert((slot->_entries & bitmask) == 0, "releasing cached entry");
+      slot->_entries |= bitmask;
+      return true;
+    }
+  }
+  return false;
+}
+
+void OopStorageThreadCache::flush() {
+  for (uint i = 0; i < NumSlots; ++i) {
+    flush_slot(&_slots[i]);
+    _slots[i]._storage = nullptr;
+  }
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_SHARED_OOPSTORAGETHREADCACHE_HPP
+#define SHARE_GC_SHARED_OOPSTORAGETHREADCACHE_HPP
+
+#include "oops/oopsHierarchy.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class OopStorage;
+
+// Per-thread cache of free entries of OopStorage blocks, for storages with
+// thread local caching enabled.  Each slot holds entries of one block of one
+// storage, as a bitmask relative to the first entry of the block.  The
+// cached entries are allocated in the block, so allocating from or releasing
+// to the cache doesn't need locking or atomic updates of the block.
+//
+// Only the owning thread accesses its cache.  The remaining entries are
+// released back to their blocks when the thread is destroyed.
+class OopStorageThreadCache {
+  static const uint NumSlots = 2;
+
+  struct Slot {
+    OopStorage* _storage;
+    oop* _base;
+    uintx _entries;
+  };
+
+  Slot _slots[NumSlots];
+
+  Slot* slot_for(OopStorage* storage);
+  static void flush_slot(Slot* slot);
+
+  NONCOPYABLE(OopStorageThreadCache);
+
+public:
+  OopStorageThreadCache();
+  ~OopStorageThreadCache();
+
+  // Returns an entry of storage, refilling the cache from storage if needed.
+  // Returns null if refilling failed.
+  oop* allocate(OopStorage* storage);
+
+  // Returns true if the entry at bitmask of the block starting with base
+  // was added to the cache.
+  bool release(const OopStorage* storage, const oop* base, uintx bitmask);
+
+  // Release all cached entries back to their blocks.
+  void flush();
+};
+
+#endif // SHARE_GC_SHARED_OOPSTORAGETHREADCACHE_HPP
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2020, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "gc/shared/gc_globals.hpp"
 #include "gc/shared/partialArrayTaskStepper.hpp"
 #include "oops/arrayOop.hpp"
 #include "utilities/globalDefinitions.hpp"
@@ -48,7 +49,18 @@ static uint compute_task_fanout(uint task_limit) {
   return result;
 }
 
+static uint compute_target_chunks(uint n_workers) {
+  if (!UseAdaptiveArrayScanChunk) {
+    return 0;
+  }
+  // Enough chunks per worker to even out differences in the time needed to
+  // process a chunk, but not many more, as every chunk is a task queue
+  // operation and potentially a steal.
+  return MAX2(n_workers, 1u) * ArrayScanChunksPerWorker;
+}
+
 PartialArrayTaskStepper::PartialArrayTaskStepper(uint n_workers) :
   _task_limit(compute_task_limit(n_workers)),
-  _task_fanout(compute_task_fanout(_task_limit))
+  _task_fanout(compute_task_fanout(_task_limit)),
+  _target_chunks(compute_target_chunks(n_workers))
 {}
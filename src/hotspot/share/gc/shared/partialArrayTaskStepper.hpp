@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2020, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -63,6 +63,18 @@ class PartialArrayTaskStepper {
   // precondition: chunk_size must be the same as used to start the task sequence.
   inline Step next(arrayOop from, arrayOop to, int chunk_size) const;
 
+  // Returns the chunk size to use for an array with the given length.  This
+  // is min_chunk_size unless UseAdaptiveArrayScanChunk is enabled, in which
+  // case chunks grow with the length so that a large array is split into
+  // about ArrayScanChunksPerWorker chunks per worker.  It only depends on
+  // the length, so start() and next() calls for the same array agree on it.
+  inline int chunk_size(int length, int min_chunk_size) const;
+
+  // Prefetch the start of the chunk beginning at index in to, if there is
+  // such a chunk.  Used to hide the memory latency of the next chunk that
+  // the current worker is likely to claim.
+  static inline void prefetch_chunk(arrayOop to, int length, int index, int chunk_size);
+
   class TestSupport;            // For unit tests
 
 private:
@@ -70,6 +82,9 @@ class PartialArrayTaskStepper {
   uint _task_limit;
   // Maximum number of new tasks to create when processing an existing task.
   uint _task_fanout;
+  // Number of chunks an adaptively chunked array is split into, or 0 if
+  // the chunk size is not adaptive.
+  uint _target_chunks;
 
   // Split start/next into public part dealing with oops and private
   // impl dealing with lengths and pointers to lengths, for unit testing.
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2020, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -29,6 +29,8 @@
 
 #include "oops/arrayOop.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/prefetch.inline.hpp"
+#include "utilities/globalDefinitions.hpp"
 
 PartialArrayTaskStepper::Step
 PartialArrayTaskStepper::start_impl(int length,
@@ -115,4 +117,26 @@ PartialArrayTaskStepper::next(arrayOop from, arrayOop to, int chunk_size) const
   return next_impl(from->length(), to->length_addr(), chunk_size);
 }
 
+int PartialArrayTaskStepper::chunk_size(int length, int min_chunk_size) const {
+  assert(min_chunk_size > 0, "precondition");
+  if (_target_chunks == 0) {
+    return min_chunk_size;
+  }
+  return MAX2(length / (int)_target_chunks, min_chunk_size);
+}
+
+void PartialArrayTaskStepper::prefetch_chunk(arrayOop to, int length, int index, int chunk_size) {
+  if (index >= length) {
+    return;
+  }
+  // Only the first few cache lines, the hardware prefetcher picks up the
+  // sequential accesses from there.
+  const int max_elements = 4 * DEFAULT_CACHE_LINE_SIZE / heapOopSize;
+  const int bytes = MIN3(length - index, chunk_size, max_elements) * heapOopSize;
+  char* const start = (char*)to->base(T_OBJECT) + (size_t)index * heapOopSize;
+  for (int offset = 0; offset < bytes; offset += DEFAULT_CACHE_LINE_SIZE) {
+    Prefetch::read(start, offset);
+  }
+}
+
 #endif // SHARE_GC_SHARED_PARTIALARRAYTASKSTEPPER_INLINE_HPP
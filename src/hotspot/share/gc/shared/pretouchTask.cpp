@@ -31,38 +31,93 @@
 #include "runtime/os.hpp"
 #include "utilities/align.hpp"
 
+// Start of the chunk containing addr. Chunks are aligned to the chunk size,
+// which is a multiple of the page size but not necessarily a power of two.
+static char* chunk_start(char* addr, size_t chunk_size) {
+  return addr - ((uintptr_t)addr % chunk_size);
+}
+
 PretouchTask::PretouchTask(const char* task_name,
                            char* start_address,
                            char* end_address,
                            size_t page_size,
                            size_t chunk_size) :
     WorkerTask(task_name),
-    _cur_addr(start_address),
-    _end_addr(end_address),
+    _parts(nullptr),
+    _node_ids(nullptr),
+    _num_parts(1),
     _page_size(page_size),
     _chunk_size(chunk_size) {
 
   assert(chunk_size >= page_size,
          "Chunk size " SIZE_FORMAT " is smaller than page size " SIZE_FORMAT,
          chunk_size, page_size);
+
+  size_t total_bytes = pointer_delta(end_address, start_address, sizeof(char));
+  if (NUMAAwarePreTouch && UseNUMA && total_bytes > chunk_size) {
+    _node_ids = NEW_C_HEAP_ARRAY(uint, os::numa_get_groups_num(), mtGC);
+    _num_parts = checked_cast<uint>(os::numa_get_leaf_groups(_node_ids, os::numa_get_groups_num()));
+    _num_parts = MAX2(1u, checked_cast<uint>(MIN2((size_t)_num_parts, total_bytes / chunk_size)));
+  }
+  _parts = NEW_C_HEAP_ARRAY(Part, _num_parts, mtGC);
+
+  // Parts end at chunk boundaries.
+  size_t part_size = total_bytes / _num_parts;
+  char* part_start = start_address;
+  for (uint i = 0; i < _num_parts; i++) {
+    char* part_end = (i == _num_parts - 1) ? end_address
+                                           : chunk_start(part_start + part_size, chunk_size);
+    _parts[i]._cur_addr = part_start;
+    _parts[i]._end_addr = part_end;
+    part_start = MAX2(part_start, part_end);
+  }
+}
+
+PretouchTask::~PretouchTask() {
+  FREE_C_HEAP_ARRAY(Part, _parts);
+  if (_node_ids != nullptr) {
+    FREE_C_HEAP_ARRAY(uint, _node_ids);
+  }
 }
 
 size_t PretouchTask::chunk_size() {
   return PreTouchParallelChunkSize;
 }
 
-void PretouchTask::work(uint worker_id) {
+uint PretouchTask::local_part() const {
+  if (_num_parts > 1) {
+    int node_id = os::numa_get_group_id();
+    for (uint i = 0; i < _num_parts; i++) {
+      if (_node_ids[i] == (uint)node_id) {
+        return i;
+      }
+    }
+  }
+  return 0;
+}
+
+void PretouchTask::pretouch_part(Part* part) {
   while (true) {
-    char* cur_start = Atomic::load(&_cur_addr);
-    char* cur_end = cur_start + MIN2(_chunk_size, pointer_delta(_end_addr, cur_start, 1));
+    char* cur_start = Atomic::load(&part->_cur_addr);
+    // Chunks end at chunk size aligned addresses, so with a chunk size that
+    // is a multiple of the page size, no two chunks share a (large) page.
+    char* cur_end = MIN2(chunk_start(cur_start, _chunk_size) + _chunk_size, part->_end_addr);
     if (cur_start >= cur_end) {
       break;
-    } else if (cur_start == Atomic::cmpxchg(&_cur_addr, cur_start, cur_end)) {
+    } else if (cur_start == Atomic::cmpxchg(&part->_cur_addr, cur_start, cur_end)) {
       os::pretouch_memory(cur_start, cur_end, _page_size);
     } // Else attempt to claim chunk failed, so try again.
   }
 }
 
+void PretouchTask::work(uint worker_id) {
+  // Pre-touch the part of the local NUMA node first, then help with the others.
+  uint first = local_part();
+  for (uint i = 0; i < _num_parts; i++) {
+    pretouch_part(&_parts[(first + i) % _num_parts]);
+  }
+}
+
 void PretouchTask::pretouch(const char* task_name, char* start_address, char* end_address,
                             size_t page_size, WorkerThreads* pretouch_workers) {
   // Page-align the chunk size, so if start_address is also page-aligned (as
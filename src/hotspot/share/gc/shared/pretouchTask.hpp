@@ -28,13 +28,28 @@
 #include "gc/shared/workerThread.hpp"
 
 class PretouchTask : public WorkerTask {
-  char* volatile _cur_addr;
-  char* const _end_addr;
+  // A part of the range to pre-touch, claimed chunk by chunk. With
+  // NUMAAwarePreTouch there is a part for each NUMA node, otherwise a
+  // single one.
+  struct Part {
+    char* volatile _cur_addr;
+    char* _end_addr;
+  };
+
+  Part* _parts;
+  uint* _node_ids;
+  uint _num_parts;
   size_t _page_size;
   size_t _chunk_size;
 
+  // Pre-touch the chunks of the part until none are left.
+  void pretouch_part(Part* part);
+  // Index of the part of the NUMA node the current thread runs on.
+  uint local_part() const;
+
 public:
   PretouchTask(const char* task_name, char* start_address, char* end_address, size_t page_size, size_t chunk_size);
+  ~PretouchTask();
 
   virtual void work(uint worker_id);
 
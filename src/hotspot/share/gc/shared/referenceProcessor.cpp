@@ -1071,6 +1071,14 @@ void ReferenceProcessor::preclean_discovered_references(BoolObjectClosure* is_al
   }
 }
 
+bool ReferenceProcessor::preclean_discovered_list(uint index,
+                                                  BoolObjectClosure* is_alive,
+                                                  EnqueueDiscoveredFieldClosure* enqueue,
+                                                  YieldClosure*      yield) {
+  assert(index < num_discovered_lists(), "index out of bounds: %u", index);
+  return preclean_discovered_reflist(_discovered_refs[index], is_alive, enqueue, yield);
+}
+
 bool ReferenceProcessor::preclean_discovered_reflist(DiscoveredList&    refs_list,
                                                      BoolObjectClosure* is_alive,
                                                      EnqueueDiscoveredFieldClosure* enqueue,
@@ -320,6 +320,18 @@ class ReferenceProcessor : public ReferenceDiscoverer {
                                       YieldClosure*      yield,
                                       GCTimer*           gc_timer);
 
+  // Total number of discovered reference lists, over all reference types.
+  uint num_discovered_lists() const { return _max_num_queues * (uint)number_of_subclasses_of_ref(); }
+
+  // "Preclean" the discovered reference list with the given index in
+  // [0, num_discovered_lists()). Lists with different indices may be
+  // precleaned by different threads at the same time.
+  // Returns whether the operation should be aborted.
+  bool preclean_discovered_list(uint index,
+                                BoolObjectClosure* is_alive,
+                                EnqueueDiscoveredFieldClosure* enqueue,
+                                YieldClosure*      yield);
+
 private:
   // Returns the name of the discovered reference list
   // occupying the i / _num_queues slot.
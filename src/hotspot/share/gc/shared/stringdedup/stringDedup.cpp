@@ -63,6 +63,7 @@ const Klass* StringDedup::_string_klass_or_null = nullptr; // No klass will matc
 static_assert(markWord::max_age < UINT_MAX, "assumption");
 uint StringDedup::_enabled_age_threshold = UINT_MAX;       // Age never equals max.
 uint StringDedup::_enabled_age_limit = 0;                  // Age is never less than zero.
+bool StringDedup::_array_fields_enabled = false;
 
 bool StringDedup::ergo_initialize() {
   return Config::ergo_initialize();
@@ -83,6 +84,7 @@ void StringDedup::initialize() {
     _string_klass_or_null = vmClasses::String_klass();
     _enabled_age_threshold = Config::age_threshold();
     _enabled_age_limit = Config::age_threshold();
+    _array_fields_enabled = Config::array_field_count() > 0;
     Table::initialize();
     Processor::initialize();
     // Don't create the thread yet.  JavaThreads need to be created later.
@@ -92,6 +94,22 @@ void StringDedup::initialize() {
   _initialized = true;
 }
 
+bool StringDedup::is_array_field_holder(const Klass* k) {
+  return k->is_instance_klass() && InstanceKlass::cast(k)->has_dedup_array_fields();
+}
+
+void StringDedup::initialize_array_fields(InstanceKlass* ik) {
+  if (!_array_fields_enabled) return;
+  const InstanceKlass* super = ik->java_super();
+  bool is_holder = (super != nullptr) && super->has_dedup_array_fields();
+  for (size_t i = 0; !is_holder && (i < Config::array_field_count()); ++i) {
+    is_holder = Config::array_field_offset(ik, i) >= 0;
+  }
+  if (is_holder) {
+    ik->set_has_dedup_array_fields(true);
+  }
+}
+
 void StringDedup::start() {
   assert(is_enabled(), "precondition");
   StringDedupThread::initialize();
@@ -105,6 +105,7 @@
 #include "oops/oopsHierarchy.hpp"
 #include "utilities/globalDefinitions.hpp"
 
+class InstanceKlass;
 class Klass;
 class StringDedupThread;
 class ThreadClosure;
@@ -133,6 +134,9 @@ class StringDedup : public AllStatic {
   static const Klass* _string_klass_or_null;
   static uint _enabled_age_threshold;
   static uint _enabled_age_limit;
+  static bool _array_fields_enabled;
+
+  static bool is_array_field_holder(const Klass* k);
 
 public:
   class Requests;
@@ -166,6 +170,10 @@ class StringDedup : public AllStatic {
   // precondition: java_string is a Java String object.
   static void notify_intern(oop java_string);
 
+  // Called when ik is being created, records whether instances of ik have
+  // fields listed in DeduplicateByteArrayFields.
+  static void initialize_array_fields(InstanceKlass* ik);
+
   // precondition: at safepoint
   static void verify();
 
@@ -178,6 +186,12 @@ class StringDedup : public AllStatic {
     return k == _string_klass_or_null;
   }
 
+  // Return true if deduplication is enabled and k is String klass or has
+  // fields listed in DeduplicateByteArrayFields.
+  static bool is_enabled_candidate(const Klass* k) {
+    return is_enabled_string(k) || (_array_fields_enabled && is_array_field_holder(k));
+  }
+
   // Return true if age == StringDeduplicationAgeThreshold and
   // deduplication is enabled.
   static bool is_threshold_age(uint age) {
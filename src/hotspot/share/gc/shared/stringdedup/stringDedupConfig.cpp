@@ -24,8 +24,13 @@
 
 #include "precompiled.hpp"
 #include "classfile/altHashing.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/vmSymbols.hpp"
 #include "gc/shared/stringdedup/stringDedupConfig.hpp"
 #include "logging/log.hpp"
+#include "memory/allocation.hpp"
+#include "oops/instanceKlass.hpp"
+#include "runtime/fieldDescriptor.inline.hpp"
 #include "runtime/flags/jvmFlag.hpp"
 #include "runtime/globals.hpp"
 #include "runtime/globals_extension.hpp"
@@ -40,6 +45,8 @@ double StringDedup::Config::_load_factor_target;
 size_t StringDedup::Config::_minimum_dead_for_cleanup;
 double StringDedup::Config::_dead_factor_for_cleanup;
 uint64_t StringDedup::Config::_hash_seed;
+StringDedup::Config::ArrayField* StringDedup::Config::_array_fields = nullptr;
+size_t StringDedup::Config::_array_field_count = 0;
 
 size_t StringDedup::Config::initial_table_size() {
   return _initial_table_size;
@@ -58,6 +65,69 @@ uint64_t StringDedup::Config::hash_seed() {
   return _hash_seed;
 }
 
+size_t StringDedup::Config::array_field_count() {
+  return _array_field_count;
+}
+
+int StringDedup::Config::array_field_offset(const InstanceKlass* ik, size_t i) {
+  assert(i < _array_field_count, "index out of bounds");
+  const ArrayField& entry = _array_fields[i];
+  if (!ik->name()->equals(entry._class_name)) {
+    return -1;
+  }
+  Symbol* name = SymbolTable::probe(entry._field_name, (int)strlen(entry._field_name));
+  fieldDescriptor fd;
+  if ((name != nullptr) &&
+      ik->find_local_field(name, vmSymbols::byte_array_signature(), &fd) &&
+      !fd.is_static()) {
+    return fd.offset();
+  }
+  return -1;
+}
+
+// Entries have the form pkg.Class::field; malformed entries are ignored
+// with a warning.
+void StringDedup::Config::parse_array_fields() {
+  if ((DeduplicateByteArrayFields == nullptr) || (DeduplicateByteArrayFields[0] == '\0')) {
+    return;
+  }
+  size_t max_count = 1;
+  for (const char* p = DeduplicateByteArrayFields; *p != '\0'; ++p) {
+    if (*p == ',') max_count++;
+  }
+  _array_fields = NEW_C_HEAP_ARRAY(ArrayField, max_count, mtStringDedup);
+  const char* start = DeduplicateByteArrayFields;
+  while (true) {
+    const char* end = strchr(start, ',');
+    size_t len = (end == nullptr) ? strlen(start) : pointer_delta(end, start, 1);
+    const char* sep = nullptr;
+    for (size_t i = 0; i + 1 < len; ++i) {
+      if ((start[i] == ':') && (start[i + 1] == ':')) {
+        sep = start + i;
+        break;
+      }
+    }
+    if ((sep == nullptr) || (sep == start) || (sep + 2 == start + len)) {
+      log_warning(stringdedup)("Ignoring malformed DeduplicateByteArrayFields entry: %.*s",
+                               (int)len, start);
+    } else {
+      size_t class_len = pointer_delta(sep, start, 1);
+      size_t field_len = len - class_len - 2;
+      ArrayField& entry = _array_fields[_array_field_count++];
+      entry._class_name = NEW_C_HEAP_ARRAY(char, class_len + 1, mtStringDedup);
+      for (size_t i = 0; i < class_len; ++i) {
+        entry._class_name[i] = (start[i] == '.') ? '/' : start[i];
+      }
+      entry._class_name[class_len] = '\0';
+      entry._field_name = NEW_C_HEAP_ARRAY(char, field_len + 1, mtStringDedup);
+      memcpy(entry._field_name, sep + 2, field_len);
+      entry._field_name[field_len] = '\0';
+    }
+    if (end == nullptr) break;
+    start = end + 1;
+  }
+}
+
 static uint64_t initial_hash_seed() {
   if (StringDeduplicationHashSeed != 0) {
     return StringDeduplicationHashSeed;
@@ -163,4 +233,5 @@ void StringDedup::Config::initialize() {
   _minimum_dead_for_cleanup = StringDeduplicationCleanupDeadMinimum;
   _dead_factor_for_cleanup = StringDeduplicationCleanupDeadPercent / 100.0;
   _hash_seed = initial_hash_seed();
+  parse_array_fields();
 }
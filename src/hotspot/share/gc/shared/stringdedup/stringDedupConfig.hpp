@@ -29,6 +29,8 @@
 #include "memory/allStatic.hpp"
 #include "utilities/globalDefinitions.hpp"
 
+class InstanceKlass;
+
 // Provides access to canonicalized configuration parameter values.  This
 // class captures the various StringDeduplicationXXX command line option
 // values, massages them, and provides error checking support.
@@ -42,6 +44,15 @@ class StringDedup::Config : AllStatic {
   static double _dead_factor_for_cleanup;
   static uint64_t _hash_seed;
 
+  // Parsed DeduplicateByteArrayFields entries, class names in internal form.
+  struct ArrayField {
+    char* _class_name;
+    char* _field_name;
+  };
+  static ArrayField* _array_fields;
+  static size_t _array_field_count;
+  static void parse_array_fields();
+
   static const size_t good_sizes[];
   static const size_t min_good_size;
   static const size_t max_good_size;
@@ -58,6 +69,11 @@ class StringDedup::Config : AllStatic {
   static int age_threshold();
   static uint64_t hash_seed();
 
+  static size_t array_field_count();
+  // Returns the offset of the i'th DeduplicateByteArrayFields entry if it
+  // names a byte[] instance field declared by ik, or -1.
+  static int array_field_offset(const InstanceKlass* ik, size_t i);
+
   static size_t grow_threshold(size_t table_size);
   static size_t shrink_threshold(size_t table_size);
   static bool should_grow_table(size_t table_size, size_t entry_count);
@@ -44,6 +44,7 @@
 #include "utilities/debug.hpp"
 #include "utilities/globalCounter.hpp"
 #include "utilities/globalDefinitions.hpp"
+#include "utilities/powerOfTwo.hpp"
 
 OopStorage* StringDedup::Processor::_storages[2] = {};
 
@@ -61,7 +62,41 @@ void StringDedup::Processor::initialize_storage() {
   _storage_for_processing = new StorageUse(_storages[1]);
 }
 
-StringDedup::Processor::Processor() : _thread(nullptr) {}
+StringDedup::Processor::Processor() : _thread(nullptr), _estimates() {}
+
+// Requests inspected in a size class before its estimate is trusted.  The
+// counts are halved when they reach the decay limit, so the estimate tracks
+// recent behavior.  Requests in a size class below the hit threshold are
+// still sampled, so that the estimate can recover.
+static const uint estimate_min_samples = 64;
+static const uint estimate_decay_limit = 4096;
+static const uint estimate_sample_interval = 16;
+
+uint StringDedup::Processor::size_class(int length) {
+  return (length == 0) ? 0 : log2i(length) + 1;
+}
+
+bool StringDedup::Processor::should_process(int length) {
+  if (StringDeduplicationMinHitPercent == 0) return true;
+  SizeClassEstimate& estimate = _estimates[size_class(length)];
+  if ((estimate._inspected < estimate_min_samples) ||
+      (estimate._found * 100 >= estimate._inspected * StringDeduplicationMinHitPercent)) {
+    return true;
+  }
+  return (++estimate._skipped % estimate_sample_interval) == 0;
+}
+
+void StringDedup::Processor::record_result(int length, bool found) {
+  SizeClassEstimate& estimate = _estimates[size_class(length)];
+  estimate._inspected++;
+  if (found) {
+    estimate._found++;
+  }
+  if (estimate._inspected == estimate_decay_limit) {
+    estimate._inspected /= 2;
+    estimate._found /= 2;
+  }
+}
 
 void StringDedup::Processor::initialize() {
   _processor = new Processor();
@@ -153,12 +188,19 @@ class StringDedup::Processor::ProcessRequest final : public OopClosure {
     if (java_string == nullptr) {
       // String became unreachable before we got a chance to process it.
       _cur_stat.inc_skipped_dead();
+    } else if (!java_lang_String::is_instance(java_string)) {
+      // Request for an object with fields listed in DeduplicateByteArrayFields.
+      Table::deduplicate_array_fields(java_string);
     } else if (java_lang_String::value(java_string) == nullptr) {
       // Request during String construction, before its value array has
       // been initialized.
       _cur_stat.inc_skipped_incomplete();
+    } else if (!_processor->should_process(java_lang_String::value(java_string)->length())) {
+      // Strings of this size have rarely had a duplicate recently.
+      _cur_stat.inc_skipped_unlikely();
     } else {
-      Table::deduplicate(java_string);
+      int length = java_lang_String::value(java_string)->length();
+      _processor->record_result(length, Table::deduplicate(java_string));
       if (Table::is_grow_needed()) {
         _cur_stat.report_process_pause();
         _processor->cleanup_table(true /* grow_only */, false /* force */);
@@ -27,6 +27,7 @@
 
 #include "gc/shared/stringdedup/stringDedup.hpp"
 #include "memory/allocation.hpp"
+#include "utilities/globalDefinitions.hpp"
 #include "utilities/macros.hpp"
 
 class JavaThread;
@@ -53,6 +54,20 @@ class StringDedup::Processor : public CHeapObj<mtGC> {
 
   JavaThread* _thread;
 
+  // Estimate of how likely a request finds a duplicate, per size class
+  // (log2 of the value array length).  Only used by the processor thread.
+  struct SizeClassEstimate {
+    uint _inspected;
+    uint _found;
+    uint _skipped;
+  };
+  static const uint number_of_size_classes = BitsPerInt;
+  SizeClassEstimate _estimates[number_of_size_classes];
+
+  static uint size_class(int length);
+  bool should_process(int length);
+  void record_result(int length, bool found);
+
   // Wait until there are requests to be processed.  The storage for requests
   // and storage for processing are swapped; the former requests storage
   // becomes the current processing storage, and vice versa.
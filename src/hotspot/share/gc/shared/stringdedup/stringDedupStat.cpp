@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "gc/shared/stringdedup/stringDedupStat.hpp"
 #include "logging/log.hpp"
+#include "runtime/os.hpp"
 #include "utilities/globalDefinitions.hpp"
 
 StringDedup::Stat::Stat() :
@@ -40,6 +41,7 @@ StringDedup::Stat::Stat() :
   _skipped_dead(0),
   _skipped_incomplete(0),
   _skipped_shared(0),
+  _skipped_unlikely(0),
   _active(0),
   _idle(0),
   _process(0),
@@ -47,6 +49,8 @@ StringDedup::Stat::Stat() :
   _cleanup_table(0),
   _active_start(),
   _active_elapsed(),
+  _active_cpu_start(0),
+  _active_cpu_time(0),
   _phase_start(),
   _idle_elapsed(),
   _process_elapsed(),
@@ -67,12 +71,14 @@ void StringDedup::Stat::add(const Stat* const stat) {
   _skipped_dead        += stat->_skipped_dead;
   _skipped_incomplete  += stat->_skipped_incomplete;
   _skipped_shared      += stat->_skipped_shared;
+  _skipped_unlikely    += stat->_skipped_unlikely;
   _active              += stat->_active;
   _idle                += stat->_idle;
   _process             += stat->_process;
   _resize_table        += stat->_resize_table;
   _cleanup_table       += stat->_cleanup_table;
   _active_elapsed      += stat->_active_elapsed;
+  _active_cpu_time     += stat->_active_cpu_time;
   _idle_elapsed        += stat->_idle_elapsed;
   _process_elapsed     += stat->_process_elapsed;
   _resize_table_elapsed += stat->_resize_table_elapsed;
@@ -91,35 +97,52 @@ static double strdedup_elapsed_param_ms(Tickspan t) {
   return t.seconds() * MILLIUNITS;
 }
 
+static double strdedup_cpu_ms(jlong nanos) {
+  return (double)nanos / NANOUNITS_PER_MILLIUNIT;
+}
+
 void StringDedup::Stat::log_summary(const Stat* last_stat, const Stat* total_stat) {
   double total_deduped_bytes_percent = 0.0;
+  size_t total_deduped_bytes_per_cpu_ms = 0;
 
   if (total_stat->_new_bytes > 0) {
     // Avoid division by zero
     total_deduped_bytes_percent = percent_of(total_stat->_deduped_bytes, total_stat->_new_bytes);
   }
+  if (total_stat->_active_cpu_time > 0) {
+    total_deduped_bytes_per_cpu_ms =
+      (size_t)(total_stat->_deduped_bytes / strdedup_cpu_ms(total_stat->_active_cpu_time));
+  }
 
   log_info(stringdedup)(
     "Concurrent String Deduplication "
     "%zu/" STRDEDUP_BYTES_FORMAT_NS " (new), "
     "%zu/" STRDEDUP_BYTES_FORMAT_NS " (deduped), "
     "avg " STRDEDUP_PERCENT_FORMAT_NS ", "
-    STRDEDUP_ELAPSED_FORMAT_MS " of " STRDEDUP_ELAPSED_FORMAT_MS,
+    STRDEDUP_ELAPSED_FORMAT_MS " of " STRDEDUP_ELAPSED_FORMAT_MS ", "
+    "avg " STRDEDUP_BYTES_FORMAT_NS "/cpu-ms",
     last_stat->_new, STRDEDUP_BYTES_PARAM(last_stat->_new_bytes),
     last_stat->_deduped, STRDEDUP_BYTES_PARAM(last_stat->_deduped_bytes),
     total_deduped_bytes_percent,
     strdedup_elapsed_param_ms(last_stat->_process_elapsed),
-    strdedup_elapsed_param_ms(last_stat->_active_elapsed));
+    strdedup_elapsed_param_ms(last_stat->_active_elapsed),
+    STRDEDUP_BYTES_PARAM(total_deduped_bytes_per_cpu_ms));
 }
 
 void StringDedup::Stat::report_active_start() {
   log_debug(stringdedup, phases, start)("Active start");
   _active_start = Ticks::now();
+  if (os::is_thread_cpu_time_supported()) {
+    _active_cpu_start = os::current_thread_cpu_time();
+  }
   _active++;
 }
 
 void StringDedup::Stat::report_active_end() {
   _active_elapsed += (Ticks::now() - _active_start);
+  if (os::is_thread_cpu_time_supported()) {
+    _active_cpu_time += os::current_thread_cpu_time() - _active_cpu_start;
+  }
   log_debug(stringdedup, phases)("Active end: " STRDEDUP_ELAPSED_FORMAT_MS,
                                  strdedup_elapsed_param_ms(_active_elapsed));
 }
@@ -193,10 +216,12 @@ void StringDedup::Stat::report_cleanup_table_end() {
 void StringDedup::Stat::log_times(const char* prefix) const {
   log_debug(stringdedup)(
     "  %s Process: %zu/" STRDEDUP_ELAPSED_FORMAT_MS
-    ", Idle: %zu/" STRDEDUP_ELAPSED_FORMAT_MS,
+    ", Idle: %zu/" STRDEDUP_ELAPSED_FORMAT_MS
+    ", CPU: " STRDEDUP_ELAPSED_FORMAT_MS,
     prefix,
     _process, strdedup_elapsed_param_ms(_process_elapsed),
-    _idle, strdedup_elapsed_param_ms(_idle_elapsed));
+    _idle, strdedup_elapsed_param_ms(_idle_elapsed),
+    strdedup_cpu_ms(_active_cpu_time));
   if (_resize_table > 0) {
     log_debug(stringdedup)(
       "  %s Resize Table: %zu/" STRDEDUP_ELAPSED_FORMAT_MS,
@@ -227,6 +252,6 @@ void StringDedup::Stat::log_statistics(bool total) const {
   log_debug(stringdedup)("      Deleted:    %12zu(%5.1f%%)", _deleted, deleted_percent);
   log_debug(stringdedup)("    Deduplicated: %12zu(%5.1f%%)" STRDEDUP_BYTES_FORMAT "(%5.1f%%)",
                          _deduped, deduped_percent, STRDEDUP_BYTES_PARAM(_deduped_bytes), deduped_bytes_percent);
-  log_debug(stringdedup)("    Skipped: %zu (dead), %zu (incomplete), %zu (shared)",
-                         _skipped_dead, _skipped_incomplete, _skipped_shared);
+  log_debug(stringdedup)("    Skipped: %zu (dead), %zu (incomplete), %zu (shared), %zu (unlikely)",
+                         _skipped_dead, _skipped_incomplete, _skipped_shared, _skipped_unlikely);
 }
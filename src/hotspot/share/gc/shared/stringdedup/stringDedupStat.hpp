@@ -48,6 +48,7 @@ class StringDedup::Stat {
   size_t _skipped_dead;
   size_t _skipped_incomplete;
   size_t _skipped_shared;
+  size_t _skipped_unlikely;
 
   // Phase counters for deduplication thread
   size_t _active;
@@ -59,6 +60,9 @@ class StringDedup::Stat {
   // Time spent by the deduplication thread in different phases
   Ticks _active_start;
   Tickspan _active_elapsed;
+  // CPU time of the deduplication thread while active, in nanoseconds
+  jlong _active_cpu_start;
+  jlong _active_cpu_time;
   Ticks _phase_start;
   // These phases are disjoint, so share _phase_start.
   // Some of these overlap with active, hence need _active_start.
@@ -96,6 +100,12 @@ class StringDedup::Stat {
     _skipped_shared++;
   }
 
+  // Track number of requests skipped because strings of that size have
+  // rarely been found to have a duplicate.
+  void inc_skipped_unlikely() {
+    _skipped_unlikely++;
+  }
+
   // Track number of inspected strings already present.
   void inc_known() {
     _known++;
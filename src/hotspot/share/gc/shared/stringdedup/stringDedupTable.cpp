@@ -38,7 +38,9 @@
 #include "memory/resourceArea.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
-#include "oops/access.hpp"
+#include "oops/access.inline.hpp"
+#include "oops/instanceKlass.hpp"
+#include "oops/oop.inline.hpp"
 #include "oops/oopsHierarchy.hpp"
 #include "oops/typeArrayOop.inline.hpp"
 #include "oops/weakHandle.inline.hpp"
@@ -607,12 +609,12 @@ bool StringDedup::Table::deduplicate_if_permitted(oop java_string,
   }
 }
 
-void StringDedup::Table::deduplicate(oop java_string) {
+bool StringDedup::Table::deduplicate(oop java_string) {
   assert(java_lang_String::is_instance(java_string), "precondition");
   _cur_stat.inc_inspected();
   if ((StringTable::shared_entry_count() > 0) &&
       try_deduplicate_shared(java_string)) {
-    return;                     // Done if deduplicated against shared StringTable.
+    return true;                // Done if deduplicated against shared StringTable.
   }
   typeArrayOop value = java_lang_String::value(java_string);
   uint hash_code = compute_hash(value);
@@ -620,6 +622,7 @@ void StringDedup::Table::deduplicate(oop java_string) {
   if (tv.is_empty()) {
     // Not in table.  Create a new table entry.
     install(value, hash_code);
+    return false;
   } else {
     _cur_stat.inc_known();
     typeArrayOop found = cast_from_oop<typeArrayOop>(tv.resolve());
@@ -638,6 +641,41 @@ void StringDedup::Table::deduplicate(oop java_string) {
         _cur_stat.inc_replaced();
       }
     }
+    return true;
+  }
+}
+
+void StringDedup::Table::deduplicate_array_fields(oop holder) {
+  for (const InstanceKlass* ik = InstanceKlass::cast(holder->klass());
+       (ik != nullptr) && ik->has_dedup_array_fields();
+       ik = ik->java_super()) {
+    for (size_t i = 0; i < Config::array_field_count(); ++i) {
+      int offset = Config::array_field_offset(ik, i);
+      if (offset >= 0) {
+        deduplicate_array_field(holder, offset);
+      }
+    }
+  }
+}
+
+void StringDedup::Table::deduplicate_array_field(oop holder, int offset) {
+  oop obj = holder->obj_field(offset);
+  if (obj == nullptr) return;
+  typeArrayOop value = cast_from_oop<typeArrayOop>(obj);
+  _cur_stat.inc_inspected();
+  uint hash_code = compute_hash(value);
+  TableValue tv = find(value, hash_code);
+  if (tv.is_empty()) {
+    install(value, hash_code);
+  } else {
+    _cur_stat.inc_known();
+    typeArrayOop found = cast_from_oop<typeArrayOop>(tv.resolve());
+    assert(found != nullptr, "invariant");
+    // Don't replace an array that was stored into the field meanwhile.
+    if ((found != value) &&
+        (HeapAccess<>::oop_atomic_cmpxchg_at(holder, offset, obj, oop(found)) == obj)) {
+      _cur_stat.inc_deduped(found->size() * HeapWordSize);
+    }
   }
 }
 
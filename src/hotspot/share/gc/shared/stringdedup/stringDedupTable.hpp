@@ -98,6 +98,7 @@ class StringDedup::Table : AllStatic {
   static bool deduplicate_if_permitted(oop java_string, typeArrayOop value);
   static bool try_deduplicate_shared(oop java_string);
   static bool try_deduplicate_found_shared(oop java_string, oop found);
+  static void deduplicate_array_field(oop holder, int offset);
   static Bucket* make_buckets(size_t number_of_buckets, size_t reserve = 0);
   static void free_buckets(Bucket* buckets, size_t number_of_buckets);
 
@@ -114,8 +115,13 @@ class StringDedup::Table : AllStatic {
 
   // Deduplicate java_string.  If the table already contains the string's
   // data array, replace the string's data array with the one in the table.
-  // Otherwise, add the string's data array to the table.
-  static void deduplicate(oop java_string);
+  // Otherwise, add the string's data array to the table.  Returns true if
+  // an equivalent data array was already known.
+  static bool deduplicate(oop java_string);
+
+  // Deduplicate the byte[] values of the fields of holder that are listed
+  // in DeduplicateByteArrayFields, like the data array of a string.
+  static void deduplicate_array_fields(oop holder);
 
   // Returns true if table needs to grow.
   static bool is_grow_needed();
@@ -25,6 +25,7 @@
 
 #include "precompiled.hpp"
 #include "gc/shared/gc_globals.hpp"
+#include "gc/shared/gcWorkerTimeline.hpp"
 #include "gc/shared/taskTerminator.hpp"
 #include "gc/shared/taskqueue.hpp"
 #include "logging/log.hpp"
@@ -141,6 +142,7 @@ bool TaskTerminator::offer_termination(TerminatorTerminator* terminator) {
   }
 
   Thread* the_thread = Thread::current();
+  GCWorkerTimelineMark timeline_mark("Termination");
 
   MonitorLocker x(&_blocker, Mutex::_no_safepoint_check_flag);
   _offered_termination++;
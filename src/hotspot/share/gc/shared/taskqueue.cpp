@@ -36,6 +36,7 @@
 const char * const TaskQueueStats::_names[last_stat_id] = {
   "push", "pop", "pop-slow",
   "st-attempt", "st-empty", "st-ctdd", "st-success", "st-ctdd-max", "st-biasdrop",
+  "st-batch", "st-bt-tasks",
   "ovflw-push", "ovflw-max"
 };
 
@@ -88,9 +89,10 @@ void TaskQueueStats::print(outputStream* stream, unsigned int width) const
 // quiescent; they do not hold at arbitrary times.
 void TaskQueueStats::verify() const
 {
-  assert(get(push) == get(pop) + get(steal_success),
-         "push=%zu pop=%zu steal=%zu",
-         get(push), get(pop), get(steal_success));
+  // Tasks taken by a batched steal are pushed again onto the stealing queue.
+  assert(get(push) == get(pop) + get(steal_success) + get(steal_batch_tasks),
+         "push=%zu pop=%zu steal=%zu steal_batch_tasks=%zu",
+         get(push), get(pop), get(steal_success), get(steal_batch_tasks));
   assert(get(pop_slow) <= get(pop),
          "pop_slow=%zu pop=%zu",
          get(pop_slow), get(pop));
@@ -106,6 +108,12 @@ void TaskQueueStats::verify() const
   assert(get(steal_empty) + get(steal_contended) + get(steal_success) == get(steal_attempt),
          "steal_empty=%zu steal_contended=%zu steal_success=%zu steal_attempt=%zu",
          get(steal_empty), get(steal_contended), get(steal_success), get(steal_attempt));
+  assert(get(steal_batch) <= get(steal_success),
+         "steal_batch=%zu steal_success=%zu",
+         get(steal_batch), get(steal_success));
+  assert(get(steal_batch) <= get(steal_batch_tasks),
+         "steal_batch=%zu steal_batch_tasks=%zu",
+         get(steal_batch), get(steal_batch_tasks));
   assert(get(overflow) == 0 || get(push) != 0,
          "overflow=%zu push=%zu",
          get(overflow), get(push));
@@ -61,6 +61,8 @@ class TaskQueueStats {
     steal_success,    // number of successful steals
     steal_max_contended_in_a_row, // maximum number of contended steals in a row
     steal_bias_drop,  // number of times the bias has been dropped
+    steal_batch,      // subset of successful steals that took additional tasks
+    steal_batch_tasks, // number of additional tasks taken by batched steals
     overflow,         // number of overflow pushes
     overflow_max_len, // max length of overflow stack
     last_stat_id
@@ -82,6 +84,10 @@ class TaskQueueStats {
     }
   }
   inline void record_bias_drop() { ++_stats[steal_bias_drop]; }
+  inline void record_steal_batch(uint num_tasks) {
+    ++_stats[steal_batch];
+    _stats[steal_batch_tasks] += num_tasks;
+  }
   inline void record_overflow(size_t new_length);
 
   TaskQueueStats & operator +=(const TaskQueueStats & addend);
@@ -477,13 +483,34 @@ class GenericTaskQueueSet: public TaskQueueSetSuperImpl<F> {
   typedef typename T::PopResult PopResult;
 
 private:
+  static const int UnknownNumaId = -1;
+  // Maximum number of random draws looking for a victim on the same NUMA
+  // node as the thief before accepting any victim.
+  static const uint MaxNumaVictimDraws = 4;
+
   uint _n;
   T** _queues;
+  // NUMA node of the worker currently owning each queue, or UnknownNumaId.
+  // Only used to bias victim selection, so racy reads are benign.
+  int* _numa_ids;
+
+  // Returns a random queue id different from queue_num and exclude. If
+  // numa_id is known, prefers queues whose owner runs on that node.
+  uint select_victim(T* local_queue, uint queue_num, uint exclude, int numa_id);
 
   // Attempts to steal an element from a foreign queue (!= queue_num), setting
   // the result in t. Validity of this value and the return value is the same
-  // as for the last pop_global() operation.
-  PopResult steal_best_of_2(uint queue_num, E& t);
+  // as for the last pop_global() operation. On success, additionally moves up
+  // to max_batch - 1 elements from the same foreign queue to queue_num.
+  // If prefer_local, random victims are preferably selected from queues
+  // owned by workers on the same NUMA node as the owner of queue_num.
+  PopResult steal_best_of_2(uint queue_num, E& t, uint max_batch, bool prefer_local);
+
+  // Moves up to max_tasks elements from the global end of from_queue to the
+  // local end of to_queue, which must be owned by the current thread.
+  void steal_batch_into(T* to_queue, T* from_queue, uint max_tasks);
+
+  bool steal_inner(uint queue_num, E& t, uint max_batch);
 
 public:
   GenericTaskQueueSet(uint n);
@@ -495,10 +522,20 @@ class GenericTaskQueueSet: public TaskQueueSetSuperImpl<F> {
 
   T* queue(uint n);
 
+  // Records the NUMA node of the worker that owns the i'th queue for the
+  // next parallel phase. Used for victim selection with UseNUMAAwareStealing.
+  void set_numa_id(uint i, int numa_id);
+
   // Try to steal a task from some other queue than queue_num. It may perform several attempts at doing so.
   // Returns if stealing succeeds, and sets "t" to the stolen task.
   bool steal(uint queue_num, E& t);
 
+  // Like steal(), but on success also moves up to half of the remaining tasks of the
+  // foreign queue, at most WorkStealingBatchSize in total, to queue_num. This reduces
+  // the number of steal rounds when a few queues hold most of the work, as is typical
+  // when marking wide object graphs. Must only be called by the owner of queue_num.
+  bool steal_batch(uint queue_num, E& t);
+
   DEBUG_ONLY(virtual void assert_empty() const;)
 
   virtual uint tasks() const;
@@ -530,6 +567,12 @@ GenericTaskQueueSet<T, F>::queue(uint i) {
   return _queues[i];
 }
 
+template<class T, MEMFLAGS F> void
+GenericTaskQueueSet<T, F>::set_numa_id(uint i, int numa_id) {
+  assert(i < _n, "index out of range.");
+  _numa_ids[i] = numa_id;
+}
+
 #ifdef ASSERT
 template<class T, MEMFLAGS F>
 void GenericTaskQueueSet<T, F>::assert_empty() const {
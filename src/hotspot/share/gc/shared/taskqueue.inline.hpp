@@ -27,6 +27,7 @@
 
 #include "gc/shared/taskqueue.hpp"
 
+#include "gc/shared/gc_globals.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "memory/allocation.inline.hpp"
@@ -42,14 +43,17 @@ template <class T, MEMFLAGS F>
 inline GenericTaskQueueSet<T, F>::GenericTaskQueueSet(uint n) : _n(n) {
   typedef T* GenericTaskQueuePtr;
   _queues = NEW_C_HEAP_ARRAY(GenericTaskQueuePtr, n, F);
+  _numa_ids = NEW_C_HEAP_ARRAY(int, n, F);
   for (uint i = 0; i < n; i++) {
     _queues[i] = nullptr;
+    _numa_ids[i] = UnknownNumaId;
   }
 }
 
 template <class T, MEMFLAGS F>
 inline GenericTaskQueueSet<T, F>::~GenericTaskQueueSet() {
   FREE_C_HEAP_ARRAY(T*, _queues);
+  FREE_C_HEAP_ARRAY(int, _numa_ids);
 }
 
 #if TASKQUEUE_STATS
@@ -317,43 +321,83 @@ int GenericTaskQueue<E, F, N>::next_random_queue_id() {
 }
 
 template<class T, MEMFLAGS F>
-typename GenericTaskQueueSet<T, F>::PopResult GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t) {
+void GenericTaskQueueSet<T, F>::steal_batch_into(T* to_queue, T* from_queue, uint max_tasks) {
+  // Only the owner pushes to to_queue, and other threads only remove elements
+  // from it, so limiting the batch to the currently free space guarantees the
+  // pushes below can not fail or overflow.
+  uint free_space = to_queue->max_elems() - MIN2(to_queue->size(), to_queue->max_elems());
+  max_tasks = MIN2(max_tasks, free_space);
+
+  // Every element is separately claimed with pop_global(), so this does not
+  // change the concurrency protocol of the queue; a batch merely saves the
+  // victim selection and the failed attempts of later steal rounds.
+  uint num_tasks = 0;
+  E t;
+  while (num_tasks < max_tasks && from_queue->pop_global(t) == PopResult::Success) {
+    bool pushed = to_queue->push(t);
+    assert(pushed, "must succeed");
+    num_tasks++;
+  }
+  TASKQUEUE_STATS_ONLY(if (num_tasks > 0) { to_queue->stats.record_steal_batch(num_tasks); })
+}
+
+template<class T, MEMFLAGS F>
+uint GenericTaskQueueSet<T, F>::select_victim(T* local_queue, uint queue_num, uint exclude, int numa_id) {
+  uint k = queue_num;
+  uint draws = 0;
+  while (true) {
+    uint candidate = local_queue->next_random_queue_id() % _n;
+    if (candidate == queue_num || candidate == exclude) {
+      continue;
+    }
+    k = candidate;
+    if (numa_id == UnknownNumaId || _numa_ids[k] == numa_id || ++draws >= MaxNumaVictimDraws) {
+      return k;
+    }
+  }
+}
+
+template<class T, MEMFLAGS F>
+typename GenericTaskQueueSet<T, F>::PopResult GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t, uint max_batch, bool prefer_local) {
   T* const local_queue = queue(queue_num);
   if (_n > 2) {
+    int const numa_id = prefer_local ? _numa_ids[queue_num] : UnknownNumaId;
     uint k1 = queue_num;
 
     if (local_queue->is_last_stolen_queue_id_valid()) {
       k1 = local_queue->last_stolen_queue_id();
       assert(k1 != queue_num, "Should not be the same");
     } else {
-      while (k1 == queue_num) {
-        k1 = local_queue->next_random_queue_id() % _n;
-      }
+      k1 = select_victim(local_queue, queue_num, queue_num, numa_id);
     }
 
-    uint k2 = queue_num;
-    while (k2 == queue_num || k2 == k1) {
-      k2 = local_queue->next_random_queue_id() % _n;
-    }
+    uint k2 = select_victim(local_queue, queue_num, k1, numa_id);
     // Sample both and try the larger.
     uint sz1 = queue(k1)->size();
     uint sz2 = queue(k2)->size();
 
     uint sel_k = 0;
+    uint sel_sz = 0;
     PopResult suc = PopResult::Empty;
 
     if (sz2 > sz1) {
       sel_k = k2;
+      sel_sz = sz2;
       suc = queue(k2)->pop_global(t);
       TASKQUEUE_STATS_ONLY(local_queue->record_steal_attempt(suc);)
     } else if (sz1 > 0) {
       sel_k = k1;
+      sel_sz = sz1;
       suc = queue(k1)->pop_global(t);
       TASKQUEUE_STATS_ONLY(local_queue->record_steal_attempt(suc);)
     }
 
     if (suc == PopResult::Success) {
       local_queue->set_last_stolen_queue_id(sel_k);
+      if (max_batch > 1) {
+        // Take up to half of the elements of the victim.
+        steal_batch_into(local_queue, queue(sel_k), MIN2(max_batch - 1, sel_sz / 2));
+      }
     } else {
       local_queue->invalidate_last_stolen_queue_id();
     }
@@ -362,8 +406,12 @@ typename GenericTaskQueueSet<T, F>::PopResult GenericTaskQueueSet<T, F>::steal_b
   } else if (_n == 2) {
     // Just try the other one.
     uint k = (queue_num + 1) % 2;
+    uint sz = queue(k)->size();
     PopResult res = queue(k)->pop_global(t);
     TASKQUEUE_STATS_ONLY(local_queue->record_steal_attempt(res);)
+    if (res == PopResult::Success && max_batch > 1) {
+      steal_batch_into(local_queue, queue(k), MIN2(max_batch - 1, sz / 2));
+    }
     return res;
   } else {
     assert(_n == 1, "can't be zero.");
@@ -373,12 +421,15 @@ typename GenericTaskQueueSet<T, F>::PopResult GenericTaskQueueSet<T, F>::steal_b
 }
 
 template<class T, MEMFLAGS F>
-bool GenericTaskQueueSet<T, F>::steal(uint queue_num, E& t) {
+bool GenericTaskQueueSet<T, F>::steal_inner(uint queue_num, E& t, uint max_batch) {
   uint const num_retries = 2 * _n;
+  // Prefer victims on the same NUMA node during the first half of the
+  // attempts only, so that work on other nodes is still found.
+  uint const num_local_retries = UseNUMAAwareStealing ? _n : 0;
 
   TASKQUEUE_STATS_ONLY(uint contended_in_a_row = 0;)
   for (uint i = 0; i < num_retries; i++) {
-    PopResult sr = steal_best_of_2(queue_num, t);
+    PopResult sr = steal_best_of_2(queue_num, t, max_batch, i < num_local_retries);
     if (sr == PopResult::Success) {
       return true;
     } else if (sr == PopResult::Contended) {
@@ -394,6 +445,16 @@ bool GenericTaskQueueSet<T, F>::steal(uint queue_num, E& t) {
   return false;
 }
 
+template<class T, MEMFLAGS F>
+bool GenericTaskQueueSet<T, F>::steal(uint queue_num, E& t) {
+  return steal_inner(queue_num, t, 1);
+}
+
+template<class T, MEMFLAGS F>
+bool GenericTaskQueueSet<T, F>::steal_batch(uint queue_num, E& t) {
+  return steal_inner(queue_num, t, (uint)WorkStealingBatchSize);
+}
+
 template<class E, MEMFLAGS F, unsigned int N>
 template<class Fn>
 inline void GenericTaskQueue<E, F, N>::iterate(Fn fn) {
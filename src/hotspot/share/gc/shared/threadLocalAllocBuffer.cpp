@@ -56,7 +56,7 @@ ThreadLocalAllocBuffer::ThreadLocalAllocBuffer() :
   _gc_waste(0),
   _slow_allocations(0),
   _allocated_size(0),
-  _allocation_fraction(TLABAllocationWeight) {
+  _allocation_fraction(TLABAllocationWeight, TLABAllocationDeviationPadding) {
 
   // do nothing. TLABs must be inited by initialize() calls
 }
@@ -155,7 +155,13 @@ void ThreadLocalAllocBuffer::retire_before_allocation() {
 void ThreadLocalAllocBuffer::resize() {
   // Compute the next tlab size using expected allocation amount
   assert(ResizeTLAB, "Should not call this otherwise");
-  size_t alloc = (size_t)(_allocation_fraction.average() *
+  // With deviation padding, threads whose share of eden allocation varies a
+  // lot between GCs are sized for the upper end of their recent behavior
+  // rather than the average, so bursts need fewer refills.
+  float alloc_frac = TLABAllocationDeviationPadding > 0 ?
+                     MIN2(1.0f, _allocation_fraction.padded_average()) :
+                     _allocation_fraction.average();
+  size_t alloc = (size_t)(alloc_frac *
                           (Universe::heap()->tlab_capacity(thread()) / HeapWordSize));
   size_t new_size = alloc / _target_refills;
 
@@ -164,9 +170,10 @@ void ThreadLocalAllocBuffer::resize() {
   size_t aligned_new_size = align_object_size(new_size);
 
   log_trace(gc, tlab)("TLAB new size: thread: " PTR_FORMAT " [id: %2d]"
-                      " refills %d  alloc: %8.6f desired_size: " SIZE_FORMAT " -> " SIZE_FORMAT,
+                      " refills %d  alloc: %8.6f dev: %8.6f desired_size: " SIZE_FORMAT " -> " SIZE_FORMAT,
                       p2i(thread()), thread()->osthread()->thread_id(),
-                      _target_refills, _allocation_fraction.average(), desired_size(), aligned_new_size);
+                      _target_refills, _allocation_fraction.average(), _allocation_fraction.deviation(),
+                      desired_size(), aligned_new_size);
 
   set_desired_size(aligned_new_size);
   set_refill_waste_limit(initial_refill_waste_limit());
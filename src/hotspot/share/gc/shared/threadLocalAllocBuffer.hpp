@@ -68,7 +68,7 @@ class ThreadLocalAllocBuffer: public CHeapObj<mtThread> {
   unsigned  _slow_allocations;
   size_t    _allocated_size;
 
-  AdaptiveWeightedAverage _allocation_fraction;  // fraction of eden allocated in tlabs
+  AdaptivePaddedAverage _allocation_fraction;  // fraction of eden allocated in tlabs
 
   void reset_statistics();
 
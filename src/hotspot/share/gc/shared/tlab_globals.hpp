@@ -66,6 +66,12 @@
           "Allocation averaging weight")                                    \
           range(0, 100)                                                     \
                                                                             \
+  product(uintx, TLABAllocationDeviationPadding, 0, EXPERIMENTAL,           \
+          "Multiple of the mean deviation of a thread's allocation "        \
+          "fraction added to its average when resizing its TLAB; "          \
+          "zero sizes from the average only")                               \
+          range(0, 10)                                                      \
+                                                                            \
   /* At GC all TLABs are retired, and each thread's active  */              \
   /* TLAB is assumed to be half full on average. The        */              \
   /* remaining space is waste, proportional to TLAB size.   */              \
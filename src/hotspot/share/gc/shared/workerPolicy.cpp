@@ -117,6 +117,11 @@ uint WorkerPolicy::calc_default_active_workers(uintx total_workers,
 
   new_active_workers = MIN2(max_active_workers, (uintx) total_workers);
 
+  // Do not use more workers than there are processors available, which
+  // may have been reduced since the workers were created.
+  new_active_workers = MIN2(new_active_workers,
+                            MAX2(min_workers, (uintx) os::active_processor_count()));
+
   // Increase GC workers instantly but decrease them more
   // slowly.
   if (new_active_workers < prev_active_workers) {
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "gc/shared/gc_globals.hpp"
+#include "gc/shared/gcWorkerTimeline.hpp"
 #include "gc/shared/workerThread.hpp"
 #include "logging/log.hpp"
 #include "memory/iterator.hpp"
@@ -67,7 +68,10 @@ void WorkerTaskDispatcher::worker_run_task() {
 
   // Run task.
   GCIdMark gc_id_mark(_task->gc_id());
-  _task->work(worker_id);
+  {
+    GCWorkerTimelineMark timeline_mark(_task->name());
+    _task->work(worker_id);
+  }
 
   // Mark that the worker is done with the task.
   // The worker is not allowed to read the state variables after this line.
@@ -33,7 +33,10 @@
 #include "gc/shenandoah/shenandoahSimpleBitMap.inline.hpp"
 #include "logging/logStream.hpp"
 #include "memory/resourceArea.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
+#include "runtime/safepoint.hpp"
 
 static const char* partition_name(ShenandoahFreeSetPartitionId t) {
   switch (t) {
@@ -578,11 +581,72 @@ ShenandoahFreeSet::ShenandoahFreeSet(ShenandoahHeap* heap, size_t max_regions) :
   _heap(heap),
   _partitions(max_regions, this),
   _right_to_left_bias(false),
-  _alloc_bias_weight(0)
+  _alloc_bias_weight(0),
+  _direct_regions(nullptr),
+  _num_direct_regions((uint)ShenandoahDirectAllocationRegions)
 {
+  if (_num_direct_regions > 0) {
+    _direct_regions = NEW_C_HEAP_ARRAY(ShenandoahHeapRegion* volatile, _num_direct_regions, mtGC);
+    for (uint i = 0; i < _num_direct_regions; i++) {
+      _direct_regions[i] = nullptr;
+    }
+  }
   clear_internal();
 }
 
+inline uint ShenandoahFreeSet::direct_region_index() const {
+  return os::processor_id() % _num_direct_regions;
+}
+
+HeapWord* ShenandoahFreeSet::allocate_direct(ShenandoahAllocRequest& req) {
+  assert(req.is_mutator_alloc(), "Only mutators allocate without the heap lock");
+  if (_num_direct_regions == 0 || req.size() > ShenandoahHeapRegion::humongous_threshold_words()) {
+    return nullptr;
+  }
+  // Mutators call this in the VM without checking for safepoints, so the region cannot be
+  // released while it is used here.
+  ShenandoahHeapRegion* r = Atomic::load_acquire(&_direct_regions[direct_region_index()]);
+  if (r == nullptr) {
+    return nullptr;
+  }
+  return r->allocate_atomic(req);
+}
+
+void ShenandoahFreeSet::try_install_direct_region(ShenandoahHeapRegion* r) {
+  shenandoah_assert_heaplocked();
+  if (_num_direct_regions == 0) {
+    return;
+  }
+  size_t idx = r->index();
+  if (!_partitions.in_free_set(ShenandoahFreeSetPartitionId::Mutator, idx)) {
+    // The allocation has retired the region.
+    return;
+  }
+  ShenandoahHeapRegion* volatile* slot = &_direct_regions[direct_region_index()];
+  ShenandoahHeapRegion* current = Atomic::load(slot);
+  if (current != nullptr && current->free() >= PLAB::min_size() * HeapWordSize) {
+    // The current region can still serve TLABs, only this request did not fit into it.
+    return;
+  }
+  // The rest of the region is accounted as used by the Mutator partition from now on, the same way
+  // as a TLAB is. The remaining free memory is recovered when the free set is rebuilt.
+  _partitions.retire_from_partition(ShenandoahFreeSetPartitionId::Mutator, idx, r->used());
+  _partitions.assert_bounds();
+  log_debug(gc, free)("Using region " SIZE_FORMAT " for lock-free mutator allocation, replacing region " SSIZE_FORMAT,
+                      idx, current == nullptr ? (ssize_t)-1 : (ssize_t)current->index());
+  Atomic::release_store(slot, r);
+}
+
+void ShenandoahFreeSet::release_direct_regions() {
+  for (uint i = 0; i < _num_direct_regions; i++) {
+    if (_direct_regions[i] != nullptr) {
+      assert(SafepointSynchronize::is_at_safepoint(),
+             "Mutators may still allocate in region " SIZE_FORMAT, _direct_regions[i]->index());
+      _direct_regions[i] = nullptr;
+    }
+  }
+}
+
 HeapWord* ShenandoahFreeSet::allocate_single(ShenandoahAllocRequest& req, bool& in_new_region) {
   shenandoah_assert_heaplocked();
 
@@ -638,6 +702,7 @@ HeapWord* ShenandoahFreeSet::allocate_single(ShenandoahAllocRequest& req, bool&
             HeapWord* result;
             size_t min_size = (req.type() == ShenandoahAllocRequest::_alloc_tlab)? req.min_size(): req.size();
             if ((alloc_capacity(r) >= min_size) && ((result = try_allocate_in(r, req, in_new_region)) != nullptr)) {
+              try_install_direct_region(r);
               return result;
             }
             idx = _partitions.find_index_of_previous_available_region(ShenandoahFreeSetPartitionId::Mutator, idx - 1);
@@ -658,6 +723,7 @@ HeapWord* ShenandoahFreeSet::allocate_single(ShenandoahAllocRequest& req, bool&
             HeapWord* result;
             size_t min_size = (req.type() == ShenandoahAllocRequest::_alloc_tlab)? req.min_size(): req.size();
             if ((alloc_capacity(r) >= min_size) && ((result = try_allocate_in(r, req, in_new_region)) != nullptr)) {
+              try_install_direct_region(r);
               return result;
             }
             idx = _partitions.find_index_of_next_available_region(ShenandoahFreeSetPartitionId::Mutator, idx + 1);
@@ -868,9 +934,9 @@ HeapWord* ShenandoahFreeSet::allocate_contiguous(ShenandoahAllocRequest& req) {
     assert(r->is_empty(), "Should be empty");
 
     if (i == beg) {
-      r->make_humongous_start();
+      r->make_humongous_start(YOUNG_GENERATION);
     } else {
-      r->make_humongous_cont();
+      r->make_humongous_cont(YOUNG_GENERATION);
     }
 
     // Trailing region may be non-full, record the remainder there
@@ -1083,6 +1149,8 @@ void ShenandoahFreeSet::finish_rebuild(size_t cset_regions) {
 }
 
 void ShenandoahFreeSet::rebuild() {
+  // The rebuilt partitions include the free memory of the direct allocation regions.
+  release_direct_regions();
   size_t cset_regions;
   prepare_to_rebuild(cset_regions);
   finish_rebuild(cset_regions);
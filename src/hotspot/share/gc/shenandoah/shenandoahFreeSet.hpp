@@ -271,6 +271,19 @@ class ShenandoahFreeSet : public CHeapObj<mtGC> {
 
   const ssize_t _InitialAllocBiasWeight = 256;
 
+  // Regions that mutators allocate from with atomic bump allocation, without taking the heap lock. Each
+  // processor uses the slot selected by its processor id. A region is installed into a slot under the heap
+  // lock when it serves a locked mutator allocation, and it is retired from the Mutator partition at that
+  // point, so the locked allocation paths never see it again. The slots are released at safepoints before
+  // the collection set is chosen and before the free set is rebuilt.
+  ShenandoahHeapRegion* volatile* _direct_regions;
+  const uint _num_direct_regions;
+
+  inline uint direct_region_index() const;
+
+  // Install r into the direct allocation slot of the current processor if that slot is empty or exhausted.
+  void try_install_direct_region(ShenandoahHeapRegion* r);
+
   HeapWord* try_allocate_in(ShenandoahHeapRegion* region, ShenandoahAllocRequest& req, bool& in_new_region);
 
   // While holding the heap lock, allocate memory for a single object or LAB  which is to be entirely contained
@@ -350,6 +363,16 @@ class ShenandoahFreeSet : public CHeapObj<mtGC> {
   }
 
   HeapWord* allocate(ShenandoahAllocRequest& req, bool& in_new_region);
+
+  // Allocate a TLAB or shared object for a mutator from the direct allocation region of the current
+  // processor without taking the heap lock.  Returns null if there is no such region or if it cannot
+  // satisfy the request, in which case the caller falls back to allocate() under the heap lock.
+  HeapWord* allocate_direct(ShenandoahAllocRequest& req);
+
+  // Stop lock-free allocation in all direct allocation regions.  Their remaining free memory becomes
+  // available again when the free set is rebuilt.
+  void release_direct_regions();
+
   size_t unsafe_peek_free() const;
 
   /*
@@ -202,6 +202,7 @@ void ShenandoahFullGC::do_it(GCCause::Cause gc_cause) {
     heap->gclabs_retire(ResizeTLAB);
     heap->tlabs_retire(ResizeTLAB);
   }
+  heap->free_set()->release_direct_regions();
 
   OrderAccess::fence();
 
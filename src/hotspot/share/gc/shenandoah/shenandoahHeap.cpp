@@ -930,7 +930,10 @@ HeapWord* ShenandoahHeap::allocate_memory(ShenandoahAllocRequest& req) {
     }
 
     if (!ShenandoahAllocFailureALot || !should_inject_alloc_failure()) {
-      result = allocate_memory_under_lock(req, in_new_region);
+      result = _free_set->allocate_direct(req);
+      if (result == nullptr) {
+        result = allocate_memory_under_lock(req, in_new_region);
+      }
     }
 
     // Check that gc overhead is not exceeded.
@@ -1212,6 +1215,7 @@ void ShenandoahHeap::print_heap_regions_on(outputStream* st) const {
   st->print_cr("Heap Regions:");
   st->print_cr("Region state: EU=empty-uncommitted, EC=empty-committed, R=regular, H=humongous start, HP=pinned humongous start");
   st->print_cr("              HC=humongous continuation, CS=collection set, TR=trash, P=pinned, CSP=pinned collection set");
+  st->print_cr("Affiliation: F=free, Y=young, O=old");
   st->print_cr("BTE=bottom/top/end, TAMS=top-at-mark-start");
   st->print_cr("UWM=update watermark, U=used");
   st->print_cr("T=TLAB allocs, G=GCLAB allocs");
@@ -1813,6 +1817,9 @@ void ShenandoahHeap::prepare_regions_and_collection_set(bool concurrent) {
   {
     ShenandoahGCPhase phase(concurrent ? ShenandoahPhaseTimings::final_update_region_states :
                                          ShenandoahPhaseTimings::degen_gc_final_update_region_states);
+    // Mutators must not allocate into regions that may become part of the collection set.
+    _free_set->release_direct_regions();
+
     ShenandoahFinalMarkUpdateRegionStateClosure cl;
     parallel_heap_region_iterate(&cl);
 
@@ -63,6 +63,7 @@ ShenandoahHeapRegion::ShenandoahHeapRegion(HeapWord* start, size_t index, bool c
   _new_top(nullptr),
   _empty_time(os::elapsedTime()),
   _state(committed ? _empty_committed : _empty_uncommitted),
+  _affiliation(FREE),
   _top(start),
   _tlab_allocs(0),
   _gclab_allocs(0),
@@ -84,16 +85,19 @@ void ShenandoahHeapRegion::report_illegal_transition(const char *method) {
   fatal("%s", ss.freeze());
 }
 
-void ShenandoahHeapRegion::make_regular_allocation() {
+void ShenandoahHeapRegion::make_regular_allocation(ShenandoahAffiliation affiliation) {
   shenandoah_assert_heaplocked();
 
   switch (_state) {
     case _empty_uncommitted:
       do_commit();
     case _empty_committed:
+      set_affiliation(affiliation);
       set_state(_regular);
     case _regular:
     case _pinned:
+      assert(_affiliation == affiliation, "Region " SIZE_FORMAT " allocated in %s, but is %s", index(),
+             shenandoah_affiliation_name(affiliation), shenandoah_affiliation_name(_affiliation));
       return;
     default:
       report_illegal_transition("regular allocation");
@@ -109,6 +113,7 @@ void ShenandoahHeapRegion::make_regular_bypass() {
     case _empty_uncommitted:
       do_commit();
     case _empty_committed:
+      set_affiliation(YOUNG_GENERATION);
     case _cset:
     case _humongous_start:
     case _humongous_cont:
@@ -125,12 +130,13 @@ void ShenandoahHeapRegion::make_regular_bypass() {
   }
 }
 
-void ShenandoahHeapRegion::make_humongous_start() {
+void ShenandoahHeapRegion::make_humongous_start(ShenandoahAffiliation affiliation) {
   shenandoah_assert_heaplocked();
   switch (_state) {
     case _empty_uncommitted:
       do_commit();
     case _empty_committed:
+      set_affiliation(affiliation);
       set_state(_humongous_start);
       return;
     default:
@@ -144,6 +150,7 @@ void ShenandoahHeapRegion::make_humongous_start_bypass() {
 
   switch (_state) {
     case _empty_committed:
+      set_affiliation(YOUNG_GENERATION);
     case _regular:
     case _humongous_start:
     case _humongous_cont:
@@ -154,13 +161,14 @@ void ShenandoahHeapRegion::make_humongous_start_bypass() {
   }
 }
 
-void ShenandoahHeapRegion::make_humongous_cont() {
+void ShenandoahHeapRegion::make_humongous_cont(ShenandoahAffiliation affiliation) {
   shenandoah_assert_heaplocked();
   switch (_state) {
     case _empty_uncommitted:
       do_commit();
     case _empty_committed:
-     set_state(_humongous_cont);
+      set_affiliation(affiliation);
+      set_state(_humongous_cont);
       return;
     default:
       report_illegal_transition("humongous continuation allocation");
@@ -173,6 +181,7 @@ void ShenandoahHeapRegion::make_humongous_cont_bypass() {
 
   switch (_state) {
     case _empty_committed:
+      set_affiliation(YOUNG_GENERATION);
     case _regular:
     case _humongous_start:
     case _humongous_cont:
@@ -269,6 +278,7 @@ void ShenandoahHeapRegion::make_empty() {
   switch (_state) {
     case _trash:
       set_state(_empty_committed);
+      set_affiliation(FREE);
       _empty_time = os::elapsedTime();
       return;
     default:
@@ -363,6 +373,8 @@ void ShenandoahHeapRegion::print_on(outputStream* st) const {
       ShouldNotReachHere();
   }
 
+  st->print("|%s", shenandoah_affiliation_code(_affiliation));
+
 #define SHR_PTR_FORMAT "%12" PRIxPTR
 
   st->print("|BTE " SHR_PTR_FORMAT  ", " SHR_PTR_FORMAT ", " SHR_PTR_FORMAT,
@@ -656,6 +668,12 @@ void ShenandoahHeapRegion::set_state(RegionState to) {
   _state = to;
 }
 
+void ShenandoahHeapRegion::set_affiliation(ShenandoahAffiliation affiliation) {
+  assert(affiliation != FREE || is_empty() || is_trash(),
+         "Region " SIZE_FORMAT " must be empty to become free", index());
+  _affiliation = affiliation;
+}
+
 void ShenandoahHeapRegion::record_pin() {
   Atomic::add(&_critical_pins, (size_t)1);
 }
@@ -27,6 +27,7 @@
 
 #include "gc/shared/gc_globals.hpp"
 #include "gc/shared/spaceDecorator.hpp"
+#include "gc/shenandoah/shenandoahAffiliation.hpp"
 #include "gc/shenandoah/shenandoahAllocRequest.hpp"
 #include "gc/shenandoah/shenandoahAsserts.hpp"
 #include "gc/shenandoah/shenandoahHeap.hpp"
@@ -167,10 +168,10 @@ class ShenandoahHeapRegion {
   }
 
   // Allowed transitions from the outside code:
-  void make_regular_allocation();
+  void make_regular_allocation(ShenandoahAffiliation affiliation);
   void make_regular_bypass();
-  void make_humongous_start();
-  void make_humongous_cont();
+  void make_humongous_start(ShenandoahAffiliation affiliation);
+  void make_humongous_cont(ShenandoahAffiliation affiliation);
   void make_humongous_start_bypass();
   void make_humongous_cont_bypass();
   void make_pinned();
@@ -205,6 +206,12 @@ class ShenandoahHeapRegion {
   RegionState state()              const { return _state; }
   int  state_ordinal()             const { return region_state_to_ordinal(_state); }
 
+  // Generation affiliation: empty regions are FREE, all others belong to a generation
+  ShenandoahAffiliation affiliation() const { return _affiliation; }
+  bool is_affiliated()             const { return _affiliation != FREE; }
+  bool is_young()                  const { return _affiliation == YOUNG_GENERATION; }
+  bool is_old()                    const { return _affiliation == OLD_GENERATION; }
+
   void record_pin();
   void record_unpin();
   size_t pin_count() const;
@@ -233,6 +240,7 @@ class ShenandoahHeapRegion {
 
   // Seldom updated fields
   RegionState _state;
+  ShenandoahAffiliation _affiliation;
 
   // Frequently updated fields
   HeapWord* _top;
@@ -336,6 +344,11 @@ class ShenandoahHeapRegion {
   // Allocation (return null if full)
   inline HeapWord* allocate(size_t word_size, ShenandoahAllocRequest::Type type);
 
+  // Lock-free mutator allocation in a region that is owned by the free set's
+  // direct allocation regions (return null if full). LAB requests are shrunk
+  // to the remaining free memory as long as it satisfies their minimum size.
+  inline HeapWord* allocate_atomic(ShenandoahAllocRequest& req);
+
   inline void clear_live_data();
   void set_live_data(size_t s);
 
@@ -397,6 +410,7 @@ class ShenandoahHeapRegion {
   inline void internal_increase_live_data(size_t s);
 
   void set_state(RegionState to);
+  void set_affiliation(ShenandoahAffiliation affiliation);
 };
 
 #endif // SHARE_GC_SHENANDOAH_SHENANDOAHHEAPREGION_HPP
@@ -37,7 +37,7 @@ HeapWord* ShenandoahHeapRegion::allocate(size_t size, ShenandoahAllocRequest::Ty
 
   HeapWord* obj = top();
   if (pointer_delta(end(), obj) >= size) {
-    make_regular_allocation();
+    make_regular_allocation(YOUNG_GENERATION);
     adjust_alloc_metadata(type, size);
 
     HeapWord* new_top = obj + size;
@@ -52,6 +52,36 @@ HeapWord* ShenandoahHeapRegion::allocate(size_t size, ShenandoahAllocRequest::Ty
   }
 }
 
+HeapWord* ShenandoahHeapRegion::allocate_atomic(ShenandoahAllocRequest& req) {
+  assert(req.is_mutator_alloc(), "Only mutators allocate without the heap lock");
+  assert(is_regular() || is_pinned(), "Region " SIZE_FORMAT " should already be allocated", index());
+
+  HeapWord* obj = Atomic::load(&_top);
+  for (;;) {
+    size_t free_words = pointer_delta(end(), obj);
+    size_t size = req.size();
+    if (req.is_lab_alloc()) {
+      size = MIN2(size, align_down(free_words, MinObjAlignment));
+      if (size < req.min_size()) {
+        return nullptr;
+      }
+    } else if (size > free_words) {
+      return nullptr;
+    }
+
+    HeapWord* witness = Atomic::cmpxchg(&_top, obj, obj + size);
+    if (witness == obj) {
+      if (req.type() == ShenandoahAllocRequest::_alloc_tlab) {
+        Atomic::add(&_tlab_allocs, size, memory_order_relaxed);
+      }
+      assert(is_object_aligned(obj), "obj is not aligned: " PTR_FORMAT, p2i(obj));
+      req.set_actual_size(size);
+      return obj;
+    }
+    obj = witness;
+  }
+}
+
 inline void ShenandoahHeapRegion::adjust_alloc_metadata(ShenandoahAllocRequest::Type type, size_t size) {
   switch (type) {
     case ShenandoahAllocRequest::_alloc_shared:
@@ -181,7 +181,7 @@ void ShenandoahMark::mark_loop_work(T* cl, ShenandoahLiveData* live_data, uint w
     uint work = 0;
     for (uint i = 0; i < stride; i++) {
       if (q->pop(t) ||
-          queues->steal(worker_id, t)) {
+          queues->steal_batch(worker_id, t)) {
         do_task<T, GENERATION, STRING_DEDUP>(q, cl, live_data, req, &t);
         work++;
       } else {
@@ -28,6 +28,7 @@
 #include "gc/shenandoah/shenandoahHeap.inline.hpp"
 #include "gc/shenandoah/shenandoahPacer.hpp"
 #include "gc/shenandoah/shenandoahPhaseTimings.hpp"
+#include "jfr/jfrEvents.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/javaThread.inline.hpp"
 #include "runtime/mutexLocker.hpp"
@@ -71,6 +72,7 @@ void ShenandoahPacer::setup_for_mark() {
   tax *= ShenandoahPacingSurcharge;  // additional surcharge to help unclutter heap
 
   restart_with(non_taxable, tax);
+  restart_prediction(live >> LogHeapWordSize, 1);
 
   log_info(gc, ergo)("Pacer for Mark. Expected Live: " SIZE_FORMAT "%s, Free: " SIZE_FORMAT "%s, "
                      "Non-Taxable: " SIZE_FORMAT "%s, Alloc Tax Rate: %.1fx",
@@ -95,6 +97,7 @@ void ShenandoahPacer::setup_for_evac() {
   tax *= ShenandoahPacingSurcharge;  // additional surcharge to help unclutter heap
 
   restart_with(non_taxable, tax);
+  restart_prediction(used >> LogHeapWordSize, 2);
 
   log_info(gc, ergo)("Pacer for Evacuation. Used CSet: " SIZE_FORMAT "%s, Free: " SIZE_FORMAT "%s, "
                      "Non-Taxable: " SIZE_FORMAT "%s, Alloc Tax Rate: %.1fx",
@@ -119,6 +122,7 @@ void ShenandoahPacer::setup_for_updaterefs() {
   tax *= ShenandoahPacingSurcharge;  // additional surcharge to help unclutter heap
 
   restart_with(non_taxable, tax);
+  restart_prediction(used >> LogHeapWordSize, 1);
 
   log_info(gc, ergo)("Pacer for Update Refs. Used: " SIZE_FORMAT "%s, Free: " SIZE_FORMAT "%s, "
                      "Non-Taxable: " SIZE_FORMAT "%s, Alloc Tax Rate: %.1fx",
@@ -144,6 +148,7 @@ void ShenandoahPacer::setup_for_idle() {
   double tax = 1;
 
   restart_with(initial, tax);
+  restart_prediction(0, 1);
 
   log_info(gc, ergo)("Pacer for Idle. Initial: " SIZE_FORMAT "%s, Alloc Tax Rate: %.1fx",
                      byte_size_in_proper_unit(initial), proper_unit_for_byte_size(initial),
@@ -160,6 +165,7 @@ void ShenandoahPacer::setup_for_reset() {
 
   size_t initial = _heap->max_capacity();
   restart_with(initial, 1.0);
+  restart_prediction(0, 1);
 
   log_info(gc, ergo)("Pacer for Reset. Non-Taxable: " SIZE_FORMAT "%s",
                      byte_size_in_proper_unit(initial), proper_unit_for_byte_size(initial));
@@ -189,6 +195,74 @@ void ShenandoahPacer::restart_with(size_t non_taxable_bytes, double tax_rate) {
   _need_notify_waiters.try_set();
 }
 
+void ShenandoahPacer::restart_prediction(size_t work_words, double remaining_factor) {
+  if (!ShenandoahPacingPredictive) {
+    return;
+  }
+
+  // Publish the phase work last, update_prediction() reads it first.
+  Atomic::store(&_phase_progress, size_t(0));
+  Atomic::store(&_phase_start_time, os::elapsedTime());
+  Atomic::store(&_phase_remaining_factor, remaining_factor);
+  Atomic::release_store(&_phase_work, work_words);
+
+  // Pace as usual until there is enough progress to predict from.
+  _pacing_needed.set();
+}
+
+/*
+ * Predictive pacing compares two projections, refreshed by the periodic notify task:
+ *
+ * The projected completion time of the cycle is the remaining work of the current
+ * phase divided by the GC progress rate seen so far in this phase. As with the tax
+ * rates above, it is scaled to account for the phases that follow: evac is followed
+ * by update-refs that take about the same time.
+ *
+ * The projected exhaustion time is the free space divided by the decaying average of
+ * the allocation rate, with the same margin of error as the adaptive heuristics.
+ *
+ * Allocators only have to be paced when the cycle would not complete before the free
+ * space is exhausted. The tax-and-spend budget is still maintained, so that pacing
+ * resumes from a consistent state as soon as the projections say it is needed.
+ */
+
+void ShenandoahPacer::update_prediction() {
+  if (!ShenandoahPacingPredictive) {
+    return;
+  }
+
+  _alloc_rate.sample(_heap->bytes_allocated_since_gc_start());
+
+  size_t work = Atomic::load_acquire(&_phase_work);
+  if (work == 0) {
+    // No notion of progress in this phase, pace as usual.
+    _pacing_needed.set();
+    return;
+  }
+
+  double elapsed = os::elapsedTime() - Atomic::load(&_phase_start_time);
+  size_t progress = Atomic::load(&_phase_progress);
+  if (progress == 0 || elapsed <= 0) {
+    // No progress rate to predict from yet, pace as usual.
+    _pacing_needed.set();
+    return;
+  }
+
+  double gc_rate = progress / elapsed;
+  size_t remaining = (work > progress) ? (work - progress) : 0;
+  double time_to_complete = remaining / gc_rate * Atomic::load(&_phase_remaining_factor);
+
+  double alloc_rate = _alloc_rate.upper_bound(ShenandoahAdaptiveInitialConfidence);
+  size_t free = _heap->free_set()->available();
+  double time_to_exhaust = (alloc_rate > 0) ? (free / alloc_rate) : DBL_MAX;
+
+  if (time_to_complete * ShenandoahPacingSurcharge < time_to_exhaust) {
+    _pacing_needed.unset();
+  } else {
+    _pacing_needed.set();
+  }
+}
+
 bool ShenandoahPacer::claim_for_alloc(size_t words, bool force) {
   assert(ShenandoahPacing, "Only be here when pacing is enabled");
 
@@ -239,6 +313,12 @@ void ShenandoahPacer::pace_for_alloc(size_t words) {
   claimed = claim_for_alloc(words, true);
   assert(claimed, "Should always succeed");
 
+  // The cycle is projected to complete before free space is exhausted,
+  // no need to wait for GC progress.
+  if (ShenandoahPacingPredictive && !_pacing_needed.is_set()) {
+    return;
+  }
+
   // Threads that are attaching should not block at all: they are not
   // fully initialized yet. Blocking them would be awkward.
   // This is probably the path that allocates the thread oop itself.
@@ -252,6 +332,7 @@ void ShenandoahPacer::pace_for_alloc(size_t words) {
     return;
   }
 
+  EventShenandoahAllocationPacing event;
   double start = os::elapsedTime();
 
   size_t max_ms = ShenandoahPacingMaxDelay;
@@ -272,6 +353,7 @@ void ShenandoahPacer::pace_for_alloc(size_t words) {
       //     and start Degenerated GC cycle.
       //  b) The budget had been replenished, which means our claim is satisfied.
       ShenandoahThreadLocalData::add_paced_time(JavaThread::current(), end - start);
+      event.commit(words * HeapWordSize);
       break;
     }
   }
@@ -341,5 +423,6 @@ void ShenandoahPacer::print_cycle_on(outputStream* out) {
 
 void ShenandoahPeriodicPacerNotifyTask::task() {
   assert(ShenandoahPacing, "Should not be here otherwise");
+  _pacer->update_prediction();
   _pacer->notify_waiters();
 }
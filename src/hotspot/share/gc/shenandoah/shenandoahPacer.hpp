@@ -25,6 +25,7 @@
 #ifndef SHARE_GC_SHENANDOAH_SHENANDOAHPACER_HPP
 #define SHARE_GC_SHENANDOAH_SHENANDOAHPACER_HPP
 
+#include "gc/shenandoah/heuristics/shenandoahAdaptiveHeuristics.hpp"
 #include "gc/shenandoah/shenandoahNumberSeq.hpp"
 #include "gc/shenandoah/shenandoahPadding.hpp"
 #include "gc/shenandoah/shenandoahSharedVariables.hpp"
@@ -56,6 +57,10 @@ class ShenandoahPeriodicPacerNotifyTask : public PeriodicTask {
  *
  * Currently it implements simple tax-and-spend pacing policy: GC threads provide
  * credit, allocating thread spend the credit, or stall when credit is not available.
+ *
+ * With ShenandoahPacingPredictive, allocating threads only stall when the budget is
+ * depleted and the current prediction says the cycle would not complete before
+ * free memory is exhausted (see update_prediction()).
  */
 class ShenandoahPacer : public CHeapObj<mtGC> {
 private:
@@ -70,6 +75,13 @@ class ShenandoahPacer : public CHeapObj<mtGC> {
   volatile intptr_t _epoch;
   volatile double _tax_rate;
 
+  // Predictive pacing state, set once per phase and sampled periodically
+  ShenandoahAllocationRate _alloc_rate;
+  ShenandoahSharedFlag _pacing_needed;
+  volatile double _phase_start_time;
+  volatile size_t _phase_work;
+  volatile double _phase_remaining_factor;
+
   // Heavily updated, protect from accidental false sharing
   shenandoah_padding(0);
   volatile intptr_t _budget;
@@ -80,6 +92,11 @@ class ShenandoahPacer : public CHeapObj<mtGC> {
   volatile intptr_t _progress;
   shenandoah_padding(3);
 
+  // Heavily updated, protect from accidental false sharing
+  shenandoah_padding(4);
+  volatile size_t _phase_progress;
+  shenandoah_padding(5);
+
 public:
   explicit ShenandoahPacer(ShenandoahHeap* heap) :
           _heap(heap),
@@ -89,8 +106,15 @@ class ShenandoahPacer : public CHeapObj<mtGC> {
           _notify_waiters_task(this),
           _epoch(0),
           _tax_rate(1),
+          _alloc_rate(),
+          _pacing_needed(),
+          _phase_start_time(0),
+          _phase_work(0),
+          _phase_remaining_factor(1),
           _budget(0),
-          _progress(PACING_PROGRESS_UNINIT) {
+          _progress(PACING_PROGRESS_UNINIT),
+          _phase_progress(0) {
+    _pacing_needed.set();
     _notify_waiters_task.enroll();
   }
 
@@ -112,6 +136,7 @@ class ShenandoahPacer : public CHeapObj<mtGC> {
   void unpace_for_alloc(intptr_t epoch, size_t words);
 
   void notify_waiters();
+  void update_prediction();
 
   intptr_t epoch();
 
@@ -121,9 +146,11 @@ class ShenandoahPacer : public CHeapObj<mtGC> {
 private:
   inline void report_internal(size_t words);
   inline void report_progress_internal(size_t words);
+  inline void report_phase_progress(size_t words);
 
   inline void add_budget(size_t words);
   void restart_with(size_t non_taxable_bytes, double tax_rate);
+  void restart_prediction(size_t work_words, double remaining_factor);
 
   size_t update_and_get_progress_history();
 
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 
+#include "gc/shared/gcWorkerTimeline.hpp"
 #include "gc/shared/workerDataArray.inline.hpp"
 #include "gc/shenandoah/shenandoahCollectorPolicy.hpp"
 #include "gc/shenandoah/shenandoahPhaseTimings.hpp"
@@ -315,10 +316,12 @@ ShenandoahWorkerTimingsTracker::ShenandoahWorkerTimingsTracker(ShenandoahPhaseTi
   assert(_timings->worker_data(_phase, _par_phase)->get(_worker_id) == ShenandoahWorkerData::uninitialized(),
          "Should not be set yet: %s", ShenandoahPhaseTimings::phase_name(_timings->worker_par_phase(_phase, _par_phase)));
   _start_time = os::elapsedTime();
+  GCWorkerTimeline::begin(ShenandoahPhaseTimings::phase_name(_timings->worker_par_phase(_phase, _par_phase)));
 }
 
 ShenandoahWorkerTimingsTracker::~ShenandoahWorkerTimingsTracker() {
   _timings->worker_data(_phase, _par_phase)->set(_worker_id, os::elapsedTime() - _start_time);
+  GCWorkerTimeline::end(ShenandoahPhaseTimings::phase_name(_timings->worker_par_phase(_phase, _par_phase)));
 
   if (ShenandoahPhaseTimings::is_root_work_phase(_phase)) {
     ShenandoahPhaseTimings::Phase root_phase = _phase;
@@ -234,6 +234,14 @@
           "reserve/waste is incorrect, at the risk that application "       \
           "runs out of memory too early.")                                  \
                                                                             \
+  product(uintx, ShenandoahDirectAllocationRegions, 0, EXPERIMENTAL,        \
+          "Number of regions that mutators allocate TLABs and shared "      \
+          "objects from with atomic bump allocation, without taking "       \
+          "the heap lock. Each processor uses one of these regions, and "   \
+          "only takes the heap lock when it is exhausted. Zero disables "   \
+          "lock-free mutator allocation.")                                  \
+          range(0, 1024)                                                    \
+                                                                            \
   product(bool, ShenandoahPacing, true, EXPERIMENTAL,                       \
           "Pace application allocations to give GC chance to start "        \
           "and complete before allocation failure is reached.")             \
@@ -268,6 +276,13 @@
           "the beginning of it.")                                           \
           range(1.0, 100.0)                                                 \
                                                                             \
+  product(bool, ShenandoahPacingPredictive, false, EXPERIMENTAL,            \
+          "Pace allocations only when the projected completion of the "     \
+          "current GC cycle, computed from the GC progress rate, is "       \
+          "later than the projected exhaustion of free memory, computed "   \
+          "from the allocation rate. Avoids pacing delays in cycles that "  \
+          "would complete in time anyway.")                                 \
+                                                                            \
   product(uintx, ShenandoahCriticalFreeThreshold, 1, EXPERIMENTAL,          \
           "How much of the heap needs to be free after recovery cycles, "   \
           "either Degenerated or Full GC to be claimed successful. If this "\
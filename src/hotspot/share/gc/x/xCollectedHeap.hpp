@@ -111,6 +111,7 @@ class XCollectedHeap : public CollectedHeap {
 
   void pin_object(JavaThread* thread, oop obj) override;
   void unpin_object(JavaThread* thread, oop obj) override;
+  bool pin_object_blocks_gc() const override { return true; }
 
   void print_on(outputStream* st) const override;
   void print_on_error(outputStream* st) const override;
@@ -110,6 +110,10 @@ size_t ZCollectedHeap::max_capacity() const {
   return _heap.max_capacity();
 }
 
+void ZCollectedHeap::soft_max_heap_size_changed() {
+  _heap.soft_max_capacity_changed();
+}
+
 size_t ZCollectedHeap::capacity() const {
   return _heap.capacity();
 }
@@ -66,6 +66,7 @@ class ZCollectedHeap : public CollectedHeap {
   void stop() override;
 
   size_t max_capacity() const override;
+  void soft_max_heap_size_changed() override;
   size_t capacity() const override;
   size_t used() const override;
   size_t unused() const override;
@@ -97,6 +97,11 @@ static const ZStatPhasePause      ZPhasePauseRelocateStartOld("Pause Relocate St
 static const ZStatPhaseConcurrent ZPhaseConcurrentRelocatedOld("Concurrent Relocate", ZGenerationId::old);
 static const ZStatPhaseConcurrent ZPhaseConcurrentRemapRootsOld("Concurrent Remap Roots", ZGenerationId::old);
 
+static const ZStatSubPhase ZSubPhaseConcurrentSelectRelocationSetRegisterYoung("Concurrent Select Relocation Set Register", ZGenerationId::young);
+static const ZStatSubPhase ZSubPhaseConcurrentSelectRelocationSetRegisterOld("Concurrent Select Relocation Set Register", ZGenerationId::old);
+static const ZStatSubPhase ZSubPhaseConcurrentSelectRelocationSetSelectYoung("Concurrent Select Relocation Set Select", ZGenerationId::young);
+static const ZStatSubPhase ZSubPhaseConcurrentSelectRelocationSetSelectOld("Concurrent Select Relocation Set Select", ZGenerationId::old);
+
 static const ZStatSubPhase ZSubPhaseConcurrentMarkRootsYoung("Concurrent Mark Roots", ZGenerationId::young);
 static const ZStatSubPhase ZSubPhaseConcurrentMarkFollowYoung("Concurrent Mark Follow", ZGenerationId::young);
 
@@ -187,58 +192,136 @@ static double fragmentation_limit(ZGenerationId generation) {
   }
 }
 
+class ZSelectRelocationSetTask : public ZTask {
+private:
+  ZGenerationPagesParallelIterator _iter;
+  const double                     _fragmentation_limit;
+  const uint                       _nworkers;
+  ZRelocationSetSelector** const   _selectors;
+  volatile uint                    _nstarted;
+
+public:
+  ZSelectRelocationSetTask(ZPageTable* page_table, ZGenerationId id, ZPageAllocator* page_allocator,
+                           double fragmentation_limit, uint nworkers)
+    : ZTask("ZSelectRelocationSetTask"),
+      _iter(page_table, id, page_allocator),
+      _fragmentation_limit(fragmentation_limit),
+      _nworkers(nworkers),
+      _selectors(NEW_C_HEAP_ARRAY(ZRelocationSetSelector*, nworkers, mtGC)),
+      _nstarted(0) {}
+
+  ~ZSelectRelocationSetTask() {
+    for (uint i = 0; i < _nstarted; i++) {
+      delete _selectors[i];
+    }
+    FREE_C_HEAP_ARRAY(ZRelocationSetSelector*, _selectors);
+  }
+
+  virtual void work() {
+    const uint index = Atomic::fetch_then_add(&_nstarted, 1u);
+    assert(index < _nworkers, "Too many workers");
+    ZRelocationSetSelector* const selector = new ZRelocationSetSelector(_fragmentation_limit);
+    _selectors[index] = selector;
+
+    _iter.do_pages([&](ZPage* page) {
+      // See register_relocation_set_pages() for why
+      // this property is stable for concurrently freed pages.
+      if (page->is_relocatable()) {
+        if (page->is_marked()) {
+          selector->register_live_page(page);
+        } else {
+          selector->register_empty_page(page);
+        }
+      }
+      return true;
+    });
+  }
+
+  void merge_into(ZRelocationSetSelector* selector) {
+    for (uint i = 0; i < _nstarted; i++) {
+      selector->merge(_selectors[i]);
+    }
+  }
+};
+
+void ZGeneration::register_relocation_set_pages(ZRelocationSetSelector* selector) {
+  ZGenerationPagesIterator pt_iter(_page_table, _id, _page_allocator);
+  for (ZPage* page; pt_iter.next(&page);) {
+    if (!page->is_relocatable()) {
+      // Not relocatable, don't register
+      // Note that the seqnum can change under our feet here as the page
+      // can be concurrently freed and recycled by a concurrent generation
+      // collection. However this property is stable across such transitions.
+      // If it was not relocatable before recycling, then it won't be
+      // relocatable after it gets recycled either, as the seqnum atomically
+      // becomes allocating for the given generation. The opposite property
+      // also holds: if the page is relocatable, then it can't have been
+      // concurrently freed; if it was re-allocated it would not be
+      // relocatable, and if it was not re-allocated we know that it was
+      // allocated earlier than mark start of the current generation
+      // collection.
+      continue;
+    }
+
+    if (page->is_marked()) {
+      // Register live page
+      selector->register_live_page(page);
+    } else {
+      // Register empty page
+      selector->register_empty_page(page);
+
+      // Reclaim empty pages in bulk
+
+      // An active iterator blocks immediate recycle and delete of pages.
+      // The intent it to allow the code that iterates over the pages to
+      // safely read the properties of the pages without them being changed
+      // by another thread. However, this function both iterates over the
+      // pages AND frees/recycles them. We "yield" the iterator, so that we
+      // can perform immediate recycling (as long as no other thread is
+      // iterating over the pages). The contract is that the pages that are
+      // about to be freed are "owned" by this thread, and no other thread
+      // will change their states.
+      pt_iter.yield([&]() {
+        free_empty_pages(selector, 64 /* bulk */);
+      });
+    }
+  }
+
+  // Reclaim remaining empty pages
+  free_empty_pages(selector, 0 /* bulk */);
+}
+
+void ZGeneration::register_relocation_set_pages_parallel(ZRelocationSetSelector* selector, ZGenerationId generation) {
+  {
+    ZSelectRelocationSetTask task(_page_table, _id, _page_allocator,
+                                  fragmentation_limit(generation), _workers.active_workers());
+    workers()->run(&task);
+    task.merge_into(selector);
+  }
+
+  // Reclaim empty pages, now that the pages are no longer iterated over
+  free_empty_pages(selector, 0 /* bulk */);
+}
+
 void ZGeneration::select_relocation_set(ZGenerationId generation, bool promote_all) {
   // Register relocatable pages with selector
   ZRelocationSetSelector selector(fragmentation_limit(generation));
   {
-    ZGenerationPagesIterator pt_iter(_page_table, _id, _page_allocator);
-    for (ZPage* page; pt_iter.next(&page);) {
-      if (!page->is_relocatable()) {
-        // Not relocatable, don't register
-        // Note that the seqnum can change under our feet here as the page
-        // can be concurrently freed and recycled by a concurrent generation
-        // collection. However this property is stable across such transitions.
-        // If it was not relocatable before recycling, then it won't be
-        // relocatable after it gets recycled either, as the seqnum atomically
-        // becomes allocating for the given generation. The opposite property
-        // also holds: if the page is relocatable, then it can't have been
-        // concurrently freed; if it was re-allocated it would not be
-        // relocatable, and if it was not re-allocated we know that it was
-        // allocated earlier than mark start of the current generation
-        // collection.
-        continue;
-      }
-
-      if (page->is_marked()) {
-        // Register live page
-        selector.register_live_page(page);
-      } else {
-        // Register empty page
-        selector.register_empty_page(page);
-
-        // Reclaim empty pages in bulk
-
-        // An active iterator blocks immediate recycle and delete of pages.
-        // The intent it to allow the code that iterates over the pages to
-        // safely read the properties of the pages without them being changed
-        // by another thread. However, this function both iterates over the
-        // pages AND frees/recycles them. We "yield" the iterator, so that we
-        // can perform immediate recycling (as long as no other thread is
-        // iterating over the pages). The contract is that the pages that are
-        // about to be freed are "owned" by this thread, and no other thread
-        // will change their states.
-        pt_iter.yield([&]() {
-          free_empty_pages(&selector, 64 /* bulk */);
-        });
-      }
+    ZStatTimer timer(is_young() ? ZSubPhaseConcurrentSelectRelocationSetRegisterYoung
+                                : ZSubPhaseConcurrentSelectRelocationSetRegisterOld);
+    if (ZParallelSelectRelocationSet && _workers.active_workers() > 1) {
+      register_relocation_set_pages_parallel(&selector, generation);
+    } else {
+      register_relocation_set_pages(&selector);
     }
+  }
 
-    // Reclaim remaining empty pages
-    free_empty_pages(&selector, 0 /* bulk */);
+  {
+    ZStatTimer timer(is_young() ? ZSubPhaseConcurrentSelectRelocationSetSelectYoung
+                                : ZSubPhaseConcurrentSelectRelocationSetSelectOld);
+    selector.select();
   }
 
-  // Select relocation set
-  selector.select();
 
   // Selecting tenuring threshold must be done after select
   // which produces the liveness data, but before install,
@@ -91,6 +91,8 @@ class ZGeneration {
 
   void mark_free();
 
+  void register_relocation_set_pages(ZRelocationSetSelector* selector);
+  void register_relocation_set_pages_parallel(ZRelocationSetSelector* selector, ZGenerationId generation);
   void select_relocation_set(ZGenerationId generation, bool promote_all);
   void reset_relocation_set();
 
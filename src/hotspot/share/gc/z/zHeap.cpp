@@ -110,6 +110,10 @@ size_t ZHeap::soft_max_capacity() const {
   return _page_allocator.soft_max_capacity();
 }
 
+void ZHeap::soft_max_capacity_changed() const {
+  _page_allocator.soft_max_capacity_changed();
+}
+
 size_t ZHeap::capacity() const {
   return _page_allocator.capacity();
 }
@@ -297,12 +301,6 @@ void ZHeap::object_iterate(ObjectClosure* object_cl, bool visit_weaks) {
   iter.object_iterate(object_cl, 0 /* worker_id */);
 }
 
-void ZHeap::object_and_field_iterate_for_verify(ObjectClosure* object_cl, OopFieldClosure* field_cl, bool visit_weaks) {
-  assert(SafepointSynchronize::is_at_safepoint(), "Should be at safepoint");
-  ZHeapIterator iter(1 /* nworkers */, visit_weaks, true /* for_verify */);
-  iter.object_and_field_iterate(object_cl, field_cl, 0 /* worker_id */);
-}
-
 ParallelObjectIteratorImpl* ZHeap::parallel_object_iterator(uint nworkers, bool visit_weaks) {
   assert(SafepointSynchronize::is_at_safepoint(), "Should be at safepoint");
   return new ZHeapIterator(nworkers, visit_weaks, false /* for_verify */);
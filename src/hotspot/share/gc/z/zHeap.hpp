@@ -34,8 +34,6 @@
 #include "gc/z/zPageType.hpp"
 #include "gc/z/zServiceability.hpp"
 
-class OopFieldClosure;
-
 class ZHeap {
   friend class ZForwardingTest;
   friend class ZLiveMapTest;
@@ -71,6 +69,7 @@ class ZHeap {
   size_t min_capacity() const;
   size_t max_capacity() const;
   size_t soft_max_capacity() const;
+  void soft_max_capacity_changed() const;
   size_t capacity() const;
   size_t used() const;
   size_t used_generation(ZGenerationId id) const;
@@ -118,7 +117,6 @@ class ZHeap {
 
   // Iteration
   void object_iterate(ObjectClosure* object_cl, bool visit_weaks);
-  void object_and_field_iterate_for_verify(ObjectClosure* object_cl, OopFieldClosure* field_cl, bool visit_weaks);
   ParallelObjectIteratorImpl* parallel_object_iterator(uint nworkers, bool visit_weaks);
 
   void threads_do(ThreadClosure* tc) const;
@@ -27,6 +27,8 @@
 #include "gc/z/zLock.inline.hpp"
 #include "gc/z/zMarkStack.inline.hpp"
 #include "gc/z/zMarkStackAllocator.hpp"
+#include "gc/z/zNUMA.inline.hpp"
+#include "gc/z/zValue.inline.hpp"
 #include "logging/log.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/os.hpp"
@@ -170,7 +172,7 @@ void ZMarkStackSpace::free() {
 
 ZMarkStackAllocator::ZMarkStackAllocator()
   : _space(),
-    _freelist(_space.start()),
+    _freelist(ZMarkStackMagazineList(_space.start())),
     _expanded_recently(false) {}
 
 bool ZMarkStackAllocator::is_initialized() const {
@@ -200,10 +202,16 @@ ZMarkStackMagazine* ZMarkStackAllocator::create_magazine_from_space(uintptr_t ad
 }
 
 ZMarkStackMagazine* ZMarkStackAllocator::alloc_magazine() {
-  // Try allocating from the free list first
-  ZMarkStackMagazine* const magazine = _freelist.pop();
-  if (magazine != nullptr) {
-    return magazine;
+  // Try allocating from the free lists first, starting with the
+  // one of the local NUMA node
+  const uint32_t numa_id = ZNUMA::id();
+  const uint32_t numa_count = ZNUMA::count();
+  for (uint32_t i = 0; i < numa_count; i++) {
+    const uint32_t index = (numa_id + i) % numa_count;
+    ZMarkStackMagazine* const magazine = _freelist.get(index).pop();
+    if (magazine != nullptr) {
+      return magazine;
+    }
   }
 
   if (!Atomic::load(&_expanded_recently)) {
@@ -228,10 +236,15 @@ bool ZMarkStackAllocator::clear_and_get_expanded_recently() {
 }
 
 void ZMarkStackAllocator::free_magazine(ZMarkStackMagazine* magazine) {
-  _freelist.push(magazine);
+  // Magazines are freed by the thread that used them, so this
+  // keeps them on the free list of the node they were used on
+  _freelist.get().push(magazine);
 }
 
 void ZMarkStackAllocator::free() {
-  _freelist.clear();
+  ZPerNUMAIterator<ZMarkStackMagazineList> iter(&_freelist);
+  for (ZMarkStackMagazineList* freelist; iter.next(&freelist);) {
+    freelist->clear();
+  }
   _space.free();
 }
@@ -27,6 +27,7 @@
 #include "gc/z/zGlobals.hpp"
 #include "gc/z/zLock.hpp"
 #include "gc/z/zMarkStack.hpp"
+#include "gc/z/zValue.hpp"
 #include "utilities/globalDefinitions.hpp"
 
 class ZMarkStackSpace {
@@ -60,7 +61,7 @@ class ZMarkStackSpace {
 class ZMarkStackAllocator : public CHeapObj<mtGC> {
 private:
   ZCACHE_ALIGNED ZMarkStackSpace        _space;
-  ZCACHE_ALIGNED ZMarkStackMagazineList _freelist;
+  ZPerNUMA<ZMarkStackMagazineList>      _freelist;
   ZCACHE_ALIGNED volatile bool          _expanded_recently;
 
   ZMarkStackMagazine* create_magazine_from_space(uintptr_t addr, size_t size);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -45,6 +45,7 @@ ZPage::ZPage(ZPageType type, const ZVirtualMemory& vmem, const ZPhysicalMemory&
     _livemap(object_max_count()),
     _remembered_set(),
     _last_used(0),
+    _cold(false),
     _physical(pmem),
     _node() {
   assert(!_virtual.is_null(), "Should not be null");
@@ -142,6 +143,7 @@ void ZPage::reset(ZPageAge age, ZPageResetType type) {
   const ZPageAge prev_age = _age;
   _age = age;
   _last_used = 0;
+  _cold = false;
 
   _generation_id = age == ZPageAge::old
       ? ZGenerationId::old
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -65,6 +65,7 @@ class ZPage : public CHeapObj<mtGC> {
   ZLiveMap             _livemap;
   ZRememberedSet       _remembered_set;
   uint64_t             _last_used;
+  bool                 _cold;
   ZPhysicalMemory      _physical;
   ZListNode<ZPage>     _node;
 
@@ -128,6 +129,9 @@ class ZPage : public CHeapObj<mtGC> {
   uint64_t last_used() const;
   void set_last_used();
 
+  bool is_cold() const;
+  void set_cold();
+
   void reset(ZPageAge age, ZPageResetType type);
 
   void finalize_reset_for_in_place_relocation();
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -209,6 +209,15 @@ inline uint64_t ZPage::last_used() const {
 
 inline void ZPage::set_last_used() {
   _last_used = (uint64_t)ceil(os::elapsedTime());
+  _cold = false;
+}
+
+inline bool ZPage::is_cold() const {
+  return _cold;
+}
+
+inline void ZPage::set_cold() {
+  _cold = true;
 }
 
 inline bool ZPage::is_in(zoffset offset) const {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -40,6 +40,7 @@
 #include "gc/z/zTask.hpp"
 #include "gc/z/zUncommitter.hpp"
 #include "gc/z/zUnmapper.hpp"
+#include "gc/z/zVirtualMemory.inline.hpp"
 #include "gc/z/zWorkers.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "logging/log.hpp"
@@ -862,6 +863,7 @@ size_t ZPageAllocator::uncommit(uint64_t* timeout) {
   // We need to join the suspendible thread set while manipulating capacity and
   // used, to make sure GC safepoints will have a consistent view.
   ZList<ZPage> pages;
+  ZArray<ZVirtualMemory> cold;
   size_t flushed;
 
   {
@@ -876,15 +878,50 @@ size_t ZPageAllocator::uncommit(uint64_t* timeout) {
     const size_t limit = MIN2(align_up(_current_max_capacity >> 7, ZGranuleSize), 256 * M);
     const size_t flush = MIN2(release, limit);
 
+    // Capacity above the soft max capacity is uncommitted without waiting
+    // for the pages to have been unused for ZUncommitDelay. While above the
+    // soft max capacity, check again after a second in case pages used
+    // until now have been freed.
+    const size_t soft_retain = MAX2(retain, soft_max_capacity());
+    const size_t excess = _capacity - MIN2(_capacity, soft_retain);
+    flushed = 0;
+    if (excess > 0) {
+      _cache.flush_for_allocation(MIN2(excess, limit), &pages);
+      ZListIterator<ZPage> iter(&pages);
+      for (ZPage* page; iter.next(&page);) {
+        flushed += page->size();
+      }
+    }
+
     // Flush pages to uncommit
-    flushed = _cache.flush_for_uncommit(flush, &pages, timeout);
     if (flushed == 0) {
-      // Nothing flushed
-      return 0;
+      flushed = _cache.flush_for_uncommit(flush, &pages, timeout);
+    }
+    if (excess > 0) {
+      *timeout = MIN2(*timeout, (uint64_t)1);
+    }
+    if (flushed == 0) {
+      // Nothing flushed, collect cached pages that have turned cold
+      if (ZUncommitColdDelay > 0) {
+        uint64_t cold_timeout;
+        _cache.collect_cold(&cold, &cold_timeout);
+        *timeout = MIN2(*timeout, cold_timeout);
+      }
+    } else {
+      // Record flushed pages as claimed
+      Atomic::add(&_claimed, flushed);
+    }
+  }
+
+  if (flushed == 0) {
+    // Advise cold pages outside of the lock. Pages allocated again in
+    // the meantime are unaffected, since the advice is only a hint.
+    ZArrayIterator<ZVirtualMemory> iter(&cold);
+    for (ZVirtualMemory vmem; iter.next(&vmem);) {
+      _physical.advise_cold(vmem.start(), vmem.size());
     }
 
-    // Record flushed pages as claimed
-    Atomic::add(&_claimed, flushed);
+    return 0;
   }
 
   // Unmap, uncommit, and destroy flushed pages
@@ -907,6 +944,10 @@ size_t ZPageAllocator::uncommit(uint64_t* timeout) {
   return flushed;
 }
 
+void ZPageAllocator::soft_max_capacity_changed() const {
+  _uncommitter->notify();
+}
+
 void ZPageAllocator::enable_safe_destroy() const {
   _safe_destroy.enable_deferred_delete();
 }
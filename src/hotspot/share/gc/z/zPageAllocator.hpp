@@ -154,6 +154,9 @@ class ZPageAllocator {
   void free_page(ZPage* page);
   void free_pages(const ZArray<ZPage*>* pages);
 
+  // Start uncommitting capacity above the new soft max capacity.
+  void soft_max_capacity_changed() const;
+
   void enable_safe_destroy() const;
   void disable_safe_destroy() const;
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -32,6 +32,7 @@
 #include "memory/allocation.hpp"
 #include "runtime/globals.hpp"
 #include "runtime/os.hpp"
+#include "utilities/powerOfTwo.hpp"
 
 static const ZStatCounter ZCounterPageCacheHitL1("Memory", "Page Cache Hit L1", ZStatUnitOpsPerSecond);
 static const ZStatCounter ZCounterPageCacheHitL2("Memory", "Page Cache Hit L2", ZStatUnitOpsPerSecond);
@@ -60,15 +61,50 @@ ZPageCache::ZPageCache()
     _large(),
     _last_commit(0) {}
 
-ZPage* ZPageCache::alloc_small_page() {
+uint32_t ZPageCache::large_size_class(size_t size) {
+  const uint32_t size_class = log2i(size >> ZGranuleSizeShift);
+  return MIN2(size_class, LargeSizeClasses - 1);
+}
+
+ZList<ZPage>* ZPageCache::list_for_page(ZPage* page) {
+  const ZPageType type = page->type();
+  const uint32_t numa_id = page->numa_id();
+  if (type == ZPageType::small) {
+    return _small.addr(numa_id);
+  } else if (type == ZPageType::medium) {
+    return _medium.addr(numa_id);
+  } else {
+    return _large[large_size_class(page->size())].addr(numa_id);
+  }
+}
+
+template <typename Match>
+static ZPage* remove_page(ZList<ZPage>* list, Match match) {
+  ZListIterator<ZPage> iter(list);
+  for (ZPage* page; iter.next(&page);) {
+    if (match(page)) {
+      // Page found
+      list->remove(page);
+      return page;
+    }
+  }
+
+  return nullptr;
+}
+
+// Remove the first matching page from the lists, preferring the list
+// of the current NUMA node over the lists of remote nodes.
+template <typename Match>
+static ZPage* remove_page_numa(ZPerNUMA<ZList<ZPage> >* lists, Match match,
+                               const ZStatCounter& local_counter, const ZStatCounter& remote_counter) {
   const uint32_t numa_id = ZNUMA::id();
   const uint32_t numa_count = ZNUMA::count();
 
   // Try NUMA local page cache
-  ZPage* const l1_page = _small.get(numa_id).remove_first();
-  if (l1_page != nullptr) {
-    ZStatInc(ZCounterPageCacheHitL1);
-    return l1_page;
+  ZPage* const local_page = remove_page(lists->addr(numa_id), match);
+  if (local_page != nullptr) {
+    ZStatInc(local_counter);
+    return local_page;
   }
 
   // Try NUMA remote page cache(s)
@@ -79,10 +115,10 @@ ZPage* ZPageCache::alloc_small_page() {
       remote_numa_id = 0;
     }
 
-    ZPage* const l2_page = _small.get(remote_numa_id).remove_first();
-    if (l2_page != nullptr) {
-      ZStatInc(ZCounterPageCacheHitL2);
-      return l2_page;
+    ZPage* const remote_page = remove_page(lists->addr(remote_numa_id), match);
+    if (remote_page != nullptr) {
+      ZStatInc(remote_counter);
+      return remote_page;
     }
 
     remote_numa_id++;
@@ -91,47 +127,53 @@ ZPage* ZPageCache::alloc_small_page() {
   return nullptr;
 }
 
-ZPage* ZPageCache::alloc_medium_page() {
-  ZPage* const page = _medium.remove_first();
-  if (page != nullptr) {
-    ZStatInc(ZCounterPageCacheHitL1);
-    return page;
-  }
+static bool match_any(const ZPage* page) {
+  return true;
+}
 
-  return nullptr;
+ZPage* ZPageCache::alloc_small_page() {
+  return remove_page_numa(&_small, match_any, ZCounterPageCacheHitL1, ZCounterPageCacheHitL2);
+}
+
+ZPage* ZPageCache::alloc_medium_page() {
+  return remove_page_numa(&_medium, match_any, ZCounterPageCacheHitL1, ZCounterPageCacheHitL2);
 }
 
 ZPage* ZPageCache::alloc_large_page(size_t size) {
   // Find a page with the right size
-  ZListIterator<ZPage> iter(&_large);
-  for (ZPage* page; iter.next(&page);) {
-    if (size == page->size()) {
-      // Page found
-      _large.remove(page);
-      ZStatInc(ZCounterPageCacheHitL1);
-      return page;
-    }
-  }
+  auto match_size = [&](const ZPage* page) {
+    return size == page->size();
+  };
 
-  return nullptr;
+  return remove_page_numa(&_large[large_size_class(size)], match_size, ZCounterPageCacheHitL1, ZCounterPageCacheHitL2);
 }
 
 ZPage* ZPageCache::alloc_oversized_medium_page(size_t size) {
   if (size <= ZPageSizeMedium) {
-    return _medium.remove_first();
+    return remove_page_numa(&_medium, match_any, ZCounterPageCacheHitL3, ZCounterPageCacheHitL3);
   }
 
   return nullptr;
 }
 
 ZPage* ZPageCache::alloc_oversized_large_page(size_t size) {
-  // Find a page that is large enough
-  ZListIterator<ZPage> iter(&_large);
-  for (ZPage* page; iter.next(&page);) {
-    if (size <= page->size()) {
-      // Page found
-      _large.remove(page);
-      return page;
+  // Find a page that is large enough, starting with the smallest
+  // size class that can hold such a page. All pages in larger size
+  // classes are large enough.
+  auto match_size = [&](const ZPage* page) {
+    return size <= page->size();
+  };
+
+  const uint32_t size_class = size > ZPageSizeMedium ? large_size_class(size) : 0;
+  ZPage* const page = remove_page_numa(&_large[size_class], match_size, ZCounterPageCacheHitL3, ZCounterPageCacheHitL3);
+  if (page != nullptr) {
+    return page;
+  }
+
+  for (uint32_t i = size_class + 1; i < LargeSizeClasses; i++) {
+    ZPage* const larger_page = remove_page_numa(&_large[i], match_any, ZCounterPageCacheHitL3, ZCounterPageCacheHitL3);
+    if (larger_page != nullptr) {
+      return larger_page;
     }
   }
 
@@ -144,10 +186,6 @@ ZPage* ZPageCache::alloc_oversized_page(size_t size) {
     page = alloc_oversized_medium_page(size);
   }
 
-  if (page != nullptr) {
-    ZStatInc(ZCounterPageCacheHitL3);
-  }
-
   return page;
 }
 
@@ -188,14 +226,33 @@ ZPage* ZPageCache::alloc_page(ZPageType type, size_t size) {
 }
 
 void ZPageCache::free_page(ZPage* page) {
-  const ZPageType type = page->type();
-  if (type == ZPageType::small) {
-    _small.get(page->numa_id()).insert_first(page);
-  } else if (type == ZPageType::medium) {
-    _medium.insert_first(page);
-  } else {
-    _large.insert_first(page);
+  list_for_page(page)->insert_first(page);
+}
+
+ZList<ZPage>* ZPageCache::least_recently_used_list() {
+  ZList<ZPage>* lru_list = nullptr;
+  uint64_t lru_last_used = 0;
+
+  auto select_oldest = [&](ZPerNUMA<ZList<ZPage> >* lists) {
+    ZPerNUMAIterator<ZList<ZPage> > iter(lists);
+    for (ZList<ZPage>* list; iter.next(&list);) {
+      const ZPage* const page = list->last();
+      if (page != nullptr && (lru_list == nullptr || page->last_used() < lru_last_used)) {
+        lru_list = list;
+        lru_last_used = page->last_used();
+      }
+    }
+  };
+
+  // Among pages last used at the same time, prefer flushing
+  // large, then medium and last small pages
+  for (uint32_t i = LargeSizeClasses; i > 0; i--) {
+    select_oldest(&_large[i - 1]);
   }
+  select_oldest(&_medium);
+  select_oldest(&_small);
+
+  return lru_list;
 }
 
 bool ZPageCache::flush_list_inner(ZPageCacheFlushClosure* cl, ZList<ZPage>* from, ZList<ZPage>* to) {
@@ -211,37 +268,16 @@ bool ZPageCache::flush_list_inner(ZPageCacheFlushClosure* cl, ZList<ZPage>* from
   return true;
 }
 
-void ZPageCache::flush_list(ZPageCacheFlushClosure* cl, ZList<ZPage>* from, ZList<ZPage>* to) {
-  while (flush_list_inner(cl, from, to));
-}
-
-void ZPageCache::flush_per_numa_lists(ZPageCacheFlushClosure* cl, ZPerNUMA<ZList<ZPage> >* from, ZList<ZPage>* to) {
-  const uint32_t numa_count = ZNUMA::count();
-  uint32_t numa_done = 0;
-  uint32_t numa_next = 0;
-
-  // Flush lists round-robin
-  while (numa_done < numa_count) {
-    ZList<ZPage>* const numa_list = from->addr(numa_next);
-    if (++numa_next == numa_count) {
-      numa_next = 0;
-    }
-
-    if (flush_list_inner(cl, numa_list, to)) {
-      // Not done
-      numa_done = 0;
-    } else {
-      // Done
-      numa_done++;
+void ZPageCache::flush(ZPageCacheFlushClosure* cl, ZList<ZPage>* to) {
+  // Flush the least recently used pages first, regardless of their type
+  // and NUMA node, so that hot parts of the cache survive flushing. Pages
+  // flushed for uncommit are expired in the same order, which keeps the
+  // pages most likely to be reused cached instead of being uncommitted.
+  for (ZList<ZPage>* list; (list = least_recently_used_list()) != nullptr;) {
+    if (!flush_list_inner(cl, list, to)) {
+      break;
     }
   }
-}
-
-void ZPageCache::flush(ZPageCacheFlushClosure* cl, ZList<ZPage>* to) {
-  // Prefer flushing large, then medium and last small pages
-  flush_list(cl, &_large, to);
-  flush_list(cl, &_medium, to);
-  flush_per_numa_lists(cl, &_small, to);
 
   if (cl->_flushed > cl->_requested) {
     // Overflushed, re-insert part of last page into the cache
@@ -328,6 +364,45 @@ size_t ZPageCache::flush_for_uncommit(size_t requested, ZList<ZPage>* to, uint64
   return cl._flushed;
 }
 
+size_t ZPageCache::collect_cold(ZArray<ZVirtualMemory>* to, uint64_t* timeout) {
+  const uint64_t now = os::elapsedTime();
+  size_t collected = 0;
+
+  // Set initial timeout
+  *timeout = ZUncommitColdDelay;
+
+  auto collect = [&](ZPerNUMA<ZList<ZPage> >* lists) {
+    ZPerNUMAIterator<ZList<ZPage> > iter(lists);
+    for (ZList<ZPage>* list; iter.next(&list);) {
+      // Walk from the least recently used page, until a page is found
+      // that has been used too recently to be cold
+      ZListReverseIterator<ZPage> page_iter(list);
+      for (ZPage* page; page_iter.next(&page);) {
+        const uint64_t expires = page->last_used() + ZUncommitColdDelay;
+        if (expires > now) {
+          // Record shortest non-expired timeout
+          *timeout = MIN2(*timeout, expires - now);
+          break;
+        }
+
+        if (!page->is_cold()) {
+          page->set_cold();
+          to->append(page->virtual_memory());
+          collected += page->size();
+        }
+      }
+    }
+  };
+
+  for (uint32_t i = 0; i < LargeSizeClasses; i++) {
+    collect(&_large[i]);
+  }
+  collect(&_medium);
+  collect(&_small);
+
+  return collected;
+}
+
 void ZPageCache::set_last_commit() {
   _last_commit = ceil(os::elapsedTime());
 }
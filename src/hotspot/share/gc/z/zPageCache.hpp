@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -24,20 +24,34 @@
 #ifndef SHARE_GC_Z_ZPAGECACHE_HPP
 #define SHARE_GC_Z_ZPAGECACHE_HPP
 
+#include "gc/z/zArray.hpp"
 #include "gc/z/zList.hpp"
 #include "gc/z/zPage.hpp"
 #include "gc/z/zPageType.hpp"
 #include "gc/z/zValue.hpp"
+#include "gc/z/zVirtualMemory.hpp"
 
 class ZPageCacheFlushClosure;
 
+// Cached pages are kept in separate lists per NUMA node. Large pages are in
+// addition kept in lists per size class, where size class n holds pages of
+// [2^n, 2^(n+1)) granules. Freed pages are inserted first and allocations
+// take pages from the front of the lists, so the last page of each list is
+// its least recently used page. Flushing always takes the least recently
+// used page of all lists.
 class ZPageCache {
 private:
+  static const uint32_t LargeSizeClasses = 8;
+
   ZPerNUMA<ZList<ZPage> > _small;
-  ZList<ZPage>            _medium;
-  ZList<ZPage>            _large;
+  ZPerNUMA<ZList<ZPage> > _medium;
+  ZPerNUMA<ZList<ZPage> > _large[LargeSizeClasses];
   uint64_t                _last_commit;
 
+  static uint32_t large_size_class(size_t size);
+
+  ZList<ZPage>* list_for_page(ZPage* page);
+
   ZPage* alloc_small_page();
   ZPage* alloc_medium_page();
   ZPage* alloc_large_page(size_t size);
@@ -46,9 +60,8 @@ class ZPageCache {
   ZPage* alloc_oversized_large_page(size_t size);
   ZPage* alloc_oversized_page(size_t size);
 
+  ZList<ZPage>* least_recently_used_list();
   bool flush_list_inner(ZPageCacheFlushClosure* cl, ZList<ZPage>* from, ZList<ZPage>* to);
-  void flush_list(ZPageCacheFlushClosure* cl, ZList<ZPage>* from, ZList<ZPage>* to);
-  void flush_per_numa_lists(ZPageCacheFlushClosure* cl, ZPerNUMA<ZList<ZPage> >* from, ZList<ZPage>* to);
   void flush(ZPageCacheFlushClosure* cl, ZList<ZPage>* to);
 
 public:
@@ -59,6 +72,7 @@ class ZPageCache {
 
   void flush_for_allocation(size_t requested, ZList<ZPage>* to);
   size_t flush_for_uncommit(size_t requested, ZList<ZPage>* to, uint64_t* timeout);
+  size_t collect_cold(ZArray<ZVirtualMemory>* to, uint64_t* timeout);
 
   void set_last_commit();
 };
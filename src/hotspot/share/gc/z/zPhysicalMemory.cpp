@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -387,3 +387,10 @@ void ZPhysicalMemoryManager::unmap(zoffset offset, size_t size) const {
 
   _backing.unmap(addr, size);
 }
+
+// Advise that mapped memory is unlikely to be used soon
+void ZPhysicalMemoryManager::advise_cold(zoffset offset, size_t size) const {
+  const zaddress_unsafe addr = ZOffset::address_unsafe(offset);
+
+  _backing.advise_cold(addr, size);
+}
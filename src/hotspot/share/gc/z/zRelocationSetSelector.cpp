@@ -179,6 +179,18 @@ void ZRelocationSetSelectorGroup::select_inner() {
                        _name, selected_from, selected_to, npages - selected_from, selected_forwarding_entries);
 }
 
+void ZRelocationSetSelectorGroup::merge(const ZRelocationSetSelectorGroup* other) {
+  _live_pages.appendAll(&other->_live_pages);
+  _not_selected_pages.appendAll(&other->_not_selected_pages);
+
+  for (uint i = 0; i <= ZPageAgeMax; ++i) {
+    _stats[i]._npages_candidates += other->_stats[i]._npages_candidates;
+    _stats[i]._total += other->_stats[i]._total;
+    _stats[i]._live += other->_stats[i]._live;
+    _stats[i]._empty += other->_stats[i]._empty;
+  }
+}
+
 void ZRelocationSetSelectorGroup::select() {
   if (is_disabled()) {
     return;
@@ -216,6 +228,13 @@ ZRelocationSetSelector::ZRelocationSetSelector(double fragmentation_limit)
     _large("Large", ZPageType::large, 0 /* page_size */, 0 /* object_size_limit */, fragmentation_limit),
     _empty_pages() {}
 
+void ZRelocationSetSelector::merge(const ZRelocationSetSelector* other) {
+  _small.merge(&other->_small);
+  _medium.merge(&other->_medium);
+  _large.merge(&other->_large);
+  _empty_pages.appendAll(&other->_empty_pages);
+}
+
 void ZRelocationSetSelector::select() {
   // Select pages to relocate. The resulting relocation set will be
   // sorted such that medium pages comes first, followed by small
@@ -103,6 +103,7 @@ class ZRelocationSetSelectorGroup {
 
   void register_live_page(ZPage* page);
   void register_empty_page(ZPage* page);
+  void merge(const ZRelocationSetSelectorGroup* other);
   void select();
 
   const ZArray<ZPage*>* live_pages() const;
@@ -113,7 +114,7 @@ class ZRelocationSetSelectorGroup {
   const ZRelocationSetSelectorGroupStats& stats(ZPageAge age) const;
 };
 
-class ZRelocationSetSelector : public StackObj {
+class ZRelocationSetSelector : public CHeapObj<mtGC> {
 private:
   ZRelocationSetSelectorGroup _small;
   ZRelocationSetSelectorGroup _medium;
@@ -130,6 +131,9 @@ class ZRelocationSetSelector : public StackObj {
   void register_live_page(ZPage* page);
   void register_empty_page(ZPage* page);
 
+  // Adds the pages registered with other to this selector
+  void merge(const ZRelocationSetSelector* other);
+
   bool should_free_empty_pages(int bulk) const;
   const ZArray<ZPage*>* empty_pages() const;
   void clear_empty_pages();
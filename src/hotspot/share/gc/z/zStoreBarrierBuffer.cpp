@@ -26,6 +26,7 @@
 #include "gc/z/zAddress.inline.hpp"
 #include "gc/z/zBarrier.inline.hpp"
 #include "gc/z/zGeneration.inline.hpp"
+#include "gc/z/zStat.hpp"
 #include "gc/z/zStoreBarrierBuffer.inline.hpp"
 #include "gc/z/zUncoloredRoot.inline.hpp"
 #include "memory/resourceArea.hpp"
@@ -33,6 +34,8 @@
 #include "utilities/ostream.hpp"
 #include "utilities/vmError.hpp"
 
+static const ZStatCounter ZCounterStoreBarrierBufferFlush("Memory", "Store Barrier Buffer Flush", ZStatUnitOpsPerSecond);
+
 ByteSize ZStoreBarrierEntry::p_offset() {
   return byte_offset_of(ZStoreBarrierEntry, _p);
 }
@@ -55,19 +58,25 @@ ZStoreBarrierBuffer::ZStoreBarrierBuffer()
     _last_installed_color(),
     _base_pointer_lock(),
     _base_pointers(),
-    _current(ZBufferStoreBarriers ? _buffer_size_bytes : 0) {}
+    _current(ZBufferStoreBarriers ? _buffer_initial_length * sizeof(ZStoreBarrierEntry) : 0),
+    _length(_buffer_initial_length),
+    _full_flushes(0) {}
 
 void ZStoreBarrierBuffer::initialize() {
   _last_processed_color = ZPointerStoreGoodMask;
   _last_installed_color = ZPointerStoreGoodMask;
 }
 
+size_t ZStoreBarrierBuffer::size_bytes() const {
+  return _length * sizeof(ZStoreBarrierEntry);
+}
+
 void ZStoreBarrierBuffer::clear() {
-  _current = _buffer_size_bytes;
+  _current = size_bytes();
 }
 
 bool ZStoreBarrierBuffer::is_empty() const {
-  return _current == _buffer_size_bytes;
+  return _current == size_bytes();
 }
 
 void ZStoreBarrierBuffer::install_base_pointers_inner() {
@@ -79,7 +88,7 @@ void ZStoreBarrierBuffer::install_base_pointers_inner() {
          (ZPointer::remap_bits(_last_processed_color) & ZPointerRemappedOldMask) == 0,
          "Should not have double bit errors");
 
-  for (int i = current(); i < (int)_buffer_length; ++i) {
+  for (int i = current(); i < (int)_length; ++i) {
     const ZStoreBarrierEntry& entry = _buffer[i];
     volatile zpointer* const p = entry._p;
     const zaddress_unsafe p_unsafe = to_zaddress_unsafe((uintptr_t)p);
@@ -229,12 +238,20 @@ void ZStoreBarrierBuffer::on_new_phase() {
   // Install all base pointers for relocation
   install_base_pointers();
 
-  for (int i = current(); i < (int)_buffer_length; ++i) {
+  for (int i = current(); i < (int)_length; ++i) {
     on_new_phase_relocate(i);
     on_new_phase_remember(i);
     on_new_phase_mark(i);
   }
 
+  if (ZAdaptiveStoreBarrierBuffer) {
+    // Shrink the buffer of threads that didn't fill it during the last phase
+    if (_full_flushes == 0 && _length > _buffer_initial_length) {
+      _length /= 2;
+    }
+    _full_flushes = 0;
+  }
+
   clear();
 
   _last_processed_color = ZPointerStoreGoodMask;
@@ -259,7 +276,7 @@ void ZStoreBarrierBuffer::on_error(outputStream* st) {
   st->print_cr(" _last_processed_color: " PTR_FORMAT, _last_processed_color);
   st->print_cr(" _last_installed_color: " PTR_FORMAT, _last_installed_color);
 
-  for (int i = current(); i < (int)_buffer_length; ++i) {
+  for (int i = current(); i < (int)_length; ++i) {
     st->print_cr(" [%2d]: base: " PTR_FORMAT " p: " PTR_FORMAT " prev: " PTR_FORMAT,
         i,
         untype(_base_pointers[i]),
@@ -276,7 +293,7 @@ void ZStoreBarrierBuffer::flush() {
   OnError on_error(this);
   VMErrorCallbackMark mark(&on_error);
 
-  for (int i = current(); i < (int)_buffer_length; ++i) {
+  for (int i = current(); i < (int)_length; ++i) {
     const ZStoreBarrierEntry& entry = _buffer[i];
     const zaddress addr = ZBarrier::make_load_good(entry._prev);
     ZBarrier::mark_and_remember(entry._p, addr);
@@ -285,6 +302,21 @@ void ZStoreBarrierBuffer::flush() {
   clear();
 }
 
+void ZStoreBarrierBuffer::flush_full() {
+  ZStatInc(ZCounterStoreBarrierBufferFlush);
+
+  flush();
+
+  if (ZAdaptiveStoreBarrierBuffer) {
+    // Grow the buffer of threads that keep filling it
+    if (++_full_flushes >= _grow_after_full_flushes && _length < _buffer_max_length) {
+      _length = MIN2(_length * 2, _buffer_max_length);
+      _full_flushes = 0;
+      clear();
+    }
+  }
+}
+
 bool ZStoreBarrierBuffer::is_in(volatile zpointer* p) {
   if (!ZBufferStoreBarriers) {
     return false;
@@ -296,7 +328,7 @@ bool ZStoreBarrierBuffer::is_in(volatile zpointer* p) {
     const uintptr_t  last_remap_bits = ZPointer::remap_bits(buffer->_last_processed_color) & ZPointerRemappedMask;
     const bool needs_remap = last_remap_bits != ZPointerRemapped;
 
-    for (int i = buffer->current(); i < (int)_buffer_length; ++i) {
+    for (int i = buffer->current(); i < (int)buffer->_length; ++i) {
       const ZStoreBarrierEntry& entry = buffer->_buffer[i];
       volatile zpointer* entry_p = entry._p;
 
@@ -42,10 +42,13 @@ class ZStoreBarrierBuffer : public CHeapObj<mtGC> {
   friend class ZVerify;
 
 private:
-  static const size_t _buffer_length     = 32;
-  static const size_t _buffer_size_bytes = _buffer_length * sizeof(ZStoreBarrierEntry);
+  static const size_t _buffer_initial_length = 32;
+  static const size_t _buffer_max_length     = 128;
 
-  ZStoreBarrierEntry _buffer[_buffer_length];
+  // Number of full flushes within a phase after which the buffer grows
+  static const uint   _grow_after_full_flushes = 4;
+
+  ZStoreBarrierEntry _buffer[_buffer_max_length];
 
   // Color from previous phase this buffer was processed
   uintptr_t          _last_processed_color;
@@ -54,16 +57,26 @@ class ZStoreBarrierBuffer : public CHeapObj<mtGC> {
   uintptr_t          _last_installed_color;
 
   ZLock              _base_pointer_lock;
-  zaddress_unsafe    _base_pointers[_buffer_length];
+  zaddress_unsafe    _base_pointers[_buffer_max_length];
 
   // sizeof(ZStoreBarrierEntry) scaled index growing downwards
   size_t             _current;
 
+  // Number of entries in use, only changed when the buffer is empty
+  size_t             _length;
+
+  // Number of times the buffer was flushed because it was full,
+  // since the last phase change
+  uint               _full_flushes;
+
   void on_new_phase_relocate(int i);
   void on_new_phase_remember(int i);
   void on_new_phase_mark(int i);
 
   void clear();
+  size_t size_bytes() const;
+
+  void flush_full();
 
   bool is_old_mark() const;
   bool stored_during_old_mark() const;
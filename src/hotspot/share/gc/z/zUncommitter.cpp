@@ -89,6 +89,11 @@ void ZUncommitter::run_thread() {
   }
 }
 
+void ZUncommitter::notify() {
+  ZLocker<ZConditionLock> locker(&_lock);
+  _lock.notify_all();
+}
+
 void ZUncommitter::terminate() {
   ZLocker<ZConditionLock> locker(&_lock);
   _stop = true;
@@ -44,6 +44,9 @@ class ZUncommitter : public ZThread {
 
 public:
   ZUncommitter(ZPageAllocator* page_allocator);
+
+  // Wake up the uncommitter to check for memory to uncommit.
+  void notify();
 };
 
 #endif // SHARE_GC_Z_ZUNCOMMITTER_HPP
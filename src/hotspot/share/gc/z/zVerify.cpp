@@ -25,9 +25,12 @@
 #include "classfile/classLoaderData.hpp"
 #include "gc/shared/gc_globals.hpp"
 #include "gc/shared/isGCActiveMark.hpp"
+#include "gc/shared/workerThread.hpp"
 #include "gc/z/zAddress.inline.hpp"
+#include "gc/z/zCollectedHeap.hpp"
 #include "gc/z/zGenerationId.hpp"
 #include "gc/z/zHeap.inline.hpp"
+#include "gc/z/zHeapIterator.hpp"
 #include "gc/z/zNMethod.hpp"
 #include "gc/z/zPageAllocator.hpp"
 #include "gc/z/zResurrection.hpp"
@@ -52,6 +55,7 @@
 #include "runtime/thread.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/globalDefinitions.hpp"
+#include "utilities/ostream.hpp"
 #include "utilities/preserveException.hpp"
 #include "utilities/resourceHash.hpp"
 
@@ -394,6 +398,9 @@ class ZVerifyObjectClosure : public ObjectClosure, public OopFieldClosure {
       _visited_ptr_pre_loaded() {}
 
   void log_dead_object(zaddress addr) {
+    // Serializes the output and the update of zverify_broken_object
+    // between the parallel verification workers.
+    ttyLocker ttyl;
     tty->print_cr("ZVerify found dead object: " PTR_FORMAT " at p: " PTR_FORMAT " ptr: " PTR_FORMAT, untype(addr), p2i((void*)_visited_p), untype(_visited_ptr_pre_loaded));
     to_oop(addr)->print();
     tty->print_cr("--- From --- ");
@@ -435,6 +442,24 @@ class ZVerifyObjectClosure : public ObjectClosure, public OopFieldClosure {
   }
 };
 
+class ZVerifyObjectsTask : public WorkerTask {
+private:
+  const bool    _verify_weaks;
+  ZHeapIterator _iter;
+
+public:
+  ZVerifyObjectsTask(uint nworkers, bool verify_weaks)
+    : WorkerTask("ZVerifyObjectsTask"),
+      _verify_weaks(verify_weaks),
+      _iter(nworkers, verify_weaks, true /* for_verify */) {}
+
+  virtual void work(uint worker_id) {
+    // The closure tracks the field being visited, so each worker needs its own
+    ZVerifyObjectClosure object_cl(_verify_weaks);
+    _iter.object_and_field_iterate(&object_cl, &object_cl, worker_id);
+  }
+};
+
 void ZVerify::threads_start_processing() {
   class StartProcessingClosure : public ThreadClosure {
   public:
@@ -466,8 +491,9 @@ void ZVerify::objects(bool verify_weaks) {
   // Do it here, after the roots have been verified.
   threads_start_processing();
 
-  ZVerifyObjectClosure object_cl(verify_weaks);
-  ZHeap::heap()->object_and_field_iterate_for_verify(&object_cl, &object_cl, verify_weaks);
+  WorkerThreads* const workers = ZCollectedHeap::heap()->safepoint_workers();
+  ZVerifyObjectsTask task(workers->active_workers(), verify_weaks);
+  workers->run_task(&task);
 }
 
 void ZVerify::before_zoperation() {
@@ -583,7 +609,7 @@ void ZVerify::on_color_flip() {
   for (JavaThreadIteratorWithHandle jtiwh; JavaThread* const jt = jtiwh.next(); ) {
     const ZStoreBarrierBuffer* const buffer = ZThreadLocalData::store_barrier_buffer(jt);
 
-    for (int i = buffer->current(); i < (int)ZStoreBarrierBuffer::_buffer_length; ++i) {
+    for (int i = buffer->current(); i < (int)buffer->_length; ++i) {
       volatile zpointer* const p = buffer->_buffer[i]._p;
       bool created = false;
       z_verify_store_barrier_buffer_table->put_if_absent(p, true, &created);
@@ -50,12 +50,28 @@
   product(bool, ZBufferStoreBarriers, true, DIAGNOSTIC,                     \
           "Buffer store barriers")                                          \
                                                                             \
+  product(uintx, ZUncommitColdDelay, 0, EXPERIMENTAL,                       \
+          "Advise the operating system that cached memory that has been "   \
+          "unused for the specified amount of time (in seconds) is cold, "  \
+          "so that it is reclaimed first under memory pressure but can "    \
+          "be reused without being committed again until it is "            \
+          "uncommitted after ZUncommitDelay. 0 disables the advice")        \
+                                                                            \
+  product(bool, ZAdaptiveStoreBarrierBuffer, false, EXPERIMENTAL,           \
+          "Grow the store barrier buffer of threads that fill it often "    \
+          "and shrink it again when they stop doing so")                    \
+                                                                            \
   product(uint, ZYoungGCThreads, 0, DIAGNOSTIC,                             \
           "Number of GC threads for the young generation")                  \
                                                                             \
   product(uint, ZOldGCThreads, 0, DIAGNOSTIC,                               \
           "Number of GC threads for the old generation")                    \
                                                                             \
+  product(bool, ZParallelSelectRelocationSet, false, EXPERIMENTAL,          \
+          "Register the pages of the relocation set candidates with all "   \
+          "workers. Empty pages are then freed after all pages have been "  \
+          "registered, instead of in bulks during the registration.")       \
+                                                                            \
   product(uintx, ZIndexDistributorStrategy, 0, DIAGNOSTIC,                  \
           "Strategy used to distribute indices to parallel workers "        \
           "0: Claim tree "                                                  \
@@ -74,6 +74,13 @@
   def(_nofast_aload_0            , "nofast_aload_0"            , "b"    , nullptr    , T_OBJECT ,  1, true , _aload_0           ) \
   def(_nofast_iload              , "nofast_iload"              , "bi"   , nullptr    , T_INT    ,  1, false, _iload             ) \
                                                                                                                                   \
+  def(_fast_aload_0_aload_1      , "fast_aload_0_aload_1"      , "b_"   , nullptr    , T_OBJECT ,  2, false, _aload_0           ) \
+  def(_fast_aload_0_iload_1      , "fast_aload_0_iload_1"      , "b_"   , nullptr    , T_INT    ,  2, false, _aload_0           ) \
+  def(_fast_aload_1_iload_2      , "fast_aload_1_iload_2"      , "b_"   , nullptr    , T_INT    ,  2, false, _aload_1           ) \
+  def(_fast_iload_1_iload_2      , "fast_iload_1_iload_2"      , "b_"   , nullptr    , T_INT    ,  2, false, _iload_1           ) \
+  def(_fast_iconst_1_iadd        , "fast_iconst_1_iadd"        , "b_"   , nullptr    , T_INT    ,  0, false, _iconst_1          ) \
+  def(_fast_iconst_1_isub        , "fast_iconst_1_isub"        , "b_"   , nullptr    , T_INT    ,  0, false, _iconst_1          ) \
+                                                                                                                                  \
   def(_shouldnotreachhere        , "_shouldnotreachhere"       , "b"    , nullptr    , T_VOID   ,  0, false, _shouldnotreachhere)
 
 #define BYTECODES_DO(def)                                                                                  \
@@ -363,6 +370,45 @@ bool Bytecodes::check_must_rewrite(Bytecodes::Code code) {
   }
 }
 
+// The fused pairs are among the most frequent bytecode pairs reported by
+// PrintBytecodePairHistogram that consist of bytecodes which neither use the
+// bcp nor call the VM, so that their templates can simply be concatenated.
+Bytecodes::Code Bytecodes::fused_pair(Bytecodes::Code first, Bytecodes::Code second) {
+  switch (first) {
+  case _aload_0:
+    if (second == _aload_1) return _fast_aload_0_aload_1;
+    if (second == _iload_1) return _fast_aload_0_iload_1;
+    break;
+  case _aload_1:
+    if (second == _iload_2) return _fast_aload_1_iload_2;
+    break;
+  case _iload_1:
+    if (second == _iload_2) return _fast_iload_1_iload_2;
+    break;
+  case _iconst_1:
+    if (second == _iadd)    return _fast_iconst_1_iadd;
+    if (second == _isub)    return _fast_iconst_1_isub;
+    break;
+  default:
+    break;
+  }
+  return _illegal;
+}
+
+Bytecodes::Code Bytecodes::fused_pair_second(Bytecodes::Code code) {
+  switch (code) {
+  case _fast_aload_0_aload_1: return _aload_1;
+  case _fast_aload_0_iload_1: return _iload_1;
+  case _fast_aload_1_iload_2: return _iload_2;
+  case _fast_iload_1_iload_2: return _iload_2;
+  case _fast_iconst_1_iadd:   return _iadd;
+  case _fast_iconst_1_isub:   return _isub;
+  default:
+    ShouldNotReachHere();
+    return _illegal;
+  }
+}
+
 Bytecodes::Code Bytecodes::code_at(Method* method, int bci) {
   return code_at(method, method->bcp_from(bci));
 }
@@ -301,6 +301,15 @@ class Bytecodes: AllStatic {
     _nofast_aload_0       ,          //  <- _aload_0
     _nofast_iload         ,          //  <- _iload
 
+    // Frequent pairs of simple bytecodes, fused when linking a class if
+    // FuseFrequentPairs is set (see Rewriter::rewrite_bytecode_pairs).
+    _fast_aload_0_aload_1 ,
+    _fast_aload_0_iload_1 ,
+    _fast_aload_1_iload_2 ,
+    _fast_iload_1_iload_2 ,
+    _fast_iconst_1_iadd   ,
+    _fast_iconst_1_isub   ,
+
     _shouldnotreachhere   ,          // For debugging
 
 
@@ -425,6 +434,11 @@ class Bytecodes: AllStatic {
                                                                                           code == _invokeinterface; }
   static bool        has_optional_appendix(Code code) { return code == _invokedynamic || code == _invokehandle; }
 
+  // Fused bytecode pairs: the fused bytecode's java_code() is the first bytecode of the pair
+  static bool        is_fused_pair  (Code code)    { return (_fast_aload_0_aload_1 <= code && code <= _fast_iconst_1_isub); }
+  static Code        fused_pair     (Code first, Code second);  // returns _illegal if the pair is not fused
+  static Code        fused_pair_second(Code code);
+
   static int         flags          (int code, bool is_wide) {
     assert(code == (u_char)code, "must be a byte");
     return _flags[code + (is_wide ? (1<<BitsPerByte) : 0)];
@@ -32,6 +32,7 @@
 #include "oops/generateOopMap.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/signature.hpp"
@@ -434,74 +435,127 @@ void InterpreterOopMap::resource_copy(OopMapCacheEntry* from) {
 }
 
 inline unsigned int OopMapCache::hash_value_for(const methodHandle& method, int bci) const {
-  // We use method->code_size() rather than method->identity_hash() below since
-  // the mark may not be present if a pointer to the method is already reversed.
+  // Methods with the same shape only differ in their address, which is
+  // stable as long as the method is in the cache.
   return   ((unsigned int) bci)
          ^ ((unsigned int) method->max_locals()         << 2)
          ^ ((unsigned int) method->code_size()          << 4)
-         ^ ((unsigned int) method->size_of_parameters() << 6);
+         ^ ((unsigned int) method->size_of_parameters() << 6)
+         ^ ((unsigned int) ((uintptr_t)method() >> LogBytesPerWord));
 }
 
 OopMapCacheEntry* volatile OopMapCache::_old_entries = nullptr;
 
-OopMapCache::OopMapCache() {
-  for(int i = 0; i < size; i++) _array[i] = nullptr;
+OopMapCache::Table::Table(int size) :
+  _size(size),
+  _next(nullptr),
+  _entries(NEW_C_HEAP_ARRAY(OopMapCacheEntry* volatile, size, mtClass)) {
+  for (int i = 0; i < size; i++) _entries[i] = nullptr;
 }
 
+OopMapCache::Table::~Table() {
+  FREE_C_HEAP_ARRAY(OopMapCacheEntry*, _entries);
+}
 
-OopMapCache::~OopMapCache() {
-  // Deallocate oop maps that are allocated out-of-line
-  flush();
+OopMapCacheEntry* OopMapCache::Table::entry_at(unsigned int i) const {
+  return Atomic::load_acquire(&(_entries[i % _size]));
 }
 
-OopMapCacheEntry* OopMapCache::entry_at(int i) const {
-  return Atomic::load_acquire(&(_array[i % size]));
+bool OopMapCache::Table::put_at(unsigned int i, OopMapCacheEntry* entry, OopMapCacheEntry* old) {
+  return Atomic::cmpxchg(&_entries[i % _size], old, entry) == old;
 }
 
-bool OopMapCache::put_at(int i, OopMapCacheEntry* entry, OopMapCacheEntry* old) {
-  return Atomic::cmpxchg(&_array[i % size], old, entry) == old;
+OopMapCache::OopMapCache() : _table(new Table(initial_size)) {}
+
+
+OopMapCache::~OopMapCache() {
+  // Deallocate oop maps that are allocated out-of-line
+  flush();
+  Table* table = _table;
+  while (table != nullptr) {
+    Table* next = table->next();
+    delete table;
+    table = next;
+  }
 }
 
 void OopMapCache::flush() {
-  for (int i = 0; i < size; i++) {
-    OopMapCacheEntry* entry = _array[i];
-    if (entry != nullptr) {
-      _array[i] = nullptr;  // no barrier, only called in OopMapCache destructor
-      OopMapCacheEntry::deallocate(entry);
+  for (Table* table = _table; table != nullptr; table = table->next()) {
+    for (int i = 0; i < table->size(); i++) {
+      OopMapCacheEntry* entry = table->raw_entry_at(i);
+      if (entry != nullptr) {
+        table->raw_clear_at(i);  // no barrier, only called in OopMapCache destructor
+        OopMapCacheEntry::deallocate(entry);
+      }
     }
   }
 }
 
 void OopMapCache::flush_obsolete_entries() {
   assert(SafepointSynchronize::is_at_safepoint(), "called by RedefineClasses in a safepoint");
-  for (int i = 0; i < size; i++) {
-    OopMapCacheEntry* entry = _array[i];
-    if (entry != nullptr && !entry->is_empty() && entry->method()->is_old()) {
-      // Cache entry is occupied by an old redefined method and we don't want
-      // to pin it down so flush the entry.
-      if (log_is_enabled(Debug, redefine, class, oopmap)) {
-        ResourceMark rm;
-        log_debug(redefine, class, interpreter, oopmap)
-          ("flush: %s(%s): cached entry @%d",
-           entry->method()->name()->as_C_string(), entry->method()->signature()->as_C_string(), i);
+  for (Table* table = _table; table != nullptr; table = table->next()) {
+    for (int i = 0; i < table->size(); i++) {
+      OopMapCacheEntry* entry = table->raw_entry_at(i);
+      if (entry != nullptr && !entry->is_empty() && entry->method()->is_old()) {
+        // Cache entry is occupied by an old redefined method and we don't want
+        // to pin it down so flush the entry.
+        if (log_is_enabled(Debug, redefine, class, oopmap)) {
+          ResourceMark rm;
+          log_debug(redefine, class, interpreter, oopmap)
+            ("flush: %s(%s): cached entry @%d",
+             entry->method()->name()->as_C_string(), entry->method()->signature()->as_C_string(), i);
+        }
+        table->raw_clear_at(i);
+        OopMapCacheEntry::deallocate(entry);
+      }
+    }
+  }
+}
+
+// Puts entry in an empty slot, adding an overflow table if there is
+// none. Returns false if all tables are full.
+bool OopMapCache::put(unsigned int probe, OopMapCacheEntry* entry) {
+  Table* last = nullptr;
+  for (Table* table = _table; table != nullptr; table = table->next()) {
+    for (int i = 0; i < probe_depth; i++) {
+      if (table->entry_at(probe + i) == nullptr && table->put_at(probe + i, entry, nullptr)) {
+        return true;
+      }
+    }
+    last = table;
+  }
+
+  while (last->size() * 2 <= OopMapCacheMaxTableSize) {
+    Table* table = new Table(last->size() * 2);
+    // Not yet visible to other threads.
+    table->put_at(probe, entry, nullptr);
+    if (last->set_next(table)) {
+      log_debug(interpreter, oopmap)("added oopmap cache table of size %d", table->size());
+      return true;
+    }
+    // Another thread added an overflow table first, try that one.
+    delete table;
+    last = last->next();
+    for (int i = 0; i < probe_depth; i++) {
+      if (last->entry_at(probe + i) == nullptr && last->put_at(probe + i, entry, nullptr)) {
+        return true;
       }
-      _array[i] = nullptr;
-      OopMapCacheEntry::deallocate(entry);
     }
   }
+  return false;
 }
 
 // Lookup or compute/cache the entry.
 void OopMapCache::lookup(const methodHandle& method,
                          int bci,
                          InterpreterOopMap* entry_for) {
-  int probe = hash_value_for(method, bci);
+  unsigned int probe = hash_value_for(method, bci);
 
   if (log_is_enabled(Debug, interpreter, oopmap)) {
     static int count = 0;
     ResourceMark rm;
     log_debug(interpreter, oopmap)
-          ("%d - Computing oopmap at bci %d for %s at hash %d", ++count, bci,
+          ("%d - Computing oopmap at bci %d for %s at hash %u", ++count, bci,
            method()->name_and_sig_as_C_string(), probe);
   }
 
@@ -509,13 +563,15 @@ void OopMapCache::lookup(const methodHandle& method,
   // Need a critical section to avoid race against concurrent reclamation.
   {
     GlobalCounter::CriticalSection cs(Thread::current());
-    for (int i = 0; i < probe_depth; i++) {
-      OopMapCacheEntry *entry = entry_at(probe + i);
-      if (entry != nullptr && !entry->is_empty() && entry->match(method, bci)) {
-        entry_for->resource_copy(entry);
-        assert(!entry_for->is_empty(), "A non-empty oop map should be returned");
-        log_debug(interpreter, oopmap)("- found at hash %d", probe + i);
-        return;
+    for (Table* table = _table; table != nullptr; table = table->next()) {
+      for (int i = 0; i < probe_depth; i++) {
+        OopMapCacheEntry *entry = table->entry_at(probe + i);
+        if (entry != nullptr && !entry->is_empty() && entry->match(method, bci)) {
+          entry_for->resource_copy(entry);
+          assert(!entry_for->is_empty(), "A non-empty oop map should be returned");
+          log_debug(interpreter, oopmap)("- found at hash %u in table of size %d", probe + i, table->size());
+          return;
+        }
       }
     }
   }
@@ -538,22 +594,22 @@ void OopMapCache::lookup(const methodHandle& method,
   }
 
   // First search for an empty slot
-  for (int i = 0; i < probe_depth; i++) {
-    OopMapCacheEntry* entry = entry_at(probe + i);
-    if (entry == nullptr) {
-      if (put_at(probe + i, tmp, nullptr)) {
-        assert(!entry_for->is_empty(), "A non-empty oop map should be returned");
-        return;
-      }
-    }
+  if (put(probe, tmp)) {
+    assert(!entry_for->is_empty(), "A non-empty oop map should be returned");
+    return;
   }
 
   log_debug(interpreter, oopmap)("*** collision in oopmap cache - flushing item ***");
 
   // No empty slot (uncommon case). Use (some approximation of a) LRU algorithm
-  // where the first entry in the collision array is replaced with the new one.
-  OopMapCacheEntry* old = entry_at(probe + 0);
-  if (put_at(probe + 0, tmp, old)) {
+  // where the first entry in the collision array of the largest table is
+  // replaced with the new one.
+  Table* last = _table;
+  while (last->next() != nullptr) {
+    last = last->next();
+  }
+  OopMapCacheEntry* old = last->entry_at(probe + 0);
+  if (last->put_at(probe + 0, tmp, old)) {
     // Cannot deallocate old entry on the spot: it can still be used by readers
     // that got a reference to it before we were able to replace it in the map.
     // Instead of synchronizing on GlobalCounter here and incurring heavy thread
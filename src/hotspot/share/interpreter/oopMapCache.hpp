@@ -25,6 +25,7 @@
 #ifndef SHARE_INTERPRETER_OOPMAPCACHE_HPP
 #define SHARE_INTERPRETER_OOPMAPCACHE_HPP
 
+#include "runtime/atomic.hpp"
 #include "runtime/handles.hpp"
 #include "runtime/mutex.hpp"
 #include "utilities/globalDefinitions.hpp"
@@ -149,17 +150,41 @@ class InterpreterOopMap: ResourceObj {
   bool has_valid_mask() const { return _mask_size != USHRT_MAX; }
 };
 
+// The cache starts with a small table. When all probed slots of a lookup
+// are taken, an overflow table twice as large is appended, up to
+// OopMapCacheMaxTableSize. Entries never move between tables, so lookups
+// stay lock-free. Only when the largest table is full as well an entry is
+// replaced.
 class OopMapCache : public CHeapObj<mtClass> {
  static OopMapCacheEntry* volatile _old_entries;
  private:
-  static constexpr int size = 32;        // Use fixed size for now
+  static constexpr int initial_size = 32;
   static constexpr int probe_depth = 3;  // probe depth in case of collisions
 
-  OopMapCacheEntry* volatile _array[size];
+  class Table : public CHeapObj<mtClass> {
+    const int _size;
+    Table* volatile _next;               // overflow table, or null
+    OopMapCacheEntry* volatile* const _entries;
+
+   public:
+    Table(int size);
+    ~Table();
+
+    int size() const { return _size; }
+    Table* next() const { return Atomic::load_acquire(&_next); }
+    bool set_next(Table* next) { return Atomic::replace_if_null(&_next, next); }
+
+    OopMapCacheEntry* entry_at(unsigned int i) const;
+    bool put_at(unsigned int i, OopMapCacheEntry* entry, OopMapCacheEntry* old);
+    // Unsynchronized, only for the single-threaded cases.
+    OopMapCacheEntry* raw_entry_at(int i) const { return _entries[i]; }
+    void raw_clear_at(int i) { _entries[i] = nullptr; }
+  };
+
+  Table* const _table;
 
   unsigned int hash_value_for(const methodHandle& method, int bci) const;
-  OopMapCacheEntry* entry_at(int i) const;
-  bool put_at(int i, OopMapCacheEntry* entry, OopMapCacheEntry* old);
+  bool put(unsigned int probe, OopMapCacheEntry* entry);
 
   static void enqueue_for_cleanup(OopMapCacheEntry* entry);
 
@@ -36,6 +36,7 @@
 #include "oops/resolvedFieldEntry.hpp"
 #include "oops/resolvedIndyEntry.hpp"
 #include "oops/resolvedMethodEntry.hpp"
+#include "prims/jvmtiExport.hpp"
 #include "prims/methodHandles.hpp"
 #include "runtime/fieldDescriptor.inline.hpp"
 #include "runtime/handles.inline.hpp"
@@ -495,10 +496,24 @@ void Rewriter::scan_method(Thread* thread, Method* method, bool reverse, bool* i
       case Bytecodes::_monitorenter   : // fall through
       case Bytecodes::_monitorexit    : has_monitor_bytecodes = true; break;
 
-      default: break;
+      default:
+        if (Bytecodes::is_fused_pair(c)) {
+          assert(reverse, "pairs are fused after scanning");
+          (*bcp) = Bytecodes::java_code(c);
+        }
+        break;
     }
   }
 
+#ifndef ZERO
+  // Pairs are only fused if the interpreter may rewrite them anyway, and not
+  // in methods with jsrs, which might still be relocated.
+  if (!reverse && nof_jsrs == 0 && FuseFrequentPairs && RewriteFrequentPairs &&
+      !JvmtiExport::can_post_interpreter_events() && !CDSConfig::is_dumping_archive()) {
+    rewrite_bytecode_pairs(method);
+  }
+#endif
+
   // Update flags
   if (has_monitor_bytecodes) {
     method->set_has_monitor_bytecodes();
@@ -511,6 +526,28 @@ void Rewriter::scan_method(Thread* thread, Method* method, bool reverse, bool* i
   }
 }
 
+// Replace the first bytecode of each frequent pair of simple bytecodes by the
+// fused bytecode (see Bytecodes::fused_pair), which covers both of them. The
+// second bytecode is left in place, for branches targeting it.
+void Rewriter::rewrite_bytecode_pairs(Method* method) {
+  const address code_base = method->code_base();
+  const int code_length = method->code_size();
+
+  int bc_length;
+  for (int bci = 0; bci < code_length; bci += bc_length) {
+    address bcp = code_base + bci;
+    bc_length = Bytecodes::length_at(method, bcp);
+    int next_bci = bci + bc_length;
+    if (next_bci < code_length) {
+      Bytecodes::Code fused = Bytecodes::fused_pair(Bytecodes::cast(*bcp), Bytecodes::cast(code_base[next_bci]));
+      if (fused != Bytecodes::_illegal) {
+        (*bcp) = fused;
+        bc_length = Bytecodes::length_for(fused);
+      }
+    }
+  }
+}
+
 // After constant pool is created, revisit methods containing jsrs.
 methodHandle Rewriter::rewrite_jsrs(const methodHandle& method, TRAPS) {
   ResourceMark rm(THREAD);
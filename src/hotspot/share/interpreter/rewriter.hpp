@@ -133,6 +133,7 @@ class Rewriter: public StackObj {
   void rewrite_invokedynamic(address bcp, int offset, bool reverse);
   void maybe_rewrite_ldc(address bcp, int offset, bool is_wide, bool reverse);
   void rewrite_invokespecial(address bcp, int offset, bool reverse, bool* invokespecial_error);
+  void rewrite_bytecode_pairs(Method* m);
 
   // Do all the work.
   void rewrite_bytecodes(TRAPS);
@@ -154,6 +154,32 @@ void TemplateTable::jsr() {
 }
 
 
+// A fused bytecode pair is executed by the concatenated templates of its two
+// bytecodes, without dispatching to the second one. The second template does
+// not use the bcp, so it does not matter that it still points to the first.
+void TemplateTable::fast_pair() {
+  Template* desc = _desc;
+  Bytecodes::Code first_code = Bytecodes::java_code(desc->bytecode());
+  if (first_code == Bytecodes::_aload_0) {
+    // don't let aload_0 rewrite the fused bytecode
+    first_code = Bytecodes::_fast_aload_0;
+  }
+  Template* first  = template_for(first_code);
+  Template* second = template_for(Bytecodes::fused_pair_second(desc->bytecode()));
+  assert(!first->uses_bcp() && !first->does_dispatch() && !first->calls_vm(), "cannot fuse %s", Bytecodes::name(first_code));
+  assert(!second->uses_bcp() && !second->does_dispatch() && !second->calls_vm(), "cannot fuse %s", Bytecodes::name(second->bytecode()));
+  transition(first->tos_in(), second->tos_out());
+
+  first->generate(_masm);
+  if (first->tos_out() != second->tos_in()) {
+    assert(second->tos_in() == vtos, "inconsistent tos states");
+    _masm->push(first->tos_out());
+  }
+  second->generate(_masm);
+  _desc = desc;
+}
+
+
 
 //----------------------------------------------------------------------------------------------------
 // Implementation of TemplateTable: Debugging
@@ -497,6 +523,13 @@ void TemplateTable::initialize() {
   def(Bytecodes::_nofast_aload_0      , ____|____|clvm|____, vtos, atos, nofast_aload_0      ,  _           );
   def(Bytecodes::_nofast_iload        , ubcp|____|clvm|____, vtos, itos, nofast_iload        ,  _           );
 
+  def(Bytecodes::_fast_aload_0_aload_1, ____|____|____|____, vtos, atos, fast_pair           ,  _           );
+  def(Bytecodes::_fast_aload_0_iload_1, ____|____|____|____, vtos, itos, fast_pair           ,  _           );
+  def(Bytecodes::_fast_aload_1_iload_2, ____|____|____|____, vtos, itos, fast_pair           ,  _           );
+  def(Bytecodes::_fast_iload_1_iload_2, ____|____|____|____, vtos, itos, fast_pair           ,  _           );
+  def(Bytecodes::_fast_iconst_1_iadd  , ____|____|____|____, vtos, itos, fast_pair           ,  _           );
+  def(Bytecodes::_fast_iconst_1_isub  , ____|____|____|____, vtos, itos, fast_pair           ,  _           );
+
   def(Bytecodes::_shouldnotreachhere   , ____|____|____|____, vtos, vtos, shouldnotreachhere ,  _           );
 }
 
@@ -23,16 +23,25 @@
  */
 
 #include "precompiled.hpp"
+#include "gc/shared/collectedHeap.hpp"
 #include "jfr/leakprofiler/leakProfiler.hpp"
 #include "jfr/leakprofiler/startOperation.hpp"
 #include "jfr/leakprofiler/stopOperation.hpp"
+#include "jfr/jfrEvents.hpp"
 #include "jfr/leakprofiler/checkpoint/eventEmitter.hpp"
+#include "jfr/leakprofiler/sampling/objectSample.hpp"
 #include "jfr/leakprofiler/sampling/objectSampler.hpp"
 #include "jfr/recorder/service/jfrOptionSet.hpp"
 #include "logging/log.hpp"
 #include "memory/iterator.hpp"
+#include "memory/resourceArea.hpp"
+#include "memory/universe.hpp"
+#include "oops/oop.inline.hpp"
 #include "runtime/javaThread.inline.hpp"
 #include "runtime/vmThread.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/powerOfTwo.hpp"
+#include "utilities/ticks.hpp"
 
 bool LeakProfiler::is_running() {
   return ObjectSampler::is_created();
@@ -89,6 +98,95 @@ void LeakProfiler::emit_events(int64_t cutoff_ticks, bool emit_all, bool skip_bf
   ObjectSampler::release();
 }
 
+// Collections survived are reported in power of two buckets, the last one
+// holding all samples that survived at least this many collections.
+static const uint max_gc_age_bucket = 16;
+
+static uint gc_age_bucket(const ObjectSample* sample, uint gc_count) {
+  const uint survived = gc_count - sample->gc_count();
+  return survived == 0 ? 0 : MIN2(round_down_power_of_2(survived), max_gc_age_bucket);
+}
+
+struct LiveSample {
+  const Klass* _klass;
+  traceid _stack_trace_hash;
+  size_t _size;
+  uint _gc_age;
+};
+
+static int compare_live_samples(LiveSample* a, LiveSample* b) {
+  if (a->_klass != b->_klass) {
+    return a->_klass < b->_klass ? -1 : 1;
+  }
+  if (a->_gc_age != b->_gc_age) {
+    return a->_gc_age < b->_gc_age ? -1 : 1;
+  }
+  if (a->_stack_trace_hash != b->_stack_trace_hash) {
+    return a->_stack_trace_hash < b->_stack_trace_hash ? -1 : 1;
+  }
+  return 0;
+}
+
+static void send_statistics_event(const Ticks& timestamp, const LiveSample& first, u8 samples, u8 size, u4 stack_traces) {
+  EventOldObjectSampleStatistics event(UNTIMED);
+  event.set_starttime(timestamp);
+  event.set_objectClass(first._klass);
+  event.set_gcAge(first._gc_age);
+  event.set_samples(samples);
+  event.set_objectSize(size);
+  event.set_stackTraces(stack_traces);
+  event.commit();
+}
+
+// Summarizes the samples that are still alive by class and by the number of
+// collections they survived. Liveness is maintained by the GC processing the
+// weak references to the sampled objects, so the summary is available without
+// the paths to gc roots and the safepoint needed to emit OldObjectSample events.
+void LeakProfiler::emit_statistics(const Ticks& timestamp) {
+  if (!is_running()) {
+    return;
+  }
+  if (!EventOldObjectSampleStatistics::is_enabled()) {
+    return;
+  }
+  ResourceMark rm;
+  GrowableArray<LiveSample> live_samples;
+  // exclusive access to object sampler instance
+  ObjectSampler* const sampler = ObjectSampler::acquire();
+  assert(sampler != nullptr, "invariant");
+  const uint gc_count = Universe::heap()->total_collections();
+  for (const ObjectSample* sample = sampler->last(); sample != nullptr; sample = sample->next()) {
+    const oop obj = sample->object();
+    if (obj == nullptr) {
+      continue;
+    }
+    const LiveSample live_sample = { obj->klass(), sample->stack_trace_hash(), sample->allocated(), gc_age_bucket(sample, gc_count) };
+    live_samples.append(live_sample);
+  }
+  live_samples.sort(compare_live_samples);
+  // The sampled objects keep the classes alive while the sampler is held.
+  int start = 0;
+  while (start < live_samples.length()) {
+    const LiveSample& first = live_samples.at(start);
+    u8 size = 0;
+    u4 stack_traces = 0;
+    int end = start;
+    for (; end < live_samples.length(); end++) {
+      const LiveSample& current = live_samples.at(end);
+      if (current._klass != first._klass || current._gc_age != first._gc_age) {
+        break;
+      }
+      if (end == start || current._stack_trace_hash != live_samples.at(end - 1)._stack_trace_hash) {
+        stack_traces++;
+      }
+      size += current._size;
+    }
+    send_statistics_event(timestamp, first, (u8)(end - start), size, stack_traces);
+    start = end;
+  }
+  ObjectSampler::release();
+}
+
 void LeakProfiler::sample(HeapWord* object, size_t size, JavaThread* thread) {
   assert(is_running(), "invariant");
   assert(thread != nullptr, "invariant");
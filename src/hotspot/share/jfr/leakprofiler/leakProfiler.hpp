@@ -27,6 +27,7 @@
 
 #include "memory/allStatic.hpp"
 #include "utilities/globalDefinitions.hpp"
+#include "utilities/ticks.hpp"
 
 class JavaThread;
 
@@ -37,6 +38,7 @@ class LeakProfiler : public AllStatic {
   static bool is_running();
 
   static void emit_events(int64_t cutoff_ticks, bool emit_all, bool skip_bfs);
+  static void emit_statistics(const Ticks& timestamp);
   static void sample(HeapWord* object, size_t size, JavaThread* thread);
 };
 
@@ -57,6 +57,7 @@ class ObjectSample : public JfrCHeapObj {
   size_t _span;
   size_t _allocated;
   size_t _heap_used_at_last_gc;
+  uint _gc_count;
   int _index;
   bool _virtual_thread;
 
@@ -81,6 +82,7 @@ class ObjectSample : public JfrCHeapObj {
                    _span(0),
                    _allocated(0),
                    _heap_used_at_last_gc(0),
+                   _gc_count(0),
                    _index(0),
                    _virtual_thread(false) {}
 
@@ -158,6 +160,15 @@ class ObjectSample : public JfrCHeapObj {
     return _heap_used_at_last_gc;
   }
 
+  // The number of collections started before the object was allocated.
+  void set_gc_count(uint gc_count) {
+    _gc_count = gc_count;
+  }
+
+  uint gc_count() const {
+    return _gc_count;
+  }
+
   bool has_stack_trace_id() const {
     return stack_trace_id() != 0;
   }
@@ -283,6 +283,7 @@ void ObjectSampler::add(HeapWord* obj, size_t allocated, traceid thread_id, bool
   sample->set_allocated(allocated);
   sample->set_allocation_time(JfrTicks::now());
   sample->set_heap_used_at_last_gc(Universe::heap()->used_at_last_gc());
+  sample->set_gc_count(Universe::heap()->total_collections());
   _priority_queue->push(sample);
 }
 
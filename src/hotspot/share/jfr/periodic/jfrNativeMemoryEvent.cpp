@@ -27,6 +27,7 @@
 #include "jfr/periodic/jfrNativeMemoryEvent.hpp"
 #include "nmt/memTracker.hpp"
 #include "nmt/nmtUsage.hpp"
+#include "nmt/nmtUsageHistory.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/ticks.hpp"
 
@@ -88,3 +89,32 @@ void JfrNativeMemoryEvent::send_type_events(const Ticks& timestamp) {
     send_type_event(timestamp, flag, usage->reserved(flag), usage->committed(flag));
   }
 }
+
+void JfrNativeMemoryEvent::send_growth_events(const Ticks& timestamp) {
+  if (!NMTUsageHistory::is_enabled()) {
+    return;
+  }
+
+  for (int index = 0; index < mt_number_of_types; index ++) {
+    MEMFLAGS flag = NMTUtil::index_to_flag(index);
+    if (flag == mtNone) {
+      continue;
+    }
+    NMTUsagePair usage;
+    double reserved_rate;
+    double committed_rate;
+    Tickspan window;
+    if (!NMTUsageHistory::growth(flag, &usage, &reserved_rate, &committed_rate, &window)) {
+      return;
+    }
+    EventNativeMemoryUsageGrowth event(UNTIMED);
+    event.set_starttime(timestamp);
+    event.set_type(index);
+    event.set_reserved(usage.reserved);
+    event.set_committed(usage.committed);
+    event.set_reservedGrowthRate(reserved_rate);
+    event.set_committedGrowthRate(committed_rate);
+    event.set_window(window);
+    event.commit();
+  }
+}
@@ -39,6 +39,7 @@ class JfrNativeMemoryEvent : public AllStatic {
  public:
   static void send_total_event(const Ticks& timestamp);
   static void send_type_events(const Ticks& timestamp);
+  static void send_growth_events(const Ticks& timestamp);
 };
 
 #endif //SHARE_JFR_PERIODIC_JFRNATIVEMEMORYEVENT_HPP
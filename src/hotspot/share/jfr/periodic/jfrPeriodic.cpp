@@ -36,6 +36,7 @@
 #include "gc/shared/gcVMOperations.hpp"
 #include "gc/shared/objectCountEventSender.hpp"
 #include "jfr/jfrEvents.hpp"
+#include "jfr/leakprofiler/leakProfiler.hpp"
 #include "jfr/periodic/jfrCompilerQueueUtilization.hpp"
 #include "jfr/periodic/jfrFinalizerStatisticsEvent.hpp"
 #include "jfr/periodic/jfrModuleEvent.hpp"
@@ -58,6 +59,7 @@
 #include "runtime/flags/jvmFlag.hpp"
 #include "runtime/globals.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/objectMonitor.hpp"
 #include "runtime/os.hpp"
 #include "runtime/os_perf.hpp"
 #include "runtime/thread.inline.hpp"
@@ -543,6 +545,14 @@ TRACE_REQUEST_FUNC(JavaThreadStatistics) {
   event.commit();
 }
 
+TRACE_REQUEST_FUNC(JavaMonitorSpinStatistics) {
+  EventJavaMonitorSpinStatistics event;
+  event.set_successfulSpins(ObjectMonitor::spin_successes());
+  event.set_failedSpins(ObjectMonitor::spin_failures());
+  event.set_ownerNotRunningSpins(ObjectMonitor::spin_owner_not_running());
+  event.commit();
+}
+
 TRACE_REQUEST_FUNC(GCHeapMemoryUsage) {
   MemoryUsage usage = Universe::heap()->memory_usage();
   EventGCHeapMemoryUsage event(UNTIMED);
@@ -728,6 +738,10 @@ TRACE_REQUEST_FUNC(FinalizerStatistics) {
 #endif
 }
 
+TRACE_REQUEST_FUNC(OldObjectSampleStatistics) {
+  LeakProfiler::emit_statistics(timestamp());
+}
+
 TRACE_REQUEST_FUNC(NativeMemoryUsage) {
   JfrNativeMemoryEvent::send_type_events(timestamp());
 }
@@ -735,3 +749,7 @@ TRACE_REQUEST_FUNC(NativeMemoryUsage) {
 TRACE_REQUEST_FUNC(NativeMemoryUsageTotal) {
   JfrNativeMemoryEvent::send_total_event(timestamp());
 }
+
+TRACE_REQUEST_FUNC(NativeMemoryUsageGrowth) {
+  JfrNativeMemoryEvent::send_growth_events(timestamp());
+}
@@ -102,7 +102,7 @@ static bool thread_state_in_native(JavaThread* thread) {
 
 class JfrThreadSampleClosure {
  public:
-  JfrThreadSampleClosure(EventExecutionSample* events, EventNativeMethodSample* events_native);
+  JfrThreadSampleClosure(EventExecutionSample* events, EventNativeMethodSample* events_native, jlong cpu_period_nanos);
   ~JfrThreadSampleClosure() {}
   EventExecutionSample* next_event() { return &_events[_added_java++]; }
   EventNativeMethodSample* next_event_native() { return &_events_native[_added_native++]; }
@@ -114,9 +114,11 @@ class JfrThreadSampleClosure {
  private:
   bool sample_thread_in_java(JavaThread* thread, JfrStackFrame* frames, u4 max_frames);
   bool sample_thread_in_native(JavaThread* thread, JfrStackFrame* frames, u4 max_frames);
+  bool has_consumed_cpu_period(JavaThread* thread, jlong* cpu_time) const;
   EventExecutionSample* _events;
   EventNativeMethodSample* _events_native;
   Thread* _self;
+  const jlong _cpu_period_nanos; // 0 unless sampling by cpu time
   uint _added_java;
   uint _added_native;
 };
@@ -201,6 +203,7 @@ void OSThreadSampler::protected_task(const SuspendedThreadTaskContext& context)
       ev->set_starttime(_suspend_time);
       ev->set_endtime(_suspend_time); // fake to not take an end time
       ev->set_sampledThread(JfrThreadLocal::thread_id(jt));
+      ev->set_carrierThread(JfrThreadLocal::jvm_thread_id(jt));
       ev->set_state(static_cast<u8>(JavaThreadStatus::RUNNABLE));
     }
   }
@@ -231,6 +234,7 @@ static void write_native_event(JfrThreadSampleClosure& closure, JavaThread* jt,
   EventNativeMethodSample *ev = closure.next_event_native();
   ev->set_starttime(JfrTicks::now());
   ev->set_sampledThread(JfrThreadLocal::thread_id(jt));
+  ev->set_carrierThread(JfrThreadLocal::jvm_thread_id(jt));
   ev->set_state(static_cast<u8>(JavaThreadStatus::RUNNABLE));
 }
 
@@ -327,10 +331,11 @@ void JfrThreadSampleClosure::commit_events(JfrSampleType type) {
   }
 }
 
-JfrThreadSampleClosure::JfrThreadSampleClosure(EventExecutionSample* events, EventNativeMethodSample* events_native) :
+JfrThreadSampleClosure::JfrThreadSampleClosure(EventExecutionSample* events, EventNativeMethodSample* events_native, jlong cpu_period_nanos) :
   _events(events),
   _events_native(events_native),
   _self(Thread::current()),
+  _cpu_period_nanos(cpu_period_nanos),
   _added_java(0),
   _added_native(0) {
 }
@@ -375,6 +380,7 @@ class JfrThreadSampler : public NonJavaThread {
   static void on_javathread_suspend(JavaThread* thread);
   int64_t get_java_period() const { return Atomic::load(&_java_period_millis); };
   int64_t get_native_period() const { return Atomic::load(&_native_period_millis); };
+  static bool sample_by_cpu_time() { return JfrSampleThreadsByCPUTime && os::is_thread_cpu_time_supported(); }
 };
 
 static void clear_transition_block(JavaThread* jt) {
@@ -392,6 +398,24 @@ static bool is_excluded(JavaThread* thread) {
   return thread->is_hidden_from_external_view() || thread->in_deopt_handler() || thread->jfr_thread_local()->is_excluded();
 }
 
+/*
+ * When sampling by cpu time, a thread is only sampled once it has consumed
+ * a full sampling period of cpu time since it was last sampled. Threads that
+ * are runnable but not running, or only run in short bursts, are then sampled
+ * in proportion to the cpu they actually use rather than to wall-clock time.
+ */
+bool JfrThreadSampleClosure::has_consumed_cpu_period(JavaThread* thread, jlong* cpu_time) const {
+  if (_cpu_period_nanos == 0) {
+    return true;
+  }
+  *cpu_time = os::thread_cpu_time(thread);
+  if (*cpu_time < 0) {
+    // Not available for this thread, fall back to wall-clock sampling.
+    return true;
+  }
+  return *cpu_time - thread->jfr_thread_local()->get_sampled_cpu_time() >= _cpu_period_nanos;
+}
+
 bool JfrThreadSampleClosure::do_sample_thread(JavaThread* thread, JfrStackFrame* frames, u4 max_frames, JfrSampleType type) {
   assert(Threads_lock->owned_by_self(), "Holding the thread table lock.");
   if (is_excluded(thread)) {
@@ -404,8 +428,12 @@ bool JfrThreadSampleClosure::do_sample_thread(JavaThread* thread, JfrStackFrame*
     SystemMemoryBarrier::emit();
   }
   if (JAVA_SAMPLE == type) {
-    if (thread_state_in_java(thread)) {
+    jlong cpu_time = -1;
+    if (thread_state_in_java(thread) && has_consumed_cpu_period(thread, &cpu_time)) {
       ret = sample_thread_in_java(thread, frames, max_frames);
+      if (ret && cpu_time >= 0) {
+        thread->jfr_thread_local()->set_sampled_cpu_time(cpu_time);
+      }
     }
   } else {
     assert(NATIVE_SAMPLE == type, "invariant");
@@ -587,7 +615,9 @@ void JfrThreadSampler::task_stacktrace(JfrSampleType type, JavaThread** last_thr
   ResourceMark rm;
   EventExecutionSample samples[MAX_NR_OF_JAVA_SAMPLES];
   EventNativeMethodSample samples_native[MAX_NR_OF_NATIVE_SAMPLES];
-  JfrThreadSampleClosure sample_task(samples, samples_native);
+  const jlong cpu_period_nanos = JAVA_SAMPLE == type && sample_by_cpu_time() ?
+    MAX2<int64_t>(get_java_period(), 1) * NANOSECS_PER_MILLISEC : 0;
+  JfrThreadSampleClosure sample_task(samples, samples_native, cpu_period_nanos);
 
   const uint sample_limit = JAVA_SAMPLE == type ? MAX_NR_OF_JAVA_SAMPLES : MAX_NR_OF_NATIVE_SAMPLES;
   uint num_samples = 0;
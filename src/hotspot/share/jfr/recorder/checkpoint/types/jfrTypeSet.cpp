@@ -1163,9 +1163,17 @@ static void write_symbols() {
     return;
   }
   SymbolEntryWriter sw(_writer, unloading());
-  _artifacts->iterate_symbols(sw);
   StringEntryWriter sew(_writer, unloading(), true); // skip header
-  _artifacts->iterate_strings(sew);
+  if (flushpoint()) {
+    // A flushpoint serializes all entries, so only the entries added since
+    // the previous flushpoint need to be visited.
+    _artifacts->iterate_new_symbols(sw);
+    _artifacts->iterate_new_strings(sew);
+    _artifacts->set_all_symbols_serialized();
+  } else {
+    _artifacts->iterate_symbols(sw);
+    _artifacts->iterate_strings(sew);
+  }
   sw.add(sew.count());
   _artifacts->tally(sw);
 }
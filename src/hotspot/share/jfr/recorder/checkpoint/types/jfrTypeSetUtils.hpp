@@ -241,6 +241,20 @@ class JfrArtifactSet : public JfrCHeapObj {
     _symbol_table->iterate_strings(functor);
   }
 
+  template <typename T>
+  void iterate_new_symbols(T& functor) {
+    _symbol_table->iterate_new_symbols(functor);
+  }
+
+  template <typename T>
+  void iterate_new_strings(T& functor) {
+    _symbol_table->iterate_new_strings(functor);
+  }
+
+  void set_all_symbols_serialized() {
+    _symbol_table->set_all_serialized();
+  }
+
   template <typename Writer>
   void tally(Writer& writer) {
     _total_count += writer.count();
@@ -167,13 +167,14 @@ class JfrEvent {
     } else if (_end_time == 0) {
       set_endtime(JfrTicks::now());
     }
+    // Any event can be configured to be throttled, not only those declared with a throttle setting.
     if (T::isInstant || T::isRequestable) {
-      return T::hasThrottle ? JfrEventThrottler::accept(T::eventId, _untimed ? 0 : _start_time) : true;
+      return JfrEventThrottler::accept(T::eventId, _untimed ? 0 : _start_time);
     }
     if (_end_time - _start_time < JfrEventSetting::threshold(T::eventId)) {
       return false;
     }
-    return T::hasThrottle ? JfrEventThrottler::accept(T::eventId, _untimed ? 0 : _end_time) : true;
+    return JfrEventThrottler::accept(T::eventId, _untimed ? 0 : _end_time);
   }
 
   traceid thread_id(Thread* thread) {
@@ -199,6 +200,9 @@ class JfrEvent {
     JfrThreadLocal* const tl = thread->jfr_thread_local();
     const traceid tid = thread_id(thread);
     const traceid sid = stack_trace_id(thread, tl);
+    if (sid != 0 && !JfrEventThrottler::accept_stack_trace(T::eventId, sid)) {
+      return;
+    }
     // Keep tid and sid above this line.
     JfrBuffer* const buffer = tl->native_buffer();
     if (buffer == nullptr) {
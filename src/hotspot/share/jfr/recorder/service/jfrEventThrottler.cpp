@@ -27,6 +27,8 @@
 #include "jfr/recorder/service/jfrEventThrottler.hpp"
 #include "jfr/utilities/jfrSpinlockHelper.hpp"
 #include "logging/log.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
 
 constexpr static const JfrSamplerParams _disabled_params = {
                                                              0, // sample points per window
@@ -35,7 +37,14 @@ constexpr static const JfrSamplerParams _disabled_params = {
                                                              false // reconfigure
                                                            };
 
-static JfrEventThrottler* _throttler = nullptr;
+// Throttlers are created on demand, when an event is configured to be throttled.
+// The jdk.ObjectAllocationSample event is always throttled, its throttler is created eagerly.
+static JfrEventThrottler* volatile _throttlers[LAST_EVENT_ID + 1] = { nullptr };
+static volatile int _create_lock = 0;
+
+// Number of slots for the stack traces accepted per window.
+static const size_t stack_trace_slots_log2 = 10;
+static const size_t stack_trace_slots = 1 << stack_trace_slots_log2;
 
 JfrEventThrottler::JfrEventThrottler(JfrEventId event_id) :
   JfrAdaptiveSampler(),
@@ -44,34 +53,75 @@ JfrEventThrottler::JfrEventThrottler(JfrEventId event_id) :
   _period_ms(0),
   _sample_size_ewma(0),
   _event_id(event_id),
+  _stack_traces(nullptr),
+  _window_count(0),
   _disabled(false),
   _update(false) {}
 
+JfrEventThrottler::~JfrEventThrottler() {
+  if (_stack_traces != nullptr) {
+    JfrCHeapObj::free(const_cast<u8*>(_stack_traces), stack_trace_slots * sizeof(u8));
+  }
+}
+
+bool JfrEventThrottler::initialize() {
+  if (JfrThrottleDeduplicateStackTraces) {
+    _stack_traces = JfrCHeapObj::new_array<u8>(stack_trace_slots);
+    if (_stack_traces == nullptr) {
+      return false;
+    }
+    memset(const_cast<u8*>(_stack_traces), 0, stack_trace_slots * sizeof(u8));
+  }
+  return JfrAdaptiveSampler::initialize();
+}
+
+JfrEventThrottler* JfrEventThrottler::create_throttler(JfrEventId event_id) {
+  assert(event_id >= FIRST_EVENT_ID && event_id <= LAST_EVENT_ID, "invariant");
+  JfrEventThrottler* throttler = new JfrEventThrottler(event_id);
+  if (throttler != nullptr && !throttler->initialize()) {
+    delete throttler;
+    throttler = nullptr;
+  }
+  return throttler;
+}
+
 bool JfrEventThrottler::create() {
-  assert(_throttler == nullptr, "invariant");
-  _throttler = new JfrEventThrottler(JfrObjectAllocationSampleEvent);
-  return _throttler != nullptr && _throttler->initialize();
+  assert(_throttlers[JfrObjectAllocationSampleEvent] == nullptr, "invariant");
+  JfrEventThrottler* const throttler = create_throttler(JfrObjectAllocationSampleEvent);
+  Atomic::release_store(&_throttlers[JfrObjectAllocationSampleEvent], throttler);
+  return throttler != nullptr;
 }
 
 void JfrEventThrottler::destroy() {
-  delete _throttler;
-  _throttler = nullptr;
+  for (int i = FIRST_EVENT_ID; i <= LAST_EVENT_ID; ++i) {
+    delete _throttlers[i];
+    _throttlers[i] = nullptr;
+  }
 }
 
-// There is currently only one throttler instance, for the jdk.ObjectAllocationSample event.
-// When introducing additional throttlers, also add a lookup map keyed by event id.
 JfrEventThrottler* JfrEventThrottler::for_event(JfrEventId event_id) {
-  assert(_throttler != nullptr, "JfrEventThrottler has not been properly initialized");
-  assert(event_id == JfrObjectAllocationSampleEvent, "Event type has an unconfigured throttler");
-  return event_id == JfrObjectAllocationSampleEvent ? _throttler : nullptr;
+  assert(event_id >= FIRST_EVENT_ID && event_id <= LAST_EVENT_ID, "invariant");
+  return Atomic::load_acquire(&_throttlers[event_id]);
 }
 
 void JfrEventThrottler::configure(JfrEventId event_id, int64_t sample_size, int64_t period_ms) {
-  if (event_id != JfrObjectAllocationSampleEvent) {
+  if (event_id < FIRST_EVENT_ID || event_id > LAST_EVENT_ID) {
     return;
   }
-  assert(_throttler != nullptr, "JfrEventThrottler has not been properly initialized");
-  _throttler->configure(sample_size, period_ms);
+  JfrEventThrottler* throttler = for_event(event_id);
+  if (throttler == nullptr) {
+    JfrSpinlockHelper mutex(&_create_lock);
+    throttler = for_event(event_id);
+    if (throttler == nullptr) {
+      throttler = create_throttler(event_id);
+      if (throttler == nullptr) {
+        log_warning(jfr, system, throttle)("Unable to create a throttler for event id %u", (unsigned)event_id);
+        return;
+      }
+      Atomic::release_store(&_throttlers[event_id], throttler);
+    }
+  }
+  throttler->configure(sample_size, period_ms);
 }
 
 /*
@@ -94,7 +144,32 @@ void JfrEventThrottler::configure(int64_t sample_size, int64_t period_ms) {
 bool JfrEventThrottler::accept(JfrEventId event_id, int64_t timestamp /* 0 */) {
   JfrEventThrottler* const throttler = for_event(event_id);
   if (throttler == nullptr) return true;
-  return _throttler->_disabled ? true : _throttler->sample(timestamp);
+  return throttler->_disabled ? true : throttler->sample(timestamp);
+}
+
+// Predicate for event selection by stack trace, rejects the events of a stack trace
+// that has already been accepted in the current window. The slots are updated racily,
+// a lost update only lets a duplicate through.
+bool JfrEventThrottler::accept_stack_trace(JfrEventId event_id, traceid stack_trace_id) {
+  JfrEventThrottler* const throttler = for_event(event_id);
+  if (throttler == nullptr || throttler->_stack_traces == nullptr || throttler->_disabled) {
+    return true;
+  }
+  return throttler->sample_stack_trace(stack_trace_id);
+}
+
+bool JfrEventThrottler::sample_stack_trace(traceid stack_trace_id) {
+  assert(_stack_traces != nullptr, "invariant");
+  assert(stack_trace_id != 0, "invariant");
+  // Stack trace ids are assigned in sequence, tagging with the window in the low bits
+  // keeps an entry from matching in later windows.
+  const u8 tagged_id = (stack_trace_id << 16) | (Atomic::load(&_window_count) & 0xffff);
+  volatile u8* const slot = &_stack_traces[(stack_trace_id * 0x9E3779B97F4A7C15ULL) >> (64 - stack_trace_slots_log2)];
+  if (Atomic::load(slot) == tagged_id) {
+    return false;
+  }
+  Atomic::store(slot, tagged_id);
+  return true;
 }
 
 /*
@@ -236,20 +311,19 @@ inline double compute_ewma_alpha_coefficient(size_t lookback_count) {
  *
  * Excerpt:
  *
- * "jdk.ObjectAllocationSample: avg.sample size: 19.8377, window set point: 20 ..."
+ * "jdk.ObjectAllocationSample (<event id>): avg.sample size: 19.8377, window set point: 20 ..."
  *
  * Monitoring the relation of average sample size to the window set point, i.e the target,
  * is a good indicator of how the throttler is performing over time.
  *
- * Note: there is currently only one throttler instance, for the ObjectAllocationSample event.
- * When introducing additional throttlers, also provide a map from the event id to the event name.
+ * Events other than jdk.ObjectAllocationSample are logged by their event id.
  */
-static void log(const JfrSamplerWindow* expired, double* sample_size_ewma) {
+static void log(JfrEventId event_id, const JfrSamplerWindow* expired, double* sample_size_ewma) {
   assert(sample_size_ewma != nullptr, "invariant");
   if (log_is_enabled(Debug, jfr, system, throttle)) {
     *sample_size_ewma = exponentially_weighted_moving_average(static_cast<double>(expired->sample_size()), compute_ewma_alpha_coefficient(expired->params().window_lookback_count), *sample_size_ewma);
-    log_debug(jfr, system, throttle)("jdk.ObjectAllocationSample: avg.sample size: %0.4f, window set point: %zu, sample size: %zu, population size: %zu, ratio: %.4f, window duration: %zu ms\n",
-      *sample_size_ewma, expired->params().sample_points_per_window, expired->sample_size(), expired->population_size(),
+    log_debug(jfr, system, throttle)("%s (%u): avg.sample size: %0.4f, window set point: %zu, sample size: %zu, population size: %zu, ratio: %.4f, window duration: %zu ms\n",
+      event_id == JfrObjectAllocationSampleEvent ? "jdk.ObjectAllocationSample" : "Event", (unsigned)event_id, *sample_size_ewma, expired->params().sample_points_per_window, expired->sample_size(), expired->population_size(),
       expired->population_size() == 0 ? 0 : static_cast<double>(expired->sample_size()) / static_cast<double>(expired->population_size()),
       expired->params().window_duration_ms);
   }
@@ -268,7 +342,8 @@ static void log(const JfrSamplerWindow* expired, double* sample_size_ewma) {
 const JfrSamplerParams& JfrEventThrottler::next_window_params(const JfrSamplerWindow* expired) {
   assert(expired != nullptr, "invariant");
   assert(_lock, "invariant");
-  log(expired, &_sample_size_ewma);
+  log(_event_id, expired, &_sample_size_ewma);
+  Atomic::inc(&_window_count);
   if (_update) {
     return update_params(expired); // Updates _last_params in-place.
   }
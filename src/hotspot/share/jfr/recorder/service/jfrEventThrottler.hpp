@@ -28,6 +28,7 @@
 
 #include "jfrfiles/jfrEventIds.hpp"
 #include "jfr/support/jfrAdaptiveSampler.hpp"
+#include "jfr/utilities/jfrTypes.hpp"
 
 class JfrEventThrottler : public JfrAdaptiveSampler {
   friend class JfrRecorder;
@@ -37,13 +38,20 @@ class JfrEventThrottler : public JfrAdaptiveSampler {
   int64_t _period_ms;
   double _sample_size_ewma;
   JfrEventId _event_id;
+  // Stack trace ids, tagged with the window they were accepted in.
+  volatile u8* _stack_traces;
+  volatile u4 _window_count;
   bool _disabled;
   bool _update;
 
   static bool create();
   static void destroy();
+  static JfrEventThrottler* create_throttler(JfrEventId event_id);
   JfrEventThrottler(JfrEventId event_id);
+  ~JfrEventThrottler();
+  bool initialize();
   void configure(int64_t event_sample_size, int64_t period_ms);
+  bool sample_stack_trace(traceid stack_trace_id);
 
   const JfrSamplerParams& update_params(const JfrSamplerWindow* expired);
   const JfrSamplerParams& next_window_params(const JfrSamplerWindow* expired);
@@ -52,6 +60,7 @@ class JfrEventThrottler : public JfrAdaptiveSampler {
  public:
   static void configure(JfrEventId event_id, int64_t event_sample_size, int64_t period_ms);
   static bool accept(JfrEventId event_id, int64_t timestamp = 0);
+  static bool accept_stack_trace(JfrEventId event_id, traceid stack_trace_id);
 };
 
 #endif // SHARE_JFR_RECORDER_SERVICE_JFREVENTTHROTTLER_HPP
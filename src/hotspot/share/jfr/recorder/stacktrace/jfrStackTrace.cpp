@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "jfr/recorder/checkpoint/jfrCheckpointWriter.hpp"
+#include "jfr/recorder/checkpoint/types/traceid/jfrTraceIdEpoch.hpp"
 #include "jfr/recorder/checkpoint/types/traceid/jfrTraceId.inline.hpp"
 #include "jfr/recorder/repository/jfrChunkWriter.hpp"
 #include "jfr/recorder/stacktrace/jfrStackTrace.hpp"
@@ -55,7 +56,6 @@ JfrStackFrame::JfrStackFrame(const traceid& id, int bci, u1 type, int lineno, co
   _klass(ik), _methodid(id), _line(lineno), _bci(bci), _type(type) {}
 
 JfrStackTrace::JfrStackTrace(JfrStackFrame* frames, u4 max_frames) :
-  _next(nullptr),
   _frames(frames),
   _id(0),
   _hash(0),
@@ -66,8 +66,7 @@ JfrStackTrace::JfrStackTrace(JfrStackFrame* frames, u4 max_frames) :
   _lineno(false),
   _written(false) {}
 
-JfrStackTrace::JfrStackTrace(traceid id, const JfrStackTrace& trace, const JfrStackTrace* next) :
-  _next(next),
+JfrStackTrace::JfrStackTrace(traceid id, const JfrStackTrace& trace) :
   _frames(nullptr),
   _id(id),
   _hash(trace._hash),
@@ -148,6 +147,7 @@ class JfrVframeStream : public vframeStreamCommon {
  public:
   JfrVframeStream(JavaThread* jt, const frame& fr, bool stop_at_java_call_stub, bool async_mode);
   void next_vframe();
+  JfrFrameKey frame_key() const;
 };
 
 static RegisterMap::WalkContinuation walk_continuation(JavaThread* jt) {
@@ -226,6 +226,90 @@ void JfrVframeStream::next_vframe() {
   next_frame();
 }
 
+static inline JfrFrameKey frame_key_of(const frame& f) {
+  JfrFrameKey key;
+  key._id = f.id();
+  if (f.is_interpreted_frame()) {
+    const Method* const method = f.interpreter_frame_method();
+    key._code = method;
+    key._method_id = JfrTraceId::load_raw(method);
+    key._position = f.interpreter_frame_bci();
+  } else {
+    assert(f.cb() != nullptr && f.cb()->is_nmethod(), "invariant");
+    key._code = f.pc();
+    key._method_id = 0;
+    key._position = f.cb()->as_nmethod()->compile_id();
+  }
+  return key;
+}
+
+JfrFrameKey JfrVframeStream::frame_key() const {
+  return frame_key_of(_frame);
+}
+
+JfrStackTracePrefixCache::JfrStackTracePrefixCache(u4 capacity) :
+  _capacity(capacity),
+  _keys(NEW_C_HEAP_ARRAY(JfrFrameKey, capacity, mtTracing)),
+  _first_frame(NEW_C_HEAP_ARRAY(u4, capacity, mtTracing)),
+  _next_keys(NEW_C_HEAP_ARRAY(JfrFrameKey, capacity, mtTracing)),
+  _next_first_frame(NEW_C_HEAP_ARRAY(u4, capacity, mtTracing)),
+  _probe_keys(NEW_C_HEAP_ARRAY(JfrFrameKey, capacity, mtTracing)),
+  _frames(NEW_C_HEAP_ARRAY(JfrStackFrame, capacity, mtTracing)),
+  _nr_of_keys(0),
+  _nr_of_frames(0),
+  _epoch(0),
+  _valid(false) {}
+
+JfrStackTracePrefixCache::~JfrStackTracePrefixCache() {
+  FREE_C_HEAP_ARRAY(JfrFrameKey, _keys);
+  FREE_C_HEAP_ARRAY(u4, _first_frame);
+  FREE_C_HEAP_ARRAY(JfrFrameKey, _next_keys);
+  FREE_C_HEAP_ARRAY(u4, _next_first_frame);
+  FREE_C_HEAP_ARRAY(JfrFrameKey, _probe_keys);
+  FREE_C_HEAP_ARRAY(JfrStackFrame, _frames);
+}
+
+// Collect the keys of the physical frames that JfrVframeStream visits, in the
+// same order, but without decoding them. Fails if the stack is too deep to be
+// recorded in full.
+bool JfrStackTracePrefixCache::collect_keys(JavaThread* jt, const frame& top, u4* nr_of_keys) {
+  RegisterMap map(jt,
+                  RegisterMap::UpdateMap::skip,
+                  RegisterMap::ProcessFrames::skip,
+                  RegisterMap::WalkContinuation::skip);
+  frame f = top;
+  u4 count = 0;
+  while (true) {
+    if (f.is_interpreted_frame() || (f.cb() != nullptr && f.cb()->is_nmethod())) {
+      if (count == _capacity) {
+        return false;
+      }
+      _probe_keys[count++] = frame_key_of(f);
+    } else if (f.is_first_frame()) {
+      break;
+    }
+    f = f.sender(&map);
+  }
+  *nr_of_keys = count;
+  return true;
+}
+
+// Make the trace described by the frames and by _next_keys and
+// _next_first_frame the cached trace.
+void JfrStackTracePrefixCache::update(const JfrStackFrame* frames, u4 nr_of_frames, u4 nr_of_keys) {
+  assert(nr_of_keys > 0, "invariant");
+  const u4 first_frame = _next_first_frame[0];
+  _nr_of_frames = nr_of_frames - first_frame;
+  memcpy(_frames, frames + first_frame, _nr_of_frames * sizeof(JfrStackFrame));
+  _nr_of_keys = nr_of_keys;
+  for (u4 i = 0; i < nr_of_keys; ++i) {
+    _next_first_frame[i] -= first_frame;
+  }
+  swap(_keys, _next_keys);
+  swap(_first_frame, _next_first_frame);
+  _valid = true;
+}
+
 static const size_t min_valid_free_size_bytes = 16;
 
 static inline bool is_full(const JfrBuffer* enqueue_buffer) {
@@ -295,6 +379,14 @@ bool JfrStackTrace::record(JavaThread* jt, const frame& frame, int skip, int64_t
   // This is because RegisterMap uses Handles to support continuations.
   ResetNoHandleMark rnhm;
   HandleMark hm(jt);
+  const JfrStackFilter* stack_filter = JfrStackFilterRegistry::lookup(stack_filter_id);
+  if (JfrCacheStackTracePrefixes && stack_filter == nullptr &&
+      !JfrThreadLocal::is_vthread(jt) && jt->last_continuation() == nullptr) {
+    JfrStackTracePrefixCache* const cache = jt->jfr_thread_local()->stack_trace_prefix_cache();
+    if (cache != nullptr && cache->_capacity >= _max_frames) {
+      return record(jt, frame, skip, cache);
+    }
+  }
   JfrVframeStream vfs(jt, frame, false, false);
   u4 count = 0;
   _reached_root = true;
@@ -304,7 +396,6 @@ bool JfrStackTrace::record(JavaThread* jt, const frame& frame, int skip, int64_t
     }
     vfs.next_vframe();
   }
-  const JfrStackFilter* stack_filter = JfrStackFilterRegistry::lookup(stack_filter_id);
   _hash = 1;
   while (!vfs.at_end()) {
     if (count >= _max_frames) {
@@ -344,6 +435,116 @@ bool JfrStackTrace::record(JavaThread* jt, const frame& frame, int skip, int64_t
   return count > 0;
 }
 
+bool JfrStackTrace::record(JavaThread* jt, const frame& frame, int skip, JfrStackTracePrefixCache* cache) {
+  const u1 epoch = JfrTraceIdEpoch::current();
+  if (cache->_epoch != epoch) {
+    // Methods must be tagged again in a new epoch
+    cache->_valid = false;
+    cache->_epoch = epoch;
+  }
+
+  // Find the outermost physical frames that are shared with the cached trace.
+  const intptr_t* match_id = nullptr;
+  u4 match_key = 0;
+  u4 nr_of_probe_keys = 0;
+  if (cache->_valid && cache->_nr_of_frames >= JfrStackTracePrefixCache::MIN_CACHED_FRAMES &&
+      cache->collect_keys(jt, frame, &nr_of_probe_keys)) {
+    u4 shared = 0;
+    while (shared < nr_of_probe_keys && shared < cache->_nr_of_keys &&
+           cache->_probe_keys[nr_of_probe_keys - 1 - shared].equals(cache->_keys[cache->_nr_of_keys - 1 - shared])) {
+      ++shared;
+    }
+    if (shared > 0) {
+      match_key = cache->_nr_of_keys - shared;
+      match_id = cache->_keys[match_key]._id;
+    }
+  }
+
+  JfrVframeStream vfs(jt, frame, false, false);
+  const intptr_t* skipped_id = nullptr;
+  for (int i = 0; i < skip; ++i) {
+    if (vfs.at_end()) {
+      break;
+    }
+    skipped_id = vfs.frame_id();
+    if (skipped_id == match_id) {
+      // The shared frames are not recorded from their first stack frame
+      match_id = nullptr;
+    }
+    vfs.next_vframe();
+  }
+
+  u4 count = 0;
+  u4 nr_of_keys = 0;
+  const intptr_t* current_id = skipped_id;
+  _reached_root = true;
+  _hash = 1;
+  while (!vfs.at_end()) {
+    if (count >= _max_frames) {
+      _reached_root = false;
+      break;
+    }
+    const intptr_t* const frame_id = vfs.frame_id();
+    if (frame_id != current_id) {
+      if (frame_id == match_id) {
+        // Copy the shared frames from the cache instead of walking them
+        const u4 first_cached = cache->_first_frame[match_key];
+        const u4 first_copied = count;
+        for (u4 i = first_cached; i < cache->_nr_of_frames; ++i) {
+          if (count >= _max_frames) {
+            _reached_root = false;
+            break;
+          }
+          const JfrStackFrame& cached = cache->_frames[i];
+          _hash = (_hash * 31) + cached._methodid;
+          _hash = (_hash * 31) + cached._bci;
+          _hash = (_hash * 31) + cached._type;
+          _frames[count++] = cached;
+        }
+        for (u4 k = match_key; k < cache->_nr_of_keys; ++k) {
+          cache->_next_keys[nr_of_keys] = cache->_keys[k];
+          cache->_next_first_frame[nr_of_keys] = first_copied + cache->_first_frame[k] - first_cached;
+          ++nr_of_keys;
+        }
+        break;
+      }
+      current_id = frame_id;
+      cache->_next_keys[nr_of_keys] = vfs.frame_key();
+      cache->_next_first_frame[nr_of_keys] = count;
+      ++nr_of_keys;
+    }
+    const Method* method = vfs.method();
+    const traceid mid = JfrTraceId::load(method);
+    u1 type = vfs.is_interpreted_frame() ? JfrStackFrame::FRAME_INTERPRETER : JfrStackFrame::FRAME_JIT;
+    int bci = 0;
+    if (method->is_native()) {
+      type = JfrStackFrame::FRAME_NATIVE;
+    } else {
+      bci = vfs.bci();
+    }
+
+    vfs.next_vframe();
+    if (type == JfrStackFrame::FRAME_JIT && !vfs.at_end() && frame_id == vfs.frame_id()) {
+      // This frame and the caller frame are both the same physical
+      // frame, so this frame is inlined into the caller.
+      type = JfrStackFrame::FRAME_INLINE;
+    }
+    _hash = (_hash * 31) + mid;
+    _hash = (_hash * 31) + bci;
+    _hash = (_hash * 31) + type;
+    _frames[count] = JfrStackFrame(mid, bci, type, method->method_holder());
+    count++;
+  }
+  _nr_of_frames = count;
+
+  if (_reached_root && nr_of_keys > 0) {
+    // Stack frames before the first key belong to a partially skipped
+    // physical frame and are not cached.
+    cache->update(_frames, count, nr_of_keys);
+  }
+  return count > 0;
+}
+
 bool JfrStackTrace::record(JavaThread* current_thread, int skip, int64_t stack_filter_id) {
   assert(current_thread != nullptr, "invariant");
   assert(current_thread == Thread::current(), "invariant");
@@ -35,6 +35,7 @@ class JfrCheckpointWriter;
 class JfrChunkWriter;
 
 class JfrStackFrame {
+  friend class JfrStackTrace;
   friend class ObjectSampleCheckpoint;
  private:
   const InstanceKlass* _klass;
@@ -61,6 +62,52 @@ class JfrStackFrame {
   };
 };
 
+// Identifies a physical frame together with the code position it executes.
+// Two frames with equal keys decode into the same JfrStackFrames.
+class JfrFrameKey {
+ public:
+  const intptr_t* _id;
+  const void* _code;   // pc for compiled frames, Method* for interpreted frames
+  traceid _method_id;  // guards against Method* reuse, 0 for compiled frames
+  int _position;       // compile id for compiled frames, bci for interpreted frames
+
+  bool equals(const JfrFrameKey& rhs) const {
+    return _id == rhs._id && _code == rhs._code && _position == rhs._position &&
+           _method_id == rhs._method_id;
+  }
+};
+
+// Per-thread cache of the last stack trace recorded by a thread, used with
+// JfrCacheStackTracePrefixes. The physical frames of the current stack are
+// first collected cheaply, without decoding them. Root-side frames whose keys
+// match the cached trace are still the same activations, so their stack frames
+// are copied from the cache and only the new top frames are decoded.
+class JfrStackTracePrefixCache : public JfrCHeapObj {
+  friend class JfrStackTrace;
+ private:
+  // Do not bother collecting frame keys for short traces
+  static const u4 MIN_CACHED_FRAMES = 16;
+
+  const u4 _capacity;
+  JfrFrameKey* _keys;        // physical frames of the cached trace, top to root
+  u4* _first_frame;          // index of the first stack frame of each physical frame
+  JfrFrameKey* _next_keys;   // physical frames of the trace being recorded
+  u4* _next_first_frame;
+  JfrFrameKey* _probe_keys;  // physical frames collected before decoding
+  JfrStackFrame* _frames;
+  u4 _nr_of_keys;
+  u4 _nr_of_frames;
+  u1 _epoch;
+  bool _valid;
+
+  bool collect_keys(JavaThread* jt, const frame& top, u4* nr_of_keys);
+  void update(const JfrStackFrame* frames, u4 nr_of_frames, u4 nr_of_keys);
+
+ public:
+  JfrStackTracePrefixCache(u4 capacity);
+  ~JfrStackTracePrefixCache();
+};
+
 class JfrStackTrace : public JfrCHeapObj {
   friend class JfrNativeSamplerCallback;
   friend class JfrStackTraceRepository;
@@ -69,7 +116,6 @@ class JfrStackTrace : public JfrCHeapObj {
   friend class OSThreadSampler;
   friend class StackTraceResolver;
  private:
-  const JfrStackTrace* _next;
   JfrStackFrame* _frames;
   traceid _id;
   traceid _hash;
@@ -80,8 +126,6 @@ class JfrStackTrace : public JfrCHeapObj {
   mutable bool _lineno;
   mutable bool _written;
 
-  const JfrStackTrace* next() const { return _next; }
-
   bool should_write() const { return !_written; }
   void write(JfrChunkWriter& cw) const;
   void write(JfrCheckpointWriter& cpw) const;
@@ -95,12 +139,13 @@ class JfrStackTrace : public JfrCHeapObj {
 
   bool record(JavaThread* current_thread, int skip, int64_t stack_frame_id);
   bool record(JavaThread* current_thread, const frame& frame, int skip, int64_t stack_frame_id);
+  bool record(JavaThread* current_thread, const frame& frame, int skip, JfrStackTracePrefixCache* cache);
   bool record_async(JavaThread* other_thread, const frame& frame);
 
   bool have_lineno() const { return _lineno; }
   bool full_stacktrace() const { return _reached_root; }
 
-  JfrStackTrace(traceid id, const JfrStackTrace& trace, const JfrStackTrace* next);
+  JfrStackTrace(traceid id, const JfrStackTrace& trace);
   JfrStackTrace(JfrStackFrame* frames, u4 max_frames);
   ~JfrStackTrace();
 
@@ -28,7 +28,12 @@
 #include "jfr/recorder/repository/jfrChunkWriter.hpp"
 #include "jfr/recorder/stacktrace/jfrStackTraceRepository.hpp"
 #include "jfr/support/jfrThreadLocal.hpp"
+#include "logging/log.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "utilities/globalCounter.inline.hpp"
+#include "utilities/powerOfTwo.hpp"
 
 /*
  * There are two separate repository instances.
@@ -51,8 +56,25 @@ static JfrStackTraceRepository& leak_profiler_instance() {
   return *_leak_profiler_instance;
 }
 
-JfrStackTraceRepository::JfrStackTraceRepository() : _last_entries(0), _entries(0) {
-  memset(_table, 0, sizeof(_table));
+JfrStackTraceRepository::Table::Table(u4 size) :
+  _size(size), _buckets(NEW_C_HEAP_ARRAY(JfrStackTrace* volatile, size, mtTracing)) {
+  assert(is_power_of_2(size), "invariant");
+  for (u4 i = 0; i < size; ++i) {
+    _buckets[i] = nullptr;
+  }
+}
+
+JfrStackTraceRepository::Table::~Table() {
+  FREE_C_HEAP_ARRAY(JfrStackTrace* volatile, _buckets);
+}
+
+JfrStackTraceRepository::JfrStackTraceRepository() :
+  _table(new Table(INITIAL_TABLE_SIZE)), _last_entries(0), _entries(0),
+  _lookups(0), _hits(0), _collisions(0) {}
+
+JfrStackTraceRepository::~JfrStackTraceRepository() {
+  delete_entries(_table);
+  delete _table;
 }
 
 JfrStackTraceRepository* JfrStackTraceRepository::create() {
@@ -102,24 +124,19 @@ size_t JfrStackTraceRepository::write(JfrChunkWriter& sw, bool clear) {
   if (_entries == 0) {
     return 0;
   }
+  log_statistics();
+  Table* const table = clear ? reset() : _table;
   int count = 0;
-  for (u4 i = 0; i < TABLE_SIZE; ++i) {
-    JfrStackTrace* stacktrace = _table[i];
-    while (stacktrace != nullptr) {
-      JfrStackTrace* next = const_cast<JfrStackTrace*>(stacktrace->next());
-      if (stacktrace->should_write()) {
-        stacktrace->write(sw);
-        ++count;
-      }
-      if (clear) {
-        delete stacktrace;
-      }
-      stacktrace = next;
+  for (u4 i = 0; i < table->_size; ++i) {
+    const JfrStackTrace* const stacktrace = table->_buckets[i];
+    if (stacktrace != nullptr && stacktrace->should_write()) {
+      stacktrace->write(sw);
+      ++count;
     }
   }
   if (clear) {
-    memset(_table, 0, sizeof(_table));
-    _entries = 0;
+    delete_entries(table);
+    delete table;
   }
   _last_entries = _entries;
   return count;
@@ -130,21 +147,46 @@ size_t JfrStackTraceRepository::clear(JfrStackTraceRepository& repo) {
   if (repo._entries == 0) {
     return 0;
   }
-  for (u4 i = 0; i < TABLE_SIZE; ++i) {
-    JfrStackTrace* stacktrace = repo._table[i];
-    while (stacktrace != nullptr) {
-      JfrStackTrace* next = const_cast<JfrStackTrace*>(stacktrace->next());
-      delete stacktrace;
-      stacktrace = next;
-    }
-  }
-  memset(repo._table, 0, sizeof(repo._table));
   const size_t processed = repo._entries;
-  repo._entries = 0;
+  Table* const table = repo.reset();
+  delete_entries(table);
+  delete table;
   repo._last_entries = 0;
   return processed;
 }
 
+// Publish an empty table and return the previous one, which is
+// no longer reachable by concurrent lookups.
+JfrStackTraceRepository::Table* JfrStackTraceRepository::reset() {
+  assert_lock_strong(JfrStacktrace_lock);
+  Table* const old_table = _table;
+  Atomic::release_store(&_table, new Table(INITIAL_TABLE_SIZE));
+  GlobalCounter::write_synchronize();
+  _entries = 0;
+  return old_table;
+}
+
+void JfrStackTraceRepository::delete_entries(Table* table) {
+  for (u4 i = 0; i < table->_size; ++i) {
+    delete table->_buckets[i];
+  }
+}
+
+void JfrStackTraceRepository::log_statistics() const {
+  LogTarget(Debug, jfr, system, stacktrace) lt;
+  if (lt.is_enabled()) {
+    const size_t lookups = Atomic::load(&_lookups);
+    const size_t hits = Atomic::load(&_hits);
+    const size_t collisions = Atomic::load(&_collisions);
+    lt.print("Stack trace repository: %u entries, table size %u, " SIZE_FORMAT " lookups, "
+             "hit rate %.1f%%, " SIZE_FORMAT " collisions (%.2f per lookup)",
+             _entries, Atomic::load(&_table)->_size, lookups,
+             lookups == 0 ? 0.0 : (double)hits * 100 / lookups,
+             collisions,
+             lookups == 0 ? 0.0 : (double)collisions / lookups);
+  }
+}
+
 traceid JfrStackTraceRepository::record(Thread* current_thread, int skip /* 0 */, int64_t stack_filter_id /* -1 */) {
   assert(current_thread == Thread::current(), "invariant");
   JfrThreadLocal* const tl = current_thread->jfr_thread_local();
@@ -198,35 +240,101 @@ void JfrStackTraceRepository::record_for_leak_profiler(JavaThread* current_threa
   }
 }
 
+traceid JfrStackTraceRepository::lookup(const Table* table, const JfrStackTrace& stacktrace, size_t* probes) {
+  const u4 mask = table->_size - 1;
+  for (u4 index = stacktrace._hash & mask; ; index = (index + 1) & mask) {
+    const JfrStackTrace* const entry = Atomic::load_acquire(&table->_buckets[index]);
+    if (entry == nullptr) {
+      return 0;
+    }
+    if (entry->equals(stacktrace)) {
+      return entry->id();
+    }
+    ++*probes;
+  }
+}
+
+void JfrStackTraceRepository::insert(Table* table, JfrStackTrace* stacktrace) {
+  const u4 mask = table->_size - 1;
+  u4 index = stacktrace->_hash & mask;
+  while (table->_buckets[index] != nullptr) {
+    index = (index + 1) & mask;
+  }
+  // Publish the fully constructed entry to concurrent lookups
+  Atomic::release_store(&table->_buckets[index], stacktrace);
+}
+
+JfrStackTraceRepository::Table* JfrStackTraceRepository::grow(Table* table) {
+  assert_lock_strong(JfrStacktrace_lock);
+  Table* const new_table = new Table(table->_size * 2);
+  for (u4 i = 0; i < table->_size; ++i) {
+    JfrStackTrace* const entry = table->_buckets[i];
+    if (entry != nullptr) {
+      insert(new_table, entry);
+    }
+  }
+  Atomic::release_store(&_table, new_table);
+  // The entries moved to the new table, only the bucket array is reclaimed
+  GlobalCounter::write_synchronize();
+  delete table;
+  return new_table;
+}
+
 traceid JfrStackTraceRepository::add_trace(const JfrStackTrace& stacktrace) {
-  MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
   assert(stacktrace._nr_of_frames > 0, "invariant");
-  const size_t index = stacktrace._hash % TABLE_SIZE;
-  const JfrStackTrace* table_entry = _table[index];
-
-  while (table_entry != nullptr) {
-    if (table_entry->equals(stacktrace)) {
-      return table_entry->id();
+  const bool stats = log_is_enabled(Debug, jfr, system, stacktrace);
+  size_t probes = 0;
+  traceid id;
+  {
+    GlobalCounter::CriticalSection cs(Thread::current());
+    id = lookup(Atomic::load_acquire(&_table), stacktrace, &probes);
+  }
+  if (stats) {
+    Atomic::inc(&_lookups);
+    if (id != 0) {
+      Atomic::inc(&_hits);
+    }
+    if (probes != 0) {
+      Atomic::add(&_collisions, probes);
     }
-    table_entry = table_entry->next();
+  }
+  if (id != 0) {
+    return id;
+  }
+
+  MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
+  // Another thread might have added the trace since the lock-free lookup
+  Table* table = _table;
+  probes = 0;
+  id = lookup(table, stacktrace, &probes);
+  if (id != 0) {
+    return id;
   }
 
   if (!stacktrace.have_lineno()) {
     return 0;
   }
 
-  traceid id = ++_next_id;
-  _table[index] = new JfrStackTrace(id, stacktrace, _table[index]);
+  // Keep the load factor at or below one half, so probe sequences stay short
+  if ((_entries + 1) * 2 > table->_size) {
+    table = grow(table);
+  }
+  id = ++_next_id;
+  insert(table, new JfrStackTrace(id, stacktrace));
   ++_entries;
   return id;
 }
 
 // invariant is that the entry to be resolved actually exists in the table
 const JfrStackTrace* JfrStackTraceRepository::lookup_for_leak_profiler(traceid hash, traceid id) {
-  const size_t index = (hash % TABLE_SIZE);
-  const JfrStackTrace* trace = leak_profiler_instance()._table[index];
-  while (trace != nullptr && trace->id() != id) {
-    trace = trace->next();
+  const Table* const table = Atomic::load_acquire(&leak_profiler_instance()._table);
+  const u4 mask = table->_size - 1;
+  const JfrStackTrace* trace = nullptr;
+  for (u4 index = hash & mask; ; index = (index + 1) & mask) {
+    trace = Atomic::load_acquire(&table->_buckets[index]);
+    if (trace == nullptr || trace->id() == id) {
+      break;
+    }
   }
   assert(trace != nullptr, "invariant");
   assert(trace->hash() == hash, "invariant");
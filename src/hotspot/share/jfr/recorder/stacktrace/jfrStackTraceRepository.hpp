@@ -45,12 +45,30 @@ class JfrStackTraceRepository : public JfrCHeapObj {
   friend class StackTraceRepository;
 
  private:
-  static const u4 TABLE_SIZE = 2053;
-  JfrStackTrace* _table[TABLE_SIZE];
+  // Open-addressed table with linear probing. Lookups are lock-free and
+  // run in a GlobalCounter critical section; insertions, growing and
+  // clearing are serialized by JfrStacktrace_lock. Replaced tables and
+  // cleared entries are reclaimed after a GlobalCounter::write_synchronize.
+  class Table : public JfrCHeapObj {
+   public:
+    const u4 _size; // power of two
+    JfrStackTrace* volatile* const _buckets;
+    explicit Table(u4 size);
+    ~Table();
+  };
+
+  static const u4 INITIAL_TABLE_SIZE = 2048;
+  Table* volatile _table;
   u4 _last_entries;
   u4 _entries;
 
+  // Statistics, reported when the repository is written
+  volatile size_t _lookups;
+  volatile size_t _hits;
+  volatile size_t _collisions;
+
   JfrStackTraceRepository();
+  ~JfrStackTraceRepository();
   static JfrStackTraceRepository& instance();
   static JfrStackTraceRepository* create();
   static void destroy();
@@ -67,6 +85,13 @@ class JfrStackTraceRepository : public JfrCHeapObj {
 
   static traceid next_id();
 
+  static traceid lookup(const Table* table, const JfrStackTrace& stacktrace, size_t* probes);
+  static void insert(Table* table, JfrStackTrace* stacktrace);
+  static void delete_entries(Table* table);
+  Table* grow(Table* table);
+  Table* reset();
+  void log_statistics() const;
+
   traceid add_trace(const JfrStackTrace& stacktrace);
   static traceid add(JfrStackTraceRepository& repo, const JfrStackTrace& stacktrace);
   static traceid add(const JfrStackTrace& stacktrace);
@@ -287,18 +287,22 @@ void JfrStorage::register_full(BufferPtr buffer, Thread* thread) {
   assert(buffer != nullptr, "invariant");
   assert(buffer->retired(), "invariant");
   if (_full_list->add(buffer)) {
-    if (thread->is_Java_thread()) {
-      JavaThread* jt = JavaThread::cast(thread);
-      if (jt->thread_state() == _thread_in_native) {
-        // Transition java thread to vm so it can issue a notify.
-        MACOS_AARCH64_ONLY(ThreadWXEnable __wx(WXWrite, jt));
-        ThreadInVMfromNative transition(jt);
-        _post_box.post(MSG_FULLBUFFER);
-        return;
-      }
+    notify_full(thread);
+  }
+}
+
+void JfrStorage::notify_full(Thread* thread) {
+  if (thread->is_Java_thread()) {
+    JavaThread* jt = JavaThread::cast(thread);
+    if (jt->thread_state() == _thread_in_native) {
+      // Transition java thread to vm so it can issue a notify.
+      MACOS_AARCH64_ONLY(ThreadWXEnable __wx(WXWrite, jt));
+      ThreadInVMfromNative transition(jt);
+      _post_box.post(MSG_FULLBUFFER);
+      return;
     }
-    _post_box.post(MSG_FULLBUFFER);
   }
+  _post_box.post(MSG_FULLBUFFER);
 }
 
 // don't use buffer on return, it is gone
@@ -409,6 +413,12 @@ BufferPtr JfrStorage::flush(BufferPtr cur, size_t used, size_t req, bool native,
 
 BufferPtr JfrStorage::flush_regular(BufferPtr cur, const u1* const cur_pos, size_t used, size_t req, bool native, Thread* t) {
   debug_only(assert_flush_regular_precondition(cur, cur_pos, used, req, t);)
+  if (JfrHandOffThreadLocalBuffers) {
+    BufferPtr const buffer = hand_off(cur, cur_pos, used, req, native, t);
+    if (buffer != nullptr) {
+      return buffer;
+    }
+  }
   // A flush is needed before memmove since a non-large buffer is thread stable
   // (thread local). The flush will not modify memory in addresses above pos()
   // which is where the "used / uncommitted" data resides. It is therefore both
@@ -441,6 +451,30 @@ static BufferPtr store_buffer_to_thread_local(BufferPtr buffer, JfrThreadLocal*
   return buffer;
 }
 
+// Instead of copying the flushed data of a thread local buffer into a global buffer,
+// the thread local buffer is retired as is and the thread continues with a new one.
+// The recorder thread writes the retired buffer directly to the chunk and then
+// releases it back to the thread local mspace.
+BufferPtr JfrStorage::hand_off(BufferPtr cur, const u1* const cur_pos, size_t used, size_t req, bool native, Thread* t) {
+  assert(!cur->lease(), "invariant");
+  if (cur->unflushed_size() == 0 || req > _thread_local_mspace->min_element_size() || !control().is_hand_off_allowed()) {
+    return nullptr;
+  }
+  BufferPtr const buffer = acquire_thread_local(t, req);
+  if (buffer == nullptr) {
+    return nullptr;
+  }
+  assert(buffer->free_size() >= req, "invariant");
+  if (used > 0) {
+    memcpy(buffer->pos(), (void*)cur_pos, used);
+  }
+  control().increment_handed_off();
+  cur->set_retired();
+  store_buffer_to_thread_local(buffer, t->jfr_thread_local(), native);
+  notify_full(t);
+  return buffer;
+}
+
 static BufferPtr restore_shelved_buffer(bool native, Thread* t) {
   JfrThreadLocal* const tl = t->jfr_thread_local();
   BufferPtr shelved = tl->shelved_buffer();
@@ -504,16 +538,39 @@ typedef UnBufferedWriteToChunk<JfrBuffer> WriteOperation;
 typedef MutexedWriteOp<WriteOperation> MutexedWriteOperation;
 typedef ConcurrentWriteOp<WriteOperation> ConcurrentWriteOperation;
 
-typedef ScavengingReleaseOp<JfrThreadLocalMspace, JfrThreadLocalMspace::LiveList> ReleaseThreadLocalOperation;
-typedef CompositeOperation<ConcurrentWriteOperation, ReleaseThreadLocalOperation> ConcurrentWriteReleaseThreadLocalOperation;
+// Thread local buffers handed off by their owners are retired but still hold data.
+// Counts the handed off buffers processed and, if handed_off_only, skips all others.
+template <typename Operation>
+class HandedOffOp : public StackObj {
+ private:
+  Operation& _operation;
+  const bool _handed_off_only;
+  size_t _count;
+ public:
+  typedef typename Operation::Type Type;
+  HandedOffOp(Operation& operation, bool handed_off_only) :
+    _operation(operation), _handed_off_only(handed_off_only), _count(0) {}
+  bool process(Type* t) {
+    if (t->retired() && !t->empty()) {
+      ++_count;
+      return _operation.process(t);
+    }
+    return _handed_off_only || _operation.process(t);
+  }
+  size_t count() const { return _count; }
+};
+
+typedef HandedOffOp<ConcurrentWriteOperation> ThreadLocalWriteOperation;
+typedef ReleaseRetiredOp<ThreadLocalWriteOperation, JfrThreadLocalMspace, JfrThreadLocalMspace::LiveList> ConcurrentWriteReleaseThreadLocalOperation;
 
 size_t JfrStorage::write() {
   const size_t full_elements = write_full();
   WriteOperation wo(_chunkwriter);
   ConcurrentWriteOperation cwo(wo);
-  ReleaseThreadLocalOperation rtlo(_thread_local_mspace, _thread_local_mspace->live_list());
-  ConcurrentWriteReleaseThreadLocalOperation tlop(&cwo, &rtlo);
+  ThreadLocalWriteOperation tlwo(cwo, false);
+  ConcurrentWriteReleaseThreadLocalOperation tlop(tlwo, _thread_local_mspace, _thread_local_mspace->live_list());
   process_live_list(tlop, _thread_local_mspace);
+  control().decrement_handed_off(tlwo.count());
   assert(_global_mspace->free_list_is_empty(), "invariant");
   assert(_global_mspace->live_list_is_nonempty(), "invariant");
   process_live_list(cwo, _global_mspace);
@@ -533,14 +590,16 @@ size_t JfrStorage::write_at_safepoint() {
 }
 
 typedef DiscardOp<DefaultDiscarder<JfrStorage::Buffer> > DiscardOperation;
-typedef CompositeOperation<DiscardOperation, ReleaseThreadLocalOperation> DiscardReleaseThreadLocalOperation;
+typedef HandedOffOp<DiscardOperation> ThreadLocalDiscardOperation;
+typedef ReleaseRetiredOp<ThreadLocalDiscardOperation, JfrThreadLocalMspace, JfrThreadLocalMspace::LiveList> DiscardReleaseThreadLocalOperation;
 
 size_t JfrStorage::clear() {
   const size_t full_elements = clear_full();
   DiscardOperation discarder(concurrent); // concurrent discard mode
-  ReleaseThreadLocalOperation rtlo(_thread_local_mspace, _thread_local_mspace->live_list());
-  DiscardReleaseThreadLocalOperation tldo(&discarder, &rtlo);
-  process_live_list(tldo, _thread_local_mspace);
+  ThreadLocalDiscardOperation tldo(discarder, false);
+  DiscardReleaseThreadLocalOperation tlop(tldo, _thread_local_mspace, _thread_local_mspace->live_list());
+  process_live_list(tlop, _thread_local_mspace);
+  control().decrement_handed_off(tldo.count());
   assert(_global_mspace->free_list_is_empty(), "invariant");
   assert(_global_mspace->live_list_is_nonempty(), "invariant");
   process_live_list(discarder, _global_mspace);
@@ -581,8 +640,9 @@ typedef CompositeOperation<MutexedWriteOperation, ReleaseFullOperation> WriteFul
 //
 size_t JfrStorage::write_full() {
   assert(_chunkwriter.is_valid(), "invariant");
+  const size_t handed_off = write_handed_off();
   if (_full_list->is_empty()) {
-    return 0;
+    return handed_off;
   }
   WriteOperation wo(_chunkwriter);
   MutexedWriteOperation writer(wo); // a retired buffer implies mutexed access
@@ -592,6 +652,24 @@ size_t JfrStorage::write_full() {
   if (count != 0) {
     log(count, writer.size());
   }
+  return handed_off + count;
+}
+
+// Writes and releases the thread local buffers handed off by their owners.
+size_t JfrStorage::write_handed_off() {
+  if (control().handed_off_count() == 0) {
+    return 0;
+  }
+  WriteOperation wo(_chunkwriter);
+  ConcurrentWriteOperation cwo(wo);
+  ThreadLocalWriteOperation tlwo(cwo, true);
+  ConcurrentWriteReleaseThreadLocalOperation tlop(tlwo, _thread_local_mspace, _thread_local_mspace->live_list());
+  process_live_list(tlop, _thread_local_mspace);
+  const size_t count = tlwo.count();
+  control().decrement_handed_off(count);
+  if (count != 0) {
+    log_debug(jfr, system)("Wrote " SIZE_FORMAT " handed off thread local buffer(s) of " SIZE_FORMAT " B of data to chunk.", count, wo.size());
+  }
   return count;
 }
 
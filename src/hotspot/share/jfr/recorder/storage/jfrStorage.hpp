@@ -62,6 +62,7 @@ class JfrStorage : public JfrCHeapObj {
   BufferPtr acquire_transient(size_t size, Thread* thread);
   bool flush_regular_buffer(BufferPtr buffer, Thread* thread);
   BufferPtr flush_regular(BufferPtr cur, const u1* cur_pos, size_t used, size_t req, bool native, Thread* thread);
+  BufferPtr hand_off(BufferPtr cur, const u1* cur_pos, size_t used, size_t req, bool native, Thread* thread);
   BufferPtr flush_large(BufferPtr cur, const u1* cur_pos, size_t used, size_t req, bool native, Thread* thread);
   BufferPtr provision_large(BufferPtr cur, const u1* cur_pos, size_t used, size_t req, bool native, Thread* thread);
   BufferPtr acquire_promotion_buffer(size_t size, JfrStorageMspace* mspace, JfrStorage& storage_instance, size_t retry_count, Thread* thread);
@@ -70,6 +71,7 @@ class JfrStorage : public JfrCHeapObj {
   size_t clear();
   size_t clear_full();
   size_t write_full();
+  size_t write_handed_off();
   size_t write_at_safepoint();
 
   JfrStorage(JfrChunkWriter& cw, JfrPostBox& post_box);
@@ -82,6 +84,7 @@ class JfrStorage : public JfrCHeapObj {
 
   // mspace callback
   void register_full(BufferPtr buffer, Thread* thread);
+  void notify_full(Thread* thread);
 
  public:
   static BufferPtr acquire_thread_local(Thread* thread, size_t size = 0);
@@ -31,6 +31,7 @@ JfrStorageControl::JfrStorageControl(size_t global_count_total, size_t in_memory
   _global_count_total(global_count_total),
   _full_count(0),
   _global_lease_count(0),
+  _handed_off_count(0),
   _to_disk_threshold(0),
   _in_memory_discard_threshold(in_memory_discard_threshold),
   _global_lease_threshold(global_count_total / max_lease_factor),
@@ -97,3 +98,22 @@ size_t JfrStorageControl::decrement_leased() {
 bool JfrStorageControl::is_global_lease_allowed() const {
   return global_lease_count() <= _global_lease_threshold;
 }
+
+size_t JfrStorageControl::handed_off_count() const {
+  return Atomic::load(&_handed_off_count);
+}
+
+void JfrStorageControl::increment_handed_off() {
+  Atomic::inc(&_handed_off_count);
+}
+
+void JfrStorageControl::decrement_handed_off(size_t count) {
+  assert(handed_off_count() >= count, "invariant");
+  Atomic::sub(&_handed_off_count, count);
+}
+
+// Handed off thread local buffers are not bounded by the global memory size,
+// so only let as many be outstanding as there are global buffers.
+bool JfrStorageControl::is_hand_off_allowed() const {
+  return to_disk() && handed_off_count() < _global_count_total;
+}
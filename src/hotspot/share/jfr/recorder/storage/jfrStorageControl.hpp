@@ -32,6 +32,7 @@ class JfrStorageControl : public JfrCHeapObj {
   size_t _global_count_total;
   size_t _full_count;
   volatile size_t _global_lease_count;
+  volatile size_t _handed_off_count;
   size_t _to_disk_threshold;
   size_t _in_memory_discard_threshold;
   size_t _global_lease_threshold;
@@ -54,6 +55,11 @@ class JfrStorageControl : public JfrCHeapObj {
   size_t increment_leased();
   size_t decrement_leased();
   bool is_global_lease_allowed() const;
+
+  size_t handed_off_count() const;
+  void increment_handed_off();
+  void decrement_handed_off(size_t count);
+  bool is_hand_off_allowed() const;
 };
 
 #endif // SHARE_JFR_RECORDER_STORAGE_JFRSTORAGECONTROL_HPP
@@ -76,6 +76,8 @@ JfrSymbolTable::JfrSymbolTable() :
   _strings(new Strings(this)),
   _symbol_list(nullptr),
   _string_list(nullptr),
+  _serialized_symbol_list(nullptr),
+  _serialized_string_list(nullptr),
   _symbol_query(nullptr),
   _string_query(nullptr),
   _id_counter(1),
@@ -109,6 +111,8 @@ void JfrSymbolTable::clear() {
   assert(!_strings->has_entries(), "invariant");
 
   _symbol_list = nullptr;
+  _serialized_symbol_list = nullptr;
+  _serialized_string_list = nullptr;
   _id_counter = 1;
 
   _symbol_query = nullptr;
@@ -119,6 +123,12 @@ void JfrSymbolTable::clear() {
   _string_list = bootstrap;
 }
 
+void JfrSymbolTable::set_all_serialized() {
+  assert_locked_or_safepoint(ClassLoaderDataGraph_lock);
+  _serialized_symbol_list = _symbol_list;
+  _serialized_string_list = _string_list;
+}
+
 void JfrSymbolTable::set_class_unload(bool class_unload) {
   _class_unload = class_unload;
 }
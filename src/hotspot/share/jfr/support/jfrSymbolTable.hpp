@@ -81,6 +81,9 @@ class JfrSymbolTable : public JfrCHeapObj {
   Strings* _strings;
   const SymbolEntry* _symbol_list;
   const StringEntry* _string_list;
+  // List heads as of the last time all entries were serialized.
+  const SymbolEntry* _serialized_symbol_list;
+  const StringEntry* _serialized_string_list;
   const Symbol* _symbol_query;
   const char* _string_query;
   traceid _id_counter;
@@ -93,6 +96,7 @@ class JfrSymbolTable : public JfrCHeapObj {
 
   void clear();
   void increment_checkpoint_id();
+  void set_all_serialized();
   void set_class_unload(bool class_unload);
 
   traceid mark(uintptr_t hash, const Symbol* sym, bool leakp);
@@ -134,10 +138,22 @@ class JfrSymbolTable : public JfrCHeapObj {
     iterate(functor, _string_list);
   }
 
+  // Entries are linked in at the head of the lists, so the entries added
+  // since all entries were last serialized precede the serialized heads.
+  template <typename Functor>
+  void iterate_new_symbols(Functor& functor) {
+    iterate(functor, _symbol_list, _serialized_symbol_list);
+  }
+
+  template <typename Functor>
+  void iterate_new_strings(Functor& functor) {
+    iterate(functor, _string_list, _serialized_string_list);
+  }
+
   template <typename Functor, typename T>
-  void iterate(Functor& functor, const T* list) {
+  void iterate(Functor& functor, const T* list, const T* end = nullptr) {
     const T* symbol = list;
-    while (symbol != nullptr) {
+    while (symbol != end) {
       const T* next = symbol->list_next();
       functor(symbol);
       symbol = next;
@@ -31,6 +31,7 @@
 #include "jfr/recorder/checkpoint/types/traceid/jfrOopTraceId.inline.hpp"
 #include "jfr/recorder/jfrRecorder.hpp"
 #include "jfr/recorder/service/jfrOptionSet.hpp"
+#include "jfr/recorder/stacktrace/jfrStackTrace.hpp"
 #include "jfr/recorder/stacktrace/jfrStackTraceRepository.hpp"
 #include "jfr/recorder/storage/jfrStorage.hpp"
 #include "jfr/support/jfrThreadId.inline.hpp"
@@ -56,6 +57,7 @@ JfrThreadLocal::JfrThreadLocal() :
   _checkpoint_buffer_epoch_0(nullptr),
   _checkpoint_buffer_epoch_1(nullptr),
   _stackframes(nullptr),
+  _stack_trace_prefix_cache(nullptr),
   _dcmd_arena(nullptr),
   _thread(),
   _vthread_id(0),
@@ -68,6 +70,7 @@ JfrThreadLocal::JfrThreadLocal() :
   _last_allocated_bytes(0),
   _user_time(0),
   _cpu_time(0),
+  _sampled_cpu_time(0),
   _wallclock_time(os::javaTimeNanos()),
   _stackdepth(0),
   _entering_suspend_flag(0),
@@ -162,6 +165,10 @@ void JfrThreadLocal::release(Thread* t) {
     FREE_C_HEAP_ARRAY(JfrStackFrame, _stackframes);
     _stackframes = nullptr;
   }
+  if (_stack_trace_prefix_cache != nullptr) {
+    delete _stack_trace_prefix_cache;
+    _stack_trace_prefix_cache = nullptr;
+  }
   if (_load_barrier_buffer_epoch_0 != nullptr) {
     _load_barrier_buffer_epoch_0->set_retired();
     _load_barrier_buffer_epoch_0 = nullptr;
@@ -244,6 +251,12 @@ JfrStackFrame* JfrThreadLocal::install_stackframes() const {
   return _stackframes;
 }
 
+JfrStackTracePrefixCache* JfrThreadLocal::install_stack_trace_prefix_cache() const {
+  assert(_stack_trace_prefix_cache == nullptr, "invariant");
+  _stack_trace_prefix_cache = new JfrStackTracePrefixCache(stackdepth());
+  return _stack_trace_prefix_cache;
+}
+
 ByteSize JfrThreadLocal::java_event_writer_offset() {
   return byte_offset_of(JfrThreadLocal, _java_event_writer);
 }
@@ -32,6 +32,7 @@ class Arena;
 class JavaThread;
 class JfrBuffer;
 class JfrStackFrame;
+class JfrStackTracePrefixCache;
 class Thread;
 
 class JfrThreadLocal {
@@ -50,6 +51,7 @@ class JfrThreadLocal {
   JfrBuffer* _checkpoint_buffer_epoch_0;
   JfrBuffer* _checkpoint_buffer_epoch_1;
   mutable JfrStackFrame* _stackframes;
+  mutable JfrStackTracePrefixCache* _stack_trace_prefix_cache;
   Arena* _dcmd_arena;
   JfrBlobHandle _thread;
   mutable traceid _vthread_id;
@@ -62,6 +64,7 @@ class JfrThreadLocal {
   int64_t _last_allocated_bytes;
   jlong _user_time;
   jlong _cpu_time;
+  jlong _sampled_cpu_time;
   jlong _wallclock_time;
   mutable u4 _stackdepth;
   volatile jint _entering_suspend_flag;
@@ -76,6 +79,7 @@ class JfrThreadLocal {
   JfrBuffer* install_native_buffer() const;
   JfrBuffer* install_java_buffer() const;
   JfrStackFrame* install_stackframes() const;
+  JfrStackTracePrefixCache* install_stack_trace_prefix_cache() const;
   void release(Thread* t);
   static void release(JfrThreadLocal* tl, Thread* t);
 
@@ -145,6 +149,10 @@ class JfrThreadLocal {
     _stackframes = frames;
   }
 
+  JfrStackTracePrefixCache* stack_trace_prefix_cache() const {
+    return _stack_trace_prefix_cache != nullptr ? _stack_trace_prefix_cache : install_stack_trace_prefix_cache();
+  }
+
   u4 stackdepth() const;
 
   void set_stackdepth(u4 depth) {
@@ -243,6 +251,15 @@ class JfrThreadLocal {
     _cpu_time = cpu_time;
   }
 
+  // The thread cpu time when the thread sampler last took an execution sample.
+  jlong get_sampled_cpu_time() const {
+    return _sampled_cpu_time;
+  }
+
+  void set_sampled_cpu_time(jlong cpu_time) {
+    _sampled_cpu_time = cpu_time;
+  }
+
   jlong get_wallclock_time() const {
     return _wallclock_time;
   }
@@ -2115,6 +2115,11 @@ JVMCI::CodeInstallResult JVMCIRuntime::register_method(JVMCIEnv* JVMCIENV,
     // Check if memory should be freed before allocation
     CodeCache::gc_on_allocation();
 
+    // Encode the dependencies now, so we can check them right away. The
+    // encoding only depends on this compilation, so it is done before
+    // taking the locks that other compiler threads wait on.
+    dependencies->encode_content_bytes();
+
     // To prevent compile queue updates.
     MutexLocker locker(THREAD, MethodCompileQueue_lock);
 
@@ -2122,9 +2127,6 @@ JVMCI::CodeInstallResult JVMCIRuntime::register_method(JVMCIEnv* JVMCIENV,
     // and invalidating our dependencies until we install this method.
     MutexLocker ml(Compile_lock);
 
-    // Encode the dependencies now, so we can check them right away.
-    dependencies->encode_content_bytes();
-
     // Record the dependencies for the current compile in the log
     if (LogCompilation) {
       for (Dependencies::DepStream deps(dependencies); deps.next(); ) {
@@ -2183,6 +2185,9 @@ JVMCI::CodeInstallResult JVMCIRuntime::register_method(JVMCIEnv* JVMCIENV,
         nm->set_has_unsafe_access(has_unsafe_access);
         nm->set_has_wide_vectors(has_wide_vector);
         nm->set_has_monitors(has_monitors);
+        // JVMCI does not report which methods were inlined as scoped
+        // accesses, so assume the worst.
+        nm->set_has_scoped_access(true);
 
         JVMCINMethodData* data = nm->jvmci_nmethod_data();
         assert(data != nullptr, "must be");
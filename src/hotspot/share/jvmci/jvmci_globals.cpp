@@ -94,6 +94,12 @@ bool JVMCIGlobals::check_jvmci_flags_are_consistent() {
       return false;
     }
     FLAG_SET_DEFAULT(EnableJVMCI, true);
+    if (UseObjectMonitorTable) {
+      // JVMCI compilers emit inflated locking fast paths that expect the
+      // ObjectMonitor* in the mark word.
+      FLAG_SET_ERGO(UseObjectMonitorTable, false);
+      warning("UseObjectMonitorTable is not supported with UseJVMCICompiler");
+    }
     if (BootstrapJVMCI && UseJVMCINativeLibrary) {
       jio_fprintf(defaultStream::error_stream(), "-XX:+BootstrapJVMCI is not compatible with -XX:+UseJVMCINativeLibrary\n");
       return false;
@@ -33,14 +33,15 @@
 #include "runtime/os.inline.hpp"
 
 class AsyncLogWriter::AsyncLogLocker : public StackObj {
+  Shard* const _shard;
  public:
-  AsyncLogLocker() {
-    assert(_instance != nullptr, "AsyncLogWriter::_lock is unavailable");
-    _instance->_lock.lock();
+  AsyncLogLocker(Shard* shard) : _shard(shard) {
+    assert(_shard != nullptr, "AsyncLogWriter::Shard::_lock is unavailable");
+    _shard->_lock.lock();
   }
 
   ~AsyncLogLocker() {
-    _instance->_lock.unlock();
+    _shard->_lock.unlock();
   }
 };
 
@@ -69,46 +70,92 @@ void AsyncLogWriter::Buffer::push_flush_token() {
   assert(result, "fail to enqueue the flush token.");
 }
 
-void AsyncLogWriter::enqueue_locked(LogFileStreamOutput* output, const LogDecorations& decorations, const char* msg) {
+// Threads are mapped to shards by their address. A logsite without
+// a current thread uses the first shard.
+AsyncLogWriter::Shard* AsyncLogWriter::current_shard() const {
+  if (_num_shards == 1) {
+    return _shards[0];
+  }
+  Thread* thread = Thread::current_or_null();
+  if (thread == nullptr) {
+    return _shards[0];
+  }
+  uintptr_t hash = p2i(thread) >> LogBytesPerWord;
+  hash ^= hash >> 16;
+  return _shards[(hash * 0x9E3779B1u) >> 16 & (_num_shards - 1)];
+}
+
+bool AsyncLogWriter::enqueue_locked(Shard* shard, LogFileStreamOutput* output, const LogDecorations& decorations, const char* msg) {
   // To save space and streamline execution, we just ignore null message.
   // client should use "" instead.
   assert(msg != nullptr, "enqueuing a null message!");
 
-  if (!_buffer->push_back(output, decorations, msg)) {
+  if (!shard->_buffer->push_back(output, decorations, msg)) {
     bool p_created;
-    uint32_t* counter = _stats.put_if_absent(output, 0, &p_created);
+    uint32_t* counter = shard->_stats.put_if_absent(output, 0, &p_created);
     *counter = *counter + 1;
-    return;
+    return false;
   }
 
-  _data_available = true;
-  _lock.notify();
+  return true;
+}
+
+// Wakes up the AsyncLog Thread. Only the logsite that sets _data_available
+// signals, so that the common case is a load of the flag.
+void AsyncLogWriter::signal_data_available() {
+  if (!Atomic::load(&_data_available) &&
+      !Atomic::cmpxchg(&_data_available, false, true)) {
+    _data_sem.signal();
+  }
 }
 
 void AsyncLogWriter::enqueue(LogFileStreamOutput& output, const LogDecorations& decorations, const char* msg) {
-  AsyncLogLocker locker;
-  enqueue_locked(&output, decorations, msg);
+  Shard* shard = current_shard();
+  bool enqueued;
+  {
+    AsyncLogLocker locker(shard);
+    enqueued = enqueue_locked(shard, &output, decorations, msg);
+  }
+  if (enqueued) {
+    signal_data_available();
+  }
 }
 
 // LogMessageBuffer consists of a multiple-part/multiple-line message.
 // The lock here guarantees its integrity.
 void AsyncLogWriter::enqueue(LogFileStreamOutput& output, LogMessageBuffer::Iterator msg_iterator) {
-  AsyncLogLocker locker;
+  Shard* shard = current_shard();
+  bool enqueued = false;
+  {
+    AsyncLogLocker locker(shard);
 
-  for (; !msg_iterator.is_at_end(); msg_iterator++) {
-    enqueue_locked(&output, msg_iterator.decorations(), msg_iterator.message());
+    for (; !msg_iterator.is_at_end(); msg_iterator++) {
+      enqueued |= enqueue_locked(shard, &output, msg_iterator.decorations(), msg_iterator.message());
+    }
+  }
+  if (enqueued) {
+    signal_data_available();
   }
 }
 
 AsyncLogWriter::AsyncLogWriter()
-  : _flush_sem(0), _lock(), _data_available(false),
+  : _flush_sem(0), _data_sem(0), _data_available(false),
     _initialized(false),
-    _stats() {
+    _num_shards(1) {
+
+  // Use more shards on larger machines, as long as every buffer stays reasonably large.
+  uint shards = round_down_power_of_2(clamp(os::initial_active_processor_count() / 8, 1, (int)MaxShards));
+  while (shards > 1 && AsyncLogBufferSize / (2 * shards) < MinShardBufferSize) {
+    shards /= 2;
+  }
+  _num_shards = shards;
 
-  size_t size = AsyncLogBufferSize / 2;
-  _buffer = new Buffer(size);
-  _buffer_staging = new Buffer(size);
-  log_info(logging)("AsyncLogBuffer estimates memory use: " SIZE_FORMAT " bytes", size * 2);
+  size_t size = AsyncLogBufferSize / (2 * _num_shards);
+  for (uint i = 0; i < _num_shards; i++) {
+    _shards[i] = new Shard(size);
+  }
+  log_info(logging)("AsyncLogBuffer estimates memory use: " SIZE_FORMAT " bytes in %u shards",
+                    size * 2 * _num_shards, _num_shards);
   if (os::create_thread(this, os::asynclog_thread)) {
     _initialized = true;
   } else {
@@ -116,12 +163,39 @@ AsyncLogWriter::AsyncLogWriter()
   }
 }
 
+// Writes the staging buffers of all shards, merging the messages by the time
+// they were enqueued. The messages of a shard keep their order, so multi-part
+// messages and the messages of one thread are never reordered.
 void AsyncLogWriter::write(AsyncLogMap<AnyObj::RESOURCE_AREA>& snapshot) {
   int req = 0;
-  auto it = _buffer_staging->iterator();
-  while (it.hasNext()) {
-    const Message* e = it.next();
+  Buffer::Iterator* its = NEW_RESOURCE_ARRAY(Buffer::Iterator, _num_shards);
+  for (uint i = 0; i < _num_shards; i++) {
+    ::new (&its[i]) Buffer::Iterator(*_shards[i]->_buffer_staging);
+  }
+
+  uint current = 0;
+  while (true) {
+    // Stay on the current shard as long as it has the oldest message, so that
+    // messages enqueued at the same time by one logsite are written consecutively.
+    uint next = _num_shards;
+    jlong oldest = 0;
+    if (its[current].hasNext()) {
+      next = current;
+      oldest = its[current].peek()->enqueued();
+    }
+    for (uint i = 0; i < _num_shards; i++) {
+      if (i != current && its[i].hasNext() &&
+          (next == _num_shards || its[i].peek()->enqueued() < oldest)) {
+        next = i;
+        oldest = its[i].peek()->enqueued();
+      }
+    }
+    if (next == _num_shards) {
+      break;
+    }
+    current = next;
 
+    const Message* e = its[current].next();
     if (!e->is_token()){
       e->output()->write_blocking(e->decorations(), e->message());
     } else {
@@ -152,27 +226,34 @@ void AsyncLogWriter::run() {
   while (true) {
     ResourceMark rm;
     AsyncLogMap<AnyObj::RESOURCE_AREA> snapshot;
-    {
-      AsyncLogLocker locker;
 
-      while (!_data_available) {
-        _lock.wait(0/* no timeout */);
-      }
+    _data_sem.wait();
+    // Clear the flag before the shards are swapped, so that a message enqueued
+    // into an already swapped shard signals again and is written in the next round.
+    Atomic::release_store_fence(&_data_available, false);
+
+    // The shards are swapped in order. flush() puts its token into the first
+    // shard, thus all messages enqueued before the token are written in this
+    // round or an earlier one.
+    for (uint i = 0; i < _num_shards; i++) {
+      Shard* shard = _shards[i];
+      AsyncLogLocker locker(shard);
+
       // Only doing a swap and statistics under the lock to
       // guarantee that I/O jobs don't block logsites.
-      _buffer_staging->reset();
-      swap(_buffer, _buffer_staging);
+      shard->_buffer_staging->reset();
+      swap(shard->_buffer, shard->_buffer_staging);
 
       // move counters to snapshot and reset them.
-      _stats.iterate([&] (LogFileStreamOutput* output, uint32_t& counter) {
+      shard->_stats.iterate([&] (LogFileStreamOutput* output, uint32_t& counter) {
         if (counter > 0) {
-          bool created = snapshot.put(output, counter);
-          assert(created == true, "sanity check");
+          bool created;
+          uint32_t* total = snapshot.put_if_absent(output, 0, &created);
+          *total += counter;
           counter = 0;
         }
         return true;
       });
-      _data_available = false;
     }
     write(snapshot);
   }
@@ -212,37 +293,41 @@ AsyncLogWriter* AsyncLogWriter::instance() {
 void AsyncLogWriter::flush() {
   if (_instance != nullptr) {
     {
-      AsyncLogLocker locker;
+      AsyncLogLocker locker(_instance->_shards[0]);
       // Push directly in-case we are at logical max capacity, as this must not get dropped.
-      _instance->_buffer->push_flush_token();
-      _instance->_data_available = true;
-      _instance->_lock.notify();
+      _instance->_shards[0]->_buffer->push_flush_token();
     }
+    _instance->signal_data_available();
 
     _instance->_flush_sem.wait();
   }
 }
 
 AsyncLogWriter::BufferUpdater::BufferUpdater(size_t newsize) {
-  AsyncLogLocker locker;
   auto p = AsyncLogWriter::_instance;
 
-  _buf1 = p->_buffer;
-  _buf2 = p->_buffer_staging;
-  p->_buffer = new Buffer(newsize);
-  p->_buffer_staging = new Buffer(newsize);
+  for (uint i = 0; i < p->_num_shards; i++) {
+    Shard* shard = p->_shards[i];
+    AsyncLogLocker locker(shard);
+
+    _buf1[i] = shard->_buffer;
+    _buf2[i] = shard->_buffer_staging;
+    shard->_buffer = new Buffer(newsize);
+    shard->_buffer_staging = new Buffer(newsize);
+  }
 }
 
 AsyncLogWriter::BufferUpdater::~BufferUpdater() {
   AsyncLogWriter::flush();
   auto p = AsyncLogWriter::_instance;
 
-  {
-    AsyncLogLocker locker;
+  for (uint i = 0; i < p->_num_shards; i++) {
+    Shard* shard = p->_shards[i];
+    AsyncLogLocker locker(shard);
 
-    delete p->_buffer;
-    delete p->_buffer_staging;
-    p->_buffer = _buf1;
-    p->_buffer_staging = _buf2;
+    delete shard->_buffer;
+    delete shard->_buffer_staging;
+    shard->_buffer = _buf1[i];
+    shard->_buffer_staging = _buf2[i];
   }
 }
@@ -30,6 +30,7 @@
 #include "memory/allocation.hpp"
 #include "runtime/mutex.hpp"
 #include "runtime/nonJavaThread.hpp"
+#include "runtime/os.hpp"
 #include "runtime/semaphore.hpp"
 #include "utilities/resourceHash.hpp"
 
@@ -40,6 +41,9 @@ class LogFileStreamOutput;
 //
 // Summary:
 // Async Logging is working on the basis of singleton AsyncLogWriter, which manages an intermediate buffer and a flushing thread.
+// The intermediate buffer is split into shards. Logsites are mapped to a shard by their thread, so that logsites running
+// concurrently mostly contend on different locks. The flushing thread drains all shards and merges their messages by the
+// time they were enqueued.
 //
 // Interface:
 //
@@ -50,7 +54,7 @@ class LogFileStreamOutput;
 // successfully initialized. Clients can use its return value to determine async logging is established or not.
 //
 // enqueue() is the basic operation of AsyncLogWriter. Two overloading versions of it are provided to match LogOutput::write().
-// They are both MT-safe and non-blocking. Derived classes of LogOutput can invoke the corresponding enqueue() in write() and
+// They are both MT-safe and non-blocking. Messages enqueued by one thread are written in the order they were enqueued. Derived classes of LogOutput can invoke the corresponding enqueue() in write() and
 // return 0. AsyncLogWriter is responsible of copying necessary data.
 //
 // flush() ensures that all pending messages have been written out before it returns. It is not MT-safe in itself. When users
@@ -60,6 +64,7 @@ class AsyncLogWriter : public NonJavaThread {
   friend class AsyncLogTest;
   friend class AsyncLogTest_logBuffer_vm_Test;
   class AsyncLogLocker;
+  class Shard;
 
   // account for dropped messages
   template <AnyObj::allocation_type ALLOC_TYPE>
@@ -84,10 +89,11 @@ class AsyncLogWriter : public NonJavaThread {
     ~Message() = delete;
     LogFileStreamOutput* const _output;
     const LogDecorations _decorations;
+    const jlong _enqueued; // used to merge the messages of different shards
    public:
     // msglen excludes NUL-byte
     Message(LogFileStreamOutput* output, const LogDecorations& decorations, const char* msg, const size_t msglen)
-      : _output(output), _decorations(decorations) {
+      : _output(output), _decorations(decorations), _enqueued(os::javaTimeNanos()) {
       assert(msg != nullptr, "c-str message can not be null!");
       memcpy(reinterpret_cast<char* >(this+1), msg, msglen + 1);
     }
@@ -104,6 +110,7 @@ class AsyncLogWriter : public NonJavaThread {
     inline bool is_token() const { return _output == nullptr; }
     LogFileStreamOutput* output() const { return _output; }
     const LogDecorations& decorations() const { return _decorations; }
+    jlong enqueued() const { return _enqueued; }
     const char* message() const { return reinterpret_cast<const char *>(this+1); }
   };
 
@@ -133,20 +140,25 @@ class AsyncLogWriter : public NonJavaThread {
     }
 
     class Iterator {
-      const Buffer& _buf;
+      const Buffer* _buf;
       size_t _curr;
 
     public:
-      Iterator(const Buffer& buffer): _buf(buffer), _curr(0) {}
+      Iterator(const Buffer& buffer): _buf(&buffer), _curr(0) {}
 
       bool hasNext() const {
-        return _curr < _buf._pos;
+        return _curr < _buf->_pos;
       }
 
-      const Message* next() {
+      // Returns the next message without advancing.
+      const Message* peek() const {
         assert(hasNext(), "sanity check");
-        auto msg = reinterpret_cast<Message*>(_buf._buf + _curr);
-        _curr = MIN2(_curr + msg->size(), _buf._pos);
+        return reinterpret_cast<Message*>(_buf->_buf + _curr);
+      }
+
+      const Message* next() {
+        auto msg = peek();
+        _curr = MIN2(_curr + msg->size(), _buf->_pos);
         return msg;
       }
     };
@@ -156,22 +168,46 @@ class AsyncLogWriter : public NonJavaThread {
     }
   };
 
+  // A shard of the intermediate buffer, with its own lock and drop accounting.
+  class Shard : public CHeapObj<mtLogging> {
+   public:
+    // Can't use a Mutex here as we need a low-level API that can be used without Thread::current().
+    PlatformMutex _lock;
+    AsyncLogMap<AnyObj::C_HEAP> _stats;
+
+    // ping-pong buffers
+    Buffer* _buffer;
+    Buffer* _buffer_staging;
+
+    Shard(size_t capacity) : _lock(), _stats(),
+      _buffer(new Buffer(capacity)), _buffer_staging(new Buffer(capacity)) {}
+
+    ~Shard() {
+      delete _buffer;
+      delete _buffer_staging;
+    }
+  };
+
+  static const uint MaxShards = 16;
+  // Each ping-pong buffer of a shard gets at least this much of AsyncLogBufferSize.
+  static const size_t MinShardBufferSize = 32 * K;
+
   static AsyncLogWriter* _instance;
   Semaphore _flush_sem;
-  // Can't use a Monitor here as we need a low-level API that can be used without Thread::current().
-  PlatformMonitor _lock;
-  bool _data_available;
+  // Signaled when _data_available changes from false to true.
+  Semaphore _data_sem;
+  volatile bool _data_available;
   volatile bool _initialized;
-  AsyncLogMap<AnyObj::C_HEAP> _stats;
 
-  // ping-pong buffers
-  Buffer* _buffer;
-  Buffer* _buffer_staging;
+  Shard* _shards[MaxShards];
+  uint _num_shards;
 
   static const LogDecorations& None;
 
   AsyncLogWriter();
-  void enqueue_locked(LogFileStreamOutput* output, const LogDecorations& decorations, const char* msg);
+  Shard* current_shard() const;
+  bool enqueue_locked(Shard* shard, LogFileStreamOutput* output, const LogDecorations& decorations, const char* msg);
+  void signal_data_available();
   void write(AsyncLogMap<AnyObj::RESOURCE_AREA>& snapshot);
   void run() override;
   void pre_run() override {
@@ -187,8 +223,8 @@ class AsyncLogWriter : public NonJavaThread {
 
   // for testing-only
   class BufferUpdater {
-    Buffer* _buf1;
-    Buffer* _buf2;
+    Buffer* _buf1[MaxShards];
+    Buffer* _buf2[MaxShards];
 
    public:
     BufferUpdater(size_t newsize);
@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+#include "precompiled.hpp"
+#include "logging/logBinaryFormat.hpp"
+#include "logging/logDecorations.hpp"
+#include "logging/logLevel.hpp"
+#include "logging/logTagSet.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/os.hpp"
+#include "utilities/ostream.hpp"
+
+const char LogBinaryFormat::Magic[8] = "HSULBIN";
+
+size_t LogBinaryFormat::put_varint(u1* buf, uint64_t value) {
+  size_t pos = 0;
+  while (value >= 0x80) {
+    buf[pos++] = static_cast<u1>(value | 0x80);
+    value >>= 7;
+  }
+  buf[pos++] = static_cast<u1>(value);
+  return pos;
+}
+
+static bool has_time(uint decorators) {
+  return (decorators & ((1 << LogDecorators::time_decorator) |
+                        (1 << LogDecorators::utctime_decorator) |
+                        (1 << LogDecorators::timemillis_decorator))) != 0;
+}
+
+static bool has_uptime(uint decorators) {
+  return (decorators & ((1 << LogDecorators::uptime_decorator) |
+                        (1 << LogDecorators::uptimemillis_decorator) |
+                        (1 << LogDecorators::uptimenanos_decorator))) != 0;
+}
+
+static bool has_decorator(uint decorators, LogDecorators::Decorator decorator) {
+  return (decorators & (1 << decorator)) != 0;
+}
+
+static uint decorators_mask(const LogDecorators& decorators) {
+  uint mask = 0;
+  for (uint i = 0; i < LogDecorators::Count; i++) {
+    if (decorators.is_decorator(static_cast<LogDecorators::Decorator>(i))) {
+      mask |= 1 << i;
+    }
+  }
+  return mask;
+}
+
+static int write_bytes(FILE* stream, const void* buf, size_t len) {
+  if (len > 0 && fwrite(buf, 1, len, stream) != len) {
+    return -1;
+  }
+  return static_cast<int>(len);
+}
+
+static int write_string(FILE* stream, const char* str) {
+  u1 buf[LogBinaryFormat::MaxVarintSize];
+  size_t len = strlen(str);
+  size_t pos = LogBinaryFormat::put_varint(buf, len);
+  if (write_bytes(stream, buf, pos) < 0 || write_bytes(stream, str, len) < 0) {
+    return -1;
+  }
+  return static_cast<int>(pos + len);
+}
+
+LogBinaryWriter::LogBinaryWriter() :
+  _tagset_ids(new TagSetIds(64, 1024)), _decorators(0), _decorators_written(false),
+  _last_millis(0), _last_nanos(0), _last_uptime_nanos(0) {
+}
+
+LogBinaryWriter::~LogBinaryWriter() {
+  delete _tagset_ids;
+}
+
+uint LogBinaryWriter::tagset_id(const LogTagSet* tagset, bool* is_new) {
+  uint next_id = static_cast<uint>(_tagset_ids->number_of_entries());
+  uint* id = _tagset_ids->put_if_absent(tagset, next_id, is_new);
+  if (*is_new) {
+    _tagset_ids->maybe_grow();
+  }
+  return *id;
+}
+
+int LogBinaryWriter::write_header(FILE* stream) {
+  delete _tagset_ids;
+  _tagset_ids = new TagSetIds(64, 1024);
+  _decorators_written = false;
+  _last_millis = 0;
+  _last_nanos = 0;
+  _last_uptime_nanos = 0;
+
+  u1 buf[1 + 2 * LogBinaryFormat::MaxVarintSize];
+  size_t pos = 0;
+  buf[pos++] = LogBinaryFormat::Version;
+  pos += LogBinaryFormat::put_varint(buf + pos, static_cast<uint64_t>(LogDecorations::_pid));
+
+  const char* host_name = LogDecorations::host_name();
+  int written = 0;
+  int result;
+  if ((result = write_bytes(stream, LogBinaryFormat::Magic, sizeof(LogBinaryFormat::Magic) - 1)) < 0) {
+    return -1;
+  }
+  written += result;
+  if ((result = write_bytes(stream, buf, pos)) < 0) {
+    return -1;
+  }
+  written += result;
+  if ((result = write_string(stream, host_name != nullptr ? host_name : "")) < 0) {
+    return -1;
+  }
+  return written + result;
+}
+
+int LogBinaryWriter::write(FILE* stream, const LogDecorators& decorators,
+                           const LogDecorations& decorations, const char* msg) {
+  // Tag byte and one varint per value; each is usually a single byte.
+  u1 buf[2 + 8 * LogBinaryFormat::MaxVarintSize];
+  size_t pos = 0;
+  int written = 0;
+
+  uint mask = decorators_mask(decorators);
+  if (!_decorators_written || mask != _decorators) {
+    _decorators = mask;
+    _decorators_written = true;
+    buf[pos++] = LogBinaryFormat::DecoratorsRecord;
+    pos += LogBinaryFormat::put_varint(buf + pos, mask);
+  }
+
+  uint tagset = 0;
+  if (has_decorator(mask, LogDecorators::tags_decorator)) {
+    bool is_new = false;
+    tagset = tagset_id(&decorations._tagset, &is_new);
+    if (is_new) {
+      char label[256];
+      decorations._tagset.label(label, sizeof(label));
+      buf[pos++] = LogBinaryFormat::TagSetRecord;
+      pos += LogBinaryFormat::put_varint(buf + pos, tagset);
+      int result = write_bytes(stream, buf, pos);
+      if (result < 0) {
+        return -1;
+      }
+      written += result;
+      if ((result = write_string(stream, label)) < 0) {
+        return -1;
+      }
+      written += result;
+      pos = 0;
+    }
+  }
+
+  buf[pos++] = LogBinaryFormat::MessageRecord;
+  if (has_time(mask)) {
+    pos += LogBinaryFormat::put_varint(buf + pos, LogBinaryFormat::zigzag(decorations._millis - _last_millis));
+    _last_millis = decorations._millis;
+  }
+  if (has_uptime(mask)) {
+    jlong uptime_nanos = static_cast<jlong>(decorations._elapsed_seconds * NANOUNITS);
+    pos += LogBinaryFormat::put_varint(buf + pos, LogBinaryFormat::zigzag(uptime_nanos - _last_uptime_nanos));
+    _last_uptime_nanos = uptime_nanos;
+  }
+  if (has_decorator(mask, LogDecorators::timenanos_decorator)) {
+    pos += LogBinaryFormat::put_varint(buf + pos, LogBinaryFormat::zigzag(decorations._nanos - _last_nanos));
+    _last_nanos = decorations._nanos;
+  }
+  if (has_decorator(mask, LogDecorators::tid_decorator)) {
+    pos += LogBinaryFormat::put_varint(buf + pos, LogBinaryFormat::zigzag(decorations._tid));
+  }
+  if (has_decorator(mask, LogDecorators::level_decorator)) {
+    buf[pos++] = static_cast<u1>(decorations._level);
+  }
+  if (has_decorator(mask, LogDecorators::tags_decorator)) {
+    pos += LogBinaryFormat::put_varint(buf + pos, tagset);
+  }
+  assert(pos <= sizeof(buf), "buffer overflow");
+
+  int result;
+  if ((result = write_bytes(stream, buf, pos)) < 0) {
+    return -1;
+  }
+  written += result;
+  if ((result = write_string(stream, msg)) < 0) {
+    return -1;
+  }
+  return written + result;
+}
+
+LogBinaryDecoder::LogBinaryDecoder(FILE* stream) :
+  _stream(stream), _decorators(0), _millis(0), _nanos(0), _uptime_nanos(0),
+  _pid(0), _host_name(nullptr), _tagsets(new GrowableArrayCHeap<char*, mtLogging>(64)) {
+  for (uint i = 0; i < LogDecorators::Count; i++) {
+    _padding[i] = 0;
+  }
+}
+
+LogBinaryDecoder::~LogBinaryDecoder() {
+  for (int i = 0; i < _tagsets->length(); i++) {
+    FREE_C_HEAP_ARRAY(char, _tagsets->at(i));
+  }
+  delete _tagsets;
+  FREE_C_HEAP_ARRAY(char, _host_name);
+}
+
+bool LogBinaryDecoder::read_varint(uint64_t* value) {
+  uint64_t result = 0;
+  for (uint shift = 0; shift < 64; shift += 7) {
+    int c = fgetc(_stream);
+    if (c == EOF) {
+      return false;
+    }
+    result |= static_cast<uint64_t>(c & 0x7f) << shift;
+    if ((c & 0x80) == 0) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+char* LogBinaryDecoder::read_string() {
+  uint64_t len;
+  if (!read_varint(&len) || len > INT_MAX) {
+    return nullptr;
+  }
+  char* str = NEW_C_HEAP_ARRAY(char, len + 1, mtLogging);
+  if (fread(str, 1, len, _stream) != len) {
+    FREE_C_HEAP_ARRAY(char, str);
+    return nullptr;
+  }
+  str[len] = '\0';
+  return str;
+}
+
+void LogBinaryDecoder::print_message(outputStream* out, intx tid, uint level,
+                                     const char* tagset, const char* msg) {
+  char buf[LogDecorations::max_decoration_size + 1];
+  for (uint i = 0; i < LogDecorators::Count; i++) {
+    LogDecorators::Decorator decorator = static_cast<LogDecorators::Decorator>(i);
+    if (!has_decorator(_decorators, decorator)) {
+      continue;
+    }
+    stringStream ss(buf, sizeof(buf));
+    switch (decorator) {
+      case LogDecorators::time_decorator:
+      case LogDecorators::utctime_decorator: {
+        char time[os::iso8601_timestamp_size];
+        char* result = os::iso8601_time(_millis, time, sizeof(time),
+                                        decorator == LogDecorators::utctime_decorator);
+        ss.print_raw(result ? result : "");
+        break;
+      }
+      case LogDecorators::uptime_decorator:
+        ss.print("%.3fs", (double)_uptime_nanos / NANOUNITS);
+        break;
+      case LogDecorators::timemillis_decorator:
+        ss.print(INT64_FORMAT "ms", (int64_t)_millis);
+        break;
+      case LogDecorators::uptimemillis_decorator:
+        ss.print(INT64_FORMAT "ms", (int64_t)(_uptime_nanos / NANOSECS_PER_MILLISEC));
+        break;
+      case LogDecorators::timenanos_decorator:
+        ss.print(INT64_FORMAT "ns", (int64_t)_nanos);
+        break;
+      case LogDecorators::uptimenanos_decorator:
+        ss.print(INT64_FORMAT "ns", (int64_t)_uptime_nanos);
+        break;
+      case LogDecorators::hostname_decorator:
+        ss.print_raw(_host_name);
+        break;
+      case LogDecorators::pid_decorator:
+        ss.print("%d", _pid);
+        break;
+      case LogDecorators::tid_decorator:
+        ss.print(INTX_FORMAT, tid);
+        break;
+      case LogDecorators::level_decorator:
+        ss.print_raw(level < LogLevel::Count ? LogLevel::name(static_cast<LogLevelType>(level)) : "?");
+        break;
+      case LogDecorators::tags_decorator:
+        ss.print_raw(tagset != nullptr ? tagset : "?");
+        break;
+      default:
+        ShouldNotReachHere();
+    }
+    out->print("[%-*s]", (int)_padding[i], buf);
+    if (ss.size() > _padding[i]) {
+      _padding[i] = ss.size();
+    }
+  }
+  if (_decorators != 0) {
+    out->print(" ");
+  }
+  out->print_raw_cr(msg);
+}
+
+bool LogBinaryDecoder::decode(outputStream* out) {
+  char magic[sizeof(LogBinaryFormat::Magic) - 1];
+  if (fread(magic, 1, sizeof(magic), _stream) != sizeof(magic) ||
+      memcmp(magic, LogBinaryFormat::Magic, sizeof(magic)) != 0 ||
+      fgetc(_stream) != LogBinaryFormat::Version) {
+    return false;
+  }
+  uint64_t pid;
+  if (!read_varint(&pid) || (_host_name = read_string()) == nullptr) {
+    return false;
+  }
+  _pid = static_cast<int>(pid);
+
+  int tag;
+  while ((tag = fgetc(_stream)) != EOF) {
+    uint64_t value;
+    switch (tag) {
+      case LogBinaryFormat::DecoratorsRecord:
+        if (!read_varint(&value)) {
+          return false;
+        }
+        _decorators = static_cast<uint>(value);
+        break;
+
+      case LogBinaryFormat::TagSetRecord: {
+        if (!read_varint(&value) || value != static_cast<uint64_t>(_tagsets->length())) {
+          return false;
+        }
+        char* label = read_string();
+        if (label == nullptr) {
+          return false;
+        }
+        _tagsets->append(label);
+        break;
+      }
+
+      case LogBinaryFormat::MessageRecord: {
+        intx tid = 0;
+        uint level = 0;
+        const char* tagset = nullptr;
+        if (has_time(_decorators)) {
+          if (!read_varint(&value)) {
+            return false;
+          }
+          _millis += LogBinaryFormat::unzigzag(value);
+        }
+        if (has_uptime(_decorators)) {
+          if (!read_varint(&value)) {
+            return false;
+          }
+          _uptime_nanos += LogBinaryFormat::unzigzag(value);
+        }
+        if (has_decorator(_decorators, LogDecorators::timenanos_decorator)) {
+          if (!read_varint(&value)) {
+            return false;
+          }
+          _nanos += LogBinaryFormat::unzigzag(value);
+        }
+        if (has_decorator(_decorators, LogDecorators::tid_decorator)) {
+          if (!read_varint(&value)) {
+            return false;
+          }
+          tid = static_cast<intx>(LogBinaryFormat::unzigzag(value));
+        }
+        if (has_decorator(_decorators, LogDecorators::level_decorator)) {
+          int c = fgetc(_stream);
+          if (c == EOF) {
+            return false;
+          }
+          level = static_cast<uint>(c);
+        }
+        if (has_decorator(_decorators, LogDecorators::tags_decorator)) {
+          if (!read_varint(&value) || value >= static_cast<uint64_t>(_tagsets->length())) {
+            return false;
+          }
+          tagset = _tagsets->at(static_cast<int>(value));
+        }
+        char* msg = read_string();
+        if (msg == nullptr) {
+          return false;
+        }
+        print_message(out, tid, level, tagset, msg);
+        FREE_C_HEAP_ARRAY(char, msg);
+        break;
+      }
+
+      default:
+        return false;
+    }
+  }
+  return true;
+}
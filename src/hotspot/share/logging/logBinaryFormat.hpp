@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+#ifndef SHARE_LOGGING_LOGBINARYFORMAT_HPP
+#define SHARE_LOGGING_LOGBINARYFORMAT_HPP
+
+#include "logging/logDecorators.hpp"
+#include "memory/allocation.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/resizeableResourceHash.hpp"
+
+#include <stdio.h>
+
+class LogDecorations;
+class LogTagSet;
+class outputStream;
+
+// Compact binary encoding of log messages, selected with the "format=binary"
+// option of file outputs. Decorations are stored as raw values instead of
+// being formatted, so the only text written per message is the message itself.
+//
+// A file starts with the magic "HSULBIN" followed by a version byte, the pid
+// and the host name. It then consists of records, each starting with a tag byte:
+//   'D' decorators     - the set of decorators used by the following messages
+//   'T' id label       - defines a tag set id, emitted before its first use
+//   'M' values... text - a message, with one value per selected decorator
+// All integers are LEB128 varints; signed values are zig-zag encoded. The
+// time, timemillis and timenanos values are stored as deltas to the previous
+// message, and uptime values as nanoseconds delta to the previous message.
+class LogBinaryFormat : AllStatic {
+ public:
+  static const char Magic[8];
+  static const u1 Version = 1;
+
+  static const u1 DecoratorsRecord = 'D';
+  static const u1 TagSetRecord = 'T';
+  static const u1 MessageRecord = 'M';
+
+  // Longest encoding of a 64-bit varint.
+  static const size_t MaxVarintSize = 10;
+
+  static size_t put_varint(u1* buf, uint64_t value);
+  static uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+  }
+  static int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  }
+};
+
+// Writes log messages in the binary format to a stream. Callers serialize
+// access, the same way text writes to the stream are serialized.
+class LogBinaryWriter : public CHeapObj<mtLogging> {
+ private:
+  typedef ResizeableResourceHashtable<const LogTagSet*, uint, AnyObj::C_HEAP, mtLogging> TagSetIds;
+
+  // Tag set ids are assigned per file, in order of first use.
+  TagSetIds* _tagset_ids;
+
+  uint _decorators;
+  bool _decorators_written;
+  jlong _last_millis;
+  jlong _last_nanos;
+  jlong _last_uptime_nanos;
+
+  uint tagset_id(const LogTagSet* tagset, bool* is_new);
+
+ public:
+  LogBinaryWriter();
+  ~LogBinaryWriter();
+
+  // Write the file header and forget all state from a previous file.
+  int write_header(FILE* stream);
+  // Returns the number of bytes written, or -1 on error.
+  int write(FILE* stream, const LogDecorators& decorators,
+            const LogDecorations& decorations, const char* msg);
+};
+
+// Converts a binary log back into the text format of a file output.
+class LogBinaryDecoder : public StackObj {
+ private:
+  FILE* _stream;
+  uint _decorators;
+  jlong _millis;
+  jlong _nanos;
+  jlong _uptime_nanos;
+  int _pid;
+  char* _host_name;
+  GrowableArrayCHeap<char*, mtLogging>* _tagsets;
+  size_t _padding[LogDecorators::Count];
+
+  bool read_varint(uint64_t* value);
+  char* read_string();
+  void print_message(outputStream* out, intx tid, uint level, const char* tagset, const char* msg);
+
+ public:
+  LogBinaryDecoder(FILE* stream);
+  ~LogBinaryDecoder();
+
+  // Decode the whole stream. Returns false if the input is not a
+  // binary log or is truncated.
+  bool decode(outputStream* out);
+};
+
+#endif // SHARE_LOGGING_LOGBINARYFORMAT_HPP
@@ -634,6 +634,9 @@ void LogConfiguration::print_command_line_help(outputStream* out) {
   out->print_cr(" filecount=..      - Number of files to keep in rotation (not counting the active file)."
                                        " If set to 0, log rotation is disabled."
                                        " This will cause existing log files to be overwritten.");
+  out->print_cr(" format=..         - Either 'text' (default) or 'binary'."
+                                       " The binary format stores decorations as compact raw values"
+                                       " and has to be decoded before it can be read.");
   out->cr();
 
   out->print_cr("Asynchronous logging (off by default):");
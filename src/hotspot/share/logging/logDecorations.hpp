@@ -35,6 +35,7 @@ class outputStream;
 // printed. That may happen delayed, and the object may be stored for some time,
 // in the context of asynchronous logging. Therefore size of this object matters.
 class LogDecorations {
+  friend class LogBinaryWriter;
 
   const jlong _millis;            // for "time", "utctime", "timemillis"
   const jlong _nanos;             // for "timenanos"
@@ -25,6 +25,7 @@
 #include "jvm.h"
 #include "logging/log.hpp"
 #include "logging/logAsyncWriter.hpp"
+#include "logging/logBinaryFormat.hpp"
 #include "logging/logConfiguration.hpp"
 #include "logging/logFileOutput.hpp"
 #include "memory/allocation.inline.hpp"
@@ -41,6 +42,7 @@ const char* const LogFileOutput::TimestampFormat = "%Y-%m-%d_%H-%M-%S";
 const char* const LogFileOutput::HostnameFilenamePlaceholder = "%hn";
 const char* const LogFileOutput::FileSizeOptionKey = "filesize";
 const char* const LogFileOutput::FileCountOptionKey = "filecount";
+const char* const LogFileOutput::FormatOptionKey = "format";
 char        LogFileOutput::_pid_str[PidBufferSize];
 char        LogFileOutput::_vm_start_time_str[StartTimeBufferSize];
 
@@ -82,6 +84,7 @@ LogFileOutput::~LogFileOutput() {
   os::free(_archive_name);
   os::free(_file_name);
   os::free(const_cast<char*>(_name));
+  delete _binary;
 }
 
 static size_t parse_value(const char* value_str) {
@@ -191,6 +194,19 @@ bool LogFileOutput::set_option(const char* key, const char* value, outputStream*
         _rotate_size = static_cast<size_t>(longval);
         success = true;
       }
+    } else if (strcmp(FormatOptionKey, key) == 0) {
+      if (strcmp(value, "binary") == 0) {
+        if (_binary == nullptr) {
+          _binary = new LogBinaryWriter();
+        }
+        success = true;
+      } else if (strcmp(value, "text") == 0) {
+        delete _binary;
+        _binary = nullptr;
+        success = true;
+      } else {
+        errstream->print_cr("Invalid option: %s must be 'text' or 'binary'.", FormatOptionKey);
+      }
     }
   }
   return success;
@@ -250,9 +266,22 @@ bool LogFileOutput::initialize(const char* options, outputStream* errstream) {
     os::ftruncate(os::get_fileno(_stream), 0);
   }
 
+  write_binary_header();
   return true;
 }
 
+void LogFileOutput::write_binary_header() {
+  if (_binary == nullptr) {
+    return;
+  }
+  int written = _binary->write_header(_stream);
+  if (written < 0 || !flush()) {
+    jio_fprintf(defaultStream::error_stream(), "Could not write binary log header to '%s'.\n", _file_name);
+    return;
+  }
+  _current_size += written;
+}
+
 class RotationLocker : public StackObj {
   Semaphore& _sem;
 
@@ -374,6 +403,9 @@ void LogFileOutput::rotate() {
   // Reset accumulated size, increase current file counter, and check for file count wrap-around.
   _current_size = 0;
   increment_file_count();
+
+  // Every file of a binary log is self-contained
+  write_binary_header();
 }
 
 char* LogFileOutput::make_file_name(const char* file_name,
@@ -461,8 +493,9 @@ char* LogFileOutput::make_file_name(const char* file_name,
 
 void LogFileOutput::describe(outputStream *out) {
   LogFileStreamOutput::describe(out);
-  out->print(",filecount=%u,filesize=" SIZE_FORMAT "%s,async=%s", _file_count,
+  out->print(",filecount=%u,filesize=" SIZE_FORMAT "%s,async=%s,format=%s", _file_count,
              byte_size_in_proper_unit(_rotate_size),
              proper_unit_for_byte_size(_rotate_size),
-             LogConfiguration::is_async_mode() ? "true" : "false");
+             LogConfiguration::is_async_mode() ? "true" : "false",
+             _binary != nullptr ? "binary" : "text");
 }
@@ -36,6 +36,7 @@ class LogFileOutput : public LogFileStreamOutput {
   static const char* const FileOpenMode;
   static const char* const FileCountOptionKey;
   static const char* const FileSizeOptionKey;
+  static const char* const FormatOptionKey;
   static const char* const PidFilenamePlaceholder;
   static const char* const TimestampFilenamePlaceholder;
   static const char* const TimestampFormat;
@@ -67,6 +68,7 @@ class LogFileOutput : public LogFileStreamOutput {
 
   void archive();
   void rotate();
+  void write_binary_header();
   char *make_file_name(const char* file_name, const char* pid_string, const char* timestamp_string);
 
   bool should_rotate() {
@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 #include "jvm.h"
 #include "logging/logAsyncWriter.hpp"
+#include "logging/logBinaryFormat.hpp"
 #include "logging/logDecorations.hpp"
 #include "logging/logDecorators.hpp"
 #include "logging/logFileStreamOutput.hpp"
@@ -116,6 +117,12 @@ bool LogFileStreamOutput::flush() {
 }
 
 int LogFileStreamOutput::write_internal(const LogDecorations& decorations, const char* msg) {
+  if (_binary != nullptr) {
+    int written = 0;
+    WRITE_LOG_WITH_RESULT_CHECK(_binary->write(_stream, _decorators, decorations, msg), written);
+    return written;
+  }
+
   int written = 0;
   const bool use_decorations = !_decorators.is_empty();
 
@@ -29,6 +29,7 @@
 #include "runtime/os.hpp"
 #include "utilities/globalDefinitions.hpp"
 
+class LogBinaryWriter;
 class LogDecorations;
 
 // Base class for all FileStream-based log outputs.
@@ -40,9 +41,11 @@ class LogFileStreamOutput : public LogOutput {
 
  protected:
   FILE*               _stream;
+  // Non-null when messages are written in the binary format
+  LogBinaryWriter*    _binary;
   size_t              _decorator_padding[LogDecorators::Count];
 
-  LogFileStreamOutput(FILE *stream) : _fold_multilines(false), _write_error_is_shown(false), _stream(stream) {
+  LogFileStreamOutput(FILE *stream) : _fold_multilines(false), _write_error_is_shown(false), _stream(stream), _binary(nullptr) {
     for (size_t i = 0; i < LogDecorators::Count; i++) {
       _decorator_padding[i] = 0;
     }
@@ -25,6 +25,7 @@
 
 #include "precompiled.hpp"
 #include "compiler/compilationMemoryStatistic.hpp"
+#include "compiler/compilerThread.hpp"
 #include "memory/allocation.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/arena.hpp"
@@ -71,18 +72,22 @@ class ChunkPool {
   }
 
   // Clear this pool of all contained chunks
-  void prune() {
+  // Returns the number of bytes freed.
+  size_t prune() {
     // Free all chunks while in ThreadCritical lock
     // so NMT adjustment is stable.
     ThreadCritical tc;
     Chunk* cur = _first;
     Chunk* next = nullptr;
+    size_t freed = 0;
     while (cur != nullptr) {
       next = cur->next();
       os::free(cur);
+      freed += _size;
       cur = next;
     }
     _first = nullptr;
+    return freed;
   }
 
   // Given a (inner payload) size, return the pool responsible for it, or null if the size is non-standard
@@ -100,12 +105,27 @@ class ChunkPool {
 
   static void clean() {
     NativeHeapTrimmer::SuspendMark sm("chunk pool cleaner");
+    size_t freed = 0;
     for (int i = 0; i < _num_pools; i++) {
-      _pools[i].prune();
+      freed += _pools[i].prune();
+    }
+    // The chunks of compiler arenas can add up to a lot of memory.
+    if (freed >= 1 * M) {
+      NativeHeapTrimmer::request_trim("chunk pool cleaning");
+    }
+  }
+
+  // Advise large pages for the parts of a newly allocated chunk which span them.
+  static void advise_large_pages(char* p, size_t bytes) {
+    const size_t page_size = os::large_page_size();
+    char* const start = align_up(p, page_size);
+    char* const end = align_down(p + bytes, page_size);
+    if (start < end) {
+      os::realign_memory(start, pointer_delta(end, start, 1), page_size);
     }
   }
 
-  // Returns an initialized and null-terminated Chunk of requested size
+  // Returns an initialized and null-terminated Chunk of at least the requested size
   static Chunk* allocate_chunk(size_t length, AllocFailType alloc_failmode);
   static void deallocate_chunk(Chunk* p);
 };
@@ -131,10 +151,19 @@ Chunk* ChunkPool::allocate_chunk(size_t length, AllocFailType alloc_failmode) {
 
   assert(is_aligned(length, ARENA_AMALLOC_ALIGNMENT), "chunk payload length misaligned: "
          SIZE_FORMAT ".", length);
+  // Try to reuse a chunk from the cache of this thread; it may be longer than requested.
+  ThreadChunkCache* const cache = ThreadChunkCache::current();
+  Chunk* chunk = nullptr;
+  if (cache != nullptr) {
+    chunk = cache->take(length);
+    if (chunk != nullptr) {
+      assert(chunk->length() >= length, "too short");
+      length = chunk->length();
+    }
+  }
   // Try to reuse a freed chunk from the pool
   ChunkPool* pool = ChunkPool::get_pool_for_size(length);
-  Chunk* chunk = nullptr;
-  if (pool != nullptr) {
+  if (chunk == nullptr && pool != nullptr) {
     Chunk* c = pool->take_from_pool();
     if (c != nullptr) {
       assert(c->length() == length, "wrong length?");
@@ -144,10 +173,13 @@ Chunk* ChunkPool::allocate_chunk(size_t length, AllocFailType alloc_failmode) {
   if (chunk == nullptr) {
     // Either the pool was empty, or this is a non-standard length. Allocate a new Chunk from C-heap.
     size_t bytes = ARENA_ALIGN(sizeof(Chunk)) + length;
-    void* p = os::malloc(bytes, mtChunk, CALLER_PC);
+    void* p = os::malloc(bytes, mtChunk, CALLER_PC_SAMPLED(bytes));
     if (p == nullptr && alloc_failmode == AllocFailStrategy::EXIT_OOM) {
       vm_exit_out_of_memory(bytes, OOM_MALLOC_ERROR, "Chunk::new");
     }
+    if (p != nullptr && cache != nullptr && cache->use_large_pages()) {
+      advise_large_pages((char*)p, bytes);
+    }
     chunk = (Chunk*)p;
   }
   ::new(chunk) Chunk(length);
@@ -157,6 +189,11 @@ Chunk* ChunkPool::allocate_chunk(size_t length, AllocFailType alloc_failmode) {
 }
 
 void ChunkPool::deallocate_chunk(Chunk* c) {
+  // Keep the chunk in the cache of this thread if there is room.
+  ThreadChunkCache* const cache = ThreadChunkCache::current();
+  if (cache != nullptr && cache->put(c)) {
+    return;
+  }
   // If this is a standard-sized chunk, return it to its pool; otherwise free it.
   ChunkPool* pool = ChunkPool::get_pool_for_size(c->length());
   if (pool != nullptr) {
@@ -169,6 +206,112 @@ void ChunkPool::deallocate_chunk(Chunk* c) {
 
 ChunkPool ChunkPool::_pools[] = { Chunk::size, Chunk::medium_size, Chunk::init_size, Chunk::tiny_size };
 
+ThreadChunkCache::ThreadChunkCache(size_t max_bytes, bool use_large_pages) :
+  _other(nullptr),
+  _cached_bytes(0),
+  _max_bytes(max_bytes),
+  _use_large_pages(use_large_pages) {
+  for (int i = 0; i < _num_standard_sizes; i++) {
+    _standard[i] = nullptr;
+  }
+}
+
+ThreadChunkCache::~ThreadChunkCache() {
+  clear();
+}
+
+ThreadChunkCache* ThreadChunkCache::current() {
+  Thread* const t = Thread::current_or_null();
+  if (t != nullptr && t->is_Compiler_thread()) {
+    return CompilerThread::cast(t)->chunk_cache();
+  }
+  return nullptr;
+}
+
+int ThreadChunkCache::index_for_standard_size(size_t length) {
+  switch (length) {
+    case Chunk::size:        return 0;
+    case Chunk::medium_size: return 1;
+    case Chunk::init_size:   return 2;
+    case Chunk::tiny_size:   return 3;
+    default:                 return -1;
+  }
+}
+
+Chunk* ThreadChunkCache::take(size_t length) {
+  Chunk* c = nullptr;
+  const int index = index_for_standard_size(length);
+  if (index >= 0) {
+    c = _standard[index];
+    if (c != nullptr) {
+      _standard[index] = c->next();
+    }
+  } else {
+    Chunk* prev = nullptr;
+    for (c = _other; c != nullptr && c->length() < length; c = c->next()) {
+      prev = c;
+    }
+    if (c != nullptr && c->length() / 2 > length) {
+      c = nullptr;
+    }
+    if (c != nullptr) {
+      if (prev == nullptr) {
+        _other = c->next();
+      } else {
+        prev->set_next(c->next());
+      }
+    }
+  }
+  if (c != nullptr) {
+    _cached_bytes -= c->length();
+  }
+  return c;
+}
+
+bool ThreadChunkCache::put(Chunk* c) {
+  if (_cached_bytes + c->length() > _max_bytes) {
+    return false;
+  }
+  const int index = index_for_standard_size(c->length());
+  if (index >= 0) {
+    c->set_next(_standard[index]);
+    _standard[index] = c;
+  } else {
+    Chunk* prev = nullptr;
+    Chunk* next = _other;
+    while (next != nullptr && next->length() < c->length()) {
+      prev = next;
+      next = next->next();
+    }
+    c->set_next(next);
+    if (prev == nullptr) {
+      _other = c;
+    } else {
+      prev->set_next(c);
+    }
+  }
+  _cached_bytes += c->length();
+  return true;
+}
+
+void ThreadChunkCache::clear() {
+  // Free chunks under TC lock so that NMT adjustment is stable.
+  ThreadCritical tc;
+  for (int i = 0; i <= _num_standard_sizes; i++) {
+    Chunk* c = (i < _num_standard_sizes) ? _standard[i] : _other;
+    while (c != nullptr) {
+      Chunk* next = c->next();
+      os::free(c);
+      c = next;
+    }
+  }
+  for (int i = 0; i < _num_standard_sizes; i++) {
+    _standard[i] = nullptr;
+  }
+  _other = nullptr;
+  _cached_bytes = 0;
+}
+
 class ChunkPoolCleaner : public PeriodicTask {
   static const int cleaning_interval = 5000; // cleaning interval in ms
 
@@ -221,7 +364,7 @@ Arena::Arena(MEMFLAGS flag, Tag tag, size_t init_size) :
   _hwm = _chunk->bottom();      // Save the cached hwm, max
   _max = _chunk->top();
   MemTracker::record_new_arena(flag);
-  set_size_in_bytes(init_size);
+  set_size_in_bytes(_chunk->length());
 }
 
 Arena::~Arena() {
@@ -292,7 +435,7 @@ void* Arena::grow(size_t x, AllocFailType alloc_failmode) {
   }
   _hwm  = _chunk->bottom();     // Save the cached hwm, max
   _max =  _chunk->top();
-  set_size_in_bytes(size_in_bytes() + len);
+  set_size_in_bytes(size_in_bytes() + _chunk->length());
   void* result = _hwm;
   _hwm += x;
   return result;
@@ -83,6 +83,46 @@ class Chunk {
   bool contains(char* p) const  { return bottom() <= p && p <= top(); }
 };
 
+// A cache of chunks owned by a single thread. Compiler threads use it to keep
+// the chunks of their arenas from one compilation to the next, instead of
+// handing them back to the shared chunk pools or to the C-heap each time. The
+// cache holds at most max_bytes of chunks; chunks which do not fit are released
+// as usual.
+class ThreadChunkCache : public CHeapObj<mtChunk> {
+  static constexpr int _num_standard_sizes = 4;
+
+  Chunk* _standard[_num_standard_sizes];  // standard-sized chunks, by size
+  Chunk* _other;                          // other chunks, by ascending length
+  size_t _cached_bytes;
+  const size_t _max_bytes;
+  const bool _use_large_pages;
+
+  static int index_for_standard_size(size_t length);
+
+public:
+  ThreadChunkCache(size_t max_bytes, bool use_large_pages);
+  ~ThreadChunkCache();
+
+  // Returns the chunk cache of the current thread, or null.
+  static ThreadChunkCache* current();
+
+  // Returns a cached chunk of the given standard length or, for other lengths,
+  // the smallest cached chunk at least that long but not more than twice as long.
+  // Returns null if there is none.
+  Chunk* take(size_t length);
+
+  // Keeps the chunk unless the cache would exceed its maximum size. Returns
+  // true if the chunk was taken.
+  bool put(Chunk* c);
+
+  // Frees all cached chunks.
+  void clear();
+
+  // True if new chunks of this thread should be backed by large pages.
+  bool use_large_pages() const  { return _use_large_pages; }
+  size_t cached_bytes() const   { return _cached_bytes; }
+};
+
 // Fast allocation of memory
 class Arena : public CHeapObjBase {
 public:
@@ -140,6 +140,20 @@ void ClassLoaderMetaspace::deallocate(MetaWord* ptr, size_t word_size, bool is_c
   DEBUG_ONLY(InternalStats::inc_num_deallocs();)
 }
 
+// Give back chunks, or tails of chunks, which have entirely been deallocated.
+// Returns the number of committed words given back.
+size_t ClassLoaderMetaspace::reclaim_free_chunks() {
+  MutexLocker fcl(lock(), Mutex::_no_safepoint_check_flag);
+  size_t reclaimed_words = 0;
+  if (non_class_space_arena() != nullptr) {
+    reclaimed_words += non_class_space_arena()->reclaim_free_chunks();
+  }
+  if (class_space_arena() != nullptr) {
+    reclaimed_words += class_space_arena()->reclaim_free_chunks();
+  }
+  return reclaimed_words;
+}
+
 // Update statistics. This walks all in-use chunks.
 void ClassLoaderMetaspace::add_to_statistics(metaspace::ClmsStats* out) const {
   MutexLocker fcl(lock(), Mutex::_no_safepoint_check_flag);
@@ -94,6 +94,10 @@ class ClassLoaderMetaspace : public CHeapObj<mtClass> {
   // because it is not needed anymore.
   void deallocate(MetaWord* ptr, size_t word_size, bool is_class);
 
+  // Give back chunks, or tails of chunks, which have entirely been deallocated.
+  // Returns the number of committed words given back.
+  size_t reclaim_free_chunks();
+
   // Update statistics. This walks all in-use chunks.
   void add_to_statistics(metaspace::ClmsStats* out) const;
 
@@ -316,6 +316,27 @@ void* CodeHeap::allocate(size_t instance_size) {
   }
 }
 
+void* CodeHeap::allocate_below(size_t instance_size, const void* limit) {
+  size_t number_of_segments = size_to_segments(instance_size + header_size());
+  assert(segments_to_size(number_of_segments) >= sizeof(FreeBlock), "not enough room for FreeList");
+  assert_locked_or_safepoint(CodeCache_lock);
+
+  // Only free blocks can be below an allocated block, so there is
+  // no need to look at the unallocated part of the heap.
+  NOT_PRODUCT(verify());
+  HeapBlock* block = search_freelist(number_of_segments, limit);
+  NOT_PRODUCT(verify());
+
+  if (block == nullptr) {
+    return nullptr;
+  }
+  assert(!block->free(), "must not be marked free");
+  assert((void*)block < limit, "must be below limit");
+  _max_allocated_capacity = MAX2(_max_allocated_capacity, allocated_capacity());
+  _blob_count++;
+  return block->allocated_space();
+}
+
 // Split the given block into two at the given segment.
 // This is helpful when a block was allocated too large
 // to trim off the unused space at the end (interpreter).
@@ -653,7 +674,7 @@ void CodeHeap::add_to_freelist(HeapBlock* a) {
  * Search freelist for an entry on the list with the best fit.
  * @return null, if no one was found
  */
-HeapBlock* CodeHeap::search_freelist(size_t length) {
+HeapBlock* CodeHeap::search_freelist(size_t length, const void* limit) {
   FreeBlock* found_block  = nullptr;
   FreeBlock* found_prev   = nullptr;
   size_t     found_length = _next_segment; // max it out to begin with
@@ -664,8 +685,9 @@ HeapBlock* CodeHeap::search_freelist(size_t length) {
 
   length = length < CodeCacheMinBlockLength ? CodeCacheMinBlockLength : length;
 
-  // Search for best-fitting block
-  while(cur != nullptr) {
+  // Search for best-fitting block. The freelist is ordered by address,
+  // so stop at the first block at or above the limit.
+  while(cur != nullptr && (limit == nullptr || (void*)cur < limit)) {
     size_t cur_length = cur->length();
     if (cur_length == length) {
       // We have a perfect fit
@@ -138,7 +138,7 @@ class CodeHeap : public CHeapObj<mtCode> {
 
   // Toplevel freelist management
   void add_to_freelist(HeapBlock* b);
-  HeapBlock* search_freelist(size_t length);
+  HeapBlock* search_freelist(size_t length, const void* limit = nullptr);
 
   // Iteration helpers
   void*      next_used(HeapBlock* b) const;
@@ -157,6 +157,9 @@ class CodeHeap : public CHeapObj<mtCode> {
   // Memory allocation
   void* allocate (size_t size); // Allocate 'size' bytes in the code cache or return null
   void  deallocate(void* p);    // Deallocate memory
+  // Allocate 'size' bytes from a free block below 'limit' or return null.
+  // Used to move code blobs down when compacting the heap.
+  void* allocate_below(size_t size, const void* limit);
   // Free the tail of segments allocated by the last call to 'allocate()' which exceed 'used_size'.
   // ATTENTION: this is only safe to use if there was no other call to 'allocate()' after
   //            'p' was allocated. Only intended for freeing memory which would be otherwise
@@ -38,6 +38,7 @@
 #include "runtime/atomic.hpp"
 #include "runtime/os.hpp"
 #include "utilities/globalDefinitions.hpp"
+#include "utilities/json.hpp"
 #include "utilities/macros.hpp"
 #include "utilities/stack.inline.hpp"
 
@@ -117,6 +118,23 @@ void KlassInfoEntry::print_on(outputStream* st) const {
   }
 }
 
+void KlassInfoEntry::print_json_on(JSONWriter* writer) const {
+  ResourceMark rm;
+
+  writer->begin_object();
+  writer->print_uint("instances", (uint64_t)_instance_count);
+  writer->print_uint("bytes", (uint64_t)_instance_words * HeapWordSize);
+  writer->print_string("name", name());
+  ModuleEntry* module = _klass->module();
+  if (module->is_named()) {
+    writer->print_string("module", module->name()->as_C_string());
+    if (module->version() != nullptr) {
+      writer->print_string("moduleVersion", module->version()->as_C_string());
+    }
+  }
+  writer->end_object();
+}
+
 KlassInfoEntry* KlassInfoBucket::lookup(Klass* const k) {
   // Can happen if k is an archived class that we haven't loaded yet.
   if (k->java_mirror_no_keepalive() == nullptr) {
@@ -308,6 +326,20 @@ void KlassInfoHisto::print_elements(outputStream* st) const {
                total, totalw * HeapWordSize);
 }
 
+void KlassInfoHisto::print_elements_json(JSONWriter* writer) const {
+  uint64_t total = 0;
+  uint64_t totalw = 0;
+  writer->begin_array("classes");
+  for (int i = 0; i < elements()->length(); i++) {
+    elements()->at(i)->print_json_on(writer);
+    total += elements()->at(i)->count();
+    totalw += elements()->at(i)->words();
+  }
+  writer->end_array();
+  writer->print_uint("totalInstances", total);
+  writer->print_uint("totalBytes", totalw * HeapWordSize);
+}
+
 class HierarchyClosure : public KlassInfoClosure {
 private:
   GrowableArray<KlassInfoEntry*> *_elements;
@@ -498,6 +530,14 @@ void KlassInfoHisto::print_histo_on(outputStream* st) {
   print_elements(st);
 }
 
+void KlassInfoHisto::print_histo_json_on(outputStream* st) {
+  JSONWriter writer(st);
+  writer.begin_object();
+  print_elements_json(&writer);
+  writer.end_object();
+  st->cr();
+}
+
 class HistoClosure : public KlassInfoClosure {
  private:
   KlassInfoHisto* _cih;
@@ -584,7 +624,7 @@ uintx HeapInspection::populate_table(KlassInfoTable* cit, BoolObjectClosure *fil
   return ric.missed_count();
 }
 
-void HeapInspection::heap_inspection(outputStream* st, WorkerThreads* workers) {
+void HeapInspection::heap_inspection(outputStream* st, WorkerThreads* workers, bool json) {
   ResourceMark rm;
 
   KlassInfoTable cit(false);
@@ -604,7 +644,11 @@ void HeapInspection::heap_inspection(outputStream* st, WorkerThreads* workers) {
     cit.iterate(&hc);
 
     histo.sort();
-    histo.print_histo_on(st);
+    if (json) {
+      histo.print_histo_json_on(st);
+    } else {
+      histo.print_histo_on(st);
+    }
   } else {
     st->print_cr("ERROR: Ran out of C-heap; histogram not generated");
   }
@@ -32,6 +32,8 @@
 #include "oops/annotations.hpp"
 #include "utilities/macros.hpp"
 
+class JSONWriter;
+
 class ParallelObjectIterator;
 
 #if INCLUDE_SERVICES
@@ -81,6 +83,7 @@ class KlassInfoEntry: public CHeapObj<mtInternal> {
   bool do_print() const      { return _do_print; }
   int compare(KlassInfoEntry* e1, KlassInfoEntry* e2);
   void print_on(outputStream* st) const;
+  void print_json_on(JSONWriter* writer) const;
   const char* name() const;
 };
 
@@ -150,6 +153,7 @@ class KlassInfoHisto : public StackObj {
   GrowableArray<KlassInfoEntry*>* elements() const { return _elements; }
   static int sort_helper(KlassInfoEntry** e1, KlassInfoEntry** e2);
   void print_elements(outputStream* st) const;
+  void print_elements_json(JSONWriter* writer) const;
   bool is_selected(const char *col_name);
 
   static void print_julong(outputStream* st, int width, julong n) {
@@ -187,6 +191,7 @@ class KlassInfoHisto : public StackObj {
   ~KlassInfoHisto();
   void add(KlassInfoEntry* cie);
   void print_histo_on(outputStream* st);
+  void print_histo_json_on(outputStream* st);
   void sort();
 };
 
@@ -199,7 +204,7 @@ class KlassInfoClosure;
 
 class HeapInspection : public StackObj {
  public:
-  void heap_inspection(outputStream* st, WorkerThreads* workers) NOT_SERVICES_RETURN;
+  void heap_inspection(outputStream* st, WorkerThreads* workers, bool json = false) NOT_SERVICES_RETURN;
   uintx populate_table(KlassInfoTable* cit, BoolObjectClosure* filter, WorkerThreads* workers) NOT_SERVICES_RETURN_(0);
   static void find_instances_at_safepoint(Klass* k, GrowableArray<oop>* result) NOT_SERVICES_RETURN;
 };
@@ -185,6 +185,17 @@ class BinListImpl {
 
   bool is_empty() const { return count() == 0; }
 
+  // Call f(p, word_size) for every block in this structure.
+  template <typename F>
+  void iterate(F f) const {
+    for (int i = 0; i < num_lists; i++) {
+      const size_t s = word_size_for_index(i);
+      for (Block* b = _blocks[i]; b != nullptr; b = b->_next) {
+        f((MetaWord*)b, s);
+      }
+    }
+  }
+
 #ifdef ASSERT
   void verify() const {
     MemRangeCounter local_counter;
@@ -398,6 +398,23 @@ class BlockTree: public CHeapObj<mtMetaspace> {
 
   bool is_empty() const { return _root == nullptr; }
 
+  // Call f(p, word_size) for every block in this structure, in ascending size order.
+  template <typename F>
+  void iterate(F f) const {
+    Node* n = _root;
+    if (n == nullptr) {
+      return;
+    }
+    while (n->_left != nullptr) {
+      n = n->_left;
+    }
+    for (; n != nullptr; n = successor(n)) {
+      for (Node* n2 = n; n2 != nullptr; n2 = n2->_next) {
+        f((MetaWord*)n2, n2->_word_size);
+      }
+    }
+  }
+
   DEBUG_ONLY(void print_tree(outputStream* st) const;)
   DEBUG_ONLY(void verify() const;)
 };
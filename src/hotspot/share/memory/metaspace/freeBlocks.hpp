@@ -110,6 +110,13 @@ class FreeBlocks : public CHeapObj<mtMetaspace> {
     return _small_blocks.is_empty() && _tree.is_empty();
   }
 
+  // Call f(p, word_size) for every block.
+  template <typename F>
+  void iterate(F f) const {
+    _small_blocks.iterate(f);
+    _tree.iterate(f);
+  }
+
 };
 
 } // namespace metaspace
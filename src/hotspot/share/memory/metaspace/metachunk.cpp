@@ -155,6 +155,18 @@ void Metachunk::uncommit_locked() {
     _committed_words = 0;
   }
 }
+
+void Metachunk::uncommit_tail_locked(size_t new_used_words) {
+  assert_lock_strong(Metaspace_lock);
+  assert(_state == State::InUse && new_used_words <= _used_words &&
+         is_aligned(new_used_words, Settings::commit_granule_words()),
+         "Bad tail to uncommit at " SIZE_FORMAT " (chunk " METACHUNK_FULL_FORMAT ").",
+         new_used_words, METACHUNK_FULL_FORMAT_ARGS(this));
+  _vsnode->uncommit_range(base() + new_used_words, word_size() - new_used_words);
+  _used_words = new_used_words;
+  _committed_words = new_used_words;
+}
+
 void Metachunk::set_committed_words(size_t v) {
   // Set committed words. Since we know that we only commit whole commit granules, we can round up v here.
   v = MIN2(align_up(v, Settings::commit_granule_words()), word_size());
@@ -312,6 +312,11 @@ class Metachunk {
   void uncommit();
   void uncommit_locked();
 
+  // Give back the tail of a retired in-use chunk: the used area shrinks to
+  // new_used_words, which must be aligned to the commit granule size, and the
+  // rest of the chunk is uncommitted.
+  void uncommit_tail_locked(size_t new_used_words);
+
   // Allocation from a chunk
 
   // Allocate word_size words from this chunk (word_size must be aligned to
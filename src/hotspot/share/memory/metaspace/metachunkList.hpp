@@ -82,6 +82,23 @@ class MetachunkList {
     return nullptr;
   }
 
+  // Remove the given chunk, which must be in this list.
+  void remove(Metachunk* c) {
+    assert(contains(c), "List does not contain this chunk.");
+    if (c == _first) {
+      remove_first();
+      return;
+    }
+    Metachunk* next = c->next();
+    c->prev()->set_next(next);
+    if (next) {
+      next->set_prev(c->prev());
+    }
+    _num_chunks.decrement();
+    c->set_prev(nullptr);
+    c->set_next(nullptr);
+  }
+
   Metachunk* first()              { return _first; }
   const Metachunk* first() const  { return _first; }
 
@@ -37,6 +37,7 @@
 #include "memory/metaspace/metaspaceSettings.hpp"
 #include "memory/metaspace/metaspaceStatistics.hpp"
 #include "memory/metaspace/virtualSpaceList.hpp"
+#include "memory/resourceArea.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/init.hpp"
 #include "runtime/mutexLocker.hpp"
@@ -44,6 +45,7 @@
 #include "utilities/align.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/globalDefinitions.hpp"
+#include "utilities/quickSort.hpp"
 
 namespace metaspace {
 
@@ -373,6 +375,153 @@ void MetaspaceArena::deallocate(MetaWord* p, size_t word_size) {
   SOMETIMES(verify();)
 }
 
+// A deallocated block, as seen when looking for reclaimable chunks.
+struct FreeRange {
+  MetaWord* _p;
+  size_t _word_size;
+  MetaWord* end() const { return _p + _word_size; }
+};
+
+static int compare_free_ranges(const FreeRange& a, const FreeRange& b) {
+  return a._p < b._p ? -1 : (a._p > b._p ? 1 : 0);
+}
+
+// Returns the blocks in fbl, sorted by address, in a resource array.
+static FreeRange* collect_free_blocks(const FreeBlocks* fbl, int* num_blocks) {
+  FreeRange* blocks = NEW_RESOURCE_ARRAY(FreeRange, fbl->count());
+  int n = 0;
+  fbl->iterate([&](MetaWord* p, size_t word_size) {
+    assert(n < fbl->count(), "Sanity");
+    blocks[n]._p = p;
+    blocks[n]._word_size = word_size;
+    n++;
+  });
+  QuickSort::sort(blocks, n, compare_free_ranges);
+  *num_blocks = n;
+  return blocks;
+}
+
+// Returns the index of the first block at or above p.
+static int find_free_block(const FreeRange* blocks, int num_blocks, const MetaWord* p) {
+  int lo = 0;
+  int hi = num_blocks;
+  while (lo < hi) {
+    const int mid = lo + (hi - lo) / 2;
+    if (blocks[mid]._p < p) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+// Given the free blocks [from, to) inside the used area of the retired chunk c,
+// returns the used word size c can be shrunk to: zero if the free blocks cover
+// the whole used area, otherwise the start of the free tail of the used area,
+// aligned up to a commit granule, if that gives back at least one granule.
+// Returns the current used word size if nothing can be given back. On return,
+// *first_tail is the index of the first block of the free tail.
+static size_t reclaimable_used_words(const Metachunk* c, const FreeRange* blocks,
+                                     int from, int to, int* first_tail) {
+  MetaWord* tail_start = c->top();
+  int i = to;
+  while (i > from && blocks[i - 1].end() == tail_start) {
+    i--;
+    tail_start = blocks[i]._p;
+  }
+  *first_tail = i;
+  if (tail_start == c->base()) {
+    return 0;
+  }
+  if (c->word_size() >= Settings::commit_granule_words()) {
+    MetaWord* const new_top = align_up(tail_start, Settings::commit_granule_bytes());
+    if (new_top <= c->top() && new_top < c->committed_top()) {
+      return pointer_delta(new_top, c->base(), sizeof(MetaWord));
+    }
+  }
+  return c->used_words();
+}
+
+// Give back memory of retired chunks which has entirely been deallocated.
+// (requires CLD lock to be active).
+size_t MetaspaceArena::reclaim_free_chunks() {
+  if (_fbl == nullptr || _fbl->is_empty()) {
+    return 0;
+  }
+  assert(current_chunk() != nullptr, "deallocated blocks but no chunks?");
+
+  ResourceMark rm;
+  int num_blocks = 0;
+  FreeRange* const blocks = collect_free_blocks(_fbl, &num_blocks);
+
+  size_t reclaimed_words = 0;
+  size_t released_used_words = 0;
+  int num_chunks_returned = 0;
+  int num_tails_uncommitted = 0;
+
+  // The current chunk is still being allocated from; only look at retired chunks.
+  Metachunk* c = current_chunk()->next();
+  while (c != nullptr) {
+    Metachunk* const next = c->next();
+    const int from = find_free_block(blocks, num_blocks, c->base());
+    const int to = find_free_block(blocks, num_blocks, c->top());
+    int first_tail = to;
+    const size_t new_used_words = reclaimable_used_words(c, blocks, from, to, &first_tail);
+    if (new_used_words < c->used_words()) {
+      // The blocks of the free tail go away with it, but whatever lies between
+      // the start of the tail and the new used top is kept as one block.
+      MetaWord* const new_top = c->base() + new_used_words;
+      MetaWord* const tail_start = blocks[first_tail]._p;
+      for (int i = first_tail; i < to; i++) {
+        blocks[i]._word_size = 0;
+      }
+      if (new_top > tail_start) {
+        const size_t kept_words = pointer_delta(new_top, tail_start, sizeof(MetaWord));
+        if (kept_words >= FreeBlocks::MinWordSize) {
+          blocks[first_tail]._word_size = kept_words;
+        }
+      }
+
+      reclaimed_words += c->committed_words() - new_used_words;
+      released_used_words += c->used_words() - new_used_words;
+
+      if (c->word_size() >= Settings::commit_granule_words()) {
+        MutexLocker fcl(Metaspace_lock, Mutex::_no_safepoint_check_flag);
+        c->uncommit_tail_locked(new_used_words);
+      }
+      if (new_used_words == 0) {
+        UL2(debug, "returning fully deallocated chunk " METACHUNK_FORMAT ".", METACHUNK_FORMAT_ARGS(c));
+        _chunks.remove(c);
+        _chunk_manager->return_chunk(c);
+        // c may be invalid after return_chunk(c) was called. Don't access anymore.
+        num_chunks_returned++;
+      } else {
+        UL2(debug, "uncommitted free tail of chunk " METACHUNK_FULL_FORMAT ".", METACHUNK_FULL_FORMAT_ARGS(c));
+        num_tails_uncommitted++;
+      }
+    }
+    c = next;
+  }
+
+  if (released_used_words > 0) {
+    // Rebuild the free block list from the blocks which are left.
+    delete _fbl;
+    _fbl = nullptr;
+    for (int i = 0; i < num_blocks; i++) {
+      if (blocks[i]._word_size > 0) {
+        add_allocation_to_fbl(blocks[i]._p, blocks[i]._word_size);
+      }
+    }
+    _total_used_words_counter->decrement_by(released_used_words);
+    UL2(info, "returned %d chunks, uncommitted %d chunk tails, reclaimed " SIZE_FORMAT " committed words.",
+        num_chunks_returned, num_tails_uncommitted, reclaimed_words);
+  }
+
+  SOMETIMES(verify();)
+  return reclaimed_words;
+}
+
 // Update statistics. This walks all in-use chunks.
 void MetaspaceArena::add_to_statistics(ArenaStats* out) const {
   for (const Metachunk* c = _chunks.first(); c != nullptr; c = c->next()) {
@@ -392,6 +541,21 @@ void MetaspaceArena::add_to_statistics(ArenaStats* out) const {
   if (_fbl != nullptr) {
     out->_free_blocks_num += _fbl->count();
     out->_free_blocks_word_size += _fbl->total_size();
+    if (!_fbl->is_empty()) {
+      // See reclaim_free_chunks().
+      ResourceMark rm;
+      int num_blocks = 0;
+      const FreeRange* const blocks = collect_free_blocks(_fbl, &num_blocks);
+      for (const Metachunk* c = current_chunk()->next(); c != nullptr; c = c->next()) {
+        const int from = find_free_block(blocks, num_blocks, c->base());
+        const int to = find_free_block(blocks, num_blocks, c->top());
+        int first_tail = to;
+        const size_t new_used_words = reclaimable_used_words(c, blocks, from, to, &first_tail);
+        if (new_used_words < c->used_words()) {
+          out->_reclaimable_words += c->committed_words() - new_used_words;
+        }
+      }
+    }
   }
 
   SOMETIMES(out->verify();)
@@ -171,6 +171,13 @@ class MetaspaceArena : public CHeapObj<mtClass> {
   // needed anymore.
   void deallocate(MetaWord* p, size_t word_size);
 
+  // Give back memory of retired chunks which has entirely been deallocated:
+  //  chunks whose used area is covered by free blocks are returned to the chunk
+  //  manager, and free tails of retired chunks spanning at least one commit granule
+  //  are uncommitted. Live metadata is never moved. Returns the number of committed
+  //  words given back (requires CLD lock to be active).
+  size_t reclaim_free_chunks();
+
   // Update statistics. This walks all in-use chunks.
   void add_to_statistics(ArenaStats* out) const;
 
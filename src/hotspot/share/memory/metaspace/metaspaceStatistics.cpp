@@ -139,6 +139,7 @@ void ArenaStats::add(const ArenaStats& other) {
   }
   _free_blocks_num += other._free_blocks_num;
   _free_blocks_word_size += other._free_blocks_word_size;
+  _reclaimable_words += other._reclaimable_words;
 }
 
 // Returns total chunk statistics over all chunk types.
@@ -176,12 +177,16 @@ void ArenaStats::print_on(outputStream* st, size_t scale,  bool detailed) const
       st->cr_indent();
       st->print("deallocated: " UINTX_FORMAT " blocks with ", _free_blocks_num);
       print_scaled_words(st, _free_blocks_word_size, scale);
+      st->print(", reclaimable: ");
+      print_scaled_words(st, _reclaimable_words, scale);
     }
   } else {
     totals().print_on(st, scale);
     st->print(", ");
     st->print("deallocated: " UINTX_FORMAT " blocks with ", _free_blocks_num);
     print_scaled_words(st, _free_blocks_word_size, scale);
+    st->print(", reclaimable: ");
+    print_scaled_words(st, _reclaimable_words, scale);
   }
 }
 
@@ -124,11 +124,15 @@ struct  ArenaStats {
   InUseChunkStats _stats[chunklevel::NUM_CHUNK_LEVELS];
   uintx _free_blocks_num;
   size_t _free_blocks_word_size;
+  // committed words in retired chunks which are covered by deallocated blocks,
+  // and which MetaspaceArena::reclaim_free_chunks() could give back
+  size_t _reclaimable_words;
 
   ArenaStats() :
     _stats(),
     _free_blocks_num(0),
-    _free_blocks_word_size(0)
+    _free_blocks_word_size(0),
+    _reclaimable_words(0)
   {}
 
   void add(const ArenaStats& other);
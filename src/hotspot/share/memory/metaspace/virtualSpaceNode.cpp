@@ -113,6 +113,11 @@ bool VirtualSpaceNode::commit_range(MetaWord* p, size_t word_size) {
     vm_exit_out_of_memory(word_size * BytesPerWord, OOM_MMAP_ERROR, "Failed to commit metaspace.");
   }
 
+  // Only the class space node is set up over a space reserved elsewhere.
+  if (_owns_rs ? MetaspaceLargePages : ClassSpaceLargePages) {
+    os::realign_memory((char*)p, word_size * BytesPerWord, os::large_page_size());
+  }
+
   if (AlwaysPreTouch) {
     os::pretouch_memory(p, p + word_size);
   }
@@ -30,6 +30,7 @@
 #include "cds/metaspaceShared.hpp"
 #include "classfile/classLoader.hpp"
 #include "classfile/classLoaderDataGraph.hpp"
+#include "classfile/fieldLayoutProfile.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
@@ -44,6 +45,7 @@
 #include "gc/shared/gcConfig.hpp"
 #include "gc/shared/gcLogPrecious.hpp"
 #include "gc/shared/gcTraceTime.inline.hpp"
+#include "gc/shared/gcWorkerTimeline.hpp"
 #include "gc/shared/oopStorageSet.hpp"
 #include "gc/shared/plab.hpp"
 #include "gc/shared/stringdedup/stringDedup.hpp"
@@ -846,6 +848,7 @@ jint universe_init() {
   initialize_global_behaviours();
 
   GCLogPrecious::initialize();
+  GCWorkerTimeline::initialize();
 
   // Initialize CPUTimeCounters object, which must be done before creation of the heap.
   CPUTimeCounters::initialize();
@@ -889,6 +892,7 @@ jint universe_init() {
 
   SymbolTable::create_table();
   StringTable::create_table();
+  FieldLayoutProfile::load();
 
   if (strlen(VerifySubSet) > 0) {
     Universe::initialize_verify_flags();
@@ -41,8 +41,8 @@ class MallocSite : public AllocationSite {
   MallocSite(const NativeCallStack& stack, MEMFLAGS flags) :
     AllocationSite(stack, flags) {}
 
-  void allocate(size_t size)      { _c.allocate(size);   }
-  void deallocate(size_t size)    { _c.deallocate(size); }
+  void allocate(size_t size, size_t count = 1)   { _c.allocate(size, count);   }
+  void deallocate(size_t size, size_t count = 1) { _c.deallocate(size, count); }
 
   // Memory allocated from this code path
   size_t size()  const { return _c.size(); }
@@ -122,6 +122,11 @@ class MallocSiteTable : AllStatic {
   static uint16_t bucket_idx_from_marker(uint32_t marker) { return (uint16_t)(marker >> 16); }
   static uint16_t pos_idx_from_marker(uint32_t marker) { return marker & 0xFFFF; }
 
+ public:
+  // Marker of blocks whose allocation was not sampled and is not recorded
+  // in this table, see MallocStackSampler. Never built by build_marker().
+  static const uint32_t unsampled_marker = UINT32_MAX;
+
  public:
 
   static bool initialize();
@@ -132,6 +137,9 @@ class MallocSiteTable : AllStatic {
   // Access and copy a call stack from this table. Shared lock should be
   // acquired before access the entry.
   static inline bool access_stack(NativeCallStack& stack, const MallocHeader& header) {
+    if (header.mst_marker() == unsampled_marker) {
+      return false;
+    }
     MallocSite* site = malloc_site(header.mst_marker());
     if (site != nullptr) {
       stack = *site->call_stack();
@@ -146,19 +154,23 @@ class MallocSiteTable : AllStatic {
   // Return false only occurs under rare scenarios:
   //  1. out of memory
   //  2. overflow hash bucket
+  // A sampled allocation is recorded as count allocations of size bytes in total.
   static inline bool allocation_at(const NativeCallStack& stack, size_t size,
-      uint32_t* marker, MEMFLAGS flags) {
+      uint32_t* marker, MEMFLAGS flags, size_t count = 1) {
     MallocSite* site = lookup_or_add(stack, marker, flags);
-    if (site != nullptr) site->allocate(size);
+    if (site != nullptr) site->allocate(size, count);
     return site != nullptr;
   }
 
   // Record memory deallocation. marker indicates where the allocation
   // information was recorded.
-  static inline bool deallocation_at(size_t size, uint32_t marker) {
+  static inline bool deallocation_at(size_t size, uint32_t marker, size_t count = 1) {
+    if (marker == unsampled_marker) {
+      return false;
+    }
     MallocSite* site = malloc_site(marker);
     if (site != nullptr) {
-      site->deallocate(size);
+      site->deallocate(size, count);
       return true;
     }
     return false;
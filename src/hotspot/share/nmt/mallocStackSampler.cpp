@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "nmt/mallocStackSampler.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/os.hpp"
+
+#include <math.h>
+
+size_t MallocStackSampler::_interval = 0;
+THREAD_LOCAL size_t MallocStackSampler::_bytes_until_sample = 0;
+THREAD_LOCAL unsigned int MallocStackSampler::_seed = 0;
+THREAD_LOCAL bool MallocStackSampler::_pending = false;
+
+void MallocStackSampler::initialize() {
+  _interval = NMTDetailSamplingInterval;
+}
+
+size_t MallocStackSampler::pick_next_sample() {
+  if (_seed == 0) {
+    _seed = (unsigned int)(p2i(&_seed) >> 4) | 1;
+  }
+  _seed = (unsigned int)os::next_random(_seed);
+  // next_random() returns values in [1, 2^31 - 2], so u is in (0, 1).
+  double u = (double)_seed / (double)max_jint;
+  double next = -log(u) * (double)_interval;
+  return MAX2((size_t)1, (size_t)next);
+}
+
+bool MallocStackSampler::should_sample_slow(size_t size) {
+  if (_bytes_until_sample == 0) {
+    // First malloc of this thread.
+    _bytes_until_sample = pick_next_sample();
+    if (_bytes_until_sample > size) {
+      _bytes_until_sample -= size;
+      return false;
+    }
+  }
+  _bytes_until_sample = pick_next_sample();
+  return true;
+}
+
+double MallocStackSampler::inverse_probability(size_t size) {
+  assert(is_enabled(), "must be");
+  double p = 1.0 - exp(-(double)MAX2((size_t)1, size) / (double)_interval);
+  return 1.0 / p;
+}
+
+size_t MallocStackSampler::scaled_size(size_t size) {
+  if (!is_enabled()) {
+    return size;
+  }
+  return (size_t)((double)size * inverse_probability(size));
+}
+
+size_t MallocStackSampler::scaled_count(size_t size) {
+  if (!is_enabled()) {
+    return 1;
+  }
+  return MAX2((size_t)1, (size_t)(inverse_probability(size) + 0.5));
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_NMT_MALLOCSTACKSAMPLER_HPP
+#define SHARE_NMT_MALLOCSTACKSAMPLER_HPP
+
+#include "memory/allStatic.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+// Decides which mallocs get their call stacks recorded in NMT detail mode
+// when NMTDetailSamplingInterval is set. Like ThreadHeapSampler, the
+// distance between samples is taken from an exponential distribution with
+// the interval as mean, so every byte is sampled with the same probability.
+// The malloc sites of sampled mallocs are credited with the estimated size
+// and number of all mallocs the sample stands for.
+//
+// The main malloc entry points decide before walking the stack, using
+// CALLER_PC_SAMPLED, and leave the decision for MallocTracker. Stacks
+// passed in from elsewhere are sampled when the malloc is recorded.
+class MallocStackSampler : AllStatic {
+  static size_t _interval;
+
+  static THREAD_LOCAL size_t _bytes_until_sample;
+  static THREAD_LOCAL unsigned int _seed;
+  static THREAD_LOCAL bool _pending;
+
+  static size_t pick_next_sample();
+  static bool should_sample_slow(size_t size);
+  static double inverse_probability(size_t size);
+
+ public:
+  static void initialize();
+
+  static bool is_enabled() { return _interval > 0; }
+
+  // Returns true if a malloc of size bytes should record its call stack.
+  static inline bool should_sample(size_t size) {
+    if (!is_enabled()) {
+      return true;
+    }
+    if (_bytes_until_sample > size) {
+      _bytes_until_sample -= size;
+      return false;
+    }
+    return should_sample_slow(size);
+  }
+
+  // As should_sample(), and remember a positive decision for take_pending().
+  static inline bool pick(size_t size) {
+    bool sampled = should_sample(size);
+    _pending = sampled && is_enabled();
+    return sampled;
+  }
+
+  // Returns and clears the decision left by pick().
+  static inline bool take_pending() {
+    bool pending = _pending;
+    _pending = false;
+    return pending;
+  }
+
+  // The estimated size and number of mallocs a sample of size bytes stands for.
+  static size_t scaled_size(size_t size);
+  static size_t scaled_count(size_t size);
+};
+
+#endif // SHARE_NMT_MALLOCSTACKSAMPLER_HPP
@@ -32,6 +32,7 @@
 #include "nmt/mallocHeader.inline.hpp"
 #include "nmt/mallocLimit.hpp"
 #include "nmt/mallocSiteTable.hpp"
+#include "nmt/mallocStackSampler.hpp"
 #include "nmt/mallocTracker.hpp"
 #include "nmt/memTracker.hpp"
 #include "runtime/arguments.hpp"
@@ -46,6 +47,11 @@
 #include "utilities/globalDefinitions.hpp"
 
 MallocMemorySnapshot MallocMemorySummary::_snapshot;
+bool MallocMemorySummary::_striped = false;
+ATTRIBUTE_ALIGNED(DEFAULT_PADDING_SIZE)
+PaddedEnd<MallocCounterStripe> MallocMemorySummary::_stripes[MallocMemorySummary::StripeCount];
+volatile uint MallocMemorySummary::_next_stripe = 0;
+THREAD_LOCAL uint MallocMemorySummary::_stripe_plus_one = 0;
 
 void MemoryCounter::update_peak(size_t size, size_t cnt) {
   size_t peak_sz = peak_size();
@@ -99,6 +105,50 @@ void MallocMemorySnapshot::make_adjustment() {
 void MallocMemorySummary::initialize() {
   // Uses placement new operator to initialize static area.
   MallocLimitHandler::initialize(MallocLimit);
+  // MallocLimit checks the totals on every allocation, which would need
+  // the stripes to be folded every time.
+  if (NMTStripedMallocCounters) {
+    if (MallocLimitHandler::have_limit()) {
+      log_info(nmt)("MallocLimit is set, not using striped malloc counters");
+    } else {
+      _striped = true;
+    }
+  }
+}
+
+uint MallocMemorySummary::assign_stripe() {
+  // Hand out the stripes round-robin, so threads started close together
+  // don't collide.
+  uint s = (Atomic::fetch_then_add(&_next_stripe, 1u, memory_order_relaxed) % StripeCount) + 1;
+  _stripe_plus_one = s;
+  return s;
+}
+
+void MallocMemorySummary::fold_stripes() {
+  if (!_striped) {
+    return;
+  }
+  ThreadCritical tc;
+  size_t total_size = 0;
+  size_t total_count = 0;
+  for (int index = 0; index < mt_number_of_types; index ++) {
+    size_t size = 0;
+    size_t count = 0;
+    for (uint s = 0; s < StripeCount; s++) {
+      size += Atomic::load(&_stripes[s]._size[index]);
+      count += Atomic::load(&_stripes[s]._count[index]);
+    }
+    // A free counted before its malloc in another stripe may make the
+    // sum transiently wrap around.
+    if (ssize_t(size) < 0 || ssize_t(count) < 0) {
+      size = 0;
+      count = 0;
+    }
+    _snapshot._malloc[index].set_malloc_size_and_count(size, count);
+    total_size += size;
+    total_count += count;
+  }
+  _snapshot._all_mallocs.set_size_and_count(total_size, total_count);
 }
 
 bool MallocMemorySummary::total_limit_reached(size_t s, size_t so_far, const malloclimit* limit) {
@@ -161,6 +211,7 @@ bool MallocTracker::initialize(NMT_TrackingLevel level) {
   }
 
   if (level == NMT_detail) {
+    MallocStackSampler::initialize();
     return MallocSiteTable::initialize();
   }
   return true;
@@ -176,7 +227,16 @@ void* MallocTracker::record_malloc(void* malloc_base, size_t size, MEMFLAGS flag
   MallocMemorySummary::record_malloc(size, flags);
   uint32_t mst_marker = 0;
   if (MemTracker::tracking_level() == NMT_detail) {
-    MallocSiteTable::allocation_at(stack, size, &mst_marker, flags);
+    if (!MallocStackSampler::is_enabled()) {
+      MallocSiteTable::allocation_at(stack, size, &mst_marker, flags);
+    } else if (MallocStackSampler::take_pending() ||
+               (!stack.is_empty() && MallocStackSampler::should_sample(size))) {
+      // An empty stack means CALLER_PC_SAMPLED did not pick this malloc.
+      MallocSiteTable::allocation_at(stack, MallocStackSampler::scaled_size(size), &mst_marker,
+                                     flags, MallocStackSampler::scaled_count(size));
+    } else {
+      mst_marker = MallocSiteTable::unsampled_marker;
+    }
   }
 
   // Uses placement global new operator to initialize malloc header
@@ -215,7 +275,8 @@ void* MallocTracker::record_free_block(void* memblock) {
 void MallocTracker::deaccount(MallocHeader::FreeInfo free_info) {
   MallocMemorySummary::record_free(free_info.size, free_info.flags);
   if (MemTracker::tracking_level() == NMT_detail) {
-    MallocSiteTable::deallocation_at(free_info.size, free_info.mst_marker);
+    MallocSiteTable::deallocation_at(MallocStackSampler::scaled_size(free_info.size), free_info.mst_marker,
+                                     MallocStackSampler::scaled_count(free_info.size));
   }
 }
 
@@ -29,6 +29,7 @@
 #include "nmt/mallocHeader.hpp"
 #include "nmt/memflags.hpp"
 #include "nmt/nmtCommon.hpp"
+#include "memory/padded.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/threadCritical.hpp"
 #include "utilities/nativeCallStack.hpp"
@@ -61,18 +62,18 @@ class MemoryCounter {
     update_peak(size, count);
   }
 
-  inline void allocate(size_t sz) {
-    size_t cnt = Atomic::add(&_count, size_t(1), memory_order_relaxed);
+  inline void allocate(size_t sz, size_t n = 1) {
+    size_t cnt = Atomic::add(&_count, n, memory_order_relaxed);
     if (sz > 0) {
       size_t sum = Atomic::add(&_size, sz, memory_order_relaxed);
       update_peak(sum, cnt);
     }
   }
 
-  inline void deallocate(size_t sz) {
-    assert(count() > 0, "Nothing allocated yet");
+  inline void deallocate(size_t sz, size_t n = 1) {
+    assert(count() >= n, "Nothing allocated yet");
     assert(size() >= sz, "deallocation > allocated");
-    Atomic::dec(&_count, memory_order_relaxed);
+    Atomic::sub(&_count, n, memory_order_relaxed);
     if (sz > 0) {
       Atomic::sub(&_size, sz, memory_order_relaxed);
     }
@@ -131,6 +132,10 @@ class MallocMemory {
     _arena.resize(sz);
   }
 
+  inline void set_malloc_size_and_count(size_t size, size_t count) {
+    _malloc.set_size_and_count(size, count);
+  }
+
   inline size_t malloc_size()  const { return _malloc.size(); }
   inline size_t malloc_peak_size()  const { return _malloc.peak_size(); }
   inline size_t malloc_count() const { return _malloc.count();}
@@ -199,6 +204,32 @@ class MallocMemorySnapshot {
   void make_adjustment();
 };
 
+/*
+ * Malloc counters of one stripe, used instead of the shared counters of
+ * the snapshot when NMTStripedMallocCounters is enabled. A block may be
+ * freed through a different stripe than it was allocated through, so
+ * a single stripe may wrap around; only the sum over all stripes is
+ * meaningful.
+ */
+class MallocCounterStripe {
+  friend class MallocMemorySummary;
+
+ private:
+  volatile size_t _size[mt_number_of_types];
+  volatile size_t _count[mt_number_of_types];
+
+ public:
+  inline void record_malloc(size_t sz, int index) {
+    Atomic::add(&_count[index], size_t(1), memory_order_relaxed);
+    Atomic::add(&_size[index], sz, memory_order_relaxed);
+  }
+
+  inline void record_free(size_t sz, int index) {
+    Atomic::sub(&_count[index], size_t(1), memory_order_relaxed);
+    Atomic::sub(&_size[index], sz, memory_order_relaxed);
+  }
+};
+
 /*
  * This class is for collecting malloc statistics at summary level
  */
@@ -208,6 +239,22 @@ class MallocMemorySummary : AllStatic {
   static MallocMemorySnapshot _snapshot;
   static bool _have_limits;
 
+  // Striped malloc counters, see MallocCounterStripe.
+  static const uint StripeCount = 16;
+  static bool _striped;
+  static PaddedEnd<MallocCounterStripe> _stripes[StripeCount];
+  static volatile uint _next_stripe;
+  static THREAD_LOCAL uint _stripe_plus_one;
+
+  static uint assign_stripe();
+  static inline MallocCounterStripe* current_stripe() {
+    uint s = _stripe_plus_one;
+    if (s == 0) {
+      s = assign_stripe();
+    }
+    return &_stripes[s - 1];
+  }
+
   // Called when a total limit break was detected.
   // Will return true if the limit was handled, false if it was ignored.
   static bool total_limit_reached(size_t s, size_t so_far, const malloclimit* limit);
@@ -220,11 +267,19 @@ class MallocMemorySummary : AllStatic {
    static void initialize();
 
    static inline void record_malloc(size_t size, MEMFLAGS flag) {
+     if (_striped) {
+       current_stripe()->record_malloc(size, NMTUtil::flag_to_index(flag));
+       return;
+     }
      as_snapshot()->by_type(flag)->record_malloc(size);
      as_snapshot()->_all_mallocs.allocate(size);
    }
 
    static inline void record_free(size_t size, MEMFLAGS flag) {
+     if (_striped) {
+       current_stripe()->record_free(size, NMTUtil::flag_to_index(flag));
+       return;
+     }
      as_snapshot()->by_type(flag)->record_free(size);
      as_snapshot()->_all_mallocs.deallocate(size);
    }
@@ -241,13 +296,19 @@ class MallocMemorySummary : AllStatic {
      as_snapshot()->by_type(flag)->record_arena_size_change(size);
    }
 
+   // Fold the striped malloc counters into the snapshot. The peak values
+   // then only reflect the totals seen at the times the stripes were folded.
+   static void fold_stripes();
+
    static void snapshot(MallocMemorySnapshot* s) {
+     fold_stripes();
      as_snapshot()->copy_to(s);
      s->make_adjustment();
    }
 
    // The memory used by malloc tracking headers
    static inline size_t tracking_overhead() {
+     fold_stripes();
      return as_snapshot()->malloc_overhead();
    }
 
@@ -25,12 +25,14 @@
 #include "cds/filemap.hpp"
 #include "memory/metaspace.hpp"
 #include "memory/metaspaceUtils.hpp"
+#include "nmt/mallocStackSampler.hpp"
 #include "nmt/mallocTracker.hpp"
 #include "nmt/memflags.hpp"
 #include "nmt/memReporter.hpp"
 #include "nmt/memoryFileTracker.hpp"
 #include "nmt/threadStackTracker.hpp"
 #include "nmt/virtualMemoryTracker.hpp"
+#include "runtime/globals.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/ostream.hpp"
@@ -310,6 +312,10 @@ void MemDetailReporter::report_detail() {
   // Start detail report
   outputStream* out = output();
   out->print_cr("Details:\n");
+  if (MallocStackSampler::is_enabled()) {
+    out->print_cr("(Malloc call sites are estimated from samples taken every " SIZE_FORMAT " bytes on average.)\n",
+                  NMTDetailSamplingInterval);
+  }
 
   int num_omitted =
       report_malloc_sites() +
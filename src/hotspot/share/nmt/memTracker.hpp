@@ -25,6 +25,7 @@
 #ifndef SHARE_NMT_MEMTRACKER_HPP
 #define SHARE_NMT_MEMTRACKER_HPP
 
+#include "nmt/mallocStackSampler.hpp"
 #include "nmt/mallocTracker.hpp"
 #include "nmt/nmtCommon.hpp"
 #include "nmt/memoryFileTracker.hpp"
@@ -39,6 +40,12 @@
                     NativeCallStack(0) : FAKE_CALLSTACK)
 #define CALLER_PC  ((MemTracker::tracking_level() == NMT_detail) ?  \
                     NativeCallStack(1) : FAKE_CALLSTACK)
+// As CALLER_PC, for a malloc of the given size. Only walks the stack if
+// the malloc is picked as sample, see MallocStackSampler.
+#define CALLER_PC_SAMPLED(size)                                     \
+                   ((MemTracker::tracking_level() == NMT_detail &&  \
+                     MallocStackSampler::pick(size)) ?              \
+                    NativeCallStack(1) : FAKE_CALLSTACK)
 
 class MemBaseline;
 
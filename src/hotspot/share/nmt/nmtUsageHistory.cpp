@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "logging/log.hpp"
+#include "nmt/memTracker.hpp"
+#include "nmt/nmtUsageHistory.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/task.hpp"
+
+NMTUsageHistory::Sample* NMTUsageHistory::_samples = nullptr;
+uint NMTUsageHistory::_capacity = 0;
+uint NMTUsageHistory::_count = 0;
+NMTUsage* NMTUsageHistory::_usage = nullptr;
+
+class NMTUsageHistoryTask : public PeriodicTask {
+ public:
+  NMTUsageHistoryTask(size_t interval) : PeriodicTask(interval) {}
+  void task() {
+    NMTUsageHistory::take_sample();
+  }
+};
+
+void NMTUsageHistory::initialize() {
+  if (!MemTracker::enabled() || NMTUsageHistoryInterval == 0) {
+    return;
+  }
+  // PeriodicTask intervals are limited and have a granularity.
+  size_t interval = align_down(clamp((size_t)NMTUsageHistoryInterval,
+                                     (size_t)PeriodicTask::min_interval,
+                                     (size_t)PeriodicTask::max_interval),
+                               (size_t)PeriodicTask::interval_gran);
+  _usage = new NMTUsage(NMTUsage::OptionsNoTS);
+  _capacity = NMTUsageHistorySize;
+  _samples = NEW_C_HEAP_ARRAY(Sample, _capacity, mtNMT);
+  log_info(nmt)("Sampling native memory usage every " SIZE_FORMAT " ms, keeping %u samples",
+                interval, _capacity);
+  take_sample();
+  NMTUsageHistoryTask* task = new NMTUsageHistoryTask(interval);
+  task->enroll();
+}
+
+void NMTUsageHistory::take_sample() {
+  // Refreshing takes ThreadCritical, so do it before taking the lock.
+  _usage->refresh();
+  Ticks now = Ticks::now();
+
+  MutexLocker ml(NMTUsageHistory_lock, Mutex::_no_safepoint_check_flag);
+  Sample* s = &_samples[_count % _capacity];
+  s->_time = now;
+  for (int index = 0; index < mt_number_of_types; index++) {
+    MEMFLAGS flag = NMTUtil::index_to_flag(index);
+    s->_usage[index].reserved = _usage->reserved(flag);
+    s->_usage[index].committed = _usage->committed(flag);
+  }
+  _count++;
+}
+
+bool NMTUsageHistory::growth(MEMFLAGS flag, NMTUsagePair* usage,
+                             double* reserved_rate, double* committed_rate,
+                             Tickspan* window) {
+  if (!is_enabled()) {
+    return false;
+  }
+  MutexLocker ml(NMTUsageHistory_lock, Mutex::_no_safepoint_check_flag);
+  if (_count < 2) {
+    return false;
+  }
+  const int index = NMTUtil::flag_to_index(flag);
+  const Sample* newest = &_samples[(_count - 1) % _capacity];
+  const Sample* oldest = &_samples[_count > _capacity ? _count % _capacity : 0];
+  const Tickspan span = newest->_time - oldest->_time;
+  const double seconds = span.seconds();
+  if (seconds <= 0.0) {
+    return false;
+  }
+  const NMTUsagePair& now = newest->_usage[index];
+  const NMTUsagePair& then = oldest->_usage[index];
+  *usage = now;
+  *reserved_rate = ((double)now.reserved - (double)then.reserved) / seconds;
+  *committed_rate = ((double)now.committed - (double)then.committed) / seconds;
+  *window = span;
+  return true;
+}
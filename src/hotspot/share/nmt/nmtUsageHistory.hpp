@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_NMT_NMTUSAGEHISTORY_HPP
+#define SHARE_NMT_NMTUSAGEHISTORY_HPP
+
+#include "memory/allStatic.hpp"
+#include "nmt/memflags.hpp"
+#include "nmt/nmtUsage.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/ticks.hpp"
+
+class NMTUsageHistoryTask;
+
+// A ring buffer of the native memory usage per memory type, sampled by
+// the WatcherThread every NMTUsageHistoryInterval milliseconds. Growth
+// rates over the last NMTUsageHistorySize samples can be read from it at
+// any time, without safepoints or baselines.
+class NMTUsageHistory : AllStatic {
+  friend class NMTUsageHistoryTask;
+
+  struct Sample {
+    Ticks _time;
+    NMTUsagePair _usage[mt_number_of_types];
+  };
+
+  static Sample* _samples;
+  static uint _capacity;
+  // Number of samples taken so far, the newest is at (_count - 1) % _capacity.
+  static uint _count;
+  // Only used by the WatcherThread.
+  static NMTUsage* _usage;
+
+  static void take_sample();
+
+ public:
+  // Starts sampling if NMT and NMTUsageHistoryInterval are on.
+  static void initialize();
+
+  static bool is_enabled() { return _samples != nullptr; }
+
+  // Returns the newest sampled usage of flag and the growth of its reserved
+  // and committed memory in bytes per second since the oldest sample.
+  // Returns false if fewer than two samples have been taken.
+  static bool growth(MEMFLAGS flag, NMTUsagePair* usage,
+                     double* reserved_rate, double* committed_rate,
+                     Tickspan* window);
+};
+
+#endif // SHARE_NMT_NMTUSAGEHISTORY_HPP
@@ -401,9 +401,7 @@ void ConstantPoolCache::remove_unshareable_info() {
   assert(CDSConfig::is_dumping_archive(), "sanity");
 
   if (_resolved_indy_entries != nullptr) {
-    for (int i = 0; i < _resolved_indy_entries->length(); i++) {
-      resolved_indy_entry_at(i)->remove_unshareable_info();
-    }
+    remove_resolved_indy_entries();
   }
   if (_resolved_field_entries != nullptr) {
     remove_resolved_field_entries_if_non_deterministic();
@@ -413,6 +411,30 @@ void ConstantPoolCache::remove_unshareable_info() {
   }
 }
 
+// Resolved indy entries are always reverted: their CallSite targets and
+// appendices live in the resolved references, which are not archived.
+void ConstantPoolCache::remove_resolved_indy_entries() {
+  ConstantPool* cp = constant_pool();
+  for (int i = 0; i < _resolved_indy_entries->length(); i++) {
+    ResolvedIndyEntry* rie = resolved_indy_entry_at(i);
+    bool resolved = rie->is_resolved();
+    if (resolved) {
+      LogStreamHandle(Trace, cds, resolve) log;
+      if (log.is_enabled()) {
+        ResourceMark rm;
+        int cp_index = rie->constant_pool_index();
+        Symbol* name = cp->uncached_name_ref_at(cp_index);
+        Symbol* signature = cp->uncached_signature_ref_at(cp_index);
+        log.print("reverted indy   CP entry [%3d]: %s %s:%s",
+                  cp_index, cp->pool_holder()->name()->as_C_string(),
+                  name->as_C_string(), signature->as_C_string());
+      }
+    }
+    rie->remove_unshareable_info();
+    ArchiveBuilder::alloc_stats()->record_indy_cp_entry(false, resolved);
+  }
+}
+
 void ConstantPoolCache::remove_resolved_field_entries_if_non_deterministic() {
   ConstantPool* cp = constant_pool();
   ConstantPool* src_cp =  ArchiveBuilder::current()->get_source_addr(cp);
@@ -496,14 +518,6 @@ void ConstantPoolCache::remove_resolved_method_entries_if_non_deterministic() {
 }
 
 bool ConstantPoolCache::can_archive_resolved_method(ResolvedMethodEntry* method_entry) {
-  InstanceKlass* pool_holder = constant_pool()->pool_holder();
-  if (!(pool_holder->is_shared_boot_class() || pool_holder->is_shared_platform_class() ||
-        pool_holder->is_shared_app_class())) {
-    // Archiving resolved cp entries for classes from non-builtin loaders
-    // is not yet supported.
-    return false;
-  }
-
   if (CDSConfig::is_dumping_dynamic_archive()) {
     // InstanceKlass::methods() has been resorted. We need to
     // update the vtable_index in method_entry (not implemented)
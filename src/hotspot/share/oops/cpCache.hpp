@@ -223,6 +223,7 @@ class ConstantPoolCache: public MetaspaceObj {
 #endif // INCLUDE_JVMTI
 
 #if INCLUDE_CDS
+  void remove_resolved_indy_entries();
   void remove_resolved_field_entries_if_non_deterministic();
   void remove_resolved_method_entries_if_non_deterministic();
   bool can_archive_resolved_method(ResolvedMethodEntry* method_entry);
@@ -2366,8 +2366,8 @@ void InstanceKlass::mark_dependent_nmethods(DeoptimizationScope* deopt_scope, Kl
   dependencies().mark_dependent_nmethods(deopt_scope, changes);
 }
 
-void InstanceKlass::add_dependent_nmethod(nmethod* nm) {
-  dependencies().add_dependent_nmethod(nm);
+void InstanceKlass::add_dependent_nmethod(nmethod* nm, int dep_type) {
+  dependencies().add_dependent_nmethod(nm, dep_type);
 }
 
 void InstanceKlass::clean_dependency_context() {
@@ -673,6 +673,10 @@ class InstanceKlass: public Klass {
   bool has_contended_annotations() const { return _misc_flags.has_contended_annotations(); }
   void set_has_contended_annotations(bool value)  { _misc_flags.set_has_contended_annotations(value); }
 
+  // Instances have fields listed in DeduplicateByteArrayFields
+  bool has_dedup_array_fields() const { return _misc_flags.has_dedup_array_fields(); }
+  void set_has_dedup_array_fields(bool value) { _misc_flags.set_has_dedup_array_fields(value); }
+
 #if INCLUDE_JVMTI
   // Redefinition locking.  Class can only be redefined by one thread at a time.
   // The flag is in access_flags so that it can be set and reset using atomic
@@ -832,7 +836,7 @@ class InstanceKlass: public Klass {
   // maintenance of deoptimization dependencies
   inline DependencyContext dependencies();
   void mark_dependent_nmethods(DeoptimizationScope* deopt_scope, KlassDepChange& changes);
-  void add_dependent_nmethod(nmethod* nm);
+  void add_dependent_nmethod(nmethod* nm, int dep_type);
   void clean_dependency_context();
   // Setup link to hierarchy and deoptimize
   void add_to_hierarchy(JavaThread* current);
@@ -170,17 +170,93 @@ bool Klass::search_secondary_supers(Klass* k) const {
   // This is necessary, since I am never in my own secondary_super list.
   if (this == k)
     return true;
+
+  if (UseSecondarySupersTable) {
+    // The hashed lookup is constant time in the common case, so the
+    // secondary_super_cache is not updated: threads checking different
+    // interfaces against the same klass would keep overwriting it.
+    bool result = lookup_secondary_supers_table(k);
+    if (VerifySecondarySupers) {
+      bool linear_result = linear_search_secondary_supers(k);
+      if (linear_result != result) {
+        on_secondary_supers_verification_failure(k, (Klass*)this, linear_result, result, "mismatch");
+      }
+    }
+    return result;
+  }
+
+  if (linear_search_secondary_supers(k)) {
+    ((Klass*)this)->set_secondary_super_cache(k);
+    return true;
+  }
+  return false;
+}
+
+bool Klass::linear_search_secondary_supers(const Klass* k) const {
   // Scan the array-of-objects for a match
   int cnt = secondary_supers()->length();
   for (int i = 0; i < cnt; i++) {
     if (secondary_supers()->at(i) == k) {
-      ((Klass*)this)->set_secondary_super_cache(k);
       return true;
     }
   }
   return false;
 }
 
+// Look up k in the hashed secondary supers, see hash_secondary_supers.
+// This is the same lookup as the one generated by
+// MacroAssembler::lookup_secondary_supers_table.
+bool Klass::lookup_secondary_supers_table(Klass* k) const {
+  uintx bitmap = _bitmap;
+  if (bitmap == SECONDARY_SUPERS_BITMAP_FULL) {
+    // The secondary supers are not hashed.
+    return linear_search_secondary_supers(k);
+  }
+
+  constexpr int highest_bit_number = SECONDARY_SUPERS_TABLE_SIZE - 1;
+  uint8_t slot = k->_hash_slot;
+  uintx shifted_bitmap = bitmap << (highest_bit_number - slot);
+
+  // If the bit of the home slot of k is zero, k is certainly not one of
+  // the secondary supers.
+  if (((shifted_bitmap >> highest_bit_number) & 1) == 0) {
+    return false;
+  }
+
+  // The number of entries up to and including the home slot is one more
+  // than the index of the first entry to probe.
+  int index = population_count(shifted_bitmap) - 1;
+  if (secondary_supers()->at(index) == k) {
+    return true;
+  }
+
+  // Rotate the bitmap so that Bit 1 tells whether there is another entry
+  // to probe.
+  uintx rotated_bitmap = rotate_right(bitmap, slot);
+  if ((rotated_bitmap & 2) == 0) {
+    return false;
+  }
+  return fallback_search_secondary_supers(k, index, rotated_bitmap);
+}
+
+bool Klass::fallback_search_secondary_supers(const Klass* k, int index, uintx rotated_bitmap) const {
+  // This is conventional linear probing, but instead of terminating when
+  // a null entry is found in the table, we stop at the first 0 in the
+  // bitmap. The bitmap is not full, so the loop eventually terminates.
+  assert(rotated_bitmap != SECONDARY_SUPERS_BITMAP_FULL, "must be hashed");
+  const int length = secondary_supers()->length();
+  while ((rotated_bitmap & 2) != 0) {
+    if (++index == length) {
+      index = 0;
+    }
+    if (secondary_supers()->at(index) == k) {
+      return true;
+    }
+    rotated_bitmap = rotate_right(rotated_bitmap, 1);
+  }
+  return false;
+}
+
 // Return self, except for abstract classes with exactly 1
 // implementor.  Then return the 1 concrete implementation.
 Klass *Klass::up_cast_abstract() {
@@ -428,6 +428,7 @@ class Klass : public Metadata {
   static ByteSize next_sibling_offset()          { return byte_offset_of(Klass, _next_sibling); }
 #endif
   static ByteSize bitmap_offset()                { return byte_offset_of(Klass, _bitmap); }
+  static ByteSize hash_slot_offset()             { return byte_offset_of(Klass, _hash_slot); }
 
   // Unpacking layout_helper:
   static const int _lh_neutral_value           = 0;  // neutral non-array non-instance value
@@ -542,6 +543,9 @@ class Klass : public Metadata {
   }
 
   bool search_secondary_supers(Klass* k) const;
+  bool lookup_secondary_supers_table(Klass* k) const;
+  bool linear_search_secondary_supers(const Klass* k) const;
+  bool fallback_search_secondary_supers(const Klass* k, int index, uintx rotated_bitmap) const;
 
   // Find LCA in class hierarchy
   Klass *LCA( Klass *k );
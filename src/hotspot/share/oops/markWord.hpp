@@ -26,6 +26,7 @@
 #define SHARE_OOPS_MARKWORD_HPP
 
 #include "metaprogramming/primitiveConversions.hpp"
+#include "oops/compressedKlass.hpp"
 #include "oops/oopsHierarchy.hpp"
 #include "runtime/globals.hpp"
 
@@ -43,6 +44,10 @@
 //  --------
 //  unused:25 hash:31 -->| unused_gap:1  age:4  unused_gap:1  lock:2 (normal object)
 //
+//  64 bits, with the narrow klass in the mark word:
+//  ------------------------------------------------
+//  klass:22 unused:3 hash:31 -->| unused_gap:1  age:4  unused_gap:1  lock:2 (normal object)
+//
 //  - hash contains the identity hash value: largest value is
 //    31 bits, see os::random().  Also, 64-bit vm's require
 //    a hash value no bigger than 32 bits because they will not
@@ -62,6 +67,13 @@
 //  - INFLATING() is a distinguished markword value of all zeros that is
 //    used when inflating an existing stack-lock into an ObjectMonitor.
 //    See below for is_being_inflated() and INFLATING().
+//
+//  - klass is only used by a header layout that stores the narrow klass
+//    in the mark word instead of in a separate field of the object. It is
+//    only valid for an unlocked or lightweight locked mark word, as a
+//    monitor or forwarding pointer replaces it. Its 22 bits require a
+//    narrow klass encoding with a large enough shift to cover the class
+//    space.
 
 class BasicLock;
 class ObjectMonitor;
@@ -130,6 +142,14 @@ class markWord {
 
   static const uint max_age                       = age_mask;
 
+#ifdef _LP64
+  static const int klass_bits                     = 22;
+  static const int klass_shift                    = BitsPerWord - klass_bits;
+  static const uintptr_t klass_mask               = right_n_bits(klass_bits);
+  static const uintptr_t klass_mask_in_place      = klass_mask << klass_shift;
+  static_assert(klass_shift >= hash_shift + hash_bits, "klass must not overlap the hash");
+#endif
+
   // Creates a markWord with all bits set to zero.
   static markWord zero() { return markWord(uintptr_t(0)); }
 
@@ -197,10 +217,20 @@ class markWord {
   }
   ObjectMonitor* monitor() const {
     assert(has_monitor(), "check");
+    assert(!UseObjectMonitorTable, "the mark word does not refer to the monitor");
     // Use xor instead of &~ to provide one extra tag-bit check.
     return (ObjectMonitor*) (value() ^ monitor_value);
   }
+  markWord set_has_monitor() const {
+    // Only used with UseObjectMonitorTable, where the mark word keeps the
+    // hash and age and just carries the monitor lock bits.
+    return markWord((value() & ~lock_mask_in_place) | monitor_value);
+  }
   bool has_displaced_mark_helper() const {
+    if (UseObjectMonitorTable) {
+      // The mark word is never displaced.
+      return false;
+    }
     intptr_t lockbits = value() & lock_mask_in_place;
     return LockingMode == LM_LIGHTWEIGHT  ? lockbits == monitor_value   // monitor?
                                           : (lockbits & unlocked_value) == 0; // monitor | stack-locked?
@@ -255,6 +285,20 @@ class markWord {
     return markWord( no_hash_in_place | no_lock_in_place );
   }
 
+#ifdef _LP64
+  // narrow klass operations, see the description of klass above
+  narrowKlass narrow_klass() const {
+    return (narrowKlass) mask_bits(value() >> klass_shift, klass_mask);
+  }
+  markWord set_narrow_klass(narrowKlass nk) const {
+    assert(fits_narrow_klass(nk), "narrow klass does not fit: " UINT32_FORMAT, nk);
+    return markWord((value() & ~klass_mask_in_place) | ((uintptr_t)nk << klass_shift));
+  }
+  static bool fits_narrow_klass(narrowKlass nk) {
+    return (nk & ~klass_mask) == 0;
+  }
+#endif
+
   // Debugging
   void print_on(outputStream* st, bool print_monitor_info = true) const;
 
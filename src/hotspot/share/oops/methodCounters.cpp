@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "compiler/compiler_globals.hpp"
 #include "compiler/compilerOracle.hpp"
+#include "compiler/methodProfileArchive.hpp"
 #include "oops/method.hpp"
 #include "oops/methodCounters.hpp"
 #include "runtime/handles.inline.hpp"
@@ -43,6 +44,7 @@ MethodCounters::MethodCounters(const methodHandle& mh) :
   // Set per-method thresholds.
   double scale = 1.0;
   CompilerOracle::has_option_value(mh, CompileCommandEnum::CompileThresholdScaling, scale);
+  scale *= MethodProfileArchive::threshold_scaling(mh);
 
   _invoke_mask = right_n_bits(CompilerConfig::scaled_freq_log(Tier0InvokeNotifyFreqLog, scale)) << InvocationCounter::count_shift;
   _backedge_mask = right_n_bits(CompilerConfig::scaled_freq_log(Tier0BackedgeNotifyFreqLog, scale)) << InvocationCounter::count_shift;
@@ -28,6 +28,7 @@
 #include "compiler/compilationPolicy.hpp"
 #include "compiler/compilerDefinitions.inline.hpp"
 #include "compiler/compilerOracle.hpp"
+#include "compiler/methodProfileArchive.hpp"
 #include "interpreter/bytecode.hpp"
 #include "interpreter/bytecodeStream.hpp"
 #include "interpreter/linkResolver.hpp"
@@ -1320,6 +1321,7 @@ void MethodData::init() {
   double scale = 1.0;
   methodHandle mh(Thread::current(), _method);
   CompilerOracle::has_option_value(mh, CompileCommandEnum::CompileThresholdScaling, scale);
+  scale *= MethodProfileArchive::threshold_scaling(mh);
   _invoke_mask = (int)right_n_bits(CompilerConfig::scaled_freq_log(Tier0InvokeNotifyFreqLog, scale)) << InvocationCounter::count_shift;
   _backedge_mask = (int)right_n_bits(CompilerConfig::scaled_freq_log(Tier0BackedgeNotifyFreqLog, scale)) << InvocationCounter::count_shift;
 
@@ -162,6 +162,27 @@ bool InlineTree::should_inline(ciMethod* callee_method, ciMethod* caller_method,
   assert(invoke_count != 0, "require invocation count greater than zero");
   double freq = (double)call_site_count / (double)invoke_count;
 
+  if (InlineCostBenefit &&
+      !is_unboxing_method(callee_method, C) &&
+      !is_init_with_ea(callee_method, caller_method, C)) {
+    max_inline_size = cost_benefit_inline_size(freq);
+    if (C->print_inlining() && Verbose) {
+      CompileTask::print_inline_indent(inline_level());
+      tty->print_cr("Cost/benefit: size=%d freq=%lf max size=%d", size, freq, max_inline_size);
+    }
+    if (size > max_inline_size) {
+      set_msg(freq >= InlineFrequencyRatio ? "hot method too big" : "too big for call site frequency");
+      return false;
+    }
+    if (freq < InlineFrequencyRatio &&
+        callee_method->has_compiled_code() &&
+        callee_method->inline_instructions_size() > inline_small_code_size) {
+      set_msg("already compiled into a medium method");
+      return false;
+    }
+    return true;
+  }
+
   // bump the max size if the call is frequent
   if ((freq >= InlineFrequencyRatio) ||
       is_unboxing_method(callee_method, C) ||
@@ -195,6 +216,28 @@ bool InlineTree::should_inline(ciMethod* callee_method, ciMethod* caller_method,
 }
 
 
+// Maximum bytecode size of a callee to inline at a call site with the given
+// frequency, with InlineCostBenefit. Instead of switching from MaxInlineSize to
+// FreqInlineSize at InlineFrequencyRatio, the limit grows with the frequency,
+// drops below MaxInlineSize at cold call sites, and leaves no single callee
+// more than a quarter of the inlining budget left in this compilation.
+int InlineTree::cost_benefit_inline_size(double freq) const {
+  const int max_size = C->max_inline_size();
+  const int freq_size = MAX2(C->freq_inline_size(), max_size);
+  const double hotness = MIN2(freq / InlineFrequencyRatio, 1.0);
+  int limit;
+  if (hotness >= 0.1) {
+    limit = max_size + (int)((freq_size - max_size) * hotness);
+  } else {
+    limit = (int)(max_size * hotness * 10);
+  }
+  if (ClipInlining) {
+    const int budget_left = DesiredMethodLimit - (int)C->ilt()->count_inline_bcs();
+    limit = MIN2(limit, budget_left / 4);
+  }
+  return MAX2(limit, (int)MaxTrivialSize);
+}
+
 // negative filter: should callee NOT be inlined?
 bool InlineTree::should_not_inline(ciMethod* callee_method, ciMethod* caller_method,
                                    int caller_bci, bool& should_delay, ciCallProfile& profile) {
@@ -251,6 +251,11 @@
   develop(bool, OptoCoalesce, true,                                         \
           "Use Conservative Copy Coalescing in the Register Allocator")     \
                                                                             \
+  product(uint, RegAllocLargeMethodLRGCount, 0, DIAGNOSTIC,                 \
+          "Above this number of live ranges, skip conservative copy "       \
+          "coalescing in the spill-split-recycle rounds of the register "   \
+          "allocator to bound its compile time. 0 means no limit")          \
+                                                                            \
   develop(bool, UseUniqueSubclasses, true,                                  \
           "Narrow an abstract reference to the unique concrete subclass")   \
                                                                             \
@@ -335,6 +340,11 @@
   develop(bool, TraceLoopUnswitching, false,                                \
           "Trace loop unswitching")                                         \
                                                                             \
+  product(bool, LoopAliasingVersioning, false, EXPERIMENTAL,                \
+          "Version loops that store to an array and access another array "  \
+          "of the same type on a runtime check that the arrays differ, so " \
+          "that the fast version can be auto-vectorized")                   \
+                                                                            \
   product(bool, AllowVectorizeOnDemand, true,                               \
           "Globally suppress vectorization set in VectorizeMethod")         \
                                                                             \
@@ -482,6 +492,13 @@
   develop(bool, VerifyReduceAllocationMerges, true,                         \
           "Verify reduce allocation merges in escape analysis")             \
                                                                             \
+  product(double, RareBranchUncommonTrapProbability, 0.0, EXPERIMENTAL,     \
+          "Turn profiled branches taken with less than this probability "   \
+          "into uncommon traps, so that allocations which only escape on "  \
+          "such branches can be scalar replaced. 0 only traps branches "    \
+          "that were never taken")                                          \
+          range(0.0, 0.01)                                                  \
+                                                                            \
   product(bool, DoEscapeAnalysis, true,                                     \
           "Perform escape analysis")                                        \
                                                                             \
@@ -675,6 +692,11 @@
           "high tier compiler")                                             \
           range(0, max_jint)                                                \
                                                                             \
+  product(bool, InlineCostBenefit, false, EXPERIMENTAL,                     \
+          "Scale the maximum bytecode size of a method to be inlined with " \
+          "the frequency of the call site, and limit it by the inlining "   \
+          "budget left in the compilation")                                 \
+                                                                            \
   product(bool, IncrementalInline, true,                                    \
           "do post parse inlining")                                         \
                                                                             \
@@ -761,6 +783,13 @@
           "Loop with fewer iterations are not strip mined")                 \
           range(0, max_juint)                                               \
                                                                             \
+  product(uintx, LoopStripMiningBodyBudget, 0, EXPERIMENTAL,                \
+          "If non zero, the number of iterations of a strip mined loop is " \
+          "chosen so that about this many IR nodes of the loop body are "   \
+          "executed between safepoint polls, instead of using "             \
+          "LoopStripMiningIter for all loops")                              \
+          range(0, max_juint)                                               \
+                                                                            \
   product(bool, UseProfiledLoopPredicate, true,                             \
           "Move predicates out of loops based on profiling data")           \
                                                                             \
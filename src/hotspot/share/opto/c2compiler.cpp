@@ -276,10 +276,12 @@ bool C2Compiler::is_intrinsic_supported(vmIntrinsics::ID id) {
     if (StubRoutines::bigIntegerLeftShift() == nullptr) return false;
     break;
   case vmIntrinsics::_encodeAsciiArray:
+  case vmIntrinsics::_encodeAsciiArrayToAddress:
     if (!Matcher::match_rule_supported(Op_EncodeISOArray) || !Matcher::supports_encode_ascii_array) return false;
     break;
   case vmIntrinsics::_encodeISOArray:
   case vmIntrinsics::_encodeByteISOArray:
+  case vmIntrinsics::_encodeByteISOArrayToAddress:
     if (!Matcher::match_rule_supported(Op_EncodeISOArray)) return false;
     break;
   case vmIntrinsics::_countPositives:
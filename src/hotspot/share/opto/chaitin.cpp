@@ -578,8 +578,10 @@ void PhaseChaitin::Register_Allocate() {
     _ifg->SquareUp();
     _ifg->Compute_Effective_Degree();
 
-    // Only do conservative coalescing if requested
-    if (OptoCoalesce) {
+    // Only do conservative coalescing if requested, and not for very large methods.
+    // Each round reruns it over all copies, and it tends to undo the splits that
+    // were just made, so it mostly adds more rounds there.
+    if (OptoCoalesce && !is_large_method()) {
       Compile::TracePhase tp("chaitinCoalesce3", &timers[_t_chaitinCoalesce3]);
       // Conservative (and pessimistic) copy coalescing
       PhaseConservativeCoalesce coalesce(*this);
@@ -495,6 +495,12 @@ class PhaseChaitin : public PhaseRegAlloc {
   // Do all the real work of allocate
   void Register_Allocate();
 
+  // True if the method has so many live ranges that the allocator trades some
+  // allocation quality for compile time (see RegAllocLargeMethodLRGCount).
+  bool is_large_method() const {
+    return RegAllocLargeMethodLRGCount > 0 && _lrg_map.max_lrg_id() > RegAllocLargeMethodLRGCount;
+  }
+
   double high_frequency_lrg() const { return _high_frequency_lrg; }
 
   // Used when scheduling info generated, not in general register allocation
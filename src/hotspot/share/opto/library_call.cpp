@@ -647,6 +647,10 @@ bool LibraryCallKit::try_to_inline(int predicate) {
     return inline_encodeISOArray(false);
   case vmIntrinsics::_encodeAsciiArray:
     return inline_encodeISOArray(true);
+  case vmIntrinsics::_encodeByteISOArrayToAddress:
+    return inline_encodeISOArrayToAddress(false);
+  case vmIntrinsics::_encodeAsciiArrayToAddress:
+    return inline_encodeISOArrayToAddress(true);
 
   case vmIntrinsics::_updateCRC32:
     return inline_updateCRC32();
@@ -4607,7 +4611,15 @@ bool LibraryCallKit::inline_native_hashcode(bool is_virtual, bool is_static) {
   // Test the header to see if it is safe to read w.r.t. locking.
   Node *lock_mask      = _gvn.MakeConX(markWord::lock_mask_in_place);
   Node *lmasked_header = _gvn.transform(new AndXNode(header, lock_mask));
-  if (LockingMode == LM_LIGHTWEIGHT) {
+  if (LockingMode == LM_LIGHTWEIGHT && UseObjectMonitorTable) {
+    // The mark word of an inflated object is not displaced and keeps the
+    // hash, so only a marked header needs the slow path.
+    Node *marked_val    = _gvn.MakeConX(markWord::marked_value);
+    Node *chk_marked    = _gvn.transform(new CmpXNode(lmasked_header, marked_val));
+    Node *test_marked   = _gvn.transform(new BoolNode(chk_marked, BoolTest::eq));
+
+    generate_slow_guard(test_marked, slow_region);
+  } else if (LockingMode == LM_LIGHTWEIGHT) {
     Node *monitor_val   = _gvn.MakeConX(markWord::monitor_value);
     Node *chk_monitor   = _gvn.transform(new CmpXNode(lmasked_header, monitor_val));
     Node *test_monitor  = _gvn.transform(new BoolNode(chk_monitor, BoolTest::eq));
@@ -5974,6 +5986,48 @@ bool LibraryCallKit::inline_encodeISOArray(bool ascii) {
   return true;
 }
 
+//-------------inline_encodeISOArrayToAddress---------------------------
+// encode the chars of a UTF16 byte[] to off-heap memory in ISO_8859_1 or ASCII
+// int java.lang.StringCoding.implEncode{ISO,Ascii}ArrayToAddress(byte[] sa, int sp, long address, int len)
+bool LibraryCallKit::inline_encodeISOArrayToAddress(bool ascii) {
+  assert(callee()->signature()->size() == 5, "encodeISOArrayToAddress has 4 parameters and one is long");
+  // no receiver since it is static method
+  Node* src         = argument(0); // type: byte[]
+  Node* src_offset  = argument(1); // type: int
+  Node* address     = argument(2); // type: long
+  Node* length      = argument(4); // type: int
+
+  src = must_be_not_null(src, true);
+
+  const TypeAryPtr* src_type = src->Value(&_gvn)->isa_aryptr();
+  if (src_type == nullptr || src_type->elem() == Type::BOTTOM) {
+    // failed array check
+    return false;
+  }
+  if (src_type->elem()->array_element_basic_type() != T_BYTE) {
+    return false;
+  }
+
+  Node* src_start = array_element_address(src, src_offset, T_CHAR);
+  address = ConvL2X(address);  // adjust Java long to machine word
+  Node* dst_start = _gvn.transform(new CastX2PNode(address));
+  // 'src_start' points to src array + scaled offset
+  // 'dst_start' points to the off-heap destination
+
+  // The raw destination may alias any memory, so order the encoding
+  // against all other memory accesses, as for mismatched unsafe accesses.
+  insert_mem_bar(Op_MemBarCPUOrder);
+  Node* enc = new EncodeISOArrayNode(control(), memory(TypeAryPtr::BYTES), src_start, dst_start, length, ascii);
+  enc = _gvn.transform(enc);
+  Node* res_mem = _gvn.transform(new SCMemProjNode(enc));
+  set_memory(res_mem, TypeRawPtr::BOTTOM);
+  insert_mem_bar(Op_MemBarCPUOrder);
+  set_result(enc);
+  clear_upper_avx();
+
+  return true;
+}
+
 //-------------inline_multiplyToLen-----------------------------------
 bool LibraryCallKit::inline_multiplyToLen() {
   assert(UseMultiplyToLenIntrinsic, "not implemented on this platform");
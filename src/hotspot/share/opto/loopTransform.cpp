@@ -3601,6 +3601,13 @@ bool IdealLoopTree::iteration_split_impl(PhaseIdealLoop *phase, Node_List &old_n
   }
   CountedLoopNode *cl = _head->as_CountedLoop();
 
+  // Remember the size of one iteration of the body before unrolling
+  // multiplies it. It determines the number of iterations of the strip
+  // mined inner loop with LoopStripMiningBodyBudget.
+  if (cl->is_strip_mined() && cl->unrolled_count() == 1) {
+    cl->set_body_size(_body.size());
+  }
+
   if (!cl->is_valid_counted_loop(T_INT)) return true; // Ignore various kinds of broken loops
 
   // Do nothing special to pre- and post- loops
@@ -3616,6 +3623,10 @@ bool IdealLoopTree::iteration_split_impl(PhaseIdealLoop *phase, Node_List &old_n
       phase->do_unswitching(this, old_new);
       return false; // need to recalculate idom data
     }
+    if (policy_aliasing_versioning(phase)) {
+      phase->do_aliasing_versioning(this, old_new);
+      return false; // need to recalculate idom data
+    }
     if (policy_maximally_unroll(phase)) {
       // Here we did some unrolling and peeling.  Eventually we will
       // completely unroll this loop and it will no longer be a loop.
@@ -24,14 +24,17 @@
 
 #include "precompiled.hpp"
 #include "memory/allocation.inline.hpp"
+#include "opto/addnode.hpp"
 #include "opto/castnode.hpp"
 #include "opto/cfgnode.hpp"
 #include "opto/connode.hpp"
 #include "opto/convertnode.hpp"
 #include "opto/loopnode.hpp"
+#include "opto/memnode.hpp"
 #include "opto/opaquenode.hpp"
 #include "opto/predicates.hpp"
 #include "opto/rootnode.hpp"
+#include "opto/subnode.hpp"
 
 // Loop Unswitching is a loop optimization to move an invariant, non-loop-exiting test in the loop body before the loop.
 // Such a test is either always true or always false in all loop iterations and could therefore only be executed once.
@@ -429,3 +432,192 @@ void PhaseIdealLoop::increment_unswitch_counts(LoopNode* original_head, LoopNode
   new_head->set_unswitch_count(unswitch_count);
 }
 
+
+// Aliasing Versioning is a form of Loop Unswitching where the loop selector If is not taken from the loop body but is
+// a new runtime check that two arrays accessed in the loop are different arrays:
+//
+//                 loop selector If (base1 != base2)
+//                    /                   \
+//                true?                  false?
+//                /                         \
+//      Fast Loop (=Orig)               Slow Loop (=Clone)
+//
+// Two Java arrays are either the same array or do not overlap at all. Auto-vectorization of the fast loop can thus
+// treat all accesses to base1 and base2 as independent (see VLoopDependencyGraph::construct()). This matters for
+// accesses with different invariant offsets, such as "dst[dst_off + i] = src[src_off + i]", that it otherwise has
+// to treat as possibly overlapping.
+
+// Strip casts, and look through compressed oops since IGVN turns CmpP of decoded pointers into CmpN.
+static Node* pointer_identity(Node* n) {
+  n = n->uncast();
+  if (n->Opcode() == Op_DecodeN || n->Opcode() == Op_EncodeP) {
+    n = n->in(1)->uncast();
+  }
+  return n;
+}
+
+bool PhaseIdealLoop::is_dominated_by_pointer_compare(Node* ctrl, Node* p1, Node* p2, bool& distinct) const {
+  // Enough to get past the pre-loop and predicates of a main-loop to the loop selector If of Aliasing Versioning.
+  const int max_dom_walk = 100;
+  Node* id1 = pointer_identity(p1);
+  Node* id2 = pointer_identity(p2);
+  Node* n = ctrl;
+  for (int i = 0; i < max_dom_walk && n != nullptr && !n->is_Start() && !n->is_Root(); i++) {
+    if (n->is_IfProj() && n->in(0)->in(1)->is_Bool()) {
+      BoolNode* bol = n->in(0)->in(1)->as_Bool();
+      Node* cmp = bol->in(1);
+      if ((cmp->Opcode() == Op_CmpP || cmp->Opcode() == Op_CmpN) &&
+          (bol->_test._test == BoolTest::eq || bol->_test._test == BoolTest::ne)) {
+        Node* in1 = pointer_identity(cmp->in(1));
+        Node* in2 = pointer_identity(cmp->in(2));
+        if ((in1 == id1 && in2 == id2) || (in1 == id2 && in2 == id1)) {
+          distinct = (bol->_test._test == BoolTest::ne) == n->is_IfTrue();
+          return true;
+        }
+      }
+    }
+    n = idom(n);
+  }
+  return false;
+}
+
+// Return the base of an array access, or null if the base is not loop invariant.
+static Node* invariant_array_base(const IdealLoopTree* loop, Node* mem) {
+  Node* adr = mem->in(MemNode::Address);
+  if (!adr->is_AddP()) {
+    return nullptr;
+  }
+  Node* base = adr->in(AddPNode::Base);
+  if (base->is_top() || base->bottom_type()->isa_aryptr() == nullptr || !loop->is_invariant(base)) {
+    return nullptr;
+  }
+  return base;
+}
+
+// The offset of an array access without its constant part. Accesses to two arrays with the same index expression
+// can already be compared by auto-vectorization, which treats them as accesses to the same array.
+static Node* array_index_offset(Node* mem) {
+  Node* adr = mem->in(MemNode::Address);
+  Node* inner = adr->in(AddPNode::Address);
+  if (inner->is_AddP()) {
+    return inner->in(AddPNode::Offset);
+  }
+  return adr->in(AddPNode::Offset);
+}
+
+// Find a store to an array and an access to another array of the same memory slice whose relation is not known yet.
+bool PhaseIdealLoop::find_aliasing_versioning_candidate(const IdealLoopTree* loop, Node*& base1, Node*& base2) const {
+  Node* entry = loop->_head->as_Loop()->skip_strip_mined()->in(LoopNode::EntryControl);
+  for (uint i = 0; i < loop->_body.size(); i++) {
+    Node* store = loop->_body.at(i);
+    if (!store->is_Store()) {
+      continue;
+    }
+    Node* store_base = invariant_array_base(loop, store);
+    if (store_base == nullptr) {
+      continue;
+    }
+    int alias_idx = C->get_alias_index(store->adr_type());
+    for (uint j = 0; j < loop->_body.size(); j++) {
+      Node* mem = loop->_body.at(j);
+      if (mem == store || !(mem->is_Load() || mem->is_Store()) ||
+          C->get_alias_index(mem->adr_type()) != alias_idx) {
+        continue;
+      }
+      Node* mem_base = invariant_array_base(loop, mem);
+      if (mem_base == nullptr || pointer_identity(mem_base) == pointer_identity(store_base) ||
+          array_index_offset(mem) == array_index_offset(store)) {
+        continue;
+      }
+      bool distinct;
+      if (is_dominated_by_pointer_compare(entry, store_base, mem_base, distinct)) {
+        continue;
+      }
+      base1 = store_base;
+      base2 = mem_base;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool IdealLoopTree::policy_aliasing_versioning(PhaseIdealLoop* phase) const {
+  if (!LoopAliasingVersioning || !LoopUnswitching || !UseSuperWord) {
+    return false;
+  }
+  if (!_head->is_CountedLoop() || !_head->as_CountedLoop()->is_normal_loop()) {
+    return false;
+  }
+  assert(!phase->exceeding_node_budget(), "sanity");
+
+  // Shares the limit on the number of versions of a loop with Loop Unswitching.
+  LoopNode* head = _head->as_Loop();
+  if (head->unswitch_count() + 1 > head->unswitch_max()) {
+    return false;
+  }
+  Node* base1;
+  Node* base2;
+  if (!phase->find_aliasing_versioning_candidate(this, base1, base2)) {
+    return false;
+  }
+  return phase->may_require_nodes(est_loop_clone_sz(2));
+}
+
+// See the comments on Aliasing Versioning above pointer_identity() for more information.
+void PhaseIdealLoop::do_aliasing_versioning(IdealLoopTree* loop, Node_List& old_new) {
+  LoopNode* original_head = loop->_head->as_Loop();
+  if (has_control_dependencies_from_predicates(original_head)) {
+    NOT_PRODUCT(trace_loop_unswitching_impossible(original_head);)
+    return;
+  }
+  Node* base1;
+  Node* base2;
+  if (!find_aliasing_versioning_candidate(loop, base1, base2)) {
+    assert(false, "guaranteed to exist by policy_aliasing_versioning");
+    return;
+  }
+
+  NOT_PRODUCT(trace_loop_unswitching_count(loop, original_head);)
+  C->print_method(PHASE_BEFORE_LOOP_UNSWITCHING, 4, original_head);
+
+  revert_to_normal_loop(original_head);
+
+  LoopNode* loop_head = original_head->skip_strip_mined();
+  IdealLoopTree* outer_loop = loop->skip_strip_mined()->_parent;
+  Node* entry = loop_head->in(LoopNode::EntryControl);
+  const uint entry_dom_depth = dom_depth(entry);
+
+  Node* cmp = new CmpPNode(base1, base2);
+  register_new_node(cmp, entry);
+  Node* bol = new BoolNode(cmp, BoolTest::ne);
+  register_new_node(bol, entry);
+  // Loops usually access different arrays, the slow loop is for the rare case where the same array is passed twice.
+  IfNode* selector = new IfNode(entry, bol, PROB_LIKELY_MAG(3), COUNT_UNKNOWN);
+  register_node(selector, outer_loop, entry, entry_dom_depth);
+  IfProjNode* fast_loop_entry = new IfTrueNode(selector);
+  register_node(fast_loop_entry, outer_loop, selector, entry_dom_depth);
+  IfProjNode* slow_loop_entry = new IfFalseNode(selector);
+  register_node(slow_loop_entry, outer_loop, selector, entry_dom_depth);
+
+  clone_loop(loop, old_new, dom_depth(loop_head), CloneIncludesStripMined, selector);
+  clone_parse_and_assertion_predicates_to_unswitched_loop(loop, old_new, fast_loop_entry, slow_loop_entry);
+  replace_loop_entry(loop_head, fast_loop_entry);
+  replace_loop_entry(old_new[loop_head->_idx]->as_Loop(), slow_loop_entry);
+  recompute_dom_depth();
+
+  add_unswitched_loop_version_bodies_to_igvn(loop, old_new);
+
+  LoopNode* new_head = old_new[original_head->_idx]->as_Loop();
+  increment_unswitch_counts(original_head, new_head);
+
+#ifndef PRODUCT
+  if (TraceLoopUnswitching) {
+    tty->print_cr("Aliasing Versioning:");
+    tty->print_cr("- Loop-Selector-If: %d %s (%d != %d)", selector->_idx, selector->Name(), base1->_idx, base2->_idx);
+    tty->print_cr("- Fast-Loop (=Orig): %d %s", original_head->_idx, original_head->Name());
+    tty->print_cr("- Slow-Loop (=Clone): %d %s", new_head->_idx, new_head->Name());
+  }
+#endif
+  C->print_method(PHASE_AFTER_LOOP_UNSWITCHING, 4, new_head);
+  C->set_major_progress();
+}
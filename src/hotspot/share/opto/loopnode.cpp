@@ -2938,6 +2938,19 @@ void OuterStripMinedLoopNode::fix_sunk_stores(CountedLoopEndNode* inner_cle, Loo
   }
 }
 
+// Number of iterations of the inner loop between two safepoint polls. With
+// LoopStripMiningBodyBudget, light loop bodies run more iterations and heavy
+// ones fewer, so that about the same amount of work is done between polls.
+jlong OuterStripMinedLoopNode::strip_mined_iters(CountedLoopNode* inner_cl) {
+  assert(LoopStripMiningIter > 1, "no strip mining");
+  if (LoopStripMiningBodyBudget == 0 || inner_cl->body_size() == 0) {
+    return LoopStripMiningIter;
+  }
+  // Unrolling multiplied the body executed by one iteration of the inner loop.
+  jlong body_size = (jlong)inner_cl->body_size() * inner_cl->unrolled_count();
+  return MAX2((jlong)LoopStripMiningBodyBudget / body_size, (jlong)2);
+}
+
 void OuterStripMinedLoopNode::adjust_strip_mined_loop(PhaseIterGVN* igvn) {
   // Look for the outer & inner strip mined loop, reduce number of
   // iterations of the inner loop, set exit condition of outer loop,
@@ -2963,10 +2976,11 @@ void OuterStripMinedLoopNode::adjust_strip_mined_loop(PhaseIterGVN* igvn) {
   CountedLoopEndNode* inner_cle = inner_cl->loopexit();
 
   int stride = inner_cl->stride_con();
-  // For a min int stride, LoopStripMiningIter * stride overflows the int range for all values of LoopStripMiningIter
-  // except 0 or 1. Those values are handled early on in this method and causes the method to return. So for a min int
-  // stride, the method is guaranteed to return at the next check below.
-  jlong scaled_iters_long = ((jlong)LoopStripMiningIter) * ABS((jlong)stride);
+  jlong iters = strip_mined_iters(inner_cl);
+  // For a min int stride, iters * stride overflows the int range for all values of iters except 0 or 1. iters is
+  // at least 2 if we get here (0 or 1 for LoopStripMiningIter are handled early on in this method and cause the
+  // method to return). So for a min int stride, the method is guaranteed to return at the next check below.
+  jlong scaled_iters_long = iters * ABS((jlong)stride);
   int scaled_iters = (int)scaled_iters_long;
   if ((jlong)scaled_iters != scaled_iters_long) {
     // Remove outer loop and safepoint (too few iterations)
@@ -3067,7 +3081,7 @@ void OuterStripMinedLoopNode::adjust_strip_mined_loop(PhaseIterGVN* igvn) {
     // If limit < init for stride > 0 (or limit > init for stride < 0),
     // the loop body is run only once. Given limit - init (init - limit resp.)
     // would be negative, the unsigned comparison below would cause
-    // the loop body to be run for LoopStripMiningIter.
+    // the loop body to be run for the number of strip mined iterations.
     Node* max = nullptr;
     if (stride > 0) {
       max = MaxNode::max_diff_with_zero(limit, iv_phi, TypeInt::INT, *igvn);
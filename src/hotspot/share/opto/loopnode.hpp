@@ -234,11 +234,15 @@ class CountedLoopNode : public BaseCountedLoopNode {
   // vector mapped unroll factor here
   int _slp_maximum_unroll_factor;
 
+  // Node count of one iteration of the loop body, recorded before
+  // unrolling - used to size the inner loop of a strip mined loop
+  uint _body_size;
+
 public:
   CountedLoopNode(Node *entry, Node *backedge)
     : BaseCountedLoopNode(entry, backedge), _main_idx(0), _trip_count(max_juint),
       _unrolled_count_log2(0), _node_count_before_unroll(0),
-      _slp_maximum_unroll_factor(0) {
+      _slp_maximum_unroll_factor(0), _body_size(0) {
     init_class_id(Class_CountedLoop);
     // Initialize _trip_count to the largest possible value.
     // Will be reset (lower) if the loop's trip count is known.
@@ -314,6 +318,8 @@ class CountedLoopNode : public BaseCountedLoopNode {
   int  node_count_before_unroll()            { return _node_count_before_unroll; }
   void set_slp_max_unroll(int unroll_factor) { _slp_maximum_unroll_factor = unroll_factor; }
   int  slp_max_unroll() const                { return _slp_maximum_unroll_factor; }
+  void set_body_size(uint size)              { _body_size = size; }
+  uint body_size() const                     { return _body_size; }
 
   virtual LoopNode* skip_strip_mined(int expect_skeleton = 1);
   OuterStripMinedLoopNode* outer_loop() const;
@@ -546,6 +552,7 @@ class OuterStripMinedLoopNode : public LoopNode {
   virtual OuterStripMinedLoopEndNode* outer_loop_end() const;
   virtual IfFalseNode* outer_loop_exit() const;
   virtual SafePointNode* outer_safepoint() const;
+  static jlong strip_mined_iters(CountedLoopNode* inner_cl);
   void adjust_strip_mined_loop(PhaseIterGVN* igvn);
 
   void remove_outer_loop_and_safepoint(PhaseIterGVN* igvn) const;
@@ -690,6 +697,10 @@ class IdealLoopTree : public ResourceObj {
   // loop with an invariant test
   bool policy_unswitching( PhaseIdealLoop *phase ) const;
 
+  // Return TRUE if the loop should be versioned on a runtime check that two
+  // arrays it accesses are not the same array
+  bool policy_aliasing_versioning(PhaseIdealLoop* phase) const;
+
   // Micro-benchmark spamming.  Remove empty loops.
   bool do_remove_empty_loop( PhaseIdealLoop *phase );
 
@@ -1424,6 +1435,18 @@ class PhaseIdealLoop : public PhaseTransform {
 
   IfNode* find_unswitch_candidate(const IdealLoopTree* loop) const;
 
+  // Clone loop and select the version to execute by a runtime check that
+  // two arrays accessed in the loop are different arrays. Auto-vectorization
+  // of the version where they are different does not need to assume that
+  // accesses to them alias.
+  void do_aliasing_versioning(IdealLoopTree* loop, Node_List& old_new);
+
+  bool find_aliasing_versioning_candidate(const IdealLoopTree* loop, Node*& base1, Node*& base2) const;
+
+  // Returns true if a pointer comparison of p1 and p2 dominates ctrl, and
+  // sets distinct to whether p1 != p2 holds on the path to ctrl.
+  bool is_dominated_by_pointer_compare(Node* ctrl, Node* p1, Node* p2, bool& distinct) const;
+
  private:
   static bool has_control_dependencies_from_predicates(LoopNode* head);
   static void revert_to_normal_loop(const LoopNode* loop_head);
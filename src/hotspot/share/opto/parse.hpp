@@ -78,6 +78,7 @@ class InlineTree : public AnyObj {
                             int caller_bci,
                             bool& should_delay,
                             ciCallProfile& profile);
+  int         cost_benefit_inline_size(double freq) const;
   bool        should_not_inline(ciMethod* callee_method,
                                 ciMethod* caller_method,
                                 int caller_bci,
@@ -388,6 +389,9 @@ class Parse : public GraphKit {
   float         prof_factor()   const { return _prof_factor; }
   int           depth()         const { return _depth; }
   const TypeFunc* tf()          const { return _tf; }
+  // Entry and exit probes are emitted for inlined methods only with DTrace.
+  bool          method_probes() const { return depth() == 1 ? C->env()->method_probes()
+                                                            : C->env()->dtrace_method_probes(); }
   //            entry_bci()     -- see osr_bci, etc.
 
   ciTypeFlow*   flow()          const { return _flow; }
@@ -561,6 +565,7 @@ class Parse : public GraphKit {
   float   dynamic_branch_prediction(float &cnt, BoolTest::mask btest, Node* test);
   float   branch_prediction(float &cnt, BoolTest::mask btest, int target_bci, Node* test);
   bool    seems_never_taken(float prob) const;
+  bool    seems_rarely_taken(float prob) const;
   bool    path_is_suitable_for_uncommon_trap(float prob) const;
 
   void    do_ifnull(BoolTest::mask btest, Node* c);
@@ -437,6 +437,10 @@ Parse::Parse(JVMState* caller, ciMethod* parse_method, float expected_uses)
     C->set_has_monitors(true);
   }
 
+  if (parse_method->is_scoped()) {
+    C->set_has_scoped_access(true);
+  }
+
   _iter.reset_to_method(method());
   C->set_has_loops(C->has_loops() || method()->has_loops());
 
@@ -1075,8 +1079,8 @@ void Parse::do_exits() {
   // See GraphKit::add_exception_state, which performs the commoning.
   bool do_synch = method()->is_synchronized() && GenerateSynchronizationCode;
 
-  // record exit from a method if compiled while Dtrace is turned on.
-  if (do_synch || C->env()->dtrace_method_probes() || _replaced_nodes_for_exceptions) {
+  // record exit from a method if compiled while Dtrace or tracing is turned on.
+  if (do_synch || method_probes() || _replaced_nodes_for_exceptions) {
     // First move the exception list out of _exits:
     GraphKit kit(_exits.transfer_exceptions_into_jvms());
     SafePointNode* normal_map = kit.map();  // keep this guy safe
@@ -1097,7 +1101,7 @@ void Parse::do_exits() {
         // Unlock!
         kit.shared_unlock(_synch_lock->box_node(), _synch_lock->obj_node());
       }
-      if (C->env()->dtrace_method_probes()) {
+      if (method_probes()) {
         kit.make_dtrace_method_exit(method());
       }
       if (_replaced_nodes_for_exceptions) {
@@ -1205,7 +1209,7 @@ void Parse::do_method_entry() {
 
   NOT_PRODUCT( count_compiled_calls(true/*at_method_entry*/, false/*is_inline*/); )
 
-  if (C->env()->dtrace_method_probes()) {
+  if (method_probes()) {
     make_dtrace_method_entry(method());
   }
 
@@ -2200,7 +2204,7 @@ void Parse::return_current(Node* value) {
   if (method()->is_synchronized() && GenerateSynchronizationCode) {
     shared_unlock(_synch_lock->box_node(), _synch_lock->obj_node());
   }
-  if (C->env()->dtrace_method_probes()) {
+  if (method_probes()) {
     make_dtrace_method_exit(method());
   }
   SafePointNode* exit_return = _exits.map();
@@ -1354,6 +1354,13 @@ bool Parse::seems_never_taken(float prob) const {
   return prob < PROB_MIN;
 }
 
+// A branch that was taken, but so rarely that deoptimizing on it is cheaper than
+// compiling it, see RareBranchUncommonTrapProbability. If the trap is hit, the
+// recompiled method keeps the branch, as for any unstable_if trap.
+bool Parse::seems_rarely_taken(float prob) const {
+  return prob < RareBranchUncommonTrapProbability;
+}
+
 //-------------------------------repush_if_args--------------------------------
 // Push arguments of an "if" bytecode back onto the stack by adjusting _sp.
 inline int Parse::repush_if_args() {
@@ -1557,7 +1564,7 @@ bool Parse::path_is_suitable_for_uncommon_trap(float prob) const {
   if (!UseInterpreter) {
     return false;
   }
-  return seems_never_taken(prob) &&
+  return (seems_never_taken(prob) || seems_rarely_taken(prob)) &&
          !C->too_many_traps(method(), bci(), Deoptimization::Reason_unstable_if);
 }
 
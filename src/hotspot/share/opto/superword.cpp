@@ -527,9 +527,41 @@ void SuperWord::collect_valid_vpointers(GrowableArray<const VPointer*>& vpointer
         is_java_primitive(mem->memory_type())) {
       vpointers.append(&p);
     }
+#ifndef PRODUCT
+    else if (!p.valid() && is_trace_superword_rejections() && is_indexed_memop(mem)) {
+      tty->print("  indexed access, needs gather or scatter: ");
+      mem->dump();
+    }
+#endif
   });
 }
 
+#ifndef PRODUCT
+// Returns true if the address of mem depends on a value loaded in the loop, as in
+// data[idx[i]]. Such memops have no valid VPointer, and could only be vectorized
+// with gathers or scatters.
+bool SuperWord::is_indexed_memop(const MemNode* mem) const {
+  ResourceMark rm;
+  Unique_Node_List worklist;
+  worklist.push(mem->in(MemNode::Address));
+  for (uint i = 0; i < worklist.size(); i++) {
+    Node* n = worklist.at(i);
+    if (!in_bb(n)) {
+      continue;
+    }
+    if (n->is_Load()) {
+      return true;
+    }
+    for (uint j = 1; j < n->req(); j++) {
+      if (n->in(j) != nullptr) {
+        worklist.push(n->in(j));
+      }
+    }
+  }
+  return false;
+}
+#endif
+
 // For each group, find the adjacent memops.
 void SuperWord::create_adjacent_memop_pairs_in_all_groups(const GrowableArray<const VPointer*> &vpointers) {
   int group_start = 0;
@@ -1589,8 +1621,9 @@ bool SuperWord::implemented(const Node_List* pack, const uint size) const {
       // See JDK-8294816 for miscompilation issues with shorts.
       return false;
     } else if (p0->is_Cmp()) {
-      // Cmp -> Bool -> Cmove
-      retValue = UseVectorCmov;
+      // Cmp -> Bool -> Cmove. Only signed comparisons map to a VectorMaskCmp.
+      retValue = UseVectorCmov &&
+                 (opc == Op_CmpI || opc == Op_CmpL || opc == Op_CmpF || opc == Op_CmpD);
     } else if (VectorNode::is_scalar_op_that_returns_int_but_vector_op_returns_long(opc)) {
       // Requires extra vector long -> int conversion.
       retValue = VectorNode::implemented(opc, size, T_LONG) &&
@@ -1797,6 +1830,11 @@ bool SuperWord::profitable(const Node_List* p) const {
     if (cmp == nullptr || get_pack(cmp) == nullptr) {
       return false;
     }
+    // The mask from the comparison must have lanes of the size of the blended
+    // elements, e.g. an int comparison can not select between longs.
+    if (type2aelembytes(velt_basic_type(cmp)) != type2aelembytes(velt_basic_type(p0))) {
+      return false;
+    }
   }
   return true;
 }
@@ -560,6 +560,7 @@ class SuperWord : public ResourceObj {
   // Find the "seed" memops pairs. These are pairs that we strongly suspect would lead to vectorization.
   void create_adjacent_memop_pairs();
   void collect_valid_vpointers(GrowableArray<const VPointer*>& vpointers);
+  NOT_PRODUCT(bool is_indexed_memop(const MemNode* mem) const;)
   void create_adjacent_memop_pairs_in_all_groups(const GrowableArray<const VPointer*>& vpointers);
   static int find_group_end(const GrowableArray<const VPointer*>& vpointers, int group_start);
   void create_adjacent_memop_pairs_in_one_group(const GrowableArray<const VPointer*>& vpointers, const int group_start, int group_end);
@@ -236,7 +236,8 @@ void VLoopVPointers::print() const {
 //    - No edges between different slices.
 //    - No Load-Load edges.
 //    - Inside a slice, add all Store-Load, Load-Store, Store-Store edges,
-//      except if we can prove that the memory does not overlap.
+//      except if we can prove that the memory does not overlap, or that it
+//      belongs to different objects.
 void VLoopDependencyGraph::construct() {
   const GrowableArray<PhiNode*>& mem_slice_heads = _memory_slices.heads();
   const GrowableArray<MemNode*>& mem_slice_tails = _memory_slices.tails();
@@ -266,7 +267,7 @@ void VLoopDependencyGraph::construct() {
         if (n1->is_Load() && n2->is_Load()) { continue; }
 
         const VPointer& p2 = _vpointers.vpointer(n2);
-        if (!VPointer::not_equal(p1.cmp(p2))) {
+        if (!VPointer::not_equal(p1.cmp(p2)) && !are_different_objects(p1, p2)) {
           // Possibly overlapping memory
           memory_pred_edges.append(_body.bb_idx(n2));
         }
@@ -285,6 +286,19 @@ void VLoopDependencyGraph::construct() {
   NOT_PRODUCT( if (_vloop.is_trace_dependency_graph()) { print(); } )
 }
 
+// Different objects never overlap. VPointer::cmp() has to assume that accesses
+// with different bases may be to the same object, but a dominating pointer
+// comparison, like the one emitted by Aliasing Versioning, can tell otherwise.
+bool VLoopDependencyGraph::are_different_objects(const VPointer& p1, const VPointer& p2) const {
+  if (!p1.valid() || !p2.valid() || p1.base()->is_top() || p2.base()->is_top() ||
+      p1.base()->uncast() == p2.base()->uncast()) {
+    return false;
+  }
+  Node* entry = _vloop.cl()->skip_strip_mined()->in(LoopNode::EntryControl);
+  bool distinct;
+  return _vloop.phase()->is_dominated_by_pointer_compare(entry, p1.base(), p2.base(), distinct) && distinct;
+}
+
 void VLoopDependencyGraph::add_node(MemNode* n, GrowableArray<int>& memory_pred_edges) {
   assert(_dependency_nodes.at_grow(_body.bb_idx(n), nullptr) == nullptr, "not yet created");
   assert(!memory_pred_edges.is_empty(), "no need to create a node without edges");
@@ -554,6 +554,7 @@ class VLoopDependencyGraph : public StackObj {
 
 private:
   void add_node(MemNode* n, GrowableArray<int>& memory_pred_edges);
+  bool are_different_objects(const VPointer& p1, const VPointer& p2) const;
   int depth(const Node* n) const { return _depths.at(_body.bb_idx(n)); }
   void set_depth(const Node* n, int d) { _depths.at_put(_body.bb_idx(n), d); }
   int find_max_pred_depth(const Node* n) const;
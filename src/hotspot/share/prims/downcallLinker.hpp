@@ -41,6 +41,20 @@ class DowncallLinker: AllStatic {
                                          int captured_state_mask,
                                          bool needs_transition);
 
+  // keep in synch with jdk.internal.foreign.abi.PreservableValues
+  enum PreservableValues {
+    NONE = 0,
+    GET_LAST_ERROR = 1,
+    WSA_GET_LAST_ERROR = 1 << 1,
+    ERRNO = 1 << 2
+  };
+
+  // The offset of errno in the captured state buffer, after the Windows
+  // specific values.
+  static int captured_errno_offset_in_bytes() {
+    return WIN64_ONLY(2 * (int)sizeof(int32_t)) NOT_WIN64(0);
+  }
+
   // This is defined as JVM_LEAF which adds the JNICALL modifier.
   static void JNICALL capture_state(int32_t* value_ptr, int captured_state_mask);
 
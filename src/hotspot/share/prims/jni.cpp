@@ -2798,16 +2798,44 @@ JNI_ENTRY(void, jni_GetStringUTFRegion(JNIEnv *env, jstring string, jsize start,
   }
 JNI_END
 
+// If pinning would block all GCs, small arrays are copied instead. The JNI
+// specification allows GetPrimitiveArrayCritical to return a copy, and for
+// small arrays that is cheaper than holding up a GC for the duration of the
+// critical region. Returns null if the array is to be pinned.
+static void* critical_array_copy(typeArrayOop a, BasicType type) {
+  if (JNICriticalArrayCopyLimit == 0 || !Universe::heap()->pin_object_blocks_gc()) {
+    return nullptr;
+  }
+  const size_t size = (size_t)a->length() * type2aelembytes(type);
+  if (size == 0 || size > JNICriticalArrayCopyLimit) {
+    return nullptr;
+  }
+  jbyte* copy = NEW_C_HEAP_ARRAY_RETURN_NULL(jbyte, size, mtInternal);
+  if (copy != nullptr) {
+    ArrayAccess<>::arraycopy_to_native(a, arrayOopDesc::base_offset_in_bytes(type), copy, size);
+  }
+  return copy;
+}
+
 JNI_ENTRY(void*, jni_GetPrimitiveArrayCritical(JNIEnv *env, jarray array, jboolean *isCopy))
  HOTSPOT_JNI_GETPRIMITIVEARRAYCRITICAL_ENTRY(env, array, (uintptr_t *) isCopy);
   Handle a(thread, JNIHandles::resolve_non_null(array));
   assert(a->is_typeArray(), "just checking");
 
+  BasicType type = TypeArrayKlass::cast(a->klass())->element_type();
+  void* ret = critical_array_copy(typeArrayOop(a()), type);
+  if (ret != nullptr) {
+    if (isCopy != nullptr) {
+      *isCopy = JNI_TRUE;
+    }
+    HOTSPOT_JNI_GETPRIMITIVEARRAYCRITICAL_RETURN(ret);
+    return ret;
+  }
+
   // Pin object
   Universe::heap()->pin_object(thread, a());
 
-  BasicType type = TypeArrayKlass::cast(a->klass())->element_type();
-  void* ret = arrayOop(a())->base(type);
+  ret = arrayOop(a())->base(type);
   if (isCopy != nullptr) {
     *isCopy = JNI_FALSE;
   }
@@ -2818,8 +2846,22 @@ JNI_END
 
 JNI_ENTRY(void, jni_ReleasePrimitiveArrayCritical(JNIEnv *env, jarray array, void *carray, jint mode))
   HOTSPOT_JNI_RELEASEPRIMITIVEARRAYCRITICAL_ENTRY(env, array, carray, mode);
-  // Unpin object
-  Universe::heap()->unpin_object(thread, JNIHandles::resolve_non_null(array));
+  oop a = JNIHandles::resolve_non_null(array);
+  if (carray != nullptr && !Universe::heap()->is_in(carray)) {
+    // A copy made by critical_array_copy()
+    typeArrayOop ta = typeArrayOop(a);
+    if ((mode == 0) || (mode == JNI_COMMIT)) {
+      BasicType type = TypeArrayKlass::cast(ta->klass())->element_type();
+      ArrayAccess<>::arraycopy_from_native((jbyte*)carray, ta, arrayOopDesc::base_offset_in_bytes(type),
+                                           (size_t)ta->length() * type2aelembytes(type));
+    }
+    if ((mode == 0) || (mode == JNI_ABORT)) {
+      FreeHeap(carray);
+    }
+  } else {
+    // Unpin object
+    Universe::heap()->unpin_object(thread, a);
+  }
 HOTSPOT_JNI_RELEASEPRIMITIVEARRAYCRITICAL_RETURN();
 JNI_END
 
@@ -3725,7 +3725,7 @@ JVM_ENTRY(void, JVM_LogLambdaFormInvoker(JNIEnv *env, jstring line))
     if (CDSConfig::is_dumping_dynamic_archive()) {
       // Note: LambdaFormInvokers::append take same format which is not
       // same as below the print format. The line does not include LAMBDA_FORM_TAG.
-      LambdaFormInvokers::append(os::strdup((const char*)c_line, mtInternal));
+      LambdaFormInvokers::append(c_line);
     }
     if (ClassListWriter::is_enabled()) {
       ClassListWriter w;
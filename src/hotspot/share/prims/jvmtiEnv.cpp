@@ -964,8 +964,12 @@ JvmtiEnv::SuspendThreadList(jint request_count, const jthread* request_list, jvm
   int self_idx = -1;
 
   {
+    ResourceMark rm(current);
     JvmtiVTMSTransitionDisabler disabler(true);
     ThreadsListHandle tlh(current);
+    // Threads which need a handshake are suspended together after the loop.
+    GrowableArray<JavaThread*> deferred;
+    GrowableArray<int> deferred_idx;
 
     for (int i = 0; i < request_count; i++) {
       JavaThread *java_thread = nullptr;
@@ -989,7 +993,16 @@ JvmtiEnv::SuspendThreadList(jint request_count, const jthread* request_list, jvm
         self_tobj = Handle(current, thread_oop);
         continue; // self suspend after all other suspends
       }
-      results[i] = suspend_thread(thread_oop, java_thread, /* single_suspend */ true, nullptr);
+      int deferred_count = deferred.length();
+      results[i] = suspend_thread(thread_oop, java_thread, /* single_suspend */ true, nullptr, &deferred);
+      if (deferred.length() > deferred_count) {
+        deferred_idx.append(i);
+      }
+    }
+    jvmtiError* deferred_results = NEW_RESOURCE_ARRAY(jvmtiError, deferred.length());
+    suspend_deferred_threads(&tlh, &deferred, deferred_results);
+    for (int j = 0; j < deferred.length(); j++) {
+      results[deferred_idx.at(j)] = deferred_results[j];
     }
   }
   // Self suspend after all other suspends if necessary.
@@ -1033,7 +1046,9 @@ JvmtiEnv::SuspendAllVirtualThreads(jint except_count, const jthread* except_list
       }
     }
 
-    for (JavaThreadIteratorWithHandle jtiwh; JavaThread *java_thread = jtiwh.next(); ) {
+    // Carriers of mounted virtual threads are suspended together after the loop.
+    GrowableArray<JavaThread*> deferred;
+    for (JavaThread* java_thread : tlh) {
       oop vt_oop = java_thread->jvmti_vthread();
       if (!java_thread->is_exiting() &&
           !java_thread->is_jvmti_agent_thread() &&
@@ -1049,9 +1064,10 @@ JvmtiEnv::SuspendAllVirtualThreads(jint except_count, const jthread* except_list
           self_tobj = Handle(current, vt_oop);
           continue; // self suspend after all other suspends
         }
-        suspend_thread(vt_oop, java_thread, /* single_suspend */ false, nullptr);
+        suspend_thread(vt_oop, java_thread, /* single_suspend */ false, nullptr, &deferred);
       }
     }
+    suspend_deferred_threads(&tlh, &deferred, nullptr);
     JvmtiVTSuspender::register_all_vthreads_suspend();
 
     // Restore resumed state for threads from except list that were not suspended before.
@@ -1496,8 +1496,9 @@ JvmtiEnvBase::get_object_monitor_usage(JavaThread* calling_thread, jobject objec
   GrowableArray<JavaThread*>* wantList = nullptr;
 
   if (mark.has_monitor()) {
-    mon = mark.monitor();
-    assert(mon != nullptr, "must have monitor");
+    mon = ObjectSynchronizer::read_monitor(current_thread, hobj(), mark);
+  }
+  if (mon != nullptr) {
     // this object has a heavyweight monitor
     nWant = mon->contentions(); // # of threads contending for monitor entry, but not re-entry
     nWait = mon->waiters();     // # of threads waiting for notification,
@@ -1708,7 +1709,7 @@ JvmtiEnvBase::disable_virtual_threads_notify_jvmti() {
 // java_thread - protected by ThreadsListHandle
 jvmtiError
 JvmtiEnvBase::suspend_thread(oop thread_oop, JavaThread* java_thread, bool single_suspend,
-                             int* need_safepoint_p) {
+                             int* need_safepoint_p, GrowableArray<JavaThread*>* deferred) {
   JavaThread* current = JavaThread::current();
   HandleMark hm(current);
   Handle thread_h(current, thread_oop);
@@ -1764,6 +1765,10 @@ JvmtiEnvBase::suspend_thread(oop thread_oop, JavaThread* java_thread, bool singl
     assert(single_suspend || thread_h()->is_a(vmClasses::BaseVirtualThread_klass()),
            "SuspendAllVirtualThreads should never suspend non-virtual threads");
     // Case of mounted virtual or attached carrier thread.
+    if (deferred != nullptr) {
+      deferred->append(java_thread);
+      return JVMTI_ERROR_NONE;
+    }
     if (!JvmtiSuspendControl::suspend(java_thread)) {
       // Thread is already suspended or in process of exiting.
       if (java_thread->is_exiting()) {
@@ -1776,6 +1781,32 @@ JvmtiEnvBase::suspend_thread(oop thread_oop, JavaThread* java_thread, bool singl
   return JVMTI_ERROR_NONE;
 }
 
+void
+JvmtiEnvBase::suspend_deferred_threads(ThreadsListHandle* tlh, GrowableArray<JavaThread*>* deferred,
+                                       jvmtiError* results) {
+  int count = deferred->length();
+  if (count == 0) {
+    return;
+  }
+  ResourceMark rm;
+  bool* did_suspend = NEW_RESOURCE_ARRAY(bool, count);
+  JvmtiSuspendControl::suspend_list(tlh, deferred->adr_at(0), (uint)count, did_suspend);
+  if (results == nullptr) {
+    return;
+  }
+  for (int i = 0; i < count; i++) {
+    if (did_suspend[i]) {
+      results[i] = JVMTI_ERROR_NONE;
+    } else if (deferred->at(i)->is_exiting()) {
+      // The thread was in the process of exiting.
+      results[i] = JVMTI_ERROR_THREAD_NOT_ALIVE;
+    } else {
+      // Thread is already suspended.
+      results[i] = JVMTI_ERROR_THREAD_SUSPENDED;
+    }
+  }
+}
+
 // java_thread - protected by ThreadsListHandle
 jvmtiError
 JvmtiEnvBase::resume_thread(oop thread_oop, JavaThread* java_thread, bool single_resume) {
@@ -90,8 +90,14 @@ class JvmtiEnvBase : public CHeapObj<mtInternal> {
   // It is unsafe to use this function when virtual threads are executed.
   static bool disable_virtual_threads_notify_jvmti();
 
+  // If deferred is not null, a java_thread which must be suspended with a
+  // handshake is appended to it instead, see suspend_deferred_threads().
   static jvmtiError suspend_thread(oop thread_oop, JavaThread* java_thread, bool single_suspend,
-                                   int* need_safepoint_p);
+                                   int* need_safepoint_p, GrowableArray<JavaThread*>* deferred = nullptr);
+  // Suspends the threads deferred by suspend_thread() with a single handshake,
+  // and stores the error for each of them in results, if not null.
+  static void suspend_deferred_threads(ThreadsListHandle* tlh, GrowableArray<JavaThread*>* deferred,
+                                       jvmtiError* results);
   static jvmtiError resume_thread(oop thread_oop, JavaThread* java_thread, bool single_resume);
   static jvmtiError check_thread_list(jint count, const jthread* list);
   static bool is_in_thread_list(jint count, const jthread* list, oop jt_oop);
@@ -893,6 +893,11 @@ bool JvmtiSuspendControl::suspend(JavaThread *java_thread) {
   return java_thread->java_suspend();
 }
 
+void JvmtiSuspendControl::suspend_list(ThreadsListHandle* tlh, JavaThread* const* threads,
+                                       uint count, bool* did_suspend) {
+  JavaThread::java_suspend_list(tlh, threads, count, did_suspend);
+}
+
 bool JvmtiSuspendControl::resume(JavaThread *java_thread) {
   return java_thread->java_resume();
 }
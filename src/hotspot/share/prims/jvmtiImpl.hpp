@@ -431,6 +431,9 @@ class JvmtiSuspendControl : public AllStatic {
 public:
   // suspend the thread, taking it to a safepoint
   static bool suspend(JavaThread *java_thread);
+  // suspend the threads with a single handshake, see JavaThread::java_suspend_list
+  static void suspend_list(ThreadsListHandle* tlh, JavaThread* const* threads,
+                           uint count, bool* did_suspend);
   // resume the thread
   static bool resume(JavaThread *java_thread);
 
@@ -29,6 +29,7 @@
 #include "classfile/vmClasses.hpp"
 #include "classfile/vmSymbols.hpp"
 #include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/workerThread.hpp"
 #include "jvmtifiles/jvmtiEnv.hpp"
 #include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
@@ -127,7 +128,7 @@ JvmtiTagMap* JvmtiTagMap::tag_map_for(JvmtiEnv* env) {
 }
 
 // iterate over all entries in the tag map.
-void JvmtiTagMap::entry_iterate(JvmtiTagMapKeyClosure* closure) {
+void JvmtiTagMap::entry_iterate(JvmtiTagMapEntryClosure* closure) {
   hashmap()->entry_iterate(closure);
 }
 
@@ -326,7 +327,7 @@ class TwoOopCallbackWrapper : public CallbackWrapper {
 //
 // This function is performance critical. If many threads attempt to tag objects
 // around the same time then it's possible that the Mutex associated with the
-// tag map will be a hot lock.
+// tag map will be a hot lock. Readers of the tags (GetTag) don't take it.
 void JvmtiTagMap::set_tag(jobject object, jlong tag) {
   MutexLocker ml(lock(), Mutex::_no_safepoint_check_flag);
 
@@ -352,14 +353,10 @@ void JvmtiTagMap::set_tag(jobject object, jlong tag) {
 }
 
 // get the tag for an object
+//
+// The lookup does not take the tag map lock. It can't post events or
+// clean the table, which is done by SetTag and the ServiceThread.
 jlong JvmtiTagMap::get_tag(jobject object) {
-  MutexLocker ml(lock(), Mutex::_no_safepoint_check_flag);
-
-  // GetTag should not post events because the JavaThread has to
-  // transition to native for the callback and this cannot stop for
-  // safepoints with the hashmap lock held.
-  check_hashmap(nullptr); /* don't collect dead objects */
-
   // resolve the object
   oop o = JNIHandles::resolve_non_null(object);
 
@@ -871,15 +868,136 @@ static jint invoke_primitive_field_callback_for_instance_fields(
 }
 
 
+// A filter that selects the objects which may be reported to the agent by
+// a heap iteration. It only applies the class and tag filters, which don't
+// depend on the agent, so it can be used by several worker threads at once
+// while the agent callbacks are still invoked by the VM thread.
+class JvmtiHeapIterationFilter : public BoolObjectClosure {
+ private:
+  JvmtiTagMap* _tag_map;
+  Klass* _klass;
+  bool _include_subclasses;
+  int _heap_filter;
+
+ public:
+  JvmtiHeapIterationFilter(JvmtiTagMap* tag_map, Klass* klass,
+                           bool include_subclasses, int heap_filter) :
+    _tag_map(tag_map),
+    _klass(klass),
+    _include_subclasses(include_subclasses),
+    _heap_filter(heap_filter) { }
+
+  // Returns true if the filter is expected to reject most of the heap,
+  // otherwise collecting the selected objects costs more than it saves.
+  bool is_selective() const {
+    if (_klass != nullptr && _klass != vmClasses::Object_klass()) {
+      return true;
+    }
+    return (_heap_filter & (JVMTI_HEAP_FILTER_UNTAGGED | JVMTI_HEAP_FILTER_CLASS_UNTAGGED)) != 0;
+  }
+
+  bool do_object_b(oop o) {
+    if (_klass != nullptr) {
+      if (_include_subclasses ? !o->is_a(_klass) : o->klass() != _klass) {
+        return false;
+      }
+    }
+    oop mirror = o->klass()->java_mirror();
+    if (mirror == nullptr) {
+      // dormant archived object, skipped by the heap iteration closures
+      return false;
+    }
+    if (_heap_filter == 0) {
+      return true;
+    }
+    // The lookups don't take the tag map lock, and the table can't change
+    // while the workers run in the safepoint.
+    jlong obj_tag = tag_for(_tag_map, o);
+    jlong klass_tag = tag_for(_tag_map, mirror);
+    return !is_filtered_by_heap_filter(obj_tag, klass_tag, _heap_filter);
+  }
+};
+
+typedef GrowableArrayCHeap<oop, mtServiceability> JvmtiOopArray;
+
+// Collects the objects selected by a JvmtiHeapIterationFilter, one array
+// of objects per worker.
+class JvmtiParHeapFilterTask : public WorkerTask {
+ private:
+  ParallelObjectIterator* _poi;
+  BoolObjectClosure* _filter;
+  JvmtiOopArray** _selected;
+
+  class SelectObjectClosure : public ObjectClosure {
+    BoolObjectClosure* _filter;
+    JvmtiOopArray* _selected;
+   public:
+    SelectObjectClosure(BoolObjectClosure* filter,
+                        JvmtiOopArray* selected) :
+      _filter(filter), _selected(selected) { }
+
+    void do_object(oop o) {
+      if (_filter->do_object_b(o)) {
+        _selected->append(o);
+      }
+    }
+  };
+
+ public:
+  JvmtiParHeapFilterTask(ParallelObjectIterator* poi, BoolObjectClosure* filter,
+                         JvmtiOopArray** selected) :
+    WorkerTask("JVMTI heap iteration"),
+    _poi(poi),
+    _filter(filter),
+    _selected(selected) { }
+
+  void work(uint worker_id) {
+    SelectObjectClosure cl(_filter, _selected[worker_id]);
+    _poi->object_iterate(&cl, worker_id);
+  }
+};
+
 // VM operation to iterate over all objects in the heap (both reachable
 // and unreachable)
 class VM_HeapIterateOperation: public VM_Operation {
  private:
   ObjectClosure* _blk;
+  JvmtiHeapIterationFilter* _filter;
   GrowableArray<jlong>* const _dead_objects;
+
+  // Select the objects with the safepoint workers, and then pass them to
+  // the closure in the VM thread. Returns false if there are no workers.
+  bool parallel_object_iterate() {
+    WorkerThreads* workers = Universe::heap()->safepoint_workers();
+    if (workers == nullptr) {
+      return false;
+    }
+    uint num_workers = workers->active_workers();
+    JvmtiOopArray** selected =
+      NEW_C_HEAP_ARRAY(JvmtiOopArray*, num_workers, mtServiceability);
+    for (uint i = 0; i < num_workers; i++) {
+      selected[i] = new JvmtiOopArray();
+    }
+    {
+      ParallelObjectIterator poi(num_workers);
+      JvmtiParHeapFilterTask task(&poi, _filter, selected);
+      workers->run_task(&task);
+    }
+    for (uint i = 0; i < num_workers; i++) {
+      JvmtiOopArray* objects = selected[i];
+      for (int j = 0; j < objects->length(); j++) {
+        _blk->do_object(objects->at(j));
+      }
+      delete objects;
+    }
+    FREE_C_HEAP_ARRAY(JvmtiOopArray*, selected);
+    return true;
+  }
+
  public:
-  VM_HeapIterateOperation(ObjectClosure* blk, GrowableArray<jlong>* objects) :
-    _blk(blk), _dead_objects(objects) { }
+  VM_HeapIterateOperation(ObjectClosure* blk, JvmtiHeapIterationFilter* filter,
+                          GrowableArray<jlong>* objects) :
+    _blk(blk), _filter(filter), _dead_objects(objects) { }
 
   VMOp_Type type() const { return VMOp_HeapIterateOperation; }
   void doit() {
@@ -898,6 +1016,10 @@ class VM_HeapIterateOperation: public VM_Operation {
     }
 
     // do the iteration
+    if (ParallelJvmtiHeapIteration && _filter->is_selective() &&
+        parallel_object_iterate()) {
+      return;
+    }
     Universe::heap()->object_iterate(_blk);
   }
 };
@@ -1133,7 +1255,10 @@ void JvmtiTagMap::iterate_over_heap(jvmtiHeapObjectFilter object_filter,
                                      object_filter,
                                      heap_object_callback,
                                      user_data);
-    VM_HeapIterateOperation op(&blk, &dead_objects);
+    int heap_filter = object_filter == JVMTI_HEAP_OBJECT_TAGGED   ? JVMTI_HEAP_FILTER_UNTAGGED :
+                      object_filter == JVMTI_HEAP_OBJECT_UNTAGGED ? JVMTI_HEAP_FILTER_TAGGED : 0;
+    JvmtiHeapIterationFilter filter(this, klass, true /* include_subclasses */, heap_filter);
+    VM_HeapIterateOperation op(&blk, &filter, &dead_objects);
     VMThread::execute(&op);
   }
   // Post events outside of Heap_lock
@@ -1160,7 +1285,8 @@ void JvmtiTagMap::iterate_through_heap(jint heap_filter,
                                         heap_filter,
                                         callbacks,
                                         user_data);
-    VM_HeapIterateOperation op(&blk, &dead_objects);
+    JvmtiHeapIterationFilter filter(this, klass, false /* include_subclasses */, heap_filter);
+    VM_HeapIterateOperation op(&blk, &filter, &dead_objects);
     VMThread::execute(&op);
   }
   // Post events outside of Heap_lock
@@ -1177,7 +1303,9 @@ void JvmtiTagMap::remove_dead_entries_locked(GrowableArray<jlong>* objects) {
     log_info(jvmti, table)("TagMap table needs cleaning%s",
                            ((objects != nullptr) ? " and posting" : ""));
     hashmap()->remove_dead_entries(objects);
-    _needs_cleaning = false;
+    // At a safepoint the dead entries are only reported, and are
+    // removed by the next cleaning outside of a safepoint.
+    _needs_cleaning = SafepointSynchronize::is_at_safepoint();
   }
 }
 
@@ -1232,7 +1360,7 @@ void JvmtiTagMap::flush_object_free_events() {
 
 // support class for get_objects_with_tags
 
-class TagObjectCollector : public JvmtiTagMapKeyClosure {
+class TagObjectCollector : public JvmtiTagMapEntryClosure {
  private:
   JvmtiEnv* _env;
   JavaThread* _thread;
@@ -1264,14 +1392,15 @@ class TagObjectCollector : public JvmtiTagMapKeyClosure {
   // - if it matches then we create a JNI local reference to the object
   // and record the reference and tag value.
   // Always return true so the iteration continues.
-  bool do_entry(JvmtiTagMapKey& key, jlong& value) {
+  bool do_entry(JvmtiTagMapEntry* entry) {
+    jlong value = entry->tag();
     for (int i = 0; i < _tag_count; i++) {
       if (_tags[i] == value) {
         // The reference in this tag map could be the only (implicitly weak)
         // reference to that object. If we hand it out, we need to keep it live wrt
         // SATB marking similar to other j.l.ref.Reference referents. This is
         // achieved by using a phantom load in the object() accessor.
-        oop o = key.object();
+        oop o = entry->object();
         if (o == nullptr) {
           _some_dead_found = true;
           // skip this whole entry
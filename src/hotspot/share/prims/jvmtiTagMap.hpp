@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2003, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2003, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -32,7 +32,7 @@
 
 class JvmtiEnv;
 class JvmtiTagMapTable;
-class JvmtiTagMapKeyClosure;
+class JvmtiTagMapEntryClosure;
 
 class JvmtiTagMap :  public CHeapObj<mtServiceability> {
  private:
@@ -53,7 +53,7 @@ class JvmtiTagMap :  public CHeapObj<mtServiceability> {
 
   void check_hashmap(GrowableArray<jlong>* objects);
 
-  void entry_iterate(JvmtiTagMapKeyClosure* closure);
+  void entry_iterate(JvmtiTagMapEntryClosure* closure);
 
  public:
   // indicates if this tag map is locked
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2020, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -23,70 +23,100 @@
  */
 
 #include "precompiled.hpp"
+#include "gc/shared/collectedHeap.hpp"
+#include "logging/log.hpp"
 #include "memory/allocation.hpp"
 #include "memory/universe.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/weakHandle.inline.hpp"
 #include "prims/jvmtiExport.hpp"
 #include "prims/jvmtiTagMapTable.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/safepoint.hpp"
+#include "utilities/concurrentHashTable.inline.hpp"
+#include "utilities/growableArray.hpp"
+
+// 2^10 buckets initially, which is close to the 1007 buckets used before
+// the table became concurrent.
+const size_t START_SIZE = 10;
+const size_t END_SIZE = 30;
+// Grow the table when the average chain length exceeds this.
+const double PREF_AVG_LIST_LEN = 2.0;
+
+void JvmtiTagMapEntry::release_weak_handle() {
+  _wh.release(JvmtiExport::weak_tag_storage());
+}
 
+oop JvmtiTagMapEntry::object() const {
+  return _wh.resolve();
+}
 
-JvmtiTagMapKey::JvmtiTagMapKey(oop obj) : _obj(obj) {}
-
-JvmtiTagMapKey::JvmtiTagMapKey(const JvmtiTagMapKey& src) {
-  // move object into WeakHandle when copying into the table
-  if (src._obj != nullptr) {
-
-    // obj was read with AS_NO_KEEPALIVE, or equivalent, like during
-    // a heap walk.  The object needs to be kept alive when it is published.
-    Universe::heap()->keep_alive(src._obj);
+oop JvmtiTagMapEntry::object_no_keepalive() const {
+  return _wh.peek();
+}
 
-    _wh = WeakHandle(JvmtiExport::weak_tag_storage(), src._obj);
-  } else {
-    // resizing needs to create a copy.
-    _wh = src._wh;
-  }
-  // obj is always null after a copy.
-  _obj = nullptr;
+jlong JvmtiTagMapEntry::tag() const {
+  return Atomic::load(&_tag);
 }
 
-void JvmtiTagMapKey::release_weak_handle() {
-  _wh.release(JvmtiExport::weak_tag_storage());
+void JvmtiTagMapEntry::set_tag(jlong tag) {
+  Atomic::store(&_tag, tag);
 }
 
-oop JvmtiTagMapKey::object() const {
-  assert(_obj == nullptr, "Must have a handle and not object");
-  return _wh.resolve();
+void* JvmtiTagMapConfig::allocate_node(void* context, size_t size, Value const& value) {
+  static_cast<JvmtiTagMapTable*>(context)->item_added();
+  return AllocateHeap(size, mtServiceability);
 }
 
-oop JvmtiTagMapKey::object_no_keepalive() const {
-  assert(_obj == nullptr, "Must have a handle and not object");
-  return _wh.peek();
+void JvmtiTagMapConfig::free_node(void* context, void* memory, Value& value) {
+  value.release_weak_handle();
+  FreeHeap(memory);
+  static_cast<JvmtiTagMapTable*>(context)->item_removed();
 }
 
-static const int INITIAL_TABLE_SIZE = 1007;
-static const int MAX_TABLE_SIZE     = 0x3fffffff;
+class JvmtiTagMapLookup : public StackObj {
+  oop _obj;
+  uintx _hash;
+ public:
+  JvmtiTagMapLookup(oop obj, uintx hash) : _obj(obj), _hash(hash) {}
 
-JvmtiTagMapTable::JvmtiTagMapTable() : _table(INITIAL_TABLE_SIZE, MAX_TABLE_SIZE) {}
+  uintx get_hash() const {
+    return _hash;
+  }
 
-void JvmtiTagMapTable::clear() {
-  struct RemoveAll {
-    bool do_entry(JvmtiTagMapKey& entry, const jlong& tag) {
-      entry.release_weak_handle();
-      return true;
-    }
-  } remove_all;
-  // The unlink method of ResourceHashTable gets a pointer to a type whose 'do_entry(K,V)' method is callled
-  // while iterating over all the elements of the table. If the do_entry() method returns true the element
-  // will be removed.
-  // In this case, we always return true from do_entry to clear all the elements.
-  _table.unlink(&remove_all);
+  bool equals(JvmtiTagMapEntry* value) {
+    return value->hash() == _hash && value->object_no_keepalive() == _obj;
+  }
+
+  bool is_dead(JvmtiTagMapEntry* value) {
+    return false;
+  }
+};
+
+JvmtiTagMapTable::JvmtiTagMapTable() :
+  _items_count(0),
+  _table(START_SIZE, END_SIZE, JvmtiTagMapCHT::DEFAULT_GROW_HINT,
+         JvmtiTagMapCHT::DEFAULT_ENABLE_STATISTICS, Mutex::nosafepoint-2, this) {}
 
-  assert(_table.number_of_entries() == 0, "should have removed all entries");
+void JvmtiTagMapTable::item_added() {
+  Atomic::inc(&_items_count);
+}
+
+void JvmtiTagMapTable::item_removed() {
+  Atomic::dec(&_items_count);
+}
+
+void JvmtiTagMapTable::clear() {
+  assert_not_at_safepoint();
+  auto remove_all = [] (JvmtiTagMapEntry* entry) { return true; };
+  auto do_nothing = [] (JvmtiTagMapEntry* entry) {};
+  _table.bulk_delete(Thread::current(), remove_all, do_nothing);
+  assert(is_empty(), "should have removed all entries");
 }
 
 JvmtiTagMapTable::~JvmtiTagMapTable() {
-  clear();
+  // The remaining nodes and their weak handles are freed when _table
+  // is destroyed.
 }
 
 jlong JvmtiTagMapTable::find(oop obj) {
@@ -99,56 +129,89 @@ jlong JvmtiTagMapTable::find(oop obj) {
     return 0;
   }
 
-  JvmtiTagMapKey jtme(obj);
-  jlong* found = _table.get(jtme);
-  return found == nullptr ? 0 : *found;
+  JvmtiTagMapLookup lookup(obj, (uintx)obj->identity_hash());
+  jlong tag = 0;
+  auto get_tag = [&] (JvmtiTagMapEntry* entry) { tag = entry->tag(); };
+  _table.get(Thread::current(), lookup, get_tag);
+  return tag;
 }
 
 void JvmtiTagMapTable::add(oop obj, jlong tag) {
-  JvmtiTagMapKey new_entry(obj);
-  bool is_added;
-  if (obj->fast_no_hash_check()) {
-    // Can't be in the table so add it fast.
-    is_added = _table.put_when_absent(new_entry, tag);
-  } else {
-    jlong* value = _table.put_if_absent(new_entry, tag, &is_added);
-    *value = tag; // assign the new tag
+  Thread* thread = Thread::current();
+  uintx hash = (uintx)obj->identity_hash();
+  JvmtiTagMapLookup lookup(obj, hash);
+  auto update_tag = [&] (JvmtiTagMapEntry* entry) { entry->set_tag(tag); };
+  if (_table.get(thread, lookup, update_tag)) {
+    return;
   }
-  if (is_added) {
-    if (_table.maybe_grow(5, true /* use_large_table_sizes */)) {
-      int max_bucket_size = DEBUG_ONLY(_table.verify()) NOT_DEBUG(0);
-      log_info(jvmti, table) ("JvmtiTagMap table resized to %d for %d entries max bucket %d",
-                              _table.table_size(), _table.number_of_entries(), max_bucket_size);
-    }
+
+  // obj was read with AS_NO_KEEPALIVE, or equivalent, like during
+  // a heap walk.  The object needs to be kept alive when it is published.
+  Universe::heap()->keep_alive(obj);
+
+  JvmtiTagMapEntry entry(WeakHandle(JvmtiExport::weak_tag_storage(), obj), hash, tag);
+  // Updates are serialized by the tag map lock so there can be no racing
+  // insert of the same object.  If there were, the node for our entry is
+  // freed and its weak handle released by the table.
+  bool is_added = _table.insert(thread, lookup, entry);
+  assert(is_added, "must not have been added concurrently");
+  maybe_grow(thread);
+}
+
+void JvmtiTagMapTable::maybe_grow(Thread* thread) {
+  size_t size = (size_t)1 << _table.get_size_log2(thread);
+  if ((double)Atomic::load(&_items_count) / size <= PREF_AVG_LIST_LEN ||
+      _table.is_max_size_reached()) {
+    return;
+  }
+  if (_table.grow(thread)) {
+    log_info(jvmti, table) ("JvmtiTagMap table resized to " SIZE_FORMAT " for " SIZE_FORMAT " entries",
+                            (size_t)1 << _table.get_size_log2(thread), Atomic::load(&_items_count));
   }
 }
 
 void JvmtiTagMapTable::remove(oop obj) {
-  JvmtiTagMapKey jtme(obj);
-  auto clean = [] (JvmtiTagMapKey& entry, jlong tag) {
-    entry.release_weak_handle();
-  };
-  _table.remove(jtme, clean);
+  if (is_empty() || obj->fast_no_hash_check()) {
+    return;
+  }
+  JvmtiTagMapLookup lookup(obj, (uintx)obj->identity_hash());
+  _table.remove(Thread::current(), lookup);
 }
 
-void JvmtiTagMapTable::entry_iterate(JvmtiTagMapKeyClosure* closure) {
-  _table.iterate(closure);
+void JvmtiTagMapTable::entry_iterate(JvmtiTagMapEntryClosure* closure) {
+  auto do_entry = [&] (JvmtiTagMapEntry* entry) { return closure->do_entry(entry); };
+  if (SafepointSynchronize::is_at_safepoint()) {
+    _table.do_safepoint_scan(do_entry);
+  } else {
+    _table.do_scan(Thread::current(), do_entry);
+  }
 }
 
 void JvmtiTagMapTable::remove_dead_entries(GrowableArray<jlong>* objects) {
-  struct IsDead {
-    GrowableArray<jlong>* _objects;
-    IsDead(GrowableArray<jlong>* objects) : _objects(objects) {}
-    bool do_entry(JvmtiTagMapKey& entry, jlong tag) {
-      if (entry.object_no_keepalive() == nullptr) {
-        if (_objects != nullptr) {
-          _objects->append(tag);
+  if (SafepointSynchronize::is_at_safepoint()) {
+    // Nodes can't be unlinked at a safepoint, so report the dead entries
+    // and clear their tags, which keeps them from being reported again
+    // when they are removed after the safepoint.
+    auto report_dead = [&] (JvmtiTagMapEntry* entry) {
+      if (entry->object_no_keepalive() == nullptr && entry->tag() != 0) {
+        if (objects != nullptr) {
+          objects->append(entry->tag());
         }
-        entry.release_weak_handle();
-        return true;
+        entry->set_tag(0);
       }
-      return false;;
+      return true;
+    };
+    _table.do_safepoint_scan(report_dead);
+    return;
+  }
+
+  auto is_dead = [] (JvmtiTagMapEntry* entry) {
+    return entry->object_no_keepalive() == nullptr;
+  };
+  auto report_dead = [&] (JvmtiTagMapEntry* entry) {
+    if (objects != nullptr && entry->tag() != 0) {
+      objects->append(entry->tag());
     }
-  } is_dead(objects);
-  _table.unlink(&is_dead);
+  };
+  _table.bulk_delete(Thread::current(), is_dead, report_dead);
 }
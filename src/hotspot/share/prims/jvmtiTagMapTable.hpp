@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2020, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,54 +25,70 @@
 #ifndef SHARE_VM_PRIMS_TAGMAPTABLE_HPP
 #define SHARE_VM_PRIMS_TAGMAPTABLE_HPP
 
-#include "gc/shared/collectedHeap.hpp"
 #include "memory/allocation.hpp"
 #include "oops/weakHandle.hpp"
-#include "utilities/resizeableResourceHash.hpp"
+#include "runtime/atomic.hpp"
+#include "utilities/concurrentHashTable.hpp"
 
 class JvmtiEnv;
-class JvmtiTagMapKeyClosure;
+class JvmtiTagMapEntryClosure;
 
-// The oop is needed for lookup rather than creating a WeakHandle during
-// lookup because the HeapWalker may walk soon to be dead objects and
-// creating a WeakHandle for an otherwise dead object makes G1 unhappy.
+// An entry in the tag map. The object is held by a WeakHandle and the
+// identity hash of the object is recorded when the entry is created so
+// the table can be resized without touching the (possibly dead) object.
 //
-// This class is the Key type for inserting in ResizeableResourceHashTable
-// Its get_hash() and equals() methods are also used for getting the hash
-// value of a Key and comparing two Keys, respectively.
-class JvmtiTagMapKey : public CHeapObj<mtServiceability> {
+// The tag is updated in place while holding the tag map lock, and read
+// without any lock by JvmtiTagMapTable::find().
+class JvmtiTagMapEntry {
   WeakHandle _wh;
-  oop _obj; // temporarily hold obj while searching
+  uintx _hash;
+  volatile jlong _tag;
  public:
-  JvmtiTagMapKey(oop obj);
-  JvmtiTagMapKey(const JvmtiTagMapKey& src);
-  JvmtiTagMapKey& operator=(const JvmtiTagMapKey&) = delete;
+  JvmtiTagMapEntry(WeakHandle wh, uintx hash, jlong tag) : _wh(wh), _hash(hash), _tag(tag) {}
 
   oop object() const;
   oop object_no_keepalive() const;
   void release_weak_handle();
 
-  static unsigned get_hash(const JvmtiTagMapKey& entry) {
-    assert(entry._obj != nullptr, "must lookup obj to hash");
-    return (unsigned)entry._obj->identity_hash();
-  }
+  uintx hash() const  { return _hash; }
+  jlong tag() const;
+  void set_tag(jlong tag);
+};
+
+class JvmtiTagMapConfig : public AllStatic {
+ public:
+  typedef JvmtiTagMapEntry Value;
 
-  static bool equals(const JvmtiTagMapKey& lhs, const JvmtiTagMapKey& rhs) {
-    oop lhs_obj = lhs._obj != nullptr ? lhs._obj : lhs.object_no_keepalive();
-    oop rhs_obj = rhs._obj != nullptr ? rhs._obj : rhs.object_no_keepalive();
-    return lhs_obj == rhs_obj;
+  static uintx get_hash(Value const& value, bool* is_dead) {
+    // Dead entries are only removed by remove_dead_entries() so that
+    // their tags can be posted in ObjectFree events.
+    *is_dead = false;
+    return value.hash();
   }
+  static void* allocate_node(void* context, size_t size, Value const& value);
+  static void free_node(void* context, void* memory, Value& value);
 };
 
-typedef
-ResizeableResourceHashtable <JvmtiTagMapKey, jlong,
-                              AnyObj::C_HEAP, mtServiceability,
-                              JvmtiTagMapKey::get_hash,
-                              JvmtiTagMapKey::equals> ResizableResourceHT;
+typedef ConcurrentHashTable<JvmtiTagMapConfig, mtServiceability> JvmtiTagMapCHT;
 
+// The tag map is a concurrent hash table keyed on the object identity.
+// Lookups (GetTag and the heap walks' tag queries) do not take any lock.
+// Updates, removals and cleaning are serialized by the owning JvmtiTagMap's
+// lock, either by holding it or by running in the VM thread at a safepoint.
+//
+// The oop is needed for lookup rather than creating a WeakHandle during
+// lookup because the HeapWalker may walk soon to be dead objects and
+// creating a WeakHandle for an otherwise dead object makes G1 unhappy.
 class JvmtiTagMapTable : public CHeapObj<mtServiceability> {
+  friend class JvmtiTagMapConfig;
  private:
-  ResizableResourceHT _table;
+  // Declared before _table, which updates the count while it is destroyed.
+  volatile size_t _items_count;
+  JvmtiTagMapCHT _table;
+
+  void item_added();
+  void item_removed();
+  void maybe_grow(Thread* thread);
 
  public:
   JvmtiTagMapTable();
@@ -84,9 +100,9 @@ class JvmtiTagMapTable : public CHeapObj<mtServiceability> {
   void remove(oop obj);
 
   // iterate over all entries in the hashmap
-  void entry_iterate(JvmtiTagMapKeyClosure* closure);
+  void entry_iterate(JvmtiTagMapEntryClosure* closure);
 
-  bool is_empty() const { return _table.number_of_entries() == 0; }
+  bool is_empty() const { return Atomic::load(&_items_count) == 0; }
 
   // Cleanup cleared entries and store dead object tags in objects array
   void remove_dead_entries(GrowableArray<jlong>* objects);
@@ -94,9 +110,9 @@ class JvmtiTagMapTable : public CHeapObj<mtServiceability> {
 };
 
 // A supporting class for iterating over all entries in Hashmap
-class JvmtiTagMapKeyClosure {
+class JvmtiTagMapEntryClosure {
  public:
-  virtual bool do_entry(JvmtiTagMapKey& key, jlong& value) = 0;
+  virtual bool do_entry(JvmtiTagMapEntry* entry) = 0;
 };
 
 #endif // SHARE_VM_PRIMS_TAGMAPTABLE_HPP
@@ -941,7 +941,7 @@ void MethodHandles::add_dependent_nmethod(oop call_site, nmethod* nm) {
   // in order to avoid memory leak, stale entries are purged whenever a dependency list
   // is changed (both on addition and removal). Though memory reclamation is delayed,
   // it avoids indefinite memory usage growth.
-  deps.add_dependent_nmethod(nm);
+  deps.add_dependent_nmethod(nm, Dependencies::call_site_target_value);
 }
 
 void MethodHandles::clean_dependency_context(oop call_site) {
@@ -116,10 +116,16 @@ class CloseScopedMemoryClosure : public HandshakeClosure {
 
     ResourceMark rm;
     if (last_frame.is_compiled_frame() && last_frame.can_be_deoptimized()) {
+      // Compiled code may have hoisted the session liveness check of an inlined
+      // scoped access out of a loop, so it must be deoptimized to see the closed
+      // session. Code that inlined no scoped access cannot have done so.
       // FIXME: we would like to conditionally deoptimize only if the corresponding
       // _session is reachable from the frame, but reachabilityFence doesn't currently
-      // work the way it should. Therefore we deopt unconditionally for now.
-      Deoptimization::deoptimize(jt, last_frame);
+      // work the way it should. Therefore we deopt all such frames for now.
+      nmethod* nm = last_frame.cb()->as_nmethod();
+      if (nm->has_scoped_access()) {
+        Deoptimization::deoptimize(jt, last_frame);
+      }
     }
 
     if (jt->has_async_exception_condition()) {
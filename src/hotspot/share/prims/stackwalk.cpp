@@ -198,7 +198,14 @@ int StackWalk::fill_in_frames(jint mode, BaseFrameStream& stream,
 
     int index = end_index++;
     log_debug(stackwalk)("  frame %d: %s bci %d", index, stream.method()->external_name(), stream.bci());
-    stream.fill_frame(index, frames_array, methodHandle(THREAD, method), CHECK_0);
+    if (fill_class_info_only(mode)) {
+      // Only the declaring class and the method flags are recorded, which
+      // cannot safepoint, so the frame does not need a methodHandle or any
+      // other handle. This keeps the getCallerClass and Class-only walks cheap.
+      java_lang_ClassFrameInfo::init_class(frames_array->obj_at(index), method);
+    } else {
+      stream.fill_frame(index, frames_array, methodHandle(THREAD, method), CHECK_0);
+    }
     frames_decoded++;
 
     // End a batch on continuation bottom to let the Java side to set the continuation to its parent and continue
@@ -227,9 +234,7 @@ void JavaFrameStream::fill_frame(int index, objArrayHandle  frames_array,
     Handle stackFrame(THREAD, frames_array->obj_at(index));
     fill_stackframe(stackFrame, method, CHECK);
   } else {
-    HandleMark hm(THREAD);
-    Handle stackFrame(THREAD, frames_array->obj_at(index));
-    java_lang_ClassFrameInfo::init_class(stackFrame, method);
+    java_lang_ClassFrameInfo::init_class(frames_array->obj_at(index), method());
   }
 }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -153,6 +153,9 @@ class StackWalk : public AllStatic {
   static inline bool live_frame_info(jint mode) {
     return (mode & JVM_STACKWALK_FILL_LIVE_STACK_FRAMES) != 0;
   }
+  static inline bool fill_class_info_only(jint mode) {
+    return !need_method_info(mode) && !live_frame_info(mode);
+  }
 
 public:
   static inline bool need_method_info(jint mode) {
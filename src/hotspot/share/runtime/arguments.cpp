@@ -1831,6 +1831,17 @@ bool Arguments::check_vm_args_consistency() {
                 "-XX:+VerifyHeavyMonitors requires LockingMode == 0 (LM_MONITOR)\n");
     return false;
   }
+
+#if !defined(X86) && !defined(AARCH64)
+  if (UseObjectMonitorTable) {
+    FLAG_SET_CMDLINE(UseObjectMonitorTable, false);
+    warning("UseObjectMonitorTable not supported on this platform");
+  }
+#endif
+  if (UseObjectMonitorTable && LockingMode != LM_LIGHTWEIGHT) {
+    FLAG_SET_CMDLINE(UseObjectMonitorTable, false);
+    warning("UseObjectMonitorTable requires LockingMode == 2 (LM_LIGHTWEIGHT)");
+  }
   return status;
 }
 
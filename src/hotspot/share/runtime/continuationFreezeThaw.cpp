@@ -388,6 +388,7 @@ class FreezeBase : public StackObj {
   void set_jvmti_event_collector(JvmtiSampledObjectAllocEventCollector* jsoaec) { _jvmti_event_collector = jsoaec; }
 
   inline int size_if_fast_freeze_available();
+  int new_chunk_headroom();
 
 #ifdef ASSERT
   bool check_valid_fast_path();
@@ -535,7 +536,8 @@ freeze_result Freeze<ConfigT>::try_freeze_fast() {
   DEBUG_ONLY(_fast_freeze_size = size_if_fast_freeze_available();)
   assert(_fast_freeze_size == 0, "");
 
-  stackChunkOop chunk = allocate_chunk(cont_size() + frame::metadata_words, _cont.argsize() + frame::metadata_words_at_top);
+  stackChunkOop chunk = allocate_chunk(cont_size() + frame::metadata_words + new_chunk_headroom(),
+                                       _cont.argsize() + frame::metadata_words_at_top);
   if (freeze_fast_new_chunk(chunk)) {
     return freeze_ok;
   }
@@ -549,6 +551,24 @@ freeze_result Freeze<ConfigT>::try_freeze_fast() {
   return freeze_slow();
 }
 
+// Extra words given to a chunk allocated by the fast path, so that a later freeze
+// of a somewhat deeper stack can still reuse the chunk once it has been thawed.
+// The headroom is dropped if it would make the chunk humongous.
+int FreezeBase::new_chunk_headroom() {
+  if (ContinuationChunkHeadroomPercent == 0) {
+    return 0;
+  }
+  const int headroom = (int)(((int64_t)cont_size() * ContinuationChunkHeadroomPercent) / 100);
+  const size_t max_size = CollectedHeap::stack_chunk_max_size();
+  if (max_size > 0) {
+    InstanceStackChunkKlass* klass = InstanceStackChunkKlass::cast(vmClasses::StackChunk_klass());
+    if (klass->instance_size(cont_size() + frame::metadata_words + headroom) >= max_size) {
+      return 0;
+    }
+  }
+  return headroom;
+}
+
 // Returns size needed if the continuation fits, otherwise 0.
 int FreezeBase::size_if_fast_freeze_available() {
   stackChunkOop chunk = _cont.tail();
@@ -649,8 +669,9 @@ bool FreezeBase::freeze_fast_new_chunk(stackChunkOop chunk) {
 
   // in a fresh chunk, we freeze *with* the bottom-most frame's stack arguments.
   // They'll then be stored twice: in the chunk and in the parent chunk's top frame
-  const int chunk_start_sp = cont_size() + frame::metadata_words;
-  assert(chunk_start_sp == chunk->stack_size(), "");
+  // The chunk may have been allocated with headroom above the frames.
+  const int chunk_start_sp = chunk->stack_size();
+  assert(chunk_start_sp >= cont_size() + frame::metadata_words, "");
 
   DEBUG_ONLY(_orig_chunk_sp = chunk->start_address() + chunk_start_sp;)
 
@@ -1575,7 +1596,9 @@ static inline int freeze_internal(JavaThread* current, intptr_t* const sp) {
          "Held monitor count and locks on stack invariant: " INT64_FORMAT " JNI: " INT64_FORMAT, (int64_t)current->held_monitor_count(), (int64_t)current->jni_monitor_count());
 
   if (entry->is_pinned() || current->held_monitor_count() > 0) {
-    log_develop_debug(continuations)("PINNED due to critical section/hold monitor");
+    log_debug(continuations)("PINNED due to %s (held monitors: " INT64_FORMAT ", JNI monitors: " INT64_FORMAT ")",
+                             entry->is_pinned() ? "critical section" : "held monitor",
+                             (int64_t)current->held_monitor_count(), (int64_t)current->jni_monitor_count());
     verify_continuation(cont.continuation());
     freeze_result res = entry->is_pinned() ? freeze_pinned_cs : freeze_pinned_monitor;
     log_develop_trace(continuations)("=== end of freeze (fail %d)", res);
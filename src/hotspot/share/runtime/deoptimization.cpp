@@ -29,6 +29,7 @@
 #include "classfile/vmClasses.hpp"
 #include "code/codeCache.hpp"
 #include "code/debugInfoRec.hpp"
+#include "code/dependencies.hpp"
 #include "code/nmethod.hpp"
 #include "code/pcDesc.hpp"
 #include "code/scopeDesc.hpp"
@@ -106,8 +107,10 @@ uint64_t DeoptimizationScope::_committed_deopt_gen = 0;
 uint64_t DeoptimizationScope::_active_deopt_gen    = 1;
 bool     DeoptimizationScope::_committing_in_progress = false;
 
-DeoptimizationScope::DeoptimizationScope() : _required_gen(0) {
+DeoptimizationScope::DeoptimizationScope() : _required_gen(0), _marked_count(0), _cause(nullptr) {
   DEBUG_ONLY(_deopted = false;)
+  STATIC_ASSERT(Dependencies::TYPE_LIMIT <= max_dep_types);
+  memset(_marked_per_dep_type, 0, sizeof(_marked_per_dep_type));
 
   MutexLocker ml(NMethodState_lock, Mutex::_no_safepoint_check_flag);
   // If there is nothing to deopt _required_gen is the same as comitted.
@@ -137,6 +140,52 @@ void DeoptimizationScope::mark(nmethod* nm, bool inc_recompile_counts) {
 
   nm->_deoptimization_generation = DeoptimizationScope::_active_deopt_gen;
   _required_gen                  = DeoptimizationScope::_active_deopt_gen;
+  _marked_count++;
+}
+
+void DeoptimizationScope::mark(nmethod* nm, DepChange& changes, int dep_type) {
+  assert(dep_type > Dependencies::end_marker && dep_type < Dependencies::TYPE_LIMIT, "bad dependency type");
+  ConditionalMutexLocker ml(NMethodState_lock, !NMethodState_lock->owned_by_self(), Mutex::_no_safepoint_check_flag);
+
+  uint marked_count = _marked_count;
+  mark(nm, !changes.is_call_site_change());
+  if (_marked_count == marked_count) {
+    // Already marked by someone else.
+    return;
+  }
+  _marked_per_dep_type[dep_type]++;
+  if (_cause == nullptr) {
+    _cause = changes.is_call_site_change()  ? "call site target change" :
+             changes.is_klass_init_change() ? "class initialization" :
+                                              "class hierarchy change";
+  }
+}
+
+void DeoptimizationScope::report_marked() const {
+  if (_marked_count == 0) {
+    return;
+  }
+  // Report the most common type of broken dependency.
+  int dep_type = Dependencies::end_marker;
+  for (int i = Dependencies::end_marker + 1; i < Dependencies::TYPE_LIMIT; i++) {
+    if (_marked_per_dep_type[i] > _marked_per_dep_type[dep_type]) {
+      dep_type = i;
+    }
+  }
+  const char* cause = _cause != nullptr ? _cause : "other";
+  const char* dep_name = dep_type != Dependencies::end_marker ? Dependencies::dep_name((Dependencies::DepType)dep_type) : "none";
+  log_info(deoptimization)("Deoptimizing %u nmethods, cause: %s, most common broken dependency: %s (%u nmethods)",
+                           _marked_count, cause, dep_name, _marked_per_dep_type[dep_type]);
+#if INCLUDE_JFR
+  EventDependencyDeoptimization event;
+  if (event.should_commit()) {
+    event.set_cause(cause);
+    event.set_nmethodCount(_marked_count);
+    event.set_dependencyType(dep_name);
+    event.set_dependencyTypeCount(_marked_per_dep_type[dep_type]);
+    event.commit();
+  }
+#endif
 }
 
 void DeoptimizationScope::dependent(nmethod* nm) {
@@ -158,6 +207,8 @@ void DeoptimizationScope::deoptimize_marked() {
     return;
   }
 
+  report_marked();
+
   // Safepoints are a special case, handled here.
   if (SafepointSynchronize::is_at_safepoint()) {
     DeoptimizationScope::_committed_deopt_gen = DeoptimizationScope::_active_deopt_gen;
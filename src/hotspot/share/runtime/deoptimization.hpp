@@ -37,6 +37,7 @@ class ObjectValue;
 class AutoBoxObjectValue;
 class ScopeValue;
 class compiledVFrame;
+class DepChange;
 
 template<class E> class GrowableArray;
 
@@ -53,11 +54,23 @@ class DeoptimizationScope {
   uint64_t _required_gen;
   DEBUG_ONLY(bool _deopted;)
 
+  // Summary of the methods marked by this scope, for logging and JFR.
+  // Methods marked because of a broken dependency are also counted per
+  // dependency type.
+  static const int max_dep_types = 16;
+  uint        _marked_count;
+  uint        _marked_per_dep_type[max_dep_types];
+  const char* _cause;
+
+  void report_marked() const;
+
  public:
   DeoptimizationScope();
   ~DeoptimizationScope();
   // Mark a method, if already marked as dependent.
   void mark(nmethod* nm, bool inc_recompile_counts = true);
+  // Mark a method with a dependency of the given type broken by changes.
+  void mark(nmethod* nm, DepChange& changes, int dep_type);
   // Record this as a dependent method.
   void dependent(nmethod* nm);
 
@@ -167,6 +167,12 @@ const int ObjectAlignmentInBytes = 8;
   product(uint, HandshakeTimeout, 0, DIAGNOSTIC,                            \
           "If nonzero set a timeout in milliseconds for handshakes")        \
                                                                             \
+  product(uint, HandshakeWorkerThreads, 0, DIAGNOSTIC,                      \
+          "Number of worker threads that help the VMThread execute "        \
+          "handshake operations for blocked threads when many threads "     \
+          "are targeted (0 is off)")                                        \
+          range(0, 1024)                                                    \
+                                                                            \
   product(bool, AlwaysSafeConstructors, false, EXPERIMENTAL,                \
           "Force safe construction, as if all fields are final.")           \
                                                                             \
@@ -292,6 +298,13 @@ const int ObjectAlignmentInBytes = 8;
   product(size_t, InlineCacheBufferSize, 10*K, EXPERIMENTAL,                \
           "InlineCacheBuffer size")                                         \
                                                                             \
+  product(uint, InterfaceCallTypeCacheSize, 0, EXPERIMENTAL,                \
+          "Number of receiver classes and their selected methods that "     \
+          "are remembered per megamorphic interface call site and "         \
+          "checked before the itable is scanned, 0 disables the cache. "    \
+          "Only supported on x86_64")                                       \
+          range(0, 8)                                                       \
+                                                                            \
   product(bool, InlineArrayCopy, true, DIAGNOSTIC,                          \
           "Inline arraycopy native that is known to be part of "            \
           "base library DLL")                                               \
@@ -576,6 +589,28 @@ const int ObjectAlignmentInBytes = 8;
   product(bool, PrintNMTStatistics, false, DIAGNOSTIC,                      \
           "Print native memory tracking summary data if it is on")          \
                                                                             \
+  product(bool, NMTStripedMallocCounters, false, DIAGNOSTIC,                \
+          "Count mallocs for native memory tracking in per-thread stripes " \
+          "that are only summed up when reporting. Reported peak values "   \
+          "are then only approximate. Ignored if MallocLimit is set.")      \
+                                                                            \
+  product(size_t, NMTDetailSamplingInterval, 0, DIAGNOSTIC,                \
+          "With NativeMemoryTracking=detail, record the call stacks of "    \
+          "mallocs sampled every this many bytes on average, and scale "    \
+          "the malloc sites accordingly. 0 records every malloc.")          \
+          range(0, max_uintx)                                               \
+                                                                            \
+  product(uint, NMTUsageHistoryInterval, 0, DIAGNOSTIC,                    \
+          "Sample the native memory usage per memory type every this "      \
+          "many milliseconds into a ring buffer, used for the "             \
+          "NativeMemoryUsageGrowth event. 0 turns sampling off.")           \
+          range(0, 10000)                                                   \
+                                                                            \
+  product(uint, NMTUsageHistorySize, 60, DIAGNOSTIC,                        \
+          "Number of native memory usage samples kept, see "                \
+          "NMTUsageHistoryInterval")                                        \
+          range(2, 100000)                                                  \
+                                                                            \
   product(bool, LogCompilation, false, DIAGNOSTIC,                          \
           "Log compilation activity in detail to LogFile")                  \
                                                                             \
@@ -663,6 +698,15 @@ const int ObjectAlignmentInBytes = 8;
   product(bool, StackTraceInThrowable, true,                                \
           "Collect backtrace in throwable when exception happens")          \
                                                                             \
+  product(bool, UseStackTraceCache, false, EXPERIMENTAL,                    \
+          "Share the backtrace of throwables that are thrown from the "     \
+          "same stack")                                                     \
+                                                                            \
+  product(int, StackTraceCacheMaxDepth, 64, EXPERIMENTAL,                   \
+          "The maximum number of frames of a stack trace shared with "      \
+          "UseStackTraceCache")                                             \
+          range(1, 1024)                                                    \
+                                                                            \
   product(bool, OmitStackTraceInFastThrow, true,                            \
           "Omit backtraces for some 'hot' exceptions in optimized code")    \
                                                                             \
@@ -740,6 +784,13 @@ const int ObjectAlignmentInBytes = 8;
           "The maximum number of monitors to unlink in one batch. ")        \
           range(1, max_jint)                                                \
                                                                             \
+  product(intx, MonitorDeflationTimeSlice, 0, DIAGNOSTIC,                   \
+          "The maximum time in milliseconds to spend deflating monitors "   \
+          "in one async deflation cycle before unlinking and deleting "     \
+          "them. The next cycle continues where this one stopped "          \
+          "(0 is off).")                                                    \
+          range(0, max_jint)                                                \
+                                                                            \
   product(int, MonitorUsedDeflationThreshold, 90, DIAGNOSTIC,               \
           "Percentage of used monitors before triggering deflation (0 is "  \
           "off). The check is performed on AsyncDeflationInterval or "      \
@@ -784,6 +835,12 @@ const int ObjectAlignmentInBytes = 8;
   product(bool, UseFastJNIAccessors, true,                                  \
           "Use optimized versions of Get<Primitive>Field")                  \
                                                                             \
+  product(size_t, JNICriticalArrayCopyLimit, 0, EXPERIMENTAL,               \
+          "If pinning an object blocks garbage collections, let "           \
+          "GetPrimitiveArrayCritical return a copy of arrays of at most "   \
+          "this many bytes instead of pinning them. 0 means never copy")    \
+          range(0, max_jint)                                                \
+                                                                            \
   product(intx, MaxJNILocalCapacity, 65536,                                 \
           "Maximum allowable local JNI handle capacity to "                 \
           "EnsureLocalCapacity() and PushLocalFrame(), "                    \
@@ -808,6 +865,16 @@ const int ObjectAlignmentInBytes = 8;
   develop(bool, PrintFieldLayout, false,                                    \
           "Print field layout for each class")                              \
                                                                             \
+  product(ccstr, DumpFieldLayoutProfileFile, nullptr, EXPERIMENTAL,         \
+          "At exit, write the instance fields accessed by the methods "     \
+          "that ran, weighted by how often, to this file, for use with "    \
+          "FieldLayoutProfileFile")                                         \
+                                                                            \
+  product(ccstr, FieldLayoutProfileFile, nullptr, EXPERIMENTAL,             \
+          "Read the often accessed instance fields of a previous run, "     \
+          "written with DumpFieldLayoutProfileFile, and lay them out "      \
+          "together before the other fields of their class")                \
+                                                                            \
   /* Need to limit the extent of the padding to reasonable size.          */\
   /* 8K is well beyond the reasonable HW cache line size, even with       */\
   /* aggressive prefetching, while still leaving the room for segregating */\
@@ -912,6 +979,12 @@ const int ObjectAlignmentInBytes = 8;
   product(bool, VerifyBeforeIteration, false, DIAGNOSTIC,                   \
           "Verify memory system before JVMTI iteration")                    \
                                                                             \
+  product(bool, ParallelJvmtiHeapIteration, false,                          \
+          "Use the GC's safepoint worker threads to select the objects "    \
+          "passed to the agent by JVMTI IterateOverHeap and "               \
+          "IterateThroughHeap when a class or tag filter is given. The "    \
+          "agent callbacks are still invoked by the VM thread")             \
+                                                                            \
   /* compiler */                                                            \
                                                                             \
   /* notice: the max range value here is max_jint, not max_intx  */         \
@@ -931,11 +1004,39 @@ const int ObjectAlignmentInBytes = 8;
   product(bool, TraceCompilerThreads, false, DIAGNOSTIC,                    \
              "Trace creation and removal of compiler threads")              \
                                                                             \
+  product(uint, CompilerThreadCPUBudget, 0, EXPERIMENTAL,                   \
+          "Percentage of the CPUs available to the VM, which honors "       \
+          "container CPU quotas, that compiler threads may use. "           \
+          "Dynamically added compiler threads are limited to this budget "  \
+          "and compiler threads yield between compilations while they "     \
+          "exceed it. 0 disables the budget")                               \
+          range(0, 100)                                                     \
+                                                                            \
+  product(size_t, CompilerThreadChunkCacheSize, 0, EXPERIMENTAL,            \
+          "Maximum size in bytes of the arena chunks each compiler thread " \
+          "keeps for reuse by later compilations. 0 disables the cache")    \
+          range(0, max_uintx)                                               \
+                                                                            \
+  product(bool, CompilerThreadChunkCacheLargePages, false, EXPERIMENTAL,    \
+          "Advise transparent huge pages for arena chunks of compiler "     \
+          "threads which span large pages. Requires "                       \
+          "CompilerThreadChunkCacheSize and UseTransparentHugePages")       \
+                                                                            \
   product(ccstr, LogClassLoadingCauseFor, nullptr,                          \
           "Apply -Xlog:class+load+cause* to classes whose fully "           \
           "qualified name contains this string (\"*\" matches "             \
           "any class).")                                                    \
                                                                             \
+  product(ccstr, PreloadClassList, nullptr, EXPERIMENTAL,                   \
+          "Load and link the classes named in this class list on "          \
+          "background threads during startup. Uses the format of "          \
+          "-XX:DumpLoadedClassList; classes of custom class loaders "       \
+          "are skipped")                                                    \
+                                                                            \
+  product(uint, PreloadClassListThreads, 2, EXPERIMENTAL,                   \
+          "Number of threads used for PreloadClassList")                    \
+          range(1, 64)                                                      \
+                                                                            \
   develop(bool, InjectCompilerCreationFailure, false,                       \
           "Inject thread creation failures for "                            \
           "UseDynamicNumberOfCompilerThreads")                              \
@@ -1126,6 +1227,10 @@ const int ObjectAlignmentInBytes = 8;
   product_pd(bool, RewriteFrequentPairs,                                    \
           "Rewrite frequently used bytecode pairs into a single bytecode")  \
                                                                             \
+  product(bool, FuseFrequentPairs, false, EXPERIMENTAL,                     \
+          "Fuse frequent pairs of simple bytecodes into a single "          \
+          "bytecode when linking a class. Requires RewriteFrequentPairs")   \
+                                                                            \
   product(bool, PrintInterpreter, false, DIAGNOSTIC,                        \
           "Print the generated interpreter code")                           \
                                                                             \
@@ -1411,6 +1516,20 @@ const int ObjectAlignmentInBytes = 8;
   develop(bool, MetaspaceGuardAllocations, false,                           \
           "Metapace allocations are guarded.")                              \
                                                                             \
+  product(bool, MetaspaceReclaimFreeChunks, false, EXPERIMENTAL,            \
+          "When cleaning metaspaces of live class loaders, give back "      \
+          "chunks, and tails of chunks, which have entirely been "          \
+          "deallocated")                                                    \
+                                                                            \
+  product(bool, MetaspaceLargePages, false, EXPERIMENTAL,                   \
+          "Advise transparent huge pages for committed non-class "          \
+          "metaspace, where the OS supports them (see "                     \
+          "UseTransparentHugePages)")                                       \
+                                                                            \
+  product(bool, ClassSpaceLargePages, false, EXPERIMENTAL,                  \
+          "Advise transparent huge pages for the committed class space, "   \
+          "where the OS supports them (see UseTransparentHugePages)")       \
+                                                                            \
   product(uintx, MinHeapFreeRatio, 40, MANAGEABLE,                          \
           "The minimum percentage of heap free after GC to avoid expansion."\
           " For most GCs this applies to the old generation. In G1 and"     \
@@ -1538,6 +1657,22 @@ const int ObjectAlignmentInBytes = 8;
           "Size of code heap with non-nmethods (in bytes)")                 \
           constraint(VMPageSizeConstraintFunc, AtParse)                     \
                                                                             \
+  product(uintx, HotCodeHeapSize, 0, EXPERIMENTAL,                          \
+          "Size of code heap with hot non-profiled methods (in bytes), "    \
+          "taken from the non-profiled code heap. Aligned to the large "    \
+          "page size. 0 means no hot code heap. Requires "                  \
+          "SegmentedCodeCache.")                                            \
+          range(0, max_uintx)                                               \
+                                                                            \
+  product(intx, HotCodeHeapThreshold, 100000, EXPERIMENTAL,                 \
+          "Number of invocations and backedges at which an optimized "      \
+          "method is placed in the hot code heap")                          \
+          range(0, max_jint)                                                \
+                                                                            \
+  product(bool, NMethodRelocation, false, DIAGNOSTIC,                       \
+          "Allow relocating nmethods within the code cache, used by "       \
+          "the Compiler.codecache_compact diagnostic command")              \
+                                                                            \
   product_pd(uintx, CodeCacheExpansionSize,                                 \
           "Code cache expansion size (in bytes)")                           \
           range(32*K, max_uintx)                                            \
@@ -1669,6 +1804,12 @@ const int ObjectAlignmentInBytes = 8;
   develop(intx, MinOopMapAllocation,     8,                                 \
           "Minimum number of OopMap entries in an OopMapSet")               \
                                                                             \
+  product(int, OopMapCacheMaxTableSize, 256, DIAGNOSTIC,                    \
+          "Size of the largest overflow table the interpreter oop map "     \
+          "cache of a class can grow to when its entries collide. Each "    \
+          "overflow table is twice as large as the previous one")           \
+          range(32, 64 * K)                                                 \
+                                                                            \
   /* recompilation */                                                       \
   product_pd(intx, CompileThreshold,                                        \
           "number of interpreted method invocations before (re-)compiling") \
@@ -1811,6 +1952,10 @@ const int ObjectAlignmentInBytes = 8;
   product(bool, DTraceAllocProbes, false,                                   \
           "Enable dtrace tool probes for object allocation")                \
                                                                             \
+  product(bool, RecordAllocationSites, false, DIAGNOSTIC,                   \
+          "Aggregate TLAB refills and allocations outside TLABs per "       \
+          "allocation site, see jcmd GC.allocation_sites")                  \
+                                                                            \
   product(bool, DTraceMonitorProbes, false,                                 \
           "Enable dtrace tool probes for monitor events")                   \
                                                                             \
@@ -1822,6 +1967,16 @@ const int ObjectAlignmentInBytes = 8;
           "(will be rounded to nearest higher power of 2)")                 \
           range(minimumStringTableSize, 16777216ul /* 2^24 */)              \
                                                                             \
+  product(uintx, StringTableThreadCacheSize, 0,                             \
+          "Number of entries in the per-thread cache of recently "          \
+          "interned Strings, 0 disables the cache "                         \
+          "(will be rounded down to a power of 2)")                         \
+          range(0, 4096)                                                    \
+                                                                            \
+  product(bool, ConcurrentStringTableRehash, false,                         \
+          "Rehash the interned String table concurrently instead of at a "  \
+          "safepoint")                                                      \
+                                                                            \
   product(uintx, SymbolTableSize, defaultSymbolTableSize, EXPERIMENTAL,     \
           "Number of buckets in the JVM internal Symbol table")             \
           range(minimumSymbolTableSize, 16777216ul /* 2^24 */)              \
@@ -1834,6 +1989,17 @@ const int ObjectAlignmentInBytes = 8;
           "to be considered for deduplication")                             \
           range(1, markWord::max_age)                                       \
                                                                             \
+  product(uint, StringDeduplicationMinHitPercent, 0, EXPERIMENTAL,          \
+          "Mostly skip requests for strings of a size for which fewer "     \
+          "than this percentage of recent requests found a duplicate; "     \
+          "0 processes all requests")                                       \
+          range(0, 100)                                                     \
+                                                                            \
+  product(ccstr, DeduplicateByteArrayFields, nullptr, EXPERIMENTAL,         \
+          "Comma separated list of Class::field names of byte[] instance "  \
+          "fields whose arrays may be shared by deduplication. "            \
+          "The arrays must never be modified")                              \
+                                                                            \
   product(size_t, StringDeduplicationInitialTableSize, 500, EXPERIMENTAL,   \
           "Approximate initial number of buckets in the table")             \
           range(1, 1 * G)                                                   \
@@ -1908,6 +2074,12 @@ const int ObjectAlignmentInBytes = 8;
   product_pd(bool, VMContinuations, EXPERIMENTAL,                           \
           "Enable VM continuations support")                                \
                                                                             \
+  product(uint, ContinuationChunkHeadroomPercent, 0, EXPERIMENTAL,          \
+          "Extra space, as a percentage of the frozen frames, to reserve "  \
+          "in a stack chunk allocated by the fast freeze path so that "     \
+          "later freezes of a deeper stack can reuse the chunk")            \
+          range(0, 100)                                                     \
+                                                                            \
   develop(bool, LoomDeoptAfterThaw, false,                                  \
           "Deopt stack after thaw")                                         \
                                                                             \
@@ -1942,6 +2114,24 @@ const int ObjectAlignmentInBytes = 8;
   JFR_ONLY(product(ccstr, StartFlightRecording, nullptr,                    \
           "Start flight recording with options"))                           \
                                                                             \
+  JFR_ONLY(product(bool, JfrCacheStackTracePrefixes, false, EXPERIMENTAL,   \
+          "Reuse the stack frames of the previous JFR stack trace of a "    \
+          "thread for the outer part of its stack that is unchanged"))      \
+                                                                            \
+  JFR_ONLY(product(bool, JfrSampleThreadsByCPUTime, false, EXPERIMENTAL,    \
+          "Only take a JFR execution sample of a Java thread once it has "  \
+          "consumed a sampling period of cpu time since its last sample"))  \
+                                                                            \
+  JFR_ONLY(product(bool, JfrThrottleDeduplicateStackTraces, false,          \
+          EXPERIMENTAL,                                                     \
+          "Let throttled JFR events with a stack trace only be emitted "    \
+          "once per stack trace and throttling window"))                    \
+                                                                            \
+  JFR_ONLY(product(bool, JfrHandOffThreadLocalBuffers, false, EXPERIMENTAL, \
+          "Let the recorder thread write full JFR thread local buffers "    \
+          "to the chunk directly instead of copying them to global "        \
+          "buffers"))                                                       \
+                                                                            \
   product(bool, UseFastUnorderedTimeStamps, false, EXPERIMENTAL,            \
           "Use platform unstable time where supported for timestamps only") \
                                                                             \
@@ -1960,6 +2150,11 @@ const int ObjectAlignmentInBytes = 8;
           "2: monitors & new lightweight locking (LM_LIGHTWEIGHT, default)") \
           range(0, 2)                                                       \
                                                                             \
+  product(bool, UseObjectMonitorTable, false, DIAGNOSTIC,                   \
+          "With lightweight locking (LockingMode=2), keep the mapping from "\
+          "objects to their inflated ObjectMonitors in a concurrent hash "  \
+          "table instead of in the mark word")                              \
+                                                                            \
   product(uint, TrimNativeHeapInterval, 0,                                  \
           "Interval, in ms, at which the JVM will trim the native heap if " \
           "the platform supports that. Lower values will reclaim memory "   \
@@ -1967,6 +2162,12 @@ const int ObjectAlignmentInBytes = 8;
           "(default) disables native heap trimming.")                       \
           range(0, UINT_MAX)                                                \
                                                                             \
+  product(bool, TrimNativeHeapOnPressure, false, EXPERIMENTAL,              \
+          "Only trim the native heap every TrimNativeHeapInterval ms if "   \
+          "the OS reported memory pressure since the last trim, and trim "  \
+          "right after the JVM freed a lot of native memory, like after "   \
+          "class unloading")                                                \
+                                                                            \
   develop(bool, SimulateFullAddressSpace, false,                            \
           "Simulates a very populated, fragmented address space; no "       \
           "targeted reservations will succeed.")                            \
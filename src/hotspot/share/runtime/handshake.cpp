@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/vmSymbols.hpp"
+#include "gc/shared/workerThread.hpp"
 #include "jvm_io.h"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
@@ -43,7 +44,9 @@
 #include "utilities/formatBuffer.hpp"
 #include "utilities/filterQueue.inline.hpp"
 #include "utilities/globalDefinitions.hpp"
+#include "utilities/growableArray.hpp"
 #include "utilities/preserveException.hpp"
+#include "utilities/resourceHash.hpp"
 #include "utilities/systemMemoryBarrier.hpp"
 
 class HandshakeOperation : public CHeapObj<mtThread> {
@@ -155,8 +158,8 @@ class HandshakeSpinYield : public StackObj {
     _spin_time_ns = _spin_time_ns > max_spin_time_ns ? max_spin_time_ns : _spin_time_ns;
   }
 
-  void add_result(HandshakeState::ProcessResult pr) {
-    _result_count[current_result_pos()][pr]++;
+  void add_result(HandshakeState::ProcessResult pr, int count = 1) {
+    _result_count[current_result_pos()][pr] += count;
   }
 
   void process() {
@@ -233,10 +236,69 @@ static void log_handshake_info(jlong start_time_ns, const char* name, int target
   }
 }
 
+// Worker threads helping the VMThread process handshake operations for
+// blocked threads, created on first use. They are only used while the
+// VMThread executes a handshake operation, so no safepoint can start while
+// they process operations.
+static WorkerThreads* _handshake_workers = nullptr;
+
+// Number of targets each claim of a HandshakeProcessTask covers.
+static const uint HandshakeProcessChunk = 32;
+
+static uint handshake_workers_for(uint num_targets) {
+  assert(Thread::current()->is_VM_thread(), "only used by the VMThread");
+  uint wanted = MIN2(HandshakeWorkerThreads, num_targets / HandshakeProcessChunk);
+  if (wanted < 2) {
+    return 0;
+  }
+  if (_handshake_workers == nullptr) {
+    _handshake_workers = new WorkerThreads("Handshake Worker", HandshakeWorkerThreads);
+  }
+  return _handshake_workers->set_active_workers(wanted);
+}
+
+// One pass over the targets, trying to process the operation for each
+// of them, in parallel.
+class HandshakeProcessTask : public WorkerTask {
+  HandshakeOperation* const _op;
+  JavaThread* const* const  _targets;
+  const uint                _num_targets;
+  volatile uint             _next;
+  volatile int              _result_count[HandshakeState::_number_states];
+
+ public:
+  HandshakeProcessTask(HandshakeOperation* op, JavaThread* const* targets, uint num_targets) :
+    WorkerTask("Handshake Process Task"),
+    _op(op), _targets(targets), _num_targets(num_targets), _next(0), _result_count() {}
+
+  void work(uint worker_id) {
+    int result_count[HandshakeState::_number_states] = {};
+    for (uint start = Atomic::fetch_then_add(&_next, HandshakeProcessChunk);
+         start < _num_targets;
+         start = Atomic::fetch_then_add(&_next, HandshakeProcessChunk)) {
+      uint end = MIN2(start + HandshakeProcessChunk, _num_targets);
+      for (uint i = start; i < end; i++) {
+        result_count[_targets[i]->handshake_state()->try_process(_op)]++;
+      }
+    }
+    for (int i = 0; i < HandshakeState::_number_states; i++) {
+      if (result_count[i] != 0) {
+        Atomic::add(&_result_count[i], result_count[i]);
+      }
+    }
+  }
+
+  int result_count(HandshakeState::ProcessResult pr) const { return _result_count[pr]; }
+};
+
 class VM_HandshakeAllThreads: public VM_Operation {
   HandshakeOperation* const _op;
+  // The targets, or null to target all threads.
+  JavaThread* const* const  _targets;
+  const uint                _num_targets;
  public:
-  VM_HandshakeAllThreads(HandshakeOperation* op) : _op(op) {}
+  VM_HandshakeAllThreads(HandshakeOperation* op, JavaThread* const* targets = nullptr, uint num_targets = 0) :
+    _op(op), _targets(targets), _num_targets(num_targets) {}
 
   const char* cause() const { return _op->name(); }
 
@@ -245,10 +307,20 @@ class VM_HandshakeAllThreads: public VM_Operation {
   void doit() {
     jlong start_time_ns = os::javaTimeNanos();
 
-    JavaThreadIteratorWithHandle jtiwh;
+    // The requester protects explicit targets. A new thread on the
+    // ThreadsList will not have an operation, hence it is skipped in
+    // handshake_try_process.
+    ThreadsListHandle tlh;
+    JavaThread* const* targets = _targets;
+    uint num_targets = _num_targets;
+    if (targets == nullptr) {
+      targets = tlh.list()->threads();
+      num_targets = tlh.length();
+    }
+
     int number_of_threads_issued = 0;
-    for (JavaThread* thr = jtiwh.next(); thr != nullptr; thr = jtiwh.next()) {
-      thr->handshake_state()->add_operation(_op);
+    for (uint i = 0; i < num_targets; i++) {
+      targets[i]->handshake_state()->add_operation(_op);
       number_of_threads_issued++;
     }
     if (UseSystemMemoryBarrier) {
@@ -262,6 +334,8 @@ class VM_HandshakeAllThreads: public VM_Operation {
     // _op was created with a count == 1 so don't double count.
     _op->add_target_count(number_of_threads_issued - 1);
 
+    uint num_workers = handshake_workers_for(num_targets);
+
     log_trace(handshake)("Threads signaled, begin processing blocked threads by VMThread");
     HandshakeSpinYield hsy(start_time_ns);
     // Keeps count on how many of own emitted handshakes
@@ -274,14 +348,21 @@ class VM_HandshakeAllThreads: public VM_Operation {
       // Have VM thread perform the handshake operation for blocked threads.
       // Observing a blocked state may of course be transient but the processing is guarded
       // by mutexes and we optimistically begin by working on the blocked threads
-      jtiwh.rewind();
-      for (JavaThread* thr = jtiwh.next(); thr != nullptr; thr = jtiwh.next()) {
-        // A new thread on the ThreadsList will not have an operation,
-        // hence it is skipped in handshake_try_process.
-        HandshakeState::ProcessResult pr = thr->handshake_state()->try_process(_op);
-        hsy.add_result(pr);
-        if (pr == HandshakeState::_succeeded) {
-          emitted_handshakes_executed++;
+      if (num_workers > 0) {
+        HandshakeProcessTask task(_op, targets, num_targets);
+        _handshake_workers->run_task(&task, num_workers);
+        for (int i = 0; i < HandshakeState::_number_states; i++) {
+          HandshakeState::ProcessResult pr = static_cast<HandshakeState::ProcessResult>(i);
+          hsy.add_result(pr, task.result_count(pr));
+        }
+        emitted_handshakes_executed += task.result_count(HandshakeState::_succeeded);
+      } else {
+        for (uint i = 0; i < num_targets; i++) {
+          HandshakeState::ProcessResult pr = targets[i]->handshake_state()->try_process(_op);
+          hsy.add_result(pr);
+          if (pr == HandshakeState::_succeeded) {
+            emitted_handshakes_executed++;
+          }
         }
       }
       hsy.process();
@@ -293,7 +374,8 @@ class VM_HandshakeAllThreads: public VM_Operation {
     // by the Handshakee.
     OrderAccess::acquire();
 
-    log_handshake_info(start_time_ns, _op->name(), number_of_threads_issued, emitted_handshakes_executed);
+    log_handshake_info(start_time_ns, _op->name(), number_of_threads_issued, emitted_handshakes_executed,
+                       num_workers > 0 ? err_msg("Workers: %u", num_workers).buffer() : nullptr);
   }
 
   VMOp_Type type() const { return VMOp_HandshakeAllThreads; }
@@ -417,6 +499,21 @@ void Handshake::execute(HandshakeClosure* hs_cl, ThreadsListHandle* tlh, JavaThr
   log_handshake_info(start_time_ns, op.name(), 1, emitted_handshakes_executed);
 }
 
+void Handshake::execute(HandshakeClosure* hs_cl, ThreadsListHandle* tlh,
+                        JavaThread* const* targets, uint num_targets) {
+#ifdef ASSERT
+  for (uint i = 0; i < num_targets; i++) {
+    assert(tlh->includes(targets[i]), "target " INTPTR_FORMAT " not protected by tlh", p2i(targets[i]));
+  }
+#endif
+  if (num_targets == 0) {
+    return;
+  }
+  HandshakeOperation cto(hs_cl, nullptr, Thread::current());
+  VM_HandshakeAllThreads handshake(&cto, targets, num_targets);
+  VMThread::execute(&handshake);
+}
+
 void Handshake::execute(AsyncHandshakeClosure* hs_cl, JavaThread* target) {
   jlong start_time_ns = os::javaTimeNanos();
   AsyncHandshakeOperation* op = new AsyncHandshakeOperation(hs_cl, target, start_time_ns);
@@ -762,6 +859,36 @@ class SuspendThreadHandshake : public HandshakeClosure {
   bool did_suspend() { return _did_suspend; }
 };
 
+// This is the closure that synchronously honors the suspend requests for a
+// list of threads. It is executed for all of them as one handshake operation.
+class SuspendThreadListHandshake : public HandshakeClosure {
+  typedef ResourceHashtable<JavaThread*, uint, 1031, AnyObj::RESOURCE_AREA, mtThread> TargetIndexTable;
+  TargetIndexTable _target_index; // only read while the handshake runs
+  bool* const _did_suspend;
+public:
+  SuspendThreadListHandshake(JavaThread* const* targets, uint num_targets, bool* did_suspend) :
+    HandshakeClosure("SuspendThreadList"), _did_suspend(did_suspend) {
+    for (uint i = 0; i < num_targets; i++) {
+      bool created = _target_index.put(targets[i], i);
+      assert(created, "target " INTPTR_FORMAT " listed twice", p2i(targets[i]));
+      _did_suspend[i] = false;
+    }
+  }
+  void do_thread(Thread* thr) {
+    JavaThread* target = JavaThread::cast(thr);
+    uint* index = _target_index.get(target);
+    assert(index != nullptr, "not a target");
+    _did_suspend[*index] = target->handshake_state()->suspend_with_handshake();
+  }
+};
+
+void HandshakeState::suspend_list(ThreadsListHandle* tlh, JavaThread* const* targets,
+                                  uint num_targets, bool* did_suspend) {
+  ResourceMark rm;
+  SuspendThreadListHandshake st(targets, num_targets, did_suspend);
+  Handshake::execute(&st, tlh, targets, num_targets);
+}
+
 bool HandshakeState::suspend() {
   JVMTI_ONLY(assert(!_handshakee->is_in_VTMS_transition(), "no suspend allowed in VTMS transition");)
   JavaThread* self = JavaThread::current();
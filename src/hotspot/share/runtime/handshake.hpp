@@ -36,6 +36,7 @@ class HandshakeOperation;
 class AsyncHandshakeOperation;
 class JavaThread;
 class SuspendThreadHandshake;
+class SuspendThreadListHandshake;
 class ThreadSelfSuspensionHandshake;
 class UnsafeAccessErrorHandshake;
 class ThreadsListHandle;
@@ -79,6 +80,11 @@ class Handshake : public AllStatic {
   // This version of execute() relies on a ThreadListHandle somewhere in
   // the caller's context to protect target (and we sanity check for that).
   static void execute(AsyncHandshakeClosure*  hs_cl, JavaThread* target);
+  // Execute hs_cl for all of the num_targets targets, which must be protected
+  // by tlh, as one operation. Like the handshake of all threads, this is done
+  // by the VMThread, helped by HandshakeWorkerThreads for blocked targets.
+  static void execute(HandshakeClosure*       hs_cl, ThreadsListHandle* tlh,
+                      JavaThread* const* targets, uint num_targets);
 };
 
 class JvmtiRawMonitor;
@@ -90,6 +96,7 @@ class JvmtiRawMonitor;
 class HandshakeState {
   friend ThreadSelfSuspensionHandshake;
   friend SuspendThreadHandshake;
+  friend SuspendThreadListHandshake;
   friend UnsafeAccessErrorHandshake;
   friend JavaThread;
   // This a back reference to the JavaThread,
@@ -185,6 +192,10 @@ class HandshakeState {
 
   bool suspend();
   bool resume();
+  // Suspends the targets, which must not include the current thread,
+  // with a single handshake operation.
+  static void suspend_list(ThreadsListHandle* tlh, JavaThread* const* targets,
+                           uint num_targets, bool* did_suspend);
 };
 
 #endif // SHARE_RUNTIME_HANDSHAKE_HPP
@@ -161,6 +161,7 @@ void JavaThread::set_threadOopHandles(oop p) {
   _vthread     = OopHandle(_thread_oop_storage, p);
   _jvmti_vthread = OopHandle(_thread_oop_storage, p->is_a(vmClasses::BoundVirtualThread_klass()) ? p : nullptr);
   _scopedValueCache = OopHandle(_thread_oop_storage, nullptr);
+  _string_table_cache = OopHandle(_thread_oop_storage, nullptr);
 }
 
 oop JavaThread::threadObj() const {
@@ -211,6 +212,18 @@ void JavaThread::set_scopedValueCache(oop p) {
   }
 }
 
+oop JavaThread::string_table_cache() const {
+  return _string_table_cache.resolve();
+}
+
+// Threads without a java.lang.Thread object have no handle; they simply
+// do not get a cache.
+void JavaThread::set_string_table_cache(oop p) {
+  if (!_string_table_cache.is_empty()) {
+    _string_table_cache.replace(p);
+  }
+}
+
 void JavaThread::clear_scopedValueBindings() {
   set_scopedValueCache(nullptr);
   oop vthread_oop = vthread();
@@ -476,6 +489,7 @@ JavaThread::JavaThread(MEMFLAGS flags) :
 
   _jni_active_critical(0),
   _pending_jni_exception_check_fn(nullptr),
+  _errno_address(nullptr),
   _depth_first_number(0),
 
   // JVMTI PopFrame support
@@ -487,6 +501,8 @@ JavaThread::JavaThread(MEMFLAGS flags) :
   _cont_fastpath_thread_state(1),
   _held_monitor_count(0),
   _jni_monitor_count(0),
+  _profile_sample_countdown(1),
+  _profile_sample_seed(os::random() | 1),
 
   _handshake(this),
 
@@ -1187,6 +1203,19 @@ bool JavaThread::java_suspend() {
   return this->handshake_state()->suspend();
 }
 
+void JavaThread::java_suspend_list(ThreadsListHandle* tlh, JavaThread* const* targets,
+                                   uint num_targets, bool* did_suspend) {
+#ifdef ASSERT
+  for (uint i = 0; i < num_targets; i++) {
+    JavaThread* target = targets[i];
+    assert(target != JavaThread::current(), "use java_suspend() for self suspend");
+    JVMTI_ONLY(assert(!target->is_in_VTMS_transition(), "no suspend allowed in VTMS transition");)
+    JVMTI_ONLY(assert(!target->is_VTMS_transition_disabler(), "no suspend allowed for VTMS transition disablers");)
+  }
+#endif
+  HandshakeState::suspend_list(tlh, targets, num_targets, did_suspend);
+}
+
 bool JavaThread::java_resume() {
   guarantee(Thread::is_JavaThread_protected_by_TLH(/* target */ this),
             "missing ThreadsListHandle in calling context.");
@@ -1485,8 +1514,8 @@ void JavaThread::metadata_do(MetadataClosure* f) {
 }
 
 // Printing
-static const char* _get_thread_state_name(JavaThreadState _thread_state) {
-  switch (_thread_state) {
+const char* JavaThread::thread_state_name(JavaThreadState state) {
+  switch (state) {
   case _thread_uninitialized:     return "_thread_uninitialized";
   case _thread_new:               return "_thread_new";
   case _thread_new_trans:         return "_thread_new_trans";
@@ -1503,7 +1532,7 @@ static const char* _get_thread_state_name(JavaThreadState _thread_state) {
 }
 
 void JavaThread::print_thread_state_on(outputStream *st) const {
-  st->print_cr("   JavaThread state: %s", _get_thread_state_name(_thread_state));
+  st->print_cr("   JavaThread state: %s", thread_state_name(_thread_state));
 }
 
 // Called by Threads::print() for VM_PrintThreads operation
@@ -1566,7 +1595,7 @@ void JavaThread::print_on_error(outputStream* st, char *buf, int buflen) const {
     }
   }
   st->print(" [");
-  st->print("%s", _get_thread_state_name(_thread_state));
+  st->print("%s", thread_state_name(_thread_state));
   if (osthread()) {
     st->print(", id=%d", osthread()->thread_id());
   }
@@ -2242,7 +2271,7 @@ void JavaThread::pretouch_stack() {
 // Deferred OopHandle release support.
 
 class OopHandleList : public CHeapObj<mtInternal> {
-  static const int _count = 4;
+  static const int _count = 5;
   OopHandle _handles[_count];
   OopHandleList* _next;
   int _index;
@@ -2289,6 +2318,7 @@ void JavaThread::add_oop_handles_for_release() {
   new_head->add(_vthread);
   new_head->add(_jvmti_vthread);
   new_head->add(_scopedValueCache);
+  new_head->add(_string_table_cache);
   _oop_handle_list = new_head;
   Service_lock->notify_all();
 }
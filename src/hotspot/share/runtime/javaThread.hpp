@@ -95,6 +95,7 @@ class JavaThread: public Thread {
   OopHandle      _vthread; // the value returned by Thread.currentThread(): the virtual thread, if mounted, otherwise _threadObj
   OopHandle      _jvmti_vthread;
   OopHandle      _scopedValueCache;
+  OopHandle      _string_table_cache;            // Recently interned Strings, see StringTable
 
   static OopStorage* _thread_oop_storage;
 
@@ -442,6 +443,9 @@ class JavaThread: public Thread {
   // Checked JNI: function name requires exception check
   char* _pending_jni_exception_check_fn;
 
+  // Address of this thread's errno, read by FFM downcall stubs that capture it
+  int* _errno_address;
+
   // For deadlock detection.
   int _depth_first_number;
 
@@ -464,6 +468,10 @@ class JavaThread: public Thread {
   intx _held_monitor_count;  // used by continuations for fast lock detection
   intx _jni_monitor_count;
 
+  // Sampling of branch profile counter updates in C1 profiled code, see C1ProfileSamplingShift.
+  int _profile_sample_countdown;
+  int _profile_sample_seed;
+
 private:
 
   friend class VMThread;
@@ -531,6 +539,8 @@ class JavaThread: public Thread {
   oop scopedValueCache() const;
   void set_scopedValueCache(oop p);
   void clear_scopedValueBindings();
+  oop string_table_cache() const;
+  void set_string_table_cache(oop p);
   oop jvmti_vthread() const;
   void set_jvmti_vthread(oop p);
   oop vthread_or_thread() const;
@@ -635,6 +645,10 @@ class JavaThread: public Thread {
   // higher-level suspension/resume logic called by the public APIs
   bool java_suspend();
   bool java_resume();
+  // Suspends all the targets with a single handshake, did_suspend[i] tells
+  // if targets[i] was suspended like java_suspend() would.
+  static void java_suspend_list(ThreadsListHandle* tlh, JavaThread* const* targets,
+                                uint num_targets, bool* did_suspend);
   bool is_suspended()     { return _handshake.is_suspended(); }
 
   // Check for async exception in addition to safepoint.
@@ -766,6 +780,7 @@ class JavaThread: public Thread {
   static ByteSize pending_jni_exception_check_fn_offset() {
     return byte_offset_of(JavaThread, _pending_jni_exception_check_fn);
   }
+  static ByteSize errno_address_offset()         { return byte_offset_of(JavaThread, _errno_address); }
   static ByteSize last_Java_sp_offset() {
     return byte_offset_of(JavaThread, _anchor) + JavaFrameAnchor::last_Java_sp_offset();
   }
@@ -827,6 +842,8 @@ class JavaThread: public Thread {
   static ByteSize cont_fastpath_offset()      { return byte_offset_of(JavaThread, _cont_fastpath); }
   static ByteSize held_monitor_count_offset() { return byte_offset_of(JavaThread, _held_monitor_count); }
   static ByteSize jni_monitor_count_offset()  { return byte_offset_of(JavaThread, _jni_monitor_count); }
+  static ByteSize profile_sample_countdown_offset() { return byte_offset_of(JavaThread, _profile_sample_countdown); }
+  static ByteSize profile_sample_seed_offset()      { return byte_offset_of(JavaThread, _profile_sample_seed); }
 
 #if INCLUDE_JVMTI
   static ByteSize is_in_VTMS_transition_offset()     { return byte_offset_of(JavaThread, _is_in_VTMS_transition); }
@@ -875,6 +892,9 @@ class JavaThread: public Thread {
   const char* get_pending_jni_exception_check() const { return _pending_jni_exception_check_fn; }
   void set_pending_jni_exception_check(const char* fn_name) { _pending_jni_exception_check_fn = (char*) fn_name; }
 
+  // Must be called by the thread itself, errno is thread local
+  void set_errno_address(int* errno_address) { _errno_address = errno_address; }
+
   // For deadlock detection
   int depth_first_number() { return _depth_first_number; }
   void set_depth_first_number(int dfn) { _depth_first_number = dfn; }
@@ -923,6 +943,7 @@ class JavaThread: public Thread {
   void print_on(outputStream* st) const { print_on(st, false); }
   void print() const;
   void print_thread_state_on(outputStream*) const;
+  static const char* thread_state_name(JavaThreadState state);
   void print_on_error(outputStream* st, char* buf, int buflen) const;
   void print_name_on_error(outputStream* st, char* buf, int buflen) const;
   void verify();
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1998, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1998, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -53,6 +53,10 @@ OopStorage* JNIHandles::_weak_global_handles = nullptr;
 void jni_handles_init() {
   JNIHandles::_global_handles = OopStorageSet::create_strong("JNI Global", mtInternal);
   JNIHandles::_weak_global_handles = OopStorageSet::create_weak("JNI Weak", mtInternal);
+  // Global handles are often created and destroyed by the same thread, so
+  // let threads cache entries to avoid contention on the storage locks.
+  JNIHandles::_global_handles->enable_thread_local_caching();
+  JNIHandles::_weak_global_handles->enable_thread_local_caching();
 }
 
 jobject JNIHandles::make_local(oop obj) {
@@ -417,7 +421,7 @@ void JNIHandleBlock::oops_do(OopClosure* f) {
 }
 
 
-jobject JNIHandleBlock::allocate_handle(JavaThread* caller, oop obj, AllocFailType alloc_failmode) {
+jobject JNIHandleBlock::allocate_handle_slow(JavaThread* caller, oop obj, AllocFailType alloc_failmode) {
   assert(Universe::heap()->is_in(obj), "sanity check");
   if (_top == 0) {
     // This is the first allocation or the initial block got zapped when
@@ -465,7 +469,7 @@ jobject JNIHandleBlock::allocate_handle(JavaThread* caller, oop obj, AllocFailTy
   if (_last->_next != nullptr) {
     // update last and retry
     _last = _last->_next;
-    return allocate_handle(caller, obj, alloc_failmode);
+    return allocate_handle_slow(caller, obj, alloc_failmode);
   }
 
   // No space available, we have to rebuild free list or expand
@@ -479,7 +483,7 @@ jobject JNIHandleBlock::allocate_handle(JavaThread* caller, oop obj, AllocFailTy
     _last = _last->_next;
     _allocate_before_rebuild--;
   }
-  return allocate_handle(caller, obj, alloc_failmode);  // retry
+  return allocate_handle_slow(caller, obj, alloc_failmode);  // retry
 }
 
 void JNIHandleBlock::rebuild_free_list() {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1998, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1998, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -165,9 +165,12 @@ class JNIHandleBlock : public CHeapObj<mtInternal> {
   // No more handles in the both the current and following blocks
   void clear() { _top = 0; }
 
+  // Handle allocation when the last block is full or the chain has been cleared
+  jobject allocate_handle_slow(JavaThread* caller, oop obj, AllocFailType alloc_failmode);
+
  public:
-  // Handle allocation
-  jobject allocate_handle(JavaThread* caller, oop obj, AllocFailType alloc_failmode = AllocFailStrategy::EXIT_OOM);
+  // Handle allocation, bumps the top of the last block in the common case
+  inline jobject allocate_handle(JavaThread* caller, oop obj, AllocFailType alloc_failmode = AllocFailStrategy::EXIT_OOM);
 
   // Block allocation and block free list management
   static JNIHandleBlock* allocate_block(JavaThread* thread = nullptr, AllocFailType alloc_failmode = AllocFailStrategy::EXIT_OOM);
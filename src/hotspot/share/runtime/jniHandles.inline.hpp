@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -32,6 +32,16 @@
 #include "utilities/debug.hpp"
 #include "utilities/globalDefinitions.hpp"
 
+inline jobject JNIHandleBlock::allocate_handle(JavaThread* caller, oop obj, AllocFailType alloc_failmode) {
+  // A non-zero top of the first block means that _last is valid.
+  if (_top != 0 && _last->_top < block_size_in_oops) {
+    oop* handle = (oop*)&(_last->_handles)[_last->_top++];
+    *handle = obj;
+    return (jobject) handle;
+  }
+  return allocate_handle_slow(caller, obj, alloc_failmode);
+}
+
 inline bool JNIHandles::is_tagged_with(jobject handle, TypeTag tag) {
   return (reinterpret_cast<uintptr_t>(handle) & tag_mask) == tag;
 }
@@ -48,7 +48,7 @@ const int LockStack::lock_stack_top_offset =  in_bytes(JavaThread::lock_stack_to
 const int LockStack::lock_stack_base_offset = in_bytes(JavaThread::lock_stack_base_offset());
 
 LockStack::LockStack(JavaThread* jt) :
-  _top(lock_stack_base_offset), _base() {
+  _top(lock_stack_base_offset), _base(), _monitor_cache() {
   // Make sure the layout of the object is compatible with the emitted code's assumptions.
   STATIC_ASSERT(sizeof(_bad_oop_sentinel) == oopSize);
   STATIC_ASSERT(sizeof(_base[0]) == oopSize);
@@ -73,6 +73,43 @@ uint32_t LockStack::end_offset() {
   return static_cast<uint32_t>(offset);
 }
 
+ObjectMonitor* LockStack::get_cached_monitor(oop o) const {
+  assert(UseObjectMonitorTable, "must be");
+  for (int i = 0; i < MONITOR_CACHE_CAPACITY; i++) {
+    ObjectMonitor* monitor = _monitor_cache[i];
+    if (monitor == nullptr) {
+      break;
+    }
+    if (monitor->object_peek() == o) {
+      // A deflated monitor stays cached until the next deflation handshake,
+      // but may already have been replaced by a new monitor of the object.
+      return monitor->is_being_async_deflated() ? nullptr : monitor;
+    }
+  }
+  return nullptr;
+}
+
+void LockStack::set_cached_monitor(ObjectMonitor* monitor) {
+  assert(UseObjectMonitorTable, "must be");
+  assert(is_owning_thread(), "only the owning thread may update its monitor cache");
+  // Shift the entries down to the old position of the monitor, or over the
+  // least recently used entry.
+  int i = 0;
+  while (i < MONITOR_CACHE_CAPACITY - 1 && _monitor_cache[i] != monitor) {
+    i++;
+  }
+  for (; i > 0; i--) {
+    _monitor_cache[i] = _monitor_cache[i - 1];
+  }
+  _monitor_cache[0] = monitor;
+}
+
+void LockStack::clear_monitor_cache() {
+  for (int i = 0; i < MONITOR_CACHE_CAPACITY; i++) {
+    _monitor_cache[i] = nullptr;
+  }
+}
+
 #ifndef PRODUCT
 void LockStack::verify(const char* msg) const {
   assert(LockingMode == LM_LIGHTWEIGHT, "never use lock-stack when light weight locking is disabled");
@@ -32,6 +32,7 @@
 #include "utilities/sizes.hpp"
 
 class JavaThread;
+class ObjectMonitor;
 class OopClosure;
 class outputStream;
 template<typename>
@@ -43,6 +44,7 @@ class LockStack {
   JVMCI_ONLY(friend class JVMCIVMStructs;)
 public:
   static const int CAPACITY = 8;
+  static const int MONITOR_CACHE_CAPACITY = 4;
 private:
 
   // TODO: It would be very useful if JavaThread::lock_stack_offset() and friends were constexpr,
@@ -60,6 +62,11 @@ class LockStack {
   // The correct layout is statically asserted in the constructor.
   const uintptr_t _bad_oop_sentinel = badOopVal;
   oop _base[CAPACITY];
+  // The ObjectMonitors most recently found by this thread, most recent first.
+  // Only used with UseObjectMonitorTable, where the mark word of an inflated
+  // object does not refer to its ObjectMonitor. Cleared by the handshake of
+  // each deflation cycle, before deflated monitors are deleted.
+  ObjectMonitor* _monitor_cache[MONITOR_CACHE_CAPACITY];
 
   // Get the owning thread of this lock-stack.
   inline JavaThread* get_thread() const;
@@ -116,6 +123,15 @@ class LockStack {
   // Tests whether the oop is on this lock-stack.
   inline bool contains(oop o) const;
 
+  // Returns the cached ObjectMonitor of the oop, or null if it is not cached
+  // or its monitor is being deflated.
+  ObjectMonitor* get_cached_monitor(oop o) const;
+
+  // Makes the monitor the most recently used entry of the monitor cache.
+  void set_cached_monitor(ObjectMonitor* monitor);
+
+  void clear_monitor_cache();
+
   // GC support
   inline void oops_do(OopClosure* cl);
 
@@ -52,6 +52,7 @@
 #include "runtime/safefetch.hpp"
 #include "runtime/safepointMechanism.inline.hpp"
 #include "runtime/sharedRuntime.hpp"
+#include "runtime/threadSMR.hpp"
 #include "services/threadService.hpp"
 #include "utilities/dtrace.hpp"
 #include "utilities/globalDefinitions.hpp"
@@ -396,7 +397,7 @@ bool ObjectMonitor::enter(JavaThread* current) {
   if (TrySpin(current)) {
     assert(owner_raw() == current, "must be current: owner=" INTPTR_FORMAT, p2i(owner_raw()));
     assert(_recursions == 0, "must be 0: recursions=" INTX_FORMAT, _recursions);
-    assert(object()->mark() == markWord::encode(this),
+    assert(is_object_mark_inflated(),
            "object mark must match encoded this: mark=" INTPTR_FORMAT
            ", encoded this=" INTPTR_FORMAT, object()->mark().value(),
            markWord::encode(this).value());
@@ -487,7 +488,7 @@ bool ObjectMonitor::enter(JavaThread* current) {
   assert(_recursions == 0, "invariant");
   assert(owner_raw() == current, "invariant");
   assert(_succ != current, "invariant");
-  assert(object()->mark() == markWord::encode(this), "invariant");
+  assert(is_object_mark_inflated(), "invariant");
 
   // The thread -- now the owner -- is back in vm mode.
   // Report the glorious news via TI,DTrace and jvmstat.
@@ -630,6 +631,13 @@ bool ObjectMonitor::deflate_monitor() {
   return true;  // Success, ObjectMonitor has been deflated.
 }
 
+#ifdef ASSERT
+bool ObjectMonitor::is_object_mark_inflated() const {
+  const markWord mark = object()->mark();
+  return UseObjectMonitorTable ? mark.has_monitor() : mark == markWord::encode(const_cast<ObjectMonitor*>(this));
+}
+#endif
+
 // Install the displaced mark word (dmw) of a deflating ObjectMonitor
 // into the header of the object associated with the monitor. This
 // idempotent method is called by a thread that is deflating a
@@ -643,6 +651,13 @@ void ObjectMonitor::install_displaced_markword_in_object(const oop obj) {
 
   guarantee(obj != nullptr, "must be non-null");
 
+  if (UseObjectMonitorTable) {
+    // The mark word does not tell which monitor its monitor bits belong
+    // to, so only the deflating thread clears them, after which it removes
+    // the monitor from the table (see ObjectSynchronizer::deflate_monitor_list).
+    return;
+  }
+
   // Separate loads in is_being_async_deflated(), which is almost always
   // called before this function, from the load of dmw/header below.
 
@@ -975,7 +990,7 @@ void ObjectMonitor::ReenterI(JavaThread* current, ObjectWaiter* currentNode) {
   assert(currentNode != nullptr, "invariant");
   assert(currentNode->_thread == current, "invariant");
   assert(_waiters > 0, "invariant");
-  assert(object()->mark() == markWord::encode(this), "invariant");
+  assert(is_object_mark_inflated(), "invariant");
 
   assert(current->thread_state() != _thread_blocked, "invariant");
 
@@ -1042,7 +1057,7 @@ void ObjectMonitor::ReenterI(JavaThread* current, ObjectWaiter* currentNode) {
   // In addition, current.TState is stable.
 
   assert(owner_raw() == current, "invariant");
-  assert(object()->mark() == markWord::encode(this), "invariant");
+  assert(is_object_mark_inflated(), "invariant");
   UnlinkAfterAcquire(current, currentNode);
   if (_succ == current) _succ = nullptr;
   assert(_succ != current, "invariant");
@@ -1668,7 +1683,7 @@ void ObjectMonitor::wait(jlong millis, bool interruptible, TRAPS) {
   // Verify a few postconditions
   assert(owner_raw() == current, "invariant");
   assert(_succ != current, "invariant");
-  assert(object()->mark() == markWord::encode(this), "invariant");
+  assert(is_object_mark_inflated(), "invariant");
 
   // check if the notification happened
   if (!WasNotified) {
@@ -1888,6 +1903,40 @@ inline static int adjust_down(int spin_duration) {
   }
 }
 
+// Spinning is futile while the owner cannot make progress towards releasing
+// the monitor, for instance because it is itself blocked in the VM or runs
+// native code. This is a one-time check per spin attempt; the owner is only
+// inspected while protected by a ThreadsListHandle, so an owner that is not
+// a live JavaThread (anonymous owner, BasicLock*, exited thread) is treated
+// as running.
+bool ObjectMonitor::owner_is_not_running(JavaThread* current, void* owner) {
+  if (owner == nullptr || owner == anon_owner_ptr() || owner == DEFLATER_MARKER) {
+    return false;
+  }
+  ThreadsListHandle tlh(current);
+  JavaThread* jt = static_cast<JavaThread*>(owner);
+  if (!tlh.includes(jt)) {
+    return false;
+  }
+  switch (jt->thread_state()) {
+    case _thread_blocked:
+    case _thread_blocked_trans:
+    case _thread_in_native:
+    case _thread_in_native_trans:
+      return true;
+    default:
+      return false;
+  }
+}
+
+volatile uint64_t ObjectMonitor::_spin_successes         = 0;
+volatile uint64_t ObjectMonitor::_spin_failures          = 0;
+volatile uint64_t ObjectMonitor::_spin_owner_not_running = 0;
+
+uint64_t ObjectMonitor::spin_successes()         { return Atomic::load(&_spin_successes); }
+uint64_t ObjectMonitor::spin_failures()          { return Atomic::load(&_spin_failures); }
+uint64_t ObjectMonitor::spin_owner_not_running() { return Atomic::load(&_spin_owner_not_running); }
+
 bool ObjectMonitor::short_fixed_spin(JavaThread* current, int spin_count, bool adapt) {
   for (int ctr = 0; ctr < spin_count; ctr++) {
     TryLockResult status = TryLock(current);
@@ -1906,6 +1955,12 @@ bool ObjectMonitor::short_fixed_spin(JavaThread* current, int spin_count, bool a
 
 // Spinning: Fixed frequency (100%), vary duration
 bool ObjectMonitor::TrySpin(JavaThread* current) {
+  bool success = spin_until_acquired(current);
+  Atomic::inc(success ? &_spin_successes : &_spin_failures, memory_order_relaxed);
+  return success;
+}
+
+bool ObjectMonitor::spin_until_acquired(JavaThread* current) {
 
   // Dumb, brutal spin.  Good for comparative measurements against adaptive spinning.
   int knob_fixed_spin = Knob_FixedSpin;  // 0 (don't spin: default), 2000 good test
@@ -2014,6 +2069,12 @@ bool ObjectMonitor::TrySpin(JavaThread* current) {
     if (ox != prv && prv != nullptr) {
       break;
     }
+    // Don't spin on an owner that is known not to be running. This
+    // is a spin failure without prejudice.
+    if (prv == nullptr && owner_is_not_running(current, ox)) {
+      Atomic::inc(&_spin_owner_not_running, memory_order_relaxed);
+      break;
+    }
     prv = ox;
 
     if (_succ == nullptr) {
@@ -213,6 +213,18 @@ class ObjectMonitor : public CHeapObj<mtObjectMonitor> {
 
   static int Knob_SpinLimit;
 
+  // Outcome of adaptive spinning, reported by the JavaMonitorSpinStatistics
+  // JFR event. _spin_owner_not_running counts spins that were given up early
+  // because the owner was blocked or in native code; unless the final
+  // acquisition attempt succeeds these are also counted as failures.
+  static volatile uint64_t _spin_successes;
+  static volatile uint64_t _spin_failures;
+  static volatile uint64_t _spin_owner_not_running;
+
+  static uint64_t spin_successes();
+  static uint64_t spin_failures();
+  static uint64_t spin_owner_not_running();
+
   static ByteSize owner_offset()       { return byte_offset_of(ObjectMonitor, _owner); }
   static ByteSize recursions_offset()  { return byte_offset_of(ObjectMonitor, _recursions); }
   static ByteSize cxq_offset()         { return byte_offset_of(ObjectMonitor, _cxq); }
@@ -261,6 +273,11 @@ class ObjectMonitor : public CHeapObj<mtObjectMonitor> {
   bool      owner_is_DEFLATER_MARKER() const;
   // Returns true if 'this' is being async deflated and false otherwise.
   bool      is_being_async_deflated();
+#ifdef ASSERT
+  // Returns true if the object's mark word shows that it is inflated to
+  // 'this'. With UseObjectMonitorTable only the monitor bits are checked.
+  bool      is_object_mark_inflated() const;
+#endif
   // Clear _owner field; current value must match old_value.
   void      release_clear_owner(void* old_value);
   // Simply set _owner field to new_value; current value must match old_value.
@@ -360,6 +377,8 @@ class ObjectMonitor : public CHeapObj<mtObjectMonitor> {
   TryLockResult  TryLock(JavaThread* current);
 
   bool      TrySpin(JavaThread* current);
+  bool      spin_until_acquired(JavaThread* current);
+  static bool owner_is_not_running(JavaThread* current, void* owner);
   bool      short_fixed_spin(JavaThread* current, int spin_count, bool adapt);
   void      ExitEpilog(JavaThread* current, ObjectWaiter* Wakee);
 
@@ -485,6 +485,10 @@ class os: AllStatic {
   struct size_change_t { size_t before; size_t after; };
   static bool trim_native_heap(size_change_t* rss_change = nullptr);
 
+  // Returns true if the OS reported memory pressure for the process since
+  // the last call. Used to trim the native heap only when it matters.
+  static bool memory_pressure_reported();
+
   // A diagnostic function to print memory mappings in the given range.
   static void print_memory_mappings(char* addr, size_t bytes, outputStream* st);
   // Prints all mappings
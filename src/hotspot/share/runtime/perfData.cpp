@@ -32,8 +32,10 @@
 #include "runtime/java.hpp"
 #include "runtime/mutex.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/os.hpp"
 #include "runtime/perfData.inline.hpp"
+#include "runtime/thread.hpp"
 #include "utilities/exceptions.hpp"
 #include "utilities/globalDefinitions.hpp"
 
@@ -198,14 +200,50 @@ PerfLong::PerfLong(CounterNS ns, const char* namep, Units u, Variability v)
   create_entry(T_LONG, sizeof(jlong));
 }
 
+PerfLongStripes::PerfLongStripes() {
+  for (uint i = 0; i < num_stripes; i++) {
+    _stripes[i]._value = 0;
+  }
+}
+
+void PerfLongStripes::add(jlong val) {
+  // Spread the threads over the stripes. Thread objects are large, so
+  // the low bits of their addresses carry little information.
+  const uintptr_t t = (uintptr_t)Thread::current_or_null();
+  const uint index = (uint)((t >> 6) ^ (t >> 12) ^ (t >> 18)) % num_stripes;
+  Atomic::add(&_stripes[index]._value, val, memory_order_relaxed);
+}
+
+jlong PerfLongStripes::take_sample() {
+  jlong sum = 0;
+  for (uint i = 0; i < num_stripes; i++) {
+    sum += Atomic::load(&_stripes[i]._value);
+  }
+  return sum;
+}
+
 PerfLongVariant::PerfLongVariant(CounterNS ns, const char* namep, Units u,
                                  Variability v, PerfLongSampleHelper* helper)
                                 : PerfLong(ns, namep, u, v),
-                                  _sample_helper(helper) {
+                                  _sample_helper(helper),
+                                  _stripes(nullptr) {
 
   sample();
 }
 
+PerfLongVariant::PerfLongVariant(CounterNS ns, const char* namep, Units u,
+                                 Variability v, PerfLongStripes* stripes)
+                                : PerfLong(ns, namep, u, v),
+                                  _sample_helper(stripes),
+                                  _stripes(stripes) {
+
+  sample();
+}
+
+PerfLongVariant::~PerfLongVariant() {
+  delete _stripes;
+}
+
 void PerfLongVariant::sample() {
   if (_sample_helper != nullptr) {
     *(jlong*)_valuep = _sample_helper->take_sample();
@@ -490,6 +528,27 @@ PerfLongCounter* PerfDataManager::create_long_counter(CounterNS ns,
   return p;
 }
 
+PerfLongCounter* PerfDataManager::create_striped_counter(CounterNS ns,
+                                                         const char* name,
+                                                         PerfData::Units u,
+                                                         TRAPS) {
+
+  // Sampled counters are not supported if UsePerfData is false.
+  if (!UsePerfData) return create_long_counter(ns, name, u, (jlong)0, THREAD);
+
+  PerfLongCounter* p = new PerfLongCounter(ns, name, u, new PerfLongStripes());
+
+  if (!p->is_valid()) {
+    // allocation of native resources failed.
+    delete p;
+    THROW_0(vmSymbols::java_lang_OutOfMemoryError());
+  }
+
+  add_item(p, true);
+
+  return p;
+}
+
 PerfDataList::PerfDataList(int length) {
 
   _set = new (mtInternal) PerfDataArray(length, mtInternal);
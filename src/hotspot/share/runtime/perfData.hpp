@@ -232,6 +232,18 @@ enum CounterNS {
  *
  *     As before, PerfSampleHelper is an alias for PerfLongSampleHelper.
  *
+ * Creating a counter that is incremented from many threads concurrently.
+ *
+ *     PerfCounter* baz_counter;
+ *     baz_counter = PerfDataManager::create_striped_counter(SUN_CLS, "baz",
+ *                                                           PerfData::U_Events,
+ *                                                           CHECK);
+ *     baz_counter->inc();
+ *
+ *     The increments are accumulated in per-thread striped slots that are
+ *     summed into the PerfData memory region by the StatSampler, so that
+ *     concurrent increments do not contend on a single cache line.
+ *
  * For additional uses of PerfData subtypes, see the utility classes
  * PerfTraceTime and PerfTraceTimedEvent below.
  *
@@ -350,6 +362,28 @@ class PerfLongSampleHelper : public CHeapObj<mtInternal> {
     virtual jlong take_sample() = 0;
 };
 
+/*
+ * PerfLongStripes is the sample helper of a striped counter. Increments
+ * are accumulated in cache line sized slots selected by the incrementing
+ * thread, and the StatSampler writes the sum of the slots to the PerfData
+ * memory region.
+ */
+class PerfLongStripes : public PerfLongSampleHelper {
+  private:
+    static const uint num_stripes = 16;
+
+    struct Stripe {
+      volatile jlong _value;
+      char _pad[DEFAULT_CACHE_LINE_SIZE - sizeof(jlong)];
+    };
+    Stripe _stripes[num_stripes];
+
+  public:
+    PerfLongStripes();
+    void add(jlong val);
+    jlong take_sample();
+};
+
 /*
  * PerfLong is the base class for the various Long PerfData subtypes.
  * it contains implementation details that are common among its derived
@@ -401,22 +435,41 @@ class PerfLongVariant : public PerfLong {
 
   protected:
     PerfLongSampleHelper* _sample_helper;
+    PerfLongStripes* _stripes;  // non-null if striped
 
     PerfLongVariant(CounterNS ns, const char* namep, Units u, Variability v,
                     jlong initial_value=0)
-                   : PerfLong(ns, namep, u, v) {
+                   : PerfLong(ns, namep, u, v),
+                     _sample_helper(nullptr), _stripes(nullptr) {
       if (is_valid()) *(jlong*)_valuep = initial_value;
     }
 
     PerfLongVariant(CounterNS ns, const char* namep, Units u, Variability v,
                     PerfLongSampleHelper* sample_helper);
 
+    PerfLongVariant(CounterNS ns, const char* namep, Units u, Variability v,
+                    PerfLongStripes* stripes);
+
+    ~PerfLongVariant();
+
     void sample();
 
   public:
-    inline void inc() { (*(jlong*)_valuep)++; }
-    inline void inc(jlong val) { (*(jlong*)_valuep) += val; }
+    inline void inc() { inc(1); }
+    inline void inc(jlong val) {
+      if (_stripes != nullptr) {
+        _stripes->add(val);
+      } else {
+        (*(jlong*)_valuep) += val;
+      }
+    }
     inline void dec(jlong val) { inc(-val); }
+
+    // the value of a striped counter in the PerfData memory region is only
+    // updated when sampled, so sum up the slots instead.
+    inline jlong get_value() {
+      return _stripes != nullptr ? _stripes->take_sample() : PerfLong::get_value();
+    }
 };
 
 /*
@@ -443,6 +496,11 @@ class PerfLongCounter : public PerfLongVariant {
                     PerfLongSampleHelper* sample_helper)
                    : PerfLongVariant(ns, namep, u, V_Monotonic,
                                      sample_helper) { }
+
+    PerfLongCounter(CounterNS ns, const char* namep, Units u,
+                    PerfLongStripes* stripes)
+                   : PerfLongVariant(ns, namep, u, V_Monotonic,
+                                     stripes) { }
 };
 
 /*
@@ -751,6 +809,11 @@ class PerfDataManager : AllStatic {
                                                 PerfLongSampleHelper* sh,
                                                 TRAPS);
 
+    // A counter for increments from many threads, see PerfLongStripes.
+    // Falls back to a plain counter if UsePerfData is false.
+    static PerfLongCounter* create_striped_counter(CounterNS ns, const char* name,
+                                                   PerfData::Units u, TRAPS);
+
 
     // these creation methods are provided for ease of use. These allow
     // Long performance data types to be created with a shorthand syntax.
@@ -804,6 +867,14 @@ class PerfDataManager : AllStatic {
   {counter = PerfDataManager::create_counter(counter_ns, counter_name, \
                                              PerfData::U_Bytes,CHECK);}
 
+#define NEWPERFSTRIPEDEVENTCOUNTER(counter, counter_ns, counter_name)  \
+  {counter = PerfDataManager::create_striped_counter(counter_ns, counter_name, \
+                                                     PerfData::U_Events,CHECK);}
+
+#define NEWPERFSTRIPEDBYTECOUNTER(counter, counter_ns, counter_name)  \
+  {counter = PerfDataManager::create_striped_counter(counter_ns, counter_name, \
+                                                     PerfData::U_Bytes,CHECK);}
+
 // Utility Classes
 
 /*
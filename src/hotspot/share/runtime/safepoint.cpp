@@ -36,6 +36,7 @@
 #include "gc/shared/workerUtils.hpp"
 #include "interpreter/interpreter.hpp"
 #include "jfr/jfrEvents.hpp"
+#include "jfr/support/jfrThreadId.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "memory/resourceArea.hpp"
@@ -195,6 +196,33 @@ static void back_off(int64_t start_time) {
   }
 }
 
+// Threads that were still running after the first check of the threads are
+// stragglers. Their time to safepoint is collected into a histogram with
+// buckets of <10us, <100us, <1ms, <10ms and >=10ms.
+static const int StragglerBuckets = 5;
+
+static void report_straggler(ThreadSafepointState* cur_tss, uint64_t safepoint_id, int* histogram) {
+  jlong time_to_safepoint = os::javaTimeNanos() - SafepointTracing::start_of_safepoint();
+  int bucket = 0;
+  for (jlong limit = 10 * (NANOUNITS / MICROUNITS); bucket < StragglerBuckets - 1 && time_to_safepoint >= limit; limit *= 10) {
+    bucket++;
+  }
+  histogram[bucket]++;
+
+  EventSafepointStragglers event;
+  if (event.should_commit()) {
+    JavaThread* thread = cur_tss->thread();
+    // The thread is safe now, so its last Java frame, if any, is walkable.
+    address pc = thread->has_last_Java_frame() ? thread->frame_anchor()->last_Java_pc() : nullptr;
+    event.set_safepointId(safepoint_id);
+    event.set_straggler(JFR_JVM_THREAD_ID(thread));
+    event.set_timeToSafepoint(time_to_safepoint);
+    event.set_lastRunningState(JavaThread::thread_state_name(cur_tss->last_running_state()));
+    event.set_lastJavaPC((u8)p2i(pc));
+    event.commit();
+  }
+}
+
 int SafepointSynchronize::synchronize_threads(jlong safepoint_limit_time, int nof_threads, int* initial_running)
 {
   JavaThreadIteratorWithHandle jtiwh;
@@ -235,6 +263,10 @@ int SafepointSynchronize::synchronize_threads(jlong safepoint_limit_time, int no
   int iterations = 1; // The first iteration is above.
   int64_t start_time = os::javaTimeNanos();
 
+  // The safepoint id is incremented once synchronized.
+  const uint64_t safepoint_id = _safepoint_id + 1;
+  int histogram[StragglerBuckets] = {};
+
   do {
     // Check if this has taken too long:
     if (SafepointTimeout && safepoint_limit_time < os::javaTimeNanos()) {
@@ -246,6 +278,7 @@ int SafepointSynchronize::synchronize_threads(jlong safepoint_limit_time, int no
     while (cur_tss != nullptr) {
       assert(cur_tss->is_running(), "Illegal initial state");
       if (thread_not_running(cur_tss)) {
+        report_straggler(cur_tss, safepoint_id, histogram);
         --still_running;
         *p_prev = nullptr;
         ThreadSafepointState *tmp = cur_tss;
@@ -269,6 +302,11 @@ int SafepointSynchronize::synchronize_threads(jlong safepoint_limit_time, int no
 
   assert(tss_head == nullptr, "Must be empty");
 
+  log_debug(safepoint)("Time to safepoint of %d stragglers: "
+                       "<10us: %d, <100us: %d, <1ms: %d, <10ms: %d, >=10ms: %d",
+                       *initial_running,
+                       histogram[0], histogram[1], histogram[2], histogram[3], histogram[4]);
+
   return iterations;
 }
 
@@ -671,7 +709,8 @@ void SafepointSynchronize::print_safepoint_timeout() {
 
 ThreadSafepointState::ThreadSafepointState(JavaThread *thread)
   : _at_poll_safepoint(false), _thread(thread), _safepoint_safe(false),
-    _safepoint_id(SafepointSynchronize::InactiveSafepointCounter), _next(nullptr) {
+    _safepoint_id(SafepointSynchronize::InactiveSafepointCounter),
+    _last_running_state(_thread_uninitialized), _next(nullptr) {
 }
 
 void ThreadSafepointState::create(JavaThread *thread) {
@@ -713,6 +752,8 @@ void ThreadSafepointState::examine_state_of_thread(uint64_t safepoint_count) {
     return;
   }
 
+  _last_running_state = stable_state;
+
   // All other thread states will continue to run until they
   // transition and self-block in state _blocked
   // Safepoint polling in compiled code causes the Java threads to do the same.
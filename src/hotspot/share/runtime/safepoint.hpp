@@ -186,6 +186,9 @@ class ThreadSafepointState: public CHeapObj<mtThread> {
   JavaThread*                     _thread;
   bool                            _safepoint_safe;
   volatile uint64_t               _safepoint_id;
+  // State last observed by the VMThread while the thread was running
+  // during safepoint synchronization, for reporting stragglers.
+  JavaThreadState                 _last_running_state;
 
   ThreadSafepointState*           _next;
 
@@ -206,6 +209,7 @@ class ThreadSafepointState: public CHeapObj<mtThread> {
   // Query
   JavaThread*  thread() const         { return _thread; }
   bool         is_running() const     { return !_safepoint_safe; }
+  JavaThreadState last_running_state() const { return _last_running_state; }
 
   uint64_t get_safepoint_id() const;
   void     reset_safepoint_id();
@@ -23,9 +23,11 @@
  */
 
 #include "precompiled.hpp"
+#include "cds/dynamicArchive.hpp"
 #include "classfile/classLoaderDataGraph.inline.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/protectionDomainCache.hpp"
+#include "classfile/stackTraceCache.hpp"
 #include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
@@ -97,6 +99,8 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     bool cldg_cleanup_work = false;
     bool jvmti_tagmap_work = false;
     bool oopmap_cache_work = false;
+    bool stack_trace_cache_work = false;
+    bool dynamic_archive_work = false;
     {
       // Need state transition ThreadBlockInVM so that this thread
       // will be handled by safepoint correctly when this thread is
@@ -127,7 +131,9 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
               (oop_handles_to_release = JavaThread::has_oop_handles_to_release()) |
               (cldg_cleanup_work = ClassLoaderDataGraph::should_clean_metaspaces_and_reset()) |
               (jvmti_tagmap_work = JvmtiTagMap::has_object_free_events_and_reset()) |
-              (oopmap_cache_work = OopMapCache::has_cleanup_work())
+              (oopmap_cache_work = OopMapCache::has_cleanup_work()) |
+              (stack_trace_cache_work = StackTraceCache::has_cleanup_work()) |
+              (dynamic_archive_work = CDS_ONLY(DynamicArchive::has_background_dump_work()) NOT_CDS(false))
              ) == 0) {
         // Wait until notified that there is some work to do or timer expires.
         // Some cleanup requests don't notify the ServiceThread so work needs to be done at periodic intervals.
@@ -203,6 +209,16 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     if (oopmap_cache_work) {
       OopMapCache::cleanup();
     }
+
+    if (stack_trace_cache_work) {
+      StackTraceCache::cleanup();
+    }
+
+#if INCLUDE_CDS
+    if (dynamic_archive_work) {
+      DynamicArchive::dump_in_background(jt);
+    }
+#endif
   }
 }
 
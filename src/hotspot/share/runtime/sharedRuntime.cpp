@@ -1061,11 +1061,30 @@ int SharedRuntime::dtrace_object_alloc(JavaThread* thread, oopDesc* o, size_t si
   return 0;
 }
 
+// Reports an entry to or exit from the compiled code of a method selected
+// by the TraceMethodCalls compile command.
+static void post_method_trace_event(Method* method, bool exit) {
+#if INCLUDE_JFR
+  EventMethodTrace event;
+  if (event.should_commit()) {
+    event.set_method(method);
+    event.set_exit(exit);
+    event.commit();
+  }
+#endif
+}
+
 JRT_LEAF(int, SharedRuntime::dtrace_method_entry(
     JavaThread* current, Method* method))
   assert(current == JavaThread::current(), "pre-condition");
 
-  assert(DTraceMethodProbes, "wrong call");
+  assert(DTraceMethodProbes || method->has_traced_calls(), "wrong call");
+  if (method->has_traced_calls()) {
+    post_method_trace_event(method, false /* exit */);
+  }
+  if (!DTraceMethodProbes) {
+    return 0;
+  }
   Symbol* kname = method->klass_name();
   Symbol* name = method->name();
   Symbol* sig = method->signature();
@@ -1080,7 +1099,13 @@ JRT_END
 JRT_LEAF(int, SharedRuntime::dtrace_method_exit(
     JavaThread* current, Method* method))
   assert(current == JavaThread::current(), "pre-condition");
-  assert(DTraceMethodProbes, "wrong call");
+  assert(DTraceMethodProbes || method->has_traced_calls(), "wrong call");
+  if (method->has_traced_calls()) {
+    post_method_trace_event(method, true /* exit */);
+  }
+  if (!DTraceMethodProbes) {
+    return 0;
+  }
   Symbol* kname = method->klass_name();
   Symbol* name = method->name();
   Symbol* sig = method->signature();
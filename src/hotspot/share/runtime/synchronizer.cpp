@@ -59,6 +59,8 @@
 #include "runtime/vframe.hpp"
 #include "runtime/vmThread.hpp"
 #include "utilities/align.hpp"
+#include "utilities/concurrentHashTable.inline.hpp"
+#include "utilities/concurrentHashTableTasks.inline.hpp"
 #include "utilities/dtrace.hpp"
 #include "utilities/events.hpp"
 #include "utilities/globalDefinitions.hpp"
@@ -267,10 +269,137 @@ static inline PlatformMutex* inflation_lock(size_t index) {
   return reinterpret_cast<PlatformMutex*>(_inflation_locks[index]);
 }
 
+// -----------------------------------------------------------------------------
+// Object monitor table
+//
+// With UseObjectMonitorTable, inflation does not install the ObjectMonitor*
+// in the object's mark word. The mark word keeps the identity hash and the
+// age and only gets the monitor lock bits, and the ObjectMonitor is found in
+// this table, keyed by the identity hash. The hash is installed before the
+// object is inflated and is also part of the monitor's header, so an entry
+// can be found both from its object and from its monitor, even after the
+// object has died.
+//
+// An object has at most one entry. The inflating thread inserts its monitor
+// before it sets the monitor bits in the mark word, and only the thread that
+// inserted the entry may do so. Deflation clears the monitor bits before the
+// entry is removed. Monitors found in the table are additionally cached per
+// thread on the LockStack.
+
+class ObjectMonitorTable : AllStatic {
+  struct Config {
+    using Value = ObjectMonitor*;
+    static uintx get_hash(Value const& value, bool* is_dead) {
+      return (uintx)value->header().hash();
+    }
+    static void* allocate_node(void* context, size_t size, Value const& value) {
+      Atomic::inc(&_items_count);
+      return AllocateHeap(size, mtObjectMonitor);
+    }
+    static void free_node(void* context, void* memory, Value const& value) {
+      Atomic::dec(&_items_count);
+      FreeHeap(memory);
+    }
+  };
+
+  using ConcurrentTable = ConcurrentHashTable<Config, mtObjectMonitor>;
+
+  static ConcurrentTable* _table;
+  static volatile size_t _items_count;
+
+  // Initial size 1024, max size 2^24.
+  static const size_t INITIAL_SIZE_LOG = 10;
+  static const size_t MAX_SIZE_LOG = 24;
+  // Prefer short chains of avg 2.
+  static constexpr double PREF_AVG_LIST_LEN = 2.0;
+
+  // Finds the entry of an object.
+  class Lookup : public StackObj {
+    oop _obj;
+    uintx _hash;
+   public:
+    Lookup(oop obj, uintx hash) : _obj(obj), _hash(hash) {}
+    uintx get_hash() const { return _hash; }
+    bool equals(ObjectMonitor** value) { return (*value)->object_peek() == _obj; }
+    bool is_dead(ObjectMonitor** value) { return false; }
+  };
+
+  // Finds the entry of a monitor, whose object may have died.
+  class LookupMonitor : public StackObj {
+    ObjectMonitor* _monitor;
+   public:
+    LookupMonitor(ObjectMonitor* monitor) : _monitor(monitor) {}
+    uintx get_hash() const { return (uintx)_monitor->header().hash(); }
+    bool equals(ObjectMonitor** value) { return *value == _monitor; }
+    bool is_dead(ObjectMonitor** value) { return false; }
+  };
+
+ public:
+  static void create() {
+    _table = new ConcurrentTable(INITIAL_SIZE_LOG, MAX_SIZE_LOG, ConcurrentTable::DEFAULT_GROW_HINT);
+  }
+
+  static ObjectMonitor* lookup(Thread* current, oop obj, uintx hash) {
+    Lookup lookup_f(obj, hash);
+    ObjectMonitor* result = nullptr;
+    auto found_f = [&](ObjectMonitor** found) {
+      result = *found;
+    };
+    _table->get(current, lookup_f, found_f);
+    return result;
+  }
+
+  // Inserts the monitor as the entry of obj unless obj already has an
+  // entry. Returns the monitor of obj's entry.
+  static ObjectMonitor* insert_get(Thread* current, ObjectMonitor* monitor, oop obj) {
+    Lookup lookup_f(obj, (uintx)monitor->header().hash());
+    ObjectMonitor* result = nullptr;
+    auto found_f = [&](ObjectMonitor** found) {
+      result = *found;
+    };
+    _table->insert_get(current, lookup_f, monitor, found_f);
+    return result;
+  }
+
+  static bool remove(Thread* current, ObjectMonitor* monitor) {
+    LookupMonitor lookup_f(monitor);
+    return _table->remove(current, lookup_f);
+  }
+
+  // Called by the MonitorDeflationThread between deflation cycles.
+  static void grow_if_needed(JavaThread* current) {
+    size_t size = (size_t)1 << _table->get_size_log2(current);
+    double load_factor = (double)Atomic::load(&_items_count) / (double)size;
+    if (load_factor <= PREF_AVG_LIST_LEN || _table->is_max_size_reached()) {
+      return;
+    }
+    ConcurrentTable::GrowTask gt(_table);
+    if (!gt.prepare(current)) {
+      return;
+    }
+    while (gt.do_task(current)) {
+      gt.pause(current);
+      {
+        ThreadBlockInVM tbivm(current);
+      }
+      gt.cont(current);
+    }
+    gt.done(current);
+    log_info(monitorinflation)("Object monitor table grown to size: " SIZE_FORMAT,
+                               (size_t)1 << _table->get_size_log2(current));
+  }
+};
+
+ObjectMonitorTable::ConcurrentTable* ObjectMonitorTable::_table = nullptr;
+volatile size_t ObjectMonitorTable::_items_count = 0;
+
 void ObjectSynchronizer::initialize() {
   for (size_t i = 0; i < inflation_lock_count(); i++) {
     ::new(static_cast<void*>(inflation_lock(i))) PlatformMutex();
   }
+  if (UseObjectMonitorTable) {
+    ObjectMonitorTable::create();
+  }
   // Start the ceiling with the estimate for one thread.
   set_in_use_list_ceiling(AvgMonitorsPerThreadEstimate);
 
@@ -306,6 +435,13 @@ jlong ObjectSynchronizer::_last_async_deflation_time_ns = 0;
 static uintx _no_progress_cnt = 0;
 static bool _no_progress_skip_increment = false;
 
+// Where the next deflation cycle continues walking the in-use list, if the
+// last cycle stopped early because of MonitorDeflationMax or
+// MonitorDeflationTimeSlice. Only the MonitorDeflationThread unlinks
+// monitors from the in-use list, and it never unlinks a monitor it has not
+// deflated, so the monitor stays valid until the next cycle.
+static ObjectMonitor* _deflation_resume_point = nullptr;
+
 // =====================> Quick functions
 
 // The quick_* forms are special fast-path variants used to improve
@@ -349,7 +485,11 @@ bool ObjectSynchronizer::quick_notify(oopDesc* obj, JavaThread* current, bool al
   }
 
   if (mark.has_monitor()) {
-    ObjectMonitor* const mon = mark.monitor();
+    ObjectMonitor* const mon = read_monitor(current, obj, mark);
+    if (mon == nullptr) {
+      // Racing with deflation.
+      return false;
+    }
     assert(mon->object() == oop(obj), "invariant");
     if (mon->owner() != current) return false;  // slow-path for IMS exception
 
@@ -409,11 +549,11 @@ bool ObjectSynchronizer::quick_enter(oop obj, JavaThread* current,
   const markWord mark = obj->mark();
 
   if (mark.has_monitor()) {
-    ObjectMonitor* const m = mark.monitor();
+    ObjectMonitor* const m = read_monitor(current, obj, mark);
     // An async deflation or GC can race us before we manage to make
     // the ObjectMonitor busy by setting the owner below. If we detect
     // that race we just bail out to the slow-path here.
-    if (m->object_peek() == nullptr) {
+    if (m == nullptr || m->object_peek() == nullptr) {
       return false;
     }
     JavaThread* const owner = static_cast<JavaThread*>(m->owner_raw());
@@ -1040,6 +1180,13 @@ intptr_t ObjectSynchronizer::FastHashCode(Thread* current, oop obj) {
       // occurred or... so we fall thru to inflate the monitor for
       // stability and then install the hash.
     } else if (mark.has_monitor()) {
+      if (UseObjectMonitorTable) {
+        // The hash is installed in the mark word before inflation and
+        // is never displaced.
+        hash = mark.hash();
+        assert(hash != 0, "inflated object must have a hash");
+        return hash;
+      }
       monitor = mark.monitor();
       temp = monitor->header();
       assert(temp.is_neutral(), "invariant: header=" INTPTR_FORMAT, temp.value());
@@ -1149,8 +1296,8 @@ bool ObjectSynchronizer::current_thread_holds_lock(JavaThread* current,
     // Inflated monitor so header points to ObjectMonitor (tagged pointer).
     // The first stage of async deflation does not affect any field
     // used by this comparison so the ObjectMonitor* is usable here.
-    ObjectMonitor* monitor = mark.monitor();
-    return monitor->is_entered(current) != 0;
+    ObjectMonitor* monitor = read_monitor(current, obj, mark);
+    return monitor != nullptr && monitor->is_entered(current) != 0;
   }
   // Unlocked case, header in place
   assert(mark.is_unlocked(), "sanity check");
@@ -1177,8 +1324,11 @@ JavaThread* ObjectSynchronizer::get_lock_owner(ThreadsList * t_list, Handle h_ob
     // Inflated monitor so header points to ObjectMonitor (tagged pointer).
     // The first stage of async deflation does not affect any field
     // used by this comparison so the ObjectMonitor* is usable here.
-    ObjectMonitor* monitor = mark.monitor();
-    assert(monitor != nullptr, "monitor should be non-null");
+    ObjectMonitor* monitor = read_monitor(Thread::current(), obj, mark);
+    if (monitor == nullptr) {
+      // Deflated, so not owned.
+      return nullptr;
+    }
     // owning_thread_from_monitor() may also return null here:
     return Threads::owning_thread_from_monitor(t_list, monitor);
   }
@@ -1310,6 +1460,12 @@ bool ObjectSynchronizer::is_async_deflation_needed() {
     return true;
   }
 
+  if (_deflation_resume_point != nullptr) {
+    // The last cycle stopped early, continue right away.
+    log_info(monitorinflation)("Async deflation needed: continuing incremental deflation");
+    return true;
+  }
+
   if (GuaranteedAsyncDeflationInterval > 0 &&
       time_since_last > GuaranteedAsyncDeflationInterval) {
     // It's been longer than our specified guaranteed deflate interval.
@@ -1391,9 +1547,11 @@ static void post_monitor_inflate_event(EventJavaMonitorInflate* event,
 void ObjectSynchronizer::inflate_helper(oop obj) {
   markWord mark = obj->mark_acquire();
   if (mark.has_monitor()) {
-    ObjectMonitor* monitor = mark.monitor();
-    markWord dmw = monitor->header();
-    assert(dmw.is_neutral(), "sanity check: header=" INTPTR_FORMAT, dmw.value());
+    if (!UseObjectMonitorTable) {
+      ObjectMonitor* monitor = mark.monitor();
+      markWord dmw = monitor->header();
+      assert(dmw.is_neutral(), "sanity check: header=" INTPTR_FORMAT, dmw.value());
+    }
     return;
   }
   (void)inflate(Thread::current(), obj, inflate_cause_vm_internal);
@@ -1421,6 +1579,10 @@ ObjectMonitor* ObjectSynchronizer::inflate_impl(JavaThread* inflating_thread, oo
   // important for the correctness of the LM_LIGHTWEIGHT algorithm that the thread
   // is set when called from ObjectSynchronizer::enter from the owning thread,
   // ObjectSynchronizer::enter_for from any thread, or ObjectSynchronizer::exit.
+  if (UseObjectMonitorTable) {
+    return inflate_with_table(inflating_thread, object, cause);
+  }
+
   EventJavaMonitorInflate event;
 
   for (;;) {
@@ -1658,19 +1820,172 @@ ObjectMonitor* ObjectSynchronizer::inflate_impl(JavaThread* inflating_thread, oo
   }
 }
 
+ObjectMonitor* ObjectSynchronizer::read_monitor(Thread* current, oop obj, markWord mark) {
+  assert(mark.has_monitor(), "must be");
+  if (!UseObjectMonitorTable) {
+    return mark.monitor();
+  }
+  assert(current == Thread::current(), "must be");
+  if (!current->is_Java_thread()) {
+    return ObjectMonitorTable::lookup(current, obj, (uintx)mark.hash());
+  }
+  LockStack& lock_stack = JavaThread::cast(current)->lock_stack();
+  ObjectMonitor* monitor = lock_stack.get_cached_monitor(obj);
+  if (monitor == nullptr) {
+    monitor = ObjectMonitorTable::lookup(current, obj, (uintx)mark.hash());
+    if (monitor != nullptr && !monitor->is_being_async_deflated()) {
+      lock_stack.set_cached_monitor(monitor);
+    }
+  }
+  return monitor;
+}
+
+ObjectMonitor* ObjectSynchronizer::inflate_with_table(JavaThread* inflating_thread, oop object, const InflateCause cause) {
+  assert(LockingMode == LM_LIGHTWEIGHT, "must be");
+  EventJavaMonitorInflate event;
+  Thread* const current = Thread::current();
+
+  for (;;) {
+    const markWord mark = object->mark_acquire();
+
+    // CASE: inflated
+    // The owner is fixed up as in inflate_impl() if it is anonymous.
+    if (mark.has_monitor()) {
+      ObjectMonitor* inf = read_monitor(current, object, mark);
+      if (inf == nullptr) {
+        // The monitor was deflated after we read the mark.
+        continue;
+      }
+      if (inf->is_owner_anonymous() &&
+          inflating_thread != nullptr && inflating_thread->lock_stack().contains(object)) {
+        inf->set_owner_from_anonymous(inflating_thread);
+        size_t removed = inflating_thread->lock_stack().remove(object);
+        inf->set_recursions(removed - 1);
+      }
+      return inf;
+    }
+
+    // The hash is the key of the table, so it has to be installed first.
+    if (mark.has_no_hash()) {
+      intptr_t hash = get_next_hash(current, object);
+      object->cas_set_mark(mark.copy_set_hash(hash), mark);
+      continue;
+    }
+
+    // CASE: fast-locked or unlocked
+    // Claim the inflation of the object by inserting the new monitor into
+    // the table. If another thread is inflating the object, or the previous
+    // monitor of the object is still being removed by deflation, then just
+    // retry until the mark word shows the outcome.
+    ObjectMonitor* monitor = new ObjectMonitor(object);
+    monitor->set_header(mark.set_unlocked());
+    if (ObjectMonitorTable::insert_get(current, monitor, object) != monitor) {
+      delete monitor;
+      SpinPause();
+      continue;
+    }
+
+    // Only this thread can set the monitor bits now. The lock bits can still
+    // change because of fast-locking by other threads, so configure the owner
+    // for the mark word we install over.
+    bool own = inflating_thread != nullptr && inflating_thread->lock_stack().contains(object);
+    markWord old_mark = mark;
+    for (;;) {
+      void* owner = nullptr;
+      if (own) {
+        // Owned by inflating_thread.
+        owner = inflating_thread;
+      } else if (old_mark.is_fast_locked()) {
+        // Owned by somebody else.
+        owner = reinterpret_cast<void*>(ObjectMonitor::ANONYMOUS_OWNER);
+      }
+      monitor->set_owner_from(monitor->owner_raw(), owner);
+      const markWord witness = object->cas_set_mark(old_mark.set_has_monitor(), old_mark);
+      if (witness == old_mark) {
+        break;
+      }
+      old_mark = witness;
+      assert(!old_mark.has_monitor(), "only this thread may inflate the object");
+    }
+
+    if (own) {
+      size_t removed = inflating_thread->lock_stack().remove(object);
+      monitor->set_recursions(removed - 1);
+    }
+    // Once the ObjectMonitor is configured and object is associated
+    // with the ObjectMonitor, it is safe to allow async deflation:
+    _in_use_list.add(monitor);
+
+    if (current->is_Java_thread()) {
+      JavaThread::cast(current)->lock_stack().set_cached_monitor(monitor);
+    }
+
+    OM_PERFDATA_OP(Inflations, inc());
+    if (log_is_enabled(Trace, monitorinflation)) {
+      ResourceMark rm;
+      log_trace(monitorinflation)("inflate(table): object=" INTPTR_FORMAT ", mark="
+                                  INTPTR_FORMAT ", type='%s'", p2i(object),
+                                  object->mark().value(), object->klass()->external_name());
+    }
+    if (event.should_commit()) {
+      post_monitor_inflate_event(&event, object, cause);
+    }
+    return monitor;
+  }
+}
+
+void ObjectSynchronizer::remove_deflated_monitor_from_table(JavaThread* current, ObjectMonitor* monitor) {
+  assert(UseObjectMonitorTable, "must be");
+  const oop obj = monitor->object_peek();
+  if (obj != nullptr) {
+    // The deflated monitor is still the entry of obj, so the monitor bits
+    // in the mark word are ours to clear.
+    markWord mark = obj->mark_acquire();
+    while (mark.has_monitor()) {
+      const markWord witness = obj->cas_set_mark(mark.set_unlocked(), mark);
+      if (witness == mark) {
+        break;
+      }
+      mark = witness;
+    }
+  }
+  bool removed = ObjectMonitorTable::remove(current, monitor);
+  assert(removed, "deflated monitor must be in the table");
+}
+
 // Walk the in-use list and deflate (at most MonitorDeflationMax) idle
-// ObjectMonitors. Returns the number of deflated ObjectMonitors.
+// ObjectMonitors, for at most MonitorDeflationTimeSlice milliseconds.
+// The walk starts where the last one stopped early, if it did.
+// Returns the number of deflated ObjectMonitors.
 //
 size_t ObjectSynchronizer::deflate_monitor_list(ObjectMonitorDeflationSafepointer* safepointer) {
-  MonitorList::Iterator iter = _in_use_list.iterator();
+  MonitorList::Iterator iter = _deflation_resume_point != nullptr
+                               ? MonitorList::Iterator(_deflation_resume_point)
+                               : _in_use_list.iterator();
+  _deflation_resume_point = nullptr;
   size_t deflated_count = 0;
+  size_t visited_count = 0;
+  const jlong deadline = MonitorDeflationTimeSlice > 0
+                         ? os::javaTimeNanos() + MonitorDeflationTimeSlice * NANOSECS_PER_MILLISEC
+                         : 0;
 
   while (iter.has_next()) {
     if (deflated_count >= (size_t)MonitorDeflationMax) {
+      _deflation_resume_point = iter.next();
+      break;
+    }
+    // Only read the clock every so often.
+    if (deadline != 0 && (++visited_count % 1024) == 0 && os::javaTimeNanos() > deadline) {
+      _deflation_resume_point = iter.next();
+      log_debug(monitorinflation)("deflation time slice expired: deflated_count=" SIZE_FORMAT
+                                  ", visited_count=" SIZE_FORMAT, deflated_count, visited_count);
       break;
     }
     ObjectMonitor* mid = iter.next();
     if (mid->deflate_monitor()) {
+      if (UseObjectMonitorTable) {
+        remove_deflated_monitor_from_table(JavaThread::current(), mid);
+      }
       deflated_count++;
     }
 
@@ -1688,6 +2003,10 @@ class HandshakeForDeflation : public HandshakeClosure {
   void do_thread(Thread* thread) {
     log_trace(monitorinflation)("HandshakeForDeflation::do_thread: thread="
                                 INTPTR_FORMAT, p2i(thread));
+    if (UseObjectMonitorTable && thread->is_Java_thread()) {
+      // The deflated monitors may be cached by the thread.
+      JavaThread::cast(thread)->lock_stack().clear_monitor_cache();
+    }
   }
 };
 
@@ -1858,6 +2177,10 @@ size_t ObjectSynchronizer::deflate_idle_monitors() {
 
   log.end(deflated_count, unlinked_count);
 
+  if (UseObjectMonitorTable) {
+    ObjectMonitorTable::grow_if_needed(current);
+  }
+
   OM_PERFDATA_OP(MonExtant, set_value(_in_use_list.count()));
   OM_PERFDATA_OP(Deflations, inc(deflated_count));
 
@@ -2057,7 +2380,7 @@ void ObjectSynchronizer::chk_in_use_entry(ObjectMonitor* n, outputStream* out,
                     p2i(obj), mark.value());
       *error_cnt_p = *error_cnt_p + 1;
     }
-    ObjectMonitor* const obj_mon = mark.monitor();
+    ObjectMonitor* const obj_mon = read_monitor(Thread::current(), obj, mark);
     if (n != obj_mon) {
       out->print_cr("ERROR: monitor=" INTPTR_FORMAT ": in-use monitor's "
                     "object does not refer to the same monitor: obj="
@@ -132,8 +132,16 @@ class ObjectSynchronizer : AllStatic {
 private:
   // Shared implementation between the different LockingMode.
   static ObjectMonitor* inflate_impl(JavaThread* thread, oop obj, const InflateCause cause);
+  // Implementation of inflate_impl() with UseObjectMonitorTable.
+  static ObjectMonitor* inflate_with_table(JavaThread* thread, oop obj, const InflateCause cause);
 
 public:
+  // Returns the ObjectMonitor of obj, whose mark must have a monitor. With
+  // UseObjectMonitorTable the monitor is looked up in the monitor cache of
+  // current and then in the object monitor table, and null is returned if
+  // the monitor has been deflated and removed from the table.
+  static ObjectMonitor* read_monitor(Thread* current, oop obj, markWord mark);
+
   // This version is only for internal use
   static void inflate_helper(oop obj);
   static const char* inflate_cause_name(const InflateCause cause);
@@ -212,6 +220,10 @@ class ObjectSynchronizer : AllStatic {
   static u_char* get_gvars_stw_random_addr();
 
   static void handle_sync_on_value_based_class(Handle obj, JavaThread* locking_thread);
+
+  // Restore the mark word of the object of a deflated monitor and remove
+  // the monitor from the object monitor table.
+  static void remove_deflated_monitor_from_table(JavaThread* current, ObjectMonitor* monitor);
 };
 
 // ObjectLocker enforces balanced locking and can never throw an
@@ -53,6 +53,8 @@
 #include "jfr/jfr.hpp"
 #endif
 
+#include <errno.h>
+
 #ifndef USE_LIBRARY_BASED_TLS_ONLY
 // Current thread is maintained as a thread-local variable
 THREAD_LOCAL Thread* Thread::_thr_current = nullptr;
@@ -159,6 +161,9 @@ void Thread::initialize_thread_current() {
   assert(ThreadLocalStorage::thread() == nullptr, "ThreadLocalStorage::thread already initialized");
   ThreadLocalStorage::set_thread(this);
   assert(Thread::current() == ThreadLocalStorage::thread(), "TLS mismatch!");
+  if (is_Java_thread()) {
+    JavaThread::cast(this)->set_errno_address(&errno);
+  }
 }
 
 void Thread::clear_thread_current() {
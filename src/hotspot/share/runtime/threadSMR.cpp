@@ -40,6 +40,7 @@
 #include "utilities/copy.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/globalDefinitions.hpp"
+#include "utilities/growableArray.hpp"
 #include "utilities/ostream.hpp"
 #include "utilities/powerOfTwo.hpp"
 #include "utilities/resourceHash.hpp"
@@ -217,38 +218,17 @@ class ThreadScanHashtable : public CHeapObj<mtThread> {
   }
 };
 
-// Closure to gather JavaThreads indirectly referenced by hazard ptrs
-// (ThreadsList references) into a hash table. This closure handles part 2
-// of the dance - adding all the JavaThreads referenced by the hazard
-// pointer (ThreadsList reference) to the hash table.
+// Closure to gather the distinct ThreadsLists referenced by stable hazard
+// ptrs. All the JavaThreads on those ThreadsLists are protected. There are
+// usually only a few distinct ThreadsLists, the current _java_thread_list
+// and maybe some older ones that have been removed but not freed, so they
+// are kept in a small array rather than a hash table.
 //
-class AddThreadHazardPointerThreadClosure : public ThreadClosure {
+class ScanHazardPtrGatherProtectedListsClosure : public ThreadClosure {
  private:
-  ThreadScanHashtable *_table;
-
+  GrowableArrayCHeap<ThreadsList*, mtThread>* _lists;
  public:
-  AddThreadHazardPointerThreadClosure(ThreadScanHashtable *table) : _table(table) {}
-
-  virtual void do_thread(Thread *thread) {
-    if (!_table->has_entry((void*)thread)) {
-      // The same JavaThread might be on more than one ThreadsList or
-      // more than one thread might be using the same ThreadsList. In
-      // either case, we only need a single entry for a JavaThread.
-      _table->add_entry((void*)thread);
-    }
-  }
-};
-
-// Closure to gather JavaThreads indirectly referenced by hazard ptrs
-// (ThreadsList references) into a hash table. This closure handles part 1
-// of the dance - hazard ptr chain walking and dispatch to another
-// closure.
-//
-class ScanHazardPtrGatherProtectedThreadsClosure : public ThreadClosure {
- private:
-  ThreadScanHashtable *_table;
- public:
-  ScanHazardPtrGatherProtectedThreadsClosure(ThreadScanHashtable *table) : _table(table) {}
+  ScanHazardPtrGatherProtectedListsClosure(GrowableArrayCHeap<ThreadsList*, mtThread>* lists) : _lists(lists) {}
 
   virtual void do_thread(Thread *thread) {
     assert_locked_or_safepoint(Threads_lock);
@@ -288,8 +268,7 @@ class ScanHazardPtrGatherProtectedThreadsClosure : public ThreadClosure {
     // ThreadsList that has been removed but not freed. In either case,
     // the hazard ptr is protecting all the JavaThreads on that
     // ThreadsList.
-    AddThreadHazardPointerThreadClosure add_cl(_table);
-    current_list->threads_do(&add_cl);
+    _lists->append_if_missing(current_list);
   }
 };
 
@@ -951,8 +930,10 @@ void ThreadsSMRSupport::free_list(ThreadsList* threads) {
     log_debug(thread, smr)("tid=" UINTX_FORMAT ": ThreadsSMRSupport::free_list: threads=" INTPTR_FORMAT " is not freed.", os::current_thread_id(), p2i(threads));
   }
 
+#ifdef ASSERT
   ValidateHazardPtrsClosure validate_cl;
   threads_do(&validate_cl);
+#endif
 
   delete scan_table;
 }
@@ -963,10 +944,9 @@ void ThreadsSMRSupport::free_list(ThreadsList* threads) {
 bool ThreadsSMRSupport::is_a_protected_JavaThread(JavaThread *thread) {
   assert_locked_or_safepoint(Threads_lock);
 
-  // Gather a hash table of the JavaThreads indirectly referenced by
-  // hazard ptrs.
-  ThreadScanHashtable *scan_table = new ThreadScanHashtable();
-  ScanHazardPtrGatherProtectedThreadsClosure scan_cl(scan_table);
+  // Gather the ThreadsLists referenced by hazard ptrs.
+  GrowableArrayCHeap<ThreadsList*, mtThread> lists;
+  ScanHazardPtrGatherProtectedListsClosure scan_cl(&lists);
   threads_do(&scan_cl);
   OrderAccess::acquire(); // Must order reads of hazard ptr before reads of
                           // nested reference counters
@@ -979,18 +959,17 @@ bool ThreadsSMRSupport::is_a_protected_JavaThread(JavaThread *thread) {
     if (current->_nested_handle_cnt != 0) {
       // 'current' is in use by a nested ThreadsListHandle so the hazard
       // ptr is protecting all the JavaThreads on that ThreadsList.
-      AddThreadHazardPointerThreadClosure add_cl(scan_table);
-      current->threads_do(&add_cl);
+      lists.append_if_missing(current);
     }
     current = current->next_list();
   }
 
-  bool thread_is_protected = false;
-  if (scan_table->has_entry((void*)thread)) {
-    thread_is_protected = true;
+  for (ThreadsList* list : lists) {
+    if (list->includes(thread)) {
+      return true;
+    }
   }
-  delete scan_table;
-  return thread_is_protected;
+  return false;
 }
 
 // Wake up portion of the release stable ThreadsList protocol;
@@ -28,6 +28,7 @@
 #include "cds/cdsConfig.hpp"
 #include "cds/metaspaceShared.hpp"
 #include "classfile/classLoader.hpp"
+#include "classfile/classPreloader.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/javaThreadStatus.hpp"
 #include "classfile/systemDictionary.hpp"
@@ -54,6 +55,7 @@
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
 #include "nmt/memTracker.hpp"
+#include "nmt/nmtUsageHistory.hpp"
 #include "oops/instanceKlass.hpp"
 #include "oops/klass.inline.hpp"
 #include "oops/oop.inline.hpp"
@@ -109,6 +111,9 @@
 #ifdef COMPILER2
 #include "opto/idealGraphPrinter.hpp"
 #endif
+#ifdef LINUX
+#include "osContainer_linux.hpp"
+#endif
 #if INCLUDE_JFR
 #include "jfr/jfr.hpp"
 #endif
@@ -747,6 +752,10 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   // cache the system and platform class loaders
   SystemDictionary::compute_java_loaders(CHECK_JNI_ERR);
 
+  // Start loading classes from PreloadClassList, now that the system class
+  // loader is available.
+  ClassPreloader::initialize(CHECK_JNI_ERR);
+
   if (Continuations::enabled()) {
     // Initialize Continuation class now so that failure to create enterSpecial/doYield
     // special nmethods due to limited CodeCache size can be treated as a fatal error at
@@ -773,6 +782,10 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
     NativeHeapTrimmer::initialize();
   }
 
+#ifdef LINUX
+  OSContainer::start_limits_watcher();
+#endif
+
   // Always call even when there are not JVMTI environments yet, since environments
   // may be attached late and JVMTI must track phases of VM execution
   JvmtiExport::enter_live_phase();
@@ -798,6 +811,7 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
 
   StatSampler::engage();
   if (CheckJNICalls)                  JniPeriodicChecker::engage();
+  NMTUsageHistory::initialize();
 
   call_postVMInitHook(THREAD);
   // The Java side of PostVMInitHook.run must deal with all
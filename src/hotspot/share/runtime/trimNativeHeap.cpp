@@ -50,6 +50,8 @@ class NativeHeapTrimmerThread : public NamedThread {
   Monitor* const _lock;
   bool _stop;
   uint16_t _suspend_count;
+  // Reason for the pending trim request, if any.
+  const char* _requested_reason;
 
   // Statistics
   uint64_t _num_trims_performed;
@@ -100,16 +102,18 @@ class NativeHeapTrimmerThread : public NamedThread {
       unsigned times_suspended = 0;
       unsigned times_waited = 0;
       unsigned times_safepoint = 0;
+      const char* requested_reason = nullptr;
 
       {
         MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
         if (_stop) return;
 
-        while (at_or_nearing_safepoint() || is_suspended() || next_trim_time > tnow) {
+        while (at_or_nearing_safepoint() || is_suspended() ||
+               (next_trim_time > tnow && _requested_reason == nullptr)) {
           if (is_suspended()) {
             times_suspended ++;
             ml.wait(0); // infinite
-          } else if (next_trim_time > tnow) {
+          } else if (next_trim_time > tnow && _requested_reason == nullptr) {
             times_waited ++;
             const double wait_ms = MAX2(1.0, to_ms(next_trim_time - tnow));
             ml.wait((int64_t)wait_ms);
@@ -123,17 +127,28 @@ class NativeHeapTrimmerThread : public NamedThread {
 
           tnow = now();
         }
+        requested_reason = _requested_reason;
+        _requested_reason = nullptr;
       }
 
       log_trace(trimnative)("Times: %u suspended, %u timed, %u safepoint",
                             times_suspended, times_waited, times_safepoint);
 
-      execute_trim_and_log(tnow);
+      if (!TrimNativeHeapOnPressure) {
+        execute_trim_and_log(tnow, "Periodic");
+      } else if (requested_reason != nullptr) {
+        log_debug(trimnative)("Trim requested after %s", requested_reason);
+        execute_trim_and_log(tnow, "Requested");
+      } else if (os::memory_pressure_reported()) {
+        execute_trim_and_log(tnow, "Pressure");
+      } else {
+        log_trace(trimnative)("No memory pressure, skipping trim");
+      }
     }
   }
 
   // Execute the native trim, log results.
-  void execute_trim_and_log(double t1) {
+  void execute_trim_and_log(double t1, const char* kind) {
     assert(os::can_trim_native_heap(), "Unexpected");
 
     os::size_change_t sc = { 0, 0 };
@@ -148,13 +163,13 @@ class NativeHeapTrimmerThread : public NamedThread {
         if (sc.after != SIZE_MAX) {
           const size_t delta = sc.after < sc.before ? (sc.before - sc.after) : (sc.after - sc.before);
           const char sign = sc.after < sc.before ? '-' : '+';
-          log_info(trimnative)("Periodic Trim (" UINT64_FORMAT "): " PROPERFMT "->" PROPERFMT " (%c" PROPERFMT ") %.3fms",
-                               _num_trims_performed,
+          log_info(trimnative)("%s Trim (" UINT64_FORMAT "): " PROPERFMT "->" PROPERFMT " (%c" PROPERFMT ") %.3fms",
+                               kind, _num_trims_performed,
                                PROPERFMTARGS(sc.before), PROPERFMTARGS(sc.after), sign, PROPERFMTARGS(delta),
                                to_ms(t2 - t1));
         } else {
-          log_info(trimnative)("Periodic Trim (" UINT64_FORMAT "): complete (no details) %.3fms",
-                               _num_trims_performed,
+          log_info(trimnative)("%s Trim (" UINT64_FORMAT "): complete (no details) %.3fms",
+                               kind, _num_trims_performed,
                                to_ms(t2 - t1));
         }
       }
@@ -167,6 +182,7 @@ class NativeHeapTrimmerThread : public NamedThread {
     _lock(new (std::nothrow) PaddedMonitor(Mutex::nosafepoint, "NativeHeapTrimmer_lock")),
     _stop(false),
     _suspend_count(0),
+    _requested_reason(nullptr),
     _num_trims_performed(0)
   {
     set_name("Native Heap Trimmer");
@@ -203,6 +219,12 @@ class NativeHeapTrimmerThread : public NamedThread {
     }
   }
 
+  void request(const char* reason) {
+    MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    _requested_reason = reason;
+    ml.notify_all();
+  }
+
   void stop() {
     MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
     _stop = true;
@@ -237,7 +259,8 @@ void NativeHeapTrimmer::initialize() {
       return;
     }
     g_trimmer_thread = new NativeHeapTrimmerThread();
-    log_info(trimnative)("Periodic native trim enabled (interval: %u ms)", TrimNativeHeapInterval);
+    log_info(trimnative)("Periodic native trim enabled (interval: %u ms%s)", TrimNativeHeapInterval,
+                         TrimNativeHeapOnPressure ? ", on memory pressure only" : "");
   }
 }
 
@@ -259,6 +282,12 @@ void NativeHeapTrimmer::resume_periodic_trim(const char* reason) {
   }
 }
 
+void NativeHeapTrimmer::request_trim(const char* reason) {
+  if (TrimNativeHeapOnPressure && g_trimmer_thread != nullptr) {
+    g_trimmer_thread->request(reason);
+  }
+}
+
 void NativeHeapTrimmer::print_state(outputStream* st) {
   if (g_trimmer_thread != nullptr) {
     st->print_cr("Periodic native trim enabled (interval: %u ms)", TrimNativeHeapInterval);
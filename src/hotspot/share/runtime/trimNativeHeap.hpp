@@ -49,6 +49,10 @@ class NativeHeapTrimmer : public AllStatic {
 
   static void print_state(outputStream* st);
 
+  // With TrimNativeHeapOnPressure, ask for a trim as soon as possible since
+  // a lot of native memory was freed.
+  static void request_trim(const char* reason);
+
   // Pause periodic trimming while in scope; when leaving scope,
   // resume periodic trimming.
   struct SuspendMark {
@@ -50,6 +50,7 @@
   template(CollectForMetadataAllocation)          \
   template(CollectForCodeCacheAllocation)         \
   template(GC_HeapInspection)                     \
+  template(EpsilonReclaim)                        \
   template(SerialCollectForAllocation)            \
   template(SerialGCCollect)                       \
   template(ParallelGCFailedAllocation)            \
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "utilities/macros.hpp"
+#if INCLUDE_SERVICES
+#include "classfile/classLoaderData.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/klass.inline.hpp"
+#include "oops/method.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/javaThread.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/vframe.inline.hpp"
+#include "services/allocationSiteService.hpp"
+#include "utilities/concurrentHashTable.inline.hpp"
+#include "utilities/concurrentHashTableTasks.inline.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/ostream.hpp"
+
+AllocationSiteEntry::AllocationSiteEntry(const Method* method, int bci, const Klass* klass) :
+    _method(method),
+    _bci(bci),
+    _klass(klass),
+    _samples(0),
+    _bytes(0) {}
+
+size_t AllocationSiteEntry::samples() const {
+  return Atomic::load(&_samples);
+}
+
+size_t AllocationSiteEntry::bytes() const {
+  return Atomic::load(&_bytes);
+}
+
+void AllocationSiteEntry::on_sample(size_t bytes) {
+  Atomic::inc(&_samples, memory_order_relaxed);
+  Atomic::add(&_bytes, bytes, memory_order_relaxed);
+}
+
+static inline uintx hash_function(const Method* method, int bci, const Klass* klass) {
+  return primitive_hash(method) ^ primitive_hash(klass) ^ (uintx)bci;
+}
+
+static inline uintx hash_function(const AllocationSiteEntry* entry) {
+  return hash_function(entry->method(), entry->bci(), entry->klass());
+}
+
+class AllocationSiteLookup : StackObj {
+ private:
+  const Method* const _method;
+  const int _bci;
+  const Klass* const _klass;
+ public:
+  AllocationSiteLookup(const Method* method, int bci, const Klass* klass) :
+    _method(method), _bci(bci), _klass(klass) {}
+  uintx get_hash() const { return hash_function(_method, _bci, _klass); }
+  bool equals(AllocationSiteEntry** value) {
+    assert(value != nullptr, "invariant");
+    assert(*value != nullptr, "invariant");
+    return (*value)->method() == _method && (*value)->bci() == _bci && (*value)->klass() == _klass;
+  }
+  bool is_dead(AllocationSiteEntry** value) {
+    return false;
+  }
+};
+
+class AllocationSiteTableConfig : public AllStatic {
+ public:
+  typedef AllocationSiteEntry* Value;  // value of the Node in the hashtable
+
+  static uintx get_hash(Value const& value, bool* is_dead) {
+    return hash_function(value);
+  }
+  static void* allocate_node(void* context, size_t size, Value const& value) {
+    return AllocateHeap(size, mtServiceability);
+  }
+  static void free_node(void* context, void* memory, Value const& value) {
+    delete value;
+    FreeHeap(memory);
+  }
+};
+
+typedef ConcurrentHashTable<AllocationSiteTableConfig, mtServiceability> AllocationSiteHashtable;
+static AllocationSiteHashtable* _table = nullptr;
+// The table is not resized, so it is created with a generous number of buckets.
+static const size_t TABLE_SIZE_LOG_2 = 14;
+// Once this many sites are recorded, samples for new sites are dropped.
+static const size_t MAX_ENTRIES = 64 * K;
+static volatile size_t _num_entries = 0;
+static volatile size_t _dropped_samples = 0;
+
+class AllocationSiteLookupGet {
+ private:
+  AllocationSiteEntry* _result;
+ public:
+  AllocationSiteLookupGet() : _result(nullptr) {}
+  void operator()(AllocationSiteEntry** node) {
+    assert(node != nullptr, "invariant");
+    _result = *node;
+  }
+  AllocationSiteEntry* result() const { return _result; }
+};
+
+void AllocationSiteService::init() {
+  assert(_table == nullptr, "invariant");
+  if (RecordAllocationSites) {
+    _table = new AllocationSiteHashtable(TABLE_SIZE_LOG_2, TABLE_SIZE_LOG_2);
+  }
+}
+
+static AllocationSiteEntry* get_entry(const Method* method, int bci, const Klass* klass, Thread* thread) {
+  AllocationSiteLookup lookup(method, bci, klass);
+  AllocationSiteLookupGet get;
+  if (_table->get(thread, lookup, get)) {
+    return get.result();
+  }
+  if (Atomic::load(&_num_entries) >= MAX_ENTRIES) {
+    return nullptr;
+  }
+  AllocationSiteEntry* const entry = new AllocationSiteEntry(method, bci, klass);
+  if (_table->insert(thread, lookup, entry)) {
+    Atomic::inc(&_num_entries);
+    return entry;
+  }
+  // Another thread added the site concurrently. The table has freed the
+  // entry that was not inserted.
+  _table->get(thread, lookup, get);
+  return get.result();
+}
+
+void AllocationSiteService::on_sample(JavaThread* thread, const Klass* klass, size_t bytes) {
+  assert(RecordAllocationSites, "invariant");
+  if (!thread->has_last_Java_frame()) {
+    return;
+  }
+  vframeStream vfs(thread, false /* stop_at_java_call_stub */, false /* process_frames */);
+  if (vfs.at_end()) {
+    return;
+  }
+  AllocationSiteEntry* const entry = get_entry(vfs.method(), vfs.bci(), klass, thread);
+  if (entry != nullptr) {
+    entry->on_sample(bytes);
+  } else {
+    Atomic::inc(&_dropped_samples, memory_order_relaxed);
+  }
+}
+
+static bool is_unloading(AllocationSiteEntry** value) {
+  const AllocationSiteEntry* const entry = *value;
+  return !entry->klass()->is_loader_alive() || !entry->method()->method_holder()->is_loader_alive();
+}
+
+static void on_removed(AllocationSiteEntry** value) {
+  Atomic::dec(&_num_entries);
+}
+
+class AllocationSiteCollect : public StackObj {
+ private:
+  GrowableArray<AllocationSiteEntry*>* _entries;
+  const bool _only_unloading;
+ public:
+  AllocationSiteCollect(GrowableArray<AllocationSiteEntry*>* entries, bool only_unloading = false) :
+    _entries(entries), _only_unloading(only_unloading) {}
+  bool operator()(AllocationSiteEntry** entry) {
+    if (!_only_unloading || is_unloading(entry)) {
+      _entries->append(*entry);
+    }
+    return true;
+  }
+};
+
+void AllocationSiteService::purge_unloaded() {
+  assert_locked_or_safepoint(ClassLoaderDataGraph_lock);
+  if (_table == nullptr) {
+    return;
+  }
+  Thread* const thread = Thread::current();
+  if (!SafepointSynchronize::is_at_safepoint()) {
+    _table->bulk_delete(thread, is_unloading, on_removed);
+    return;
+  }
+  // Bulk deletion is not available at a safepoint, remove the entries one by one.
+  ResourceMark rm(thread);
+  GrowableArray<AllocationSiteEntry*> unloading;
+  AllocationSiteCollect collect(&unloading, true /* only_unloading */);
+  _table->do_safepoint_scan(collect);
+  for (int i = 0; i < unloading.length(); i++) {
+    const AllocationSiteEntry* const entry = unloading.at(i);
+    AllocationSiteLookup lookup(entry->method(), entry->bci(), entry->klass());
+    if (_table->remove(thread, lookup)) {
+      Atomic::dec(&_num_entries);
+    }
+  }
+}
+
+static int compare_by_bytes(AllocationSiteEntry** a, AllocationSiteEntry** b) {
+  const size_t bytes_a = (*a)->bytes();
+  const size_t bytes_b = (*b)->bytes();
+  return bytes_a > bytes_b ? -1 : (bytes_a < bytes_b ? 1 : 0);
+}
+
+void AllocationSiteService::print_on(outputStream* st, uint limit, JavaThread* thread) {
+  if (_table == nullptr) {
+    st->print_cr("Allocation sites are not recorded, use -XX:+UnlockDiagnosticVMOptions -XX:+RecordAllocationSites");
+    return;
+  }
+
+  ResourceMark rm(thread);
+  // Keep classes from being unloaded while the entries are printed.
+  MutexLocker ml(thread, ClassLoaderDataGraph_lock);
+
+  GrowableArray<AllocationSiteEntry*> entries;
+  AllocationSiteCollect collect(&entries);
+  _table->do_scan(thread, collect);
+  entries.sort(compare_by_bytes);
+
+  size_t total_bytes = 0;
+  size_t total_samples = 0;
+  for (int i = 0; i < entries.length(); i++) {
+    total_bytes += entries.at(i)->bytes();
+    total_samples += entries.at(i)->samples();
+  }
+
+  st->print_cr("Allocation sites: %d, samples: " SIZE_FORMAT ", sampled bytes: " SIZE_FORMAT ", dropped samples: " SIZE_FORMAT,
+               entries.length(), total_samples, total_bytes, Atomic::load(&_dropped_samples));
+  st->print_cr("%14s %10s %7s  %s", "Bytes", "Samples", "Percent", "Class / Site");
+  const int num_printed = limit == 0 ? entries.length() : MIN2(entries.length(), (int)limit);
+  for (int i = 0; i < num_printed; i++) {
+    const AllocationSiteEntry* const entry = entries.at(i);
+    st->print_cr(SIZE_FORMAT_W(14) " " SIZE_FORMAT_W(10) " %6.2f%%  %s", entry->bytes(), entry->samples(),
+                 percent_of(entry->bytes(), total_bytes), entry->klass()->external_name());
+    st->print_cr("%34s  at %s @ %d", "", entry->method()->external_name(), entry->bci());
+  }
+}
+
+static bool is_any(AllocationSiteEntry** value) {
+  return true;
+}
+
+void AllocationSiteService::reset(JavaThread* thread) {
+  if (_table == nullptr) {
+    return;
+  }
+  _table->bulk_delete(thread, is_any, on_removed);
+  Atomic::store(&_dropped_samples, (size_t)0);
+}
+
+#endif // INCLUDE_SERVICES
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_SERVICES_ALLOCATIONSITESERVICE_HPP
+#define SHARE_SERVICES_ALLOCATIONSITESERVICE_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/macros.hpp"
+
+class JavaThread;
+class Klass;
+class Method;
+class outputStream;
+
+// An allocation site: the allocated class and the method and bci of the
+// topmost Java frame that allocated it.
+class AllocationSiteEntry : public CHeapObj<mtServiceability> {
+ private:
+  const Method* const _method;
+  const int _bci;
+  const Klass* const _klass;
+  volatile size_t _samples;
+  volatile size_t _bytes;
+ public:
+  AllocationSiteEntry(const Method* method, int bci, const Klass* klass);
+  const Method* method() const { return _method; }
+  int bci() const { return _bci; }
+  const Klass* klass() const { return _klass; }
+  size_t samples() const;
+  size_t bytes() const;
+  void on_sample(size_t bytes);
+};
+
+// Aggregates the allocations that take the allocation slow path, i.e. that
+// refill a TLAB or are allocated outside a TLAB, per allocation site. These
+// are a sample of all allocations that is weighted by the allocated bytes,
+// the same way as the JFR ObjectAllocationInNewTLAB and
+// ObjectAllocationOutsideTLAB events.
+class AllocationSiteService : AllStatic {
+ public:
+  static void init() NOT_SERVICES_RETURN;
+  static void purge_unloaded() NOT_SERVICES_RETURN;
+  static void on_sample(JavaThread* thread, const Klass* klass, size_t bytes) NOT_SERVICES_RETURN;
+  static void print_on(outputStream* st, uint limit, JavaThread* thread) NOT_SERVICES_RETURN;
+  static void reset(JavaThread* thread) NOT_SERVICES_RETURN;
+};
+
+#endif // SHARE_SERVICES_ALLOCATIONSITESERVICE_HPP
@@ -37,8 +37,10 @@
 #include "runtime/flags/jvmFlag.hpp"
 #include "runtime/globals.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/java.hpp"
 #include "runtime/javaCalls.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "runtime/vmOperations.hpp"
 #include "services/attachListener.hpp"
@@ -47,6 +49,7 @@
 #include "services/writeableFlags.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/formatBuffer.hpp"
+#include "utilities/growableArray.hpp"
 
 volatile AttachListenerState AttachListener::_state = AL_NOT_INITIALIZED;
 
@@ -370,9 +373,99 @@ static AttachOperationFunctionInfo funcs[] = {
 
 
 
+// Dispatches an operation to the function that implements it and sends the
+// result and output to the client.
+static void process_operation(AttachOperation* op) {
+  ResourceMark rm;
+  bufferedStream st;
+  jint res = JNI_OK;
+
+  // handle special detachall operation
+  if (strcmp(op->name(), AttachOperation::detachall_operation_name()) == 0) {
+    AttachListener::detachall();
+  } else {
+    // find the function to dispatch too
+    AttachOperationFunctionInfo* info = nullptr;
+    for (int i=0; funcs[i].name != nullptr; i++) {
+      const char* name = funcs[i].name;
+      assert(strlen(name) <= AttachOperation::name_length_max, "operation <= name_length_max");
+      if (strcmp(op->name(), name) == 0) {
+        info = &(funcs[i]);
+        break;
+      }
+    }
+
+    if (info != nullptr) {
+      // dispatch to the function that implements this operation
+      res = (info->func)(op, &st);
+    } else {
+      st.print("Operation %s not recognized!", op->name());
+      res = JNI_ERR;
+    }
+  }
+
+  // operation complete - send result and output to client
+  op->complete(res, &st);
+}
+
+// Heap and thread dumps and heap inspection can take a long time, as can the
+// diagnostic commands that declare themselves long running.
+static bool is_long_running(AttachOperation* op) {
+  if (strcmp(op->name(), "dumpheap") == 0 ||
+      strcmp(op->name(), "inspectheap") == 0 ||
+      strcmp(op->name(), "threaddump") == 0) {
+    return true;
+  }
+  if (strcmp(op->name(), "jcmd") == 0) {
+    DCmdIter iter(op->arg(0), '\n');
+    while (iter.has_next()) {
+      CmdLine line = iter.next();
+      if (line.is_stop()) {
+        break;
+      }
+      if (line.is_executable()) {
+        DCmdFactory* factory = DCmdFactory::factory(DCmd_Source_AttachAPI, line.cmd_addr(), line.cmd_len());
+        if (factory != nullptr && factory->is_long_running()) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+static GrowableArrayCHeap<AttachOperation*, mtServiceability>* _long_running_ops = nullptr;
+
+void AttachListenerWorkerThread::enqueue(AttachOperation* op) {
+  MonitorLocker ml(AttachListenerWorker_lock, Mutex::_no_safepoint_check_flag);
+  _long_running_ops->append(op);
+  ml.notify();
+}
+
+void AttachListenerWorkerThread::thread_entry(JavaThread* thread, TRAPS) {
+  assert(thread == Thread::current(), "Must be");
+  for (;;) {
+    AttachOperation* op;
+    {
+      ThreadBlockInVM tbivm(thread);
+      MonitorLocker ml(AttachListenerWorker_lock, Mutex::_no_safepoint_check_flag);
+      while (_long_running_ops->is_empty()) {
+        ml.wait();
+      }
+      op = _long_running_ops->at(0);
+      _long_running_ops->remove_at(0);
+    }
+    process_operation(op);
+  }
+
+  ShouldNotReachHere();
+}
+
 // The Attach Listener threads services a queue. It dequeues an operation
 // from the queue, examines the operation name (command), and dispatches
-// to the corresponding function to perform the operation.
+// to the corresponding function to perform the operation. Long running
+// operations are handed to the AttachListenerWorkerThread instead, so that
+// a heap dump does not keep other clients waiting.
 
 void AttachListenerThread::thread_entry(JavaThread* thread, TRAPS) {
   os::set_priority(thread, NearMaxPriority);
@@ -394,36 +487,11 @@ void AttachListenerThread::thread_entry(JavaThread* thread, TRAPS) {
       return;   // dequeue failed or shutdown
     }
 
-    ResourceMark rm;
-    bufferedStream st;
-    jint res = JNI_OK;
-
-    // handle special detachall operation
-    if (strcmp(op->name(), AttachOperation::detachall_operation_name()) == 0) {
-      AttachListener::detachall();
+    if (_long_running_ops != nullptr && is_long_running(op)) {
+      AttachListenerWorkerThread::enqueue(op);
     } else {
-      // find the function to dispatch too
-      AttachOperationFunctionInfo* info = nullptr;
-      for (int i=0; funcs[i].name != nullptr; i++) {
-        const char* name = funcs[i].name;
-        assert(strlen(name) <= AttachOperation::name_length_max, "operation <= name_length_max");
-        if (strcmp(op->name(), name) == 0) {
-          info = &(funcs[i]);
-          break;
-        }
-      }
-
-      if (info != nullptr) {
-        // dispatch to the function that implements this operation
-        res = (info->func)(op, &st);
-      } else {
-        st.print("Operation %s not recognized!", op->name());
-        res = JNI_ERR;
-      }
+      process_operation(op);
     }
-
-    // operation complete - send result and output to client
-    op->complete(res, &st);
   }
 
   ShouldNotReachHere();
@@ -447,6 +515,20 @@ bool AttachListener::has_init_error(TRAPS) {
 void AttachListener::init() {
   EXCEPTION_MARK;
 
+  // The worker is started before the attach listener, and only once since the
+  // attach listener may be restarted after it has been shut down.
+  if (_long_running_ops == nullptr) {
+    Handle worker_oop = JavaThread::create_system_thread_object("Attach Listener Worker", THREAD);
+    if (!has_init_error(THREAD)) {
+      _long_running_ops = new GrowableArrayCHeap<AttachOperation*, mtServiceability>(4);
+      JavaThread* worker = new AttachListenerWorkerThread();
+      JavaThread::vm_exit_on_osthread_failure(worker);
+
+      JavaThread::start_internal_daemon(THREAD, worker, worker_oop, NoPriority);
+    }
+    // Otherwise long running operations are executed by the attach listener itself.
+  }
+
   const char* name = "Attach Listener";
   Handle thread_oop = JavaThread::create_system_thread_object(name, THREAD);
   if (has_init_error(THREAD)) {
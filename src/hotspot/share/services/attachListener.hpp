@@ -68,6 +68,20 @@ class AttachListenerThread : public JavaThread {
   bool is_AttachListener_thread() const { return true; }
 };
 
+// Executes the long running attach operations, like heap and thread dumps,
+// on behalf of the AttachListenerThread, so that other operations are not
+// held up by them.
+class AttachListenerWorkerThread : public JavaThread {
+private:
+  static void thread_entry(JavaThread* thread, TRAPS);
+
+public:
+  AttachListenerWorkerThread() : JavaThread(&AttachListenerWorkerThread::thread_entry) {}
+  bool is_AttachListener_thread() const { return true; }
+
+  static void enqueue(AttachOperation* op);
+};
+
 class AttachListener: AllStatic {
  public:
   static void vm_start() NOT_SERVICES_RETURN;
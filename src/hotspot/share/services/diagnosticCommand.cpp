@@ -37,6 +37,7 @@
 #include "compiler/compileBroker.hpp"
 #include "compiler/directivesParser.hpp"
 #include "gc/shared/gcVMOperations.hpp"
+#include "gc/shared/gcWorkerTimeline.hpp"
 #include "jvm.h"
 #include "memory/metaspace/metaspaceDCmd.hpp"
 #include "memory/resourceArea.hpp"
@@ -58,6 +59,7 @@
 #include "runtime/os.hpp"
 #include "runtime/vmOperations.hpp"
 #include "runtime/vm_version.hpp"
+#include "services/allocationSiteService.hpp"
 #include "services/diagnosticArgument.hpp"
 #include "services/diagnosticCommand.hpp"
 #include "services/diagnosticFramework.hpp"
@@ -110,6 +112,8 @@ void DCmd::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<RunFinalizationDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<HeapInfoDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<FinalizerInfoDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<AllocationSitesDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<GCWorkerTimelineDCmd>(full_export, true, false));
 #if INCLUDE_SERVICES
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<HeapDumpDCmd>(DCmd_Source_Internal | DCmd_Source_AttachAPI, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassHistogramDCmd>(full_export, true, false));
@@ -134,6 +138,7 @@ void DCmd::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompileQueueDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeListDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeCacheDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeCacheCompactDCmd>(full_export, true, false));
 #ifdef LINUX
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<PerfMapDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<TrimCLibcHeapDCmd>(full_export, true, false));
@@ -418,6 +423,46 @@ void HeapInfoDCmd::execute(DCmdSource source, TRAPS) {
   Universe::heap()->print_on(output());
 }
 
+AllocationSitesDCmd::AllocationSitesDCmd(outputStream* output, bool heap) :
+                                         DCmdWithParser(output, heap),
+  _limit("-limit", "Number of allocation sites to print, 0 prints all", "INT", false, "20"),
+  _reset("-reset", "Clear the recorded allocation sites after printing them", "BOOLEAN", false, "false") {
+  _dcmdparser.add_dcmd_option(&_limit);
+  _dcmdparser.add_dcmd_option(&_reset);
+}
+
+void AllocationSitesDCmd::execute(DCmdSource source, TRAPS) {
+  jlong limit = _limit.value();
+  if (limit < 0 || limit > max_juint) {
+    output()->print_cr("Limit out of range: " JLONG_FORMAT, limit);
+    return;
+  }
+  AllocationSiteService::print_on(output(), (uint)limit, THREAD);
+  if (_reset.value()) {
+    AllocationSiteService::reset(THREAD);
+  }
+}
+
+GCWorkerTimelineDCmd::GCWorkerTimelineDCmd(outputStream* output, bool heap) :
+                                           DCmdWithParser(output, heap),
+  _filename("filename", "Name of the trace file", "STRING", true) {
+  _dcmdparser.add_dcmd_argument(&_filename);
+}
+
+void GCWorkerTimelineDCmd::execute(DCmdSource source, TRAPS) {
+  if (!RecordGCWorkerTimeline) {
+    output()->print_cr("The GC worker timeline is not recorded, use -XX:+UnlockDiagnosticVMOptions -XX:+RecordGCWorkerTimeline");
+    return;
+  }
+  fileStream fs(_filename.value(), "w");
+  if (!fs.is_open()) {
+    output()->print_cr("Could not open %s", _filename.value());
+    return;
+  }
+  GCWorkerTimeline::write_on(&fs);
+  output()->print_cr("GC worker timeline written to %s", _filename.value());
+}
+
 void FinalizerInfoDCmd::execute(DCmdSource source, TRAPS) {
   ResourceMark rm(THREAD);
 
@@ -479,15 +524,25 @@ HeapDumpDCmd::HeapDumpDCmd(outputStream* output, bool heap) :
   _gzip("-gz", "If specified, the heap dump is written in gzipped format "
                "using the given compression level. 1 (recommended) is the fastest, "
                "9 the strongest compression.", "INT", false, "1"),
+  _zstd("-zstd", "If specified, the heap dump is written in zstd format "
+                 "using the given compression level. 1 (recommended) is the fastest, "
+                 "19 the strongest compression. Requires the zstd library of the platform.",
+        "INT", false, "1"),
   _overwrite("-overwrite", "If specified, the dump file will be overwritten if it exists",
            "BOOLEAN", false, "false"),
+  _delta("-delta", "If specified, only objects in heap regions that changed since the "
+                   "previous delta dump are written, and a manifest of the written regions "
+                   "is created as <filename>.delta. The first delta dump writes all objects.",
+         "BOOLEAN", false, "false"),
   _parallel("-parallel", "Number of parallel threads to use for heap dump. The VM "
                           "will try to use the specified number of threads, but might use fewer.",
             "INT", false, "1") {
   _dcmdparser.add_dcmd_option(&_all);
   _dcmdparser.add_dcmd_argument(&_filename);
   _dcmdparser.add_dcmd_option(&_gzip);
+  _dcmdparser.add_dcmd_option(&_zstd);
   _dcmdparser.add_dcmd_option(&_overwrite);
+  _dcmdparser.add_dcmd_option(&_delta);
   _dcmdparser.add_dcmd_option(&_parallel);
 }
 
@@ -504,6 +559,22 @@ void HeapDumpDCmd::execute(DCmdSource source, TRAPS) {
     }
   }
 
+  HeapDumper::CompressionType compression_type = HeapDumper::CompressionType::gzip;
+  if (_zstd.is_set()) {
+    if (_gzip.is_set()) {
+      output()->print_cr("Only one of -gz and -zstd can be specified");
+      return;
+    }
+
+    level = _zstd.value();
+    compression_type = HeapDumper::CompressionType::zstd;
+
+    if (level < 1 || level > 19) {
+      output()->print_cr("Compression level out of range (1-19): " JLONG_FORMAT, level);
+      return;
+    }
+  }
+
   if (_parallel.is_set()) {
     parallel = _parallel.value();
 
@@ -520,7 +591,8 @@ void HeapDumpDCmd::execute(DCmdSource source, TRAPS) {
   // This helps reduces the amount of unreachable objects in the dump
   // and makes it easier to browse.
   HeapDumper dumper(!_all.value() /* request GC if _all is false*/);
-  dumper.dump(_filename.value(), output(), (int) level, _overwrite.value(), (uint)parallel);
+  dumper.set_delta(_delta.value());
+  dumper.dump(_filename.value(), output(), (int) level, _overwrite.value(), (uint)parallel, compression_type);
 }
 
 ClassHistogramDCmd::ClassHistogramDCmd(outputStream* output, bool heap) :
@@ -533,9 +605,11 @@ ClassHistogramDCmd::ClassHistogramDCmd(outputStream* output, bool heap) :
        "1 means use one thread (disable parallelism). "
        "For any other value the VM will try to use the specified number of "
        "threads, but might use fewer.",
-       "INT", false, "0") {
+       "INT", false, "0"),
+  _format("-format", "Output format (\"plain\" or \"json\")", "STRING", false, "plain") {
   _dcmdparser.add_dcmd_option(&_all);
   _dcmdparser.add_dcmd_option(&_parallel_thread_num);
+  _dcmdparser.add_dcmd_option(&_format);
 }
 
 void ClassHistogramDCmd::execute(DCmdSource source, TRAPS) {
@@ -547,9 +621,11 @@ void ClassHistogramDCmd::execute(DCmdSource source, TRAPS) {
   uint parallel_thread_num = num == 0
       ? MAX2<uint>(1, (uint)os::initial_active_processor_count() * 3 / 8)
       : num;
+  bool json = (_format.value() != nullptr) && (strcmp(_format.value(), "json") == 0);
   VM_GC_HeapInspection heapop(output(),
                               !_all.value(), /* request full gc if false */
-                              parallel_thread_num);
+                              parallel_thread_num,
+                              json);
   VMThread::execute(&heapop);
 }
 
@@ -851,6 +927,10 @@ void CodeCacheDCmd::execute(DCmdSource source, TRAPS) {
   CodeCache::print_layout(output());
 }
 
+void CodeCacheCompactDCmd::execute(DCmdSource source, TRAPS) {
+  CodeCache::compact_all(output());
+}
+
 #ifdef LINUX
 #define DEFAULT_PERFMAP_FILENAME "/tmp/perf-<pid>.map"
 
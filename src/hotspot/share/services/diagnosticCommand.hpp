@@ -258,6 +258,7 @@ class SystemGCDCmd : public DCmd {
     static const char* impact() {
       return "Medium: Depends on Java heap size and content.";
     }
+    static bool is_long_running() { return true; }
     virtual void execute(DCmdSource source, TRAPS);
 };
 
@@ -293,6 +294,51 @@ class HeapInfoDCmd : public DCmd {
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class AllocationSitesDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<jlong> _limit;
+  DCmdArgument<bool> _reset;
+public:
+  static int num_arguments() { return 2; }
+  AllocationSitesDCmd(outputStream* output, bool heap);
+  static const char* name() { return "GC.allocation_sites"; }
+  static const char* description() {
+    return "Print the allocation sites that allocated the most bytes in new TLABs "
+           "and outside TLABs. Requires -XX:+RecordAllocationSites.";
+  }
+  static const char* impact() {
+    return "Low: Depends on the number of allocation sites.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", nullptr};
+    return p;
+  }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
+class GCWorkerTimelineDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<char*> _filename;
+public:
+  static int num_arguments() { return 1; }
+  GCWorkerTimelineDCmd(outputStream* output, bool heap);
+  static const char* name() { return "GC.worker_timeline"; }
+  static const char* description() {
+    return "Write the recent events of the GC worker threads in the Chrome trace event "
+           "format, which Perfetto loads. Requires -XX:+RecordGCWorkerTimeline.";
+  }
+  static const char* impact() {
+    return "Low: Depends on GCWorkerTimelineSize.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", nullptr};
+    return p;
+  }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class FinalizerInfoDCmd : public DCmd {
 public:
   FinalizerInfoDCmd(outputStream* output, bool heap) : DCmd(output, heap) { }
@@ -319,7 +365,9 @@ class HeapDumpDCmd : public DCmdWithParser {
   DCmdArgument<char*> _filename;
   DCmdArgument<bool>  _all;
   DCmdArgument<jlong> _gzip;
+  DCmdArgument<jlong> _zstd;
   DCmdArgument<bool> _overwrite;
+  DCmdArgument<bool> _delta;
   DCmdArgument<jlong> _parallel;
 public:
   static int num_arguments() { return 5; }
@@ -334,6 +382,7 @@ class HeapDumpDCmd : public DCmdWithParser {
     return "High: Depends on Java heap size and content. "
            "Request a full GC unless the '-all' option is specified.";
   }
+  static bool is_long_running() { return true; }
   static const JavaPermission permission() {
     JavaPermission p = {"java.lang.management.ManagementPermission",
                         "monitor", nullptr};
@@ -348,8 +397,9 @@ class ClassHistogramDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<bool> _all;
   DCmdArgument<jlong> _parallel_thread_num;
+  DCmdArgument<char*> _format;
 public:
-  static int num_arguments() { return 2; }
+  static int num_arguments() { return 3; }
   ClassHistogramDCmd(outputStream* output, bool heap);
   static const char* name() {
     return "GC.class_histogram";
@@ -360,6 +410,7 @@ class ClassHistogramDCmd : public DCmdWithParser {
   static const char* impact() {
     return "High: Depends on Java heap size and content.";
   }
+  static bool is_long_running() { return true; }
   static const JavaPermission permission() {
     JavaPermission p = {"java.lang.management.ManagementPermission",
                         "monitor", nullptr};
@@ -436,6 +487,7 @@ class ThreadDumpDCmd : public DCmdWithParser {
   static const char* impact() {
     return "Medium: Depends on the number of threads.";
   }
+  static bool is_long_running() { return true; }
   static const JavaPermission permission() {
     JavaPermission p = {"java.lang.management.ManagementPermission",
                         "monitor", nullptr};
@@ -641,6 +693,27 @@ class CodeCacheDCmd : public DCmd {
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class CodeCacheCompactDCmd : public DCmd {
+public:
+  CodeCacheCompactDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
+  static const char* name() {
+    return "Compiler.codecache_compact";
+  }
+  static const char* description() {
+    return "Compact the code heaps by relocating nmethods into free blocks. "
+           "Requires -XX:+NMethodRelocation.";
+  }
+  static const char* impact() {
+    return "Medium: Depends on the number of nmethods.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "control", nullptr};
+    return p;
+  }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 //---<  BEGIN  >--- CodeHeap State Analytics.
 class CodeHeapAnalyticsDCmd : public DCmdWithParser {
 protected:
@@ -950,6 +1023,7 @@ class ThreadDumpToFileDCmd : public DCmdWithParser {
   static const char* impact() {
     return "Medium: Depends on the number of threads.";
   }
+  static bool is_long_running() { return true; }
   static const JavaPermission permission() {
     JavaPermission p = {"java.lang.management.ManagementPermission", "monitor", nullptr};
     return p;
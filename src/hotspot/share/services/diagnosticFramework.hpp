@@ -261,6 +261,11 @@ class DCmd : public AnyObj {
   // impact depends on the heap size.
   static const char* impact()       { return "Low: No impact"; }
 
+  // Commands that can run for a long time, like heap or thread dumps, return
+  // true from is_long_running(). The attach listener executes them on a
+  // separate thread, so that they do not hold up other commands.
+  static bool is_long_running()     { return false; }
+
   // The permission() method returns the description of Java Permission. This
   // permission is required when the diagnostic command is invoked via the
   // DiagnosticCommandMBean. The rationale for this permission check is that
@@ -384,6 +389,7 @@ class DCmdFactory: public CHeapObj<mtInternal> {
   virtual const char* name() const = 0;
   virtual const char* description() const = 0;
   virtual const char* impact() const = 0;
+  virtual bool is_long_running() const = 0;
   virtual const JavaPermission permission() const = 0;
   virtual const char* disabled_message() const = 0;
   // Register a DCmdFactory to make a diagnostic command available.
@@ -428,6 +434,9 @@ template <class DCmdClass> class DCmdFactoryImpl : public DCmdFactory {
   const char* impact() const {
     return DCmdClass::impact();
   }
+  bool is_long_running() const {
+    return DCmdClass::is_long_running();
+  }
   const JavaPermission permission() const {
     return DCmdClass::permission();
   }
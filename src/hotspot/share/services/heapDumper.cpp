@@ -63,6 +63,7 @@
 #include "utilities/checkedCast.hpp"
 #include "utilities/macros.hpp"
 #include "utilities/ostream.hpp"
+#include "utilities/resizeableResourceHash.hpp"
 #ifdef LINUX
 #include "os_linux.hpp"
 #endif
@@ -610,6 +611,7 @@ class DumpWriter : public AbstractDumpWriter {
 private:
   FileWriter* _writer;
   AbstractCompressor* _compressor;
+  bool _owns_compressor;
   size_t _bytes_written;
   char* _error;
   // Compression support
@@ -623,7 +625,7 @@ class DumpWriter : public AbstractDumpWriter {
   void do_compress();
 
 public:
-  DumpWriter(const char* path, bool overwrite, AbstractCompressor* compressor);
+  DumpWriter(const char* path, bool overwrite, AbstractCompressor* compressor, bool owns_compressor = false);
   ~DumpWriter();
   julong bytes_written() const override        { return (julong) _bytes_written; }
   char const* error() const override           { return _error; }
@@ -643,10 +645,11 @@ class DumpWriter : public AbstractDumpWriter {
   void set_compressor(AbstractCompressor* p)   { _compressor = p; }
 };
 
-DumpWriter::DumpWriter(const char* path, bool overwrite, AbstractCompressor* compressor) :
+DumpWriter::DumpWriter(const char* path, bool overwrite, AbstractCompressor* compressor, bool owns_compressor) :
   AbstractDumpWriter(),
   _writer(new (std::nothrow) FileWriter(path, overwrite)),
   _compressor(compressor),
+  _owns_compressor(owns_compressor),
   _bytes_written(0),
   _error(nullptr),
   _out_buffer(nullptr),
@@ -687,6 +690,9 @@ DumpWriter::~DumpWriter(){
   if (_writer != nullptr) {
     delete _writer;
   }
+  if (_owns_compressor && _compressor != nullptr) {
+    delete _compressor;
+  }
   _bytes_written = -1;
 }
 
@@ -1919,18 +1925,193 @@ class UnmountedVThreadDumper {
   virtual void dump_vthread(oop vt, AbstractDumpWriter* segment_writer) = 0;
 };
 
+// Support for incremental (delta) heap dumps. The heap is divided into
+// regions of RegionSize bytes, and a digest of the objects starting in each
+// region is kept from one delta dump to the next. A delta dump only writes
+// the objects of the regions whose digest changed since the previous delta
+// dump. Classes, threads and roots are always written, so references into
+// unchanged regions refer to objects written by an earlier dump. A GC that
+// moves objects changes the digests of the affected regions, thus such
+// regions are written again.
+class HeapDumpDelta : public CHeapObj<mtServiceability> {
+ private:
+  static const int LogRegionSize = 20;
+  static const size_t RegionSize = (size_t)1 << LogRegionSize;
+
+  struct RegionDigest {
+    u8   _digest;
+    bool _changed;
+  };
+
+  typedef ResizeableResourceHashtable<uintptr_t, RegionDigest,
+                                      AnyObj::C_HEAP, mtServiceability> DigestTable;
+
+  // Digests of the previous delta dump. Only accessed by the VM thread
+  // at a safepoint, so delta dumps are serialized.
+  static DigestTable* _previous;
+  static uint         _previous_sequence;
+
+  DigestTable*              _digests;
+  GrowableArray<uintptr_t>* _changed;
+  uint                      _sequence;
+  bool                      _has_base;
+
+  static uintptr_t region_of(oop o) {
+    return cast_from_oop<uintptr_t>(o) >> LogRegionSize;
+  }
+
+  static u8 mix(u8 h) {
+    h ^= h >> 33;
+    h *= UCONST64(0xff51afd7ed558ccd);
+    h ^= h >> 33;
+    h *= UCONST64(0xc4ceb9fe1a85ec53);
+    h ^= h >> 33;
+    return h;
+  }
+
+  // The mark word is skipped, since age and lock bits change without the
+  // object being modified.
+  static u8 object_digest(oop o) {
+    const u8* p = (const u8*)cast_from_oop<HeapWord*>(o);
+    size_t words = o->size();
+    u8 h = (u8)p2i(p);
+    for (size_t i = 1; i < words; i++) {
+      h = (h ^ p[i]) * UCONST64(0x100000001b3);
+    }
+    return mix(h ^ words);
+  }
+
+  class DigestClosure : public ObjectClosure {
+   private:
+    DigestTable* _digests;
+   public:
+    DigestClosure(DigestTable* digests) : _digests(digests) {}
+    void do_object(oop o) {
+      bool created;
+      RegionDigest* region = _digests->put_if_absent(region_of(o), &created);
+      if (created) {
+        region->_digest = 0;
+        region->_changed = true;
+        _digests->maybe_grow();
+      }
+      // Addition is used so that the region digest does not
+      // depend on the order the objects are visited in.
+      region->_digest += object_digest(o);
+    }
+  };
+
+  static int compare_regions(uintptr_t* a, uintptr_t* b) {
+    return *a < *b ? -1 : (*a > *b ? 1 : 0);
+  }
+
+ public:
+  HeapDumpDelta() :
+    _digests(nullptr),
+    _changed(new (mtServiceability) GrowableArray<uintptr_t>(64, mtServiceability)),
+    _sequence(0),
+    _has_base(false) { }
+
+  ~HeapDumpDelta() {
+    delete _changed;
+  }
+
+  // Computes the region digests of the heap and compares them with the
+  // ones of the previous delta dump, which are then replaced. Must be called
+  // at a safepoint with a parsable heap.
+  void compute();
+
+  // Returns whether the object needs to be written to the dump.
+  // Only valid at the safepoint of the dump.
+  bool should_dump(oop o) const {
+    RegionDigest* region = _digests->get(region_of(o));
+    return region == nullptr || region->_changed;
+  }
+
+  // Writes the manifest describing the written regions next to the dump file.
+  // Returns null on success and a static error message otherwise.
+  char const* write_manifest(const char* dump_path) const;
+};
+
+HeapDumpDelta::DigestTable* HeapDumpDelta::_previous = nullptr;
+uint                        HeapDumpDelta::_previous_sequence = 0;
+
+void HeapDumpDelta::compute() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  TraceTime timer("Compute delta dump regions", TRACETIME_LOG(Info, heapdump));
+
+  _digests = new (mtServiceability) DigestTable(1009, 4915219);
+  DigestClosure cl(_digests);
+  Universe::heap()->object_iterate(&cl);
+
+  // Without a previous dump all regions are considered changed,
+  // and this dump becomes the base for the following delta dumps.
+  _has_base = _previous != nullptr;
+  DigestTable* previous = _previous;
+  GrowableArray<uintptr_t>* changed = _changed;
+  _digests->iterate_all([&] (const uintptr_t& index, RegionDigest& region) {
+    if (previous != nullptr) {
+      RegionDigest* old_region = previous->get(index);
+      region._changed = old_region == nullptr || old_region->_digest != region._digest;
+    }
+    if (region._changed) {
+      changed->append(index);
+    }
+  });
+  _changed->sort(compare_regions);
+
+  // Remember the digests for the next delta dump.
+  delete _previous;
+  _previous = _digests;
+  _sequence = ++_previous_sequence;
+
+  log_info(heapdump)("Delta dump %u: %d of %d regions changed",
+                     _sequence, _changed->length(), _digests->number_of_entries());
+}
+
+char const* HeapDumpDelta::write_manifest(const char* dump_path) const {
+  stringStream manifest_path;
+  manifest_path.print("%s.delta", dump_path);
+  fileStream out(manifest_path.base(), "w");
+  if (!out.is_open()) {
+    return "Could not create delta dump manifest";
+  }
+
+  out.print_cr("# HPROF delta dump manifest");
+  out.print_cr("sequence=%u", _sequence);
+  if (_has_base) {
+    out.print_cr("base_sequence=%u", _sequence - 1);
+  } else {
+    out.print_cr("base_sequence=none");
+  }
+  out.print_cr("region_size=" SIZE_FORMAT, RegionSize);
+  out.print_cr("changed_regions=%d", _changed->length());
+
+  // Print the address ranges of the written objects, coalescing adjacent regions.
+  int i = 0;
+  while (i < _changed->length()) {
+    uintptr_t start = _changed->at(i);
+    uintptr_t end = start + 1;
+    while (++i < _changed->length() && _changed->at(i) == end) {
+      end++;
+    }
+    out.print_cr("changed=" PTR_FORMAT "-" PTR_FORMAT, start << LogRegionSize, end << LogRegionSize);
+  }
+  return nullptr;
+}
+
 // Support class used when iterating over the heap.
 class HeapObjectDumper : public ObjectClosure {
  private:
   AbstractDumpWriter* _writer;
   AbstractDumpWriter* writer()                  { return _writer; }
   UnmountedVThreadDumper* _vthread_dumper;
+  const HeapDumpDelta* _delta;
 
   DumperClassCacheTable _class_cache;
 
  public:
-  HeapObjectDumper(AbstractDumpWriter* writer, UnmountedVThreadDumper* vthread_dumper)
-    : _writer(writer), _vthread_dumper(vthread_dumper) {}
+  HeapObjectDumper(AbstractDumpWriter* writer, UnmountedVThreadDumper* vthread_dumper, const HeapDumpDelta* delta)
+    : _writer(writer), _vthread_dumper(vthread_dumper), _delta(delta) {}
 
   // called for each object in the heap
   void do_object(oop o);
@@ -1948,15 +2129,22 @@ void HeapObjectDumper::do_object(oop o) {
     return;
   }
 
+  // in a delta dump only the objects of changed regions are written
+  bool dump_object = _delta == nullptr || _delta->should_dump(o);
+
   if (o->is_instance()) {
     // create a HPROF_GC_INSTANCE record for each object
-    DumperSupport::dump_instance(writer(), o, &_class_cache);
+    if (dump_object) {
+      DumperSupport::dump_instance(writer(), o, &_class_cache);
+    }
     // If we encounter an unmounted virtual thread it needs to be dumped explicitly
     // (mounted virtual threads are dumped with their carriers).
     if (java_lang_VirtualThread::is_instance(o)
         && ThreadDumper::should_dump_vthread(o) && !ThreadDumper::is_vthread_mounted(o)) {
       _vthread_dumper->dump_vthread(o, writer());
     }
+  } else if (!dump_object) {
+    return;
   } else if (o->is_objArray()) {
     // create a HPROF_GC_OBJ_ARRAY_DUMP record for each object array
     DumperSupport::dump_object_array(writer(), objArrayOop(o));
@@ -2209,6 +2397,9 @@ class VM_HeapDumper : public VM_GC_Operation, public WorkerTask, public Unmounte
   DumperController*       _dumper_controller;
   ParallelObjectIterator* _poi;
 
+  // delta dump support, null for a full dump
+  HeapDumpDelta*          _delta;
+
   // Dumper id of VMDumper thread.
   static const int VMDumperId = 0;
   // VM dumper dumps both heap and non-heap data, other dumpers dump heap-only data.
@@ -2253,7 +2444,7 @@ class VM_HeapDumper : public VM_GC_Operation, public WorkerTask, public Unmounte
   void dump_stack_traces(AbstractDumpWriter* writer);
 
  public:
-  VM_HeapDumper(DumpWriter* writer, bool gc_before_heap_dump, bool oome, uint num_dump_threads) :
+  VM_HeapDumper(DumpWriter* writer, bool gc_before_heap_dump, bool oome, uint num_dump_threads, HeapDumpDelta* delta) :
     VM_GC_Operation(0 /* total collections,      dummy, ignored */,
                     GCCause::_heap_dump /* GC Cause */,
                     0 /* total full collections, dummy, ignored */,
@@ -2272,6 +2463,7 @@ class VM_HeapDumper : public VM_GC_Operation, public WorkerTask, public Unmounte
     _num_dumper_threads = num_dump_threads;
     _dumper_controller = nullptr;
     _poi = nullptr;
+    _delta = delta;
     if (oome) {
       assert(!Thread::current()->is_VM_thread(), "Dump from OutOfMemoryError cannot be called by the VMThread");
       // get OutOfMemoryError zero-parameter constructor
@@ -2435,6 +2627,10 @@ void VM_HeapDumper::doit() {
   set_global_dumper();
   set_global_writer();
 
+  if (_delta != nullptr) {
+    _delta->compute();
+  }
+
   WorkerThreads* workers = ch->safepoint_workers();
   prepare_parallel_dump(workers);
 
@@ -2495,9 +2691,18 @@ void VM_HeapDumper::work(uint worker_id) {
   // HPROF_HEAP_DUMP/HPROF_HEAP_DUMP_SEGMENT starts here
 
   ResourceMark rm;
-  // share global compressor, local DumpWriter is not responsible for its life cycle
+  // Every dumper compresses its segment with a private copy of the global compressor,
+  // so that no compression state is shared between threads. The compressed segments
+  // are self-contained and are concatenated as they are by the DumpMerger.
+  AbstractCompressor* segment_compressor = nullptr;
+  if (writer()->compressor() != nullptr) {
+    segment_compressor = writer()->compressor()->clone();
+  }
   DumpWriter segment_writer(DumpMerger::get_writer_path(writer()->get_file_path(), dumper_id),
-                            writer()->is_overwrite(), writer()->compressor());
+                            writer()->is_overwrite(), segment_compressor, true /* owns_compressor */);
+  if (writer()->compressor() != nullptr && segment_compressor == nullptr) {
+    segment_writer.set_error("Could not allocate segment compressor");
+  }
   if (!segment_writer.has_error()) {
     if (is_vm_dumper(dumper_id)) {
       // dump some non-heap subrecords to heap dump segment
@@ -2531,7 +2736,7 @@ void VM_HeapDumper::work(uint worker_id) {
     // of the heap dump.
 
     TraceTime timer(is_parallel_dump() ? "Dump heap objects in parallel" : "Dump heap objects", TRACETIME_LOG(Info, heapdump));
-    HeapObjectDumper obj_dumper(&segment_writer, this);
+    HeapObjectDumper obj_dumper(&segment_writer, this, _delta);
     if (!is_parallel_dump()) {
       Universe::heap()->object_iterate(&obj_dumper);
     } else {
@@ -2617,7 +2822,8 @@ void VM_HeapDumper::dump_vthread(oop vt, AbstractDumpWriter* segment_writer) {
 }
 
 // dump the heap to given path.
-int HeapDumper::dump(const char* path, outputStream* out, int compression, bool overwrite, uint num_dump_threads) {
+int HeapDumper::dump(const char* path, outputStream* out, int compression, bool overwrite, uint num_dump_threads,
+                     CompressionType compression_type) {
   assert(path != nullptr && strlen(path) > 0, "path missing");
 
   // print message in interactive case
@@ -2628,7 +2834,7 @@ int HeapDumper::dump(const char* path, outputStream* out, int compression, bool
 
   if (_oome && num_dump_threads > 1) {
     // Each additional parallel writer requires several MB of internal memory
-    // (DumpWriter buffer, DumperClassCacheTable, GZipCompressor buffers).
+    // (DumpWriter buffer, DumperClassCacheTable, compressor buffers).
     // For the OOM handling we may already be limited in memory.
     // Lets ensure we have at least 20MB per thread.
     julong max_threads = os::free_memory() / (20 * M);
@@ -2643,10 +2849,14 @@ int HeapDumper::dump(const char* path, outputStream* out, int compression, bool
   AbstractCompressor* compressor = nullptr;
 
   if (compression > 0) {
-    compressor = new (std::nothrow) GZipCompressor(compression);
+    if (compression_type == CompressionType::zstd) {
+      compressor = new (std::nothrow) ZstdCompressor(compression);
+    } else {
+      compressor = new (std::nothrow) GZipCompressor(compression);
+    }
 
     if (compressor == nullptr) {
-      set_error("Could not allocate gzip compressor");
+      set_error("Could not allocate compressor");
       return -1;
     }
   }
@@ -2662,8 +2872,17 @@ int HeapDumper::dump(const char* path, outputStream* out, int compression, bool
     return -1;
   }
 
+  HeapDumpDelta* delta = nullptr;
+  if (_delta) {
+    delta = new (std::nothrow) HeapDumpDelta();
+    if (delta == nullptr) {
+      set_error("Could not allocate delta dump support");
+      return -1;
+    }
+  }
+
   // generate the segmented heap dump into separate files
-  VM_HeapDumper dumper(&writer, _gc_before_heap_dump, _oome, num_dump_threads);
+  VM_HeapDumper dumper(&writer, _gc_before_heap_dump, _oome, num_dump_threads, delta);
   VMThread::execute(&dumper);
 
   // record any error that the writer may have encountered
@@ -2686,6 +2905,17 @@ int HeapDumper::dump(const char* path, outputStream* out, int compression, bool
     set_error(writer.error());
   }
 
+  if (delta != nullptr) {
+    if (error() == nullptr) {
+      const char* msg = delta->write_manifest(path);
+      if (msg != nullptr) {
+        set_error(msg);
+        writer.set_error(msg);
+      }
+    }
+    delete delta;
+  }
+
   // emit JFR event
   if (error() == nullptr) {
     event.set_destination(path);
@@ -37,10 +37,11 @@ class HeapDumper : public StackObj {
   char* _error;
   bool _gc_before_heap_dump;
   bool _oome;
+  bool _delta;
   elapsedTimer _t;
 
   HeapDumper(bool gc_before_heap_dump, bool oome) :
-    _error(nullptr), _gc_before_heap_dump(gc_before_heap_dump), _oome(oome) { }
+    _error(nullptr), _gc_before_heap_dump(gc_before_heap_dump), _oome(oome), _delta(false) { }
 
   // string representation of error
   char* error() const                   { return _error; }
@@ -52,16 +53,28 @@ class HeapDumper : public StackObj {
   static void dump_heap(bool oome);
 
  public:
+  // Compressed formats of the dump file.
+  enum class CompressionType {
+    gzip,
+    zstd
+  };
+
   HeapDumper(bool gc_before_heap_dump) :
-    _error(nullptr), _gc_before_heap_dump(gc_before_heap_dump), _oome(false) { }
+    _error(nullptr), _gc_before_heap_dump(gc_before_heap_dump), _oome(false), _delta(false) { }
 
   ~HeapDumper();
 
+  // requests a delta dump, i.e. only the objects in heap regions changed since the
+  // previous delta dump are written, and a manifest is written to <path>.delta.
+  void set_delta(bool delta)            { _delta = delta; }
+
   // dumps the heap to the specified file, returns 0 if success.
   // additional info is written to out if not null.
-  // compression >= 0 creates a gzipped file with the given compression level.
+  // compression >= 0 creates a compressed file with the given compression level,
+  // using the format given by compression_type.
   // parallel_thread_num >= 0 indicates thread numbers of parallel object dump.
-  int dump(const char* path, outputStream* out = nullptr, int compression = -1, bool overwrite = false, uint parallel_thread_num = default_num_of_dump_threads());
+  int dump(const char* path, outputStream* out = nullptr, int compression = -1, bool overwrite = false, uint parallel_thread_num = default_num_of_dump_threads(),
+           CompressionType compression_type = CompressionType::gzip);
 
   // returns error message (resource allocated), or null if no error
   char* error_as_C_string() const;
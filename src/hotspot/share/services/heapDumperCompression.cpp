@@ -25,6 +25,7 @@
 
 #include "precompiled.hpp"
 #include "jvm.h"
+#include "runtime/atomic.hpp"
 #include "runtime/os.hpp"
 #include "services/heapDumperCompression.hpp"
 #include "utilities/zipLibrary.hpp"
@@ -86,3 +87,88 @@ char const* GZipCompressor::compress(char* in, size_t in_size, char* out, size_t
 
   return msg;
 }
+
+AbstractCompressor* GZipCompressor::clone() const {
+  return new (std::nothrow) GZipCompressor(_level);
+}
+
+// Entry points in the zstd library.
+typedef size_t (*ZSTD_compressBound_t)(size_t src_size);
+typedef size_t (*ZSTD_compress_t)(void* dst, size_t dst_capacity, const void* src,
+                                  size_t src_size, int level);
+typedef unsigned (*ZSTD_isError_t)(size_t code);
+typedef const char* (*ZSTD_getErrorName_t)(size_t code);
+
+static ZSTD_compressBound_t ZSTD_compressBound = nullptr;
+static ZSTD_compress_t ZSTD_compress = nullptr;
+static ZSTD_isError_t ZSTD_isError = nullptr;
+static ZSTD_getErrorName_t ZSTD_getErrorName = nullptr;
+
+static volatile bool _zstd_loaded = false;
+
+static void* load_zstd_library() {
+  char ebuf[1024];
+  void* handle = os::dll_load(JNI_LIB_PREFIX "zstd" JNI_LIB_SUFFIX, ebuf, sizeof(ebuf));
+#ifdef LINUX
+  if (handle == nullptr) {
+    // Distributions usually only ship the development symlink with the headers.
+    handle = os::dll_load("libzstd.so.1", ebuf, sizeof(ebuf));
+  }
+#endif
+  return handle;
+}
+
+// Loading is idempotent, so concurrent callers may race without harm.
+static char const* initialize_zstd() {
+  if (Atomic::load_acquire(&_zstd_loaded)) {
+    return nullptr;
+  }
+
+  void* handle = load_zstd_library();
+
+  if (handle == nullptr) {
+    return "Could not load zstd library";
+  }
+
+  ZSTD_compressBound = CAST_TO_FN_PTR(ZSTD_compressBound_t, os::dll_lookup(handle, "ZSTD_compressBound"));
+  ZSTD_compress = CAST_TO_FN_PTR(ZSTD_compress_t, os::dll_lookup(handle, "ZSTD_compress"));
+  ZSTD_isError = CAST_TO_FN_PTR(ZSTD_isError_t, os::dll_lookup(handle, "ZSTD_isError"));
+  ZSTD_getErrorName = CAST_TO_FN_PTR(ZSTD_getErrorName_t, os::dll_lookup(handle, "ZSTD_getErrorName"));
+
+  if (ZSTD_compressBound == nullptr || ZSTD_compress == nullptr ||
+      ZSTD_isError == nullptr || ZSTD_getErrorName == nullptr) {
+    return "Could not resolve zstd library functions";
+  }
+
+  Atomic::release_store(&_zstd_loaded, true);
+  return nullptr;
+}
+
+char const* ZstdCompressor::init(size_t block_size, size_t* needed_out_size,
+                                 size_t* needed_tmp_size) {
+  char const* msg = initialize_zstd();
+
+  if (msg == nullptr) {
+    *needed_out_size = ZSTD_compressBound(block_size);
+    *needed_tmp_size = 0;
+  }
+
+  return msg;
+}
+
+char const* ZstdCompressor::compress(char* in, size_t in_size, char* out, size_t out_size,
+                                     char* tmp, size_t tmp_size, size_t* compressed_size) {
+  size_t result = ZSTD_compress(out, out_size, in, in_size, _level);
+
+  if (ZSTD_isError(result)) {
+    *compressed_size = 0;
+    return ZSTD_getErrorName(result);
+  }
+
+  *compressed_size = result;
+  return nullptr;
+}
+
+AbstractCompressor* ZstdCompressor::clone() const {
+  return new (std::nothrow) ZstdCompressor(_level);
+}
@@ -43,6 +43,11 @@ class AbstractCompressor : public CHeapObj<mtInternal> {
   // message otherwise. Sets the 'compressed_size'.
   virtual char const* compress(char* in, size_t in_size, char* out, size_t out_size,
                                char* tmp, size_t tmp_size, size_t* compressed_size) = 0;
+
+  // Creates an uninitialized compressor with the same settings. Used to give every
+  // parallel dumper its own instance, so that compressing heap dump segments does not
+  // share any state between threads. Returns null if the allocation failed.
+  virtual AbstractCompressor* clone() const = 0;
 };
 
 // Interface for a writer implementation.
@@ -100,6 +105,30 @@ class GZipCompressor : public AbstractCompressor {
 
   virtual char const* compress(char* in, size_t in_size, char* out, size_t out_size,
                                char* tmp, size_t tmp_size, size_t* compressed_size);
+
+  virtual AbstractCompressor* clone() const;
+};
+
+
+// A compressor using the zstd format. Every block is written as a separate zstd
+// frame, so the output of several compressors can simply be concatenated. The
+// compression is done by the zstd library of the platform, which is loaded on
+// first use.
+class ZstdCompressor : public AbstractCompressor {
+private:
+  int _level;
+
+public:
+  ZstdCompressor(int level) : _level(level) {
+  }
+
+  virtual char const* init(size_t block_size, size_t* needed_out_size,
+                           size_t* needed_tmp_size);
+
+  virtual char const* compress(char* in, size_t in_size, char* out, size_t out_size,
+                               char* tmp, size_t tmp_size, size_t* compressed_size);
+
+  virtual AbstractCompressor* clone() const;
 };
 
 #endif // SHARE_SERVICES_HEAPDUMPERCOMPRESSION_HPP
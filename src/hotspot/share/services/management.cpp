@@ -54,6 +54,7 @@
 #include "runtime/threads.hpp"
 #include "runtime/threadSMR.hpp"
 #include "runtime/vmOperations.hpp"
+#include "services/allocationSiteService.hpp"
 #include "services/classLoadingService.hpp"
 #include "services/diagnosticCommand.hpp"
 #include "services/diagnosticFramework.hpp"
@@ -100,6 +101,7 @@ void management_init() {
 #else
   ThreadService::init();
 #endif // INCLUDE_MANAGEMENT
+  AllocationSiteService::init();
 }
 
 #if INCLUDE_MANAGEMENT
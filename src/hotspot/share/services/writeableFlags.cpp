@@ -24,11 +24,14 @@
 
 #include "precompiled.hpp"
 #include "classfile/javaClasses.hpp"
+#include "gc/shared/collectedHeap.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/resourceArea.hpp"
+#include "memory/universe.hpp"
 #include "runtime/flags/jvmFlag.hpp"
 #include "runtime/flags/jvmFlagAccess.hpp"
 #include "runtime/flags/jvmFlagLimit.hpp"
+#include "runtime/globals_extension.hpp"
 #include "runtime/java.hpp"
 #include "runtime/jniHandles.hpp"
 #include "services/writeableFlags.hpp"
@@ -237,7 +240,11 @@ JVMFlag::Error WriteableFlags::set_flag(const char* name, const void* value, JVM
   if (f) {
     // only writeable flags are allowed to be set
     if (f->is_writeable()) {
-      return setter(f, value, origin, err_msg);
+      JVMFlag::Error err = setter(f, value, origin, err_msg);
+      if (err == JVMFlag::SUCCESS && f == JVMFlag::flag_from_enum(FLAG_MEMBER_ENUM(SoftMaxHeapSize))) {
+        Universe::heap()->soft_max_heap_size_changed();
+      }
+      return err;
     } else {
       err_msg.print("only 'writeable' flags can be set");
       return JVMFlag::NON_WRITABLE;
@@ -270,6 +270,22 @@ class ConcurrentHashTable<CONFIG, F>::ScanTask :
     _new_table_claimer.set(claim_size, new_table);
   }
 
+  // Visits one claimed range outside of a safepoint, returns false when all
+  // ranges are done. The caller must make sure that no other thread
+  // modifies the table while the task is in progress.
+  template <typename SCAN_FUNC>
+  bool do_task(Thread* thread, SCAN_FUNC& scan_f) {
+    assert(!SafepointSynchronize::is_at_safepoint(),
+           "must be outside a safepoint");
+    size_t start_idx = 0, stop_idx = 0;
+    InternalTable* table = nullptr;
+    if (!claim(&start_idx, &stop_idx, &table)) {
+      return false;
+    }
+    this->_cht->do_scan_for_range(scan_f, start_idx, stop_idx, table);
+    return true;
+  }
+
   template <typename SCAN_FUNC>
   void  do_safepoint_scan(SCAN_FUNC& scan_f) {
     assert(SafepointSynchronize::is_at_safepoint(),
@@ -27,12 +27,15 @@
 #if !defined(_WINDOWS) && !defined(__APPLE__)
 
 #include "memory/allocation.inline.hpp"
+#include "runtime/os.hpp"
 #include "utilities/checkedCast.hpp"
 #include "utilities/elfFuncDescTable.hpp"
 #include "utilities/elfSymbolTable.hpp"
+#include "utilities/quickSort.hpp"
 
 ElfSymbolTable::ElfSymbolTable(FILE* const file, Elf_Shdr& shdr) :
-  _next(nullptr), _fd(file), _section(file, shdr) {
+  _next(nullptr), _fd(file), _section(file, shdr),
+  _sorted_symbols(nullptr), _sorted_count(0), _index_built(false) {
   assert(file != nullptr, "null file handle");
   _status = _section.status();
 
@@ -45,6 +48,81 @@ ElfSymbolTable::~ElfSymbolTable() {
   if (_next != nullptr) {
     delete _next;
   }
+  if (_sorted_symbols != nullptr) {
+    os::free(_sorted_symbols);
+  }
+}
+
+int ElfSymbolTable::compare_sorted(const SortedSymbol& a, const SortedSymbol& b) {
+  if (a._start != b._start) {
+    return a._start < b._start ? -1 : 1;
+  }
+  // Aliases with a lower index in the section sort last, so that they are
+  // found first when searching backwards, like with a scan of the section.
+  return b._index - a._index;
+}
+
+bool ElfSymbolTable::build_index(const Elf_Sym* symbols, int count) {
+  assert(_sorted_symbols == nullptr, "invariant");
+  int num_functions = 0;
+  for (int index = 0; index < count; index++) {
+    if (STT_FUNC == ELF_ST_TYPE(symbols[index].st_info) && symbols[index].st_size > 0) {
+      num_functions++;
+    }
+  }
+  if (num_functions == 0) {
+    return false;
+  }
+  // Not enough memory for the index is okay, the section is scanned instead.
+  _sorted_symbols = (SortedSymbol*)os::malloc(sizeof(SortedSymbol) * num_functions, mtInternal);
+  if (_sorted_symbols == nullptr) {
+    return false;
+  }
+  for (int index = 0; index < count; index++) {
+    const Elf_Sym* const sym = &symbols[index];
+    if (STT_FUNC == ELF_ST_TYPE(sym->st_info) && sym->st_size > 0) {
+      SortedSymbol* const entry = &_sorted_symbols[_sorted_count++];
+      entry->_start = (address)sym->st_value;
+      entry->_end = entry->_start + sym->st_size;
+      entry->_name = sym->st_name;
+      entry->_index = index;
+    }
+  }
+  QuickSort::sort(_sorted_symbols, _sorted_count, compare_sorted);
+  address max_end = nullptr;
+  for (int i = 0; i < _sorted_count; i++) {
+    max_end = MAX2(max_end, _sorted_symbols[i]._end);
+    _sorted_symbols[i]._max_end = max_end;
+  }
+  return true;
+}
+
+bool ElfSymbolTable::lookup_in_index(address addr, int* stringtableIndex, int* posIndex, int* offset) const {
+  // Find the last symbol starting at or below addr.
+  int low = 0;
+  int high = _sorted_count - 1;
+  int candidate = -1;
+  while (low <= high) {
+    const int mid = low + (high - low) / 2;
+    if (_sorted_symbols[mid]._start <= addr) {
+      candidate = mid;
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+  // Symbols may nest or overlap, walk back as long as a preceding symbol can
+  // still contain addr.
+  for (int i = candidate; i >= 0 && _sorted_symbols[i]._max_end > addr; i--) {
+    const SortedSymbol* const entry = &_sorted_symbols[i];
+    if (addr < entry->_end) {
+      *offset = (int)(addr - entry->_start);
+      *posIndex = entry->_name;
+      *stringtableIndex = _section.section_header()->sh_link;
+      return true;
+    }
+  }
+  return false;
 }
 
 bool ElfSymbolTable::compare(const Elf_Sym* sym, address addr, int* stringtableIndex, int* posIndex, int* offset, ElfFuncDescTable* funcDescTable) {
@@ -81,6 +159,16 @@ bool ElfSymbolTable::lookup(address addr, int* stringtableIndex, int* posIndex,
   int count = checked_cast<int>(_section.section_header()->sh_size / sym_size);
   Elf_Sym* symbols = (Elf_Sym*)_section.section_data();
 
+  if (symbols != nullptr && funcDescTable == nullptr) {
+    if (!_index_built) {
+      _index_built = true;
+      build_index(symbols, count);
+    }
+    if (_sorted_symbols != nullptr) {
+      return lookup_in_index(addr, stringtableIndex, posIndex, offset);
+    }
+  }
+
   if (symbols != nullptr) {
     for (int index = 0; index < count; index ++) {
       if (compare(&symbols[index], addr, stringtableIndex, posIndex, offset, funcDescTable)) {
@@ -37,6 +37,8 @@
  * Whenever possible, it will load all symbols from the corresponding section
  * of the elf file into memory. Otherwise, it will walk the section in file
  * to look up the symbol that nearest the given address.
+ * When the symbols are loaded, the function symbols are also indexed by
+ * address on the first lookup, so that lookups need not scan the section.
  */
 class ElfSymbolTable: public CHeapObj<mtInternal> {
   friend class ElfFile;
@@ -50,6 +52,18 @@ class ElfSymbolTable: public CHeapObj<mtInternal> {
   ElfSection      _section;
 
   NullDecoder::decoder_status _status;
+
+  // function symbols sorted by start address
+  struct SortedSymbol {
+    address _start;
+    address _end;
+    address _max_end;  // the largest _end of this and all preceding symbols
+    int     _name;
+    int     _index;    // index in the section, to order aliases
+  };
+  SortedSymbol*   _sorted_symbols;
+  int             _sorted_count;
+  bool            _index_built;
 public:
   ElfSymbolTable(FILE* const file, Elf_Shdr& shdr);
   ~ElfSymbolTable();
@@ -63,6 +77,10 @@ class ElfSymbolTable: public CHeapObj<mtInternal> {
   void set_next(ElfSymbolTable* next) { _next = next; }
 
   bool compare(const Elf_Sym* sym, address addr, int* stringtableIndex, int* posIndex, int* offset, ElfFuncDescTable* funcDescTable);
+
+  bool build_index(const Elf_Sym* symbols, int count);
+  bool lookup_in_index(address addr, int* stringtableIndex, int* posIndex, int* offset) const;
+  static int compare_sorted(const SortedSymbol& a, const SortedSymbol& b);
 };
 
 #endif // !_WINDOWS and !__APPLE__
@@ -686,3 +686,103 @@ void JSON::error(JSON_ERROR e, const char* format, ...) {
   }
 }
 
+JSONWriter::JSONWriter(outputStream* st) : _st(st), _depth(0) {
+  _has_elements[0] = false;
+}
+
+void JSONWriter::begin_value(const char* key) {
+  if (_has_elements[_depth]) {
+    _st->print(",");
+  }
+  _has_elements[_depth] = true;
+  if (key != nullptr) {
+    print_string_value(key);
+    _st->print(":");
+  }
+}
+
+void JSONWriter::print_string_value(const char* s) {
+  _st->print("\"");
+  // Write the characters that need no escaping in runs.
+  const char* run = s;
+  for (const char* p = s; *p != '\0'; p++) {
+    const u_char c = (u_char)*p;
+    if (c >= ' ' && c != '"' && c != '\\') {
+      continue;
+    }
+    if (p > run) {
+      _st->write(run, p - run);
+    }
+    run = p + 1;
+    switch (c) {
+      case '"':  _st->print("\\\""); break;
+      case '\\': _st->print("\\\\"); break;
+      case '\b': _st->print("\\b"); break;
+      case '\f': _st->print("\\f"); break;
+      case '\n': _st->print("\\n"); break;
+      case '\r': _st->print("\\r"); break;
+      case '\t': _st->print("\\t"); break;
+      default:   _st->print("\\u%04x", c); break;
+    }
+  }
+  const size_t len = strlen(run);
+  if (len > 0) {
+    _st->write(run, len);
+  }
+  _st->print("\"");
+}
+
+void JSONWriter::begin_object(const char* key) {
+  begin_value(key);
+  _st->print("{");
+  assert(_depth + 1 < max_depth, "nested too deep");
+  _has_elements[++_depth] = false;
+}
+
+void JSONWriter::end_object() {
+  assert(_depth > 0, "unbalanced");
+  _depth--;
+  _st->print("}");
+}
+
+void JSONWriter::begin_array(const char* key) {
+  begin_value(key);
+  _st->print("[");
+  assert(_depth + 1 < max_depth, "nested too deep");
+  _has_elements[++_depth] = false;
+}
+
+void JSONWriter::end_array() {
+  assert(_depth > 0, "unbalanced");
+  _depth--;
+  _st->print("]");
+}
+
+void JSONWriter::print_string(const char* key, const char* value) {
+  begin_value(key);
+  if (value != nullptr) {
+    print_string_value(value);
+  } else {
+    _st->print("null");
+  }
+}
+
+void JSONWriter::print_int(const char* key, int64_t value) {
+  begin_value(key);
+  _st->print(INT64_FORMAT, value);
+}
+
+void JSONWriter::print_uint(const char* key, uint64_t value) {
+  begin_value(key);
+  _st->print(UINT64_FORMAT, value);
+}
+
+void JSONWriter::print_bool(const char* key, bool value) {
+  begin_value(key);
+  _st->print(value ? "true" : "false");
+}
+
+void JSONWriter::print_null(const char* key) {
+  begin_value(key);
+  _st->print("null");
+}
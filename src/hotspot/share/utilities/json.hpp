@@ -109,4 +109,33 @@ class JSON : public ResourceObj {
   const char* strerror(JSON_ERROR e);
 };
 
+// Writes JSON to an outputStream as it is produced, so that large outputs
+// need not be built up in memory. The separators between the elements are
+// taken care of, the caller has to balance the begin and end calls. Values
+// inside an object are given a key, values inside an array are not.
+class JSONWriter : public StackObj {
+ private:
+  static const uint max_depth = 32;
+  outputStream* const _st;
+  uint _depth;
+  bool _has_elements[max_depth];
+
+  void begin_value(const char* key);
+  void print_string_value(const char* s);
+
+ public:
+  JSONWriter(outputStream* st);
+
+  void begin_object(const char* key = nullptr);
+  void end_object();
+  void begin_array(const char* key = nullptr);
+  void end_array();
+
+  void print_string(const char* key, const char* value);
+  void print_int(const char* key, int64_t value);
+  void print_uint(const char* key, uint64_t value);
+  void print_bool(const char* key, bool value);
+  void print_null(const char* key);
+};
+
 #endif // SHARE_UTILITIES_JSON_HPP
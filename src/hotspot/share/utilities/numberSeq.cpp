@@ -205,6 +205,31 @@ double TruncatedSeq::oldest() const {
   }
 }
 
+double TruncatedSeq::percentile(double p) const {
+  assert(p >= 0.0 && p <= 100.0, "percentile out of range: %f", p);
+  if (_num == 0)
+    return 0.0;
+  int rank = MAX2((int)ceil(p / 100.0 * _num), 1);
+  // The buffer is short, select the rank-th smallest value without sorting
+  // a copy of it.
+  for (int i = 0; i < _num; ++i) {
+    double val = _sequence[i];
+    int smaller = 0;
+    int equal = 0;
+    for (int j = 0; j < _num; ++j) {
+      if (_sequence[j] < val) {
+        ++smaller;
+      } else if (_sequence[j] == val) {
+        ++equal;
+      }
+    }
+    if (smaller < rank && rank <= smaller + equal) {
+      return val;
+    }
+  }
+  return maximum();
+}
+
 double TruncatedSeq::predict_next() const {
   if (_num == 0) {
     // No data points, pick function: y = 0 + 0*x
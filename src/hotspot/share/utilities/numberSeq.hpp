@@ -126,6 +126,7 @@ class TruncatedSeq: public AbsSeq {
 
   double oldest() const; // the oldest valid value in the sequence
   double predict_next() const; // prediction based on linear regression
+  double percentile(double p) const; // nearest-rank percentile of the buffered values
 
   // Debugging/Printing
   virtual void dump_on(outputStream* s);
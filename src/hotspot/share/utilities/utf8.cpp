@@ -24,11 +24,34 @@
 
 #include "precompiled.hpp"
 #include "memory/allocation.hpp"
+#include "utilities/checkedCast.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/utf8.hpp"
 #include "runtime/os.hpp"
 
+#include <string.h>
+
+// The ASCII fast paths below look at eight bytes at a time.
+static const uint64_t utf8_high_bits = UCONST64(0x8080808080808080);
+static const uint64_t utf8_low_bits  = UCONST64(0x0101010101010101);
+
+static inline uint64_t utf8_load_word(const void* p) {
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+// True if none of the eight bytes has its high bit set.
+static inline bool utf8_is_ascii_word(uint64_t v) {
+  return (v & utf8_high_bits) == 0;
+}
+
+// True if the eight bytes are all in the range 1..127.
+static inline bool utf8_is_nonzero_ascii_word(uint64_t v) {
+  return ((v | (v - utf8_low_bits)) & utf8_high_bits) == 0;
+}
+
 // Assume the utf8 string is in legal form and has been
 // checked in the class file parser/format checker.
 template<typename T> char* UTF8::next(const char* str, T* value) {
@@ -106,6 +129,14 @@ int UTF8::unicode_length(const char* str, int len, bool& is_latin1, bool& has_mu
   is_latin1 = true;
   unsigned char prev = 0;
   for (int i = 0; i < len; i++) {
+    // Skip ASCII a word at a time, it has no continuation bytes.
+    while (i + 8 <= len && utf8_is_ascii_word(utf8_load_word(str + i))) {
+      i += 8;
+      prev = 0;
+    }
+    if (i == len) {
+      break;
+    }
     unsigned char c = str[i];
     if ((c & 0xC0) == 0x80) {
       // Multibyte, check if valid latin1 character.
@@ -125,24 +156,7 @@ int UTF8::unicode_length(const char* str, int len, bool& is_latin1, bool& has_mu
 // The utf8 string must be in legal form and has been
 // verified in the format checker.
 int UTF8::unicode_length(const char* str, bool& is_latin1, bool& has_multibyte) {
-  int num_chars = 0;
-  has_multibyte = false;
-  is_latin1 = true;
-  unsigned char prev = 0;
-  for (const char* p = str; *p; p++) {
-    unsigned char c = (*p);
-    if ((c & 0xC0) == 0x80) {
-      // Multibyte, check if valid latin1 character.
-      has_multibyte = true;
-      if (prev > 0xC3) {
-        is_latin1 = false;
-      }
-    } else {
-      num_chars++;
-    }
-    prev = c;
-  }
-  return num_chars;
+  return unicode_length(str, checked_cast<int>(strlen(str)), is_latin1, has_multibyte);
 }
 
 // Writes a jchar as utf8 and returns the end
@@ -175,7 +189,18 @@ template<typename T> void UTF8::convert_to_unicode(const char* utf8_str, T* unic
   const char *ptr = utf8_str;
   int index = 0;
 
-  /* ASCII case loop optimization */
+  /* ASCII case loop optimization, a word at a time first */
+  while (index + 8 <= unicode_length) {
+    uint64_t word = utf8_load_word(ptr);
+    if (!utf8_is_ascii_word(word)) {
+      break;
+    }
+    for (int i = 0; i < 8; i++) {
+      unicode_str[index + i] = (T)(unsigned char)ptr[i];
+    }
+    index += 8;
+    ptr += 8;
+  }
   for (; index < unicode_length; index++) {
     if((ch = ptr[0]) > 0x7F) { break; }
     unicode_str[index] = (T)ch;
@@ -332,24 +357,17 @@ jint UTF8::get_supplementary_character(const unsigned char* str) {
 bool UTF8::is_legal_utf8(const unsigned char* buffer, int length,
                          bool version_leq_47) {
   int i = 0;
-  int count = length >> 2;
-  for (int k=0; k<count; k++) {
-    unsigned char b0 = buffer[i];
-    unsigned char b1 = buffer[i+1];
-    unsigned char b2 = buffer[i+2];
-    unsigned char b3 = buffer[i+3];
-    // For an unsigned char v,
-    // (v | v - 1) is < 128 (highest bit 0) for 0 < v < 128;
-    // (v | v - 1) is >= 128 (highest bit 1) for v == 0 or v >= 128.
-    unsigned char res = b0 | (b0 - 1) |
-                        b1 | (b1 - 1) |
-                        b2 | (b2 - 1) |
-                        b3 | (b3 - 1);
-    if (res >= 128) break;
-    i += 4;
-  }
   for(; i < length; i++) {
     unsigned short c;
+    // Skip runs of non-zero ASCII a word at a time. For each byte v,
+    // (v | v - 1) has its highest bit clear only for 0 < v < 128; the
+    // per byte subtraction can only borrow from a byte that is zero.
+    while (i + 8 <= length && utf8_is_nonzero_ascii_word(utf8_load_word(buffer + i))) {
+      i += 8;
+    }
+    if (i == length) {
+      break;
+    }
     // no embedded zeros
     if (buffer[i] == 0) return false;
     if(buffer[i] < 128) {
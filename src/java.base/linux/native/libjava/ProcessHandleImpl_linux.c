@@ -31,12 +31,18 @@
 #include "ProcessHandleImpl_unix.h"
 
 
+#include <dirent.h>
+#include <errno.h>
 #include <fcntl.h>
 #include <limits.h>
+#include <signal.h>
 #include <stdlib.h>
 #include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/wait.h>
 
 #include <string.h>
 #include <ctype.h>
@@ -66,45 +72,22 @@ jint os_getChildren(JNIEnv *env, jlong jpid, jlongArray jarray,
 }
 
 /**
- * Read /proc/<pid>/stat and return the ppid, total cputime and start time.
+ * Parse the contents of /proc/<pid>/stat and return the ppid, total cputime
+ * and start time.
  * -1 is fail;  >=  0 is parent pid
- * 'total' will contain the running time of 'pid' in nanoseconds.
- * 'start' will contain the start time of 'pid' in milliseconds since epoch.
  */
-pid_t os_getParentPidAndTimings(JNIEnv *env, pid_t pid,
-                                jlong *totalTime, jlong* startTime) {
-    FILE* fp;
-    char buffer[2048];
-    int statlen;
-    char fn[32];
+static pid_t parseStat(char *buffer, jlong *totalTime, jlong *startTime) {
     char* s;
     int parentPid;
     long unsigned int utime = 0;      // clock tics
     long unsigned int stime = 0;      // clock tics
     long long unsigned int start = 0; // microseconds
 
-    /*
-     * Try to stat and then open /proc/%d/stat
-     */
-    snprintf(fn, sizeof fn, "/proc/%d/stat", pid);
-
-    fp = fopen(fn, "r");
-    if (fp == NULL) {
-        return -1;              // fail, no such /proc/pid/stat
-    }
-
     /*
      * The format is: pid (command) state ppid ...
      * As the command could be anything we must find the right most
      * ")" and then skip the white spaces that follow it.
      */
-    statlen = fread(buffer, 1, (sizeof buffer - 1), fp);
-    fclose(fp);
-    if (statlen < 0) {
-        return -1;               // parent pid is not available
-    }
-
-    buffer[statlen] = '\0';
     s = strchr(buffer, '(');
     if (s == NULL) {
         return -1;               // parent pid is not available
@@ -131,6 +114,53 @@ pid_t os_getParentPidAndTimings(JNIEnv *env, pid_t pid,
     return parentPid;
 }
 
+/**
+ * Read <name>/stat relative to the directory dirfd and return the ppid,
+ * total cputime and start time. If uid is not NULL it is set to the owner
+ * of the process.
+ * -1 is fail;  >=  0 is parent pid
+ */
+static pid_t readStatAt(int dirfd, const char *name,
+                        jlong *totalTime, jlong *startTime, uid_t *uid) {
+    char buffer[2048];
+    char fn[48];
+    ssize_t statlen;
+    int fd;
+
+    snprintf(fn, sizeof fn, "%s/stat", name);
+    if ((fd = openat(dirfd, fn, O_RDONLY | O_CLOEXEC)) < 0) {
+        return -1;              // fail, no such /proc/pid/stat
+    }
+    if (uid != NULL) {
+        struct stat stat_buf;
+        if (fstat(fd, &stat_buf) < 0) {
+            close(fd);
+            return -1;
+        }
+        *uid = stat_buf.st_uid;
+    }
+    statlen = read(fd, buffer, sizeof buffer - 1);
+    close(fd);
+    if (statlen < 0) {
+        return -1;               // parent pid is not available
+    }
+    buffer[statlen] = '\0';
+    return parseStat(buffer, totalTime, startTime);
+}
+
+/**
+ * Read /proc/<pid>/stat and return the ppid, total cputime and start time.
+ * -1 is fail;  >=  0 is parent pid
+ * 'total' will contain the running time of 'pid' in nanoseconds.
+ * 'start' will contain the start time of 'pid' in milliseconds since epoch.
+ */
+pid_t os_getParentPidAndTimings(JNIEnv *env, pid_t pid,
+                                jlong *totalTime, jlong* startTime) {
+    char fn[32];
+    snprintf(fn, sizeof fn, "/proc/%d", pid);
+    return readStatAt(AT_FDCWD, fn, totalTime, startTime, NULL);
+}
+
 void os_getCmdlineAndUserInfo(JNIEnv *env, jobject jinfo, pid_t pid) {
     int fd;
     int cmdlen = 0;
@@ -269,3 +299,249 @@ static long long getBoottime(JNIEnv *env) {
 
     return bootTime * 1000;
 }
+
+/*
+ * Waiting for process exit with pidfds.
+ *
+ * Instead of a reaper thread blocked in waitpid() per process, a single
+ * thread can watch any number of processes: each process is opened as a
+ * pidfd, which becomes readable when the process exits, and registered with
+ * an epoll instance. The epoll data carries the pid, whether to reap the
+ * status and the pidfd, so an event can be handled without further lookup.
+ */
+
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+
+#define PIDFD_DATA(pid, fd, reap) \
+    ((jlong)(uint32_t)(pid) | ((jlong)((reap) ? 1 : 0) << 32) | ((jlong)(fd) << 33))
+#define PIDFD_DATA_PID(data)  ((pid_t)((data) & 0xFFFFFFFF))
+#define PIDFD_DATA_REAP(data) ((int)(((data) >> 32) & 1))
+#define PIDFD_DATA_FD(data)   ((int)((data) >> 33))
+
+/* Maximum number of exits returned by one call to pidfdAwait0. */
+#define PIDFD_MAX_EVENTS 64
+
+/*
+ * Class:     java_lang_ProcessHandleImpl
+ * Method:    pidfdWaiterCreate0
+ * Signature: ()I
+ *
+ * Returns an epoll file descriptor to watch pidfds on, or -1 if pidfds are
+ * not supported by the kernel.
+ */
+JNIEXPORT jint JNICALL
+Java_java_lang_ProcessHandleImpl_pidfdWaiterCreate0(JNIEnv *env, jclass clazz) {
+    int epfd;
+    int pidfd = (int)syscall(SYS_pidfd_open, getpid(), 0);
+    if (pidfd < 0) {
+        return -1;
+    }
+    close(pidfd);
+    epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (epfd < 0) {
+        JNU_ThrowIOExceptionWithLastError(env, "epoll_create1 failed");
+    }
+    return epfd;
+}
+
+/*
+ * Class:     java_lang_ProcessHandleImpl
+ * Method:    pidfdWatch0
+ * Signature: (IJZ)Z
+ *
+ * Watch the process for exit. Returns false if the process does not exist,
+ * in which case the caller should fall back to waitForProcessExit0.
+ */
+JNIEXPORT jboolean JNICALL
+Java_java_lang_ProcessHandleImpl_pidfdWatch0(JNIEnv *env, jclass clazz,
+                                             jint epfd, jlong jpid,
+                                             jboolean reapStatus) {
+    struct epoll_event event;
+    pid_t pid = (pid_t)jpid;
+    int pidfd = (int)syscall(SYS_pidfd_open, pid, 0);
+    if (pidfd < 0) {
+        return JNI_FALSE;
+    }
+    fcntl(pidfd, F_SETFD, FD_CLOEXEC);
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u64 = (uint64_t)PIDFD_DATA(pid, pidfd, reapStatus != JNI_FALSE);
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, pidfd, &event) < 0) {
+        close(pidfd);
+        JNU_ThrowIOExceptionWithLastError(env, "epoll_ctl failed");
+        return JNI_FALSE;
+    }
+    return JNI_TRUE;
+}
+
+/*
+ * Return the exit code of an exited process in the same form as
+ * waitForProcessExit0.
+ */
+static jint waitExited(pid_t pid, int reap) {
+    siginfo_t siginfo;
+    int options = WEXITED | WNOHANG | (reap ? 0 : WNOWAIT);
+    memset(&siginfo, 0, sizeof siginfo);
+    while (waitid(P_PID, pid, &siginfo, options) < 0) {
+        switch (errno) {
+            case ECHILD:
+                return java_lang_ProcessHandleImpl_NOT_A_CHILD;
+            case EINTR: break;
+            default: return -1;
+        }
+    }
+    if (siginfo.si_code == CLD_EXITED) {
+        return siginfo.si_status;
+    } else if (siginfo.si_code == CLD_KILLED || siginfo.si_code == CLD_DUMPED) {
+        return WTERMSIG_RETURN(siginfo.si_status);
+    } else {
+        return siginfo.si_status;
+    }
+}
+
+/*
+ * Class:     java_lang_ProcessHandleImpl
+ * Method:    pidfdAwait0
+ * Signature: (I[J[I)I
+ *
+ * Block until at least one watched process exits. Fills in the pids and exit
+ * codes of the exited processes, which are no longer watched, and returns
+ * their number.
+ */
+JNIEXPORT jint JNICALL
+Java_java_lang_ProcessHandleImpl_pidfdAwait0(JNIEnv *env, jclass clazz,
+                                             jint epfd, jlongArray jpids,
+                                             jintArray jexitCodes) {
+    struct epoll_event events[PIDFD_MAX_EVENTS];
+    jlong pids[PIDFD_MAX_EVENTS];
+    jint exitCodes[PIDFD_MAX_EVENTS];
+    jsize max = (*env)->GetArrayLength(env, jpids);
+    int i, n;
+
+    if (max > PIDFD_MAX_EVENTS) {
+        max = PIDFD_MAX_EVENTS;
+    }
+    do {
+        n = epoll_wait(epfd, events, max, -1);
+    } while (n < 0 && errno == EINTR);
+    if (n < 0) {
+        JNU_ThrowIOExceptionWithLastError(env, "epoll_wait failed");
+        return -1;
+    }
+
+    for (i = 0; i < n; i++) {
+        jlong data = (jlong)events[i].data.u64;
+        pid_t pid = PIDFD_DATA_PID(data);
+        /* Closing the pidfd also removes it from the epoll set. */
+        close(PIDFD_DATA_FD(data));
+        pids[i] = pid;
+        exitCodes[i] = waitExited(pid, PIDFD_DATA_REAP(data));
+    }
+    (*env)->SetLongArrayRegion(env, jpids, 0, n, pids);
+    (*env)->SetIntArrayRegion(env, jexitCodes, 0, n, exitCodes);
+    return n;
+}
+
+/*
+ * Class:     java_lang_ProcessHandleImpl
+ * Method:    snapshot0
+ * Signature: ([J[J[J[J[I)I
+ *
+ * Take a snapshot of all processes in a single walk of /proc, reading each
+ * process's stat file once. For each process the pid, parent pid, start time,
+ * total cputime and owner uid are stored at the same index of the arrays, all
+ * of which must have the same length. Returns the number of processes found;
+ * if that is more than the array length, only the first fit were stored and
+ * the caller should retry with larger arrays.
+ */
+JNIEXPORT jint JNICALL
+Java_java_lang_ProcessHandleImpl_snapshot0(JNIEnv *env, jclass clazz,
+                                           jlongArray jpids, jlongArray jppids,
+                                           jlongArray jstimes, jlongArray jtotals,
+                                           jintArray juids) {
+    DIR* dir;
+    struct dirent* ptr;
+    int procfd;
+    jlong* pids = NULL;
+    jlong* ppids = NULL;
+    jlong* stimes = NULL;
+    jlong* totals = NULL;
+    jint* uids = NULL;
+    jsize arraySize;
+    jsize count = 0;
+
+    arraySize = (*env)->GetArrayLength(env, jpids);
+    JNU_CHECK_EXCEPTION_RETURN(env, -1);
+    if ((*env)->GetArrayLength(env, jppids) != arraySize ||
+        (*env)->GetArrayLength(env, jstimes) != arraySize ||
+        (*env)->GetArrayLength(env, jtotals) != arraySize ||
+        (*env)->GetArrayLength(env, juids) != arraySize) {
+        JNU_ThrowIllegalArgumentException(env, "array sizes not equal");
+        return 0;
+    }
+
+    if ((dir = opendir("/proc")) == NULL) {
+        JNU_ThrowByNameWithLastError(env,
+            "java/lang/RuntimeException", "Unable to open /proc");
+        return -1;
+    }
+    procfd = dirfd(dir);
+
+    do { // Block to break out of on Exception
+        if ((pids = (*env)->GetLongArrayElements(env, jpids, NULL)) == NULL ||
+            (ppids = (*env)->GetLongArrayElements(env, jppids, NULL)) == NULL ||
+            (stimes = (*env)->GetLongArrayElements(env, jstimes, NULL)) == NULL ||
+            (totals = (*env)->GetLongArrayElements(env, jtotals, NULL)) == NULL ||
+            (uids = (*env)->GetIntArrayElements(env, juids, NULL)) == NULL) {
+            break;
+        }
+
+        while ((ptr = readdir(dir)) != NULL) {
+            pid_t ppid;
+            jlong totalTime = 0L;
+            jlong startTime = 0L;
+            uid_t uid = 0;
+
+            /* skip files that aren't numbers */
+            pid_t pid = (pid_t) atoi(ptr->d_name);
+            if ((int) pid <= 0) {
+                continue;
+            }
+
+            ppid = readStatAt(procfd, ptr->d_name, &totalTime, &startTime, &uid);
+            if (ppid < 0) {
+                continue;   // process has gone away
+            }
+            if (count < arraySize) {
+                // Only store if it fits
+                pids[count] = (jlong) pid;
+                ppids[count] = (jlong) ppid;
+                stimes[count] = startTime;
+                totals[count] = totalTime;
+                uids[count] = (jint) uid;
+            }
+            count++; // Count to tabulate size needed
+        }
+    } while (0);
+
+    if (pids != NULL) {
+        (*env)->ReleaseLongArrayElements(env, jpids, pids, 0);
+    }
+    if (ppids != NULL) {
+        (*env)->ReleaseLongArrayElements(env, jppids, ppids, 0);
+    }
+    if (stimes != NULL) {
+        (*env)->ReleaseLongArrayElements(env, jstimes, stimes, 0);
+    }
+    if (totals != NULL) {
+        (*env)->ReleaseLongArrayElements(env, jtotals, totals, 0);
+    }
+    if (uids != NULL) {
+        (*env)->ReleaseIntArrayElements(env, juids, uids, 0);
+    }
+
+    closedir(dir);
+    return count;
+}
@@ -24,9 +24,12 @@
  */
 
  #include <dlfcn.h>
+ #include <stdint.h>
+ #include <string.h>
  #include <unistd.h>
  #include <sys/types.h>
  #include <sys/epoll.h>
+ #include <sys/ioctl.h>
 
 #include "jni.h"
 #include "jni_util.h"
@@ -37,6 +40,17 @@
 
 #include "sun_nio_ch_EPoll.h"
 
+// epoll busy poll parameters, since Linux 6.9
+#ifndef EPIOCSPARAMS
+struct epoll_params {
+    uint32_t busy_poll_usecs;
+    uint16_t busy_poll_budget;
+    uint8_t prefer_busy_poll;
+    uint8_t __pad;
+};
+#define EPIOCSPARAMS _IOW(0x8A, 0x01, struct epoll_params)
+#endif
+
 JNIEXPORT jint JNICALL
 Java_sun_nio_ch_EPoll_eventSize(JNIEnv* env, jclass clazz)
 {
@@ -94,3 +108,24 @@ Java_sun_nio_ch_EPoll_wait(JNIEnv *env, jclass clazz, jint epfd,
     }
     return res;
 }
+
+/*
+ * Makes epoll_wait busy poll the NAPI contexts of the registered sockets
+ * for up to usecs microseconds before sleeping. Returns 0 or the errno
+ * value, ENOTTY if the kernel does not support it.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_EPoll_setBusyPoll(JNIEnv *env, jclass clazz, jint epfd,
+                                  jint usecs, jint budget, jboolean prefer)
+{
+    struct epoll_params params;
+    int res;
+
+    memset(&params, 0, sizeof(params));
+    params.busy_poll_usecs = (uint32_t)usecs;
+    params.busy_poll_budget = (uint16_t)budget;
+    params.prefer_busy_poll = (prefer == JNI_TRUE) ? 1 : 0;
+
+    res = ioctl(epfd, EPIOCSPARAMS, &params);
+    return (res == 0) ? 0 : errno;
+}
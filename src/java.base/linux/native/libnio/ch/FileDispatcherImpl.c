@@ -25,12 +25,17 @@
 
 #include <sys/sendfile.h>
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <poll.h>
 
 #include "jni.h"
 #include "nio.h"
 #include "nio_util.h"
 #include "sun_nio_ch_FileDispatcherImpl.h"
 
+// Default capacity of a pipe
+#define SPLICE_CHUNK_SIZE (64 * 1024)
+
 typedef ssize_t copy_file_range_func(int, loff_t*, int, loff_t*, size_t,
                                      unsigned int);
 static copy_file_range_func* my_copy_file_range_func = NULL;
@@ -128,3 +133,78 @@ Java_sun_nio_ch_FileDispatcherImpl_transferTo0(JNIEnv *env, jobject this,
     }
     return n;
 }
+
+/*
+ * Transfers up to count bytes from srcFDO to dstFDO through the pipe
+ * pipeIn/pipeOut with splice, without copying through user space. This
+ * works for any combination of sockets and files. The position of a
+ * file side is given by srcPosition/dstPosition; -1 means that side is
+ * not positioned, e.g. a socket. The pipe must be empty and is empty
+ * again on return. Blocks for the first bytes only, like a read.
+ */
+JNIEXPORT jlong JNICALL
+Java_sun_nio_ch_FileDispatcherImpl_splice0(JNIEnv *env, jobject this,
+                                           jobject srcFDO, jlong srcPosition,
+                                           jobject dstFDO, jlong dstPosition,
+                                           jlong count, jint pipeIn, jint pipeOut)
+{
+    jint srcFD = fdval(env, srcFDO);
+    jint dstFD = fdval(env, dstFDO);
+    loff_t srcOffset = (loff_t)srcPosition;
+    loff_t dstOffset = (loff_t)dstPosition;
+    loff_t* srcOffsetPtr = (srcPosition < 0) ? NULL : &srcOffset;
+    loff_t* dstOffsetPtr = (dstPosition < 0) ? NULL : &dstOffset;
+    jlong total = 0;
+
+    while (total < count) {
+        size_t len = (size_t)(count - total);
+        // only wait for the source while nothing has been transferred
+        unsigned int flags = SPLICE_F_MOVE | ((total > 0) ? SPLICE_F_NONBLOCK : 0);
+        ssize_t n;
+        if (len > SPLICE_CHUNK_SIZE)
+            len = SPLICE_CHUNK_SIZE;
+        n = splice(srcFD, srcOffsetPtr, pipeOut, NULL, len, flags);
+        if (n == 0) {
+            if (total == 0)
+                return IOS_EOF;
+            break;
+        }
+        if (n < 0) {
+            if (total > 0 && (errno == EAGAIN || errno == EINTR))
+                break;
+            if (errno == EAGAIN)
+                return IOS_UNAVAILABLE;
+            if (errno == EINTR)
+                return IOS_INTERRUPTED;
+            if (errno == EINVAL || errno == ENOSYS) {
+                if (total > 0)
+                    break;
+                return IOS_UNSUPPORTED_CASE;
+            }
+            JNU_ThrowIOExceptionWithLastError(env, "Transfer failed");
+            return IOS_THROWN;
+        }
+
+        // Drain the pipe completely, the bytes are gone from the source
+        while (n > 0) {
+            ssize_t m = splice(pipeIn, NULL, dstFD, dstOffsetPtr, (size_t)n, SPLICE_F_MOVE);
+            if (m < 0) {
+                if (errno == EINTR)
+                    continue;
+                if (errno == EAGAIN) {
+                    struct pollfd pfd;
+                    pfd.fd = dstFD;
+                    pfd.events = POLLOUT;
+                    pfd.revents = 0;
+                    poll(&pfd, 1, -1);
+                    continue;
+                }
+                JNU_ThrowIOExceptionWithLastError(env, "Transfer failed");
+                return IOS_THROWN;
+            }
+            n -= m;
+            total += m;
+        }
+    }
+    return total;
+}
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Thin layer over the io_uring system calls for positional file reads and
+ * writes. A ring is used by a single submitting thread at a time, which
+ * queues requests with submitRead/submitWrite and hands them to the kernel
+ * with submit. A poller thread waits for completions with await and reaps
+ * them with reap, so the submitting (virtual) thread does not block in the
+ * kernel for the duration of the I/O.
+ *
+ * The ring file descriptor polls readable while completions are pending,
+ * so instead of a dedicated thread blocking in await, the ring can be
+ * registered with the EPoll based poller that parks and unparks virtual
+ * threads for sockets.
+ *
+ * liburing is not used; the rings are mapped directly as described in
+ * io_uring(7).
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+
+#include "jni.h"
+#include "jni_util.h"
+#include "jvm.h"
+#include "jlong.h"
+#include "nio.h"
+#include "nio_util.h"
+
+#include "sun_nio_ch_IOUring.h"
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup     425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter     426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register  427
+#endif
+
+typedef struct {
+    int fd;
+
+    // submission queue
+    void* sq_ring;
+    size_t sq_ring_size;
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned* sq_mask;
+    unsigned* sq_array;
+    unsigned sq_entries;
+    struct io_uring_sqe* sqes;
+    size_t sqes_size;
+    // number of queued requests not yet handed to the kernel
+    unsigned sq_unsubmitted;
+
+    // completion queue
+    void* cq_ring;
+    size_t cq_ring_size;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned* cq_mask;
+    struct io_uring_cqe* cqes;
+} ring_t;
+
+static void unmap_ring(ring_t* ring)
+{
+    if (ring->sqes != NULL)
+        munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ring != NULL)
+        munmap(ring->cq_ring, ring->cq_ring_size);
+    if (ring->sq_ring != NULL)
+        munmap(ring->sq_ring, ring->sq_ring_size);
+    close(ring->fd);
+    free(ring);
+}
+
+static void* map_ring(int fd, size_t size, off_t offset)
+{
+    void* addr = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd, offset);
+    return (addr == MAP_FAILED) ? NULL : addr;
+}
+
+/*
+ * Creates a ring with the given number of submission queue entries.
+ * Returns 0 if io_uring is not available, in which case the caller
+ * should use the blocking dispatcher.
+ */
+JNIEXPORT jlong JNICALL
+Java_sun_nio_ch_IOUring_create(JNIEnv* env, jclass clazz, jint entries)
+{
+    struct io_uring_params params;
+    ring_t* ring;
+    char* sq;
+    char* cq;
+    int fd;
+
+    memset(&params, 0, sizeof(params));
+    fd = (int)syscall(__NR_io_uring_setup, (unsigned)entries, &params);
+    if (fd < 0) {
+        // ENOSYS: kernel without io_uring, EPERM: disabled by
+        // kernel.io_uring_disabled or a seccomp filter
+        if (errno == ENOSYS || errno == EPERM)
+            return 0;
+        JNU_ThrowIOExceptionWithLastError(env, "io_uring_setup failed");
+        return 0;
+    }
+
+    ring = (ring_t*)calloc(1, sizeof(ring_t));
+    if (ring == NULL) {
+        close(fd);
+        JNU_ThrowOutOfMemoryError(env, NULL);
+        return 0;
+    }
+    ring->fd = fd;
+
+    ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    ring->sq_ring = map_ring(fd, ring->sq_ring_size, IORING_OFF_SQ_RING);
+    if (ring->sq_ring != NULL)
+        ring->cq_ring = map_ring(fd, ring->cq_ring_size, IORING_OFF_CQ_RING);
+    if (ring->cq_ring != NULL)
+        ring->sqes = map_ring(fd, ring->sqes_size, IORING_OFF_SQES);
+    if (ring->sqes == NULL) {
+        JNU_ThrowIOExceptionWithLastError(env, "Mapping io_uring failed");
+        unmap_ring(ring);
+        return 0;
+    }
+
+    sq = (char*)ring->sq_ring;
+    ring->sq_head = (unsigned*)(sq + params.sq_off.head);
+    ring->sq_tail = (unsigned*)(sq + params.sq_off.tail);
+    ring->sq_mask = (unsigned*)(sq + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned*)(sq + params.sq_off.array);
+    ring->sq_entries = params.sq_entries;
+
+    cq = (char*)ring->cq_ring;
+    ring->cq_head = (unsigned*)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned*)(cq + params.cq_off.tail);
+    ring->cq_mask = (unsigned*)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+
+    return ptr_to_jlong(ring);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_fd(JNIEnv* env, jclass clazz, jlong address)
+{
+    return ((ring_t*)jlong_to_ptr(address))->fd;
+}
+
+JNIEXPORT void JNICALL
+Java_sun_nio_ch_IOUring_close(JNIEnv* env, jclass clazz, jlong address)
+{
+    unmap_ring((ring_t*)jlong_to_ptr(address));
+}
+
+/*
+ * Registers the given memory as fixed buffer 0, to be used by requests
+ * with fixed set. Returns 0 or the errno value.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_registerBuffer(JNIEnv* env, jclass clazz, jlong address,
+                                       jlong bufAddress, jlong length)
+{
+    ring_t* ring = (ring_t*)jlong_to_ptr(address);
+    struct iovec iov;
+    int res;
+
+    iov.iov_base = jlong_to_ptr(bufAddress);
+    iov.iov_len = (size_t)length;
+    res = (int)syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_BUFFERS, &iov, 1);
+    return (res == 0) ? 0 : errno;
+}
+
+static jint queue_request(ring_t* ring, int opcode, jint fd, jlong bufAddress,
+                          jint len, jlong position, jlong userData)
+{
+    unsigned tail = *ring->sq_tail;
+    unsigned head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    unsigned index;
+    struct io_uring_sqe* sqe;
+
+    if (tail - head >= ring->sq_entries)
+        return IOS_UNAVAILABLE;
+
+    index = tail & *ring->sq_mask;
+    sqe = &ring->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = (unsigned char)opcode;
+    sqe->fd = fd;
+    sqe->addr = (unsigned long long)(uintptr_t)jlong_to_ptr(bufAddress);
+    sqe->len = (unsigned)len;
+    sqe->off = (unsigned long long)position;
+    sqe->user_data = (unsigned long long)userData;
+    ring->sq_array[index] = index;
+
+    // publish the entry to the kernel
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ring->sq_unsubmitted++;
+    return 0;
+}
+
+/*
+ * Queues a read of len bytes at the given file position, or at the
+ * current file position if position is -1 (as for streams). Returns 0,
+ * or IOS_UNAVAILABLE if the submission queue is full.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_submitRead(JNIEnv* env, jclass clazz, jlong address,
+                                   jint fd, jlong bufAddress, jint len,
+                                   jlong position, jlong userData, jboolean fixed)
+{
+    return queue_request((ring_t*)jlong_to_ptr(address),
+                         (fixed == JNI_TRUE) ? IORING_OP_READ_FIXED : IORING_OP_READ,
+                         fd, bufAddress, len, position, userData);
+}
+
+/*
+ * Queues a write of len bytes at the given file position, or at the
+ * current file position if position is -1 (as for streams). Returns 0,
+ * or IOS_UNAVAILABLE if the submission queue is full.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_submitWrite(JNIEnv* env, jclass clazz, jlong address,
+                                    jint fd, jlong bufAddress, jint len,
+                                    jlong position, jlong userData, jboolean fixed)
+{
+    return queue_request((ring_t*)jlong_to_ptr(address),
+                         (fixed == JNI_TRUE) ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE,
+                         fd, bufAddress, len, position, userData);
+}
+
+/*
+ * Hands all queued requests to the kernel with a single system call.
+ * Returns the number of requests submitted.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_submit(JNIEnv* env, jclass clazz, jlong address)
+{
+    ring_t* ring = (ring_t*)jlong_to_ptr(address);
+    int res;
+
+    if (ring->sq_unsubmitted == 0)
+        return 0;
+    res = (int)syscall(__NR_io_uring_enter, ring->fd, ring->sq_unsubmitted, 0, 0, NULL, 0);
+    if (res < 0) {
+        if (errno == EINTR)
+            return IOS_INTERRUPTED;
+        if (errno == EAGAIN || errno == EBUSY)
+            return IOS_UNAVAILABLE;
+        JNU_ThrowIOExceptionWithLastError(env, "io_uring_enter failed");
+        return IOS_THROWN;
+    }
+    ring->sq_unsubmitted -= (unsigned)res;
+    return res;
+}
+
+/*
+ * Waits until at least minComplete completions are available.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_await(JNIEnv* env, jclass clazz, jlong address, jint minComplete)
+{
+    ring_t* ring = (ring_t*)jlong_to_ptr(address);
+    int res = (int)syscall(__NR_io_uring_enter, ring->fd, 0, (unsigned)minComplete,
+                           IORING_ENTER_GETEVENTS, NULL, 0);
+    if (res < 0) {
+        if (errno == EINTR)
+            return IOS_INTERRUPTED;
+        JNU_ThrowIOExceptionWithLastError(env, "io_uring_enter failed");
+        return IOS_THROWN;
+    }
+    return 0;
+}
+
+/*
+ * Copies up to max completions to the array of (user data, result) jlong
+ * pairs at the given address. The result is the number of bytes transferred
+ * or a negated errno value. Returns the number of completions copied.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_reap(JNIEnv* env, jclass clazz, jlong address,
+                             jlong resultsAddress, jint max)
+{
+    ring_t* ring = (ring_t*)jlong_to_ptr(address);
+    jlong* results = (jlong*)jlong_to_ptr(resultsAddress);
+    unsigned head = *ring->cq_head;
+    unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+    jint n = 0;
+
+    while (head != tail && n < max) {
+        struct io_uring_cqe* cqe = &ring->cqes[head & *ring->cq_mask];
+        results[2 * n] = (jlong)cqe->user_data;
+        results[2 * n + 1] = (jlong)cqe->res;
+        n++;
+        head++;
+    }
+
+    // release the entries to the kernel
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    return n;
+}
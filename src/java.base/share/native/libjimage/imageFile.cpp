@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2026, Oracle and/or its affiliates. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions
@@ -249,6 +249,110 @@ bool ImageFileReaderTable::contains(ImageFileReader* image) {
     return false;
 }
 
+SimpleCriticalSection _resource_cache_lock;
+
+ImageResourceCache::ImageResourceCache() :
+    _lru_head(NULL), _lru_tail(NULL), _bytes(0) {
+    memset(_table, 0, sizeof(_table));
+    memset(_seen, 0, sizeof(_seen));
+}
+
+ImageResourceCache::~ImageResourceCache() {
+    while (_lru_head != NULL) {
+        evict(_lru_head);
+    }
+}
+
+// Remove an entry from the LRU list.
+void ImageResourceCache::unlink(Entry* entry) {
+    if (entry->_lru_prev != NULL) {
+        entry->_lru_prev->_lru_next = entry->_lru_next;
+    } else {
+        _lru_head = entry->_lru_next;
+    }
+    if (entry->_lru_next != NULL) {
+        entry->_lru_next->_lru_prev = entry->_lru_prev;
+    } else {
+        _lru_tail = entry->_lru_prev;
+    }
+}
+
+// Make an entry the most recently used.
+void ImageResourceCache::push_front(Entry* entry) {
+    entry->_lru_prev = NULL;
+    entry->_lru_next = _lru_head;
+    if (_lru_head != NULL) {
+        _lru_head->_lru_prev = entry;
+    } else {
+        _lru_tail = entry;
+    }
+    _lru_head = entry;
+}
+
+// Remove an entry from the cache and free it.
+void ImageResourceCache::evict(Entry* entry) {
+    for (Entry** link = bucket(entry->_key); *link != NULL; link = &(*link)->_hash_next) {
+        if (*link == entry) {
+            *link = entry->_hash_next;
+            break;
+        }
+    }
+    unlink(entry);
+    _bytes -= entry->_size;
+    delete[] (u1*)entry;
+}
+
+// Copy the resource at key into data if cached.  Returns true if found.
+bool ImageResourceCache::get(u8 key, u1* data, u8 size) {
+    SimpleCriticalSectionLock cs(&_resource_cache_lock);
+    for (Entry* entry = *bucket(key); entry != NULL; entry = entry->_hash_next) {
+        if (entry->_key == key && entry->_size == size) {
+            unlink(entry);
+            push_front(entry);
+            memcpy(data, entry->data(), (size_t)size);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Record a decompressed resource, caching it if recently seen.
+void ImageResourceCache::put(u8 key, const u1* data, u8 size) {
+    if (size > MAX_ENTRY_BYTES) {
+        return;
+    }
+    SimpleCriticalSectionLock cs(&_resource_cache_lock);
+    // Only admit resources decompressed before.
+    u8* seen = &_seen[(key >> 3) % SEEN_SIZE];
+    if (*seen != key + 1) {
+        *seen = key + 1;
+        return;
+    }
+    // Another thread may have cached it meanwhile.
+    for (Entry* entry = *bucket(key); entry != NULL; entry = entry->_hash_next) {
+        if (entry->_key == key) {
+            return;
+        }
+    }
+    u1* bytes = new u1[sizeof(Entry) + (size_t)size];
+    if (bytes == NULL) {
+        return;
+    }
+    Entry* entry = (Entry*)bytes;
+    entry->_key = key;
+    entry->_size = size;
+    memcpy(entry->data(), data, (size_t)size);
+    Entry** head = bucket(key);
+    entry->_hash_next = *head;
+    *head = entry;
+    push_front(entry);
+    _bytes += size;
+    // Evict least recently used entries beyond capacity.
+    while (_bytes > MAX_BYTES) {
+        evict(_lru_tail);
+    }
+}
+
 // Table to manage multiple opens of an image file.
 ImageFileReaderTable ImageFileReader::_reader_table;
 
@@ -341,7 +445,7 @@ ImageFileReader* ImageFileReader::id_to_reader(u8 id) {
 
 // Constructor initializes to a closed state.
 ImageFileReader::ImageFileReader(const char* name, bool big_endian) :
-    _module_data(NULL) {
+    _module_data(NULL), _resource_cache(NULL) {
     // Copy the image file name.
      int len = (int) strlen(name) + 1;
     _name = new char[len];
@@ -417,8 +521,10 @@ bool ImageFileReader::open() {
 
     // Initialize the module data
     _module_data = new ImageModuleData(this);
+    // Initialize the decompressed resource cache
+    _resource_cache = new ImageResourceCache();
     // Successful open (if memory allocation succeeded).
-    return _module_data != NULL;
+    return _module_data != NULL && _resource_cache != NULL;
 }
 
 // Close image file.
@@ -438,6 +544,11 @@ void ImageFileReader::close() {
         delete _module_data;
         _module_data = NULL;
     }
+
+    if (_resource_cache != NULL) {
+        delete _resource_cache;
+        _resource_cache = NULL;
+    }
 }
 
 // Read directly from the file.
@@ -540,6 +651,10 @@ void ImageFileReader::get_resource(ImageLocation& location, u1* uncompressed_dat
     u8 compressed_size = location.get_attribute(ImageLocation::ATTRIBUTE_COMPRESSED);
     // If the resource is compressed.
     if (compressed_size != 0) {
+        // Reuse a recent decompression of the resource.
+        if (_resource_cache->get(offset, uncompressed_data, uncompressed_size)) {
+            return;
+        }
         u1* compressed_data;
         // If not memory mapped read in bytes.
         if (!memory_map_image) {
@@ -561,6 +676,10 @@ void ImageFileReader::get_resource(ImageLocation& location, u1* uncompressed_dat
         if (!memory_map_image) {
                 delete[] compressed_data;
         }
+        _resource_cache->put(offset, uncompressed_data, uncompressed_size);
+    } else if (memory_map_image) {
+        // Copy bytes straight out of the mapped image.
+        memcpy(uncompressed_data, get_data_address() + offset, (size_t)uncompressed_size);
     } else {
         // Read bytes from offset beyond the image index.
         bool is_read = read_at(uncompressed_data, uncompressed_size, _index_size + offset);
@@ -568,6 +687,19 @@ void ImageFileReader::get_resource(ImageLocation& location, u1* uncompressed_dat
     }
 }
 
+// Return the address of the resource for the supplied location offset if it is
+// stored uncompressed in the memory mapped image, NULL otherwise.
+u1* ImageFileReader::get_resource_address(u4 offset) const {
+    if (!memory_map_image) {
+        return NULL;
+    }
+    ImageLocation location(get_location_offset_data(offset));
+    if (location.get_attribute(ImageLocation::ATTRIBUTE_COMPRESSED) != 0) {
+        return NULL;
+    }
+    return get_data_address() + location.get_attribute(ImageLocation::ATTRIBUTE_OFFSET);
+}
+
 // Return the ImageModuleData for this image
 ImageModuleData * ImageFileReader::get_image_module_data() {
     return _module_data;
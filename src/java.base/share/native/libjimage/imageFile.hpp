@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2026, Oracle and/or its affiliates. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions
@@ -394,6 +394,59 @@ class ImageFileReaderTable {
     bool contains(ImageFileReader* image);
 };
 
+// Cache of decompressed resources.
+// ImageResourceCache keeps copies of recently decompressed resources so that a
+// resource requested more than once is copied rather than decompressed again.
+// Entries are keyed by the resource's byte offset in the image.  Since most
+// resources are only read once, a resource is admitted on its second
+// decompression; the first is only noted in a small direct mapped table of
+// recently seen offsets.  Entries are evicted least recently used first when
+// the cache exceeds MAX_BYTES.
+class ImageResourceCache {
+private:
+    struct Entry {
+        u8 _key;            // Byte offset of the resource
+        u8 _size;           // Uncompressed size
+        Entry* _hash_next;  // Next entry in the hash bucket
+        Entry* _lru_prev;   // More recently used entry
+        Entry* _lru_next;   // Less recently used entry
+
+        // Decompressed bytes follow the entry.
+        inline u1* data() { return (u1*)(this + 1); }
+    };
+
+    enum {
+        TABLE_SIZE = 512,                 // Number of hash buckets
+        SEEN_SIZE = 4096,                 // Number of recently seen offsets
+        MAX_BYTES = 8 * 1024 * 1024,      // Cache capacity
+        MAX_ENTRY_BYTES = 256 * 1024      // Largest resource cached
+    };
+
+    Entry* _table[TABLE_SIZE];
+    u8 _seen[SEEN_SIZE];  // Offset + 1 of recently decompressed resources
+    Entry* _lru_head;     // Most recently used
+    Entry* _lru_tail;     // Least recently used
+    u8 _bytes;            // Total bytes of cached resources
+
+    Entry** bucket(u8 key) {
+        return &_table[(key >> 3) % TABLE_SIZE];
+    }
+
+    void unlink(Entry* entry);
+    void push_front(Entry* entry);
+    void evict(Entry* entry);
+
+public:
+    ImageResourceCache();
+    ~ImageResourceCache();
+
+    // Copy the resource at key into data if cached.  Returns true if found.
+    bool get(u8 key, u1* data, u8 size);
+
+    // Record a decompressed resource, caching it if recently seen.
+    void put(u8 key, const u1* data, u8 size);
+};
+
 // Manage the image file.
 // ImageFileReader manages the content of an image file.
 // Initially, the header of the image file is read for validation.  If valid,
@@ -429,6 +482,7 @@ friend class ImageFileReaderTable;
     u1* _location_bytes; // Location attributes
     u1* _string_bytes;   // String table
     ImageModuleData *_module_data;       // The ImageModuleData for this image
+    ImageResourceCache* _resource_cache; // Recently decompressed resources
 
     ImageFileReader(const char* name, bool big_endian);
     ~ImageFileReader();
@@ -578,6 +632,10 @@ friend class ImageFileReaderTable;
     // Return the resource for the supplied path.
     void get_resource(ImageLocation& location, u1* uncompressed_data) const;
 
+    // Return the address of the resource for the supplied location offset if
+    // it is stored uncompressed in the memory mapped image, NULL otherwise.
+    u1* get_resource_address(u4 offset) const;
+
     // Return the ImageModuleData for this image
     ImageModuleData * get_image_module_data();
 
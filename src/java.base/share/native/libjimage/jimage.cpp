@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2026, Oracle and/or its affiliates. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions
@@ -162,6 +162,23 @@ JIMAGE_GetResource(JImageFile* image, JImageLocationRef location,
     return size;
 }
 
+/*
+ * JImageGetResourceAddress - Given an open image file (see JImageOpen) and a
+ * resource's location information (see JImageFindResource), return the address
+ * of the resource's bytes if the resource is stored uncompressed in the memory
+ * mapped image, or NULL otherwise.
+ *
+ * Ex.
+ *  jlong size;
+ *   JImageLocationRef location = (*JImageFindResource)(image,
+ *                                 "java.base", "9.0", "java/lang/String.class", &size);
+ *  const char* bytes = (*JImageGetResourceAddress)(image, location);
+ */
+extern "C" JNIEXPORT const char*
+JIMAGE_GetResourceAddress(JImageFile* image, JImageLocationRef location) {
+    return (const char*) ((ImageFileReader*) image)->get_resource_address((u4) location);
+}
+
 /*
  * JImageResourceIterator - Given an open image file (see JImageOpen), a visitor
  * function and a visitor argument, iterator through each of the image's resources.
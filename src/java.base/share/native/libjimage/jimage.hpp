@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2026, Oracle and/or its affiliates. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions
@@ -157,6 +157,24 @@ JIMAGE_GetResource(JImageFile* jimage, JImageLocationRef location,
 typedef jlong(*JImageGetResource_t)(JImageFile* jimage, JImageLocationRef location,
         char* buffer, jlong size);
 
+/*
+ * JImageGetResourceAddress - Given an open image file (see JImageOpen) and a
+ * resource's location information (see JImageFindResource), return the address
+ * of the resource's bytes if the resource is stored uncompressed in the memory
+ * mapped image, or NULL otherwise, in which case JImageGetResource must be used.
+ * The bytes remain valid until the image file is closed and must not be modified.
+ *
+ * Ex.
+ *  jlong size;
+ *  JImageLocationRef location = (*JImageFindResource)(image,
+ *                               "java.base", "9.0", "java/lang/String.class", &size);
+ *  const char* bytes = (*JImageGetResourceAddress)(image, location);
+ */
+extern "C" JNIEXPORT const char*
+JIMAGE_GetResourceAddress(JImageFile* jimage, JImageLocationRef location);
+
+typedef const char*(*JImageGetResourceAddress_t)(JImageFile* jimage, JImageLocationRef location);
+
 
 /*
  * JImageResourceIterator - Given an open image file (see JImageOpen), a visitor
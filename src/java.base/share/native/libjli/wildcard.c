@@ -83,6 +83,12 @@
  * supporting the use of wildcards on the command line and in the
  * CLASSPATH environment variable.  We do not support the use of
  * wildcards by applications that embed the JVM.
+ *
+ * On Unix, if the JDK_JAVA_LAUNCHER_CACHE environment variable names a
+ * file, the launcher saves the jar files found for each wildcard
+ * directory in that file, together with the directory's modification
+ * time, and later launches reuse them instead of scanning the directory
+ * again for as long as the directory is unchanged.
  */
 
 #include <stddef.h>
@@ -98,6 +104,8 @@
 #else /* Unix */
 #include <unistd.h>
 #include <dirent.h>
+#include <sys/stat.h>
+#include <time.h>
 #endif /* Unix */
 
 static int
@@ -173,19 +181,26 @@ struct WildcardIterator_
     DIR *dir;
 };
 
-static WildcardIterator
-WildcardIterator_for(const char *wildcard)
+/* Return the directory of a wildcard, to be freed by the caller. */
+static char *
+wildcardDirName(const char *wildcard)
 {
-    DIR *dir;
     int wildlen = JLI_StrLen(wildcard);
+    char *dirname;
     if (wildlen < 2) {
-        dir = opendir(".");
-    } else {
-        char *dirname = JLI_StringDup(wildcard);
-        dirname[wildlen - 1] = '\0';
-        dir = opendir(dirname);
-        JLI_MemFree(dirname);
+        return JLI_StringDup(".");
     }
+    dirname = JLI_StringDup(wildcard);
+    dirname[wildlen - 1] = '\0';
+    return dirname;
+}
+
+static WildcardIterator
+WildcardIterator_for(const char *wildcard)
+{
+    char *dirname = wildcardDirName(wildcard);
+    DIR *dir = opendir(dirname);
+    JLI_MemFree(dirname);
     if (dir == NULL)
         return NULL;
     else {
@@ -242,13 +257,251 @@ wildcardConcat(const char *wildcard, const char *basename)
     return filename;
 }
 
+#ifndef _WIN32
+/*
+ * Persistent cache of wildcard expansions, see JDK_JAVA_LAUNCHER_CACHE.
+ * The cache file holds one record per wildcard:
+ *   <mtime seconds> <mtime nanoseconds> <wildcard>
+ *   <number of files>
+ *   <file>...
+ * each on its own line.
+ */
+#define LAUNCHER_CACHE_ENV_ENTRY "JDK_JAVA_LAUNCHER_CACHE"
+
+#ifdef __APPLE__
+#define MTIME_NSEC(st) ((st)->st_mtimespec.tv_nsec)
+#else
+#define MTIME_NSEC(st) ((st)->st_mtim.tv_nsec)
+#endif
+
+typedef struct CacheEntry_ *CacheEntry;
+struct CacheEntry_
+{
+    char *wildcard;
+    long long mtimeSec;
+    long mtimeNsec;
+    JLI_List files;
+    CacheEntry next;
+};
+
+static CacheEntry cacheEntries = NULL;
+static int cacheLoaded = 0;
+static int cacheDirty = 0;
+
+static JLI_List
+copyFileList(JLI_List fl)
+{
+    size_t i;
+    JLI_List copy = JLI_List_new(fl->size + 1);
+    for (i = 0; i < fl->size; i++)
+        JLI_List_add(copy, JLI_StringDup(fl->elements[i]));
+    return copy;
+}
+
+static char *
+readCacheLine(FILE *fp, char **line, size_t *cap)
+{
+    ssize_t len = getline(line, cap, fp);
+    if (len <= 0 || (*line)[len - 1] != '\n')
+        return NULL;
+    (*line)[len - 1] = '\0';
+    return *line;
+}
+
+/* Load the cache file once; a malformed record ends the load. */
+static void
+loadCache(const char *cacheFile)
+{
+    FILE *fp;
+    char *line = NULL;
+    size_t cap = 0;
+
+    cacheLoaded = 1;
+    if ((fp = fopen(cacheFile, "r")) == NULL)
+        return;
+    while (readCacheLine(fp, &line, &cap) != NULL) {
+        long long sec;
+        long nsec;
+        int offset = 0;
+        int count, i;
+        CacheEntry entry;
+        if (sscanf(line, "%lld %ld %n", &sec, &nsec, &offset) != 2 || offset == 0)
+            break;
+        entry = NEW_(CacheEntry);
+        entry->wildcard = JLI_StringDup(line + offset);
+        entry->mtimeSec = sec;
+        entry->mtimeNsec = nsec;
+        entry->files = JLI_List_new(16);
+        entry->next = cacheEntries;
+        cacheEntries = entry;
+        if (readCacheLine(fp, &line, &cap) == NULL || (count = atoi(line)) < 0)
+            break;
+        for (i = 0; i < count && readCacheLine(fp, &line, &cap) != NULL; i++)
+            JLI_List_add(entry->files, JLI_StringDup(line));
+        if (i < count) {
+            /* Truncated, never match it. */
+            entry->mtimeSec = -1;
+            break;
+        }
+    }
+    free(line);
+    fclose(fp);
+}
+
+/*
+ * Relative wildcards are recorded as <cwd><PATH_SEPARATOR><wildcard>, with
+ * the working directory they were expanded in; the expanded files stay
+ * relative. A wildcard never contains PATH_SEPARATOR, so the key of a
+ * relative wildcard cannot equal that of an absolute one.
+ */
+static CacheEntry
+findCacheEntry(const char *wildcard)
+{
+    CacheEntry entry;
+    char cwd[PATH_MAX + 1];
+    size_t cwdlen = 0;
+    if (wildcard[0] != FILE_SEPARATOR) {
+        if (getcwd(cwd, sizeof(cwd)) == NULL)
+            return NULL;
+        cwdlen = JLI_StrLen(cwd);
+    }
+    for (entry = cacheEntries; entry != NULL; entry = entry->next) {
+        const char *key = entry->wildcard;
+        if (cwdlen != 0) {
+            if (JLI_StrNCmp(key, cwd, cwdlen) != 0 || key[cwdlen] != PATH_SEPARATOR)
+                continue;
+            key += cwdlen + 1;
+        }
+        if (equal(key, wildcard))
+            return entry;
+    }
+    return NULL;
+}
+
+static char *
+cacheKey(const char *wildcard)
+{
+    char cwd[PATH_MAX + 1];
+    size_t len;
+    char *key;
+    if (wildcard[0] == FILE_SEPARATOR)
+        return JLI_StringDup(wildcard);
+    if (getcwd(cwd, sizeof(cwd)) == NULL)
+        return NULL;
+    len = JLI_StrLen(cwd) + JLI_StrLen(wildcard) + 2;
+    key = (char *) JLI_MemAlloc(len);
+    JLI_Snprintf(key, len, "%s%c%s", cwd, PATH_SEPARATOR, wildcard);
+    return key;
+}
+
+/*
+ * Return the cached files for a wildcard if its directory is unchanged,
+ * NULL otherwise. *st receives the directory's status, with st_mtime set
+ * to -1 if it cannot be cached.
+ */
+static JLI_List
+cachedFileList(const char *cacheFile, const char *wildcard, struct stat *st)
+{
+    char *dirname = wildcardDirName(wildcard);
+    CacheEntry entry;
+    int found = stat(dirname, st) == 0;
+    JLI_MemFree(dirname);
+    if (!found) {
+        st->st_mtime = -1;
+        return NULL;
+    }
+    /* A directory modified within the timestamp granularity may still be
+     * changing unnoticed, so do not trust or record it. */
+    if (st->st_mtime >= time(NULL) - 1) {
+        st->st_mtime = -1;
+        return NULL;
+    }
+    if (!cacheLoaded)
+        loadCache(cacheFile);
+    entry = findCacheEntry(wildcard);
+    if (entry != NULL &&
+        entry->mtimeSec == (long long)st->st_mtime &&
+        entry->mtimeNsec == (long)MTIME_NSEC(st))
+        return copyFileList(entry->files);
+    return NULL;
+}
+
+static void
+cacheFileList(const char *wildcard, const struct stat *st, JLI_List fl)
+{
+    size_t i;
+    CacheEntry entry;
+    if (st->st_mtime == -1 || JLI_StrChr(wildcard, '\n') != NULL)
+        return;
+    for (i = 0; i < fl->size; i++)
+        if (JLI_StrChr(fl->elements[i], '\n') != NULL)
+            return;
+    if ((entry = findCacheEntry(wildcard)) == NULL) {
+        char *key = cacheKey(wildcard);
+        if (key == NULL)
+            return;
+        entry = NEW_(CacheEntry);
+        entry->wildcard = key;
+        entry->next = cacheEntries;
+        cacheEntries = entry;
+    } else {
+        JLI_List_free(entry->files);
+    }
+    entry->mtimeSec = (long long)st->st_mtime;
+    entry->mtimeNsec = (long)MTIME_NSEC(st);
+    entry->files = copyFileList(fl);
+    cacheDirty = 1;
+}
+
+/* Write the cache to a temporary file and rename it into place. */
+static void
+saveCache(const char *cacheFile)
+{
+    FILE *fp;
+    CacheEntry entry;
+    size_t i;
+    int ok = 1;
+    size_t len = JLI_StrLen(cacheFile) + 32;
+    char *tmpFile = (char *) JLI_MemAlloc(len);
+
+    cacheDirty = 0;
+    JLI_Snprintf(tmpFile, len, "%s.%d.tmp", cacheFile, (int)getpid());
+    if ((fp = fopen(tmpFile, "w")) == NULL) {
+        JLI_MemFree(tmpFile);
+        return;
+    }
+    for (entry = cacheEntries; entry != NULL; entry = entry->next) {
+        if (entry->mtimeSec < 0)
+            continue;
+        ok &= fprintf(fp, "%lld %ld %s\n%d\n", entry->mtimeSec, entry->mtimeNsec,
+                      entry->wildcard, (int)entry->files->size) > 0;
+        for (i = 0; i < entry->files->size; i++)
+            ok &= fprintf(fp, "%s\n", entry->files->elements[i]) > 0;
+    }
+    ok &= fclose(fp) == 0;
+    if (!ok || rename(tmpFile, cacheFile) != 0)
+        unlink(tmpFile);
+    JLI_MemFree(tmpFile);
+}
+#endif /* Unix */
+
 static JLI_List
 wildcardFileList(const char *wildcard)
 {
     const char *basename;
-    JLI_List fl = JLI_List_new(16);
-    WildcardIterator it = WildcardIterator_for(wildcard);
+    JLI_List fl;
+    WildcardIterator it;
+#ifndef _WIN32
+    struct stat st;
+    const char *cacheFile = getenv(LAUNCHER_CACHE_ENV_ENTRY);
+    st.st_mtime = -1;
+    if (cacheFile != NULL && *cacheFile != '\0' &&
+        (fl = cachedFileList(cacheFile, wildcard, &st)) != NULL)
+        return fl;
+#endif
 
+    fl = JLI_List_new(16);
+    it = WildcardIterator_for(wildcard);
     if (it == NULL)
     {
         JLI_List_free(fl);
@@ -259,6 +512,10 @@ wildcardFileList(const char *wildcard)
         if (isJarFileName(basename))
             JLI_List_add(fl, wildcardConcat(wildcard, basename));
     WildcardIterator_close(it);
+#ifndef _WIN32
+    if (cacheFile != NULL && *cacheFile != '\0')
+        cacheFileList(wildcard, &st, fl);
+#endif
     return fl;
 }
 
@@ -311,6 +568,10 @@ JLI_WildcardExpandClasspath(const char *classpath)
     expanded = FileList_expandWildcards(fl) ?
         JLI_List_join(fl, PATH_SEPARATOR) : classpath;
     JLI_List_free(fl);
+#ifndef _WIN32
+    if (cacheDirty)
+        saveCache(getenv(LAUNCHER_CACHE_ENV_ENTRY));
+#endif
     if (getenv(JLDEBUG_ENV_ENTRY) != 0)
         printf("Expanded wildcards:\n"
                "    before: \"%s\"\n"
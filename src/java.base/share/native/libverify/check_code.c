@@ -181,6 +181,8 @@ enum {
                                        ((unsigned)1 << ((i) % BITS_PER_INT)))
 #define IS_BIT_SET(flags, i) (flags[(i)/BITS_PER_INT] & \
                                        ((unsigned)1 << ((i) % BITS_PER_INT)))
+#define CLEAR_BIT(flags, i)  (flags[(i)/BITS_PER_INT] &= \
+                                       ~((unsigned)1 << ((i) % BITS_PER_INT)))
 
 typedef unsigned int fullinfo_type;
 typedef unsigned int *bitvector;
@@ -304,6 +306,7 @@ struct context_type {
     struct handler_info_type *handler_info;
     fullinfo_type *superclasses; /* null terminated superclasses */
     int instruction_count;      /* number of instructions */
+    int *changed;               /* bitmap of instructions to look at */
     fullinfo_type return_type;  /* function return type */
     fullinfo_type swap_table[4]; /* used for passing information */
     int bitmask_size;           /* words needed to hold bitmap of arguments */
@@ -346,7 +349,6 @@ typedef unsigned short flag_type;
 
 struct instruction_data_type {
     int opcode;         /* may turn into "canonical" opcode */
-    unsigned changed:1;         /* has it changed */
     unsigned protected:1;       /* must accessor be a subclass of "this" */
     union {
         int i;                  /* operand to the opcode */
@@ -1048,6 +1050,7 @@ verify_method(context_type *context, jclass cb, int method_index,
 
     /* Allocate a structure to hold info about each instruction. */
     idata = NEW(instruction_data_type, instruction_count);
+    context->changed = ZNEW(int, (instruction_count + BITS_PER_INT - 1) / BITS_PER_INT);
 
     /* Initialize the heap, and other info in the context structure. */
     context->code = code;
@@ -1071,7 +1074,6 @@ verify_method(context_type *context, jclass cb, int method_index,
         this_idata->stack_info.stack = NULL;
         this_idata->stack_info.stack_size  = UNKNOWN_STACK_SIZE;
         this_idata->register_info.register_count = UNKNOWN_REGISTER_COUNT;
-        this_idata->changed = JNI_FALSE;  /* no need to look at it yet. */
         this_idata->protected = JNI_FALSE;  /* no need to look at it yet. */
         this_idata->and_flags = (flag_type) -1; /* "bottom" and value */
         this_idata->or_flags = 0; /* "bottom" or value*/
@@ -1835,7 +1837,7 @@ initialize_dataflow(context_type *context)
     }
     pop_and_free(context);
     /* Indicate that we need to look at the first instruction. */
-    idata[0].changed = JNI_TRUE;
+    SET_BIT(context->changed, 0);
 }
 
 
@@ -1848,20 +1850,27 @@ run_dataflow(context_type *context) {
     int max_stack_size = JVM_GetMethodIxMaxStack(env, cb, mi);
     instruction_data_type *idata = context->instruction_data;
     unsigned int icount = context->instruction_count;
+    int *changed = context->changed;
     jboolean work_to_do = JNI_TRUE;
     unsigned int inumber;
 
-    /* Run through the loop, until there is nothing left to do. */
+    /* Run through the loop, until there is nothing left to do.
+     * Each pass looks at the changed instructions in order, skipping
+     * a word of the bitmap at a time where nothing changed. */
     while (work_to_do) {
         work_to_do = JNI_FALSE;
         for (inumber = 0; inumber < icount; inumber++) {
             instruction_data_type *this_idata = &idata[inumber];
-            if (this_idata->changed) {
+            if (changed[inumber / BITS_PER_INT] == 0) {
+                inumber |= BITS_PER_INT - 1;
+                continue;
+            }
+            if (IS_BIT_SET(changed, inumber)) {
                 register_info_type new_register_info;
                 stack_info_type new_stack_info;
                 flag_type new_and_flags, new_or_flags;
 
-                this_idata->changed = JNI_FALSE;
+                CLEAR_BIT(changed, inumber);
                 work_to_do = JNI_TRUE;
 #ifdef DEBUG
                 if (verify_verbose) {
@@ -2938,7 +2947,7 @@ merge_into_successors(context_type *context, unsigned int inumber,
 
     case JVM_OPC_jsr: case JVM_OPC_jsr_w:
         if (this_idata->operand2.i != UNKNOWN_RET_INSTRUCTION)
-            idata[this_idata->operand2.i].changed = JNI_TRUE;
+            SET_BIT(context->changed, this_idata->operand2.i);
         /* FALLTHROUGH */
     case JVM_OPC_goto: case JVM_OPC_goto_w:
         successors_count = 1;
@@ -3200,7 +3209,7 @@ merge_into_one_successor(context_type *context,
     }
 
 #ifdef DEBUG
-    if (verify_verbose && idata[to_inumber].changed) {
+    if (verify_verbose && IS_BIT_SET(context->changed, to_inumber)) {
         register_info_type *register_info = &this_idata->register_info;
         stack_info_type *stack_info = &this_idata->stack_info;
         if (memcmp(&old_reg_info, register_info, sizeof(old_reg_info)) ||
@@ -3238,7 +3247,7 @@ merge_stack(context_type *context, unsigned int from_inumber,
         /* First time at this instruction.  Just copy. */
         this_idata->stack_info.stack_size = new_stack_size;
         this_idata->stack_info.stack = new_stack;
-        this_idata->changed = JNI_TRUE;
+        SET_BIT(context->changed, to_inumber);
     } else if (new_stack_size != stack_size) {
         CCerror(context, "Inconsistent stack height %d != %d",
                 new_stack_size, stack_size);
@@ -3271,7 +3280,7 @@ merge_stack(context_type *context, unsigned int from_inumber,
                 CCerror(context, "Mismatched stack types");
             }
             this_idata->stack_info.stack = stack;
-            this_idata->changed = JNI_TRUE;
+            SET_BIT(context->changed, to_inumber);
         }
     }
 }
@@ -3295,7 +3304,7 @@ merge_registers(context_type *context, unsigned int from_inumber,
         this_reginfo->registers = new_registers;
         this_reginfo->mask_count = new_mask_count;
         this_reginfo->masks = new_masks;
-        this_idata->changed = JNI_TRUE;
+        SET_BIT(context->changed, to_inumber);
     } else {
         /* See if we've got new information on the register set. */
         int register_count = this_reginfo->register_count;
@@ -3309,7 +3318,7 @@ merge_registers(context_type *context, unsigned int from_inumber,
             /* Any register larger than new_register_count is now bogus */
             this_reginfo->register_count = new_register_count;
             register_count = new_register_count;
-            this_idata->changed = JNI_TRUE;
+            SET_BIT(context->changed, to_inumber);
         }
         for (i = 0; i < register_count; i++) {
             fullinfo_type prev_value = registers[i];
@@ -3341,7 +3350,7 @@ merge_registers(context_type *context, unsigned int from_inumber,
                 register_count--;
             this_reginfo->register_count = register_count;
             this_reginfo->registers = new_set;
-            this_idata->changed = JNI_TRUE;
+            SET_BIT(context->changed, to_inumber);
         }
         if (mask_count > 0) {
             /* If the target instruction already has a sequence of masks, then
@@ -3384,7 +3393,7 @@ merge_registers(context_type *context, unsigned int from_inumber,
                 }
                 this_reginfo->masks = copy;
                 this_reginfo->mask_count = matches;
-                this_idata->changed = JNI_TRUE;
+                SET_BIT(context->changed, to_inumber);
                 matches = 0;
                 last_match = -1;
                 for (i = 0; i < mask_count; i++) {
@@ -3427,7 +3436,7 @@ merge_flags(context_type *context, unsigned int from_inumber,
     if ((merged_and != this_and_flags) || (merged_or != this_or_flags)) {
         this_idata->and_flags = merged_and;
         this_idata->or_flags = merged_or;
-        this_idata->changed = JNI_TRUE;
+        SET_BIT(context->changed, to_inumber);
     }
 }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1997, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1997, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -54,6 +54,18 @@ Java_java_util_zip_CRC32_updateBytes0(JNIEnv *env, jclass cls, jint crc,
     return crc;
 }
 
+/*
+ * Returns the CRC-32 of the concatenation of two sequences, given the CRC-32
+ * of each of them and the length of the second one. This lets the checksums of
+ * blocks that are compressed in parallel be combined for the gzip trailer.
+ */
+JNIEXPORT jint JNICALL
+Java_java_util_zip_CRC32_combine0(JNIEnv *env, jclass cls, jint crc1, jint crc2,
+                                  jlong len2)
+{
+    return crc32_combine(crc1, crc2, (z_off_t)len2);
+}
+
 JNIEXPORT jint
 ZIP_CRC32(jint crc, const jbyte *buf, jint len)
 {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1997, 2020, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1997, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -29,6 +29,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "jlong.h"
 #include "jni.h"
 #include "jni_util.h"
@@ -286,6 +287,84 @@ Java_java_util_zip_Deflater_deflateBufferBuffer(JNIEnv *env, jobject this, jlong
     return retVal;
 }
 
+/*
+ * Compresses one block of a stream that is split into independent blocks, so
+ * that the blocks can be compressed on several threads. The block is raw
+ * deflate data that uses the preceding input (at most 32K of it) as a preset
+ * dictionary. All blocks except the last end on a byte boundary with
+ * Z_SYNC_FLUSH, and the last one with Z_FINISH, so that the concatenation of
+ * the blocks is a single deflate stream. A stream is set up for each block,
+ * no state is shared between calls.
+ *
+ * Returns the number of bytes written to the output buffer, or -1 if the
+ * output buffer is too small for the compressed block.
+ */
+JNIEXPORT jint JNICALL
+Java_java_util_zip_Deflater_deflateBlock(JNIEnv *env, jclass cls,
+                                         jint level, jint strategy,
+                                         jlong dictionaryBuffer, jint dictionaryLen,
+                                         jlong inputBuffer, jint inputLen,
+                                         jlong outputBuffer, jint outputLen,
+                                         jboolean last)
+{
+    z_stream strm;
+    jint outputUsed = -1;
+    int res;
+
+    memset(&strm, 0, sizeof(strm));
+    res = deflateInit2(&strm, level, Z_DEFLATED, -MAX_WBITS, DEF_MEM_LEVEL, strategy);
+    switch (res) {
+    case Z_OK:
+        break;
+    case Z_MEM_ERROR:
+        JNU_ThrowOutOfMemoryError(env, 0);
+        return -1;
+    case Z_STREAM_ERROR:
+        JNU_ThrowIllegalArgumentException(env, 0);
+        return -1;
+    default:
+        throwInternalErrorHelper(env, &strm, "unknown error initializing zlib library");
+        return -1;
+    }
+
+    if (dictionaryLen > 0) {
+        if (dictionaryLen > (1 << MAX_WBITS)) {
+            /* Only the window size preceding the block can be referenced. */
+            dictionaryBuffer += dictionaryLen - (1 << MAX_WBITS);
+            dictionaryLen = 1 << MAX_WBITS;
+        }
+        res = deflateSetDictionary(&strm, jlong_to_ptr(dictionaryBuffer), dictionaryLen);
+        if (res != Z_OK) {
+            checkSetDictionaryResult(env, ptr_to_jlong(&strm), res);
+            deflateEnd(&strm);
+            return -1;
+        }
+    }
+
+    strm.next_in  = (Bytef *) jlong_to_ptr(inputBuffer);
+    strm.avail_in = inputLen;
+    strm.next_out  = (Bytef *) jlong_to_ptr(outputBuffer);
+    strm.avail_out = outputLen;
+
+    res = deflate(&strm, last ? Z_FINISH : Z_SYNC_FLUSH);
+    switch (res) {
+    case Z_STREAM_END:
+    case Z_OK:
+        /* A sync flush is complete only if there was space left in the output. */
+        if (strm.avail_in == 0 && (last ? res == Z_STREAM_END : strm.avail_out > 0)) {
+            outputUsed = outputLen - strm.avail_out;
+        }
+        break;
+    case Z_BUF_ERROR:
+        break;
+    default:
+        throwInternalErrorHelper(env, &strm, "unknown error in deflateBlock");
+        break;
+    }
+    deflateEnd(&strm);
+    return outputUsed;
+}
+
 JNIEXPORT jint JNICALL
 Java_java_util_zip_Deflater_getAdler(JNIEnv *env, jclass cls, jlong addr)
 {
@@ -557,6 +557,58 @@ countCENHeaders(unsigned char *beg, unsigned char *end)
     return count;
 }
 
+/*
+ * Allocates an empty hash table for total entries.
+ * Returns non-zero in case of allocation error.
+ */
+static int
+allocTable(jzfile *zip, jint total)
+{
+    jint j;
+    zip->tablelen = ((total/2) | 1); // Odd -> fewer collisions
+    zip->table    = malloc(zip->tablelen * sizeof(zip->table[0]));
+    /* 'tablelen' can't be zero (see computation above). */
+    if (zip->table == NULL) return -1;
+    for (j = 0; j < zip->tablelen; j++)
+        zip->table[j] = ZIP_ENDCHAIN;
+    return 0;
+}
+
+/*
+ * Records the name hash of entry i, whose CEN header is at cp, and adds
+ * the entry to the hash table.
+ */
+static void
+addToTable(jzfile *zip, jint i, unsigned char *cp)
+{
+    jzcell *zc = &zip->entries[i];
+    unsigned int hsh;
+
+    zc->hash = hashN((char *)cp+CENHDR, CENNAM(cp));
+    hsh = zc->hash % zip->tablelen;
+    zc->next = zip->table[hsh];
+    zip->table[hsh] = i;
+}
+
+#ifdef USE_MMAP
+/*
+ * Builds the hash table for a zip file with a mapped central directory.
+ * This is deferred to the first lookup by name, so that zip files that
+ * are only opened or iterated don't pay for hashing every entry name.
+ * Returns non-zero in case of allocation error.
+ */
+static int
+buildTable(jzfile *zip)
+{
+    jint i;
+    if (allocTable(zip, zip->total) != 0)
+        return -1;
+    for (i = 0; i < zip->total; i++)
+        addToTable(zip, i, zip->maddr + (zip->entries[i].cenpos - zip->offset));
+    return 0;
+}
+#endif
+
 #define ZIP_FORMAT_ERROR(message) \
 if (1) { zip->msg = message; goto Catch; } else ((void)0)
 
@@ -572,7 +624,7 @@ readCEN(jzfile *zip, jint knownTotal)
     /* Following are unsigned 32-bit */
     jlong endpos, end64pos, cenpos, cenlen, cenoff;
     /* Following are unsigned 16-bit */
-    jint total, tablelen, i, j;
+    jint total, i;
     unsigned char *cenbuf = NULL;
     unsigned char *cenend;
     unsigned char *cp;
@@ -583,7 +635,8 @@ readCEN(jzfile *zip, jint knownTotal)
     unsigned char endbuf[ENDHDR];
     jint endhdrlen = ENDHDR;
     jzcell *entries;
-    jint *table;
+    /* Hash the entry names only on the first lookup if the CEN stays mapped */
+    jboolean deferTable = JNI_FALSE;
 
     /* Clear previous zip error */
     zip->msg = NULL;
@@ -661,6 +714,7 @@ readCEN(jzfile *zip, jint knownTotal)
             }
         }
         cenbuf = zip->maddr + cenpos - offset;
+        deferTable = JNI_TRUE;
     } else
 #endif
     {
@@ -684,20 +738,15 @@ readCEN(jzfile *zip, jint knownTotal)
      */
     total = (knownTotal != -1) ? knownTotal : total;
     entries  = zip->entries  = calloc(total, sizeof(entries[0]));
-    tablelen = zip->tablelen = ((total/2) | 1); // Odd -> fewer collisions
-    table    = zip->table    = malloc(tablelen * sizeof(table[0]));
-    /* According to ISO C it is perfectly legal for malloc to return zero
-     * if called with a zero argument. We check this for 'entries' but not
-     * for 'table' because 'tablelen' can't be zero (see computation above). */
-    if ((entries == NULL && total != 0) || table == NULL) goto Catch;
-    for (j = 0; j < tablelen; j++)
-        table[j] = ZIP_ENDCHAIN;
+    /* According to ISO C it is perfectly legal for calloc to return zero
+     * if called with a zero argument. */
+    if (entries == NULL && total != 0) goto Catch;
+    if (!deferTable && allocTable(zip, total) != 0) goto Catch;
 
     /* Iterate through the entries in the central directory */
     for (i = 0, cp = cenbuf; cp <= cenend - CENHDR; i++, cp += CENSIZE(cp)) {
         /* Following are unsigned 16-bit */
         jint method, nlen;
-        unsigned int hsh;
 
         if (i >= total) {
             /* This will only happen if the zip file has an incorrect
@@ -727,14 +776,11 @@ readCEN(jzfile *zip, jint knownTotal)
             if (addMetaName(zip, (char *)cp+CENHDR, nlen) != 0)
                 goto Catch;
 
-        /* Record the CEN offset and the name hash in our hash cell. */
+        /* Record the CEN offset in our hash cell, and add the entry
+         * to the hash table unless that is deferred. */
         entries[i].cenpos = cenpos + (cp - cenbuf);
-        entries[i].hash = hashN((char *)cp+CENHDR, nlen);
-
-        /* Add the entry to the hash table */
-        hsh = entries[i].hash % tablelen;
-        entries[i].next = table[hsh];
-        table[hsh] = i;
+        if (!deferTable)
+            addToTable(zip, i, cp);
     }
     if (cp != cenend) {
         ZIP_FORMAT_ERROR("invalid CEN header (bad header size)");
@@ -1177,6 +1223,11 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
     if (zip->total == 0) {
         goto Finally;
     }
+#ifdef USE_MMAP
+    if (zip->table == NULL && buildTable(zip) != 0) {
+        goto Finally;
+    }
+#endif
 
     idx = zip->table[hsh % zip->tablelen];
 
@@ -271,16 +271,30 @@ void ZLIB_INTERNAL inflate_fast(z_streamp strm, unsigned start) {
                 }
                 else {
                     from = out - dist;          /* copy direct from output */
-                    do {                        /* minimum length is three */
-                        *out++ = *from++;
-                        *out++ = *from++;
-                        *out++ = *from++;
-                        len -= 3;
-                    } while (len > 2);
-                    if (len) {
-                        *out++ = *from++;
-                        if (len > 1)
+                    if (dist >= 8) {            /* copy 8 bytes at a time */
+                        while (len >= 8) {      /* chunks don't overlap */
+                            zmemcpy(out, from, 8);
+                            out += 8;
+                            from += 8;
+                            len -= 8;
+                        }
+                        while (len > 0) {
                             *out++ = *from++;
+                            len--;
+                        }
+                    }
+                    else {
+                        do {                    /* minimum length is three */
+                            *out++ = *from++;
+                            *out++ = *from++;
+                            *out++ = *from++;
+                            len -= 3;
+                        } while (len > 2);
+                        if (len) {
+                            *out++ = *from++;
+                            if (len > 1)
+                                *out++ = *from++;
+                        }
                     }
                 }
             }
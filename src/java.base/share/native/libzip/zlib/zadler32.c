@@ -81,6 +81,76 @@
 #  define MOD63(a) a %= BASE
 #endif
 
+/* SSSE3 kernel, selected at run time on x86_64 with GCC or clang */
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#  define ADLER32_SSSE3
+#  include <tmmintrin.h>
+
+local int adler32_have_ssse3(void) {
+    static int have = -1;
+    if (have < 0)
+        have = __builtin_cpu_supports("ssse3") ? 1 : 0;
+    return have;
+}
+
+/* Update the component sums with the 32-byte blocks of *buf, leaving
+   fewer than 32 bytes in *len. Returns the sums reduced modulo BASE. */
+__attribute__((target("ssse3")))
+local void adler32_ssse3(unsigned long *adler, unsigned long *sum2,
+                         const Bytef **buf, z_size_t *len) {
+    const __m128i tap1 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,
+                                       24, 23, 22, 21, 20, 19, 18, 17);
+    const __m128i tap2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9,
+                                       8, 7, 6, 5, 4, 3, 2, 1);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+    const Bytef *p = *buf;
+    unsigned long s1 = *adler;
+    unsigned long s2 = *sum2;
+    z_size_t blocks = *len / 32;
+
+    *len -= blocks * 32;
+    while (blocks) {
+        /* NMAX / 32 blocks keep the 32-bit lanes from overflowing */
+        unsigned n = NMAX / 32;
+        __m128i v_ps, v_s1, v_s2;
+        if (n > blocks)
+            n = (unsigned)blocks;
+        blocks -= n;
+
+        v_ps = _mm_set_epi32(0, 0, 0, (int)(s1 * n));
+        v_s2 = _mm_set_epi32(0, 0, 0, (int)s2);
+        v_s1 = _mm_setzero_si128();
+        do {
+            const __m128i bytes1 = _mm_loadu_si128((const __m128i *)p);
+            const __m128i bytes2 = _mm_loadu_si128((const __m128i *)(p + 16));
+            /* s1 of each previous block contributes 32 times to s2 */
+            v_ps = _mm_add_epi32(v_ps, v_s1);
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes1, zero));
+            v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_maddubs_epi16(bytes1, tap1), ones));
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes2, zero));
+            v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_maddubs_epi16(bytes2, tap2), ones));
+            p += 32;
+        } while (--n);
+        v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(v_ps, 5));
+
+        /* horizontal sums */
+        v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, _MM_SHUFFLE(2, 3, 0, 1)));
+        v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, _MM_SHUFFLE(1, 0, 3, 2)));
+        s1 += (unsigned)_mm_cvtsi128_si32(v_s1);
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(2, 3, 0, 1)));
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(1, 0, 3, 2)));
+        s2 = (unsigned)_mm_cvtsi128_si32(v_s2);
+
+        MOD(s1);
+        MOD(s2);
+    }
+    *adler = s1;
+    *sum2 = s2;
+    *buf = p;
+}
+#endif
+
 /* ========================================================================= */
 uLong ZEXPORT adler32_z(uLong adler, const Bytef *buf, z_size_t len) {
     unsigned long sum2;
@@ -117,6 +187,14 @@ uLong ZEXPORT adler32_z(uLong adler, const Bytef *buf, z_size_t len) {
         return adler | (sum2 << 16);
     }
 
+#ifdef ADLER32_SSSE3
+    if (len >= 64 && adler32_have_ssse3()) {
+        adler32_ssse3(&adler, &sum2, &buf, &len);
+        if (len == 0)
+            return adler | (sum2 << 16);
+    }
+#endif
+
     /* do length NMAX blocks -- requires just one modulo operation */
     while (len >= NMAX) {
         len -= NMAX;
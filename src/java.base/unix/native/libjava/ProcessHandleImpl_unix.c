@@ -122,14 +122,6 @@
 #define WTERMSIG(status) ((status)&0x7F)
 #endif
 
-/* The child exited because of a signal.
- * The best value to return is 0x80 + signal number,
- * because that is what all Unix shells do, and because
- * it allows callers to distinguish between process exit and
- * process death by signal.
- */
-#define WTERMSIG_RETURN(status) (WTERMSIG(status) + 0x80)
-
 /* Field id for jString 'command' in java.lang.ProcessHandleImpl.Info */
 jfieldID ProcessHandleImpl_Info_commandID;
 
@@ -562,8 +554,13 @@ jint unix_getChildren(JNIEnv *env, jlong jpid, jlongArray jarray,
                 continue;
             }
 
-            // Get the parent pid, and start time
-            ppid = os_getParentPidAndTimings(env, childpid, &totalTime, &startTime);
+            // Get the parent pid, and start time; listing all processes
+            // without parents or start times needs neither.
+            if (pid == 0 && ppids == NULL && stimes == NULL) {
+                ppid = 0;
+            } else {
+                ppid = os_getParentPidAndTimings(env, childpid, &totalTime, &startTime);
+            }
             if (ppid >= 0 && (pid == 0 || ppid == pid)) {
                 if (count < arraySize) {
                     // Only store if it fits
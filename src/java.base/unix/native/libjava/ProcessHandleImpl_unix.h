@@ -33,6 +33,14 @@
  * See ProcessHandleImpl_unix.c for more details.
  */
 
+/* The child exited because of a signal.
+ * The best value to return is 0x80 + signal number,
+ * because that is what all Unix shells do, and because
+ * it allows callers to distinguish between process exit and
+ * process death by signal.
+ */
+#define WTERMSIG_RETURN(status) (WTERMSIG(status) + 0x80)
+
 /* Field id for jString 'command' in java.lang.ProcessHandleImpl.Info */
 extern jfieldID ProcessHandleImpl_Info_commandID;
 
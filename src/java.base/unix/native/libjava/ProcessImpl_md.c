@@ -45,6 +45,10 @@
 #include <string.h>
 
 #include <spawn.h>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/mman.h>
+#endif
 
 #include "childproc.h"
 
@@ -180,6 +184,11 @@
  *
  * Based on the above analysis, we are currently defaulting to posix_spawn()
  * on all Unices including Linux.
+ *
+ * On Linux there is a further mode, MODE_CLONE, which does what glibc's
+ * posix_spawn does but runs our own pre-exec work in the child: clone(2) with
+ * CLONE_VM | CLONE_VFORK on a separate stack with all signals blocked. This
+ * execs the target binary directly, saving the exec of jspawnhelper.
  */
 
 static void
@@ -468,6 +477,66 @@ vforkChild(ChildStuff *c) {
 }
 #endif
 
+#ifdef __linux__
+/* The parent is suspended until the child execs or exits (CLONE_VFORK),
+ * so the child's stack can be released as soon as clone returns. */
+#define CLONE_STACK_SIZE (256 * 1024)
+
+typedef struct _CloneArgs {
+    ChildStuff *c;
+    const sigset_t *sigmask;  /* signal mask to restore before exec */
+} CloneArgs;
+
+static int
+cloneChildProcess(void *arg) {
+    const CloneArgs *args = (const CloneArgs *) arg;
+    struct sigaction dfl;
+    int sig;
+
+    /* The child shares the parent's memory but not its signal handlers
+     * (no CLONE_SIGHAND). Reset caught signals to their default so that
+     * no handler of the parent runs in the child before exec. Ignored
+     * signals stay ignored, as they would across exec. */
+    memset(&dfl, 0, sizeof(dfl));
+    dfl.sa_handler = SIG_DFL;
+    for (sig = 1; sig < _NSIG; sig++) {
+        struct sigaction old;
+        if (sigaction(sig, NULL, &old) == 0 &&
+            old.sa_handler != SIG_DFL && old.sa_handler != SIG_IGN) {
+            sigaction(sig, &dfl, NULL);
+        }
+    }
+    pthread_sigmask(SIG_SETMASK, args->sigmask, NULL);
+    return childProcess(args->c);
+}
+
+static pid_t
+cloneChild(ChildStuff *c) {
+    pid_t resultPid;
+    int errnum;
+    sigset_t all, old;
+    CloneArgs args;
+    char *stack = mmap(NULL, CLONE_STACK_SIZE, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (stack == MAP_FAILED) {
+        return -1;
+    }
+
+    /* Block all signals until the child has reset its handlers. */
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+    args.c = c;
+    args.sigmask = &old;
+    resultPid = clone(cloneChildProcess, stack + CLONE_STACK_SIZE,
+                      CLONE_VM | CLONE_VFORK | SIGCHLD, &args);
+    errnum = errno;
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+    munmap(stack, CLONE_STACK_SIZE);
+    errno = errnum;
+    return resultPid;
+}
+#endif
+
 static pid_t
 forkChild(ChildStuff *c) {
     pid_t resultPid;
@@ -619,6 +688,10 @@ startChild(JNIEnv *env, jobject process, ChildStuff *c, const char *helperpath)
         return forkChild(c);
       case MODE_POSIX_SPAWN:
         return spawnChild(env, process, c, helperpath);
+#ifdef __linux__
+      case MODE_CLONE:
+        return cloneChild(c);
+#endif
       default:
         return -1;
     }
@@ -732,6 +805,9 @@ Java_java_lang_ProcessImpl_forkAndExec(JNIEnv *env,
           case MODE_POSIX_SPAWN:
             throwIOException(env, errno, "posix_spawn failed");
             break;
+          case MODE_CLONE:
+            throwIOException(env, errno, "clone failed");
+            break;
         }
         goto Catch;
     }
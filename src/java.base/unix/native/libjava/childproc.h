@@ -78,6 +78,7 @@ extern char **environ;
 #define MODE_FORK 1
 #define MODE_POSIX_SPAWN 2
 #define MODE_VFORK 3
+#define MODE_CLONE 4
 
 typedef struct _ChildStuff
 {
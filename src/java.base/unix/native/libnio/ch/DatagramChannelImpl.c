@@ -34,6 +34,10 @@
 #include <netinet/in.h>
 #endif
 
+#if defined(__linux__)
+#include <netinet/udp.h>
+#endif
+
 #include "jni.h"
 #include "jni_util.h"
 #include "jlong.h"
@@ -43,6 +47,30 @@
 
 #include "sun_nio_ch_DatagramChannelImpl.h"
 
+#if defined(__linux__)
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+// Maximum number of datagrams per batch
+#define MAX_BATCH 64
+
+// Per datagram entry of the batch metadata buffer. The datagrams
+// themselves are in consecutive slots of the data buffer.
+typedef struct {
+    jint length;        // datagram length, or GSO/GRO payload length
+    jint segmentSize;   // GSO/GRO segment size, 0 for a single datagram
+    jint addressLength; // 0 when connected
+    SOCKETADDRESS address;
+} batch_entry_t;
+#endif
+
 JNIEXPORT void JNICALL
 Java_sun_nio_ch_DatagramChannelImpl_disconnect0(JNIEnv *env, jclass clazz,
                                                 jobject fdo, jboolean isIPv6)
@@ -161,3 +189,166 @@ Java_sun_nio_ch_DatagramChannelImpl_send0(JNIEnv *env, jclass clazz,
     }
     return n;
 }
+
+#if defined(__linux__)
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_DatagramChannelImpl_batchEntrySize0(JNIEnv *env, jclass clazz)
+{
+    return sizeof(batch_entry_t);
+}
+
+/*
+ * Receives up to count datagrams with one recvmmsg call. Datagram i is
+ * received into the slot at bufAddress + i * slotSize, and its length,
+ * GRO segment size and sender are stored into entry i of the metadata
+ * buffer at entriesAddress. Returns the number of datagrams received.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_DatagramChannelImpl_receiveBatch0(JNIEnv *env, jclass clazz,
+                                                  jobject fdo, jlong bufAddress,
+                                                  jint slotSize, jint count,
+                                                  jlong entriesAddress,
+                                                  jboolean connected)
+{
+    jint fd = fdval(env, fdo);
+    char *buf = (char *)jlong_to_ptr(bufAddress);
+    batch_entry_t *entries = (batch_entry_t *)jlong_to_ptr(entriesAddress);
+    struct mmsghdr msgs[MAX_BATCH];
+    struct iovec iovs[MAX_BATCH];
+    char control[MAX_BATCH][CMSG_SPACE(sizeof(int))];
+    int i, n;
+
+    if (count > MAX_BATCH) {
+        count = MAX_BATCH;
+    }
+
+    memset(msgs, 0, sizeof(struct mmsghdr) * count);
+    for (i = 0; i < count; i++) {
+        iovs[i].iov_base = buf + (size_t)i * slotSize;
+        iovs[i].iov_len = slotSize;
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_name = &entries[i].address;
+        msgs[i].msg_hdr.msg_namelen = sizeof(SOCKETADDRESS);
+        msgs[i].msg_hdr.msg_control = control[i];
+        msgs[i].msg_hdr.msg_controllen = sizeof(control[i]);
+    }
+
+    // MSG_WAITFORONE: only block for the first datagram, then take
+    // whatever else is queued
+    do {
+        n = recvmmsg(fd, msgs, count, MSG_WAITFORONE, NULL);
+    } while (n < 0 && errno == ECONNREFUSED && connected == JNI_FALSE);
+
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return IOS_UNAVAILABLE;
+        }
+        if (errno == EINTR) {
+            return IOS_INTERRUPTED;
+        }
+        if (errno == ECONNREFUSED) {
+            JNU_ThrowByName(env, JNU_JAVANETPKG "PortUnreachableException", 0);
+            return IOS_THROWN;
+        }
+        return handleSocketError(env, errno);
+    }
+
+    for (i = 0; i < n; i++) {
+        struct cmsghdr *cmsg;
+        entries[i].length = msgs[i].msg_len;
+        entries[i].segmentSize = 0;
+        entries[i].addressLength = msgs[i].msg_hdr.msg_namelen;
+        for (cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cmsg != NULL;
+             cmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, cmsg)) {
+            if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+                int gso_size;
+                memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size));
+                entries[i].segmentSize = gso_size;
+            }
+        }
+    }
+    return n;
+}
+
+/*
+ * Sends up to count datagrams with one sendmmsg call. Datagram i is taken
+ * from the slot at bufAddress + i * slotSize, with the length, target and
+ * GSO segment size from entry i of the metadata buffer. With a segment
+ * size, the kernel splits the slot into datagrams of that size (UDP_SEGMENT).
+ * Returns the number of entries sent.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_DatagramChannelImpl_sendBatch0(JNIEnv *env, jclass clazz,
+                                               jobject fdo, jlong bufAddress,
+                                               jint slotSize, jint count,
+                                               jlong entriesAddress)
+{
+    jint fd = fdval(env, fdo);
+    char *buf = (char *)jlong_to_ptr(bufAddress);
+    batch_entry_t *entries = (batch_entry_t *)jlong_to_ptr(entriesAddress);
+    struct mmsghdr msgs[MAX_BATCH];
+    struct iovec iovs[MAX_BATCH];
+    char control[MAX_BATCH][CMSG_SPACE(sizeof(uint16_t))];
+    int i, n;
+
+    if (count > MAX_BATCH) {
+        count = MAX_BATCH;
+    }
+
+    memset(msgs, 0, sizeof(struct mmsghdr) * count);
+    for (i = 0; i < count; i++) {
+        iovs[i].iov_base = buf + (size_t)i * slotSize;
+        iovs[i].iov_len = entries[i].length;
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        if (entries[i].addressLength > 0) {
+            msgs[i].msg_hdr.msg_name = &entries[i].address;
+            msgs[i].msg_hdr.msg_namelen = entries[i].addressLength;
+        }
+        if (entries[i].segmentSize > 0) {
+            struct cmsghdr *cmsg;
+            uint16_t gso_size = (uint16_t)entries[i].segmentSize;
+            msgs[i].msg_hdr.msg_control = control[i];
+            msgs[i].msg_hdr.msg_controllen = sizeof(control[i]);
+            cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr);
+            cmsg->cmsg_level = SOL_UDP;
+            cmsg->cmsg_type = UDP_SEGMENT;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(gso_size));
+            memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+        }
+    }
+
+    n = sendmmsg(fd, msgs, count, 0);
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return IOS_UNAVAILABLE;
+        }
+        if (errno == EINTR) {
+            return IOS_INTERRUPTED;
+        }
+        if (errno == ECONNREFUSED) {
+            JNU_ThrowByName(env, JNU_JAVANETPKG "PortUnreachableException", 0);
+            return IOS_THROWN;
+        }
+        return handleSocketError(env, errno);
+    }
+    return n;
+}
+
+/*
+ * Enables or disables UDP_GRO, so that receiveBatch0 may return several
+ * coalesced datagrams in one slot. Returns 0 or the errno value.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_DatagramChannelImpl_setGro0(JNIEnv *env, jclass clazz,
+                                            jobject fdo, jboolean enable)
+{
+    jint fd = fdval(env, fdo);
+    int on = (enable == JNI_TRUE) ? 1 : 0;
+    int rv = setsockopt(fd, SOL_UDP, UDP_GRO, &on, sizeof(on));
+    return (rv == 0) ? 0 : errno;
+}
+
+#endif // defined(__linux__)
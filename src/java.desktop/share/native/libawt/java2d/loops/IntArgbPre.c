@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2000, 2005, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2000, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -33,6 +33,22 @@
 #include "ByteGray.h"
 #include "ByteIndexed.h"
 
+#include <string.h>
+
+/*
+ * The SrcOver MaskFill loop has a SIMD variant on the platforms where the
+ * baseline instruction set includes 128-bit integer vectors (SSE2 on x64,
+ * NEON on AArch64), so no runtime CPU check is needed to select it.
+ */
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define INTARGBPRE_SIMD_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON) && \
+      (!defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#include <arm_neon.h>
+#define INTARGBPRE_SIMD_NEON
+#endif
+
 /*
  * This file declares, registers, and defines the various graphics
  * primitive loops to manipulate surfaces of type "IntArgbPre".
@@ -159,8 +175,177 @@ DEFINE_XOR_BLIT(IntArgb, IntArgbPre, AnyInt)
 
 DEFINE_SRC_MASKFILL(IntArgbPre, 4ByteArgb)
 
+#if defined(INTARGBPRE_SIMD_SSE2) || defined(INTARGBPRE_SIMD_NEON)
+
+/*
+ * SrcOver MaskFill of a premultiplied color into IntArgbPre pixels.
+ *
+ * For every pixel the loops compute, with pathA = 0xff when there is no mask:
+ *
+ *     res  = MUL8(pathA, src)          (all four components)
+ *     res += MUL8(0xff - resA, dst)    (all four components)
+ *
+ * which gives the same result as DEFINE_SRCOVER_MASKFILL for all values of
+ * pathA, including the 0 and 0xff special cases of the macro.  Since the
+ * color components are premultiplied, no component of the sum can exceed
+ * 0xff.  MUL8 is evaluated as ((t + (t >> 8)) >> 8) with t = a * b + 128,
+ * which matches mul8table exactly.
+ */
+
+static inline jint BlendIntArgbPreSrcOver(jint pixel, jint srcPix, jint pathA)
+{
+    jint resPix = 0;
+    jint resA = MUL8(pathA, ((juint) srcPix) >> 24);
+    jint dstF = 0xff - resA;
+    jint shift;
+    for (shift = 0; shift < 32; shift += 8) {
+        jint srcC = (srcPix >> shift) & 0xff;
+        jint dstC = (pixel >> shift) & 0xff;
+        resPix |= (MUL8(pathA, srcC) + MUL8(dstF, dstC)) << shift;
+    }
+    return resPix;
+}
+
+#ifdef INTARGBPRE_SIMD_SSE2
+
+static inline __m128i Mul8x16(__m128i a, __m128i b)
+{
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(a, b), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+/* Blends two pixels held as 16-bit components. */
+static inline __m128i BlendIntArgbPreSrcOverx2(__m128i dst, __m128i src, __m128i path)
+{
+    __m128i res = Mul8x16(path, src);
+    __m128i resA = _mm_shufflehi_epi16(_mm_shufflelo_epi16(res, _MM_SHUFFLE(3, 3, 3, 3)),
+                                       _MM_SHUFFLE(3, 3, 3, 3));
+    __m128i dstF = _mm_sub_epi16(_mm_set1_epi16(0xff), resA);
+    return _mm_add_epi16(res, Mul8x16(dstF, dst));
+}
+
+/* Blends four pixels, pMask points to their coverage values or is NULL. */
+static inline void BlendIntArgbPreSrcOverx4(jint *pRas, jubyte *pMask, __m128i src)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i dst = _mm_loadu_si128((__m128i *) pRas);
+    __m128i pathLo, pathHi;
+    if (pMask) {
+        jint m;
+        __m128i path;
+        memcpy(&m, pMask, sizeof(m));
+        path = _mm_cvtsi32_si128(m);
+        path = _mm_unpacklo_epi8(path, path);
+        path = _mm_unpacklo_epi16(path, path);
+        pathLo = _mm_unpacklo_epi8(path, zero);
+        pathHi = _mm_unpackhi_epi8(path, zero);
+    } else {
+        pathLo = pathHi = _mm_set1_epi16(0xff);
+    }
+    _mm_storeu_si128((__m128i *) pRas,
+        _mm_packus_epi16(BlendIntArgbPreSrcOverx2(_mm_unpacklo_epi8(dst, zero), src, pathLo),
+                         BlendIntArgbPreSrcOverx2(_mm_unpackhi_epi8(dst, zero), src, pathHi)));
+}
+
+#define DeclareIntArgbPreSrcVector(VEC, srcPix) \
+    __m128i VEC = _mm_unpacklo_epi8(_mm_set1_epi32(srcPix), _mm_setzero_si128());
+
+#else /* INTARGBPRE_SIMD_NEON */
+
+static inline uint8x8_t Mul8x8(uint8x8_t a, uint8x8_t b)
+{
+    uint16x8_t t = vaddq_u16(vmull_u8(a, b), vdupq_n_u16(128));
+    return vmovn_u16(vshrq_n_u16(vsraq_n_u16(t, t, 8), 8));
+}
+
+static inline uint8x16_t Mul8x16(uint8x16_t a, uint8x16_t b)
+{
+    return vcombine_u8(Mul8x8(vget_low_u8(a), vget_low_u8(b)),
+                       Mul8x8(vget_high_u8(a), vget_high_u8(b)));
+}
+
+/* Blends four pixels, pMask points to their coverage values or is NULL. */
+static inline void BlendIntArgbPreSrcOverx4(jint *pRas, jubyte *pMask, uint8x16_t src)
+{
+    static const uint8_t pathIndex[16] = { 0, 0, 0, 0, 1, 1, 1, 1,
+                                           2, 2, 2, 2, 3, 3, 3, 3 };
+    static const uint8_t alphaIndex[16] = { 3, 3, 3, 3, 7, 7, 7, 7,
+                                            11, 11, 11, 11, 15, 15, 15, 15 };
+    uint8x16_t dst = vld1q_u8((uint8_t *) pRas);
+    uint8x16_t res, dstF;
+    if (pMask) {
+        uint32_t m;
+        memcpy(&m, pMask, sizeof(m));
+        res = Mul8x16(vqtbl1q_u8(vreinterpretq_u8_u32(vdupq_n_u32(m)),
+                                 vld1q_u8(pathIndex)), src);
+    } else {
+        res = src;
+    }
+    /* 0xff - resA */
+    dstF = vmvnq_u8(vqtbl1q_u8(res, vld1q_u8(alphaIndex)));
+    vst1q_u8((uint8_t *) pRas, vaddq_u8(res, Mul8x16(dstF, dst)));
+}
+
+#define DeclareIntArgbPreSrcVector(VEC, srcPix) \
+    uint8x16_t VEC = vreinterpretq_u8_u32(vdupq_n_u32((uint32_t) srcPix));
+
+#endif /* INTARGBPRE_SIMD_SSE2 */
+
+void NAME_SRCOVER_MASKFILL(IntArgbPre)
+    (void *rasBase,
+     jubyte *pMask, jint maskOff, jint maskScan,
+     jint width, jint height,
+     jint fgColor,
+     SurfaceDataRasInfo *pRasInfo,
+     NativePrimitive *pPrim,
+     CompositeInfo *pCompInfo)
+{
+    jint rasScan = pRasInfo->scanStride;
+    jint *pRas = (jint *) rasBase;
+    jint srcA, srcR, srcG, srcB;
+    jint srcPix;
+
+    ExtractIntDcmComponents1234(fgColor, srcA, srcR, srcG, srcB);
+    if (srcA != 0xff) {
+        if (srcA == 0) {
+            return;
+        }
+        srcR = MUL8(srcA, srcR);
+        srcG = MUL8(srcA, srcG);
+        srcB = MUL8(srcA, srcB);
+    }
+    srcPix = ComposeIntDcmComponents1234(srcA, srcR, srcG, srcB);
+
+    if (pMask) {
+        pMask += maskOff;
+    }
+    {
+        DeclareIntArgbPreSrcVector(src, srcPix)
+        do {
+            jint x = 0;
+            for (; x + 4 <= width; x += 4) {
+                BlendIntArgbPreSrcOverx4(pRas + x, pMask ? pMask + x : NULL, src);
+            }
+            for (; x < width; x++) {
+                jint pathA = pMask ? pMask[x] : 0xff;
+                if (pathA > 0) {
+                    pRas[x] = BlendIntArgbPreSrcOver(pRas[x], srcPix, pathA);
+                }
+            }
+            pRas = PtrAddBytes(pRas, rasScan);
+            if (pMask) {
+                pMask = PtrAddBytes(pMask, maskScan);
+            }
+        } while (--height > 0);
+    }
+}
+
+#else
+
 DEFINE_SRCOVER_MASKFILL(IntArgbPre, 4ByteArgb)
 
+#endif
+
 DEFINE_ALPHA_MASKFILL(IntArgbPre, 4ByteArgb)
 
 DEFINE_SRCOVER_MASKBLIT(IntArgb, IntArgbPre, 4ByteArgb)
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,6 +25,7 @@
 
 #include <jni_util.h>
 #include <stdlib.h>
+#include <string.h>
 #include "hb.h"
 #include "hb-jdk.h"
 #include "hb-ot.h"
@@ -225,6 +226,221 @@ JDKFontInfo*
 #define TYPO_LIGA 0x00000002
 #define TYPO_RTL  0x80000000
 
+/*
+ * The results of shaping recently laid out runs are cached, so that text
+ * which is laid out over and over again, such as UI labels, is not
+ * shaped again every time. The result depends on the strike, which
+ * supplies the glyph advances, on the script and the layout flags, and on
+ * the text of the run together with the context harfbuzz looks at on
+ * either side of it. The cache is bounded and evicts the least recently
+ * used run. It is guarded by the monitor of the GVData class.
+ */
+#define SHAPE_CACHE_SIZE      512   // max number of cached runs
+#define SHAPE_CACHE_BUCKETS   1024  // must be a power of 2
+#define SHAPE_CACHE_MAX_CHARS 256   // longer runs are not cached
+// harfbuzz uses up to 5 code points of context, i.e. 10 UTF-16 chars
+#define SHAPE_CONTEXT_CHARS   10
+
+typedef struct ShapeCacheEntry {
+    struct ShapeCacheEntry *next;    // next entry in the same bucket
+    struct ShapeCacheEntry *lruPrev; // more recently used entry
+    struct ShapeCacheEntry *lruNext; // less recently used entry
+    unsigned int hash;
+    jweak fontStrike;
+    jlong pFace;
+    float ptSize;
+    float matrix[4];
+    jint script;
+    jint flags;
+    int contextLen;                  // context chars before the run
+    int charCount;                   // chars of the run
+    int textLen;                     // chars of the run and its context
+    jchar *text;
+    int glyphCount;
+    hb_glyph_info_t *glyphInfo;      // clusters are relative to the run
+    hb_glyph_position_t *glyphPos;
+} ShapeCacheEntry;
+
+static ShapeCacheEntry* shapeCacheBuckets[SHAPE_CACHE_BUCKETS];
+static ShapeCacheEntry* shapeCacheMRU = NULL;
+static ShapeCacheEntry* shapeCacheLRU = NULL;
+static int shapeCacheCount = 0;
+
+static unsigned int shapeCacheHash(ShapeCacheEntry* key) {
+    unsigned int hash = 2166136261u;
+    int i;
+    for (i = 0; i < key->textLen; i++) {
+        hash = (hash ^ key->text[i]) * 16777619u;
+    }
+    hash = hash * 31 + (unsigned int)key->contextLen;
+    hash = hash * 31 + (unsigned int)key->charCount;
+    hash = hash * 31 + (unsigned int)key->script;
+    hash = hash * 31 + (unsigned int)key->flags;
+    hash = hash * 31 + (unsigned int)(key->pFace >> 4);
+    return hash;
+}
+
+static jboolean shapeCacheMatches(JNIEnv* env, ShapeCacheEntry* entry,
+                                  ShapeCacheEntry* key, jobject fontStrike) {
+    return entry->hash == key->hash &&
+           entry->pFace == key->pFace &&
+           entry->ptSize == key->ptSize &&
+           memcmp(entry->matrix, key->matrix, sizeof(key->matrix)) == 0 &&
+           entry->script == key->script &&
+           entry->flags == key->flags &&
+           entry->contextLen == key->contextLen &&
+           entry->charCount == key->charCount &&
+           entry->textLen == key->textLen &&
+           memcmp(entry->text, key->text, key->textLen * sizeof(jchar)) == 0 &&
+           (*env)->IsSameObject(env, entry->fontStrike, fontStrike);
+}
+
+/*
+ * Allocates an entry for the key which holds a copy of the key text and
+ * of the shaping result. clusterBase is subtracted from the clusters.
+ */
+static ShapeCacheEntry* newShapeCacheEntry(ShapeCacheEntry* key,
+                                           int glyphCount,
+                                           hb_glyph_info_t *glyphInfo,
+                                           hb_glyph_position_t *glyphPos,
+                                           int clusterBase) {
+    int i;
+    size_t size = sizeof(ShapeCacheEntry) +
+                  glyphCount * (sizeof(hb_glyph_info_t) +
+                                sizeof(hb_glyph_position_t)) +
+                  key->textLen * sizeof(jchar);
+    ShapeCacheEntry* entry = (ShapeCacheEntry*)malloc(size);
+    if (entry == NULL) {
+        return NULL;
+    }
+    *entry = *key;
+    entry->next = NULL;
+    entry->lruPrev = NULL;
+    entry->lruNext = NULL;
+    entry->fontStrike = NULL;
+    entry->glyphCount = glyphCount;
+    entry->glyphInfo = (hb_glyph_info_t*)(entry + 1);
+    entry->glyphPos = (hb_glyph_position_t*)(entry->glyphInfo + glyphCount);
+    entry->text = (jchar*)(entry->glyphPos + glyphCount);
+    memcpy(entry->text, key->text, key->textLen * sizeof(jchar));
+    memcpy(entry->glyphPos, glyphPos, glyphCount * sizeof(hb_glyph_position_t));
+    for (i = 0; i < glyphCount; i++) {
+        entry->glyphInfo[i] = glyphInfo[i];
+        entry->glyphInfo[i].cluster -= clusterBase;
+    }
+    return entry;
+}
+
+static void shapeCacheUnlinkLRU(ShapeCacheEntry* entry) {
+    if (entry->lruPrev != NULL) {
+        entry->lruPrev->lruNext = entry->lruNext;
+    } else {
+        shapeCacheMRU = entry->lruNext;
+    }
+    if (entry->lruNext != NULL) {
+        entry->lruNext->lruPrev = entry->lruPrev;
+    } else {
+        shapeCacheLRU = entry->lruPrev;
+    }
+    entry->lruPrev = NULL;
+    entry->lruNext = NULL;
+}
+
+static void shapeCacheLinkMRU(ShapeCacheEntry* entry) {
+    entry->lruPrev = NULL;
+    entry->lruNext = shapeCacheMRU;
+    if (shapeCacheMRU != NULL) {
+        shapeCacheMRU->lruPrev = entry;
+    } else {
+        shapeCacheLRU = entry;
+    }
+    shapeCacheMRU = entry;
+}
+
+static void shapeCacheRemove(JNIEnv* env, ShapeCacheEntry* entry) {
+    ShapeCacheEntry** link =
+        &shapeCacheBuckets[entry->hash & (SHAPE_CACHE_BUCKETS - 1)];
+    while (*link != entry) {
+        link = &(*link)->next;
+    }
+    *link = entry->next;
+    shapeCacheUnlinkLRU(entry);
+    shapeCacheCount--;
+    (*env)->DeleteWeakGlobalRef(env, entry->fontStrike);
+    free(entry);
+}
+
+static ShapeCacheEntry* shapeCacheFind(JNIEnv* env, ShapeCacheEntry* key,
+                                       jobject fontStrike) {
+    ShapeCacheEntry* entry =
+        shapeCacheBuckets[key->hash & (SHAPE_CACHE_BUCKETS - 1)];
+    while (entry != NULL && !shapeCacheMatches(env, entry, key, fontStrike)) {
+        entry = entry->next;
+    }
+    return entry;
+}
+
+/*
+ * Returns a copy of the cached result for the key, which the caller
+ * must free, or NULL if the run is not cached.
+ */
+static ShapeCacheEntry* lookupShapeCache(JNIEnv* env, ShapeCacheEntry* key,
+                                         jobject fontStrike) {
+    ShapeCacheEntry* entry;
+    ShapeCacheEntry* result = NULL;
+
+    if (!init_JNI_IDs(env) || (*env)->MonitorEnter(env, gvdClass) != JNI_OK) {
+        return NULL;
+    }
+    entry = shapeCacheFind(env, key, fontStrike);
+    if (entry != NULL) {
+        shapeCacheUnlinkLRU(entry);
+        shapeCacheLinkMRU(entry);
+        result = newShapeCacheEntry(entry, entry->glyphCount,
+                                    entry->glyphInfo, entry->glyphPos, 0);
+    }
+    (*env)->MonitorExit(env, gvdClass);
+    return result;
+}
+
+static void storeShapeCache(JNIEnv* env, ShapeCacheEntry* key,
+                            jobject fontStrike, int offset, int glyphCount,
+                            hb_glyph_info_t *glyphInfo,
+                            hb_glyph_position_t *glyphPos) {
+    ShapeCacheEntry** bucket;
+    ShapeCacheEntry* entry =
+        newShapeCacheEntry(key, glyphCount, glyphInfo, glyphPos, offset);
+    if (entry == NULL) {
+        return;
+    }
+    entry->fontStrike = (*env)->NewWeakGlobalRef(env, fontStrike);
+    if (entry->fontStrike == NULL) {
+        free(entry);
+        return;
+    }
+    if (!init_JNI_IDs(env) || (*env)->MonitorEnter(env, gvdClass) != JNI_OK) {
+        (*env)->DeleteWeakGlobalRef(env, entry->fontStrike);
+        free(entry);
+        return;
+    }
+    if (shapeCacheFind(env, key, fontStrike) != NULL) {
+        // another thread has cached the same run meanwhile
+        (*env)->MonitorExit(env, gvdClass);
+        (*env)->DeleteWeakGlobalRef(env, entry->fontStrike);
+        free(entry);
+        return;
+    }
+    bucket = &shapeCacheBuckets[entry->hash & (SHAPE_CACHE_BUCKETS - 1)];
+    entry->next = *bucket;
+    *bucket = entry;
+    shapeCacheLinkMRU(entry);
+    shapeCacheCount++;
+    while (shapeCacheCount > SHAPE_CACHE_SIZE) {
+        shapeCacheRemove(env, shapeCacheLRU);
+    }
+    (*env)->MonitorExit(env, gvdClass);
+}
+
 JNIEXPORT jboolean JNICALL Java_sun_font_SunLayoutEngine_shape
     (JNIEnv *env, jclass cls,
      jobject font2D,
@@ -257,6 +473,9 @@ JNIEXPORT jboolean JNICALL Java_sun_font_SunLayoutEngine_shape
      char* liga = (flags & TYPO_LIGA) ? "liga" : "-liga";
      jboolean ret;
      unsigned int buflen;
+     ShapeCacheEntry key;
+     ShapeCacheEntry* cached;
+     jboolean cacheable;
 
      JDKFontInfo *jdkFontInfo =
          createJDKFontInfo(env, font2D, fontStrike, ptSize, matrix);
@@ -267,6 +486,44 @@ JNIEXPORT jboolean JNICALL Java_sun_font_SunLayoutEngine_shape
      jdkFontInfo->font2D = font2D;
      jdkFontInfo->fontStrike = fontStrike;
 
+     chars = (*env)->GetCharArrayElements(env, text, NULL);
+     if ((*env)->ExceptionCheck(env)) {
+         free((void*)jdkFontInfo);
+         return JNI_FALSE;
+     }
+     len = (*env)->GetArrayLength(env, text);
+
+     cacheable = (limit - offset) <= SHAPE_CACHE_MAX_CHARS;
+     if (cacheable) {
+         int contextStart = offset > SHAPE_CONTEXT_CHARS ?
+                            offset - SHAPE_CONTEXT_CHARS : 0;
+         int contextLimit = len - limit > SHAPE_CONTEXT_CHARS ?
+                            limit + SHAPE_CONTEXT_CHARS : len;
+         memset(&key, 0, sizeof(key));
+         key.pFace = pFace;
+         key.ptSize = ptSize;
+         memcpy(key.matrix, jdkFontInfo->matrix, sizeof(key.matrix));
+         key.script = script;
+         key.flags = flags;
+         key.contextLen = offset - contextStart;
+         key.charCount = limit - offset;
+         key.textLen = contextLimit - contextStart;
+         key.text = chars + contextStart;
+         key.hash = shapeCacheHash(&key);
+
+         cached = lookupShapeCache(env, &key, fontStrike);
+         if (cached != NULL) {
+             ret = storeGVData(env, gvdata, slot, baseIndex, 0, startPt,
+                               limit - offset, cached->glyphCount,
+                               cached->glyphInfo, cached->glyphPos,
+                               jdkFontInfo->devScale);
+             free(cached);
+             free((void*)jdkFontInfo);
+             (*env)->ReleaseCharArrayElements(env, text, chars, JNI_ABORT);
+             return ret;
+         }
+     }
+
      hbface = (hb_face_t*) jlong_to_ptr(pFace);
      hbfont = hb_jdk_font_create(hbface, jdkFontInfo, NULL);
 
@@ -281,15 +538,6 @@ JNIEXPORT jboolean JNICALL Java_sun_font_SunLayoutEngine_shape
      hb_buffer_set_cluster_level(buffer,
                                  HB_BUFFER_CLUSTER_LEVEL_MONOTONE_CHARACTERS);
 
-     chars = (*env)->GetCharArrayElements(env, text, NULL);
-     if ((*env)->ExceptionCheck(env)) {
-         hb_buffer_destroy(buffer);
-         hb_font_destroy(hbfont);
-         free((void*)jdkFontInfo);
-         return JNI_FALSE;
-     }
-     len = (*env)->GetArrayLength(env, text);
-
      hb_buffer_add_utf16(buffer, chars, len, offset, limit-offset);
 
      features = calloc(2, sizeof(hb_feature_t));
@@ -306,6 +554,10 @@ JNIEXPORT jboolean JNICALL Java_sun_font_SunLayoutEngine_shape
      ret = storeGVData(env, gvdata, slot, baseIndex, offset, startPt,
                        limit - offset, glyphCount, glyphInfo, glyphPos,
                        jdkFontInfo->devScale);
+     if (ret && cacheable && !(*env)->ExceptionCheck(env)) {
+         storeShapeCache(env, &key, fontStrike, offset,
+                         glyphCount, glyphInfo, glyphPos);
+     }
 
      hb_buffer_destroy (buffer);
      hb_font_destroy(hbfont);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2007, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2007, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -57,6 +57,31 @@
 #define  FTFixedToFloat(x) ((x) / (float)(ftFixed1))
 #define  FT26Dot6ToFloat(x)  ((x) / ((float) (1<<6)))
 
+/* Rendered glyph images are cached per scaler, i.e. per Font2D, so that
+   they are shared by all strikes of the font which use the same size,
+   transform and rendering options, and survive the strikes being
+   disposed. Calls into a scaler are serialized in java, so the cache
+   does not need any locking of its own. */
+#define GLYPH_CACHE_SIZE 256 /* must be a power of 2 */
+#define GLYPH_CACHE_MAX_IMAGE_SIZE 2048
+
+typedef struct {
+    FT_Matrix  transform;
+    int        ptsz;
+    jint       aaType;
+    jint       fmType;
+    jboolean   useSbits;
+    jboolean   doBold;
+    jboolean   doItalize;
+    jint       glyphCode;
+} FTGlyphCacheKey;
+
+typedef struct {
+    FTGlyphCacheKey key;
+    GlyphInfo* glyphInfo;     /* NULL if the entry is not in use */
+    int        imageSize;
+} FTGlyphCacheEntry;
+
 typedef struct {
     /* Important note:
          JNI forbids sharing same env between different threads.
@@ -78,6 +103,8 @@ typedef struct {
     unsigned fontDataOffset;
     unsigned fontDataLength;
     unsigned fileSize;
+
+    FTGlyphCacheEntry* glyphCache; /* allocated lazily */
 } FTScalerInfo;
 
 typedef struct FTScalerContext {
@@ -117,11 +144,26 @@ Java_sun_font_FreetypeFontScaler_initIDs(
                                             "debugFonts", "()Z").z;
 }
 
+static void freeGlyphCache(FTScalerInfo* scalerInfo) {
+    int i;
+
+    if (scalerInfo->glyphCache == NULL)
+        return;
+
+    for (i = 0; i < GLYPH_CACHE_SIZE; i++) {
+        free(scalerInfo->glyphCache[i].glyphInfo);
+    }
+    free(scalerInfo->glyphCache);
+    scalerInfo->glyphCache = NULL;
+}
+
 static void freeNativeResources(JNIEnv *env, FTScalerInfo* scalerInfo) {
 
     if (scalerInfo == NULL)
         return;
 
+    freeGlyphCache(scalerInfo);
+
     // FT_Done_Face always closes the stream, but only frees the memory
     // of the data structure if it was internally allocated by FT.
     // We hold on to a pointer to the stream structure if we provide it
@@ -906,6 +948,92 @@ static void CopyFTSubpixelVToSubpixel(const void* srcImage, int srcRowBytes,
  */
 #define MAX_GLYPH_DIM 1024
 
+/************* Glyph image cache **************/
+
+static void initGlyphCacheKey(FTGlyphCacheKey* key,
+                              FTScalerContext* context, jint glyphCode) {
+    /* keys are compared with memcmp, so clear the padding too */
+    memset(key, 0, sizeof(FTGlyphCacheKey));
+    key->transform = context->transform;
+    key->ptsz      = context->ptsz;
+    key->aaType    = context->aaType;
+    key->fmType    = context->fmType;
+    key->useSbits  = context->useSbits;
+    key->doBold    = context->doBold;
+    key->doItalize = context->doItalize;
+    key->glyphCode = glyphCode;
+}
+
+static FTGlyphCacheEntry* getGlyphCacheEntry(FTScalerInfo* scalerInfo,
+                                             FTGlyphCacheKey* key) {
+    unsigned int hash = (unsigned int) key->glyphCode;
+    hash = hash * 31 + (unsigned int) key->ptsz;
+    hash = hash * 31 + (unsigned int) key->transform.xx;
+    hash = hash * 31 + (unsigned int) key->transform.xy;
+    hash = hash * 31 + (unsigned int) key->aaType;
+    hash ^= hash >> 16;
+    return &scalerInfo->glyphCache[hash & (GLYPH_CACHE_SIZE - 1)];
+}
+
+static GlyphInfo* copyGlyphInfo(GlyphInfo* src, int imageSize) {
+    GlyphInfo* glyphInfo = (GlyphInfo*) malloc(sizeof(GlyphInfo) + imageSize);
+    if (glyphInfo == NULL) {
+        return NULL;
+    }
+    memcpy(glyphInfo, src, sizeof(GlyphInfo) + imageSize);
+    glyphInfo->cellInfo = NULL;
+    glyphInfo->managed  = UNMANAGED_GLYPH;
+    glyphInfo->image    = (imageSize == 0) ? NULL :
+                          (unsigned char*) glyphInfo + sizeof(GlyphInfo);
+    return glyphInfo;
+}
+
+/* Returns a copy of the cached glyph image, which the caller owns,
+   or NULL if the glyph is not cached. */
+static GlyphInfo* lookupGlyphCache(FTScalerInfo* scalerInfo,
+                                   FTGlyphCacheKey* key) {
+    FTGlyphCacheEntry* entry;
+
+    if (scalerInfo->glyphCache == NULL) {
+        return NULL;
+    }
+    entry = getGlyphCacheEntry(scalerInfo, key);
+    if (entry->glyphInfo == NULL ||
+        memcmp(&entry->key, key, sizeof(FTGlyphCacheKey)) != 0) {
+        return NULL;
+    }
+    return copyGlyphInfo(entry->glyphInfo, entry->imageSize);
+}
+
+/* Caches a copy of the glyph image, evicting the glyph which was cached
+   in the same entry. Large images are not cached to bound the memory
+   used by the cache. */
+static void storeGlyphCache(FTScalerInfo* scalerInfo, FTGlyphCacheKey* key,
+                            GlyphInfo* glyphInfo, int imageSize) {
+    FTGlyphCacheEntry* entry;
+    GlyphInfo* copy;
+
+    if (imageSize > GLYPH_CACHE_MAX_IMAGE_SIZE) {
+        return;
+    }
+    if (scalerInfo->glyphCache == NULL) {
+        scalerInfo->glyphCache = (FTGlyphCacheEntry*)
+            calloc(GLYPH_CACHE_SIZE, sizeof(FTGlyphCacheEntry));
+        if (scalerInfo->glyphCache == NULL) {
+            return;
+        }
+    }
+    copy = copyGlyphInfo(glyphInfo, imageSize);
+    if (copy == NULL) {
+        return;
+    }
+    entry = getGlyphCacheEntry(scalerInfo, key);
+    free(entry->glyphInfo);
+    memcpy(&entry->key, key, sizeof(FTGlyphCacheKey));
+    entry->glyphInfo = copy;
+    entry->imageSize = imageSize;
+}
+
 /*
  * Class:     sun_font_FreetypeFontScaler
  * Method:    getGlyphImageNative
@@ -933,6 +1061,7 @@ static jlong
     GlyphInfo *glyphInfo;
     int renderFlags = FT_LOAD_DEFAULT, target;
     FT_GlyphSlot ftglyph;
+    FTGlyphCacheKey cacheKey;
 
     FTScalerContext* context =
         (FTScalerContext*) jlong_to_ptr(pScalerContext);
@@ -943,6 +1072,14 @@ static jlong
         return ptr_to_jlong(getNullGlyphImage());
     }
 
+    if (renderImage) {
+        initGlyphCacheKey(&cacheKey, context, glyphCode);
+        glyphInfo = lookupGlyphCache(scalerInfo, &cacheKey);
+        if (glyphInfo != NULL) {
+            return ptr_to_jlong(glyphInfo);
+        }
+    }
+
     error = setupFTContext(env, font2D, scalerInfo, context);
     if (error) {
         invalidateJavaScaler(env, scaler, scalerInfo);
@@ -1124,6 +1261,11 @@ static jlong
         }
     }
 
+    if (renderImage && glyphInfo != NULL) {
+        storeGlyphCache(scalerInfo, &cacheKey, glyphInfo,
+                        glyphInfo->image == NULL ? 0 : imageSize);
+    }
+
     return ptr_to_jlong(glyphInfo);
 }
 
@@ -16,6 +16,12 @@
 #include "jinclude.h"
 #include "jpeglib.h"
 
+#if defined(JPEG_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(JPEG_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
 
 /* Private subobject */
 
@@ -109,6 +115,129 @@ build_ycc_rgb_table (j_decompress_ptr cinfo)
 }
 
 
+#if defined(JPEG_SIMD_SSE2) || defined(JPEG_SIMD_NEON)
+
+/*
+ * SIMD YCbCr->RGB conversion of 8 pixels at a time.  The table lookups are
+ * replaced by 16x16->32 bit multiplies which compute exactly the table
+ * values: the constants that do not fit in 16 bits are split into a
+ * multiple of 2^16, which is added after the shift, and the remainder.
+ *      Cr_r_tab[cr] = (26345 * x + ONE_HALF) >> 16 + x
+ *      Cb_b_tab[cb] = (-14942 * x + ONE_HALF) >> 16 + 2 * x
+ *      (Cb_g_tab[cb] + Cr_g_tab[cr]) >> 16 =
+ *                     (-22554 * xb + 18734 * xr + ONE_HALF) >> 16 - xr
+ * Saturating to 0..MAXJSAMPLE is equivalent to the range_limit lookup.
+ * Returns the number of columns converted.
+ */
+
+#define CR_R_LO   ((short) (FIX(1.40200) - (1L << SCALEBITS)))
+#define CB_B_LO   ((short) (FIX(1.77200) - (2L << SCALEBITS)))
+#define CB_G      ((short) (- FIX(0.34414)))
+#define CR_G_LO   ((short) ((1L << SCALEBITS) - FIX(0.71414)))
+
+LOCAL(JDIMENSION)
+ycc_rgb_convert_simd (JSAMPROW inptr0, JSAMPROW inptr1, JSAMPROW inptr2,
+                      JSAMPROW outptr, JDIMENSION num_cols)
+{
+  JDIMENSION col;
+#ifdef JPEG_SIMD_SSE2
+  /* (x, -1) pairs multiplied by (c, -ONE_HALF) pairs give c * x + ONE_HALF */
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i minus1 = _mm_set1_epi16(-1);
+  const __m128i center = _mm_set1_epi16(CENTERJSAMPLE);
+  const __m128i half = _mm_set1_epi32(ONE_HALF);
+  const __m128i kR = _mm_set_epi16(-32768, CR_R_LO, -32768, CR_R_LO,
+                                   -32768, CR_R_LO, -32768, CR_R_LO);
+  const __m128i kB = _mm_set_epi16(-32768, CB_B_LO, -32768, CB_B_LO,
+                                   -32768, CB_B_LO, -32768, CB_B_LO);
+  const __m128i kG = _mm_set_epi16(CR_G_LO, CB_G, CR_G_LO, CB_G,
+                                   CR_G_LO, CB_G, CR_G_LO, CB_G);
+  JSAMPLE rgb[3][8];
+  int i;
+
+  for (col = 0; col + 8 <= num_cols; col += 8) {
+    __m128i y, cb, cr, lo, hi, r, g, b;
+    y  = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (inptr0 + col)),
+                           zero);
+    cb = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (inptr1 + col)),
+                           zero);
+    cr = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (inptr2 + col)),
+                           zero);
+    cb = _mm_sub_epi16(cb, center);
+    cr = _mm_sub_epi16(cr, center);
+
+    lo = _mm_madd_epi16(_mm_unpacklo_epi16(cr, minus1), kR);
+    hi = _mm_madd_epi16(_mm_unpackhi_epi16(cr, minus1), kR);
+    r = _mm_packs_epi32(_mm_srai_epi32(lo, SCALEBITS),
+                        _mm_srai_epi32(hi, SCALEBITS));
+    r = _mm_add_epi16(_mm_add_epi16(r, cr), y);
+
+    lo = _mm_madd_epi16(_mm_unpacklo_epi16(cb, minus1), kB);
+    hi = _mm_madd_epi16(_mm_unpackhi_epi16(cb, minus1), kB);
+    b = _mm_packs_epi32(_mm_srai_epi32(lo, SCALEBITS),
+                        _mm_srai_epi32(hi, SCALEBITS));
+    b = _mm_add_epi16(_mm_add_epi16(b, _mm_add_epi16(cb, cb)), y);
+
+    lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(cb, cr), kG), half);
+    hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(cb, cr), kG), half);
+    g = _mm_packs_epi32(_mm_srai_epi32(lo, SCALEBITS),
+                        _mm_srai_epi32(hi, SCALEBITS));
+    g = _mm_add_epi16(_mm_sub_epi16(g, cr), y);
+
+    _mm_storel_epi64((__m128i *) rgb[0], _mm_packus_epi16(r, r));
+    _mm_storel_epi64((__m128i *) rgb[1], _mm_packus_epi16(g, g));
+    _mm_storel_epi64((__m128i *) rgb[2], _mm_packus_epi16(b, b));
+    for (i = 0; i < 8; i++) {
+      outptr[RGB_RED] =   rgb[0][i];
+      outptr[RGB_GREEN] = rgb[1][i];
+      outptr[RGB_BLUE] =  rgb[2][i];
+      outptr += RGB_PIXELSIZE;
+    }
+  }
+#else /* JPEG_SIMD_NEON */
+  const int16x8_t center = vdupq_n_s16(CENTERJSAMPLE);
+  const int32x4_t half = vdupq_n_s32(ONE_HALF);
+
+  for (col = 0; col + 8 <= num_cols; col += 8) {
+    int16x8_t y, cb, cr, r, g, b;
+    int32x4_t lo, hi;
+    uint8x8x3_t rgb;
+    y  = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(inptr0 + col)));
+    cb = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(inptr1 + col)));
+    cr = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(inptr2 + col)));
+    cb = vsubq_s16(cb, center);
+    cr = vsubq_s16(cr, center);
+
+    lo = vmlal_n_s16(half, vget_low_s16(cr), CR_R_LO);
+    hi = vmlal_n_s16(half, vget_high_s16(cr), CR_R_LO);
+    r = vcombine_s16(vshrn_n_s32(lo, SCALEBITS), vshrn_n_s32(hi, SCALEBITS));
+    r = vaddq_s16(vaddq_s16(r, cr), y);
+
+    lo = vmlal_n_s16(half, vget_low_s16(cb), CB_B_LO);
+    hi = vmlal_n_s16(half, vget_high_s16(cb), CB_B_LO);
+    b = vcombine_s16(vshrn_n_s32(lo, SCALEBITS), vshrn_n_s32(hi, SCALEBITS));
+    b = vaddq_s16(vaddq_s16(b, vaddq_s16(cb, cb)), y);
+
+    lo = vmlal_n_s16(vmlal_n_s16(half, vget_low_s16(cb), CB_G),
+                     vget_low_s16(cr), CR_G_LO);
+    hi = vmlal_n_s16(vmlal_n_s16(half, vget_high_s16(cb), CB_G),
+                     vget_high_s16(cr), CR_G_LO);
+    g = vcombine_s16(vshrn_n_s32(lo, SCALEBITS), vshrn_n_s32(hi, SCALEBITS));
+    g = vaddq_s16(vsubq_s16(g, cr), y);
+
+    rgb.val[RGB_RED] =   vqmovun_s16(r);
+    rgb.val[RGB_GREEN] = vqmovun_s16(g);
+    rgb.val[RGB_BLUE] =  vqmovun_s16(b);
+    vst3_u8(outptr, rgb);
+    outptr += 8 * RGB_PIXELSIZE;
+  }
+#endif /* JPEG_SIMD_SSE2 */
+  return col;
+}
+
+#endif /* JPEG_SIMD_SSE2 || JPEG_SIMD_NEON */
+
+
 /*
  * Convert some rows of samples to the output colorspace.
  *
@@ -145,7 +274,13 @@ ycc_rgb_convert (j_decompress_ptr cinfo,
     inptr2 = input_buf[2][input_row];
     input_row++;
     outptr = *output_buf++;
-    for (col = 0; col < num_cols; col++) {
+#if defined(JPEG_SIMD_SSE2) || defined(JPEG_SIMD_NEON)
+    col = ycc_rgb_convert_simd(inptr0, inptr1, inptr2, outptr, num_cols);
+    outptr += col * RGB_PIXELSIZE;
+#else
+    col = 0;
+#endif
+    for (; col < num_cols; col++) {
       y  = GETJSAMPLE(inptr0[col]);
       cb = GETJSAMPLE(inptr1[col]);
       cr = GETJSAMPLE(inptr2[col]);
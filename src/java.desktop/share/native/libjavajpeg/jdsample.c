@@ -26,6 +26,12 @@
 #include "jinclude.h"
 #include "jpeglib.h"
 
+#if defined(JPEG_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(JPEG_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
 
 /* Pointer to routine to upsample a single component */
 typedef JMETHOD(void, upsample1_ptr,
@@ -304,6 +310,110 @@ h2v2_upsample (j_decompress_ptr cinfo, jpeg_component_info * compptr,
  * alternate pixel locations (a simple ordered dither pattern).
  */
 
+#if defined(JPEG_SIMD_SSE2) || defined(JPEG_SIMD_NEON)
+
+/*
+ * SIMD variant of the general case of h2v1_fancy_upsample, for 8 input
+ * columns at a time.  inptr points to the first column to process, whose
+ * left and right neighbours must exist.  Returns the number of columns
+ * processed, which is a multiple of 8 and at most colctr.
+ */
+
+LOCAL(JDIMENSION)
+h2v1_fancy_upsample_simd (JSAMPROW inptr, JSAMPROW outptr, JDIMENSION colctr)
+{
+  JDIMENSION done;
+
+  for (done = 0; done + 8 <= colctr; done += 8) {
+#ifdef JPEG_SIMD_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    __m128i cur, prev, next, even, odd;
+    cur  = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) inptr), zero);
+    prev = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (inptr - 1)),
+                             zero);
+    next = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (inptr + 1)),
+                             zero);
+    cur = _mm_add_epi16(cur, _mm_add_epi16(cur, cur));
+    even = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(cur, prev),
+                                        _mm_set1_epi16(1)), 2);
+    odd  = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(cur, next),
+                                        _mm_set1_epi16(2)), 2);
+    _mm_storeu_si128((__m128i *) outptr,
+                     _mm_unpacklo_epi8(_mm_packus_epi16(even, even),
+                                       _mm_packus_epi16(odd, odd)));
+#else /* JPEG_SIMD_NEON */
+    uint16x8_t cur = vmull_u8(vld1_u8(inptr), vdup_n_u8(3));
+    uint8x8x2_t out;
+    out.val[0] = vshrn_n_u16(vaddq_u16(vaddw_u8(cur, vld1_u8(inptr - 1)),
+                                       vdupq_n_u16(1)), 2);
+    out.val[1] = vrshrn_n_u16(vaddw_u8(cur, vld1_u8(inptr + 1)), 2);
+    vst2_u8(outptr, out);
+#endif /* JPEG_SIMD_SSE2 */
+    inptr += 8;
+    outptr += 16;
+  }
+  return done;
+}
+
+
+/*
+ * SIMD variant of the general case of h2v2_fancy_upsample, for 8 input
+ * columns at a time.  inptr0 and inptr1 point to the column after the
+ * first one to process, matching the scalar loop.  Returns the number of
+ * columns processed, which is a multiple of 8 and at most colctr.
+ */
+
+LOCAL(JDIMENSION)
+h2v2_fancy_upsample_simd (JSAMPROW inptr0, JSAMPROW inptr1, JSAMPROW outptr,
+                          JDIMENSION colctr)
+{
+  JDIMENSION done;
+
+  for (done = 0; done + 8 <= colctr; done += 8) {
+#ifdef JPEG_SIMD_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i three = _mm_set1_epi16(3);
+    __m128i last, cur, next, even, odd;
+#define COLSUM(offset) \
+    _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64( \
+                    (const __m128i *) (inptr0 + (offset))), zero), three), \
+                  _mm_unpacklo_epi8(_mm_loadl_epi64( \
+                    (const __m128i *) (inptr1 + (offset))), zero))
+    last = COLSUM(-2);
+    cur  = COLSUM(-1);
+    next = COLSUM(0);
+#undef COLSUM
+    cur = _mm_mullo_epi16(cur, three);
+    even = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(cur, last),
+                                        _mm_set1_epi16(8)), 4);
+    odd  = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(cur, next),
+                                        _mm_set1_epi16(7)), 4);
+    _mm_storeu_si128((__m128i *) outptr,
+                     _mm_unpacklo_epi8(_mm_packus_epi16(even, even),
+                                       _mm_packus_epi16(odd, odd)));
+#else /* JPEG_SIMD_NEON */
+    const uint8x8_t three = vdup_n_u8(3);
+    uint16x8_t last, cur, next;
+    uint8x8x2_t out;
+    last = vmlal_u8(vmovl_u8(vld1_u8(inptr1 - 2)), vld1_u8(inptr0 - 2), three);
+    cur  = vmlal_u8(vmovl_u8(vld1_u8(inptr1 - 1)), vld1_u8(inptr0 - 1), three);
+    next = vmlal_u8(vmovl_u8(vld1_u8(inptr1)), vld1_u8(inptr0), three);
+    cur = vmulq_n_u16(cur, 3);
+    out.val[0] = vrshrn_n_u16(vaddq_u16(cur, last), 4);
+    out.val[1] = vshrn_n_u16(vaddq_u16(vaddq_u16(cur, next),
+                                       vdupq_n_u16(7)), 4);
+    vst2_u8(outptr, out);
+#endif /* JPEG_SIMD_SSE2 */
+    inptr0 += 8;
+    inptr1 += 8;
+    outptr += 16;
+  }
+  return done;
+}
+
+#endif /* JPEG_SIMD_SSE2 || JPEG_SIMD_NEON */
+
+
 METHODDEF(void)
 h2v1_fancy_upsample (j_decompress_ptr cinfo, jpeg_component_info * compptr,
                      JSAMPARRAY input_data, JSAMPARRAY * output_data_ptr)
@@ -322,7 +432,16 @@ h2v1_fancy_upsample (j_decompress_ptr cinfo, jpeg_component_info * compptr,
     *outptr++ = (JSAMPLE) invalue;
     *outptr++ = (JSAMPLE) ((invalue * 3 + GETJSAMPLE(*inptr) + 2) >> 2);
 
-    for (colctr = compptr->downsampled_width - 2; colctr > 0; colctr--) {
+    colctr = compptr->downsampled_width - 2;
+#if defined(JPEG_SIMD_SSE2) || defined(JPEG_SIMD_NEON)
+    {
+      JDIMENSION done = h2v1_fancy_upsample_simd(inptr, outptr, colctr);
+      inptr += done;
+      outptr += 2 * done;
+      colctr -= done;
+    }
+#endif
+    for (; colctr > 0; colctr--) {
       /* General case: 3/4 * nearer pixel + 1/4 * further pixel */
       invalue = GETJSAMPLE(*inptr++) * 3;
       *outptr++ = (JSAMPLE) ((invalue + GETJSAMPLE(inptr[-2]) + 1) >> 2);
@@ -377,7 +496,22 @@ h2v2_fancy_upsample (j_decompress_ptr cinfo, jpeg_component_info * compptr,
       *outptr++ = (JSAMPLE) ((thiscolsum * 3 + nextcolsum + 7) >> 4);
       lastcolsum = thiscolsum; thiscolsum = nextcolsum;
 
-      for (colctr = compptr->downsampled_width - 2; colctr > 0; colctr--) {
+      colctr = compptr->downsampled_width - 2;
+#if defined(JPEG_SIMD_SSE2) || defined(JPEG_SIMD_NEON)
+      {
+        JDIMENSION done =
+          h2v2_fancy_upsample_simd(inptr0, inptr1, outptr, colctr);
+        if (done > 0) {
+          inptr0 += done;
+          inptr1 += done;
+          outptr += 2 * done;
+          colctr -= done;
+          lastcolsum = GETJSAMPLE(inptr0[-2]) * 3 + GETJSAMPLE(inptr1[-2]);
+          thiscolsum = GETJSAMPLE(inptr0[-1]) * 3 + GETJSAMPLE(inptr1[-1]);
+        }
+      }
+#endif
+      for (; colctr > 0; colctr--) {
         /* General case: 3/4 * nearer pixel + 1/4 * further pixel in each */
         /* dimension, thus 9/16, 3/16, 3/16, 1/16 overall */
         nextcolsum = GETJSAMPLE(*inptr0++) * 3 + GETJSAMPLE(*inptr1++);
@@ -359,6 +359,21 @@ typedef int boolean;
 #endif
 
 
+/* YCbCr->RGB conversion and fancy upsampling have SIMD variants on the
+ * platforms where the baseline instruction set has 128-bit integer vectors
+ * (SSE2 on x64, NEON on AArch64), so no runtime CPU check is needed.  They
+ * produce exactly the same output as the plain C loops.
+ */
+
+#if BITS_IN_JSAMPLE == 8 && RGB_PIXELSIZE == 3
+#if defined(__SSE2__) || defined(_M_X64)
+#define JPEG_SIMD_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define JPEG_SIMD_NEON
+#endif
+#endif
+
+
 /* FAST_FLOAT should be either float or double, whichever is done faster
  * by your compiler.  (Note that this type is only used in the floating point
  * DCT routines, so it only matters if you've defined DCT_FLOAT_SUPPORTED.)
@@ -35,6 +35,13 @@
 #include <lcms2_plugin.h>
 #include "jlong.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
 #define SigMake(a,b,c,d) \
                     ( ( ((int) ((unsigned char) (a))) << 24) | \
                       ( ((int) ((unsigned char) (b))) << 16) | \
@@ -492,6 +499,131 @@ static void releaseILData(JNIEnv *env, void *pData, jint type, jobject data,
     }
 }
 
+/*
+ * Large images are converted by several threads, each of which transforms
+ * a band of rows. Transforms can be used concurrently: lcms only caches the
+ * last transformed pixel, in a copy local to each call.
+ */
+#define PARALLEL_MIN_PIXELS     (1024 * 1024)
+#define PARALLEL_MIN_BAND_ROWS  64
+#define PARALLEL_MAX_BANDS      8
+
+typedef struct {
+    cmsHTRANSFORM sTrans;
+    char *input;
+    char *output;
+    jint width;
+    jint height;
+    jint srcNextRowOffset;
+    jint dstNextRowOffset;
+} TransformBand_t;
+
+static void transformBand(TransformBand_t *band) {
+    cmsDoTransformLineStride(band->sTrans, band->input, band->output,
+                             band->width, band->height,
+                             band->srcNextRowOffset, band->dstNextRowOffset,
+                             0, 0);
+}
+
+#ifdef _WIN32
+typedef HANDLE BandThread_t;
+
+static DWORD WINAPI bandThreadMain(LPVOID arg) {
+    transformBand((TransformBand_t *) arg);
+    return 0;
+}
+
+static int startBandThread(BandThread_t *thread, TransformBand_t *band) {
+    *thread = CreateThread(NULL, 0, bandThreadMain, band, 0, NULL);
+    return *thread != NULL;
+}
+
+static void joinBandThread(BandThread_t thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+static int getProcessorCount() {
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return (int) si.dwNumberOfProcessors;
+}
+#else
+typedef pthread_t BandThread_t;
+
+static void *bandThreadMain(void *arg) {
+    transformBand((TransformBand_t *) arg);
+    return NULL;
+}
+
+static int startBandThread(BandThread_t *thread, TransformBand_t *band) {
+    return pthread_create(thread, NULL, bandThreadMain, band) == 0;
+}
+
+static void joinBandThread(BandThread_t thread) {
+    pthread_join(thread, NULL);
+}
+
+static int getProcessorCount() {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int) n : 1;
+}
+#endif
+
+static void doTransform(cmsHTRANSFORM sTrans, char *input, char *output,
+                        jint width, jint height,
+                        jint srcNextRowOffset, jint dstNextRowOffset) {
+    TransformBand_t bands[PARALLEL_MAX_BANDS];
+    BandThread_t threads[PARALLEL_MAX_BANDS];
+    int started[PARALLEL_MAX_BANDS];
+    int numBands = 1;
+    int i, row, bandRows;
+
+    if ((jlong) width * height >= PARALLEL_MIN_PIXELS) {
+        numBands = getProcessorCount();
+        if (numBands > PARALLEL_MAX_BANDS) {
+            numBands = PARALLEL_MAX_BANDS;
+        }
+        if (numBands > height / PARALLEL_MIN_BAND_ROWS) {
+            numBands = height / PARALLEL_MIN_BAND_ROWS;
+        }
+    }
+
+    bands[0].sTrans = sTrans;
+    bands[0].input = input;
+    bands[0].output = output;
+    bands[0].width = width;
+    bands[0].height = height;
+    bands[0].srcNextRowOffset = srcNextRowOffset;
+    bands[0].dstNextRowOffset = dstNextRowOffset;
+    if (numBands <= 1) {
+        transformBand(&bands[0]);
+        return;
+    }
+
+    bandRows = (height + numBands - 1) / numBands;
+    for (i = 0, row = 0; i < numBands; i++, row += bandRows) {
+        bands[i] = bands[0];
+        bands[i].input = input + (jlong) row * srcNextRowOffset;
+        bands[i].output = output + (jlong) row * dstNextRowOffset;
+        bands[i].height = (height - row < bandRows) ? height - row : bandRows;
+    }
+
+    // The calling thread transforms the first band, and any band
+    // for which a thread could not be started.
+    for (i = 1; i < numBands; i++) {
+        started[i] = startBandThread(&threads[i], &bands[i]);
+    }
+    transformBand(&bands[0]);
+    for (i = 1; i < numBands; i++) {
+        if (started[i]) {
+            joinBandThread(threads[i]);
+        } else {
+            transformBand(&bands[i]);
+        }
+    }
+}
+
 /*
  * Class:     sun_java2d_cmm_lcms_LCMS
  * Method:    colorConvert
@@ -528,8 +660,8 @@ JNIEXPORT void JNICALL Java_sun_java2d_cmm_lcms_LCMS_colorConvert
     char *input = (char *) inputBuffer + srcOffset;
     char *output = (char *) outputBuffer + dstOffset;
 
-    cmsDoTransformLineStride(sTrans, input, output, width, height,
-                             srcNextRowOffset, dstNextRowOffset, 0, 0);
+    doTransform(sTrans, input, output, width, height,
+                srcNextRowOffset, dstNextRowOffset);
 
     releaseILData(env, inputBuffer, srcDType, srcData, JNI_ABORT);
     releaseILData(env, outputBuffer, dstDType, dstData, 0);
@@ -94,6 +94,51 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1SignInit
 }
 #endif
 
+#if defined(P11_ENABLE_C_SIGN) || defined(P11_ENABLE_SIGNBATCH)
+/*
+ * Signs the data with C_Sign in the session, on which the signing operation
+ * must have been initialized, and returns the signature. Returns NULL with
+ * a pending exception if signing fails.
+ */
+static jbyteArray signData(JNIEnv *env, CK_FUNCTION_LIST_PTR ckpFunctions,
+    CK_SESSION_HANDLE ckSessionHandle, CK_BYTE_PTR ckpData,
+    CK_ULONG ckDataLength)
+{
+    CK_BYTE_PTR bufP;
+    CK_ULONG ckSignatureLength;
+    CK_BYTE BUF[MAX_STACK_BUFFER_LEN];
+    jbyteArray jSignature = NULL;
+    CK_RV rv;
+
+    // unknown signature length
+    bufP = BUF;
+    ckSignatureLength = MAX_STACK_BUFFER_LEN;
+
+    rv = (*ckpFunctions->C_Sign)(ckSessionHandle, ckpData, ckDataLength,
+        bufP, &ckSignatureLength);
+
+    TRACE1("DEBUG C_Sign: ret rv=0x%lX\n", rv);
+
+    if (rv == CKR_BUFFER_TOO_SMALL) {
+        bufP = (CK_BYTE_PTR) malloc(ckSignatureLength);
+        if (bufP == NULL) {
+            p11ThrowOutOfMemoryError(env, 0);
+            return NULL;
+        }
+        rv = (*ckpFunctions->C_Sign)(ckSessionHandle, ckpData, ckDataLength,
+            bufP, &ckSignatureLength);
+    }
+
+    if (ckAssertReturnValueOK(env, rv) == CK_ASSERT_OK) {
+        jSignature = ckByteArrayToJByteArray(env, bufP, ckSignatureLength);
+        TRACE1("DEBUG C_Sign: signature length = %lu\n", ckSignatureLength);
+    }
+
+    if (bufP != BUF) { free(bufP); }
+    return jSignature;
+}
+#endif
+
 #ifdef P11_ENABLE_C_SIGN
 /*
  * Class:     sun_security_pkcs11_wrapper_PKCS11
@@ -112,11 +157,7 @@ JNIEXPORT jbyteArray JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Sign
     CK_SESSION_HANDLE ckSessionHandle;
     CK_BYTE_PTR ckpData = NULL_PTR;
     CK_ULONG ckDataLength;
-    CK_BYTE_PTR bufP;
-    CK_ULONG ckSignatureLength;
-    CK_BYTE BUF[MAX_STACK_BUFFER_LEN];
     jbyteArray jSignature = NULL;
-    CK_RV rv;
 
     CK_FUNCTION_LIST_PTR ckpFunctions = getFunctionList(env, obj);
     if (ckpFunctions == NULL) { return NULL; }
@@ -131,36 +172,97 @@ JNIEXPORT jbyteArray JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Sign
 
     TRACE1("DEBUG C_Sign: data length = %lu\n", ckDataLength);
 
-    // unknown signature length
-    bufP = BUF;
-    ckSignatureLength = MAX_STACK_BUFFER_LEN;
+    jSignature = signData(env, ckpFunctions, ckSessionHandle, ckpData,
+        ckDataLength);
 
-    rv = (*ckpFunctions->C_Sign)(ckSessionHandle, ckpData, ckDataLength,
-        bufP, &ckSignatureLength);
+    free(ckpData);
 
-    TRACE1("DEBUG C_Sign: ret rv=0x%lX\n", rv);
+    TRACE0("FINISHED\n");
+    return jSignature;
+}
+#endif
 
-    if (rv == CKR_BUFFER_TOO_SMALL) {
-        bufP = (CK_BYTE_PTR) malloc(ckSignatureLength);
-        if (bufP == NULL) {
-            p11ThrowOutOfMemoryError(env, 0);
-            goto cleanup;
-        }
-        rv = (*ckpFunctions->C_Sign)(ckSessionHandle, ckpData, ckDataLength,
-            bufP, &ckSignatureLength);
-    }
+#ifdef P11_ENABLE_SIGNBATCH
+/*
+ * Signs each of the data arrays in a single-part signing operation, i.e.
+ * C_SignInit followed by C_Sign, so that signing many small messages does
+ * not need two JNI calls per message. Stops at the first failure.
+ *
+ * Class:     sun_security_pkcs11_wrapper_PKCS11
+ * Method:    signBatch
+ * Signature: (JLsun/security/pkcs11/wrapper/CK_MECHANISM;J[[B)[[B
+ * Parametermapping:                    *PKCS11*
+ * @param   jlong jSessionHandle        CK_SESSION_HANDLE hSession
+ * @param   jobject jMechanism          CK_MECHANISM_PTR pMechanism
+ * @param   jlong jKeyHandle            CK_OBJECT_HANDLE hKey
+ * @param   jobjectArray jDataArray     CK_BYTE_PTR pData, CK_ULONG ulDataLen
+ *                                      of each operation
+ * @return  jobjectArray jSignatures    CK_BYTE_PTR pSignature,
+ *                                      CK_ULONG_PTR pulSignatureLen
+ *                                      of each operation
+ */
+JNIEXPORT jobjectArray JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_signBatch
+    (JNIEnv *env, jobject obj, jlong jSessionHandle, jobject jMechanism,
+    jlong jKeyHandle, jobjectArray jDataArray)
+{
+    CK_SESSION_HANDLE ckSessionHandle;
+    CK_MECHANISM_PTR ckpMechanism = NULL;
+    CK_OBJECT_HANDLE ckKeyHandle;
+    CK_BYTE_PTR ckpData;
+    CK_ULONG ckDataLength;
+    jclass jByteArrayClass;
+    jobjectArray jSignatures = NULL;
+    jbyteArray jData, jSignature;
+    jsize i, count;
+    CK_RV rv;
 
-    if (ckAssertReturnValueOK(env, rv) == CK_ASSERT_OK) {
-        jSignature = ckByteArrayToJByteArray(env, bufP, ckSignatureLength);
-        TRACE1("DEBUG C_Sign: signature length = %lu\n", ckSignatureLength);
+    CK_FUNCTION_LIST_PTR ckpFunctions = getFunctionList(env, obj);
+    if (ckpFunctions == NULL) { return NULL; }
+
+    TRACE0("DEBUG: signBatch\n");
+
+    ckSessionHandle = jLongToCKULong(jSessionHandle);
+    ckKeyHandle = jLongToCKULong(jKeyHandle);
+
+    count = (*env)->GetArrayLength(env, jDataArray);
+    jByteArrayClass = (*env)->FindClass(env, "[B");
+    if (jByteArrayClass == NULL) { return NULL; }
+    jSignatures = (*env)->NewObjectArray(env, count, jByteArrayClass, NULL);
+    if (jSignatures == NULL) { return NULL; }
+
+    // the mechanism is converted once and used by all operations
+    ckpMechanism = jMechanismToCKMechanismPtr(env, jMechanism);
+    if ((*env)->ExceptionCheck(env)) { return NULL; }
+
+    for (i = 0; i < count; i++) {
+        jData = (jbyteArray) (*env)->GetObjectArrayElement(env, jDataArray, i);
+        if ((*env)->ExceptionCheck(env)) { break; }
+        ckpData = NULL_PTR;
+        jByteArrayToCKByteArray(env, jData, &ckpData, &ckDataLength);
+        (*env)->DeleteLocalRef(env, jData);
+        if ((*env)->ExceptionCheck(env)) { break; }
+
+        rv = (*ckpFunctions->C_SignInit)(ckSessionHandle, ckpMechanism,
+            ckKeyHandle);
+        if (ckAssertReturnValueOK(env, rv) != CK_ASSERT_OK) {
+            free(ckpData);
+            break;
+        }
+        jSignature = signData(env, ckpFunctions, ckSessionHandle, ckpData,
+            ckDataLength);
+        free(ckpData);
+        if (jSignature == NULL) { break; }
+
+        (*env)->SetObjectArrayElement(env, jSignatures, i, jSignature);
+        (*env)->DeleteLocalRef(env, jSignature);
+        if ((*env)->ExceptionCheck(env)) { break; }
     }
 
-cleanup:
-    free(ckpData);
-    if (bufP != BUF) { free(bufP); }
+    TRACE1("DEBUG signBatch: freed pMech = %p\n", ckpMechanism);
+    freeCKMechanismPtr(ckpMechanism);
 
     TRACE0("FINISHED\n");
-    return jSignature;
+    return (*env)->ExceptionCheck(env) ? NULL : jSignatures;
 }
 #endif
 
@@ -163,6 +163,7 @@
 #undef  P11_ENABLE_C_WAITFORSLOTEVENT
 #define P11_ENABLE_GETNATIVEKEYINFO
 #define P11_ENABLE_CREATENATIVEKEY
+#define P11_ENABLE_SIGNBATCH
 
 
 /* include the platform dependent part of the header */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2003, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2003, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -30,6 +30,8 @@
 #include <stddef.h>
 #include <elf.h>
 #include <link.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "libproc_impl.h"
 #include "ps_core_common.h"
 #include "proc_service.h"
@@ -124,7 +126,11 @@ static bool core_read_data(struct ps_prochandle* ph, uintptr_t addr, char *buf,
       len = MIN(resid, mp->memsz - mapoff);
       off = mp->offset + mapoff;
 
-      if ((len = pread(fd, buf, len, off)) <= 0) {
+      if (fd == ph->core->core_fd && ph->core->core_addr != NULL &&
+          off >= 0 && (size_t)off + len <= ph->core->core_size) {
+         // the core file is mapped, copy from the mapping.
+         memcpy(buf, ph->core->core_addr + off, len);
+      } else if ((len = pread(fd, buf, len, off)) <= 0) {
          break;
       }
 
@@ -724,6 +730,29 @@ static bool read_shared_lib_info(struct ps_prochandle* ph) {
   return true;
 }
 
+// Map the whole core file read-only, so that reading the debuggee memory
+// saved in it is a memcpy rather than a pread system call per request.
+// Not being able to map the core file (e.g. a large core in a 32-bit
+// address space) is not an error, we fall back to pread then.
+static void map_core_file(struct ps_prochandle* ph) {
+  struct stat st;
+  void* addr;
+
+  if (fstat(ph->core->core_fd, &st) != 0 || st.st_size <= 0 ||
+      (unsigned long long) st.st_size > (unsigned long long) SIZE_MAX) {
+    return;
+  }
+
+  addr = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, ph->core->core_fd, 0);
+  if (addr == MAP_FAILED) {
+    print_debug("can't mmap core file, reading it with pread\n");
+    return;
+  }
+
+  ph->core->core_addr = (char*) addr;
+  ph->core->core_size = (size_t) st.st_size;
+}
+
 // the one and only one exposed stuff from this file
 JNIEXPORT struct ps_prochandle* JNICALL
 Pgrab_core(const char* exec_file, const char* core_file) {
@@ -760,6 +789,8 @@ Pgrab_core(const char* exec_file, const char* core_file) {
     goto err;
   }
 
+  map_core_file(ph);
+
   if ((ph->core->exec_fd = open(exec_file, O_RDONLY)) < 0) {
     print_debug("can't open executable file\n");
     goto err;
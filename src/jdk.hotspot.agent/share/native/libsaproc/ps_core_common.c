@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2019, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -31,6 +31,7 @@
 #ifdef LINUX
 #include <elf.h>
 #include <link.h>
+#include <sys/mman.h>
 #include "proc_service.h"
 #include "salibelf.h"
 #endif
@@ -62,6 +63,12 @@
 static void close_files(struct ps_prochandle* ph) {
   lib_info* lib = NULL;
 
+#ifdef LINUX
+  // unmap core file
+  if (ph->core->core_addr != NULL)
+    munmap(ph->core->core_addr, ph->core->core_size);
+#endif
+
   // close core file descriptor
   if (ph->core->core_fd >= 0)
     close(ph->core->core_fd);
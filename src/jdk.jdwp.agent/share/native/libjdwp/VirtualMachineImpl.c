@@ -33,6 +33,7 @@
 #include "threadControl.h"
 #include "SDE.h"
 #include "FrameID.h"
+#include "classTrack.h"
 
 static char *versionName = "Java Debug Wire Protocol (Reference Implementation)";
 
@@ -92,6 +93,23 @@ version(PacketInputStream *in, PacketOutputStream *out)
     return JNI_TRUE;
 }
 
+/*
+ * Get the signatures of a class, from the class tracking cache if the
+ * class is already tracked. If *pallocated is set on return, the strings
+ * were allocated and must be freed by the caller.
+ */
+static jvmtiError
+trackedClassSignature(jclass clazz, char **psignature, char **pgeneric_signature,
+                      jboolean *pallocated)
+{
+    if (classTrack_getSignature(clazz, psignature, pgeneric_signature)) {
+        *pallocated = JNI_FALSE;
+        return JVMTI_ERROR_NONE;
+    }
+    *pallocated = JNI_TRUE;
+    return classSignature(clazz, psignature, pgeneric_signature);
+}
+
 static jboolean
 classesForSignature(PacketInputStream *in, PacketOutputStream *out)
 {
@@ -132,6 +150,7 @@ classesForSignature(PacketInputStream *in, PacketOutputStream *out)
                 jclass clazz = theClasses[i];
                 jint status = classStatus(clazz);
                 char *candidate_signature = NULL;
+                jboolean allocated;
                 jint wanted =
                     (JVMTI_CLASS_STATUS_PREPARED|JVMTI_CLASS_STATUS_ARRAY|
                      JVMTI_CLASS_STATUS_PRIMITIVE);
@@ -141,7 +160,7 @@ classesForSignature(PacketInputStream *in, PacketOutputStream *out)
                     continue;
                 }
 
-                error = classSignature(clazz, &candidate_signature, NULL);
+                error = trackedClassSignature(clazz, &candidate_signature, NULL, &allocated);
                 if (error != JVMTI_ERROR_NONE) {
                   // Clazz become invalid since the time we get the class list
                   // Skip this entry
@@ -160,7 +179,9 @@ classesForSignature(PacketInputStream *in, PacketOutputStream *out)
                     theClasses[i] = theClasses[matchCount];
                     theClasses[matchCount++] = clazz;
                 }
-                jvmtiDeallocate(candidate_signature);
+                if (allocated) {
+                    jvmtiDeallocate(candidate_signature);
+                }
             }
 
             /* At this point matching prepared classes occupy
@@ -287,9 +308,10 @@ allClasses1(PacketInputStream *in, PacketOutputStream *out, int outputGenerics)
                 jclass clazz = theClasses[writtenCount];
                 jint status = classStatus(clazz);
                 jbyte tag = referenceTypeTag(clazz);
+                jboolean allocated;
                 jvmtiError error;
 
-                error = classSignature(clazz, &signature, &genericSignature);
+                error = trackedClassSignature(clazz, &signature, &genericSignature, &allocated);
                 if (error != JVMTI_ERROR_NONE) {
                     outStream_setError(out, map2jdwpError(error));
                     break;
@@ -303,9 +325,11 @@ allClasses1(PacketInputStream *in, PacketOutputStream *out, int outputGenerics)
                 }
 
                 (void)outStream_writeInt(out, map2jdwpClassStatus(status));
-                jvmtiDeallocate(signature);
-                if (genericSignature != NULL) {
-                  jvmtiDeallocate(genericSignature);
+                if (allocated) {
+                    jvmtiDeallocate(signature);
+                    if (genericSignature != NULL) {
+                      jvmtiDeallocate(genericSignature);
+                    }
                 }
 
                 /* No point in continuing if there's an error */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2001, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2001, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -28,6 +28,9 @@
  * be able to report which have been unloaded. On VM start-up
  * and whenever new classes are loaded, all prepared classes'
  * signatures are attached as JVMTI tag to the class object.
+ * The tag points to a single allocation holding the signature
+ * followed by the generic signature, so that the signatures of
+ * prepared classes can be looked up without asking JVMTI again.
  * Class unloading is tracked by registering
  * ObjectFree callback on class objects. When this happens, we find
  * the signature of the unloaded class(es) and report them back
@@ -83,6 +86,27 @@ is_wrong_phase(jvmtiError error)
 }
 
 
+/*
+ * Copy the signature and generic signature of a class to a single
+ * allocation. Both strings are NUL terminated; an empty generic
+ * signature means that the class has none.
+ */
+static char *
+createSignatures(char *signature, char *genericSignature)
+{
+    size_t sigLen = strlen(signature) + 1;
+    size_t genLen = genericSignature == NULL ? 1 : strlen(genericSignature) + 1;
+    char *signatures = jvmtiAllocate((jint)(sigLen + genLen));
+
+    (void)memcpy(signatures, signature, sigLen);
+    if (genericSignature == NULL) {
+        signatures[sigLen] = '\0';
+    } else {
+        (void)memcpy(signatures + sigLen, genericSignature, genLen);
+    }
+    return signatures;
+}
+
 /*
  * Add a class to the prepared class hash table.
  */
@@ -92,13 +116,18 @@ addPreparedClass(JNIEnv *env, jclass klass)
     jvmtiError error;
 
     char* signature;
-    error = classSignature(klass, &signature, NULL);
+    char* genericSignature;
+    char* signatures;
+    error = classSignature(klass, &signature, &genericSignature);
     if (is_wrong_phase(error)) {
         return;
     }
     if (error != JVMTI_ERROR_NONE) {
         EXIT_ERROR(error,"signature");
     }
+    signatures = createSignatures(signature, genericSignature);
+    jvmtiDeallocate(signature);
+    jvmtiDeallocate(genericSignature);
 
     if (gdata->assertOn) {
         // Check if already tagged.
@@ -112,23 +141,51 @@ addPreparedClass(JNIEnv *env, jclass klass)
         }
         if (tag != NOT_TAGGED) {
             // If tagged, the old tag better be the same as the new.
-            char* oldSignature = (char*)jlong_to_ptr(tag);
-            JDI_ASSERT(strcmp(signature, oldSignature) == 0);
-            jvmtiDeallocate(signature);
+            char* oldSignatures = (char*)jlong_to_ptr(tag);
+            JDI_ASSERT(strcmp(signatures, oldSignatures) == 0);
+            jvmtiDeallocate(signatures);
             return;
         }
     }
 
-    error = JVMTI_FUNC_PTR(trackingEnv, SetTag)(trackingEnv, klass, ptr_to_jlong(signature));
+    error = JVMTI_FUNC_PTR(trackingEnv, SetTag)(trackingEnv, klass, ptr_to_jlong(signatures));
     if (is_wrong_phase(error)) {
         return;
     }
     if (error != JVMTI_ERROR_NONE) {
-        jvmtiDeallocate(signature);
+        jvmtiDeallocate(signatures);
         EXIT_ERROR(error,"SetTag");
     }
 }
 
+/*
+ * Look up the signatures of a prepared class. The returned strings
+ * belong to the class tracking and stay valid as long as the caller
+ * holds a reference to the class; they must not be freed.
+ */
+jboolean
+classTrack_getSignature(jclass klass, char **psignature, char **pgeneric_signature)
+{
+    jvmtiError error;
+    jlong tag;
+    char *signature;
+
+    error = JVMTI_FUNC_PTR(trackingEnv, GetTag)(trackingEnv, klass, &tag);
+    if (error != JVMTI_ERROR_NONE || tag == NOT_TAGGED) {
+        return JNI_FALSE;
+    }
+
+    signature = (char*)jlong_to_ptr(tag);
+    if (psignature != NULL) {
+        *psignature = signature;
+    }
+    if (pgeneric_signature != NULL) {
+        char *genericSignature = signature + strlen(signature) + 1;
+        *pgeneric_signature = (*genericSignature == '\0') ? NULL : genericSignature;
+    }
+    return JNI_TRUE;
+}
+
 static jboolean
 setupEvents()
 {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2001, 2004, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2001, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -39,6 +39,14 @@ classTrack_processUnloads(JNIEnv *env);
 void
 classTrack_initialize(JNIEnv *env);
 
+/*
+ * Look up the cached signature and generic signature of a prepared
+ * class. Returns JNI_FALSE if the class is not tracked (yet). The
+ * returned strings must not be freed.
+ */
+jboolean
+classTrack_getSignature(jclass klass, char **psignature, char **pgeneric_signature);
+
 /*
  * Activates class tracking.
  */
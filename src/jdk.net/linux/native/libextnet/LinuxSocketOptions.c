@@ -39,6 +39,10 @@
 #define SO_INCOMING_NAPI_ID    56
 #endif
 
+#ifndef SO_BUSY_POLL
+#define SO_BUSY_POLL           46
+#endif
+
 static void handleError(JNIEnv *env, jint rv, const char *errmsg) {
     if (rv < 0) {
         if (errno == ENOPROTOOPT) {
@@ -250,6 +254,41 @@ JNIEXPORT jint JNICALL Java_jdk_net_LinuxSocketOptions_getIncomingNapiId0
     return optval;
 }
 
+/*
+ * Class:     jdk_net_LinuxSocketOptions
+ * Method:    busyPollSupported0
+ * Signature: ()Z;
+ */
+JNIEXPORT jboolean JNICALL Java_jdk_net_LinuxSocketOptions_busyPollSupported0
+(JNIEnv *env, jobject unused) {
+    return socketOptionSupported(SOL_SOCKET, SO_BUSY_POLL);
+}
+
+/*
+ * Class:     jdk_net_LinuxSocketOptions
+ * Method:    setBusyPoll0
+ * Signature: (II)V
+ */
+JNIEXPORT void JNICALL Java_jdk_net_LinuxSocketOptions_setBusyPoll0
+(JNIEnv *env, jobject unused, jint fd, jint optval) {
+    jint rv = setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &optval, sizeof (optval));
+    handleError(env, rv, "set option SO_BUSY_POLL failed");
+}
+
+/*
+ * Class:     jdk_net_LinuxSocketOptions
+ * Method:    getBusyPoll0
+ * Signature: (I)I;
+ */
+JNIEXPORT jint JNICALL Java_jdk_net_LinuxSocketOptions_getBusyPoll0
+(JNIEnv *env, jobject unused, jint fd) {
+    jint optval, rv;
+    socklen_t sz = sizeof (optval);
+    rv = getsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &optval, &sz);
+    handleError(env, rv, "get option SO_BUSY_POLL failed");
+    return optval;
+}
+
 /*
  * Class:     jdk_net_LinuxSocketOptions
  * Method:    setIpDontFragment0
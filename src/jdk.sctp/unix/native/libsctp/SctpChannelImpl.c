@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2009, 2021, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2009, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -53,6 +53,28 @@ struct controlData {
     unsigned int ppid;
 };
 
+#ifdef __linux__
+// Maximum number of messages per batch
+#define MAX_BATCH 64
+
+// Flags of a batch entry
+#define BATCH_EOR           0x1 // the slot ends a message or notification
+#define BATCH_UNORDERED     0x2
+#define BATCH_NOTIFICATION  0x4 // the slot holds (part of) a notification
+
+// Per message entry of the batch metadata buffer. The messages themselves
+// are in consecutive slots of the data buffer.
+typedef struct {
+    jint length;        // bytes received into the slot
+    jint flags;         // BATCH_* flags
+    jint assocId;
+    jint streamNumber;
+    jint ppid;
+    jint addressLength;
+    SOCKETADDRESS address;
+} batch_entry_t;
+#endif
+
 static jclass    smi_class;    /* sun.nio.ch.sctp.MessageInfoImpl            */
 static jmethodID smi_ctrID;    /* sun.nio.ch.sctp.MessageInfoImpl.<init>     */
 static jfieldID  src_valueID;  /* sun.nio.ch.sctp.ResultContainer.value      */
@@ -516,6 +538,135 @@ JNIEXPORT jint JNICALL Java_sun_nio_ch_sctp_SctpChannelImpl_receive0
     return rv;
 }
 
+#ifdef __linux__
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_sctp_SctpChannelImpl_batchEntrySize0(JNIEnv *env, jclass klass)
+{
+    return sizeof(batch_entry_t);
+}
+
+/*
+ * Receives up to count messages with one recvmmsg call. Message i is
+ * received into the slot at address + i * slotSize, and its length, flags,
+ * SCTP_SNDRCV information and sender are stored into entry i of the
+ * metadata buffer at entriesAddress. A message larger than a slot spans
+ * several entries, all but the last without BATCH_EOR.
+ *
+ * Notifications are left as they are in their slot, with BATCH_NOTIFICATION
+ * set, so that none of the messages received after them are lost; they are
+ * converted with notification0. A notification that does not fit in its
+ * slot (a SEND_FAILED notification with a large undelivered message)
+ * continues in the following entries, up to the one with BATCH_EOR, which
+ * must be skipped. Returns the number of entries received.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_sctp_SctpChannelImpl_receiveBatch0(JNIEnv *env, jclass klass,
+                                                   jint fd, jlong address,
+                                                   jint slotSize, jint count,
+                                                   jlong entriesAddress)
+{
+    char *buf = (char *)jlong_to_ptr(address);
+    batch_entry_t *entries = (batch_entry_t *)jlong_to_ptr(entriesAddress);
+    struct mmsghdr msgs[MAX_BATCH];
+    struct iovec iovs[MAX_BATCH];
+    char control[MAX_BATCH][CMSG_SPACE(sizeof (struct sctp_sndrcvinfo))];
+    int i, n;
+
+    if (slotSize < SCTP_NOTIFICATION_SIZE) {
+        JNU_ThrowIllegalArgumentException(env, "slot too small");
+        return IOS_THROWN;
+    }
+    if (count > MAX_BATCH) {
+        count = MAX_BATCH;
+    }
+
+    memset(msgs, 0, sizeof(struct mmsghdr) * count);
+    for (i = 0; i < count; i++) {
+        iovs[i].iov_base = buf + (size_t)i * slotSize;
+        iovs[i].iov_len = slotSize;
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_name = &entries[i].address;
+        msgs[i].msg_hdr.msg_namelen = sizeof(SOCKETADDRESS);
+        msgs[i].msg_hdr.msg_control = control[i];
+        msgs[i].msg_hdr.msg_controllen = sizeof(control[i]);
+    }
+
+    // MSG_WAITFORONE: only block for the first message, then take
+    // whatever else is queued
+    n = recvmmsg(fd, msgs, count, MSG_WAITFORONE, NULL);
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return IOS_UNAVAILABLE;
+        } else if (errno == EINTR) {
+            return IOS_INTERRUPTED;
+        } else if (errno == ENOTCONN) {
+            /* ENOTCONN when EOF reached */
+            return IOS_EOF;
+        }
+        sctpHandleSocketError(env, errno);
+        return IOS_THROWN;
+    }
+
+    for (i = 0; i < n; i++) {
+        struct msghdr *msg = &msgs[i].msg_hdr;
+        batch_entry_t *entry = &entries[i];
+        entry->length = msgs[i].msg_len;
+        entry->flags = 0;
+        entry->addressLength = msg->msg_namelen;
+        if (msg->msg_flags & MSG_EOR) {
+            entry->flags |= BATCH_EOR;
+        }
+        if (msg->msg_flags & MSG_NOTIFICATION) {
+            entry->flags |= BATCH_NOTIFICATION;
+            entry->assocId = 0;
+            entry->streamNumber = 0;
+            entry->ppid = 0;
+        } else {
+            struct controlData cdata[1];
+            memset(cdata, 0, sizeof (*cdata));
+            getControlData(msg, cdata);
+            entry->assocId = cdata->assocId;
+            entry->streamNumber = cdata->streamNumber;
+            entry->ppid = cdata->ppid;
+            if (cdata->unordered == JNI_TRUE) {
+                entry->flags |= BATCH_UNORDERED;
+            }
+        }
+    }
+    return n;
+}
+
+/*
+ * Converts the notification received by receiveBatch0 into the slot at
+ * address, as described by the batch entry at entryAddress, and sets it
+ * in the result container. The undelivered message of a SEND_FAILED
+ * notification that did not fit in the slot is truncated to the part in
+ * the slot. Returns JNI_TRUE if the notification is of interest to the
+ * Java API.
+ */
+JNIEXPORT jboolean JNICALL
+Java_sun_nio_ch_sctp_SctpChannelImpl_notification0(JNIEnv *env, jclass klass,
+                                                   jobject resultContainerObj,
+                                                   jlong address,
+                                                   jlong entryAddress)
+{
+    union sctp_notification *snp =
+        (union sctp_notification *)jlong_to_ptr(address);
+    batch_entry_t *entry = (batch_entry_t *)jlong_to_ptr(entryAddress);
+    jboolean isEOR = (entry->flags & BATCH_EOR) ? JNI_TRUE : JNI_FALSE;
+
+    if (snp->sn_header.sn_type == SCTP_SEND_FAILED && isEOR == JNI_FALSE) {
+        // the rest is in the following entries, don't read it from the socket
+        snp->sn_send_failed.ssf_length = entry->length;
+    }
+    return handleNotification(env, -1, resultContainerObj, snp, entry->length,
+                              isEOR, &entry->address.sa);
+}
+
+#endif /* __linux__ */
+
 /*
  * Class:     sun_nio_ch_sctp_SctpChannelImpl
  * Method:    send0
@@ -146,3 +146,29 @@ TEST_VM(G1Predictions, lower_bound_zero_predictions) {
   }
   ASSERT_NEAR(predictor.predict_zero_bounded(&s), 0.0, epsilon);
 }
+
+// Check that a prediction percentile makes predictions follow spikes in
+// the samples, while not changing predictions below that percentile.
+TEST_VM(G1Predictions, percentile_predictions) {
+  G1Predictions avg_predictor(0.5);
+  G1Predictions p90_predictor(0.5, 90.0);
+  G1Predictions p100_predictor(0.5, 100.0);
+  TruncatedSeq s;
+
+  s.add(20.0);
+  for (int i = 0; i < 3; i++) {
+    s.add(1.0);
+  }
+  ASSERT_NEAR(p100_predictor.predict(&s), avg_predictor.predict(&s), epsilon)
+    << "Small sample sets must use the average based prediction";
+
+  for (int i = 0; i < 6; i++) {
+    s.add(1.0);
+  }
+  ASSERT_NEAR(s.percentile(90.0), 1.0, epsilon);
+  ASSERT_NEAR(s.percentile(100.0), 20.0, epsilon);
+
+  ASSERT_LT(avg_predictor.predict(&s), 20.0);
+  ASSERT_NEAR(p90_predictor.predict(&s), avg_predictor.predict(&s), epsilon);
+  ASSERT_NEAR(p100_predictor.predict(&s), 20.0, epsilon);
+}
@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 #include "gc/shared/oopStorage.inline.hpp"
 #include "gc/shared/oopStorageParState.inline.hpp"
+#include "gc/shared/oopStorageThreadCache.hpp"
 #include "gc/shared/workerThread.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/resourceArea.hpp"
@@ -518,6 +519,40 @@ TEST_VM_F(OopStorageTest, bulk_allocation) {
   }
 }
 
+TEST_VM_F(OopStorageTest, thread_cache_allocation) {
+  storage().enable_thread_local_caching();
+  OopStorageThreadCache* cache = Thread::current()->oop_storage_cache();
+
+  oop* ptr1 = storage().allocate();
+  ASSERT_TRUE(ptr1 != nullptr);
+  EXPECT_EQ(1u, storage().allocation_count());
+  EXPECT_EQ(1u, storage().block_count());
+  // The block holds the handed out entry plus the rest of the refill.
+  size_t cached = total_allocation_count(storage());
+  EXPECT_LT(1u, cached);
+
+  // Allocations are served from the cache without claiming more entries.
+  oop* ptr2 = storage().allocate();
+  ASSERT_TRUE(ptr2 != nullptr);
+  EXPECT_NE(ptr1, ptr2);
+  EXPECT_EQ(2u, storage().allocation_count());
+  EXPECT_EQ(cached, total_allocation_count(storage()));
+
+  // Releases go back to the cache, leaving the entries allocated.
+  release_entry(storage(), ptr1);
+  release_entry(storage(), ptr2);
+  EXPECT_EQ(0u, storage().allocation_count());
+  EXPECT_EQ(cached, total_allocation_count(storage()));
+  EXPECT_EQ(OopStorage::ALLOCATED_ENTRY, storage().allocation_status(ptr1));
+
+  // Flushing releases the cached entries to the block.
+  cache->flush();
+  EXPECT_EQ(0u, total_allocation_count(storage()));
+  EXPECT_EQ(OopStorage::UNALLOCATED_ENTRY, storage().allocation_status(ptr1));
+  EXPECT_EQ(OopStorage::UNALLOCATED_ENTRY, storage().allocation_status(ptr2));
+  EXPECT_EQ(1u, empty_block_count(storage()));
+}
+
 #ifndef DISABLE_GARBAGE_ALLOCATION_STATUS_TESTS
 TEST_VM_F(OopStorageTest, invalid_pointer) {
   {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2020, 2024, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -23,8 +23,10 @@
  */
 
 #include "precompiled.hpp"
+#include "gc/shared/gc_globals.hpp"
 #include "gc/shared/partialArrayTaskStepper.inline.hpp"
 #include "memory/allStatic.hpp"
+#include "runtime/flags/flagSetting.hpp"
 #include "unittest.hpp"
 
 using Step = PartialArrayTaskStepper::Step;
@@ -85,3 +87,21 @@ TEST(PartialArrayTaskStepperTest, doit) {
     }
   }
 }
+
+TEST_VM(PartialArrayTaskStepperTest, adaptive_chunk_size) {
+  FlagSetting fs(UseAdaptiveArrayScanChunk, true);
+  const int min_chunk_size = 50;
+  for (uint n_workers = 1; n_workers <= 256; n_workers = (n_workers * 3 / 2 + 1)) {
+    const PartialArrayTaskStepper stepper(n_workers);
+    const int target_chunks = (int)(n_workers * ArrayScanChunksPerWorker);
+    for (int length = 0; length <= 10000000; length = (length * 2 + 1)) {
+      const int chunk_size = stepper.chunk_size(length, min_chunk_size);
+      ASSERT_GE(chunk_size, min_chunk_size);
+      if (chunk_size > min_chunk_size) {
+        ASSERT_GE(length / chunk_size, target_chunks);
+        ASSERT_LT(length / chunk_size, 2 * target_chunks);
+      }
+      run_test(length, chunk_size, n_workers);
+    }
+  }
+}
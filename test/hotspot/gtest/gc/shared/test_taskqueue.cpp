@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/gc_globals.hpp"
+#include "gc/shared/taskqueue.inline.hpp"
+#include "runtime/flags/flagSetting.hpp"
+#include "unittest.hpp"
+
+typedef GenericTaskQueue<size_t, mtGC, 64> TestTaskQueue;
+typedef GenericTaskQueueSet<TestTaskQueue, mtGC> TestTaskQueueSet;
+
+class TaskQueueStealTest : public ::testing::Test {
+protected:
+  TestTaskQueue _queue0;
+  TestTaskQueue _queue1;
+  TestTaskQueueSet _set;
+
+  TaskQueueStealTest() : _queue0(), _queue1(), _set(2) {
+    _set.register_queue(0, &_queue0);
+    _set.register_queue(1, &_queue1);
+  }
+
+  void fill(TestTaskQueue* queue, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+      ASSERT_TRUE(queue->push(i));
+    }
+  }
+
+  void drain(TestTaskQueue* queue) {
+    size_t t;
+    while (queue->pop_local(t)) { }
+  }
+};
+
+TEST_VM_F(TaskQueueStealTest, steal_takes_one) {
+  fill(&_queue0, 10);
+
+  size_t t;
+  ASSERT_TRUE(_set.steal(1, t));
+  // Steals take the oldest element.
+  EXPECT_EQ(0u, t);
+  EXPECT_EQ(9u, _queue0.size());
+  EXPECT_EQ(0u, _queue1.size());
+
+  drain(&_queue0);
+}
+
+TEST_VM_F(TaskQueueStealTest, steal_batch_takes_half) {
+  fill(&_queue0, 10);
+
+  size_t t;
+  ASSERT_TRUE(_set.steal_batch(1, t));
+  EXPECT_EQ(0u, t);
+  // One element for t plus half of the victim's 10 elements.
+  uint expected = MIN2(WorkStealingBatchSize - 1, 5u);
+  EXPECT_EQ(expected, _queue1.size());
+  EXPECT_EQ(9u - expected, _queue0.size());
+
+  // The batch is moved in order, so the most recently pushed element
+  // of the stealing queue is the last one taken from the victim.
+  if (expected > 0) {
+    size_t local;
+    ASSERT_TRUE(_queue1.pop_local(local));
+    EXPECT_EQ(expected, local);
+  }
+
+  drain(&_queue0);
+  drain(&_queue1);
+}
+
+TEST_VM_F(TaskQueueStealTest, steal_batch_respects_free_space) {
+  fill(&_queue0, 40);
+  // Leave room for just two more elements in the stealing queue.
+  fill(&_queue1, _queue1.max_elems() - 2);
+
+  size_t t;
+  ASSERT_TRUE(_set.steal_batch(1, t));
+  EXPECT_EQ(_queue1.max_elems() - 2 + MIN2(WorkStealingBatchSize - 1, 2u), _queue1.size());
+
+  drain(&_queue0);
+  drain(&_queue1);
+}
+
+TEST_VM_F(TaskQueueStealTest, steal_empty) {
+  size_t t;
+  EXPECT_FALSE(_set.steal(1, t));
+  EXPECT_FALSE(_set.steal_batch(1, t));
+}
+
+TEST_VM(TaskQueueNumaStealTest, steal_finds_remote_work) {
+  FlagSetting fs(UseNUMAAwareStealing, true);
+
+  TestTaskQueue queues[4];
+  TestTaskQueueSet set(4);
+  for (uint i = 0; i < 4; i++) {
+    set.register_queue(i, &queues[i]);
+    set.set_numa_id(i, i % 2);
+  }
+
+  // Only a queue on another node has work; stealing must still find it.
+  ASSERT_TRUE(queues[1].push(42));
+
+  size_t t;
+  ASSERT_TRUE(set.steal(0, t));
+  EXPECT_EQ(42u, t);
+  EXPECT_FALSE(set.steal(0, t));
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "logTestFixture.hpp"
+#include "logTestUtils.inline.hpp"
+#include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
+#include "logging/logBinaryFormat.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/os.hpp"
+#include "unittest.hpp"
+#include "utilities/ostream.hpp"
+
+class LogBinaryFormatTest : public LogTestFixture {
+};
+
+TEST(LogBinaryFormat, varint) {
+  u1 buf[LogBinaryFormat::MaxVarintSize];
+  EXPECT_EQ(1u, LogBinaryFormat::put_varint(buf, 0));
+  EXPECT_EQ(1u, LogBinaryFormat::put_varint(buf, 127));
+  EXPECT_EQ(2u, LogBinaryFormat::put_varint(buf, 128));
+  EXPECT_EQ(0x80, buf[0]);
+  EXPECT_EQ(0x01, buf[1]);
+  EXPECT_EQ(LogBinaryFormat::MaxVarintSize, LogBinaryFormat::put_varint(buf, max_julong));
+
+  const int64_t values[] = { 0, 1, -1, 63, -64, max_jlong, min_jlong };
+  for (size_t i = 0; i < ARRAY_SIZE(values); i++) {
+    EXPECT_EQ(values[i], LogBinaryFormat::unzigzag(LogBinaryFormat::zigzag(values[i])));
+  }
+  EXPECT_EQ(1u, LogBinaryFormat::zigzag(-1));
+  EXPECT_EQ(2u, LogBinaryFormat::zigzag(1));
+}
+
+TEST_VM_F(LogBinaryFormatTest, round_trip) {
+  set_log_config(TestLogFileName, "logging=debug", "uptime,tid,level,tags", "format=binary");
+  log_debug(logging)("%s", LOG_TEST_STRING_LITERAL);
+  log_info(logging)("second line");
+  log_debug(logging)("first line\nof a multiline message");
+  AsyncLogWriter::flush();
+
+  EXPECT_FALSE(file_contains_substring(TestLogFileName, "[logging]"))
+    << "Decorations should not be written as text";
+
+  FILE* fp = os::fopen(TestLogFileName, "rb");
+  ASSERT_NE(nullptr, fp);
+  ResourceMark rm;
+  stringStream ss;
+  LogBinaryDecoder decoder(fp);
+  bool success = decoder.decode(&ss);
+  fclose(fp);
+  ASSERT_TRUE(success) << "Could not decode " << TestLogFileName;
+
+  const char* decoded = ss.as_string();
+  EXPECT_TRUE(string_contains_substring(decoded, "][debug][logging] " LOG_TEST_STRING_LITERAL "\n")) << decoded;
+  EXPECT_TRUE(string_contains_substring(decoded, "][info ][logging] second line\n")) << decoded;
+  EXPECT_TRUE(string_contains_substring(decoded, "first line\nof a multiline message\n")) << decoded;
+}
+
+TEST_VM_F(LogBinaryFormatTest, invalid_input) {
+  FILE* fp = os::fopen(TestLogFileName, "w+b");
+  ASSERT_NE(nullptr, fp);
+  fputs("[0.001s][info][logging] not a binary log\n", fp);
+  rewind(fp);
+  ResourceMark rm;
+  stringStream ss;
+  LogBinaryDecoder decoder(fp);
+  EXPECT_FALSE(decoder.decode(&ss));
+  fclose(fp);
+}
@@ -41,7 +41,9 @@ TEST_VM(LogFileOutput, parse_valid) {
     "filesize=256,filecount=11",
     "filesize=0", "filecount=1",
     "filesize=1m", "filesize=1M",
-    "filesize=1k", "filesize=1G"
+    "filesize=1k", "filesize=1G",
+    "format=text", "format=binary",
+    "filecount=3,format=binary"
   };
 
   // Override LogOutput's vm_start time to get predictable file name
@@ -75,7 +77,8 @@ TEST_VM(LogFileOutput, parse_invalid) {
     "filecount=ab", "filesize=0xz",
     "filecount=1MB", "filesize=99bytes",
     "filesize=9999999999999999999999999",
-    "filecount=9999999999999999999999999"
+    "filecount=9999999999999999999999999",
+    "format=", "format=xml"
   };
 
   for (size_t i = 0; i < ARRAY_SIZE(invalid_options); i++) {
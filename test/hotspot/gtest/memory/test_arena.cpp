@@ -382,3 +382,40 @@ TEST_VM(Arena, different_chunk_sizes) {
     Arena ar7(mtTest, Arena::Tag::tag_other, random_arena_chunk_size());
   }
 }
+
+static Chunk* new_test_chunk(size_t length) {
+  void* p = os::malloc(Chunk::aligned_overhead_size() + length, mtChunk);
+  return ::new (p) Chunk(length);
+}
+
+TEST_VM(Arena, thread_chunk_cache) {
+  const size_t other_size = 100 * K;
+  ThreadChunkCache cache(Chunk::size + 2 * other_size, false);
+
+  Chunk* c1 = new_test_chunk(Chunk::size);
+  Chunk* c2 = new_test_chunk(other_size);
+  Chunk* c3 = new_test_chunk(other_size * 3);
+  ASSERT_TRUE(cache.put(c1));
+  ASSERT_TRUE(cache.put(c2));
+  // The cache is bounded.
+  ASSERT_FALSE(cache.put(c3));
+  os::free(c3);
+  ASSERT_EQ(cache.cached_bytes(), (size_t)Chunk::size + other_size);
+
+  // Standard sizes only match exactly.
+  ASSERT_NULL(cache.take(Chunk::medium_size));
+  ASSERT_EQ(cache.take(Chunk::size), c1);
+  ASSERT_NULL(cache.take(Chunk::size));
+
+  // Other sizes match the smallest chunk which is long enough, but not excessively long.
+  ASSERT_NULL(cache.take(other_size / 4));
+  ASSERT_NULL(cache.take(other_size * 2));
+  ASSERT_EQ(cache.take(other_size - 8), c2);
+  ASSERT_EQ(cache.cached_bytes(), (size_t)0);
+
+  ASSERT_TRUE(cache.put(c1));
+  ASSERT_TRUE(cache.put(c2));
+  cache.clear();
+  ASSERT_EQ(cache.cached_bytes(), (size_t)0);
+  ASSERT_NULL(cache.take(Chunk::size));
+}
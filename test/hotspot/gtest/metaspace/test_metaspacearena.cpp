@@ -769,3 +769,52 @@ TEST_VM(metaspace, MetaspaceArena_test_repeatedly_allocate_and_deallocate_top_al
 TEST_VM(metaspace, MetaspaceArena_test_repeatedly_allocate_and_deallocate_nontop_allocation) {
   test_repeatedly_allocate_and_deallocate(false);
 }
+
+// Test that reclaiming free chunks gives back retired chunks whose allocations have all
+// been deallocated, and that the statistics predict the amount of memory given back.
+TEST_VM(metaspace, MetaspaceArena_reclaim_free_chunks) {
+  if (Settings::use_allocation_guard()) {
+    return;
+  }
+  MetaspaceGtestContext context;
+  MetaspaceArenaTestHelper helper(context, Metaspace::StandardMetaspaceType, false);
+
+  const size_t blocksize = 64;
+  const int max_blocks = 1024;
+  MetaWord* blocks[max_blocks];
+  int num_blocks = 0;
+  while (num_blocks < max_blocks && helper.get_number_of_chunks() < 4) {
+    helper.allocate_from_arena_with_tests_expect_success(&blocks[num_blocks], blocksize);
+    num_blocks++;
+  }
+  ASSERT_GE(helper.get_number_of_chunks(), 4);
+
+  // Nothing to reclaim as long as all allocations are alive.
+  ASSERT_0(helper.get_arena_statistics()._reclaimable_words);
+  ASSERT_0(helper.arena()->reclaim_free_chunks());
+
+  // Deallocate everything but the last allocation, which lives in the current chunk.
+  for (int i = 0; i < num_blocks - 1; i++) {
+    helper.deallocate_with_tests(blocks[i], blocksize);
+  }
+
+  const int chunks_before = helper.get_number_of_chunks();
+  const size_t reclaimable = helper.get_arena_statistics()._reclaimable_words;
+  size_t used1 = 0, committed1 = 0;
+  helper.usage_numbers_with_test(&used1, &committed1, nullptr);
+
+  const size_t reclaimed = helper.arena()->reclaim_free_chunks();
+  ASSERT_GT(reclaimed, (size_t)0);
+  ASSERT_EQ(reclaimed, reclaimable);
+  ASSERT_LT(helper.get_number_of_chunks(), chunks_before);
+
+  size_t used2 = 0, committed2 = 0;
+  helper.usage_numbers_with_test(&used2, &committed2, nullptr);
+  ASSERT_LT(used2, used1);
+  ASSERT_LT(committed2, committed1);
+  DEBUG_ONLY(helper.arena()->verify();)
+
+  // A second attempt finds nothing left to do, and the arena is still usable.
+  ASSERT_0(helper.arena()->reclaim_free_chunks());
+  helper.allocate_from_arena_with_tests_expect_success(blocksize);
+}
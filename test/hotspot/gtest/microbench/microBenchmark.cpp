@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/quickSort.hpp"
+#include "microBenchmark.hpp"
+
+int MicroBenchmark::int_from_env(const char* name, int default_value) {
+  const char* value = ::getenv(name);
+  if (value == nullptr) {
+    return default_value;
+  }
+  const int result = atoi(value);
+  return result > 0 ? result : default_value;
+}
+
+MicroBenchmark::MicroBenchmark(const char* name, size_t ops_per_batch) :
+  _name(name),
+  _ops_per_batch(ops_per_batch),
+  _warmup_batches(int_from_env("MICROBENCH_WARMUP", 10)),
+  _batches(int_from_env("MICROBENCH_BATCHES", 50)) {}
+
+int MicroBenchmark::max_threads(int max_threads) {
+  const int threads = int_from_env("MICROBENCH_THREADS", MIN2(os::processor_count(), 16));
+  return MIN2(threads, max_threads);
+}
+
+static int compare_samples(jlong a, jlong b) {
+  return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+// Nearest-rank percentile of the sorted samples.
+static jlong percentile(const jlong* sorted, int num_samples, int percent) {
+  const int rank = (int)(((jlong)num_samples * percent + 99) / 100);
+  return sorted[MAX2(rank, 1) - 1];
+}
+
+void MicroBenchmark::report(int nthreads, jlong* samples, int num_samples) const {
+  QuickSort::sort(samples, num_samples, compare_samples);
+
+  jlong total = 0;
+  for (int i = 0; i < num_samples; i++) {
+    total += samples[i];
+  }
+  // Times are per operation, the batch times divided by the batch size.
+  const double ops = (double)_ops_per_batch;
+  const double mean = (double)total / num_samples / ops;
+  const double p50 = percentile(samples, num_samples, 50) / ops;
+  const double p90 = percentile(samples, num_samples, 90) / ops;
+  const double p99 = percentile(samples, num_samples, 99) / ops;
+  const double max = samples[num_samples - 1] / ops;
+  // All threads run concurrently, so they together do nthreads operations
+  // in the mean time of one.
+  const double ops_per_sec = mean > 0.0 ? nthreads * (NANOSECS_PER_SEC / mean) : 0.0;
+
+  tty->print_cr("%-40s %2d threads: mean %9.2f p50 %9.2f p90 %9.2f p99 %9.2f max %9.2f ns/op, %14.0f ops/s",
+                _name, nthreads, mean, p50, p90, p99, max, ops_per_sec);
+
+  const char* json_file = ::getenv("MICROBENCH_JSON");
+  if (json_file != nullptr) {
+    fileStream out(json_file, "a");
+    if (out.is_open()) {
+      out.print_cr("{\"benchmark\": \"%s\", \"threads\": %d, \"ops_per_batch\": " SIZE_FORMAT ", "
+                   "\"batches\": %d, \"unit\": \"ns/op\", \"mean\": %.2f, \"p50\": %.2f, "
+                   "\"p90\": %.2f, \"p99\": %.2f, \"max\": %.2f, \"ops_per_sec\": %.0f}",
+                   _name, nthreads, _ops_per_batch, _batches, mean, p50, p90, p99, max, ops_per_sec);
+    } else {
+      tty->print_cr("Could not open %s", json_file);
+    }
+  }
+}
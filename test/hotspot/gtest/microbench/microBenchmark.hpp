@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef GTEST_MICROBENCH_MICROBENCHMARK_HPP
+#define GTEST_MICROBENCH_MICROBENCHMARK_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/os.hpp"
+#include "threadHelper.inline.hpp"
+
+// A small harness for native microbenchmarks of VM data structures.
+//
+// A benchmark is an operation op(thread, id, i) that is run ops_per_batch
+// times per batch by each of a number of threads, id being the index of the
+// thread. Every thread runs a number of warmup batches, waits for the others
+// and then times each of its measured batches. The batch times of all threads
+// are reported as mean, percentiles and throughput, for 1, 2, 4, ... threads.
+//
+// The benchmarks are disabled gtests of the MicroBench test case, so that
+// they are not run with the unit tests. Run them with
+//
+//   gtestLauncher -jdk <jdk> --gtest_also_run_disabled_tests --gtest_filter='MicroBench.*'
+//
+// The following environment variables configure the runs:
+//
+//   MICROBENCH_WARMUP   warmup batches per thread (default 10)
+//   MICROBENCH_BATCHES  measured batches per thread (default 50)
+//   MICROBENCH_THREADS  maximum number of threads (default: the number of
+//                       processors, at most 16)
+//   MICROBENCH_JSON     file to which a JSON object per result is appended,
+//                       one per line
+class MicroBenchmark : public StackObj {
+  const char* const _name;
+  const size_t _ops_per_batch;
+  const int _warmup_batches;
+  const int _batches;
+
+  static int int_from_env(const char* name, int default_value);
+
+  template<typename F>
+  void run_batch(F& op, Thread* thread, int id) const {
+    for (size_t i = 0; i < _ops_per_batch; i++) {
+      op(thread, id, i);
+    }
+  }
+
+  // Reports the batch times in samples, which it sorts.
+  void report(int nthreads, jlong* samples, int num_samples) const;
+
+public:
+  MicroBenchmark(const char* name, size_t ops_per_batch);
+
+  // The number of threads to run the benchmark with up to max_threads,
+  // limited by MICROBENCH_THREADS.
+  static int max_threads(int max_threads = INT_MAX);
+
+  // Runs and reports the benchmark with nthreads threads.
+  template<typename F>
+  void run(int nthreads, F op) const;
+
+  // Runs and reports the benchmark with 1, 2, 4, ... threads, up to
+  // max_threads(limit).
+  template<typename F>
+  void run_scaling(F op, int limit = INT_MAX) const {
+    const int max = max_threads(limit);
+    for (int nthreads = 1; nthreads <= max; nthreads *= 2) {
+      run(nthreads, op);
+    }
+  }
+};
+
+template<typename F>
+void MicroBenchmark::run(int nthreads, F op) const {
+  const int num_samples = nthreads * _batches;
+  jlong* const samples = NEW_C_HEAP_ARRAY(jlong, num_samples, mtTest);
+  volatile int arrived = 0;
+
+  auto body = [&](Thread* thread, int id) {
+    for (int b = 0; b < _warmup_batches; b++) {
+      run_batch(op, thread, id);
+    }
+    // Start measuring only when all threads are warmed up.
+    Atomic::inc(&arrived);
+    while (Atomic::load_acquire(&arrived) < nthreads) {
+      SpinPause();
+    }
+    for (int b = 0; b < _batches; b++) {
+      const jlong start = os::javaTimeNanos();
+      run_batch(op, thread, id);
+      samples[id * _batches + b] = os::javaTimeNanos() - start;
+    }
+  };
+  TestThreadGroup<decltype(body)> threads(body, nthreads);
+  threads.doit();
+  threads.join();
+
+  report(nthreads, samples, num_samples);
+  FREE_C_HEAP_ARRAY(jlong, samples);
+}
+
+#endif // GTEST_MICROBENCH_MICROBENCHMARK_HPP
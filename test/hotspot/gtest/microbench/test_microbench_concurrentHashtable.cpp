@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "runtime/os.hpp"
+#include "utilities/concurrentHashTable.inline.hpp"
+#include "microBenchmark.hpp"
+#include "unittest.hpp"
+
+struct MicroBenchCHTConfig : public AllStatic {
+  typedef uintptr_t Value;
+  static uintx get_hash(const Value& value, bool* dead_hash) {
+    return (uintx)value;
+  }
+  static void* allocate_node(void* context, size_t size, const Value& value) {
+    return os::malloc(size, mtTest);
+  }
+  static void free_node(void* context, void* memory, const Value& value) {
+    os::free(memory);
+  }
+};
+
+typedef ConcurrentHashTable<MicroBenchCHTConfig, mtInternal> MicroBenchCHT;
+
+struct MicroBenchCHTLookup {
+  uintptr_t _val;
+  MicroBenchCHTLookup(uintptr_t val) : _val(val) {}
+  uintx get_hash() const { return (uintx)_val; }
+  bool equals(const uintptr_t* value) { return _val == *value; }
+  bool is_dead(const uintptr_t* value) { return false; }
+};
+
+struct MicroBenchCHTFound {
+  uintptr_t _value;
+  MicroBenchCHTFound() : _value(0) {}
+  void operator()(const uintptr_t* value) { _value = *value; }
+};
+
+// The number of entries in the table, the table has the same number of buckets.
+const size_t ChtEntriesLog2 = 16;
+const size_t ChtEntries = (size_t)1 << ChtEntriesLog2;
+const size_t ChtOpsPerBatch = 10000;
+
+// Scatters the lookups of the operations over the whole table.
+static uintptr_t cht_key(int id, size_t i) {
+  return (uintptr_t)(((i + (size_t)id * 7919) * 2654435761u) % ChtEntries) + 1;
+}
+
+TEST_VM(MicroBench, DISABLED_concurrentHashtable_get) {
+  MicroBenchCHT table(ChtEntriesLog2, ChtEntriesLog2);
+  Thread* current = Thread::current();
+  for (uintptr_t v = 1; v <= ChtEntries; v++) {
+    MicroBenchCHTLookup lookup(v);
+    ASSERT_TRUE(table.insert(current, lookup, v));
+  }
+
+  MicroBenchmark bench("ConcurrentHashTable.get", ChtOpsPerBatch);
+  bench.run_scaling([&](Thread* thread, int id, size_t i) {
+    MicroBenchCHTLookup lookup(cht_key(id, i));
+    MicroBenchCHTFound found;
+    table.get(thread, lookup, found);
+  });
+}
+
+// Every thread inserts and removes keys of its own range, so that the
+// operations contend on the buckets but never on the same entry.
+TEST_VM(MicroBench, DISABLED_concurrentHashtable_insert_remove) {
+  MicroBenchCHT table(ChtEntriesLog2, ChtEntriesLog2);
+
+  MicroBenchmark bench("ConcurrentHashTable.insert_remove", ChtOpsPerBatch);
+  bench.run_scaling([&](Thread* thread, int id, size_t i) {
+    const uintptr_t key = (uintptr_t)id * ChtEntries + cht_key(id, i);
+    MicroBenchCHTLookup lookup(key);
+    table.insert(thread, lookup, key);
+    table.remove(thread, lookup);
+  });
+}
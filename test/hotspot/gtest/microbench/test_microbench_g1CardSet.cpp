@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "utilities/macros.hpp"
+#if INCLUDE_G1GC
+#include "gc/g1/g1CardSet.inline.hpp"
+#include "gc/g1/g1CardSetMemory.hpp"
+#include "microBenchmark.hpp"
+#include "unittest.hpp"
+
+const uint CardSetCardsPerRegion = 16384;
+const uint CardSetRegions = 1000;
+const size_t CardSetOpsPerBatch = 10000;
+
+// A card set with the configuration of the multi-threaded card set test.
+class MicroBenchCardSet : public StackObj {
+  G1CardSetConfiguration _config;
+  G1CardSetFreePool _free_pool;
+  G1CardSetMemoryManager _mm;
+  G1CardSet _card_set;
+
+public:
+  MicroBenchCardSet() :
+    _config(120, 1.0, 8, 1.0, CardSetCardsPerRegion, 0),
+    _free_pool(_config.num_mem_object_types()),
+    _mm(&_config, &_free_pool),
+    _card_set(&_config, &_mm) {}
+
+  G1AddCardResult add_card(uint region, uint card) {
+    return _card_set.add_card(region, card);
+  }
+
+  bool contains_card(uint region, uint card) {
+    return _card_set.contains_card(region, card);
+  }
+
+  // Park-Miller random number generator, as in the card set tests.
+  static uint next_random(uint& seed, uint i) {
+    seed = (seed * 279470273u) % 0xfffffffb;
+    return (seed % i);
+  }
+};
+
+TEST_VM(MicroBench, DISABLED_g1CardSet_add_card) {
+  MicroBenchCardSet card_set;
+
+  MicroBenchmark bench("G1CardSet.add_card", CardSetOpsPerBatch);
+  bench.run_scaling([&](Thread* thread, int id, size_t i) {
+    uint seed = (uint)(i * 31 + id + 1);
+    const uint region = MicroBenchCardSet::next_random(seed, CardSetRegions);
+    const uint card = MicroBenchCardSet::next_random(seed, CardSetCardsPerRegion);
+    card_set.add_card(region, card);
+  });
+}
+
+TEST_VM(MicroBench, DISABLED_g1CardSet_contains_card) {
+  MicroBenchCardSet card_set;
+  uint seed = 1;
+  for (uint i = 0; i < CardSetRegions * 100; i++) {
+    const uint region = MicroBenchCardSet::next_random(seed, CardSetRegions);
+    const uint card = MicroBenchCardSet::next_random(seed, CardSetCardsPerRegion);
+    card_set.add_card(region, card);
+  }
+
+  MicroBenchmark bench("G1CardSet.contains_card", CardSetOpsPerBatch);
+  bench.run_scaling([&](Thread* thread, int id, size_t i) {
+    uint seed = (uint)(i * 31 + id + 1);
+    const uint region = MicroBenchCardSet::next_random(seed, CardSetRegions);
+    const uint card = MicroBenchCardSet::next_random(seed, CardSetCardsPerRegion);
+    card_set.contains_card(region, card);
+  });
+}
+
+#endif // INCLUDE_G1GC
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "utilities/growableArray.hpp"
+#include "microBenchmark.hpp"
+#include "unittest.hpp"
+
+const size_t GrowableArrayOpsPerBatch = 100000;
+// The appends start over from an empty array every so often, so that the
+// growing of the array is part of the measurement.
+const int GrowableArrayMaxLength = 4096;
+const int GrowableArrayFindLength = 64;
+
+typedef GrowableArrayCHeap<int, mtTest> MicroBenchArray;
+
+// GrowableArray is not thread-safe, every thread has its own array.
+TEST_VM(MicroBench, DISABLED_growableArray_append) {
+  const int nthreads = MicroBenchmark::max_threads();
+  MicroBenchArray** arrays = NEW_C_HEAP_ARRAY(MicroBenchArray*, nthreads, mtTest);
+  for (int i = 0; i < nthreads; i++) {
+    arrays[i] = new MicroBenchArray();
+  }
+
+  MicroBenchmark bench("GrowableArray.append", GrowableArrayOpsPerBatch);
+  bench.run_scaling([&](Thread* thread, int id, size_t i) {
+    MicroBenchArray* const array = arrays[id];
+    if (array->length() == GrowableArrayMaxLength) {
+      array->clear_and_deallocate();
+    }
+    array->append((int)i);
+  });
+
+  for (int i = 0; i < nthreads; i++) {
+    delete arrays[i];
+  }
+  FREE_C_HEAP_ARRAY(MicroBenchArray*, arrays);
+}
+
+TEST_VM(MicroBench, DISABLED_growableArray_find) {
+  MicroBenchArray array(GrowableArrayFindLength);
+  for (int i = 0; i < GrowableArrayFindLength; i++) {
+    array.append(i);
+  }
+
+  MicroBenchmark bench("GrowableArray.find", GrowableArrayOpsPerBatch);
+  bench.run_scaling([&](Thread* thread, int id, size_t i) {
+    guarantee(array.find((int)(i % GrowableArrayFindLength)) >= 0, "must be found");
+  });
+}
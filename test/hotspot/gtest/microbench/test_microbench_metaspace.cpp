@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "memory/metaspace.hpp"
+#include "memory/metaspace/testHelpers.hpp"
+#include "microBenchmark.hpp"
+#include "unittest.hpp"
+
+using metaspace::MetaspaceTestArena;
+using metaspace::MetaspaceTestContext;
+
+const size_t MetaspaceOpsPerBatch = 10000;
+// Every thread has its own arena, like a class loader, and replaces it with
+// a new one after this many allocations, so that the chunks go back to the
+// chunk manager and are reused like they are when class loaders die.
+const size_t MetaspaceAllocationsPerArena = 1000;
+
+TEST_VM(MicroBench, DISABLED_metaspace_allocate) {
+  const int nthreads = MicroBenchmark::max_threads();
+  MetaspaceTestContext context("microbench-metaspace-context");
+  MetaspaceTestArena** arenas = NEW_C_HEAP_ARRAY(MetaspaceTestArena*, nthreads, mtTest);
+  for (int i = 0; i < nthreads; i++) {
+    arenas[i] = context.create_arena(Metaspace::StandardMetaspaceType);
+  }
+
+  MicroBenchmark bench("Metaspace.allocate", MetaspaceOpsPerBatch);
+  bench.run_scaling([&](Thread* thread, int id, size_t i) {
+    if (i % MetaspaceAllocationsPerArena == 0) {
+      delete arenas[id];
+      arenas[id] = context.create_arena(Metaspace::StandardMetaspaceType);
+    }
+    // The sizes of typical small metadata, 2 to 33 words.
+    const size_t word_size = 2 + (i * 7) % 32;
+    guarantee(arenas[id]->allocate(word_size) != nullptr, "must succeed");
+  });
+
+  for (int i = 0; i < nthreads; i++) {
+    delete arenas[i];
+  }
+  FREE_C_HEAP_ARRAY(MetaspaceTestArena*, arenas);
+}
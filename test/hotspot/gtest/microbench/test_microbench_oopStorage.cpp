@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/oopStorage.inline.hpp"
+#include "microBenchmark.hpp"
+#include "unittest.hpp"
+
+const size_t OopStorageOpsPerBatch = 10000;
+const size_t OopStorageBulkSize = 64;
+
+TEST_VM(MicroBench, DISABLED_oopStorage_allocate_release) {
+  OopStorage* storage = OopStorage::create("MicroBench Storage", mtGC);
+
+  MicroBenchmark bench("OopStorage.allocate_release", OopStorageOpsPerBatch);
+  bench.run_scaling([&](Thread* thread, int id, size_t i) {
+    oop* const entry = storage->allocate();
+    storage->release(entry);
+  });
+
+  delete storage;
+}
+
+TEST_VM(MicroBench, DISABLED_oopStorage_bulk_allocate_release) {
+  OopStorage* storage = OopStorage::create("MicroBench Storage", mtGC);
+
+  MicroBenchmark bench("OopStorage.bulk_allocate_release", OopStorageOpsPerBatch / OopStorageBulkSize);
+  bench.run_scaling([&](Thread* thread, int id, size_t i) {
+    oop* entries[OopStorageBulkSize];
+    size_t allocated = 0;
+    // A bulk allocation takes entries from a single block.
+    while (allocated < OopStorageBulkSize) {
+      const size_t n = storage->allocate(entries + allocated, OopStorageBulkSize - allocated);
+      if (n == 0) {
+        break;
+      }
+      allocated += n;
+    }
+    storage->release(entries, allocated);
+  });
+
+  delete storage;
+}
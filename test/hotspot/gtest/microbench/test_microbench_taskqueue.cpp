@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/taskqueue.inline.hpp"
+#include "microBenchmark.hpp"
+#include "unittest.hpp"
+
+typedef GenericTaskQueue<size_t, mtGC> MicroBenchTaskQueue;
+typedef GenericTaskQueueSet<MicroBenchTaskQueue, mtGC> MicroBenchTaskQueueSet;
+
+const size_t TaskQueueOpsPerBatch = 100000;
+
+// A queue per thread, as the GC workers have.
+class MicroBenchTaskQueues : public StackObj {
+  const int _nqueues;
+  MicroBenchTaskQueue** _queues;
+  MicroBenchTaskQueueSet _set;
+
+public:
+  MicroBenchTaskQueues(int nqueues) :
+    _nqueues(nqueues),
+    _queues(NEW_C_HEAP_ARRAY(MicroBenchTaskQueue*, nqueues, mtTest)),
+    _set(nqueues) {
+    for (int i = 0; i < _nqueues; i++) {
+      _queues[i] = new MicroBenchTaskQueue();
+      _set.register_queue(i, _queues[i]);
+    }
+  }
+
+  ~MicroBenchTaskQueues() {
+    for (int i = 0; i < _nqueues; i++) {
+      size_t t;
+      while (_queues[i]->pop_local(t)) { }
+      delete _queues[i];
+    }
+    FREE_C_HEAP_ARRAY(MicroBenchTaskQueue*, _queues);
+  }
+
+  MicroBenchTaskQueue* queue(int id) { return _queues[id]; }
+  MicroBenchTaskQueueSet* set() { return &_set; }
+};
+
+TEST_VM(MicroBench, DISABLED_taskqueue_push_pop_local) {
+  MicroBenchTaskQueues queues(MicroBenchmark::max_threads());
+
+  MicroBenchmark bench("TaskQueue.push_pop_local", TaskQueueOpsPerBatch);
+  bench.run_scaling([&](Thread* thread, int id, size_t i) {
+    MicroBenchTaskQueue* const queue = queues.queue(id);
+    size_t t;
+    queue->push(i);
+    queue->pop_local(t);
+  });
+}
+
+// Every thread pushes a task to its own queue and then takes one from a
+// random other queue, as a worker does when its own queue runs empty.
+TEST_VM(MicroBench, DISABLED_taskqueue_push_steal) {
+  const int nthreads = MicroBenchmark::max_threads();
+  if (nthreads < 2) {
+    return;
+  }
+  MicroBenchTaskQueues queues(nthreads);
+
+  MicroBenchmark bench("TaskQueue.push_steal", TaskQueueOpsPerBatch);
+  for (int n = 2; n <= nthreads; n *= 2) {
+    bench.run(n, [&](Thread* thread, int id, size_t i) {
+      MicroBenchTaskQueue* const queue = queues.queue(id);
+      size_t t;
+      if (!queue->push(i)) {
+        // Full, this thread took more tasks from the other queues than the
+        // other threads took from this one.
+        queue->pop_local(t);
+        queue->push(i);
+      }
+      if (!queues.set()->steal(id, t)) {
+        queue->pop_local(t);
+      }
+    });
+  }
+}
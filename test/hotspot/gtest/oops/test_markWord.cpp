@@ -109,3 +109,24 @@ TEST_VM(markWord, printing) {
   }
 }
 #endif // PRODUCT
+
+#ifdef _LP64
+TEST(markWord, narrow_klass) {
+  const narrowKlass max_nk = (narrowKlass)markWord::klass_mask;
+  const narrowKlass values[] = { 1, 0x1234, max_nk - 1, max_nk };
+  for (narrowKlass nk : values) {
+    ASSERT_TRUE(markWord::fits_narrow_klass(nk));
+    markWord m = markWord::prototype().copy_set_hash(0x7fffffff).set_age(markWord::max_age);
+    m = m.set_narrow_klass(nk);
+    EXPECT_EQ(nk, m.narrow_klass());
+    EXPECT_EQ(0x7fffffff, m.hash());
+    EXPECT_EQ(markWord::max_age, m.age());
+    EXPECT_TRUE(m.is_unlocked());
+    // Changing the other fields keeps the narrow klass.
+    m = m.copy_set_hash(0x1).incr_age().set_marked();
+    EXPECT_EQ(nk, m.narrow_klass());
+    EXPECT_EQ(0x1, m.hash());
+  }
+  ASSERT_FALSE(markWord::fits_narrow_klass(max_nk + 1));
+}
+#endif // _LP64
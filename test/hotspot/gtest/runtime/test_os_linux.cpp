@@ -25,6 +25,7 @@
 
 #ifdef LINUX
 
+#include "hugepages.hpp"
 #include "os_linux.hpp"
 #include "prims/jniCheck.hpp"
 #include "runtime/globals.hpp"
@@ -384,6 +385,33 @@ TEST_VM(os_linux, pretouch_thp_and_use_concurrent) {
   UseTransparentHugePages = useThp;
 }
 
+TEST_VM(os_linux, madvise_thp_collapse) {
+  // MADV_COLLAPSE may be unsupported or fail; the memory must stay usable.
+  const size_t size = 8 * M;
+  const bool useCollapse = UseMadvCollapse;
+  UseMadvCollapse = true;
+  char* const heap = os::reserve_memory(size, false, mtInternal);
+  ASSERT_NE(heap, nullptr);
+  ASSERT_TRUE(os::commit_memory(heap, size, false));
+  os::Linux::madvise_transparent_huge_pages(heap, size);
+
+  int* iptr = reinterpret_cast<int*>(heap);
+  for (int i = 0; i < 1000; i++) *iptr++ = i;
+  iptr = reinterpret_cast<int*>(heap);
+  for (int i = 0; i < 1000; i++)
+    EXPECT_EQ(*iptr++, i);
+
+  stringStream ss;
+  HugePages::print_thp_coverage_on(&ss);
+  if (ss.size() > 0) {
+    ASSERT_THAT(ss.base(), testing::HasSubstr("THP coverage:"));
+  }
+
+  EXPECT_TRUE(os::uncommit_memory(heap, size, false));
+  EXPECT_TRUE(os::release_memory(heap, size));
+  UseMadvCollapse = useCollapse;
+}
+
 // Check that method JNI_CreateJavaVM is found.
 TEST(os_linux, addr_to_function_valid) {
   char buf[128] = "";
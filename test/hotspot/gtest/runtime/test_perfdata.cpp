@@ -22,6 +22,7 @@
  */
 
 #include "precompiled.hpp"
+#include "runtime/perfData.hpp"
 #include "runtime/perfMemory.hpp"
 #include "unittest.hpp"
 
@@ -41,3 +42,12 @@ TEST_VM_F(PerfMemoryTest, destroy) {
   ASSERT_NE(PerfMemory::capacity(), (size_t)0) << "PerfMemory::_capacity should not be 0";
 }
 
+TEST_VM(PerfLongStripes, sum) {
+  PerfLongStripes stripes;
+  ASSERT_EQ(stripes.take_sample(), 0);
+  stripes.add(1);
+  stripes.add(41);
+  ASSERT_EQ(stripes.take_sample(), 42);
+  stripes.add(-2);
+  ASSERT_EQ(stripes.take_sample(), 40);
+}
@@ -99,3 +99,15 @@ TEST_VM(os, TrimNative) {
   EXPECT_GT(c2, c1);
   EXPECT_GT(c3, c2);
 }
+
+TEST_VM(os, TrimNativeRequest) {
+  // Requests only lead to trims with TrimNativeHeapOnPressure, but must
+  // always be safe to make.
+  NativeHeapTrimmer::request_trim("Test");
+  check_trim_state();
+
+  // Querying memory pressure must work everywhere, whether the OS
+  // reports pressure or not.
+  os::memory_pressure_reported();
+  os::memory_pressure_reported();
+}
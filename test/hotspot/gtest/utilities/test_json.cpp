@@ -522,3 +522,23 @@ bool JSON_GTest::callback(JSON_TYPE t, JSON_VAL* v, uint rlevel) {
       return false;
   }
 }
+
+TEST_VM(utilities, json_writer) {
+  ResourceMark rm;
+  stringStream st;
+  JSONWriter writer(&st);
+  writer.begin_object();
+  writer.print_string("name", "a \"quoted\"\tname\n");
+  writer.print_int("int", -42);
+  writer.print_uint("uint", 42);
+  writer.begin_array("array");
+  writer.print_bool(nullptr, true);
+  writer.print_null(nullptr);
+  writer.begin_object();
+  writer.end_object();
+  writer.end_array();
+  writer.end_object();
+  ASSERT_STREQ("{\"name\":\"a \\\"quoted\\\"\\tname\\n\",\"int\":-42,\"uint\":42,\"array\":[true,null,{}]}",
+               st.base());
+  JSON_GTest::test(st.base(), true);
+}
@@ -103,3 +103,39 @@ TEST_VM(utf8, jbyte_length) {
   }
 
 }
+
+TEST_VM(utf8, ascii_runs) {
+  // Long enough to take the word at a time paths, with the interesting
+  // bytes placed after a full word of ASCII.
+  const char* ascii = "abcdefghijklmnopqrstuvwxyz";
+  const char* mixed = "abcdefghij\xc3\xa9klmnopqrstu\xe2\x82\xac";
+  bool is_latin1, has_multibyte;
+
+  ASSERT_EQ(UTF8::unicode_length(ascii, is_latin1, has_multibyte), 26);
+  EXPECT_TRUE(is_latin1);
+  EXPECT_FALSE(has_multibyte);
+
+  int len = UTF8::unicode_length(mixed, is_latin1, has_multibyte);
+  ASSERT_EQ(len, 23);
+  EXPECT_FALSE(is_latin1);
+  EXPECT_TRUE(has_multibyte);
+
+  jchar chars[23];
+  UTF8::convert_to_unicode(mixed, chars, len);
+  EXPECT_EQ(chars[0], 'a');
+  EXPECT_EQ(chars[10], 0xe9);
+  EXPECT_EQ(chars[21], 'u');
+  EXPECT_EQ(chars[22], 0x20ac);
+
+  const unsigned char* bytes = (const unsigned char*)mixed;
+  EXPECT_TRUE(UTF8::is_legal_utf8(bytes, (int)strlen(mixed), false));
+
+  // An embedded zero or a stray continuation byte after an ASCII run
+  // must still be rejected.
+  unsigned char bad[24];
+  memcpy(bad, ascii, sizeof(bad));
+  bad[17] = 0;
+  EXPECT_FALSE(UTF8::is_legal_utf8(bad, sizeof(bad), false));
+  bad[17] = 0x80;
+  EXPECT_FALSE(UTF8::is_legal_utf8(bad, sizeof(bad), false));
+}
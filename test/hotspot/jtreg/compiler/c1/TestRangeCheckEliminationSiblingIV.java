@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary Check range check elimination for array accesses indexed by an
+ *          induction variable that is incremented together with the one the
+ *          loop condition tests.
+ *
+ * @requires vm.compiler1.enabled
+ * @run main/othervm -Xbatch -XX:TieredStopAtLevel=1
+ *      compiler.c1.TestRangeCheckEliminationSiblingIV
+ * @run main/othervm -Xbatch -XX:TieredStopAtLevel=3
+ *      compiler.c1.TestRangeCheckEliminationSiblingIV
+ */
+
+package compiler.c1;
+
+public class TestRangeCheckEliminationSiblingIV {
+
+    private static final int ITERS = 20_000;
+
+    // j == i + 1, in bounds.
+    static int sumNext(int[] a) {
+        int sum = 0;
+        for (int i = 0, j = 1; i < a.length - 1; i++, j++) {
+            sum += a[j];
+        }
+        return sum;
+    }
+
+    // j == i - 1, in bounds.
+    static int sumPrevious(int[] a) {
+        int sum = 0;
+        for (int i = 1, j = 0; i < a.length; i++, j++) {
+            sum += a[j];
+        }
+        return sum;
+    }
+
+    // j == i + 1 runs past the end of the array in the last iteration.
+    static int sumPastEnd(int[] a) {
+        int sum = 0;
+        for (int i = 0, j = 1; i < a.length; i++, j++) {
+            sum += a[j];
+        }
+        return sum;
+    }
+
+    // j == i + 2 with a step of 2.
+    static void copyShifted(int[] dst, int[] src) {
+        for (int i = 0, j = 2; i < src.length - 2; i += 2, j += 2) {
+            dst[i] = src[j];
+        }
+    }
+
+    public static void main(String[] args) {
+        int[] a = new int[100];
+        for (int i = 0; i < a.length; i++) {
+            a[i] = i;
+        }
+        int[] dst = new int[a.length];
+        for (int iter = 0; iter < ITERS; iter++) {
+            if (sumNext(a) != 4950) {
+                throw new RuntimeException("sumNext: " + sumNext(a));
+            }
+            if (sumPrevious(a) != 4950 - 99) {
+                throw new RuntimeException("sumPrevious: " + sumPrevious(a));
+            }
+            try {
+                sumPastEnd(a);
+                throw new RuntimeException("sumPastEnd did not throw");
+            } catch (ArrayIndexOutOfBoundsException e) {
+                // expected
+            }
+            copyShifted(dst, a);
+            for (int i = 0; i < a.length - 2; i += 2) {
+                if (dst[i] != i + 2) {
+                    throw new RuntimeException("copyShifted: dst[" + i + "] = " + dst[i]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary Check that branches in tier 3 code with sampled branch profiling
+ *          still go the right way.
+ *
+ * @requires vm.compiler1.enabled
+ * @run main/othervm -Xbatch -XX:TieredStopAtLevel=3 -XX:+UnlockExperimentalVMOptions
+ *      -XX:C1ProfileSamplingShift=3 compiler.c1.TestSampledBranchProfiling
+ * @run main/othervm -Xbatch -XX:TieredStopAtLevel=3 -XX:+UnlockExperimentalVMOptions
+ *      -XX:C1ProfileSamplingShift=10 compiler.c1.TestSampledBranchProfiling
+ */
+
+package compiler.c1;
+
+public class TestSampledBranchProfiling {
+
+    private static final int ITERS = 20_000;
+
+    static int countInts(int[] a, int t) {
+        int n = 0;
+        for (int i = 0; i < a.length; i++) {
+            if (a[i] < t) {
+                n++;
+            }
+        }
+        return n;
+    }
+
+    static int countLongs(long[] a, long t) {
+        int n = 0;
+        for (int i = 0; i < a.length; i++) {
+            if (a[i] >= t) {
+                n++;
+            }
+        }
+        return n;
+    }
+
+    static int countDoubles(double[] a, double t) {
+        int n = 0;
+        for (int i = 0; i < a.length; i++) {
+            if (a[i] > t) {
+                n++;
+            }
+        }
+        return n;
+    }
+
+    static int countNulls(Object[] a) {
+        int n = 0;
+        for (int i = 0; i < a.length; i++) {
+            if (a[i] == null) {
+                n++;
+            }
+        }
+        return n;
+    }
+
+    public static void main(String[] args) {
+        int[] ints = new int[100];
+        long[] longs = new long[100];
+        double[] doubles = new double[100];
+        Object[] objects = new Object[100];
+        for (int i = 0; i < 100; i++) {
+            ints[i] = i;
+            longs[i] = i * 0x1_0000_0000L;
+            doubles[i] = (i % 10 == 0) ? Double.NaN : i;
+            objects[i] = (i % 3 == 0) ? null : ints;
+        }
+        for (int iter = 0; iter < ITERS; iter++) {
+            int t = iter % 101;
+            check("countInts", countInts(ints, t), t);
+            check("countLongs", countLongs(longs, t * 0x1_0000_0000L), 100 - t);
+            int expected = 0;
+            for (int i = 0; i < 100; i++) {
+                if (i % 10 != 0 && i > t) {
+                    expected++;
+                }
+            }
+            check("countDoubles", countDoubles(doubles, t), expected);
+            check("countNulls", countNulls(objects), 34);
+        }
+    }
+
+    static void check(String what, int actual, int expected) {
+        if (actual != expected) {
+            throw new RuntimeException(what + ": " + actual + " != " + expected);
+        }
+    }
+}
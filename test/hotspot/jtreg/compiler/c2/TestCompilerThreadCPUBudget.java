@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Test that no compiler threads are added beyond the CPU budget
+ *          of the compiler threads.
+ * @requires vm.compMode != "Xint" & vm.flagless
+ * @library /test/lib
+ * @run driver compiler.c2.TestCompilerThreadCPUBudget
+ */
+
+package compiler.c2;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestCompilerThreadCPUBudget {
+
+    public static class Test {
+        public static void main(String... args) {
+            // Compile lots of methods to fill the compile queues.
+            StringBuilder sb = new StringBuilder();
+            for (int i = 0; i < 20_000; i++) {
+                sb.setLength(0);
+                sb.append(String.format("%d %x %s", i, i, Integer.toBinaryString(i)));
+                sb.append(java.time.LocalDate.ofEpochDay(i).toString());
+            }
+            System.out.println(sb.length());
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        // A budget of 25% of 4 CPUs leaves room for a single compiler thread,
+        // fewer than the ones started at VM startup.
+        ProcessBuilder pb = ProcessTools.createTestJavaProcessBuilder(
+            "-XX:+UnlockExperimentalVMOptions",
+            "-XX:+UnlockDiagnosticVMOptions",
+            "-XX:ActiveProcessorCount=4",
+            "-XX:CICompilerCount=4",
+            "-XX:+UseDynamicNumberOfCompilerThreads",
+            "-XX:CompilerThreadCPUBudget=25",
+            "-XX:+TraceCompilerThreads",
+            "compiler.c2.TestCompilerThreadCPUBudget$Test");
+        OutputAnalyzer oa = new OutputAnalyzer(pb.start());
+        oa.shouldHaveExitValue(0);
+        oa.shouldNotContain("Added compiler thread");
+    }
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary Check the results of loops over two arrays that may be the same
+ *          array, which C2 versions on a runtime check that they differ.
+ *
+ * @requires vm.compiler2.enabled
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:+UnlockExperimentalVMOptions
+ *      -XX:CompileCommand=exclude,compiler.c2.TestLoopAliasingVersioning::*Reference
+ *      -XX:+LoopAliasingVersioning compiler.c2.TestLoopAliasingVersioning
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:+UnlockExperimentalVMOptions
+ *      -XX:CompileCommand=exclude,compiler.c2.TestLoopAliasingVersioning::*Reference
+ *      -XX:-LoopAliasingVersioning compiler.c2.TestLoopAliasingVersioning
+ */
+
+package compiler.c2;
+
+import java.util.Arrays;
+
+public class TestLoopAliasingVersioning {
+
+    private static final int SIZE = 1000;
+    private static final int ITERS = 10_000;
+
+    static void copy(byte[] dst, int dstOff, byte[] src, int srcOff, int len) {
+        for (int i = 0; i < len; i++) {
+            dst[dstOff + i] = src[srcOff + i];
+        }
+    }
+
+    static void blend(byte[] dst, int dstOff, byte[] a, byte[] b, int srcOff, int len) {
+        for (int i = 0; i < len; i++) {
+            dst[dstOff + i] = (byte)((a[srcOff + i] & 0x0f) | (b[srcOff + i] & 0xf0));
+        }
+    }
+
+    static void copyReference(byte[] dst, int dstOff, byte[] src, int srcOff, int len) {
+        for (int i = 0; i < len; i++) {
+            dst[dstOff + i] = src[srcOff + i];
+        }
+    }
+
+    static void blendReference(byte[] dst, int dstOff, byte[] a, byte[] b, int srcOff, int len) {
+        for (int i = 0; i < len; i++) {
+            dst[dstOff + i] = (byte)((a[srcOff + i] & 0x0f) | (b[srcOff + i] & 0xf0));
+        }
+    }
+
+    static byte[] init() {
+        byte[] a = new byte[SIZE];
+        for (int i = 0; i < SIZE; i++) {
+            a[i] = (byte)(i * 7 + 3);
+        }
+        return a;
+    }
+
+    static void check(byte[] expected, byte[] actual, String what, int dstOff, int srcOff) {
+        if (!Arrays.equals(expected, actual)) {
+            throw new RuntimeException(what + " failed for dstOff " + dstOff + ", srcOff " + srcOff);
+        }
+    }
+
+    static void test(int dstOff, int srcOff) {
+        int len = SIZE - Math.max(dstOff, srcOff);
+
+        // Different arrays.
+        byte[] src = init();
+        byte[] dst = new byte[SIZE];
+        byte[] expected = new byte[SIZE];
+        copy(dst, dstOff, src, srcOff, len);
+        copyReference(expected, dstOff, src, srcOff, len);
+        check(expected, dst, "copy", dstOff, srcOff);
+
+        // The same array, overlapping in both directions.
+        byte[] same = init();
+        expected = init();
+        copy(same, dstOff, same, srcOff, len);
+        copyReference(expected, dstOff, expected, srcOff, len);
+        check(expected, same, "overlapping copy", dstOff, srcOff);
+
+        byte[] b = init();
+        same = init();
+        expected = init();
+        blend(same, dstOff, same, b, srcOff, len);
+        blendReference(expected, dstOff, expected, b, srcOff, len);
+        check(expected, same, "overlapping blend", dstOff, srcOff);
+    }
+
+    public static void main(String[] args) {
+        // Compile copy() and blend() before checking them.
+        for (int iter = 0; iter < ITERS; iter++) {
+            copy(new byte[64], 1, new byte[64], 0, 32);
+            blend(new byte[64], 1, new byte[64], new byte[64], 0, 32);
+        }
+        for (int dstOff = 0; dstOff < 9; dstOff++) {
+            for (int srcOff = 0; srcOff < 9; srcOff++) {
+                test(dstOff, srcOff);
+            }
+        }
+    }
+}
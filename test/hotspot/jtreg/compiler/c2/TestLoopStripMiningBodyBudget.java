@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary Check the results of strip mined loops whose number of inner loop
+ *          iterations is derived from the size of the loop body.
+ *
+ * @requires vm.compiler2.enabled
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:+UnlockExperimentalVMOptions
+ *      -XX:+UseCountedLoopSafepoints -XX:LoopStripMiningIter=1000
+ *      -XX:CompileCommand=exclude,compiler.c2.TestLoopStripMiningBodyBudget::*Reference
+ *      -XX:LoopStripMiningBodyBudget=1 compiler.c2.TestLoopStripMiningBodyBudget
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:+UnlockExperimentalVMOptions
+ *      -XX:+UseCountedLoopSafepoints -XX:LoopStripMiningIter=1000
+ *      -XX:CompileCommand=exclude,compiler.c2.TestLoopStripMiningBodyBudget::*Reference
+ *      -XX:LoopStripMiningBodyBudget=50000 compiler.c2.TestLoopStripMiningBodyBudget
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:+UnlockExperimentalVMOptions
+ *      -XX:+UseCountedLoopSafepoints -XX:LoopStripMiningIter=1000
+ *      -XX:CompileCommand=exclude,compiler.c2.TestLoopStripMiningBodyBudget::*Reference
+ *      -XX:LoopStripMiningBodyBudget=4294967295 compiler.c2.TestLoopStripMiningBodyBudget
+ */
+
+package compiler.c2;
+
+public class TestLoopStripMiningBodyBudget {
+
+    private static final int ITERS = 10_000;
+
+    static long light(int from, int to) {
+        long sum = 0;
+        for (int i = from; i < to; i++) {
+            sum += i;
+        }
+        return sum;
+    }
+
+    static long heavy(int[] a, int from, int to) {
+        long sum = 0;
+        for (int i = from; i < to; i += 3) {
+            int v = a[i & 0xff];
+            sum += (v * 31) ^ (v >>> 3) ^ (i * 17L) ^ (sum >>> 7);
+        }
+        return sum;
+    }
+
+    static long lightReference(int from, int to) {
+        long sum = 0;
+        for (int i = from; i < to; i++) {
+            sum += i;
+        }
+        return sum;
+    }
+
+    static long heavyReference(int[] a, int from, int to) {
+        long sum = 0;
+        for (int i = from; i < to; i += 3) {
+            int v = a[i & 0xff];
+            sum += (v * 31) ^ (v >>> 3) ^ (i * 17L) ^ (sum >>> 7);
+        }
+        return sum;
+    }
+
+    static void check(long expected, long actual, String what, int from, int to) {
+        if (expected != actual) {
+            throw new RuntimeException(what + " failed for [" + from + ", " + to + "): " + actual + " != " + expected);
+        }
+    }
+
+    public static void main(String[] args) {
+        int[] a = new int[257];
+        for (int i = 0; i < a.length; i++) {
+            a[i] = i * 7 + 3;
+        }
+        // Compile light() and heavy() before checking them.
+        for (int iter = 0; iter < ITERS; iter++) {
+            light(0, 100);
+            heavy(a, 0, 100);
+        }
+        int[] bounds = { 0, 1, 2, 999, 1000, 1001, 12345, 1_000_000, Integer.MAX_VALUE - 2 };
+        for (int from : new int[] { Integer.MIN_VALUE + 1, -1000, 0, 5 }) {
+            for (int to : bounds) {
+                if ((long)to - from > 10_000_000) {
+                    continue;
+                }
+                check(lightReference(from, to), light(from, to), "light", from, to);
+                check(heavyReference(a, from, to), heavy(a, from, to), "heavy", from, to);
+            }
+        }
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary Allocations which escape only on rarely taken branches are scalar
+ *          replaced when such branches become uncommon traps; the object must
+ *          be materialized correctly when the trap is hit.
+ *
+ * @requires vm.compiler2.enabled
+ * @run main/othervm -Xbatch -XX:-TieredCompilation
+ *      -XX:+UnlockExperimentalVMOptions -XX:RareBranchUncommonTrapProbability=0.01
+ *      compiler.c2.TestRareBranchScalarReplacement
+ */
+
+package compiler.c2;
+
+public class TestRareBranchScalarReplacement {
+
+    static class Point {
+        final int x;
+        final int y;
+
+        Point(int x, int y) {
+            this.x = x;
+            this.y = y;
+        }
+    }
+
+    static Point escaped;
+
+    static int test(int i) {
+        Point p = new Point(i, i * 2);
+        if (i % 1000 == 999) {
+            // Rarely taken: the only place where p escapes.
+            escaped = p;
+        }
+        return p.x + p.y;
+    }
+
+    public static void main(String[] args) {
+        for (int i = 0; i < 1_000_000; i++) {
+            int r = test(i);
+            if (r != 3 * i) {
+                throw new RuntimeException("wrong result " + r + " for " + i);
+            }
+            if (i % 1000 == 999) {
+                if (escaped == null || escaped.x != i || escaped.y != 2 * i) {
+                    throw new RuntimeException("wrong escaped object for " + i);
+                }
+                escaped = null;
+            }
+        }
+    }
+}
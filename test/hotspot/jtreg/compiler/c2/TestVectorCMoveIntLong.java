@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary Check the results of int and long select loops, which superword
+ *          vectorizes into VectorMaskCmp and VectorBlend with UseVectorCmov.
+ *
+ * @requires vm.compiler2.enabled
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:+UseVectorCmov
+ *      -XX:+UseCMoveUnconditionally compiler.c2.TestVectorCMoveIntLong
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:-UseVectorCmov
+ *      compiler.c2.TestVectorCMoveIntLong
+ */
+
+package compiler.c2;
+
+import java.util.Random;
+
+public class TestVectorCMoveIntLong {
+
+    private static final int SIZE = 1027;
+    private static final int ITERS = 20_000;
+
+    static void selectInt(int[] a, int[] b, int[] r, int t) {
+        for (int i = 0; i < a.length; i++) {
+            r[i] = a[i] > t ? a[i] : b[i];
+        }
+    }
+
+    static void selectIntLe(int[] a, int[] b, int[] r, int t) {
+        for (int i = 0; i < a.length; i++) {
+            r[i] = a[i] <= t ? b[i] : a[i];
+        }
+    }
+
+    static void selectLong(long[] a, long[] b, long[] r, long t) {
+        for (int i = 0; i < a.length; i++) {
+            r[i] = a[i] < t ? a[i] : b[i];
+        }
+    }
+
+    // The comparison and the selected values have different sizes.
+    static void selectLongByInt(int[] a, long[] b, long[] r, int t) {
+        for (int i = 0; i < a.length; i++) {
+            r[i] = a[i] == t ? b[i] : -b[i];
+        }
+    }
+
+    public static void main(String[] args) {
+        Random random = new Random(42);
+        int[] ia = new int[SIZE];
+        int[] ib = new int[SIZE];
+        int[] ir = new int[SIZE];
+        long[] la = new long[SIZE];
+        long[] lb = new long[SIZE];
+        long[] lr = new long[SIZE];
+        for (int i = 0; i < SIZE; i++) {
+            ia[i] = random.nextInt(100);
+            ib[i] = random.nextInt();
+            la[i] = random.nextLong(100);
+            lb[i] = random.nextLong();
+        }
+        for (int iter = 0; iter < ITERS; iter++) {
+            int t = iter % 100;
+            selectInt(ia, ib, ir, t);
+            for (int i = 0; i < SIZE; i++) {
+                if (ir[i] != (ia[i] > t ? ia[i] : ib[i])) {
+                    throw new RuntimeException("selectInt failed at " + i);
+                }
+            }
+            selectIntLe(ia, ib, ir, t);
+            for (int i = 0; i < SIZE; i++) {
+                if (ir[i] != (ia[i] <= t ? ib[i] : ia[i])) {
+                    throw new RuntimeException("selectIntLe failed at " + i);
+                }
+            }
+            selectLong(la, lb, lr, t);
+            for (int i = 0; i < SIZE; i++) {
+                if (lr[i] != (la[i] < t ? la[i] : lb[i])) {
+                    throw new RuntimeException("selectLong failed at " + i);
+                }
+            }
+            selectLongByInt(ia, lb, lr, t);
+            for (int i = 0; i < SIZE; i++) {
+                if (lr[i] != (ia[i] == t ? lb[i] : -lb[i])) {
+                    throw new RuntimeException("selectLongByInt failed at " + i);
+                }
+            }
+        }
+    }
+}
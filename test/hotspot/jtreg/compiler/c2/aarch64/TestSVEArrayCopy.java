@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary Test array copies and Unsafe.setMemory of short lengths, which
+ *          use SVE predicated loads and stores for small sizes and tails.
+ *
+ * @requires os.arch == "aarch64" & vm.compiler2.enabled
+ * @modules java.base/jdk.internal.misc
+ * @run main/othervm -Xbatch -XX:-TieredCompilation
+ *      compiler.c2.aarch64.TestSVEArrayCopy
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:UseSVE=0
+ *      compiler.c2.aarch64.TestSVEArrayCopy
+ */
+
+package compiler.c2.aarch64;
+
+import jdk.internal.misc.Unsafe;
+
+public class TestSVEArrayCopy {
+
+    private static final Unsafe UNSAFE = Unsafe.getUnsafe();
+
+    private static final int MAX_LENGTH = 256;
+    private static final int PAD = 16;
+    private static final int SIZE = MAX_LENGTH + 2 * PAD;
+    private static final int ITERS = 20;
+
+    static void fail(String what, int length, int index) {
+        throw new RuntimeException(what + " failed for length " + length + " at index " + index);
+    }
+
+    // Fill src with distinct values, copy [srcPos, srcPos + length) to a
+    // cleared array at dstPos, and then within src itself. Only the copied
+    // elements may change.
+
+    static void testBytes(int length, int srcPos, int dstPos) {
+        byte[] src = new byte[SIZE];
+        byte[] dst = new byte[SIZE];
+        for (int i = 0; i < SIZE; i++) {
+            src[i] = (byte)(i + 1);
+        }
+        byte[] expected = src.clone();
+        for (int i = 0; i < length; i++) {
+            expected[dstPos + i] = src[srcPos + i];
+        }
+        System.arraycopy(src, srcPos, dst, dstPos, length);
+        System.arraycopy(src, srcPos, src, dstPos, length);
+        for (int i = 0; i < SIZE; i++) {
+            boolean copied = i >= dstPos && i < dstPos + length;
+            if (dst[i] != (copied ? expected[i] : 0)) {
+                fail("byte copy", length, i);
+            }
+            if (src[i] != expected[i]) {
+                fail("overlapping byte copy", length, i);
+            }
+        }
+    }
+
+    static void testShorts(int length, int srcPos, int dstPos) {
+        short[] src = new short[SIZE];
+        short[] dst = new short[SIZE];
+        for (int i = 0; i < SIZE; i++) {
+            src[i] = (short)(i + 1);
+        }
+        short[] expected = src.clone();
+        for (int i = 0; i < length; i++) {
+            expected[dstPos + i] = src[srcPos + i];
+        }
+        System.arraycopy(src, srcPos, dst, dstPos, length);
+        System.arraycopy(src, srcPos, src, dstPos, length);
+        for (int i = 0; i < SIZE; i++) {
+            boolean copied = i >= dstPos && i < dstPos + length;
+            if (dst[i] != (copied ? expected[i] : 0)) {
+                fail("short copy", length, i);
+            }
+            if (src[i] != expected[i]) {
+                fail("overlapping short copy", length, i);
+            }
+        }
+    }
+
+    static void testInts(int length, int srcPos, int dstPos) {
+        int[] src = new int[SIZE];
+        int[] dst = new int[SIZE];
+        for (int i = 0; i < SIZE; i++) {
+            src[i] = i + 1;
+        }
+        int[] expected = src.clone();
+        for (int i = 0; i < length; i++) {
+            expected[dstPos + i] = src[srcPos + i];
+        }
+        System.arraycopy(src, srcPos, dst, dstPos, length);
+        System.arraycopy(src, srcPos, src, dstPos, length);
+        for (int i = 0; i < SIZE; i++) {
+            boolean copied = i >= dstPos && i < dstPos + length;
+            if (dst[i] != (copied ? expected[i] : 0)) {
+                fail("int copy", length, i);
+            }
+            if (src[i] != expected[i]) {
+                fail("overlapping int copy", length, i);
+            }
+        }
+    }
+
+    static void testLongs(int length, int srcPos, int dstPos) {
+        long[] src = new long[SIZE];
+        long[] dst = new long[SIZE];
+        for (int i = 0; i < SIZE; i++) {
+            src[i] = i + 1;
+        }
+        long[] expected = src.clone();
+        for (int i = 0; i < length; i++) {
+            expected[dstPos + i] = src[srcPos + i];
+        }
+        System.arraycopy(src, srcPos, dst, dstPos, length);
+        System.arraycopy(src, srcPos, src, dstPos, length);
+        for (int i = 0; i < SIZE; i++) {
+            boolean copied = i >= dstPos && i < dstPos + length;
+            if (dst[i] != (copied ? expected[i] : 0)) {
+                fail("long copy", length, i);
+            }
+            if (src[i] != expected[i]) {
+                fail("overlapping long copy", length, i);
+            }
+        }
+    }
+
+    static void testSetMemory(int length, int dstPos) {
+        byte[] dst = new byte[SIZE];
+        UNSAFE.setMemory(dst, Unsafe.ARRAY_BYTE_BASE_OFFSET + dstPos, length, (byte)0x5a);
+        for (int i = 0; i < SIZE; i++) {
+            boolean set = i >= dstPos && i < dstPos + length;
+            if (dst[i] != (set ? (byte)0x5a : 0)) {
+                fail("setMemory", length, i);
+            }
+        }
+    }
+
+    public static void main(String[] args) {
+        for (int iter = 0; iter < ITERS; iter++) {
+            for (int length = 0; length <= MAX_LENGTH; length++) {
+                // Aligned and misaligned positions, overlapping copies in
+                // both directions.
+                for (int offset = 0; offset < 8; offset++) {
+                    testBytes(length, PAD + offset, PAD);
+                    testBytes(length, PAD, PAD + offset);
+                    testShorts(length, PAD + offset, PAD);
+                    testShorts(length, PAD, PAD + offset);
+                    testInts(length, PAD + offset, PAD);
+                    testInts(length, PAD, PAD + offset);
+                    testLongs(length, PAD + offset, PAD);
+                    testLongs(length, PAD, PAD + offset);
+                    testSetMemory(length, PAD + offset);
+                }
+            }
+        }
+    }
+}
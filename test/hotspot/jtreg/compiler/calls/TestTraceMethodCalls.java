@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test id=c1
+ * @summary Test that the C1 compiled code of a method selected by the
+ *          TraceMethodCalls compile command reports its entries and exits.
+ * @requires vm.hasJFR & vm.compiler1.enabled & vm.compMode != "Xint"
+ * @run main/othervm -Xbatch -XX:TieredStopAtLevel=1
+ *      -XX:CompileCommand=TraceMethodCalls,compiler.calls.TestTraceMethodCalls::traced
+ *      compiler.calls.TestTraceMethodCalls
+ */
+
+/*
+ * @test id=c2
+ * @summary Test that the C2 compiled code of a method selected by the
+ *          TraceMethodCalls compile command reports its entries and exits.
+ * @requires vm.hasJFR & vm.compiler2.enabled & vm.compMode != "Xint"
+ * @run main/othervm -Xbatch -XX:-TieredCompilation
+ *      -XX:CompileCommand=TraceMethodCalls,compiler.calls.TestTraceMethodCalls::traced
+ *      compiler.calls.TestTraceMethodCalls
+ */
+
+package compiler.calls;
+
+import java.nio.file.Path;
+import java.util.List;
+
+import jdk.jfr.Recording;
+import jdk.jfr.consumer.RecordedEvent;
+import jdk.jfr.consumer.RecordedMethod;
+import jdk.jfr.consumer.RecordingFile;
+
+public class TestTraceMethodCalls {
+
+    static int traced(int i) {
+        return i * 3 + 1;
+    }
+
+    static int untraced(int i) {
+        return traced(i) - 1;
+    }
+
+    public static void main(String[] args) throws Exception {
+        int sum = 0;
+        // Warm up so that traced() and untraced() are compiled.
+        for (int i = 0; i < 20_000; i++) {
+            sum += untraced(i);
+        }
+
+        try (Recording recording = new Recording()) {
+            recording.enable("jdk.MethodTrace");
+            recording.start();
+            for (int i = 0; i < 100; i++) {
+                sum += untraced(i);
+            }
+            recording.stop();
+
+            Path file = Path.of("method-trace.jfr");
+            recording.dump(file);
+            List<RecordedEvent> events = RecordingFile.readAllEvents(file);
+
+            int entries = 0;
+            int exits = 0;
+            for (RecordedEvent event : events) {
+                RecordedMethod method = event.getValue("method");
+                if (!method.getName().equals("traced")) {
+                    throw new RuntimeException("unexpected method traced: " + event);
+                }
+                if (event.getBoolean("exit")) {
+                    exits++;
+                } else {
+                    entries++;
+                }
+            }
+            System.out.println("entries: " + entries + ", exits: " + exits + ", sum: " + sum);
+            if (entries == 0 || entries != exits) {
+                throw new RuntimeException("expected matching entries and exits, got " +
+                                           entries + " entries and " + exits + " exits");
+            }
+        }
+    }
+}
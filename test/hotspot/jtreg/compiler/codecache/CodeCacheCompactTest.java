@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Test that compacting the code cache relocates nmethods and
+ *          that the relocated code keeps working.
+ * @requires vm.compiler2.enabled
+ * @modules java.management
+ * @run main/othervm -Xbatch -XX:+UnlockDiagnosticVMOptions -XX:+NMethodRelocation
+ *      -XX:+SegmentedCodeCache compiler.codecache.CodeCacheCompactTest
+ * @run main/othervm -Xbatch -XX:+UnlockDiagnosticVMOptions -XX:+NMethodRelocation
+ *      -XX:-SegmentedCodeCache compiler.codecache.CodeCacheCompactTest
+ */
+
+package compiler.codecache;
+
+import java.lang.management.ManagementFactory;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+import javax.management.MBeanServer;
+import javax.management.ObjectName;
+
+public class CodeCacheCompactTest {
+
+    static int sum;
+
+    static int add(int a, int b) {
+        return a + b;
+    }
+
+    static int work(int n) {
+        int s = 0;
+        for (int i = 0; i < n; i++) {
+            s = add(s, i);
+        }
+        return s;
+    }
+
+    static Object call(int n) {
+        // Virtual calls through an interface exercise the inline caches.
+        Runnable r = (n & 1) == 0 ? () -> sum++ : () -> sum--;
+        r.run();
+        return Integer.valueOf(work(n));
+    }
+
+    static void run() {
+        for (int i = 0; i < 20_000; i++) {
+            if ((Integer)call(i % 100) != (i % 100) * (i % 100 - 1) / 2) {
+                throw new RuntimeException("wrong result for " + i);
+            }
+        }
+    }
+
+    static String compact() throws Exception {
+        MBeanServer server = ManagementFactory.getPlatformMBeanServer();
+        ObjectName name = new ObjectName("com.sun.management:type=DiagnosticCommand");
+        return (String)server.invoke(name, "compilerCodecacheCompact",
+                                     new Object[] { new String[0] },
+                                     new String[] { String[].class.getName() });
+    }
+
+    public static void main(String[] args) throws Exception {
+        run();
+        // Free some nmethods to leave holes in the code cache.
+        System.gc();
+        System.gc();
+
+        String output = compact();
+        System.out.println(output);
+        Matcher m = Pattern.compile("relocated (\\d+) nmethods").matcher(output);
+        if (!m.find()) {
+            throw new RuntimeException("unexpected output: " + output);
+        }
+
+        // Run the relocated code, and let the GC free the old copies.
+        run();
+        System.gc();
+        System.out.println(compact());
+        run();
+    }
+}
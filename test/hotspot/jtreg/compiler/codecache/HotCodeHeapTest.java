@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Test that optimized methods with high invocation counts are
+ *          placed in the hot code heap when HotCodeHeapSize is set.
+ * @requires vm.compiler2.enabled & vm.flagless
+ * @library /test/lib
+ * @run driver compiler.codecache.HotCodeHeapTest
+ */
+
+package compiler.codecache;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class HotCodeHeapTest {
+
+    public static class Test {
+        static int sum;
+
+        static void hot(int i) {
+            sum += i;
+        }
+
+        public static void main(String... args) throws Exception {
+            for (int i = 0; i < 1_000_000; i++) {
+                hot(i);
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createTestJavaProcessBuilder(
+            "-XX:+SegmentedCodeCache",
+            "-XX:+UnlockExperimentalVMOptions",
+            "-XX:HotCodeHeapSize=4M",
+            "-XX:HotCodeHeapThreshold=0",
+            "-XX:+PrintCodeCache",
+            "compiler.codecache.HotCodeHeapTest$Test");
+        OutputAnalyzer oa = new OutputAnalyzer(pb.start());
+        oa.shouldHaveExitValue(0);
+        oa.shouldContain("CodeHeap 'hot nmethods'");
+
+        // Without a segmented code cache there is no hot code heap.
+        pb = ProcessTools.createTestJavaProcessBuilder(
+            "-XX:-SegmentedCodeCache",
+            "-XX:+UnlockExperimentalVMOptions",
+            "-XX:HotCodeHeapSize=4M",
+            "-XX:+PrintCodeCache",
+            "-version");
+        oa = new OutputAnalyzer(pb.start());
+        oa.shouldHaveExitValue(0);
+        oa.shouldNotContain("CodeHeap 'hot nmethods'");
+    }
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Test that deoptimizing the methods depending on the class
+ *          hierarchy after loading a class is logged as one batch.
+ * @requires vm.compMode != "Xint" & vm.flagless
+ * @library /test/lib
+ * @run driver compiler.deoptimization.TestDependencyDeoptimizationLog
+ */
+
+package compiler.deoptimization;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestDependencyDeoptimizationLog {
+
+    static abstract class Shape {
+        abstract int area();
+    }
+
+    static class Square extends Shape {
+        int area() {
+            return 4;
+        }
+    }
+
+    // Loaded only after areas() is compiled, which breaks the assumption
+    // that Square implements the only concrete area() method.
+    static class Circle extends Shape {
+        int area() {
+            return 3;
+        }
+    }
+
+    public static class Test {
+        static int areas(Shape shape, int n) {
+            int sum = 0;
+            for (int i = 0; i < n; i++) {
+                sum += shape.area();
+            }
+            return sum;
+        }
+
+        public static void main(String... args) throws Exception {
+            Shape square = new Square();
+            for (int i = 0; i < 20_000; i++) {
+                areas(square, 100);
+            }
+            Shape circle = (Shape) Class.forName("compiler.deoptimization.TestDependencyDeoptimizationLog$Circle")
+                                        .getDeclaredConstructor().newInstance();
+            if (areas(circle, 100) != 300) {
+                throw new RuntimeException("wrong result");
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createTestJavaProcessBuilder(
+            "-Xbatch",
+            "-Xlog:deoptimization=info",
+            "compiler.deoptimization.TestDependencyDeoptimizationLog$Test");
+        OutputAnalyzer oa = new OutputAnalyzer(pb.start());
+        oa.shouldHaveExitValue(0);
+        oa.shouldMatch("Deoptimizing \\d+ nmethods, cause: class hierarchy change, most common broken dependency: \\w+");
+    }
+}
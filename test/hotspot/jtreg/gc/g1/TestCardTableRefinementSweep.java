@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package gc.g1;
+
+/*
+ * @test TestCardTableRefinementSweep
+ * @requires vm.gc.G1
+ * @requires os.arch == "amd64" | os.arch == "x86_64" | os.arch == "i386" | os.arch == "x86"
+ * @summary Check that remembered sets stay complete when concurrent refinement
+ * sweeps the card table instead of using dirty card queues.
+ * @run main/othervm -XX:+UseG1GC -Xmx64m -XX:+UnlockExperimentalVMOptions
+ *                   -XX:+G1UseCardTableRefinementSweep -XX:+UnlockDiagnosticVMOptions
+ *                   -XX:+VerifyBeforeGC -XX:+VerifyAfterGC -XX:VerifyGCType=young-normal
+ *                   gc.g1.TestCardTableRefinementSweep
+ * @run main/othervm -XX:+UseG1GC -Xmx64m -XX:+UnlockExperimentalVMOptions
+ *                   -XX:+G1UseCardTableRefinementSweep -XX:-G1UseConcRefinement
+ *                   -XX:+UnlockDiagnosticVMOptions
+ *                   -XX:+VerifyBeforeGC -XX:+VerifyAfterGC -XX:VerifyGCType=young-normal
+ *                   gc.g1.TestCardTableRefinementSweep
+ */
+
+public class TestCardTableRefinementSweep {
+  private static final int NUM_ARRAYS = 64;
+  private static final int ARRAY_LENGTH = 4096;
+
+  private static Object[][] oldArrays = new Object[NUM_ARRAYS][];
+
+  public static void main(String[] args) throws Exception {
+    for (int i = 0; i < NUM_ARRAYS; i++) {
+      oldArrays[i] = new Object[ARRAY_LENGTH];
+    }
+    // Promote the arrays to the old generation.
+    System.gc();
+
+    // Repeatedly store young objects into the old arrays, causing young
+    // collections that need the remembered sets of the young regions.
+    long checksum = 0;
+    for (int round = 0; round < 200; round++) {
+      for (int i = 0; i < NUM_ARRAYS; i++) {
+        Object[] array = oldArrays[i];
+        for (int j = round % 7; j < ARRAY_LENGTH; j += 7) {
+          array[j] = new int[] { round, i, j };
+        }
+      }
+      // Allocate some garbage to trigger young collections.
+      for (int k = 0; k < 1000; k++) {
+        checksum += new byte[256].length;
+      }
+    }
+
+    for (int i = 0; i < NUM_ARRAYS; i++) {
+      for (Object o : oldArrays[i]) {
+        if (o != null && ((int[])o).length != 3) {
+          throw new RuntimeException("Unexpected element in old array");
+        }
+      }
+    }
+    System.out.println("Checksum: " + checksum);
+  }
+}
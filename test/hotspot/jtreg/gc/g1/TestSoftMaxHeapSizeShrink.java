@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+ */
+
+package gc.g1;
+
+/**
+ * @test TestSoftMaxHeapSizeShrink
+ * @requires vm.gc.G1
+ * @summary Verify that the heap shrinks after lowering SoftMaxHeapSize at runtime.
+ * @library /test/lib /
+ * @modules java.management
+ * @run main/othervm -XX:InitialHeapSize=128M -XX:MinHeapSize=16M -Xmx128M -XX:MinHeapFreeRatio=5 -XX:+UseG1GC -Xlog:gc*,gc+ergo+heap=debug gc.g1.TestSoftMaxHeapSizeShrink
+ */
+
+import com.sun.management.HotSpotDiagnosticMXBean;
+
+import java.lang.management.ManagementFactory;
+
+public class TestSoftMaxHeapSizeShrink {
+
+    private static final long M = 1024 * 1024;
+    private static final long SOFT_MAX = 32 * M;
+
+    private static long committed() {
+        return ManagementFactory.getMemoryMXBean().getHeapMemoryUsage().getCommitted();
+    }
+
+    public static void main(String[] args) throws Exception {
+        System.out.println("Committed before: " + committed() / M + "M");
+
+        ManagementFactory.getPlatformMXBean(HotSpotDiagnosticMXBean.class)
+            .setVMOption("SoftMaxHeapSize", Long.toString(SOFT_MAX));
+
+        // The region size and the young generation may keep the heap
+        // somewhat above SoftMaxHeapSize.
+        for (int i = 0; i < 100; i++) {
+            if (committed() <= 2 * SOFT_MAX) {
+                System.out.println("Committed after: " + committed() / M + "M");
+                return;
+            }
+            Thread.sleep(100);
+        }
+        throw new RuntimeException("Heap did not shrink towards SoftMaxHeapSize, committed: " + committed() / M + "M");
+    }
+}
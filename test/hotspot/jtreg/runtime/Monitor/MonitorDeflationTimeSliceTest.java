@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+
+/*
+ * @test id=max
+ * @summary Test that async deflation continues where a cycle stopped
+ *          because of MonitorDeflationMax or MonitorDeflationTimeSlice.
+ * @library /test/lib
+ * @run driver MonitorDeflationTimeSliceTest max
+ */
+
+/*
+ * @test id=timeslice
+ * @library /test/lib
+ * @run driver MonitorDeflationTimeSliceTest timeslice
+ */
+
+/*
+ * @test id=illegal
+ * @library /test/lib
+ * @run driver MonitorDeflationTimeSliceTest illegal
+ */
+
+public class MonitorDeflationTimeSliceTest {
+
+    public static class Test {
+        private static final int MONITORS = 20_000;
+        private static final int THREADS = 16;
+
+        public static void main(String... args) throws Exception {
+            Thread[] threads = new Thread[THREADS];
+            for (int t = 0; t < THREADS; t++) {
+                threads[t] = new Thread(() -> {
+                    for (int m = 0; m < MONITORS / THREADS; m++) {
+                        Object o = new Object();
+                        synchronized (o) {
+                            try {
+                                o.wait(1);  // force inflation
+                            } catch (InterruptedException e) {
+                            }
+                        }
+                    }
+                });
+                threads[t].start();
+            }
+            for (Thread t : threads) {
+                t.join();
+            }
+
+            try {
+                Thread.sleep(5_000);
+            } catch (InterruptedException ie) {
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        if (args.length < 1) {
+            throw new IllegalArgumentException("Expect the test label");
+        }
+
+        switch (args[0]) {
+            case "max":
+                // At most 1024 monitors per cycle, so the 20000 idle
+                // monitors take several consecutive cycles.
+                test(true, "-XX:MonitorDeflationMax=1024")
+                    .shouldContain("continuing incremental deflation");
+                break;
+
+            case "timeslice":
+                test(true, "-XX:MonitorDeflationTimeSlice=1");
+                break;
+
+            case "illegal":
+                test(false, "-XX:MonitorDeflationTimeSlice=-1")
+                    .shouldContain("outside the allowed range");
+                break;
+
+            default:
+                throw new IllegalArgumentException("Unknown test: " + args[0]);
+        }
+    }
+
+    public static OutputAnalyzer test(boolean pass, String... args) throws Exception {
+        List<String> opts = new ArrayList<>();
+        opts.add("-Xmx128M");
+        opts.add("-XX:+UnlockDiagnosticVMOptions");
+        opts.add("-XX:GuaranteedAsyncDeflationInterval=100");
+        opts.add("-Xlog:monitorinflation=info");
+        opts.addAll(Arrays.asList(args));
+        opts.add("MonitorDeflationTimeSliceTest$Test");
+
+        ProcessBuilder pb = ProcessTools.createTestJavaProcessBuilder(opts);
+        OutputAnalyzer oa = new OutputAnalyzer(pb.start());
+        if (pass) {
+            oa.shouldHaveExitValue(0);
+        } else {
+            oa.shouldNotHaveExitValue(0);
+        }
+        return oa;
+    }
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Test inflated locking, hash codes and wait/notify with the
+ *          object monitor table, while monitors are concurrently deflated.
+ * @requires os.arch == "amd64" | os.arch == "x86_64" | os.arch == "aarch64"
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:LockingMode=2
+ *      -XX:+UseObjectMonitorTable -XX:GuaranteedAsyncDeflationInterval=100
+ *      ObjectMonitorTableTest
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:LockingMode=2
+ *      -XX:+UseObjectMonitorTable -XX:GuaranteedAsyncDeflationInterval=100
+ *      -Xint ObjectMonitorTableTest
+ */
+
+public class ObjectMonitorTableTest {
+    static final int THREADS = 4;
+    static final int OBJECTS = 64;
+    static final int ITERATIONS = 200_000;
+
+    static final Object[] objects = new Object[OBJECTS];
+    static final int[] hashes = new int[OBJECTS];
+    static final long[] counters = new long[OBJECTS];
+
+    public static void main(String[] args) throws Exception {
+        for (int i = 0; i < OBJECTS; i++) {
+            objects[i] = new Object();
+            // Hash half of the objects before they get inflated.
+            if (i % 2 == 0) {
+                hashes[i] = System.identityHashCode(objects[i]);
+            }
+        }
+
+        Thread[] threads = new Thread[THREADS];
+        for (int t = 0; t < THREADS; t++) {
+            final int seed = t;
+            threads[t] = new Thread(() -> contend(seed));
+            threads[t].start();
+        }
+        Thread waiter = new Thread(ObjectMonitorTableTest::waitAndNotify);
+        waiter.start();
+
+        for (Thread t : threads) {
+            t.join();
+        }
+        waiter.join();
+
+        long total = 0;
+        for (int i = 0; i < OBJECTS; i++) {
+            total += counters[i];
+            checkHash(i);
+        }
+        if (total != (long)THREADS * ITERATIONS) {
+            throw new RuntimeException("Lost updates: " + total);
+        }
+    }
+
+    static void checkHash(int i) {
+        int hash = System.identityHashCode(objects[i]);
+        synchronized (hashes) {
+            if (hashes[i] == 0) {
+                hashes[i] = hash;
+            } else if (hashes[i] != hash) {
+                throw new RuntimeException("Hash of object " + i + " changed");
+            }
+        }
+    }
+
+    static void contend(int seed) {
+        int index = seed;
+        for (int i = 0; i < ITERATIONS; i++) {
+            index = (index * 31 + 7) % OBJECTS;
+            Object o = objects[index];
+            synchronized (o) {
+                synchronized (o) {
+                    counters[index]++;
+                }
+                if ((i & 1023) == 0) {
+                    checkHash(index);
+                }
+            }
+        }
+    }
+
+    static void waitAndNotify() {
+        for (int i = 0; i < 200; i++) {
+            Object o = objects[i % OBJECTS];
+            synchronized (o) {
+                try {
+                    o.wait(1);
+                } catch (InterruptedException e) {
+                    throw new RuntimeException(e);
+                }
+                o.notifyAll();
+            }
+            checkHash(i % OBJECTS);
+        }
+    }
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Test that NMT samples the native memory usage periodically
+ *          when NMTUsageHistoryInterval is set.
+ * @library /test/lib
+ * @run driver NMTUsageHistoryTest
+ */
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class NMTUsageHistoryTest {
+
+    public static class Test {
+        public static void main(String... args) throws Exception {
+            Thread.sleep(1_000);
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createTestJavaProcessBuilder(
+            "-XX:NativeMemoryTracking=summary",
+            "-XX:+UnlockDiagnosticVMOptions",
+            "-XX:NMTUsageHistoryInterval=105",
+            "-XX:NMTUsageHistorySize=8",
+            "-XX:+PrintNMTStatistics",
+            "-Xlog:nmt=info",
+            "NMTUsageHistoryTest$Test");
+        OutputAnalyzer oa = new OutputAnalyzer(pb.start());
+        oa.shouldHaveExitValue(0);
+        // The interval is rounded down to the PeriodicTask granularity.
+        oa.shouldContain("Sampling native memory usage every 100 ms, keeping 8 samples");
+        oa.shouldContain("Native Memory Tracking:");
+
+        pb = ProcessTools.createTestJavaProcessBuilder(
+            "-XX:+UnlockDiagnosticVMOptions",
+            "-XX:NMTUsageHistorySize=1",
+            "-version");
+        oa = new OutputAnalyzer(pb.start());
+        oa.shouldNotHaveExitValue(0);
+        oa.shouldContain("outside the allowed range");
+    }
+}
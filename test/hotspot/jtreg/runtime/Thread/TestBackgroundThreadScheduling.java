@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Test the scheduling policy and CPU affinity of compiler threads
+ *          with BackgroundThreadSchedulingPolicy and BackgroundThreadCPUs.
+ * @requires os.family == "linux" & vm.compMode != "Xint" & vm.flagless
+ * @library /test/lib
+ * @run driver TestBackgroundThreadScheduling
+ */
+
+import java.io.File;
+import java.nio.file.Files;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestBackgroundThreadScheduling {
+
+    // From sched.h
+    static final int SCHED_IDLE = 5;
+
+    public static class Test {
+        public static void main(String... args) throws Exception {
+            int compilerThreads = 0;
+            for (File task : new File("/proc/self/task").listFiles()) {
+                String comm = Files.readString(task.toPath().resolve("comm")).trim();
+                if (!comm.contains("CompilerThre")) {
+                    continue;
+                }
+                compilerThreads++;
+                // The policy is field 41 of stat, and the fields after the
+                // command name in parentheses start with field 3.
+                String stat = Files.readString(task.toPath().resolve("stat"));
+                String[] fields = stat.substring(stat.lastIndexOf(')') + 2).split(" ");
+                int policy = Integer.parseInt(fields[41 - 3]);
+                if (policy != SCHED_IDLE) {
+                    throw new RuntimeException(comm + " has scheduling policy " + policy);
+                }
+                for (String line : Files.readAllLines(task.toPath().resolve("status"))) {
+                    if (line.startsWith("Cpus_allowed_list:") && !line.endsWith("\t0")) {
+                        throw new RuntimeException(comm + " has wrong CPU affinity: " + line);
+                    }
+                }
+            }
+            if (compilerThreads == 0) {
+                throw new RuntimeException("No compiler threads found");
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createTestJavaProcessBuilder(
+            "-XX:+UnlockExperimentalVMOptions",
+            "-XX:BackgroundThreadSchedulingPolicy=idle",
+            "-XX:BackgroundThreadCPUs=0",
+            "TestBackgroundThreadScheduling$Test");
+        OutputAnalyzer oa = new OutputAnalyzer(pb.start());
+        oa.shouldHaveExitValue(0);
+
+        pb = ProcessTools.createTestJavaProcessBuilder(
+            "-XX:+UnlockExperimentalVMOptions",
+            "-XX:BackgroundThreadSchedulingPolicy=fifo",
+            "-XX:BackgroundThreadCPUs=0-",
+            "-version");
+        oa = new OutputAnalyzer(pb.start());
+        oa.shouldHaveExitValue(0);
+        oa.shouldContain("Ignoring unknown BackgroundThreadSchedulingPolicy \"fifo\"");
+        oa.shouldContain("Ignoring malformed BackgroundThreadCPUs \"0-\"");
+    }
+}
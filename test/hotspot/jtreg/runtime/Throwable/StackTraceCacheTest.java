@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Test that throwables share backtraces with UseStackTraceCache
+ *          only when they are thrown from the same stack.
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+UseStackTraceCache
+ *      StackTraceCacheTest
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+UseStackTraceCache
+ *      -XX:StackTraceCacheMaxDepth=4 StackTraceCacheTest
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+UseStackTraceCache
+ *      -Xint StackTraceCacheTest
+ */
+
+import java.util.Arrays;
+
+public class StackTraceCacheTest {
+    static final int ITERATIONS = 10_000;
+
+    static Exception throwAt(int site) {
+        try {
+            if (site == 0) {
+                throw new IllegalStateException("site 0");
+            } else {
+                throw new IllegalStateException("site 1");
+            }
+        } catch (IllegalStateException e) {
+            return e;
+        }
+    }
+
+    static Exception recurse(int depth, int site) {
+        if (depth == 0) {
+            return throwAt(site);
+        }
+        return recurse(depth - 1, site);
+    }
+
+    static void check(boolean condition, String message) {
+        if (!condition) {
+            throw new RuntimeException(message);
+        }
+    }
+
+    public static void main(String[] args) {
+        for (int depth = 0; depth < 16; depth++) {
+            StackTraceElement[] site0 = recurse(depth, 0).getStackTrace();
+            StackTraceElement[] site1 = recurse(depth, 1).getStackTrace();
+            check(site0.length == depth + 3, "unexpected depth " + site0.length + " for " + depth);
+            check(!Arrays.equals(site0, site1), "different throw sites must have different traces");
+            check(site0[0].getLineNumber() != site1[0].getLineNumber(), "different throw lines expected");
+            for (int i = 0; i < ITERATIONS / 16; i++) {
+                int site = i & 1;
+                StackTraceElement[] trace = recurse(depth, site).getStackTrace();
+                check(Arrays.equals(trace, site == 0 ? site0 : site1),
+                      "trace changed at depth " + depth + ", site " + site);
+            }
+        }
+        // Traces from other stacks are not affected.
+        StackTraceElement[] direct = throwAt(0).getStackTrace();
+        check(direct.length == 2, "unexpected depth " + direct.length);
+        check(direct[1].getMethodName().equals("main"), "unexpected caller " + direct[1]);
+    }
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Test that ArchiveClassesDelay writes the dynamic archive while
+ *          the application is still running.
+ * @requires vm.cds
+ * @run main/othervm -XX:ArchiveClassesAtExit=BackgroundDump.jsa
+ *      -XX:ArchiveClassesDelay=500 -Xlog:cds+dynamic=info BackgroundDump
+ */
+
+import java.io.File;
+
+public class BackgroundDump {
+    static final long TIMEOUT_MILLIS = 120_000;
+
+    public static void main(String[] args) throws Exception {
+        File archive = new File("BackgroundDump.jsa");
+        long deadline = System.currentTimeMillis() + TIMEOUT_MILLIS;
+        // The archive is written by the ServiceThread after the delay, before this
+        // method returns and the VM exits.
+        while (!archive.isFile() || archive.length() == 0) {
+            if (System.currentTimeMillis() > deadline) {
+                throw new RuntimeException("Dynamic archive was not written before exit");
+            }
+            Thread.sleep(100);
+        }
+        System.out.println("Dynamic archive written in the background: " + archive.length() + " bytes");
+    }
+}
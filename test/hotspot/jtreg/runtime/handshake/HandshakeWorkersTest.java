@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test HandshakeWorkersTest
+ * @summary Test that handshakes of many blocked threads can be processed
+ *          by the handshake worker threads.
+ * @library /testlibrary /test/lib
+ * @build HandshakeWorkersTest
+ * @run driver jdk.test.lib.helpers.ClassFileInstaller jdk.test.whitebox.WhiteBox
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI
+ *                   -XX:HandshakeWorkerThreads=4 HandshakeWorkersTest
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI
+ *                   -XX:HandshakeWorkerThreads=4 -XX:+HandshakeALot HandshakeWorkersTest
+ */
+
+import java.util.concurrent.CountDownLatch;
+
+import jdk.test.lib.Asserts;
+import jdk.test.whitebox.WhiteBox;
+
+public class HandshakeWorkersTest {
+    static final int THREADS = 256;
+
+    public static void main(String... args) throws Exception {
+        Object lock = new Object();
+        CountDownLatch started = new CountDownLatch(THREADS);
+        Thread[] threads = new Thread[THREADS];
+        for (int i = 0; i < THREADS; i++) {
+            threads[i] = new Thread(() -> {
+                synchronized (lock) {
+                    started.countDown();
+                    try {
+                        lock.wait();
+                    } catch (InterruptedException ie) {}
+                }
+            });
+            threads[i].setDaemon(true);
+            threads[i].start();
+        }
+        started.await();
+
+        WhiteBox wb = WhiteBox.getWhiteBox();
+        for (int i = 0; i < 3; i++) {
+            int walked = wb.handshakeWalkStack(null, true);
+            Asserts.assertGTE(walked, THREADS, "Must have walked all waiting thread stacks");
+        }
+
+        synchronized (lock) {
+            lock.notifyAll();
+        }
+        for (Thread t : threads) {
+            t.join();
+        }
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test
+ * @summary Test the interpreter with frequent bytecode pairs fused when linking classes.
+ *
+ * @run main/othervm -Xint -XX:+UnlockExperimentalVMOptions -XX:+FuseFrequentPairs
+ *      runtime.interpreter.TestFusedBytecodePairs
+ * @run main/othervm -Xint -XX:+UnlockExperimentalVMOptions -XX:-FuseFrequentPairs
+ *      runtime.interpreter.TestFusedBytecodePairs
+ */
+
+package runtime.interpreter;
+
+public class TestFusedBytecodePairs {
+
+    private int field;
+
+    TestFusedBytecodePairs(int field) {
+        this.field = field;
+    }
+
+    // aload_0; iload_1
+    void setField(int value) {
+        field = value;
+    }
+
+    // aload_0; aload_1
+    boolean sameAs(Object other) {
+        return this == other;
+    }
+
+    // aload_1; iload_2
+    int elementAt(int[] array, int index) {
+        return array[index];
+    }
+
+    // iload_1; iload_2
+    int sum(int a, int b) {
+        return a + b;
+    }
+
+    // iconst_1; iadd and iconst_1; isub
+    static int increment(int x) {
+        return x + 1;
+    }
+
+    static int decrement(int x) {
+        return x - 1;
+    }
+
+    // The second bytecode of the pair (iconst_1; iadd) is also a branch target.
+    static int addSelected(int x, int y, boolean c) {
+        return x + (c ? y : 1);
+    }
+
+    static void check(long actual, long expected, String what) {
+        if (actual != expected) {
+            throw new RuntimeException(what + ": expected " + expected + " but got " + actual);
+        }
+    }
+
+    public static void main(String[] args) {
+        TestFusedBytecodePairs t = new TestFusedBytecodePairs(0);
+        TestFusedBytecodePairs other = new TestFusedBytecodePairs(0);
+        int[] array = new int[16];
+        for (int i = 0; i < array.length; i++) {
+            array[i] = i * 7;
+        }
+        long sum = 0;
+        for (int i = 0; i < 10_000; i++) {
+            t.setField(i);
+            check(t.field, i, "setField");
+            check(t.sameAs(t) ? 1 : 0, 1, "sameAs");
+            check(t.sameAs(other) ? 1 : 0, 0, "sameAs");
+            check(t.elementAt(array, i & 15), (i & 15) * 7, "elementAt");
+            check(t.sum(i, -2 * i), -i, "sum");
+            check(increment(i), i + 1L, "increment");
+            check(decrement(i), i - 1L, "decrement");
+            check(addSelected(i, 5, (i & 1) == 0), (i & 1) == 0 ? i + 5L : i + 1L, "addSelected");
+            sum += increment(decrement(i));
+        }
+        check(sum, 10_000L * 9_999 / 2, "sum");
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package org.openjdk.bench.java.util.zip;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Enumeration;
+import java.util.List;
+import java.util.concurrent.TimeUnit;
+import java.util.zip.DataFormatException;
+import java.util.zip.Deflater;
+import java.util.zip.Inflater;
+import java.util.zip.ZipEntry;
+import java.util.zip.ZipFile;
+
+/**
+ * Measures inflate throughput over the deflated entries of a jmod file of
+ * the JDK under test.
+ */
+@BenchmarkMode(Mode.Throughput)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@OutputTimeUnit(TimeUnit.SECONDS)
+@State(Scope.Thread)
+@Fork(value = 3)
+public class InflateJmods {
+
+    @Param({"java.base", "java.desktop"})
+    public String module;
+
+    private List<byte[]> compressed;
+    private int maxSize;
+    private byte[] output;
+    private Inflater inflater;
+
+    @Setup
+    public void setup() throws IOException {
+        Path jmod = Path.of(System.getProperty("java.home"), "jmods", module + ".jmod");
+        if (!Files.exists(jmod)) {
+            throw new IllegalStateException("Not found: " + jmod);
+        }
+        // Recompress the deflated entries as raw deflate streams, so that
+        // they can be fed to an Inflater directly
+        compressed = new ArrayList<>();
+        try (ZipFile zf = new ZipFile(jmod.toFile())) {
+            Enumeration<? extends ZipEntry> entries = zf.entries();
+            while (entries.hasMoreElements()) {
+                ZipEntry e = entries.nextElement();
+                if (e.getMethod() != ZipEntry.DEFLATED) {
+                    continue;
+                }
+                try (InputStream in = zf.getInputStream(e)) {
+                    byte[] data = in.readAllBytes();
+                    compressed.add(deflate(data));
+                    maxSize = Math.max(maxSize, data.length);
+                }
+            }
+        }
+        output = new byte[maxSize];
+        inflater = new Inflater(true);
+    }
+
+    private static byte[] deflate(byte[] data) {
+        Deflater deflater = new Deflater(Deflater.DEFAULT_COMPRESSION, true);
+        deflater.setInput(data);
+        deflater.finish();
+        byte[] buf = new byte[data.length + 64];
+        int n = 0;
+        while (!deflater.finished()) {
+            if (n == buf.length) {
+                buf = Arrays.copyOf(buf, buf.length * 2);
+            }
+            n += deflater.deflate(buf, n, buf.length - n);
+        }
+        deflater.end();
+        return Arrays.copyOf(buf, n);
+    }
+
+    @Benchmark
+    public long inflateAll() throws DataFormatException {
+        long total = 0;
+        for (byte[] c : compressed) {
+            inflater.reset();
+            inflater.setInput(c);
+            while (!inflater.finished()) {
+                int n = inflater.inflate(output);
+                if (n == 0 && inflater.needsInput()) {
+                    break;
+                }
+                total += n;
+            }
+        }
+        return total;
+    }
+}